@@ -1517,6 +1517,91 @@ boolean aead_aes_gcm_decrypt(IN const uint8 *key, IN uintn key_size,
 			     IN const uint8 *tag, IN uintn tag_size,
 			     OUT uint8 *data_out, OUT uintn *data_out_size);
 
+/**
+  Allocates and initializes one AEAD AES-GCM context for subsequent use.
+
+  The key schedule is performed once here, and the context can be used for any number of
+  aead_aes_gcm_encrypt_with_context() and aead_aes_gcm_decrypt_with_context() calls
+  until it is released by aead_aes_gcm_free().
+
+  key_size must be 16, 24 or 32, otherwise NULL is returned.
+
+  @param[in]   key         Pointer to the encryption key.
+  @param[in]   key_size     size of the encryption key in bytes.
+
+  @return  Pointer to the AEAD AES-GCM context that has been initialized.
+           If the allocations fails, aead_aes_gcm_new() returns NULL.
+
+**/
+void *aead_aes_gcm_new(IN const uint8 *key, IN uintn key_size);
+
+/**
+  Release the specified AEAD AES-GCM context.
+
+  @param[in]  aead_aes_gcm_ctx  Pointer to the AEAD AES-GCM context to be released.
+
+**/
+void aead_aes_gcm_free(IN void *aead_aes_gcm_ctx);
+
+/**
+  Performs AEAD AES-GCM authenticated encryption on a data buffer and additional authenticated data (AAD),
+  with a keyed AEAD AES-GCM context.
+
+  iv_size must be 12, otherwise FALSE is returned.
+  tag_size must be 12, 13, 14, 15, 16, otherwise FALSE is returned.
+
+  @param[in]   aead_aes_gcm_ctx  Pointer to the AEAD AES-GCM context.
+  @param[in]   iv          Pointer to the IV value.
+  @param[in]   iv_size      size of the IV value in bytes.
+  @param[in]   a_data       Pointer to the additional authenticated data (AAD).
+  @param[in]   a_data_size   size of the additional authenticated data (AAD) in bytes.
+  @param[in]   data_in      Pointer to the input data buffer to be encrypted.
+  @param[in]   data_in_size  size of the input data buffer in bytes.
+  @param[out]  tag_out      Pointer to a buffer that receives the authentication tag output.
+  @param[in]   tag_size     size of the authentication tag in bytes.
+  @param[out]  data_out     Pointer to a buffer that receives the encryption output.
+  @param[out]  data_out_size size of the output data buffer in bytes.
+
+  @retval TRUE   AEAD AES-GCM authenticated encryption succeeded.
+  @retval FALSE  AEAD AES-GCM authenticated encryption failed.
+
+**/
+boolean aead_aes_gcm_encrypt_with_context(
+	IN void *aead_aes_gcm_ctx, IN const uint8 *iv, IN uintn iv_size,
+	IN const uint8 *a_data, IN uintn a_data_size, IN const uint8 *data_in,
+	IN uintn data_in_size, OUT uint8 *tag_out, IN uintn tag_size,
+	OUT uint8 *data_out, OUT uintn *data_out_size);
+
+/**
+  Performs AEAD AES-GCM authenticated decryption on a data buffer and additional authenticated data (AAD),
+  with a keyed AEAD AES-GCM context.
+
+  iv_size must be 12, otherwise FALSE is returned.
+  tag_size must be 12, 13, 14, 15, 16, otherwise FALSE is returned.
+  If additional authenticated data verification fails, FALSE is returned.
+
+  @param[in]   aead_aes_gcm_ctx  Pointer to the AEAD AES-GCM context.
+  @param[in]   iv          Pointer to the IV value.
+  @param[in]   iv_size      size of the IV value in bytes.
+  @param[in]   a_data       Pointer to the additional authenticated data (AAD).
+  @param[in]   a_data_size   size of the additional authenticated data (AAD) in bytes.
+  @param[in]   data_in      Pointer to the input data buffer to be decrypted.
+  @param[in]   data_in_size  size of the input data buffer in bytes.
+  @param[in]   tag         Pointer to a buffer that contains the authentication tag.
+  @param[in]   tag_size     size of the authentication tag in bytes.
+  @param[out]  data_out     Pointer to a buffer that receives the decryption output.
+  @param[out]  data_out_size size of the output data buffer in bytes.
+
+  @retval TRUE   AEAD AES-GCM authenticated decryption succeeded.
+  @retval FALSE  AEAD AES-GCM authenticated decryption failed.
+
+**/
+boolean aead_aes_gcm_decrypt_with_context(
+	IN void *aead_aes_gcm_ctx, IN const uint8 *iv, IN uintn iv_size,
+	IN const uint8 *a_data, IN uintn a_data_size, IN const uint8 *data_in,
+	IN uintn data_in_size, IN const uint8 *tag, IN uintn tag_size,
+	OUT uint8 *data_out, OUT uintn *data_out_size);
+
 /**
   Performs AEAD ChaCha20Poly1305 authenticated encryption on a data buffer and additional authenticated data (AAD).
 
@@ -1578,6 +1663,91 @@ boolean aead_chacha20_poly1305_decrypt(
 	IN const uint8 *data_in, IN uintn data_in_size, IN const uint8 *tag,
 	IN uintn tag_size, OUT uint8 *data_out, OUT uintn *data_out_size);
 
+/**
+  Allocates and initializes one AEAD ChaCha20Poly1305 context for subsequent use.
+
+  The key schedule is performed once here, and the context can be used for any number of
+  aead_chacha20_poly1305_encrypt_with_context() and aead_chacha20_poly1305_decrypt_with_context() calls
+  until it is released by aead_chacha20_poly1305_free().
+
+  key_size must be 32, otherwise NULL is returned.
+
+  @param[in]   key         Pointer to the encryption key.
+  @param[in]   key_size     size of the encryption key in bytes.
+
+  @return  Pointer to the AEAD ChaCha20Poly1305 context that has been initialized.
+           If the allocations fails, aead_chacha20_poly1305_new() returns NULL.
+
+**/
+void *aead_chacha20_poly1305_new(IN const uint8 *key, IN uintn key_size);
+
+/**
+  Release the specified AEAD ChaCha20Poly1305 context.
+
+  @param[in]  aead_chacha20_poly1305_ctx  Pointer to the AEAD ChaCha20Poly1305 context to be released.
+
+**/
+void aead_chacha20_poly1305_free(IN void *aead_chacha20_poly1305_ctx);
+
+/**
+  Performs AEAD ChaCha20Poly1305 authenticated encryption on a data buffer and additional authenticated data (AAD),
+  with a keyed AEAD ChaCha20Poly1305 context.
+
+  iv_size must be 12, otherwise FALSE is returned.
+  tag_size must be 16, otherwise FALSE is returned.
+
+  @param[in]   aead_chacha20_poly1305_ctx  Pointer to the AEAD ChaCha20Poly1305 context.
+  @param[in]   iv          Pointer to the IV value.
+  @param[in]   iv_size      size of the IV value in bytes.
+  @param[in]   a_data       Pointer to the additional authenticated data (AAD).
+  @param[in]   a_data_size   size of the additional authenticated data (AAD) in bytes.
+  @param[in]   data_in      Pointer to the input data buffer to be encrypted.
+  @param[in]   data_in_size  size of the input data buffer in bytes.
+  @param[out]  tag_out      Pointer to a buffer that receives the authentication tag output.
+  @param[in]   tag_size     size of the authentication tag in bytes.
+  @param[out]  data_out     Pointer to a buffer that receives the encryption output.
+  @param[out]  data_out_size size of the output data buffer in bytes.
+
+  @retval TRUE   AEAD ChaCha20Poly1305 authenticated encryption succeeded.
+  @retval FALSE  AEAD ChaCha20Poly1305 authenticated encryption failed.
+
+**/
+boolean aead_chacha20_poly1305_encrypt_with_context(
+	IN void *aead_chacha20_poly1305_ctx, IN const uint8 *iv, IN uintn iv_size,
+	IN const uint8 *a_data, IN uintn a_data_size, IN const uint8 *data_in,
+	IN uintn data_in_size, OUT uint8 *tag_out, IN uintn tag_size,
+	OUT uint8 *data_out, OUT uintn *data_out_size);
+
+/**
+  Performs AEAD ChaCha20Poly1305 authenticated decryption on a data buffer and additional authenticated data (AAD),
+  with a keyed AEAD ChaCha20Poly1305 context.
+
+  iv_size must be 12, otherwise FALSE is returned.
+  tag_size must be 16, otherwise FALSE is returned.
+  If additional authenticated data verification fails, FALSE is returned.
+
+  @param[in]   aead_chacha20_poly1305_ctx  Pointer to the AEAD ChaCha20Poly1305 context.
+  @param[in]   iv          Pointer to the IV value.
+  @param[in]   iv_size      size of the IV value in bytes.
+  @param[in]   a_data       Pointer to the additional authenticated data (AAD).
+  @param[in]   a_data_size   size of the additional authenticated data (AAD) in bytes.
+  @param[in]   data_in      Pointer to the input data buffer to be decrypted.
+  @param[in]   data_in_size  size of the input data buffer in bytes.
+  @param[in]   tag         Pointer to a buffer that contains the authentication tag.
+  @param[in]   tag_size     size of the authentication tag in bytes.
+  @param[out]  data_out     Pointer to a buffer that receives the decryption output.
+  @param[out]  data_out_size size of the output data buffer in bytes.
+
+  @retval TRUE   AEAD ChaCha20Poly1305 authenticated decryption succeeded.
+  @retval FALSE  AEAD ChaCha20Poly1305 authenticated decryption failed.
+
+**/
+boolean aead_chacha20_poly1305_decrypt_with_context(
+	IN void *aead_chacha20_poly1305_ctx, IN const uint8 *iv, IN uintn iv_size,
+	IN const uint8 *a_data, IN uintn a_data_size, IN const uint8 *data_in,
+	IN uintn data_in_size, IN const uint8 *tag, IN uintn tag_size,
+	OUT uint8 *data_out, OUT uintn *data_out_size);
+
 /**
   Performs AEAD SM4-GCM authenticated encryption on a data buffer and additional authenticated data (AAD).
 
@@ -1641,6 +1811,91 @@ boolean aead_sm4_gcm_decrypt(IN const uint8 *key, IN uintn key_size,
 			     IN const uint8 *tag, IN uintn tag_size,
 			     OUT uint8 *data_out, OUT uintn *data_out_size);
 
+/**
+  Allocates and initializes one AEAD SM4-GCM context for subsequent use.
+
+  The key schedule is performed once here, and the context can be used for any number of
+  aead_sm4_gcm_encrypt_with_context() and aead_sm4_gcm_decrypt_with_context() calls
+  until it is released by aead_sm4_gcm_free().
+
+  key_size must be 16, otherwise NULL is returned.
+
+  @param[in]   key         Pointer to the encryption key.
+  @param[in]   key_size     size of the encryption key in bytes.
+
+  @return  Pointer to the AEAD SM4-GCM context that has been initialized.
+           If the allocations fails, aead_sm4_gcm_new() returns NULL.
+
+**/
+void *aead_sm4_gcm_new(IN const uint8 *key, IN uintn key_size);
+
+/**
+  Release the specified AEAD SM4-GCM context.
+
+  @param[in]  aead_sm4_gcm_ctx  Pointer to the AEAD SM4-GCM context to be released.
+
+**/
+void aead_sm4_gcm_free(IN void *aead_sm4_gcm_ctx);
+
+/**
+  Performs AEAD SM4-GCM authenticated encryption on a data buffer and additional authenticated data (AAD),
+  with a keyed AEAD SM4-GCM context.
+
+  iv_size must be 12, otherwise FALSE is returned.
+  tag_size must be 16, otherwise FALSE is returned.
+
+  @param[in]   aead_sm4_gcm_ctx  Pointer to the AEAD SM4-GCM context.
+  @param[in]   iv          Pointer to the IV value.
+  @param[in]   iv_size      size of the IV value in bytes.
+  @param[in]   a_data       Pointer to the additional authenticated data (AAD).
+  @param[in]   a_data_size   size of the additional authenticated data (AAD) in bytes.
+  @param[in]   data_in      Pointer to the input data buffer to be encrypted.
+  @param[in]   data_in_size  size of the input data buffer in bytes.
+  @param[out]  tag_out      Pointer to a buffer that receives the authentication tag output.
+  @param[in]   tag_size     size of the authentication tag in bytes.
+  @param[out]  data_out     Pointer to a buffer that receives the encryption output.
+  @param[out]  data_out_size size of the output data buffer in bytes.
+
+  @retval TRUE   AEAD SM4-GCM authenticated encryption succeeded.
+  @retval FALSE  AEAD SM4-GCM authenticated encryption failed.
+
+**/
+boolean aead_sm4_gcm_encrypt_with_context(
+	IN void *aead_sm4_gcm_ctx, IN const uint8 *iv, IN uintn iv_size,
+	IN const uint8 *a_data, IN uintn a_data_size, IN const uint8 *data_in,
+	IN uintn data_in_size, OUT uint8 *tag_out, IN uintn tag_size,
+	OUT uint8 *data_out, OUT uintn *data_out_size);
+
+/**
+  Performs AEAD SM4-GCM authenticated decryption on a data buffer and additional authenticated data (AAD),
+  with a keyed AEAD SM4-GCM context.
+
+  iv_size must be 12, otherwise FALSE is returned.
+  tag_size must be 16, otherwise FALSE is returned.
+  If additional authenticated data verification fails, FALSE is returned.
+
+  @param[in]   aead_sm4_gcm_ctx  Pointer to the AEAD SM4-GCM context.
+  @param[in]   iv          Pointer to the IV value.
+  @param[in]   iv_size      size of the IV value in bytes.
+  @param[in]   a_data       Pointer to the additional authenticated data (AAD).
+  @param[in]   a_data_size   size of the additional authenticated data (AAD) in bytes.
+  @param[in]   data_in      Pointer to the input data buffer to be decrypted.
+  @param[in]   data_in_size  size of the input data buffer in bytes.
+  @param[in]   tag         Pointer to a buffer that contains the authentication tag.
+  @param[in]   tag_size     size of the authentication tag in bytes.
+  @param[out]  data_out     Pointer to a buffer that receives the decryption output.
+  @param[out]  data_out_size size of the output data buffer in bytes.
+
+  @retval TRUE   AEAD SM4-GCM authenticated decryption succeeded.
+  @retval FALSE  AEAD SM4-GCM authenticated decryption failed.
+
+**/
+boolean aead_sm4_gcm_decrypt_with_context(
+	IN void *aead_sm4_gcm_ctx, IN const uint8 *iv, IN uintn iv_size,
+	IN const uint8 *a_data, IN uintn a_data_size, IN const uint8 *data_in,
+	IN uintn data_in_size, IN const uint8 *tag, IN uintn tag_size,
+	OUT uint8 *data_out, OUT uintn *data_out_size);
+
 //=====================================================================================
 //    Asymmetric Cryptography Primitive
 //=====================================================================================
@@ -67,6 +67,24 @@ void *set_mem(OUT void *buffer, IN uintn length, IN uint8 value);
 **/
 void *zero_mem(OUT void *buffer, IN uintn length);
 
+/**
+  Fills a target buffer with zeros, and returns the target buffer.
+
+  This function fills length bytes of buffer with zeros, and returns buffer.
+  Unlike zero_mem(), the stores are never removed by the compiler, even if buffer
+  is not used afterwards. It should be used to clear secrets.
+
+  If length > 0 and buffer is NULL, then ASSERT().
+  If length is greater than (MAX_ADDRESS - buffer + 1), then ASSERT().
+
+  @param  buffer      The pointer to the target buffer to fill with zeros.
+  @param  length      The number of bytes in buffer to fill with zeros.
+
+  @return buffer.
+
+**/
+void *zero_mem_secure(OUT void *buffer, IN uintn length);
+
 /**
   Compares the contents of two buffers in const time.
 
@@ -106,6 +106,11 @@ typedef enum {
 	SPDM_DATA_SESSION_USE_PSK,
 	SPDM_DATA_SESSION_MUT_AUTH_REQUESTED,
 	SPDM_DATA_SESSION_END_SESSION_ATTRIBUTES,
+	//
+	// Statistics
+	//
+	SPDM_DATA_RESPONDER_STATISTICS,
+	SPDM_DATA_REQUESTER_STATISTICS,
 
 	//
 	// MAX
@@ -129,6 +134,147 @@ typedef struct {
 	uint8 additional_data[4];
 } spdm_data_parameter_t;
 
+//
+// Time histogram bucket N counts the samples below (16 << (2 * N)) timestamp units.
+// The last bucket counts all the remaining samples.
+//
+#define SPDM_STATISTICS_HISTOGRAM_BUCKET_COUNT 8
+
+typedef struct {
+	uint32 count;
+	uint32 histogram[SPDM_STATISTICS_HISTOGRAM_BUCKET_COUNT];
+	uint64 total_time;
+	uint64 min_time;
+	uint64 max_time;
+} spdm_statistics_time_t;
+
+//
+// Error response counter index.
+// The error code 0x00 ~ 0x0F uses the error code as index.
+// The error code 0x41 ~ 0x43 uses index 0x10 ~ 0x12.
+// All other error codes use index 0x13.
+//
+#define SPDM_STATISTICS_ERROR_CODE_COUNT 0x14
+#define SPDM_STATISTICS_ERROR_CODE_INDEX_OTHER 0x13
+
+//
+// Request statistics index.
+// The request codes of SPDM 1.1 use the index returned by spdm_get_statistics_request_code_index.
+// All other request codes use index SPDM_STATISTICS_REQUEST_CODE_INDEX_OTHER.
+//
+#define SPDM_STATISTICS_REQUEST_CODE_COUNT 0x13
+#define SPDM_STATISTICS_REQUEST_CODE_INDEX_OTHER 0x12
+
+typedef struct {
+	uint32 invocation_count;
+	uint32 error_response_count[SPDM_STATISTICS_ERROR_CODE_COUNT];
+	//
+	// The handler time excludes the sign time.
+	//
+	spdm_statistics_time_t handler_time;
+	spdm_statistics_time_t sign_time;
+	spdm_statistics_time_t encode_time;
+} spdm_responder_request_statistics_t;
+
+//
+// SPDM_DATA_RESPONDER_STATISTICS.
+// The request statistics are indexed by spdm_get_statistics_request_code_index.
+//
+typedef struct {
+	spdm_responder_request_statistics_t
+		request[SPDM_STATISTICS_REQUEST_CODE_COUNT];
+} spdm_responder_statistics_t;
+
+typedef struct {
+	//
+	// RESPOND_IF_READY is counted for the original request.
+	//
+	uint32 request_count;
+	uint32 busy_count;
+	uint32 not_ready_count;
+	spdm_statistics_time_t encode_time;
+	spdm_statistics_time_t send_time;
+	spdm_statistics_time_t receive_time;
+	spdm_statistics_time_t decode_time;
+	spdm_statistics_time_t verify_time;
+} spdm_requester_request_statistics_t;
+
+//
+// SPDM_DATA_REQUESTER_STATISTICS.
+// The request statistics are indexed by spdm_get_statistics_request_code_index.
+//
+typedef struct {
+	spdm_requester_request_statistics_t
+		request[SPDM_STATISTICS_REQUEST_CODE_COUNT];
+} spdm_requester_statistics_t;
+
+//
+// Trace event type
+//
+#define SPDM_TRACE_EVENT_REQUEST_SENT 0x01
+#define SPDM_TRACE_EVENT_RESPONSE_RECEIVED 0x02
+#define SPDM_TRACE_EVENT_REQUEST_RECEIVED 0x03
+#define SPDM_TRACE_EVENT_RESPONSE_SENT 0x04
+
+//
+// Trace event flags
+//
+#define SPDM_TRACE_EVENT_FLAG_APP_MESSAGE 0x01
+#define SPDM_TRACE_EVENT_FLAG_SESSION_ID_VALID 0x02
+
+typedef struct {
+	//
+	// (write index + 1) of the event. 0 means the event is being written, or was
+	// dropped because writers of two laps of the ring wrote it at the same time.
+	//
+	uint32 sequence;
+	uint8 event_type;
+	uint8 flags;
+	//
+	// request_response_code and param1 of an SPDM message, or 0 for an APP message.
+	//
+	uint8 opcode;
+	uint8 param1;
+	uint32 session_id;
+	uint32 message_size;
+	//
+	// From the function registered by spdm_register_get_timestamp_func, or 0.
+	//
+	uint64 timestamp;
+	uint64 spdm_context;
+	//
+	// Only recorded with SPDM_TRACE_BUFFER_FLAG_RECORD_MESSAGE_POINTER. The message is
+	// only valid during the SPDM call that records the event.
+	//
+	uint64 message;
+} spdm_trace_event_t;
+
+#define SPDM_TRACE_BUFFER_SIGNATURE SIGNATURE_32('S', 'T', 'R', 'C')
+#define SPDM_TRACE_BUFFER_VERSION 1
+
+//
+// Trace buffer flags
+//
+#define SPDM_TRACE_BUFFER_FLAG_RECORD_MESSAGE_POINTER 0x00000001
+
+//
+// The trace buffer is a ring of event_count events, which follow this header.
+// The event of write index N is placed at event[N & (event_count - 1)].
+//
+typedef struct {
+	uint32 signature;
+	uint16 version;
+	uint16 event_size;
+	uint32 event_count;
+	uint32 flags;
+	volatile uint32 write_index;
+	//
+	// The number of events dropped because a writer of a later lap of the ring claimed
+	// the same event while it was written.
+	//
+	volatile uint32 collision_count;
+} spdm_trace_buffer_t;
+
 typedef enum {
 	//
 	// Before GET_VERSION/VERSION
@@ -271,6 +417,74 @@ void spdm_set_last_spdm_error_struct(IN void *spdm_context,
 */
 void spdm_init_context(IN void *spdm_context);
 
+/**
+  Initialize an SPDM context with a session table of a given capacity.
+
+  The size in bytes of the spdm_context can be returned by spdm_get_context_size_ex
+  with the same max_session_count.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  max_session_count             The maximum number of concurrent sessions.
+*/
+void spdm_init_context_ex(IN void *spdm_context, IN uintn max_session_count);
+
+/**
+  Initialize an SPDM local context.
+
+  The size in bytes of the local_context can be returned by spdm_get_local_context_size.
+
+  @param  local_context                 A pointer to the SPDM local context.
+*/
+void spdm_init_local_context(IN void *local_context);
+
+/**
+  Initialize an SPDM context that uses a shared SPDM local context.
+
+  The local context holds the local identity: versions, capabilities, algorithms,
+  certificate chains, PSK hint, opaque data and responder policy. Many SPDM contexts,
+  one per peer, may share it. It must be initialized by spdm_init_local_context and
+  must stay valid until all SPDM contexts using it are released by spdm_deinit_context.
+  Local data set through any of the SPDM contexts applies to all of them.
+
+  While messages are processed the local context is only read, so the SPDM contexts
+  sharing it may serve their peers from different threads. The reference count is
+  updated atomically, so SPDM contexts may be attached by this function and released
+  by spdm_deinit_context on different threads (on compilers without atomic builtins
+  these calls must not run concurrently). spdm_set_data of local data writes the
+  local context and must not run concurrently with any other use of the SPDM
+  contexts sharing it.
+
+  The size in bytes of the spdm_context can be returned by
+  spdm_get_context_size_with_local_context with the same max_session_count.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  max_session_count             The maximum number of concurrent sessions.
+  @param  local_context                 A pointer to the shared SPDM local context.
+*/
+void spdm_init_context_with_local_context(IN void *spdm_context,
+					  IN uintn max_session_count,
+					  IN void *local_context);
+
+/**
+  Release the resources held by an SPDM context.
+
+  The running hash, AEAD and HMAC contexts of the connection and its sessions, the
+  cached peer public key and the DHE key pool are freed, and the reference to the
+  local context is dropped. The SPDM context must be initialized again before reuse.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+*/
+void spdm_deinit_context(IN void *spdm_context);
+
+/**
+  Return the number of SPDM contexts using an SPDM local context.
+
+  @param  local_context                 A pointer to the SPDM local context.
+
+  @return the number of SPDM contexts using the local context.
+**/
+uint32 spdm_get_local_context_ref_count(IN void *local_context);
+
 /**
   Reset an SPDM context.
 
@@ -280,6 +494,35 @@ void spdm_init_context(IN void *spdm_context);
 */
 void spdm_reset_context(IN void *context);
 
+/**
+  Fill the DHE key pools of an SPDM context with ephemeral key pairs.
+
+  The SPDM context keeps one DHE key pool per DHE group. KEY_EXCHANGE takes a ready key
+  pair from the pool of the negotiated group instead of generating one inline.
+  The pool of the negotiated DHE group is filled. If the DHE group is not negotiated yet,
+  the pool of every DHE group in the local algorithms is filled. Pools of other DHE groups
+  are kept.
+
+  A pool that gave a key pair to KEY_EXCHANGE is refilled automatically: by the requester
+  when FINISH_RSP completes the handshake, and by spdm_responder_dispatch_message after
+  the response is sent. A responder that calls spdm_process_message directly may call this
+  function after it sends the response. This function must not run concurrently with
+  other calls on the same SPDM context.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+
+  @retval RETURN_SUCCESS               The DHE key pools are full.
+  @retval RETURN_DEVICE_ERROR          A key pair cannot be generated.
+**/
+return_status spdm_refill_dhe_key_pool(IN void *spdm_context);
+
+/**
+  Release all key pairs in the DHE key pools of an SPDM context.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+**/
+void spdm_free_dhe_key_pool(IN void *spdm_context);
+
 /**
   Return the size in bytes of the SPDM context.
 
@@ -287,6 +530,31 @@ void spdm_reset_context(IN void *context);
 **/
 uintn spdm_get_context_size(void);
 
+/**
+  Return the size in bytes of the SPDM context with a session table of a given capacity.
+
+  @param  max_session_count             The maximum number of concurrent sessions.
+
+  @return the size in bytes of the SPDM context.
+**/
+uintn spdm_get_context_size_ex(IN uintn max_session_count);
+
+/**
+  Return the size in bytes of an SPDM context that uses a shared SPDM local context.
+
+  @param  max_session_count             The maximum number of concurrent sessions.
+
+  @return the size in bytes of the SPDM context.
+**/
+uintn spdm_get_context_size_with_local_context(IN uintn max_session_count);
+
+/**
+  Return the size in bytes of an SPDM local context.
+
+  @return the size in bytes of the SPDM local context.
+**/
+uintn spdm_get_local_context_size(void);
+
 /**
   Send an SPDM transport layer message to a device.
 
@@ -416,6 +684,7 @@ typedef return_status (*spdm_transport_encode_message_func)(
   @param  is_requester                  Indicates if it is a requester message.
   @param  transport_message_size         size in bytes of the transport message data buffer.
   @param  transport_message             A pointer to a source buffer to store the transport message.
+                                       The transport layer may decode a secured message in place in this buffer.
   @param  message_size                  size in bytes of the message data buffer.
   @param  message                      A pointer to a destination buffer to store the message.
 
@@ -426,7 +695,7 @@ typedef return_status (*spdm_transport_encode_message_func)(
 typedef return_status (*spdm_transport_decode_message_func)(
 	IN void *spdm_context, OUT uint32 **session_id,
 	OUT boolean *is_app_message, IN boolean is_requester,
-	IN uintn transport_message_size, IN void *transport_message,
+	IN uintn transport_message_size, IN OUT void *transport_message,
 	IN OUT uintn *message_size, OUT void *message);
 
 /**
@@ -443,6 +712,132 @@ void spdm_register_transport_layer_func(
 	IN spdm_transport_encode_message_func transport_encode_message,
 	IN spdm_transport_decode_message_func transport_decode_message);
 
+/**
+  Allocate a buffer from a caller-supplied arena.
+
+  @param  arena                         A pointer to the arena registered by spdm_register_arena_func.
+  @param  size                          size in bytes of the buffer to allocate.
+
+  @return A pointer to the allocated buffer, or NULL if the arena is exhausted.
+**/
+typedef void *(*spdm_arena_allocate_func)(IN void *arena, IN uintn size);
+
+/**
+  Return a buffer allocated by spdm_arena_allocate_func to a caller-supplied arena.
+
+  @param  arena                         A pointer to the arena registered by spdm_register_arena_func.
+  @param  buffer                        A pointer to the buffer to free.
+**/
+typedef void (*spdm_arena_free_func)(IN void *arena, IN void *buffer);
+
+/**
+  Register a caller-supplied arena for the large SPDM buffers.
+
+  If OPENSPDM_ARENA_MANAGED_BUFFER_SUPPORT is 1, the message B, MutB, M, K and F transcripts
+  and the encapsulated certificate chain buffer are not placed in the SPDM context. They are
+  allocated from the arena when data is appended, grow to the size actually used, and are
+  returned to the arena when they are reset. The last and the cached SPDM request buffers
+  are allocated from the arena on first use, and are returned by spdm_deinit_context. Since the SPDM context has no inline storage
+  for them then, an arena must be registered: without one, spdm_send_request and
+  spdm_process_request fail with RETURN_OUT_OF_RESOURCES. If
+  OPENSPDM_ARENA_MANAGED_BUFFER_SUPPORT is 0, the arena is never used.
+
+  This function must be called after spdm_init_context, and before any SPDM communication.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  arena                         A pointer to the arena, passed to allocate_func and free_func.
+  @param  allocate_func                 The fuction to allocate a buffer from the arena.
+  @param  free_func                     The fuction to return a buffer to the arena.
+**/
+void spdm_register_arena_func(IN void *spdm_context, IN void *arena,
+			      IN spdm_arena_allocate_func allocate_func,
+			      IN spdm_arena_free_func free_func);
+
+/**
+  Register a certificate chain verify cache to verify the peer certificate chains.
+
+  The cache is allocated by the caller with spdm_get_cert_chain_verify_cache_size bytes and
+  initialized by spdm_flush_cert_chain_verify_cache. It may be shared by several SPDM contexts,
+  for example the contexts of devices with the same intermediate and root certificates, but
+  it is not protected by a lock: the SPDM contexts sharing it must not run on several threads
+  at the same time. Without a registered cache, the peer certificate chains are verified in full.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  cert_chain_verify_cache         A pointer to the certificate chain verify cache, or NULL.
+**/
+void spdm_register_cert_chain_verify_cache(
+	IN void *spdm_context, IN void *cert_chain_verify_cache OPTIONAL);
+
+/**
+  Return a monotonic timestamp, in microseconds.
+
+  @return The current timestamp.
+**/
+typedef uint64 (*spdm_get_timestamp_func)(void);
+
+/**
+  Register the function to get a monotonic timestamp for the SPDM statistics.
+
+  If no function is registered, the statistics still count the messages,
+  but no time is recorded.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  get_timestamp_func            The fuction to get a monotonic timestamp.
+**/
+void spdm_register_get_timestamp_func(
+	IN void *spdm_context, IN spdm_get_timestamp_func get_timestamp_func);
+
+/**
+  Return the request statistics index of an SPDM request code.
+
+  @param  request_code                  The SPDM request code.
+
+  @return The index in the request statistics,
+          or SPDM_STATISTICS_REQUEST_CODE_INDEX_OTHER for an unknown request code.
+**/
+uintn spdm_get_statistics_request_code_index(IN uint8 request_code);
+
+/**
+  Return the size in bytes of a trace buffer.
+
+  @param  event_count                   The number of events the trace buffer holds.
+                                       It must be a power of 2.
+
+  @return the size in bytes of the trace buffer.
+**/
+uintn spdm_get_trace_buffer_size(IN uint32 event_count);
+
+/**
+  Initialize an empty trace buffer.
+
+  The trace buffer may be registered to many SPDM contexts, which may be used concurrently.
+  The events are reserved without a lock, and the oldest events are overwritten when the
+  ring is full. A live reader copies an event only if its sequence is not 0, and keeps the
+  copy only if the sequence is unchanged after the copy. Without compiler atomic operations
+  (GCC, clang or MSVC), the SPDM contexts sharing the trace buffer must not be used
+  concurrently.
+
+  @param  trace_buffer                   A pointer to the trace buffer,
+                                       of the size returned by spdm_get_trace_buffer_size.
+  @param  event_count                   The number of events the trace buffer holds.
+                                       It must be a power of 2.
+  @param  flags                         The trace buffer flags (SPDM_TRACE_BUFFER_FLAG_*).
+**/
+void spdm_init_trace_buffer(IN void *trace_buffer, IN uint32 event_count,
+			    IN uint32 flags);
+
+/**
+  Register a trace buffer to record the messages of an SPDM context.
+
+  If OPENSPDM_TRACE_SUPPORT is 0, the trace buffer is never used.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  trace_buffer                   A pointer to a trace buffer initialized by
+                                       spdm_init_trace_buffer. NULL means no trace.
+**/
+void spdm_register_trace_buffer(IN void *spdm_context,
+				IN void *trace_buffer OPTIONAL);
+
 /**
   Reset message A cache in SPDM context.
 
@@ -575,15 +970,24 @@ return_status spdm_append_message_m(IN void *spdm_context, IN void *message,
 /**
   Append message K cache in SPDM context.
 
+  NOTE: This function used to take only spdm_session_info, message and message_size.
+  The SPDM context and the role are now required, so that the running TH hash
+  can be seeded with A and the hash of the right certificate chain.
+  Callers of the old 3-parameter form must be updated.
+
+  @param  spdm_context                  A pointer to the SPDM context.
   @param  spdm_session_info              A pointer to the SPDM session context.
+  @param  is_requester                  Indicate of the message K for a requester or a responder.
   @param  message                      message buffer.
   @param  message_size                  size in bytes of message buffer.
 
   @return RETURN_SUCCESS          message is appended.
   @return RETURN_OUT_OF_RESOURCES message is not appended because the internal cache is full.
 **/
-return_status spdm_append_message_k(IN void *spdm_session_info,
-				    IN void *message, IN uintn message_size);
+return_status spdm_append_message_k(IN void *spdm_context,
+				    IN void *spdm_session_info,
+				    IN boolean is_requester, IN void *message,
+				    IN uintn message_size);
 
 /**
   Append message F cache in SPDM context.
@@ -691,6 +1095,43 @@ boolean spdm_calculate_th_for_finish(IN void *spdm_context,
 				     OPTIONAL IN OUT uintn *th_data_buffer_size,
 				     OUT void *th_data_buffer);
 
+/*
+  This function calculates current TH hash with message A and message K.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  session_info                  The SPDM session ID.
+  @param  cert_chain_data                Certitiface chain data without spdm_cert_chain_t header.
+  @param  cert_chain_data_size            size in bytes of the certitiface chain data.
+  @param  th_hash                        The buffer to store the TH hash.
+
+  @retval TRUE  current TH hash is calculated.
+  @retval FALSE current TH hash is not calculated.
+*/
+boolean spdm_calculate_th_hash_for_exchange(
+	IN void *spdm_context, IN void *spdm_session_info,
+	IN uint8 *cert_chain_data, OPTIONAL IN uintn cert_chain_data_size,
+	OUT uint8 *th_hash);
+
+/*
+  This function calculates current TH hash with message A, message K and message F.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  session_info                  The SPDM session ID.
+  @param  cert_chain_data                Certitiface chain data without spdm_cert_chain_t header.
+  @param  cert_chain_data_size            size in bytes of the certitiface chain data.
+  @param  mut_cert_chain_data             Certitiface chain data without spdm_cert_chain_t header in mutual authentication.
+  @param  mut_cert_chain_data_size         size in bytes of the certitiface chain data in mutual authentication.
+  @param  th_hash                        The buffer to store the TH hash.
+
+  @retval TRUE  current TH hash is calculated.
+  @retval FALSE current TH hash is not calculated.
+*/
+boolean spdm_calculate_th_hash_for_finish(
+	IN void *spdm_context, IN void *spdm_session_info,
+	IN uint8 *cert_chain_data, OPTIONAL IN uintn cert_chain_data_size,
+	OPTIONAL IN uint8 *mut_cert_chain_data,
+	OPTIONAL IN uintn mut_cert_chain_data_size, OUT uint8 *th_hash);
+
 /*
   This function calculates th1 hash.
 
@@ -21,6 +21,14 @@
 #define MAX_AEAD_KEY_SIZE 32
 #define MAX_AEAD_IV_SIZE 12
 
+///
+/// One element of a scatter-gather list passed to spdm_hash_multi() or spdm_hmac_multi().
+///
+typedef struct {
+	const void *data;
+	uintn data_size;
+} spdm_iovec_t;
+
 /**
   Computes the hash of a input data buffer.
 
@@ -36,6 +44,69 @@
 typedef boolean (*hash_all_func)(IN const void *data, IN uintn data_size,
 				 OUT uint8 *hash_value);
 
+/**
+  Allocates and initializes one HASH_CTX context for subsequent hash use.
+
+  @return  Pointer to the HASH_CTX context that has been initialized.
+           If the allocations fails, hash_new_func() returns NULL.
+**/
+typedef void *(*hash_new_func)(void);
+
+/**
+  Release the specified HASH_CTX context.
+
+  @param  hash_context                   Pointer to the HASH_CTX context to be released.
+**/
+typedef void (*hash_free_func)(IN void *hash_context);
+
+/**
+  Initializes user-supplied memory pointed by hash_context as hash context for
+  subsequent use.
+
+  @param  hash_context                   Pointer to hash context being initialized.
+
+  @retval TRUE   hash context initialization succeeded.
+  @retval FALSE  hash context initialization failed.
+**/
+typedef boolean (*hash_init_func)(OUT void *hash_context);
+
+/**
+  Makes a copy of an existing hash context.
+
+  @param  hash_context                   Pointer to hash context being copied.
+  @param  new_hash_context               Pointer to new hash context.
+
+  @retval TRUE   hash context copy succeeded.
+  @retval FALSE  hash context copy failed.
+**/
+typedef boolean (*hash_duplicate_func)(IN const void *hash_context,
+				       OUT void *new_hash_context);
+
+/**
+  Digests the input data and updates hash context.
+
+  @param  hash_context                   Pointer to the hash context.
+  @param  data                         Pointer to the buffer containing the data to be hashed.
+  @param  data_size                     size of data buffer in bytes.
+
+  @retval TRUE   hash data digest succeeded.
+  @retval FALSE  hash data digest failed.
+**/
+typedef boolean (*hash_update_func)(IN OUT void *hash_context,
+				    IN const void *data, IN uintn data_size);
+
+/**
+  Completes computation of the hash digest value.
+
+  @param  hash_context                   Pointer to the hash context.
+  @param  hash_value                    Pointer to a buffer that receives the hash value.
+
+  @retval TRUE   hash digest computation succeeded.
+  @retval FALSE  hash digest computation failed.
+**/
+typedef boolean (*hash_final_func)(IN OUT void *hash_context,
+				   OUT uint8 *hash_value);
+
 /**
   Computes the HMAC of a input data buffer.
 
@@ -54,6 +125,79 @@ typedef boolean (*hmac_all_func)(IN const void *data, IN uintn data_size,
 				 IN const uint8 *key, IN uintn key_size,
 				 OUT uint8 *hmac_value);
 
+/**
+  Allocates and initializes one HMAC_CTX context for subsequent HMAC use.
+
+  @return  Pointer to the HMAC_CTX context that has been initialized.
+           If the allocations fails, hmac_new_func() returns NULL.
+**/
+typedef void *(*hmac_new_func)(void);
+
+/**
+  Release the specified HMAC_CTX context.
+
+  @param  hmac_context                   Pointer to the HMAC_CTX context to be released.
+**/
+typedef void (*hmac_free_func)(IN void *hmac_context);
+
+/**
+  Set user-supplied key for subsequent use. It must be done before any
+  calling to hmac_update_func().
+
+  @param  hmac_context                   Pointer to HMAC context.
+  @param  key                          Pointer to the user-supplied key.
+  @param  key_size                      key size in bytes.
+
+  @retval TRUE   The key is set successfully.
+  @retval FALSE  The key is set unsuccessfully.
+**/
+typedef boolean (*hmac_set_key_func)(OUT void *hmac_context,
+				     IN const uint8 *key, IN uintn key_size);
+
+/**
+  Digests the input data and updates HMAC context.
+
+  This function can be called multiple times to compute the HMAC of long or discontinuous data streams.
+
+  @param  hmac_context                   Pointer to the HMAC context.
+  @param  data                         Pointer to the buffer containing the data to be HMACed.
+  @param  data_size                     size of data buffer in bytes.
+
+  @retval TRUE   HMAC data digest succeeded.
+  @retval FALSE  HMAC data digest failed.
+**/
+typedef boolean (*hmac_update_func)(IN OUT void *hmac_context,
+				    IN const void *data, IN uintn data_size);
+
+/**
+  Completes computation of the HMAC digest value.
+
+  The HMAC context cannot be used for further update after this call.
+
+  @param  hmac_context                   Pointer to the HMAC context.
+  @param  hmac_value                    Pointer to a buffer that receives the HMAC value.
+
+  @retval TRUE   HMAC digest computation succeeded.
+  @retval FALSE  HMAC digest computation failed.
+**/
+typedef boolean (*hmac_final_func)(IN OUT void *hmac_context,
+				   OUT uint8 *hmac_value);
+
+/**
+  Makes a copy of an existing HMAC context.
+
+  The keyed state is copied, so the new context can digest a message
+  without running the HMAC key setup again.
+
+  @param  hmac_context                   Pointer to the HMAC context being copied.
+  @param  new_hmac_context               Pointer to the new HMAC context.
+
+  @retval TRUE   HMAC context copy succeeded.
+  @retval FALSE  HMAC context copy failed.
+**/
+typedef boolean (*hmac_duplicate_func)(IN const void *hmac_context,
+				       OUT void *new_hmac_context);
+
 /**
   Derive HMAC-based Expand key Derivation Function (HKDF) Expand.
 
@@ -261,6 +405,73 @@ typedef boolean (*aead_decrypt_func)(
 	IN const uint8 *data_in, IN uintn data_in_size, IN const uint8 *tag,
 	IN uintn tag_size, OUT uint8 *data_out, OUT uintn *data_out_size);
 
+/**
+  Allocates and initializes one AEAD context with the key for subsequent use.
+
+  @param  key                          Pointer to the encryption key.
+  @param  key_size                      size of the encryption key in bytes.
+
+  @return  Pointer to the AEAD context that has been initialized.
+**/
+typedef void *(*aead_new_func)(IN const uint8 *key, IN uintn key_size);
+
+/**
+  Release the specified AEAD context.
+
+  @param  aead_context                   Pointer to the AEAD context to be released.
+**/
+typedef void (*aead_free_func)(IN void *aead_context);
+
+/**
+  Performs AEAD authenticated encryption on a data buffer and additional authenticated data (AAD),
+  with a keyed AEAD context.
+
+  @param  aead_context                   Pointer to the AEAD context.
+  @param  iv                           Pointer to the IV value.
+  @param  iv_size                       size of the IV value in bytes.
+  @param  a_data                        Pointer to the additional authenticated data (AAD).
+  @param  a_data_size                    size of the additional authenticated data (AAD) in bytes.
+  @param  data_in                       Pointer to the input data buffer to be encrypted.
+  @param  data_in_size                   size of the input data buffer in bytes.
+  @param  tag_out                       Pointer to a buffer that receives the authentication tag output.
+  @param  tag_size                      size of the authentication tag in bytes.
+  @param  data_out                      Pointer to a buffer that receives the encryption output.
+  @param  data_out_size                  size of the output data buffer in bytes.
+
+  @retval TRUE   AEAD authenticated encryption succeeded.
+  @retval FALSE  AEAD authenticated encryption failed.
+**/
+typedef boolean (*aead_encrypt_with_context_func)(
+	IN void *aead_context, IN const uint8 *iv, IN uintn iv_size,
+	IN const uint8 *a_data, IN uintn a_data_size, IN const uint8 *data_in,
+	IN uintn data_in_size, OUT uint8 *tag_out, IN uintn tag_size,
+	OUT uint8 *data_out, OUT uintn *data_out_size);
+
+/**
+  Performs AEAD authenticated decryption on a data buffer and additional authenticated data (AAD),
+  with a keyed AEAD context.
+
+  @param  aead_context                   Pointer to the AEAD context.
+  @param  iv                           Pointer to the IV value.
+  @param  iv_size                       size of the IV value in bytes.
+  @param  a_data                        Pointer to the additional authenticated data (AAD).
+  @param  a_data_size                    size of the additional authenticated data (AAD) in bytes.
+  @param  data_in                       Pointer to the input data buffer to be decrypted.
+  @param  data_in_size                   size of the input data buffer in bytes.
+  @param  tag                          Pointer to a buffer that contains the authentication tag.
+  @param  tag_size                      size of the authentication tag in bytes.
+  @param  data_out                      Pointer to a buffer that receives the decryption output.
+  @param  data_out_size                  size of the output data buffer in bytes.
+
+  @retval TRUE   AEAD authenticated decryption succeeded.
+  @retval FALSE  AEAD authenticated decryption failed.
+**/
+typedef boolean (*aead_decrypt_with_context_func)(
+	IN void *aead_context, IN const uint8 *iv, IN uintn iv_size,
+	IN const uint8 *a_data, IN uintn a_data_size, IN const uint8 *data_in,
+	IN uintn data_in_size, IN const uint8 *tag, IN uintn tag_size,
+	OUT uint8 *data_out, OUT uintn *data_out_size);
+
 /**
   This function returns the SPDM hash algorithm size.
 
@@ -286,6 +497,99 @@ uint32 spdm_get_hash_size(IN uint32 base_hash_algo);
 boolean spdm_hash_all(IN uint32 base_hash_algo, IN const void *data,
 		      IN uintn data_size, OUT uint8 *hash_value);
 
+/**
+  Allocates and initializes one HASH_CTX context for subsequent hash use, based upon the negotiated hash algorithm.
+
+  @param  base_hash_algo                 SPDM base_hash_algo
+
+  @return  Pointer to the HASH_CTX context that has been initialized.
+           If the allocations fails, spdm_hash_new() returns NULL.
+**/
+void *spdm_hash_new(IN uint32 base_hash_algo);
+
+/**
+  Release the specified HASH_CTX context, based upon the negotiated hash algorithm.
+
+  @param  base_hash_algo                 SPDM base_hash_algo
+  @param  hash_context                   Pointer to the HASH_CTX context to be released.
+**/
+void spdm_hash_free(IN uint32 base_hash_algo, IN void *hash_context);
+
+/**
+  Initializes user-supplied memory pointed by hash_context as hash context for
+  subsequent use, based upon the negotiated hash algorithm.
+
+  @param  base_hash_algo                 SPDM base_hash_algo
+  @param  hash_context                   Pointer to hash context being initialized.
+
+  @retval TRUE   hash context initialization succeeded.
+  @retval FALSE  hash context initialization failed.
+**/
+boolean spdm_hash_init(IN uint32 base_hash_algo, OUT void *hash_context);
+
+/**
+  Makes a copy of an existing hash context, based upon the negotiated hash algorithm.
+
+  @param  base_hash_algo                 SPDM base_hash_algo
+  @param  hash_context                   Pointer to hash context being copied.
+  @param  new_hash_context               Pointer to new hash context.
+
+  @retval TRUE   hash context copy succeeded.
+  @retval FALSE  hash context copy failed.
+**/
+boolean spdm_hash_duplicate(IN uint32 base_hash_algo,
+			    IN const void *hash_context,
+			    OUT void *new_hash_context);
+
+/**
+  Digests the input data and updates hash context, based upon the negotiated hash algorithm.
+
+  This function can be called multiple times to compute the digest of long or discontinuous data streams.
+
+  @param  base_hash_algo                 SPDM base_hash_algo
+  @param  hash_context                   Pointer to the hash context.
+  @param  data                         Pointer to the buffer containing the data to be hashed.
+  @param  data_size                     size of data buffer in bytes.
+
+  @retval TRUE   hash data digest succeeded.
+  @retval FALSE  hash data digest failed.
+**/
+boolean spdm_hash_update(IN uint32 base_hash_algo, IN OUT void *hash_context,
+			 IN const void *data, IN uintn data_size);
+
+/**
+  Completes computation of the hash digest value, based upon the negotiated hash algorithm.
+
+  The hash context cannot be used for further update after this call.
+
+  @param  base_hash_algo                 SPDM base_hash_algo
+  @param  hash_context                   Pointer to the hash context.
+  @param  hash_value                    Pointer to a buffer that receives the hash value.
+
+  @retval TRUE   hash digest computation succeeded.
+  @retval FALSE  hash digest computation failed.
+**/
+boolean spdm_hash_final(IN uint32 base_hash_algo, IN OUT void *hash_context,
+			OUT uint8 *hash_value);
+
+/**
+  Computes the hash of a list of discontinuous data buffers, based upon the negotiated hash algorithm.
+
+  The result is identical to spdm_hash_all() over the concatenation of all buffers,
+  but the caller does not need to assemble the concatenation in a temporary buffer.
+
+  @param  base_hash_algo                 SPDM base_hash_algo
+  @param  iov                          Pointer to the array of data buffers to be hashed, in order.
+                                       An element with data_size 0 is skipped.
+  @param  iov_count                     Number of elements in iov.
+  @param  hash_value                    Pointer to a buffer that receives the hash value.
+
+  @retval TRUE   hash computation succeeded.
+  @retval FALSE  hash computation failed.
+**/
+boolean spdm_hash_multi(IN uint32 base_hash_algo, IN const spdm_iovec_t *iov,
+			IN uintn iov_count, OUT uint8 *hash_value);
+
 /**
   This function returns the SPDM measurement hash algorithm size.
 
@@ -332,6 +636,93 @@ boolean spdm_hmac_all(IN uint32 base_hash_algo, IN const void *data,
 		      IN uintn data_size, IN const uint8 *key,
 		      IN uintn key_size, OUT uint8 *hmac_value);
 
+/**
+  Computes the HMAC of a list of discontinuous data buffers, based upon the negotiated HMAC algorithm.
+
+  The result is identical to spdm_hmac_all() over the concatenation of all buffers,
+  but the caller does not need to assemble the concatenation in a temporary buffer.
+
+  @param  base_hash_algo                 SPDM base_hash_algo
+  @param  iov                          Pointer to the array of data buffers to be HMACed, in order.
+                                       An element with data_size 0 is skipped.
+  @param  iov_count                     Number of elements in iov.
+  @param  key                          Pointer to the user-supplied key.
+  @param  key_size                      key size in bytes.
+  @param  hmac_value                    Pointer to a buffer that receives the HMAC value.
+
+  @retval TRUE   HMAC computation succeeded.
+  @retval FALSE  HMAC computation failed.
+**/
+boolean spdm_hmac_multi(IN uint32 base_hash_algo, IN const spdm_iovec_t *iov,
+			IN uintn iov_count, IN const uint8 *key,
+			IN uintn key_size, OUT uint8 *hmac_value);
+
+/**
+  Allocates one HMAC context and sets the key, based upon the negotiated HMAC algorithm.
+
+  The returned keyed HMAC context holds the inner and outer padded key state,
+  so one secret used for several HMAC or HKDF-Expand operations pays the
+  key setup once.
+
+  @param  base_hash_algo                 SPDM base_hash_algo
+  @param  key                          Pointer to the user-supplied key.
+  @param  key_size                      key size in bytes.
+
+  @return  Pointer to the keyed HMAC context.
+           If the allocation or the key setup fails, NULL is returned.
+**/
+void *spdm_hmac_new_with_key(IN uint32 base_hash_algo, IN const uint8 *key,
+			     IN uintn key_size);
+
+/**
+  Release the keyed HMAC context, based upon the negotiated HMAC algorithm.
+
+  @param  base_hash_algo                 SPDM base_hash_algo
+  @param  hmac_key_context               Pointer to the keyed HMAC context to be released.
+**/
+void spdm_hmac_free_with_key(IN uint32 base_hash_algo,
+			     IN void *hmac_key_context);
+
+/**
+  Computes the HMAC of a input data buffer with a keyed HMAC context, based upon the negotiated HMAC algorithm.
+
+  The keyed HMAC context is not modified, so it can be used again.
+
+  @param  base_hash_algo                 SPDM base_hash_algo
+  @param  hmac_key_context               Pointer to the keyed HMAC context.
+  @param  data                         Pointer to the buffer containing the data to be HMACed.
+  @param  data_size                     size of data buffer in bytes.
+  @param  hmac_value                    Pointer to a buffer that receives the HMAC value.
+
+  @retval TRUE   HMAC computation succeeded.
+  @retval FALSE  HMAC computation failed.
+**/
+boolean spdm_hmac_all_with_key(IN uint32 base_hash_algo,
+			       IN const void *hmac_key_context,
+			       IN const void *data, IN uintn data_size,
+			       OUT uint8 *hmac_value);
+
+/**
+  Computes the HMAC of a list of discontinuous data buffers with a keyed HMAC context,
+  based upon the negotiated HMAC algorithm.
+
+  The keyed HMAC context is not modified, so it can be used again.
+
+  @param  base_hash_algo                 SPDM base_hash_algo
+  @param  hmac_key_context               Pointer to the keyed HMAC context.
+  @param  iov                          Pointer to the array of data buffers to be HMACed, in order.
+                                       An element with data_size 0 is skipped.
+  @param  iov_count                     Number of elements in iov.
+  @param  hmac_value                    Pointer to a buffer that receives the HMAC value.
+
+  @retval TRUE   HMAC computation succeeded.
+  @retval FALSE  HMAC computation failed.
+**/
+boolean spdm_hmac_multi_with_key(IN uint32 base_hash_algo,
+				 IN const void *hmac_key_context,
+				 IN const spdm_iovec_t *iov, IN uintn iov_count,
+				 OUT uint8 *hmac_value);
+
 /**
   Derive HMAC-based Expand key Derivation Function (HKDF) Expand, based upon the negotiated HKDF algorithm.
 
@@ -350,6 +741,28 @@ boolean spdm_hkdf_expand(IN uint32 base_hash_algo, IN const uint8 *prk,
 			 IN uintn prk_size, IN const uint8 *info,
 			 IN uintn info_size, OUT uint8 *out, IN uintn out_size);
 
+/**
+  Derive HMAC-based Expand key Derivation Function (HKDF) Expand with a keyed HMAC context,
+  based upon the negotiated HKDF algorithm.
+
+  The keyed HMAC context is created by spdm_hmac_new_with_key() with the PRK,
+  and is not modified, so it can be used again for another info.
+
+  @param  base_hash_algo                 SPDM base_hash_algo
+  @param  prk_hmac_key_context           Pointer to the HMAC context keyed with the PRK.
+  @param  info                         Pointer to the application specific info.
+  @param  info_size                     info size in bytes.
+  @param  out                          Pointer to buffer to receive hkdf value.
+  @param  out_size                      size of hkdf bytes to generate.
+
+  @retval TRUE   Hkdf generated successfully.
+  @retval FALSE  Hkdf generation failed.
+**/
+boolean spdm_hkdf_expand_with_key(IN uint32 base_hash_algo,
+				  IN const void *prk_hmac_key_context,
+				  IN const uint8 *info, IN uintn info_size,
+				  OUT uint8 *out, IN uintn out_size);
+
 /**
   This function returns the SPDM asymmetric algorithm size.
 
@@ -406,6 +819,26 @@ boolean spdm_asym_verify(IN uint32 base_asym_algo, IN uint32 base_hash_algo,
 			 IN uintn message_size, IN const uint8 *signature,
 			 IN uintn sig_size);
 
+/**
+  Verifies the asymmetric signature of a message hash,
+  based upon negotiated asymmetric algorithm.
+
+  @param  base_asym_algo                 SPDM base_asym_algo
+  @param  base_hash_algo                 SPDM base_hash_algo
+  @param  context                      Pointer to asymmetric context for signature verification.
+  @param  message_hash                  Pointer to the hash of the message to be checked.
+  @param  hash_size                     size of the message hash in bytes.
+  @param  signature                    Pointer to asymmetric signature to be verified.
+  @param  sig_size                      size of signature in bytes.
+
+  @retval  TRUE   Valid asymmetric signature.
+  @retval  FALSE  Invalid asymmetric signature or invalid asymmetric context.
+**/
+boolean spdm_asym_verify_hash(IN uint32 base_asym_algo,
+			      IN uint32 base_hash_algo, IN void *context,
+			      IN const uint8 *message_hash, IN uintn hash_size,
+			      IN const uint8 *signature, IN uintn sig_size);
+
 /**
   Retrieve the Private key from the password-protected PEM key data.
 
@@ -449,6 +882,30 @@ boolean spdm_asym_sign(IN uint32 base_asym_algo, IN uint32 base_hash_algo,
 		       IN uintn message_size, OUT uint8 *signature,
 		       IN OUT uintn *sig_size);
 
+/**
+  Carries out the signature generation of a message hash.
+
+  If the signature buffer is too small to hold the contents of signature, FALSE
+  is returned and sig_size is set to the required buffer size to obtain the signature.
+
+  @param  base_asym_algo                 SPDM base_asym_algo
+  @param  base_hash_algo                 SPDM base_hash_algo
+  @param  context                      Pointer to asymmetric context for signature generation.
+  @param  message_hash                  Pointer to the hash of the message to be signed.
+  @param  hash_size                     size of the message hash in bytes.
+  @param  signature                    Pointer to buffer to receive signature.
+  @param  sig_size                      On input, the size of signature buffer in bytes.
+                                       On output, the size of data returned in signature buffer in bytes.
+
+  @retval  TRUE   signature successfully generated.
+  @retval  FALSE  signature generation failed.
+  @retval  FALSE  sig_size is too small.
+**/
+boolean spdm_asym_sign_hash(IN uint32 base_asym_algo, IN uint32 base_hash_algo,
+			    IN void *context, IN const uint8 *message_hash,
+			    IN uintn hash_size, OUT uint8 *signature,
+			    IN OUT uintn *sig_size);
+
 /**
   This function returns the SPDM requester asymmetric algorithm size.
 
@@ -505,6 +962,27 @@ boolean spdm_req_asym_verify(IN uint16 req_base_asym_alg,
 			     IN const uint8 *message, IN uintn message_size,
 			     IN const uint8 *signature, IN uintn sig_size);
 
+/**
+  Verifies the asymmetric signature of a message hash,
+  based upon negotiated requester asymmetric algorithm.
+
+  @param  req_base_asym_alg               SPDM req_base_asym_alg
+  @param  base_hash_algo                 SPDM base_hash_algo
+  @param  context                      Pointer to asymmetric context for signature verification.
+  @param  message_hash                  Pointer to the hash of the message to be checked.
+  @param  hash_size                     size of the message hash in bytes.
+  @param  signature                    Pointer to asymmetric signature to be verified.
+  @param  sig_size                      size of signature in bytes.
+
+  @retval  TRUE   Valid asymmetric signature.
+  @retval  FALSE  Invalid asymmetric signature or invalid asymmetric context.
+**/
+boolean spdm_req_asym_verify_hash(IN uint16 req_base_asym_alg,
+				  IN uint32 base_hash_algo, IN void *context,
+				  IN const uint8 *message_hash,
+				  IN uintn hash_size, IN const uint8 *signature,
+				  IN uintn sig_size);
+
 /**
   Retrieve the Private key from the password-protected PEM key data.
 
@@ -548,6 +1026,30 @@ boolean spdm_req_asym_sign(IN uint16 req_base_asym_alg,
 			   IN const uint8 *message, IN uintn message_size,
 			   OUT uint8 *signature, IN OUT uintn *sig_size);
 
+/**
+  Carries out the signature generation of a message hash.
+
+  If the signature buffer is too small to hold the contents of signature, FALSE
+  is returned and sig_size is set to the required buffer size to obtain the signature.
+
+  @param  req_base_asym_alg               SPDM req_base_asym_alg
+  @param  base_hash_algo                 SPDM base_hash_algo
+  @param  context                      Pointer to asymmetric context for signature generation.
+  @param  message_hash                  Pointer to the hash of the message to be signed.
+  @param  hash_size                     size of the message hash in bytes.
+  @param  signature                    Pointer to buffer to receive signature.
+  @param  sig_size                      On input, the size of signature buffer in bytes.
+                                       On output, the size of data returned in signature buffer in bytes.
+
+  @retval  TRUE   signature successfully generated.
+  @retval  FALSE  signature generation failed.
+  @retval  FALSE  sig_size is too small.
+**/
+boolean spdm_req_asym_sign_hash(IN uint16 req_base_asym_alg,
+				IN uint32 base_hash_algo, IN void *context,
+				IN const uint8 *message_hash, IN uintn hash_size,
+				OUT uint8 *signature, IN OUT uintn *sig_size);
+
 /**
   This function returns the SPDM DHE algorithm key size.
 
@@ -708,6 +1210,82 @@ boolean spdm_aead_decryption(IN uint16 aead_cipher_suite, IN const uint8 *key,
 			     IN uintn tag_size, OUT uint8 *data_out,
 			     OUT uintn *data_out_size);
 
+/**
+  Allocates and initializes one AEAD context with the key, based upon negotiated AEAD algorithm.
+
+  The key schedule is performed once, so the context should be kept for all records
+  protected by the same key.
+
+  @param  aead_cipher_suite              SPDM aead_cipher_suite
+  @param  key                          Pointer to the encryption key.
+  @param  key_size                      size of the encryption key in bytes.
+
+  @return  Pointer to the AEAD context that has been initialized.
+           If the allocations fails, spdm_aead_new() returns NULL.
+**/
+void *spdm_aead_new(IN uint16 aead_cipher_suite, IN const uint8 *key,
+		    IN uintn key_size);
+
+/**
+  Release the specified AEAD context, based upon negotiated AEAD algorithm.
+
+  @param  aead_cipher_suite              SPDM aead_cipher_suite
+  @param  aead_context                   Pointer to the AEAD context to be released.
+**/
+void spdm_aead_free(IN uint16 aead_cipher_suite, IN void *aead_context);
+
+/**
+  Performs AEAD authenticated encryption on a data buffer and additional authenticated data (AAD),
+  with a keyed AEAD context, based upon negotiated AEAD algorithm.
+
+  @param  aead_cipher_suite              SPDM aead_cipher_suite
+  @param  aead_context                   Pointer to the AEAD context.
+  @param  iv                           Pointer to the IV value.
+  @param  iv_size                       size of the IV value in bytes.
+  @param  a_data                        Pointer to the additional authenticated data (AAD).
+  @param  a_data_size                    size of the additional authenticated data (AAD) in bytes.
+  @param  data_in                       Pointer to the input data buffer to be encrypted.
+  @param  data_in_size                   size of the input data buffer in bytes.
+  @param  tag_out                       Pointer to a buffer that receives the authentication tag output.
+  @param  tag_size                      size of the authentication tag in bytes.
+  @param  data_out                      Pointer to a buffer that receives the encryption output.
+  @param  data_out_size                  size of the output data buffer in bytes.
+
+  @retval TRUE   AEAD authenticated encryption succeeded.
+  @retval FALSE  AEAD authenticated encryption failed.
+**/
+boolean spdm_aead_encryption_with_context(
+	IN uint16 aead_cipher_suite, IN void *aead_context, IN const uint8 *iv,
+	IN uintn iv_size, IN const uint8 *a_data, IN uintn a_data_size,
+	IN const uint8 *data_in, IN uintn data_in_size, OUT uint8 *tag_out,
+	IN uintn tag_size, OUT uint8 *data_out, OUT uintn *data_out_size);
+
+/**
+  Performs AEAD authenticated decryption on a data buffer and additional authenticated data (AAD),
+  with a keyed AEAD context, based upon negotiated AEAD algorithm.
+
+  @param  aead_cipher_suite              SPDM aead_cipher_suite
+  @param  aead_context                   Pointer to the AEAD context.
+  @param  iv                           Pointer to the IV value.
+  @param  iv_size                       size of the IV value in bytes.
+  @param  a_data                        Pointer to the additional authenticated data (AAD).
+  @param  a_data_size                    size of the additional authenticated data (AAD) in bytes.
+  @param  data_in                       Pointer to the input data buffer to be decrypted.
+  @param  data_in_size                   size of the input data buffer in bytes.
+  @param  tag                          Pointer to a buffer that contains the authentication tag.
+  @param  tag_size                      size of the authentication tag in bytes.
+  @param  data_out                      Pointer to a buffer that receives the decryption output.
+  @param  data_out_size                  size of the output data buffer in bytes.
+
+  @retval TRUE   AEAD authenticated decryption succeeded.
+  @retval FALSE  AEAD authenticated decryption failed.
+**/
+boolean spdm_aead_decryption_with_context(
+	IN uint16 aead_cipher_suite, IN void *aead_context, IN const uint8 *iv,
+	IN uintn iv_size, IN const uint8 *a_data, IN uintn a_data_size,
+	IN const uint8 *data_in, IN uintn data_in_size, IN const uint8 *tag,
+	IN uintn tag_size, OUT uint8 *data_out, OUT uintn *data_out_size);
+
 /**
   Generates a random byte stream of the specified size.
 
@@ -720,6 +1298,9 @@ void spdm_get_random_number(IN uintn size, OUT uint8 *rand);
 /**
   Certificate Check for SPDM leaf cert.
 
+  The validity is checked against the current date and time if
+  spdm_register_current_date_time_func registered a function.
+
   @param[in]  cert            Pointer to the DER-encoded certificate data.
   @param[in]  cert_size        The size of certificate data in bytes.
 
@@ -819,4 +1400,113 @@ boolean spdm_verify_certificate_chain_buffer(IN uint32 base_hash_algo,
 					     IN void *cert_chain_buffer,
 					     IN uintn cert_chain_buffer_size);
 
+/**
+  Return the size in bytes of a certificate chain verify cache.
+
+  A certificate chain verify cache remembers the root and intermediate certificates of up to
+  MAX_SPDM_CERT_CHAIN_VERIFY_CACHE_COUNT verified certificate chains, so that devices sharing
+  them only have their leaf certificate verified. The cache is owned by the caller, and is
+  not protected by a lock: it must not be used from several threads at the same time.
+
+  @return the size in bytes of the certificate chain verify cache,
+          or 0 if MAX_SPDM_CERT_CHAIN_VERIFY_CACHE_COUNT is 0.
+**/
+uintn spdm_get_cert_chain_verify_cache_size(void);
+
+/**
+  This function forgets every certificate chain remembered as verified by a certificate
+  chain verify cache. It also initializes a new certificate chain verify cache.
+
+  A certificate chain is verified in full again the next time it is checked.
+  It should be called when the trust policy changes.
+
+  @param  cert_chain_verify_cache         A pointer to the certificate chain verify cache of
+                                       spdm_get_cert_chain_verify_cache_size bytes.
+**/
+void spdm_flush_cert_chain_verify_cache(IN OUT void *cert_chain_verify_cache);
+
+/**
+  This function verifies the integrity of certificate chain data without spdm_cert_chain_t header,
+  with a certificate chain verify cache.
+
+  The root and intermediate certificates are remembered in the cache once verified. A chain
+  whose root and intermediate certificates are in the cache only has its leaf certificate
+  verified.
+
+  @param  cert_chain_verify_cache         The certificate chain verify cache, or NULL to verify the chain in full.
+  @param  cert_chain_data          The certificate chain data without spdm_cert_chain_t header.
+  @param  cert_chain_data_size      size in bytes of the certificate chain data.
+
+  @retval TRUE  certificate chain data integrity verification pass.
+  @retval FALSE certificate chain data integrity verification fail.
+**/
+boolean spdm_verify_cert_chain_data_with_cache(
+	IN OUT void *cert_chain_verify_cache OPTIONAL, IN uint8 *cert_chain_data,
+	IN uintn cert_chain_data_size);
+
+/**
+  This function verifies the integrity of certificate chain buffer including spdm_cert_chain_t header,
+  with a certificate chain verify cache.
+
+  The root certificate hash, the root and the intermediate certificates are remembered in the
+  cache once verified. A chain whose root certificate hash, root and intermediate certificates
+  are in the cache only has its leaf certificate verified.
+
+  @param  cert_chain_verify_cache         The certificate chain verify cache, or NULL to verify the chain in full.
+  @param  base_hash_algo                 SPDM base_hash_algo
+  @param  cert_chain_buffer              The certificate chain buffer including spdm_cert_chain_t header.
+  @param  cert_chain_buffer_size          size in bytes of the certificate chain buffer.
+
+  @retval TRUE  certificate chain buffer integrity verification pass.
+  @retval FALSE certificate chain buffer integrity verification fail.
+**/
+boolean spdm_verify_certificate_chain_buffer_with_cache(
+	IN OUT void *cert_chain_verify_cache OPTIONAL, IN uint32 base_hash_algo,
+	IN void *cert_chain_buffer, IN uintn cert_chain_buffer_size);
+
+//
+// size in bytes of a date and time string like YYYYMMDDhhmmssZ, including the final null.
+//
+#define SPDM_DATE_TIME_STRING_SIZE 16
+
+/**
+  Get the current UTC date and time of the platform.
+
+  @param  date_time_str                  A buffer of SPDM_DATE_TIME_STRING_SIZE bytes.
+                                       On output, the current date and time like YYYYMMDDhhmmssZ.
+
+  @retval TRUE  The current date and time is returned.
+  @retval FALSE The current date and time is not available.
+**/
+typedef boolean (*spdm_get_current_date_time_func)(OUT char8 *date_time_str);
+
+/**
+  This function registers the platform function that returns the current date and time.
+
+  Once it is registered, the validity of a leaf certificate is checked against the current
+  date and time, both by spdm_x509_certificate_check and on every hit of the certificate
+  chain verify cache. Without it, only the bounds 1970 to 9999 are checked. The function
+  is process-global: it must be registered before any certificate is checked.
+
+  @param  get_current_date_time_func      The function to get the current date and time, or NULL.
+**/
+void spdm_register_current_date_time_func(
+	IN spdm_get_current_date_time_func get_current_date_time_func OPTIONAL);
+
+/**
+  Select the entry of a cache table to fill: the first empty entry, or else the least recently
+  used one.
+
+  Each entry holds a uint32 stamp of its last use at the same offset. A stamp of 0 marks an
+  empty entry.
+
+  @param  last_used                     A pointer to the last use stamp of the first entry.
+  @param  entry_count                   The number of entries in the table. It must not be 0.
+  @param  entry_size                    size in bytes of one entry.
+
+  @return the index of the selected entry.
+**/
+uintn spdm_select_lru_cache_entry(IN const uint32 *last_used,
+				  IN uintn entry_count, IN uintn entry_size);
+
 #endif
\ No newline at end of file
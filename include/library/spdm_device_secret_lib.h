@@ -74,6 +74,15 @@ typedef boolean (*spdm_responder_data_sign_func)(IN uint32 base_asym_algo,
 						 OUT uint8 *signature,
 						 IN OUT uintn *sig_size);
 
+/**
+  Free the private keys cached by the sign functions.
+
+  Call it when the device key is rotated or before the library is unloaded,
+  so that the next signing operation reloads the key.
+  It may be called while sign functions run on other threads.
+**/
+void spdm_flush_private_key_cache(void);
+
 /**
   Derive HMAC-based Expand key Derivation Function (HKDF) Expand, based upon the negotiated HKDF algorithm.
 
@@ -135,6 +144,26 @@ boolean spdm_requester_data_sign(IN uint16 req_base_asym_alg,
 				 IN const uint8 *message, IN uintn message_size,
 				 OUT uint8 *signature, IN OUT uintn *sig_size);
 
+/**
+  Sign an SPDM message hash.
+
+  @param  req_base_asym_alg               Indicates the signing algorithm.
+  @param  base_hash_algo                 Indicates the hash algorithm.
+  @param  message_hash                  A pointer to the hash of the message to be signed.
+  @param  hash_size                     The size in bytes of the message hash to be signed.
+  @param  signature                    A pointer to a destination buffer to store the signature.
+  @param  sig_size                      On input, indicates the size in bytes of the destination buffer to store the signature.
+                                       On output, indicates the size in bytes of the signature in the buffer.
+
+  @retval TRUE  signing success.
+  @retval FALSE signing fail.
+**/
+boolean spdm_requester_data_sign_hash(IN uint16 req_base_asym_alg,
+				      IN uint32 base_hash_algo,
+				      IN const uint8 *message_hash,
+				      IN uintn hash_size, OUT uint8 *signature,
+				      IN OUT uintn *sig_size);
+
 /**
   Sign an SPDM message data.
 
@@ -154,6 +183,26 @@ boolean spdm_responder_data_sign(IN uint32 base_asym_algo,
 				 IN const uint8 *message, IN uintn message_size,
 				 OUT uint8 *signature, IN OUT uintn *sig_size);
 
+/**
+  Sign an SPDM message hash.
+
+  @param  base_asym_algo                 Indicates the signing algorithm.
+  @param  base_hash_algo                 Indicates the hash algorithm.
+  @param  message_hash                  A pointer to the hash of the message to be signed.
+  @param  hash_size                     The size in bytes of the message hash to be signed.
+  @param  signature                    A pointer to a destination buffer to store the signature.
+  @param  sig_size                      On input, indicates the size in bytes of the destination buffer to store the signature.
+                                       On output, indicates the size in bytes of the signature in the buffer.
+
+  @retval TRUE  signing success.
+  @retval FALSE signing fail.
+**/
+boolean spdm_responder_data_sign_hash(IN uint32 base_asym_algo,
+				      IN uint32 base_hash_algo,
+				      IN const uint8 *message_hash,
+				      IN uintn hash_size, OUT uint8 *signature,
+				      IN OUT uintn *sig_size);
+
 /**
   Derive HMAC-based Expand key Derivation Function (HKDF) Expand, based upon the negotiated HKDF algorithm.
 
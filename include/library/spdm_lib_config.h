@@ -25,6 +25,74 @@
 #define MAX_SPDM_SESSION_STATE_CALLBACK_NUM 4
 #define MAX_SPDM_CONNECTION_STATE_CALLBACK_NUM 4
 
+//
+// Number of ephemeral DHE key pairs kept ready per DHE group by spdm_refill_dhe_key_pool().
+// Each key pair takes about MAX_DHE_KEY_SIZE bytes in the SPDM context for each of the
+// six DHE groups. 0 disables the pool and KEY_EXCHANGE always generates the key pair inline.
+//
+#define MAX_SPDM_DHE_KEY_POOL_COUNT 1
+
+//
+// Number of certificate chains whose verified root and intermediate certificates are
+// remembered by a certificate chain verify cache, see spdm_get_cert_chain_verify_cache_size().
+// 0 compiles the certificate chain verify cache out.
+//
+#define MAX_SPDM_CERT_CHAIN_VERIFY_CACHE_COUNT 8
+
+//
+// Transcript Configuation
+// If 1, the messages B, C, MutB and MutC are recorded in the transcript buffers,
+// and M1/M2 and TH hash are calculated from the concatenated transcript.
+// If 0, the messages B, C, MutB and MutC are not recorded. They and the message K are fed
+// into running hash contexts when appended, and M1/M2 and TH hash are finalized from a
+// duplicated hash context. The message K and F are still recorded for the finished_key HMAC.
+//
+#define OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT 1
+
+//
+// Managed Buffer Configuation
+// If 1, the large transcript buffers (message B, MutB, M, K and F) and the encapsulated
+// certificate chain buffer hold only a header in the SPDM context. Their data is allocated
+// from the arena registered by spdm_register_arena_func, grows to the size actually used,
+// and is returned to the arena on reset. The arena must be registered before any SPDM
+// message is sent or processed.
+// If 0, every managed buffer is placed inline at its worst-case size.
+//
+#define OPENSPDM_ARENA_MANAGED_BUFFER_SUPPORT 0
+
+//
+// Responder Statistics Configuation
+// If 1, the responder counts the invocations and the error responses of each request code,
+// and records the time spent in the handler, in signing and in the transport encode.
+// The statistics are read and reset by SPDM_DATA_RESPONDER_STATISTICS. The time is taken
+// from the function registered by spdm_register_get_timestamp_func.
+// If 0, no statistics are collected.
+//
+#define OPENSPDM_RESPONDER_STATISTICS_SUPPORT 0
+
+//
+// Requester Statistics Configuation
+// If 1, the requester counts the requests, the BUSY and the RESPONSE_NOT_READY errors
+// of each request code, and records the time spent in the transport encode, send,
+// receive, decode and in the signature verification.
+// The step API (spdm_begin_*) records no send and receive time, since the caller
+// moves the transport messages.
+// The statistics are read and reset by SPDM_DATA_REQUESTER_STATISTICS. The time is taken
+// from the function registered by spdm_register_get_timestamp_func.
+// If 0, no statistics are collected.
+//
+#define OPENSPDM_REQUESTER_STATISTICS_SUPPORT 0
+
+//
+// Trace Configuation
+// If 1, each SPDM or APP message sent or received by an SPDM context with a trace buffer
+// registered by spdm_register_trace_buffer is recorded as a fixed-size binary event,
+// instead of being dumped in hex through DEBUG. The transcript dumps of such a context
+// are skipped, because they repeat the traced messages.
+// If 0, the messages and the transcripts are dumped in hex through DEBUG.
+//
+#define OPENSPDM_TRACE_SUPPORT 0
+
 //
 // Crypto Configuation
 // In each category, at least one should be selected.
@@ -24,6 +24,7 @@
 
   @retval RETURN_SUCCESS               The SPDM request is sent successfully.
   @retval RETURN_DEVICE_ERROR          A device error occurs when the SPDM request is sent to the device.
+  @retval RETURN_OUT_OF_RESOURCES      No arena is registered while OPENSPDM_ARENA_MANAGED_BUFFER_SUPPORT is 1.
 **/
 return_status spdm_send_request(IN void *spdm_context, IN uint32 *session_id,
 				IN boolean is_app_message,
@@ -138,6 +139,88 @@ return_status spdm_get_certificate_choose_length(IN void *spdm_context,
 						 IN OUT uintn *cert_chain_size,
 						 OUT void *cert_chain);
 
+/**
+  Load a verified certificate chain from a persistent certificate chain store.
+
+  The store is trusted: a loaded certificate chain is not verified again, apart from
+  its digest and the provisioned root certificate hash or certificate chain.
+  The caller must protect the integrity of the store.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  base_hash_algo                 The hash algorithm of the digest.
+  @param  digest                       The digest of the certificate chain buffer, as reported in DIGESTS.
+  @param  cert_chain_size                On input, indicate the size in bytes of cert_chain.
+                                       On output, indicate the size in bytes of the certificate chain.
+  @param  cert_chain                    A pointer to a destination buffer to store the certificate chain buffer
+                                       including spdm_cert_chain_t header.
+
+  @retval TRUE  The certificate chain is found in the store.
+  @retval FALSE The certificate chain is not found in the store.
+**/
+typedef boolean (*spdm_cert_chain_store_load_func)(IN void *spdm_context,
+						   IN uint32 base_hash_algo,
+						   IN void *digest,
+						   IN OUT uintn *cert_chain_size,
+						   OUT void *cert_chain);
+
+/**
+  Save a certificate chain verified after GET_CERTIFICATE to a persistent certificate chain store.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  base_hash_algo                 The hash algorithm of the digest.
+  @param  digest                       The digest of the certificate chain buffer.
+  @param  cert_chain_size                size in bytes of the certificate chain buffer.
+  @param  cert_chain                    The certificate chain buffer including spdm_cert_chain_t header.
+**/
+typedef void (*spdm_cert_chain_store_save_func)(IN void *spdm_context,
+						IN uint32 base_hash_algo,
+						IN void *digest,
+						IN uintn cert_chain_size,
+						IN void *cert_chain);
+
+/**
+  Return the size in bytes of a certificate chain cache.
+
+  @param  entry_count                   The number of certificate chains the cache holds.
+
+  @return the size in bytes of the certificate chain cache.
+**/
+uintn spdm_get_cert_chain_cache_size(IN uintn entry_count);
+
+/**
+  Initialize an empty certificate chain cache.
+
+  The cache may be registered to many SPDM contexts, which must not be used concurrently.
+
+  @param  cert_chain_cache               A pointer to the certificate chain cache,
+                                       of the size returned by spdm_get_cert_chain_cache_size.
+  @param  entry_count                   The number of certificate chains the cache holds.
+**/
+void spdm_init_cert_chain_cache(IN void *cert_chain_cache,
+				IN uintn entry_count);
+
+/**
+  Register a verified peer certificate chain cache and its persistent store.
+
+  Each certificate chain verified after GET_CERTIFICATE is recorded in the cache and saved
+  to the store, keyed by the negotiated hash algorithm and the digest of the chain.
+  When spdm_get_certificate is called after spdm_get_digest, and the digest of the slot
+  is found in the cache or loaded from the store, the certificate chain is used
+  without GET_CERTIFICATE and without verifying the X.509 chain again.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  cert_chain_cache               A pointer to a certificate chain cache initialized by
+                                       spdm_init_cert_chain_cache. NULL means no in-memory cache.
+  @param  load_func                     The function to load a certificate chain from the store.
+                                       NULL means no store.
+  @param  save_func                     The function to save a certificate chain to the store.
+                                       NULL means no store.
+**/
+void spdm_register_cert_chain_cache(
+	IN void *spdm_context, IN void *cert_chain_cache OPTIONAL,
+	IN spdm_cert_chain_store_load_func load_func OPTIONAL,
+	IN spdm_cert_chain_store_save_func save_func OPTIONAL);
+
 /**
   This function sends CHALLENGE
   to authenticate the device based upon the key in one slot.
@@ -231,6 +314,303 @@ return_status spdm_start_session(IN void *spdm_context, IN boolean use_psk,
 return_status spdm_stop_session(IN void *spdm_context, IN uint32 session_id,
 				IN uint8 end_session_attributes);
 
+typedef enum {
+	//
+	// The operation is complete. The status of the operation is returned.
+	//
+	SPDM_REQUESTER_STEP_ACTION_DONE,
+	//
+	// The transport message returned by spdm_requester_step must be sent to the device.
+	//
+	SPDM_REQUESTER_STEP_ACTION_SEND,
+	//
+	// A transport message must be received from the device and passed to
+	// spdm_requester_step_receive.
+	//
+	SPDM_REQUESTER_STEP_ACTION_RECEIVE,
+} spdm_requester_step_action_t;
+
+/**
+  This function begins to send GET_VERSION, GET_CAPABILITIES, NEGOTIATE_ALGORITHM
+  to initialize the connection with SPDM responder, without blocking on the transport.
+
+  The operation is driven by spdm_requester_step and spdm_requester_step_receive.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  get_version_only              TRUE means only GET_VERSION is sent.
+
+  @retval RETURN_SUCCESS               The operation is started.
+  @retval RETURN_ALREADY_STARTED       Another operation is pending on the SPDM context.
+**/
+return_status spdm_begin_init_connection(IN void *spdm_context,
+					 IN boolean get_version_only);
+
+/**
+  This function begins to send GET_DIGEST
+  to get all digest of the certificate chains from device, without blocking on the transport.
+
+  The operation is driven by spdm_requester_step and spdm_requester_step_receive.
+  The output buffers must stay valid until the operation is complete.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  slot_mask                     The slots which deploy the CertificateChain.
+  @param  total_digest_buffer            A pointer to a destination buffer to store the digest buffer.
+
+  @retval RETURN_SUCCESS               The operation is started.
+  @retval RETURN_ALREADY_STARTED       Another operation is pending on the SPDM context.
+  @retval RETURN_UNSUPPORTED           The capabilities or the connection state do not allow GET_DIGEST.
+**/
+return_status spdm_begin_get_digest(IN void *spdm_context,
+				    OUT uint8 *slot_mask,
+				    OUT void *total_digest_buffer);
+
+/**
+  This function begins to send GET_CERTIFICATE
+  to get certificate chain in one slot from device, without blocking on the transport.
+
+  The operation is driven by spdm_requester_step and spdm_requester_step_receive.
+  The output buffers must stay valid until the operation is complete.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  slot_id                      The number of slot for the certificate chain.
+  @param  cert_chain_size                On input, indicate the size in bytes of the destination buffer to store the digest buffer.
+                                       On output, indicate the size in bytes of the certificate chain.
+  @param  cert_chain                    A pointer to a destination buffer to store the certificate chain.
+
+  @retval RETURN_SUCCESS               The operation is started.
+  @retval RETURN_ALREADY_STARTED       Another operation is pending on the SPDM context.
+  @retval RETURN_UNSUPPORTED           The capabilities or the connection state do not allow GET_CERTIFICATE.
+  @retval RETURN_INVALID_PARAMETER     The slot_id is invalid.
+**/
+return_status spdm_begin_get_certificate(IN void *spdm_context,
+					 IN uint8 slot_id,
+					 IN OUT uintn *cert_chain_size,
+					 OUT void *cert_chain);
+
+/**
+  This function begins to send CHALLENGE
+  to authenticate the device based upon the key in one slot, without blocking on the transport.
+
+  The operation is driven by spdm_requester_step and spdm_requester_step_receive.
+  The output buffer must stay valid until the operation is complete.
+  If basic mutual authentication is requested from the responder, the operation
+  completes with RETURN_UNSUPPORTED. spdm_challenge handles it.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  slot_id                      The number of slot for the challenge.
+  @param  measurement_hash_type          The type of the measurement hash.
+  @param  measurement_hash              A pointer to a destination buffer to store the measurement hash.
+
+  @retval RETURN_SUCCESS               The operation is started.
+  @retval RETURN_ALREADY_STARTED       Another operation is pending on the SPDM context.
+  @retval RETURN_UNSUPPORTED           The capabilities or the connection state do not allow CHALLENGE.
+  @retval RETURN_INVALID_PARAMETER     The slot_id is invalid.
+**/
+return_status spdm_begin_challenge(IN void *spdm_context, IN uint8 slot_id,
+				   IN uint8 measurement_hash_type,
+				   OUT void *measurement_hash);
+
+/**
+  This function begins to send KEY_EXCHANGE/FINISH or PSK_EXCHANGE/PSK_FINISH
+  to start an SPDM Session, without blocking on the transport.
+
+  The operation is driven by spdm_requester_step and spdm_requester_step_receive.
+  The output buffers must stay valid until the operation is complete.
+  If encapsulated mutual authentication is requested from the responder, the
+  operation completes with RETURN_UNSUPPORTED. spdm_start_session handles it.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  use_psk                       FALSE means to use KEY_EXCHANGE/FINISH to start a session.
+                                       TRUE means to use PSK_EXCHANGE/PSK_FINISH to start a session.
+  @param  measurement_hash_type          The type of the measurement hash.
+  @param  slot_id                      The number of slot for the certificate chain.
+  @param  session_id                    The session ID of the session.
+  @param  heartbeat_period              The heartbeat period for the session.
+  @param  measurement_hash              A pointer to a destination buffer to store the measurement hash.
+
+  @retval RETURN_SUCCESS               The operation is started.
+  @retval RETURN_ALREADY_STARTED       Another operation is pending on the SPDM context.
+  @retval RETURN_UNSUPPORTED           The capabilities or the connection state do not allow the session.
+**/
+return_status spdm_begin_start_session(IN void *spdm_context,
+				       IN boolean use_psk,
+				       IN uint8 measurement_hash_type,
+				       IN uint8 slot_id, OUT uint32 *session_id,
+				       OUT uint8 *heartbeat_period,
+				       OUT void *measurement_hash);
+
+/**
+  This function begins to send GET_MEASUREMENT
+  to get measurement from the device, without blocking on the transport.
+
+  The operation is driven by spdm_requester_step and spdm_requester_step_receive.
+  The session ID and the output buffers must stay valid until the operation is complete.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  session_id                    Indicates if it is a secured message protected via SPDM session.
+                                       If session_id is NULL, it is a normal message.
+                                       If session_id is NOT NULL, it is a secured message.
+  @param  request_attribute             The request attribute of the request message.
+  @param  measurement_operation         The measurement operation of the request message.
+  @param  slot_id                      The number of slot for the certificate chain.
+  @param  number_of_blocks               The number of blocks of the measurement record.
+  @param  measurement_record_length      On input, indicate the size in bytes of the destination buffer to store the measurement record.
+                                       On output, indicate the size in bytes of the measurement record.
+  @param  measurement_record            A pointer to a destination buffer to store the measurement record.
+
+  @retval RETURN_SUCCESS               The operation is started.
+  @retval RETURN_ALREADY_STARTED       Another operation is pending on the SPDM context.
+  @retval RETURN_UNSUPPORTED           The capabilities or the connection state do not allow GET_MEASUREMENT.
+  @retval RETURN_INVALID_PARAMETER     The slot_id or the request attribute is invalid.
+**/
+return_status spdm_begin_get_measurement(IN void *spdm_context,
+					 IN uint32 *session_id,
+					 IN uint8 request_attribute,
+					 IN uint8 measurement_operation,
+					 IN uint8 slot_id,
+					 OUT uint8 *number_of_blocks,
+					 IN OUT uint32 *measurement_record_length,
+					 OUT void *measurement_record);
+
+/**
+  Advance the operation started by spdm_begin_* on an SPDM context.
+
+  If the action is SPDM_REQUESTER_STEP_ACTION_SEND, the next request is encoded to
+  the transport message, and the caller sends it to the device.
+  If the action is SPDM_REQUESTER_STEP_ACTION_RECEIVE, the caller receives a transport
+  message from the device and passes it to spdm_requester_step_receive.
+  If the action is SPDM_REQUESTER_STEP_ACTION_DONE, the operation is complete, its status
+  is returned, and a new operation can be started.
+
+  The requester statistics count the requests, BUSY and ResponseNotReady, and record the
+  encode, decode and verify time as for the blocking API. The send and receive time is not
+  recorded, because the caller moves the transport messages.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  action                       On output, the action required from the caller.
+  @param  transport_message_size         size in bytes of the transport message data buffer.
+                                       On output, the size in bytes of the transport message to send.
+  @param  transport_message             A pointer to a destination buffer to store the transport message to send.
+
+  @retval RETURN_SUCCESS               The action is returned, or the operation succeeded.
+  @retval RETURN_NOT_STARTED           No operation is pending on the SPDM context.
+  @retval others                       The operation failed, with the status of the blocking API.
+**/
+return_status spdm_requester_step(IN void *spdm_context,
+				  OUT spdm_requester_step_action_t *action,
+				  IN OUT uintn *transport_message_size,
+				  OUT void *transport_message);
+
+/**
+  Feed a transport message received from the device to the pending operation.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  transport_message_size         size in bytes of the transport message.
+  @param  transport_message             A pointer to the received transport message.
+                                       NULL means the transport failed to receive a message,
+                                       and the operation completes with RETURN_DEVICE_ERROR.
+
+  @retval RETURN_SUCCESS               The transport message is consumed. Call spdm_requester_step for the next action.
+  @retval RETURN_NOT_STARTED           No operation is waiting for a response.
+**/
+return_status spdm_requester_step_receive(IN void *spdm_context,
+					  IN uintn transport_message_size,
+					  IN void *transport_message);
+
+/**
+  Abort the operation pending on an SPDM context.
+
+  The resources held by the operation are released and a new operation can be started.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+**/
+void spdm_requester_step_abort(IN void *spdm_context);
+
+typedef enum {
+	SPDM_ATTESTATION_STAGE_INIT_CONNECTION,
+	SPDM_ATTESTATION_STAGE_GET_DIGEST,
+	SPDM_ATTESTATION_STAGE_GET_CERTIFICATE,
+	SPDM_ATTESTATION_STAGE_CHALLENGE,
+	SPDM_ATTESTATION_STAGE_GET_MEASUREMENT,
+	//
+	// All stages succeeded.
+	//
+	SPDM_ATTESTATION_STAGE_DONE,
+} spdm_attestation_stage_t;
+
+typedef struct {
+	//
+	// Set by the caller before spdm_attest_devices
+	//
+	void *spdm_context;
+	uint8 slot_id;
+	uint8 measurement_hash_type;
+	uint8 measurement_attribute;
+	// On input, the size of cert_chain. On output, the size of the certificate chain.
+	uintn cert_chain_size;
+	void *cert_chain;
+	// On input, the size of measurement_record. On output, the size of the measurement record.
+	// If measurement_record is NULL, the GET_MEASUREMENT stage is skipped.
+	uint32 measurement_record_length;
+	void *measurement_record;
+	//
+	// Set by spdm_attest_devices
+	//
+	uint8 slot_mask;
+	uint8 total_digest_buffer[MAX_HASH_SIZE * MAX_SPDM_SLOT_COUNT];
+	uint8 measurement_hash[MAX_HASH_SIZE];
+	uint8 number_of_blocks;
+	// The stage reached, SPDM_ATTESTATION_STAGE_DONE on success
+	spdm_attestation_stage_t stage;
+	// The status of the stage reached, RETURN_NOT_READY while the device is pending
+	return_status status;
+	// Time spent in each stage, in the unit of spdm_attestation_get_time_func
+	uint64 stage_time[SPDM_ATTESTATION_STAGE_DONE];
+	uint64 total_time;
+} spdm_attestation_device_t;
+
+/**
+  Return a monotonic time stamp used to time the attestation stages.
+
+  @return the time stamp, in the unit chosen by the caller (such as 100ns).
+**/
+typedef uint64 (*spdm_attestation_get_time_func)(void);
+
+/**
+  Attest a set of devices: VCA, GET_DIGEST, GET_CERTIFICATE, CHALLENGE and GET_MEASUREMENT.
+
+  The devices are attested concurrently from the calling thread: every device sends its
+  next request as soon as its previous response is processed, and the responses are polled
+  with the receive_message function registered on each SPDM context with poll_timeout.
+  A device whose response is not ready (RETURN_TIMEOUT) does not block the other devices.
+
+  Each device needs its own SPDM context. The contexts may share the immutable local state,
+  such as the trusted root certificate hash and the local key, by being initialized with
+  spdm_init_context_with_local_context.
+
+  All devices are driven from the calling thread, so their SPDM contexts may share one
+  certificate chain verify cache registered by spdm_register_cert_chain_verify_cache.
+  Several spdm_attest_devices may run on different threads for disjoint sets of devices,
+  as long as the threads do not share a certificate chain cache or a certificate chain
+  verify cache, and the shared local context is not modified by spdm_set_data while they run.
+
+  The result of each device is returned in its spdm_attestation_device_t.
+
+  @param  device                       An array of devices to attest.
+  @param  device_count                  The number of devices in the array.
+  @param  poll_timeout                  The timeout passed to receive_message, in the unit of 100ns.
+                                       It must not be 0, which would wait for each device in turn.
+  @param  get_time                      A function to time the stages. NULL means the stages are not timed.
+
+  @retval RETURN_SUCCESS               All devices are attested.
+  @retval RETURN_INVALID_PARAMETER     poll_timeout is 0.
+  @retval RETURN_DEVICE_ERROR          At least one device failed. See its stage and status.
+**/
+return_status spdm_attest_devices(IN OUT spdm_attestation_device_t *device,
+				  IN uintn device_count,
+				  IN uint64 poll_timeout,
+				  IN spdm_attestation_get_time_func get_time OPTIONAL);
+
 /**
   Send and receive an SPDM or APP message.
 
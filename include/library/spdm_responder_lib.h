@@ -66,6 +66,7 @@ void spdm_register_get_response_func(
 
   @retval RETURN_SUCCESS               The SPDM request is received successfully.
   @retval RETURN_DEVICE_ERROR          A device error occurs when the SPDM request is received from the device.
+  @retval RETURN_OUT_OF_RESOURCES      No arena is registered while OPENSPDM_ARENA_MANAGED_BUFFER_SUPPORT is 1.
 **/
 return_status spdm_process_request(IN void *spdm_context,
 				   OUT uint32 **session_id,
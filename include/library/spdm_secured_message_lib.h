@@ -73,6 +73,26 @@ uintn spdm_secured_message_get_context_size(void);
 */
 void spdm_secured_message_init_context(IN void *spdm_secured_message_context);
 
+/**
+  Release the keyed AEAD contexts held by an SPDM secured message context.
+
+  It must be called before the SPDM secured message context is initialized again or discarded.
+
+  @param  spdm_secured_message_context    A pointer to the SPDM secured message context.
+*/
+void spdm_secured_message_free_aead_context(
+	IN void *spdm_secured_message_context);
+
+/**
+  Release the keyed HMAC contexts held by an SPDM secured message context.
+
+  It must be called before the SPDM secured message context is initialized again or discarded.
+
+  @param  spdm_secured_message_context    A pointer to the SPDM secured message context.
+*/
+void spdm_secured_message_free_hmac_context(
+	IN void *spdm_secured_message_context);
+
 /**
   Set use_psk to an SPDM secured message context.
 
@@ -290,6 +310,21 @@ spdm_hmac_all_with_request_finished_key(IN void *spdm_secured_message_context,
 					IN const void *data, IN uintn data_size,
 					OUT uint8 *hmac_value);
 
+/**
+  Computes the HMAC of a list of discontinuous data buffers, with request_finished_key.
+
+  @param  spdm_secured_message_context    A pointer to the SPDM secured message context.
+  @param  iov                          Pointer to the array of data buffers to be HMACed, in order.
+  @param  iov_count                     Number of elements in iov.
+  @param  hmac_value                    Pointer to a buffer that receives the HMAC value.
+
+  @retval TRUE   HMAC computation succeeded.
+  @retval FALSE  HMAC computation failed.
+**/
+boolean spdm_hmac_multi_with_request_finished_key(
+	IN void *spdm_secured_message_context, IN const spdm_iovec_t *iov,
+	IN uintn iov_count, OUT uint8 *hmac_value);
+
 /**
   Computes the HMAC of a input data buffer, with response_finished_key.
 
@@ -305,6 +340,21 @@ boolean spdm_hmac_all_with_response_finished_key(
 	IN void *spdm_secured_message_context, IN const void *data,
 	IN uintn data_size, OUT uint8 *hmac_value);
 
+/**
+  Computes the HMAC of a list of discontinuous data buffers, with response_finished_key.
+
+  @param  spdm_secured_message_context    A pointer to the SPDM secured message context.
+  @param  iov                          Pointer to the array of data buffers to be HMACed, in order.
+  @param  iov_count                     Number of elements in iov.
+  @param  hmac_value                    Pointer to a buffer that receives the HMAC value.
+
+  @retval TRUE   HMAC computation succeeded.
+  @retval FALSE  HMAC computation failed.
+**/
+boolean spdm_hmac_multi_with_response_finished_key(
+	IN void *spdm_secured_message_context, IN const spdm_iovec_t *iov,
+	IN uintn iov_count, OUT uint8 *hmac_value);
+
 /**
   This function concatenates binary data, which is used as info in HKDF expand later.
 
@@ -420,6 +470,34 @@ typedef struct {
 	uint32 session_id;
 } spdm_error_struct_t;
 
+/**
+  Return the size in bytes in front of the application message in a secured message.
+
+  It covers the record header and, for an encrypted session, the cipher header.
+
+  @param  spdm_secured_message_context    A pointer to the SPDM secured message context.
+  @param  spdm_secured_message_callbacks_t  A pointer to a secured message callback functions structure.
+
+  @return the headroom in bytes of the secured message.
+**/
+uintn spdm_secured_message_get_headroom(
+	IN void *spdm_secured_message_context,
+	IN spdm_secured_message_callbacks_t *spdm_secured_message_callbacks_t);
+
+/**
+  Return the maximum size in bytes behind the application message in a secured message.
+
+  It covers the random padding of an encrypted session and the AEAD tag.
+
+  @param  spdm_secured_message_context    A pointer to the SPDM secured message context.
+  @param  spdm_secured_message_callbacks_t  A pointer to a secured message callback functions structure.
+
+  @return the tailroom in bytes of the secured message.
+**/
+uintn spdm_secured_message_get_tailroom(
+	IN void *spdm_secured_message_context,
+	IN spdm_secured_message_callbacks_t *spdm_secured_message_callbacks_t);
+
 /**
   Encode an application message to a secured message.
 
@@ -442,6 +520,34 @@ return_status spdm_encode_secured_message(
 	OUT void *secured_message,
 	IN spdm_secured_message_callbacks_t *spdm_secured_message_callbacks_t);
 
+/**
+  Encode an application message to a secured message in place.
+
+  The application message must already be placed in the secured message buffer at
+  the offset returned by spdm_secured_message_get_headroom. The record header is
+  written in front of it, and the padding and the AEAD tag are written behind it.
+  The buffer should have spdm_secured_message_get_tailroom bytes after the
+  application message. For an encrypted session, the message is encrypted in place.
+
+  @param  spdm_secured_message_context    A pointer to the SPDM secured message context.
+  @param  session_id                    The session ID of the SPDM session.
+  @param  is_requester                  Indicates if it is a requester message.
+  @param  app_message_size               size in bytes of the application message in the buffer.
+  @param  secured_message_size           On input, size in bytes of the secured message buffer.
+                                       On output, size in bytes of the secured message.
+  @param  secured_message               A pointer to the buffer holding the application message at the headroom offset.
+                                       On output, it holds the secured message.
+  @param  spdm_secured_message_callbacks_t  A pointer to a secured message callback functions structure.
+
+  @retval RETURN_SUCCESS               The application message is encoded successfully.
+  @retval RETURN_BUFFER_TOO_SMALL      The buffer is too small to hold the secured message.
+**/
+return_status spdm_encode_secured_message_in_place(
+	IN void *spdm_secured_message_context, IN uint32 session_id,
+	IN boolean is_requester, IN uintn app_message_size,
+	IN OUT uintn *secured_message_size, IN OUT void *secured_message,
+	IN spdm_secured_message_callbacks_t *spdm_secured_message_callbacks_t);
+
 /**
   Decode an application message from a secured message.
 
@@ -465,6 +571,94 @@ return_status spdm_decode_secured_message(
 	OUT void *app_message,
 	IN spdm_secured_message_callbacks_t *spdm_secured_message_callbacks_t);
 
+/**
+  Decode an application message from a secured message in place.
+
+  The secured message is verified, and for an encrypted session decrypted, inside the
+  secured message buffer. No copy of the application message is made. On return,
+  app_message points to the application message inside the secured message buffer.
+  The content of the buffer is undefined if the decode fails.
+
+  @param  spdm_secured_message_context    A pointer to the SPDM secured message context.
+  @param  session_id                    The session ID of the SPDM session.
+  @param  is_requester                  Indicates if it is a requester message.
+  @param  secured_message_size           size in bytes of the secured message data buffer.
+  @param  secured_message               A pointer to the buffer holding the secured message.
+  @param  app_message_size               size in bytes of the application message.
+  @param  app_message                   A pointer to the application message inside the secured message buffer.
+  @param  spdm_secured_message_callbacks_t  A pointer to a secured message callback functions structure.
+
+  @retval RETURN_SUCCESS               The application message is decoded successfully.
+  @retval RETURN_UNSUPPORTED           The secured_message is unsupported.
+  @retval RETURN_SECURITY_VIOLATION    The secured_message fails verification.
+**/
+return_status spdm_decode_secured_message_in_place(
+	IN void *spdm_secured_message_context, IN uint32 session_id,
+	IN boolean is_requester, IN uintn secured_message_size,
+	IN OUT void *secured_message, OUT uintn *app_message_size,
+	OUT void **app_message,
+	IN spdm_secured_message_callbacks_t *spdm_secured_message_callbacks_t);
+
+/**
+  Encode a batch of application messages of one session to secured messages.
+
+  The messages are assigned consecutive sequence numbers. The session key and the
+  keyed AEAD context are resolved once for the whole batch. Encoding stops at the
+  first message that fails, and the sequence numbers of the messages before it stay
+  consumed.
+
+  @param  spdm_secured_message_context    A pointer to the SPDM secured message context.
+  @param  session_id                    The session ID of the SPDM session.
+  @param  is_requester                  Indicates if it is a requester message.
+  @param  message_count                 The number of messages in the batch.
+  @param  app_message_size               An array of size in bytes of each application message.
+  @param  app_message                   An array of pointers to each application message.
+  @param  secured_message_size           An array of size in bytes of each secured message buffer.
+                                       On output, the size in bytes of each secured message.
+  @param  secured_message               An array of pointers to each secured message buffer.
+  @param  spdm_secured_message_callbacks_t  A pointer to a secured message callback functions structure.
+
+  @retval RETURN_SUCCESS               All application messages are encoded successfully.
+  @retval RETURN_BUFFER_TOO_SMALL      A secured message buffer is too small.
+  @retval RETURN_OUT_OF_RESOURCES      The sequence number is exhausted or the encryption fails.
+**/
+return_status spdm_encode_secured_messages(
+	IN void *spdm_secured_message_context, IN uint32 session_id,
+	IN boolean is_requester, IN uintn message_count,
+	IN uintn *app_message_size, IN void **app_message,
+	IN OUT uintn *secured_message_size, OUT void **secured_message,
+	IN spdm_secured_message_callbacks_t *spdm_secured_message_callbacks_t);
+
+/**
+  Decode a batch of secured messages of one session to application messages.
+
+  The messages must carry consecutive sequence numbers. The session key and the
+  keyed AEAD context are resolved once for the whole batch. Decoding stops at the
+  first message that fails.
+
+  @param  spdm_secured_message_context    A pointer to the SPDM secured message context.
+  @param  session_id                    The session ID of the SPDM session.
+  @param  is_requester                  Indicates if it is a requester message.
+  @param  message_count                 The number of messages in the batch.
+  @param  secured_message_size           An array of size in bytes of each secured message.
+  @param  secured_message               An array of pointers to each secured message.
+  @param  app_message_size               An array of size in bytes of each application message buffer.
+                                       On output, the size in bytes of each application message.
+  @param  app_message                   An array of pointers to each application message buffer.
+  @param  spdm_secured_message_callbacks_t  A pointer to a secured message callback functions structure.
+
+  @retval RETURN_SUCCESS               All secured messages are decoded successfully.
+  @retval RETURN_BUFFER_TOO_SMALL      An application message buffer is too small.
+  @retval RETURN_OUT_OF_RESOURCES      A secured message is larger than MAX_SPDM_MESSAGE_BUFFER_SIZE.
+  @retval RETURN_SECURITY_VIOLATION    A secured message fails verification.
+**/
+return_status spdm_decode_secured_messages(
+	IN void *spdm_secured_message_context, IN uint32 session_id,
+	IN boolean is_requester, IN uintn message_count,
+	IN uintn *secured_message_size, IN void **secured_message,
+	IN OUT uintn *app_message_size, OUT void **app_message,
+	IN spdm_secured_message_callbacks_t *spdm_secured_message_callbacks_t);
+
 /**
   Get the last SPDM error struct of an SPDM secured message context.
 
@@ -58,6 +58,7 @@ return_status spdm_transport_pci_doe_encode_message(
   @param  is_requester                  Indicates if it is a requester message.
   @param  transport_message_size         size in bytes of the transport message data buffer.
   @param  transport_message             A pointer to a source buffer to store the transport message.
+                                       A secured message is verified and decrypted in place in this buffer.
   @param  message_size                  size in bytes of the message data buffer.
   @param  message                      A pointer to a destination buffer to store the message.
 
@@ -68,7 +69,7 @@ return_status spdm_transport_pci_doe_encode_message(
 return_status spdm_transport_pci_doe_decode_message(
 	IN void *spdm_context, OUT uint32 **session_id,
 	OUT boolean *is_app_message, IN boolean is_requester,
-	IN uintn transport_message_size, IN void *transport_message,
+	IN uintn transport_message_size, IN OUT void *transport_message,
 	IN OUT uintn *message_size, OUT void *message);
 
 /**
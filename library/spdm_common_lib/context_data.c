@@ -6,6 +6,10 @@
 
 #include "spdm_common_lib_internal.h"
 
+#if !defined(__GNUC__) && !defined(__clang__) && defined(_MSC_EXTENSIONS)
+#include <intrin.h>
+#endif
+
 /**
   Returns if an SPDM data_type requires session info.
 
@@ -82,13 +86,13 @@ return_status spdm_set_data(IN void *context, IN spdm_data_type_t data_type,
 						 .spdm_version_count *
 					 sizeof(spdm_version_number_t));
 		} else {
-			spdm_context->local_context.version.spdm_version_count =
+			spdm_context->local_context->version.spdm_version_count =
 				(uint8)(data_size /
 					sizeof(spdm_version_number_t));
 			copy_mem(
-				spdm_context->local_context.version.spdm_version,
+				spdm_context->local_context->version.spdm_version,
 				data,
-				spdm_context->local_context.version
+				spdm_context->local_context->version
 						.spdm_version_count *
 					sizeof(spdm_version_number_t));
 		}
@@ -110,14 +114,14 @@ return_status spdm_set_data(IN void *context, IN spdm_data_type_t data_type,
 						 .spdm_version_count *
 					 sizeof(spdm_version_number_t));
 		} else {
-			spdm_context->local_context.secured_message_version
+			spdm_context->local_context->secured_message_version
 				.spdm_version_count = (uint8)(
 				data_size / sizeof(spdm_version_number_t));
 			copy_mem(spdm_context->local_context
-					 .secured_message_version.spdm_version,
+					 ->secured_message_version.spdm_version,
 				 data,
 				 spdm_context->local_context
-						 .secured_message_version
+						 ->secured_message_version
 						 .spdm_version_count *
 					 sizeof(spdm_version_number_t));
 		}
@@ -130,7 +134,7 @@ return_status spdm_set_data(IN void *context, IN spdm_data_type_t data_type,
 			spdm_context->connection_info.capability.flags =
 				*(uint32 *)data;
 		} else {
-			spdm_context->local_context.capability.flags =
+			spdm_context->local_context->capability.flags =
 				*(uint32 *)data;
 		}
 		break;
@@ -138,7 +142,7 @@ return_status spdm_set_data(IN void *context, IN spdm_data_type_t data_type,
 		if (data_size != sizeof(uint8)) {
 			return RETURN_INVALID_PARAMETER;
 		}
-		spdm_context->local_context.capability.ct_exponent =
+		spdm_context->local_context->capability.ct_exponent =
 			*(uint8 *)data;
 		break;
 	case SPDM_DATA_MEASUREMENT_SPEC:
@@ -149,7 +153,7 @@ return_status spdm_set_data(IN void *context, IN spdm_data_type_t data_type,
 			spdm_context->connection_info.algorithm
 				.measurement_spec = *(uint8 *)data;
 		} else {
-			spdm_context->local_context.algorithm.measurement_spec =
+			spdm_context->local_context->algorithm.measurement_spec =
 				*(uint8 *)data;
 		}
 		break;
@@ -161,7 +165,7 @@ return_status spdm_set_data(IN void *context, IN spdm_data_type_t data_type,
 			spdm_context->connection_info.algorithm
 				.measurement_hash_algo = *(uint32 *)data;
 		} else {
-			spdm_context->local_context.algorithm
+			spdm_context->local_context->algorithm
 				.measurement_hash_algo = *(uint32 *)data;
 		}
 		break;
@@ -173,7 +177,7 @@ return_status spdm_set_data(IN void *context, IN spdm_data_type_t data_type,
 			spdm_context->connection_info.algorithm.base_asym_algo =
 				*(uint32 *)data;
 		} else {
-			spdm_context->local_context.algorithm.base_asym_algo =
+			spdm_context->local_context->algorithm.base_asym_algo =
 				*(uint32 *)data;
 		}
 		break;
@@ -185,7 +189,7 @@ return_status spdm_set_data(IN void *context, IN spdm_data_type_t data_type,
 			spdm_context->connection_info.algorithm.base_hash_algo =
 				*(uint32 *)data;
 		} else {
-			spdm_context->local_context.algorithm.base_hash_algo =
+			spdm_context->local_context->algorithm.base_hash_algo =
 				*(uint32 *)data;
 		}
 		break;
@@ -197,7 +201,7 @@ return_status spdm_set_data(IN void *context, IN spdm_data_type_t data_type,
 			spdm_context->connection_info.algorithm.dhe_named_group =
 				*(uint16 *)data;
 		} else {
-			spdm_context->local_context.algorithm.dhe_named_group =
+			spdm_context->local_context->algorithm.dhe_named_group =
 				*(uint16 *)data;
 		}
 		break;
@@ -209,7 +213,7 @@ return_status spdm_set_data(IN void *context, IN spdm_data_type_t data_type,
 			spdm_context->connection_info.algorithm
 				.aead_cipher_suite = *(uint16 *)data;
 		} else {
-			spdm_context->local_context.algorithm.aead_cipher_suite =
+			spdm_context->local_context->algorithm.aead_cipher_suite =
 				*(uint16 *)data;
 		}
 		break;
@@ -221,7 +225,7 @@ return_status spdm_set_data(IN void *context, IN spdm_data_type_t data_type,
 			spdm_context->connection_info.algorithm
 				.req_base_asym_alg = *(uint16 *)data;
 		} else {
-			spdm_context->local_context.algorithm.req_base_asym_alg =
+			spdm_context->local_context->algorithm.req_base_asym_alg =
 				*(uint16 *)data;
 		}
 		break;
@@ -233,7 +237,7 @@ return_status spdm_set_data(IN void *context, IN spdm_data_type_t data_type,
 			spdm_context->connection_info.algorithm.key_schedule =
 				*(uint16 *)data;
 		} else {
-			spdm_context->local_context.algorithm.key_schedule =
+			spdm_context->local_context->algorithm.key_schedule =
 				*(uint16 *)data;
 		}
 		break;
@@ -251,15 +255,17 @@ return_status spdm_set_data(IN void *context, IN spdm_data_type_t data_type,
 		spdm_context->response_state = *(uint32 *)data;
 		break;
 	case SPDM_DATA_PEER_PUBLIC_ROOT_CERT_HASH:
-		spdm_context->local_context.peer_root_cert_hash_provision_size =
+		spdm_context->local_context->peer_root_cert_hash_provision_size =
 			data_size;
-		spdm_context->local_context.peer_root_cert_hash_provision =
+		spdm_context->local_context->peer_root_cert_hash_provision =
 			data;
 		break;
 	case SPDM_DATA_PEER_PUBLIC_CERT_CHAIN:
-		spdm_context->local_context.peer_cert_chain_provision_size =
+		spdm_context->local_context->peer_cert_chain_provision_size =
 			data_size;
-		spdm_context->local_context.peer_cert_chain_provision = data;
+		spdm_context->local_context->peer_cert_chain_provision = data;
+		spdm_context->local_context->peer_cert_chain_generation++;
+		spdm_invalidate_peer_cert_chain_hash(spdm_context);
 		break;
 	case SPDM_DATA_LOCAL_SLOT_COUNT:
 		if (data_size != sizeof(uint8)) {
@@ -269,17 +275,19 @@ return_status spdm_set_data(IN void *context, IN spdm_data_type_t data_type,
 		if (slot_id > MAX_SPDM_SLOT_COUNT) {
 			return RETURN_INVALID_PARAMETER;
 		}
-		spdm_context->local_context.slot_count = slot_id;
+		spdm_context->local_context->slot_count = slot_id;
 		break;
 	case SPDM_DATA_LOCAL_PUBLIC_CERT_CHAIN:
 		slot_id = parameter->additional_data[0];
-		if (slot_id >= spdm_context->local_context.slot_count) {
+		if (slot_id >= spdm_context->local_context->slot_count) {
 			return RETURN_INVALID_PARAMETER;
 		}
 		spdm_context->local_context
-			.local_cert_chain_provision_size[slot_id] = data_size;
-		spdm_context->local_context.local_cert_chain_provision[slot_id] =
+			->local_cert_chain_provision_size[slot_id] = data_size;
+		spdm_context->local_context->local_cert_chain_provision[slot_id] =
 			data;
+		spdm_context->local_context
+			->local_cert_chain_generation[slot_id]++;
 		break;
 	case SPDM_DATA_LOCAL_USED_CERT_CHAIN_BUFFER:
 		if (data_size > MAX_SPDM_CERT_CHAIN_SIZE) {
@@ -299,6 +307,7 @@ return_status spdm_set_data(IN void *context, IN spdm_data_type_t data_type,
 		copy_mem(spdm_context->connection_info
 				 .peer_used_cert_chain_buffer,
 			 data, data_size);
+		spdm_invalidate_peer_cert_chain_hash(spdm_context);
 		break;
 	case SPDM_DATA_BASIC_MUT_AUTH_REQUESTED:
 		if (data_size != sizeof(boolean)) {
@@ -308,7 +317,7 @@ return_status spdm_set_data(IN void *context, IN spdm_data_type_t data_type,
 		if (((mut_auth_requested != 0) && (mut_auth_requested != 1))) {
 			return RETURN_INVALID_PARAMETER;
 		}
-		spdm_context->local_context.basic_mut_auth_requested =
+		spdm_context->local_context->basic_mut_auth_requested =
 			mut_auth_requested;
 		spdm_context->encap_context.error_state = 0;
 		spdm_context->encap_context.request_id = 0;
@@ -329,7 +338,7 @@ return_status spdm_set_data(IN void *context, IN spdm_data_type_t data_type,
 		      SPDM_KEY_EXCHANGE_RESPONSE_MUT_AUTH_REQUESTED_WITH_GET_DIGESTS))) {
 			return RETURN_INVALID_PARAMETER;
 		}
-		spdm_context->local_context.mut_auth_requested =
+		spdm_context->local_context->mut_auth_requested =
 			mut_auth_requested;
 		spdm_context->encap_context.error_state = 0;
 		spdm_context->encap_context.request_id = 0;
@@ -340,8 +349,8 @@ return_status spdm_set_data(IN void *context, IN spdm_data_type_t data_type,
 		if (data_size > MAX_SPDM_PSK_HINT_LENGTH) {
 			return RETURN_INVALID_PARAMETER;
 		}
-		spdm_context->local_context.psk_hint_size = data_size;
-		spdm_context->local_context.psk_hint = data;
+		spdm_context->local_context->psk_hint_size = data_size;
+		spdm_context->local_context->psk_hint = data;
 		break;
 	case SPDM_DATA_SESSION_USE_PSK:
 		if (data_size != sizeof(boolean)) {
@@ -361,6 +370,28 @@ return_status spdm_set_data(IN void *context, IN spdm_data_type_t data_type,
 		}
 		session_info->end_session_attributes = *(uint8 *)data;
 		break;
+#if OPENSPDM_RESPONDER_STATISTICS_SUPPORT == 1
+	case SPDM_DATA_RESPONDER_STATISTICS:
+		if (parameter->location != SPDM_DATA_LOCATION_LOCAL) {
+			return RETURN_INVALID_PARAMETER;
+		}
+		if (data_size != sizeof(spdm_responder_statistics_t)) {
+			return RETURN_INVALID_PARAMETER;
+		}
+		copy_mem(&spdm_context->responder_statistics, data, data_size);
+		break;
+#endif
+#if OPENSPDM_REQUESTER_STATISTICS_SUPPORT == 1
+	case SPDM_DATA_REQUESTER_STATISTICS:
+		if (parameter->location != SPDM_DATA_LOCATION_LOCAL) {
+			return RETURN_INVALID_PARAMETER;
+		}
+		if (data_size != sizeof(spdm_requester_statistics_t)) {
+			return RETURN_INVALID_PARAMETER;
+		}
+		copy_mem(&spdm_context->requester_statistics, data, data_size);
+		break;
+#endif
 	default:
 		return RETURN_UNSUPPORTED;
 		break;
@@ -441,7 +472,7 @@ return_status spdm_get_data(IN void *context, IN spdm_data_type_t data_type,
 				&spdm_context->connection_info.capability.flags;
 		} else {
 			target_data =
-				&spdm_context->local_context.capability.flags;
+				&spdm_context->local_context->capability.flags;
 		}
 		break;
 	case SPDM_DATA_CAPABILITY_CT_EXPONENT:
@@ -450,7 +481,7 @@ return_status spdm_get_data(IN void *context, IN spdm_data_type_t data_type,
 			target_data = &spdm_context->connection_info.capability
 					       .ct_exponent;
 		} else {
-			target_data = &spdm_context->local_context.capability
+			target_data = &spdm_context->local_context->capability
 					       .ct_exponent;
 		}
 		break;
@@ -541,6 +572,24 @@ return_status spdm_get_data(IN void *context, IN spdm_data_type_t data_type,
 		target_data_size = sizeof(uint8);
 		target_data = &session_info->end_session_attributes;
 		break;
+#if OPENSPDM_RESPONDER_STATISTICS_SUPPORT == 1
+	case SPDM_DATA_RESPONDER_STATISTICS:
+		if (parameter->location != SPDM_DATA_LOCATION_LOCAL) {
+			return RETURN_INVALID_PARAMETER;
+		}
+		target_data_size = sizeof(spdm_responder_statistics_t);
+		target_data = &spdm_context->responder_statistics;
+		break;
+#endif
+#if OPENSPDM_REQUESTER_STATISTICS_SUPPORT == 1
+	case SPDM_DATA_REQUESTER_STATISTICS:
+		if (parameter->location != SPDM_DATA_LOCATION_LOCAL) {
+			return RETURN_INVALID_PARAMETER;
+		}
+		target_data_size = sizeof(spdm_requester_statistics_t);
+		target_data = &spdm_context->requester_statistics;
+		break;
+#endif
 	default:
 		return RETURN_UNSUPPORTED;
 		break;
@@ -579,7 +628,23 @@ void spdm_reset_message_b(IN void *context)
 	spdm_context_t *spdm_context;
 
 	spdm_context = context;
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	reset_managed_buffer(&spdm_context->transcript.message_b);
+#else
+	//
+	// C follows B, so it cannot be kept without B.
+	//
+	if (spdm_context->transcript.digest_context_b != NULL) {
+		spdm_hash_free(spdm_context->connection_info.algorithm.base_hash_algo,
+			       spdm_context->transcript.digest_context_b);
+		spdm_context->transcript.digest_context_b = NULL;
+	}
+	if (spdm_context->transcript.digest_context_m1m2 != NULL) {
+		spdm_hash_free(spdm_context->connection_info.algorithm.base_hash_algo,
+			       spdm_context->transcript.digest_context_m1m2);
+		spdm_context->transcript.digest_context_m1m2 = NULL;
+	}
+#endif
 }
 
 /**
@@ -592,7 +657,18 @@ void spdm_reset_message_c(IN void *context)
 	spdm_context_t *spdm_context;
 
 	spdm_context = context;
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	reset_managed_buffer(&spdm_context->transcript.message_c);
+#else
+	//
+	// The hash of B is kept. The next C message is appended to a duplicate of it.
+	//
+	if (spdm_context->transcript.digest_context_m1m2 != NULL) {
+		spdm_hash_free(spdm_context->connection_info.algorithm.base_hash_algo,
+			       spdm_context->transcript.digest_context_m1m2);
+		spdm_context->transcript.digest_context_m1m2 = NULL;
+	}
+#endif
 }
 
 /**
@@ -605,7 +681,23 @@ void spdm_reset_message_mut_b(IN void *context)
 	spdm_context_t *spdm_context;
 
 	spdm_context = context;
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	reset_managed_buffer(&spdm_context->transcript.message_mut_b);
+#else
+	//
+	// C follows B, so it cannot be kept without B.
+	//
+	if (spdm_context->transcript.digest_context_mut_b != NULL) {
+		spdm_hash_free(spdm_context->connection_info.algorithm.base_hash_algo,
+			       spdm_context->transcript.digest_context_mut_b);
+		spdm_context->transcript.digest_context_mut_b = NULL;
+	}
+	if (spdm_context->transcript.digest_context_mut_m1m2 != NULL) {
+		spdm_hash_free(spdm_context->connection_info.algorithm.base_hash_algo,
+			       spdm_context->transcript.digest_context_mut_m1m2);
+		spdm_context->transcript.digest_context_mut_m1m2 = NULL;
+	}
+#endif
 }
 
 /**
@@ -618,7 +710,18 @@ void spdm_reset_message_mut_c(IN void *context)
 	spdm_context_t *spdm_context;
 
 	spdm_context = context;
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	reset_managed_buffer(&spdm_context->transcript.message_mut_c);
+#else
+	//
+	// The hash of B is kept. The next C message is appended to a duplicate of it.
+	//
+	if (spdm_context->transcript.digest_context_mut_m1m2 != NULL) {
+		spdm_hash_free(spdm_context->connection_info.algorithm.base_hash_algo,
+			       spdm_context->transcript.digest_context_mut_m1m2);
+		spdm_context->transcript.digest_context_mut_m1m2 = NULL;
+	}
+#endif
 }
 
 /**
@@ -650,7 +753,7 @@ void spdm_reset_message_buffer_via_request_code(IN void *context,
 	  Any request other than SPDM_GET_MEASUREMENTS resets L1/L2
 	*/
 	if (request_code != SPDM_GET_MEASUREMENTS) {
-		reset_managed_buffer(&spdm_context->transcript.message_m);
+		spdm_reset_message_m(spdm_context);
 	}
 	/**
 	  If the Requester issued GET_MEASUREMENTS or KEY_EXCHANGE or FINISH or PSK_EXCHANGE 
@@ -670,23 +773,89 @@ void spdm_reset_message_buffer_via_request_code(IN void *context,
 	case SPDM_END_SESSION:
 		if (spdm_context->connection_info.connection_state <
 			SPDM_CONNECTION_STATE_AUTHENTICATED) {
-			reset_managed_buffer(&spdm_context->transcript.message_b);
-			reset_managed_buffer(&spdm_context->transcript.message_c);
-			reset_managed_buffer(&spdm_context->transcript.message_mut_b);
-			reset_managed_buffer(&spdm_context->transcript.message_mut_c);
+			spdm_reset_message_b(spdm_context);
+			spdm_reset_message_c(spdm_context);
+			spdm_reset_message_mut_b(spdm_context);
+			spdm_reset_message_mut_c(spdm_context);
 		}
 		break;
 	case SPDM_DELIVER_ENCAPSULATED_RESPONSE:
 		if (spdm_context->connection_info.connection_state <
 			SPDM_CONNECTION_STATE_AUTHENTICATED) {
-			reset_managed_buffer(&spdm_context->transcript.message_b);
-			reset_managed_buffer(&spdm_context->transcript.message_c);
+			spdm_reset_message_b(spdm_context);
+			spdm_reset_message_c(spdm_context);
 		}
 		break;
 	default:
 		break;
 	}
 }
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 0
+/**
+  Append a message to the running hash of a transcript.
+
+  The hash context is created on first use, as a duplicate of the prefix hash context
+  if it is present. Otherwise, if message A is requested, it is fed into the new hash
+  context before the message.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  digest_context                A pointer to the running hash context of the transcript.
+  @param  prefix_digest_context         The running hash context of the transcript prefix, or NULL.
+  @param  include_message_a             Indicate if message A is the prefix of the transcript.
+  @param  message                      message buffer.
+  @param  message_size                  size in bytes of message buffer.
+
+  @return RETURN_SUCCESS          message is appended.
+  @return RETURN_OUT_OF_RESOURCES message is not appended because the hash context cannot be created.
+  @return RETURN_DEVICE_ERROR     message is not appended because the hash operation fails.
+**/
+return_status spdm_append_message_to_digest_context(
+	IN spdm_context_t *spdm_context, IN OUT void **digest_context,
+	IN void *prefix_digest_context OPTIONAL, IN boolean include_message_a,
+	IN void *message, IN uintn message_size)
+{
+	uint32 base_hash_algo;
+	boolean result;
+
+	base_hash_algo = spdm_context->connection_info.algorithm.base_hash_algo;
+	if (*digest_context == NULL) {
+		*digest_context = spdm_hash_new(base_hash_algo);
+		if (*digest_context == NULL) {
+			return RETURN_OUT_OF_RESOURCES;
+		}
+		if (prefix_digest_context != NULL) {
+			result = spdm_hash_duplicate(base_hash_algo,
+						     prefix_digest_context,
+						     *digest_context);
+		} else {
+			result = spdm_hash_init(base_hash_algo,
+						*digest_context);
+		}
+		if (result && (prefix_digest_context == NULL) &&
+		    include_message_a) {
+			result = spdm_hash_update(
+				base_hash_algo, *digest_context,
+				get_managed_buffer(
+					&spdm_context->transcript.message_a),
+				get_managed_buffer_size(
+					&spdm_context->transcript.message_a));
+		}
+		if (!result) {
+			spdm_hash_free(base_hash_algo, *digest_context);
+			*digest_context = NULL;
+			return RETURN_DEVICE_ERROR;
+		}
+	}
+
+	result = spdm_hash_update(base_hash_algo, *digest_context, message,
+				  message_size);
+	if (!result) {
+		return RETURN_DEVICE_ERROR;
+	}
+	return RETURN_SUCCESS;
+}
+#endif
+
 /**
   Append message A cache in SPDM context.
 
@@ -723,8 +892,14 @@ return_status spdm_append_message_b(IN void *context, IN void *message,
 	spdm_context_t *spdm_context;
 
 	spdm_context = context;
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	return append_managed_buffer(&spdm_context->transcript.message_b,
 				     message, message_size);
+#else
+	return spdm_append_message_to_digest_context(
+		spdm_context, &spdm_context->transcript.digest_context_b, NULL,
+		TRUE, message, message_size);
+#endif
 }
 
 /**
@@ -743,8 +918,15 @@ return_status spdm_append_message_c(IN void *context, IN void *message,
 	spdm_context_t *spdm_context;
 
 	spdm_context = context;
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	return append_managed_buffer(&spdm_context->transcript.message_c,
 				     message, message_size);
+#else
+	return spdm_append_message_to_digest_context(
+		spdm_context, &spdm_context->transcript.digest_context_m1m2,
+		spdm_context->transcript.digest_context_b, TRUE, message,
+		message_size);
+#endif
 }
 
 /**
@@ -763,8 +945,14 @@ return_status spdm_append_message_mut_b(IN void *context, IN void *message,
 	spdm_context_t *spdm_context;
 
 	spdm_context = context;
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	return append_managed_buffer(&spdm_context->transcript.message_mut_b,
 				     message, message_size);
+#else
+	return spdm_append_message_to_digest_context(
+		spdm_context, &spdm_context->transcript.digest_context_mut_b,
+		NULL, FALSE, message, message_size);
+#endif
 }
 
 /**
@@ -783,8 +971,15 @@ return_status spdm_append_message_mut_c(IN void *context, IN void *message,
 	spdm_context_t *spdm_context;
 
 	spdm_context = context;
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	return append_managed_buffer(&spdm_context->transcript.message_mut_c,
 				     message, message_size);
+#else
+	return spdm_append_message_to_digest_context(
+		spdm_context, &spdm_context->transcript.digest_context_mut_m1m2,
+		spdm_context->transcript.digest_context_mut_b, FALSE, message,
+		message_size);
+#endif
 }
 
 /**
@@ -810,22 +1005,90 @@ return_status spdm_append_message_m(IN void *context, IN void *message,
 /**
   Append message K cache in SPDM context.
 
+  @param  spdm_context                  A pointer to the SPDM context.
   @param  spdm_session_info              A pointer to the SPDM session context.
+  @param  is_requester                  Indicate of the message K for a requester or a responder.
   @param  message                      message buffer.
   @param  message_size                  size in bytes of message buffer.
 
   @return RETURN_SUCCESS          message is appended.
   @return RETURN_OUT_OF_RESOURCES message is not appended because the internal cache is full.
 **/
-return_status spdm_append_message_k(IN void *session_info, IN void *message,
+return_status spdm_append_message_k(IN void *context, IN void *session_info,
+				    IN boolean is_requester, IN void *message,
 				    IN uintn message_size)
 {
+	spdm_context_t *spdm_context;
 	spdm_session_info_t *spdm_session_info;
+	return_status status;
+	uint32 base_hash_algo;
+	boolean result;
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 0
+	uint8 *cert_chain_data;
+	uintn cert_chain_data_size;
+	uint8 cert_chain_data_hash[MAX_HASH_SIZE];
+#endif
 
 	spdm_session_info = session_info;
-	return append_managed_buffer(
+	status = append_managed_buffer(
 		&spdm_session_info->session_transcript.message_k, message,
 		message_size);
+	if (RETURN_ERROR(status)) {
+		return status;
+	}
+
+	spdm_context = context;
+	base_hash_algo = spdm_context->connection_info.algorithm.base_hash_algo;
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 0
+	if (spdm_session_info->session_transcript.digest_context_th == NULL) {
+		if (!spdm_session_info->use_psk) {
+			if (is_requester) {
+				result = spdm_get_peer_cert_chain_data(
+					spdm_context, (void **)&cert_chain_data,
+					&cert_chain_data_size);
+			} else {
+				result = spdm_get_local_cert_chain_data(
+					spdm_context, (void **)&cert_chain_data,
+					&cert_chain_data_size);
+			}
+			if (!result) {
+				return RETURN_UNSUPPORTED;
+			}
+			spdm_calculate_cert_chain_hash(spdm_context,
+						       cert_chain_data,
+						       cert_chain_data_size,
+						       cert_chain_data_hash);
+		}
+		//
+		// TH = Concatenate (A, Ct, K). Ct is not included for PSK.
+		//
+		status = spdm_append_message_to_digest_context(
+			spdm_context,
+			&spdm_session_info->session_transcript.digest_context_th,
+			NULL, TRUE,
+			spdm_session_info->use_psk ? NULL : cert_chain_data_hash,
+			spdm_session_info->use_psk ?
+				0 :
+				spdm_get_hash_size(base_hash_algo));
+		if (RETURN_ERROR(status)) {
+			return status;
+		}
+	}
+#endif
+	//
+	// If the transcript is recorded, the TH hash context is snapshotted at TH1,
+	// and only the message K after TH1 is fed into it.
+	//
+	if (spdm_session_info->session_transcript.digest_context_th != NULL) {
+		result = spdm_hash_update(
+			base_hash_algo,
+			spdm_session_info->session_transcript.digest_context_th,
+			message, message_size);
+		if (!result) {
+			return RETURN_DEVICE_ERROR;
+		}
+	}
+	return RETURN_SUCCESS;
 }
 
 /**
@@ -905,14 +1168,14 @@ spdm_is_capabilities_flag_supported(IN spdm_context_t *spdm_context,
 
 	if (is_requester) {
 		negotiated_requester_capabilities_flag =
-			spdm_context->local_context.capability.flags;
+			spdm_context->local_context->capability.flags;
 		negotiated_responder_capabilities_flag =
 			spdm_context->connection_info.capability.flags;
 	} else {
 		negotiated_requester_capabilities_flag =
 			spdm_context->connection_info.capability.flags;
 		negotiated_responder_capabilities_flag =
-			spdm_context->local_context.capability.flags;
+			spdm_context->local_context->capability.flags;
 	}
 
 	if (((requester_capabilities_flag == 0) ||
@@ -970,6 +1233,76 @@ void spdm_register_transport_layer_func(
 	return;
 }
 
+/**
+  Register a caller-supplied arena for the large SPDM buffers.
+
+  If OPENSPDM_ARENA_MANAGED_BUFFER_SUPPORT is 1, the message B, MutB, M, K and F transcripts
+  and the encapsulated certificate chain buffer are allocated from the arena when data is
+  appended, and are returned to the arena when they are reset. The last and the cached
+  SPDM request buffers are allocated from the arena on first use, and are returned by
+  spdm_deinit_context.
+
+  This function must be called after spdm_init_context, and before any SPDM communication.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  arena                         A pointer to the arena, passed to allocate_func and free_func.
+  @param  allocate_func                 The fuction to allocate a buffer from the arena.
+  @param  free_func                     The fuction to return a buffer to the arena.
+**/
+void spdm_register_arena_func(IN void *context, IN void *arena,
+			      IN spdm_arena_allocate_func allocate_func,
+			      IN spdm_arena_free_func free_func)
+{
+	spdm_context_t *spdm_context;
+
+	spdm_context = context;
+	spdm_context->arena.arena = arena;
+	spdm_context->arena.allocate_func = allocate_func;
+	spdm_context->arena.free_func = free_func;
+	return;
+}
+
+/**
+  Register a certificate chain verify cache to verify the peer certificate chains.
+
+  The cache is allocated by the caller with spdm_get_cert_chain_verify_cache_size bytes and
+  initialized by spdm_flush_cert_chain_verify_cache. It may be shared by several SPDM contexts,
+  for example the contexts of devices with the same intermediate and root certificates, but
+  it is not protected by a lock: the SPDM contexts sharing it must not run on several threads
+  at the same time. Without a registered cache, the peer certificate chains are verified in full.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  cert_chain_verify_cache         A pointer to the certificate chain verify cache, or NULL.
+**/
+void spdm_register_cert_chain_verify_cache(
+	IN void *context, IN void *cert_chain_verify_cache OPTIONAL)
+{
+	spdm_context_t *spdm_context;
+
+	spdm_context = context;
+	spdm_context->cert_chain_verify_cache = cert_chain_verify_cache;
+	return;
+}
+
+/**
+  Register the function to get a monotonic timestamp for the SPDM statistics.
+
+  If no function is registered, the statistics still count the messages,
+  but no time is recorded.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  get_timestamp_func            The fuction to get a monotonic timestamp.
+**/
+void spdm_register_get_timestamp_func(
+	IN void *context, IN spdm_get_timestamp_func get_timestamp_func)
+{
+	spdm_context_t *spdm_context;
+
+	spdm_context = context;
+	spdm_context->get_timestamp_func = (uintn)get_timestamp_func;
+	return;
+}
+
 /**
   Get the last error of an SPDM context.
 
@@ -1018,76 +1351,338 @@ void spdm_set_last_spdm_error_struct(IN void *context,
 }
 
 /**
-  Initialize an SPDM context.
+  Return the number of session hash buckets for a session table capacity.
 
-  The size in bytes of the spdm_context can be returned by spdm_get_context_size.
+  @param  max_session_count             The maximum number of concurrent sessions.
+
+  @return the number of session hash buckets, a power of two.
+**/
+static uintn spdm_get_session_hash_bucket_count(IN uintn max_session_count)
+{
+	uintn bucket_count;
+
+	bucket_count = 1;
+	while (bucket_count < max_session_count) {
+		bucket_count <<= 1;
+	}
+	return bucket_count;
+}
+
+/**
+  Initialize an SPDM local context.
+
+  The size in bytes of the local_context can be returned by spdm_get_local_context_size.
+
+  @param  local_context                 A pointer to the SPDM local context.
+*/
+void spdm_init_local_context(IN void *context)
+{
+	spdm_local_context_t *local_context;
+
+	local_context = context;
+	zero_mem(local_context, sizeof(spdm_local_context_t));
+	local_context->version.spdm_version_count = 2;
+	local_context->version.spdm_version[0].major_version = 1;
+	local_context->version.spdm_version[0].minor_version = 0;
+	local_context->version.spdm_version[0].alpha = 0;
+	local_context->version.spdm_version[0].update_version_number = 0;
+	local_context->version.spdm_version[1].major_version = 1;
+	local_context->version.spdm_version[1].minor_version = 1;
+	local_context->version.spdm_version[1].alpha = 0;
+	local_context->version.spdm_version[1].update_version_number = 0;
+	local_context->secured_message_version.spdm_version_count = 1;
+	local_context->secured_message_version.spdm_version[0].major_version =
+		1;
+	local_context->secured_message_version.spdm_version[0].minor_version =
+		1;
+	local_context->secured_message_version.spdm_version[0].alpha = 0;
+	local_context->secured_message_version.spdm_version[0]
+		.update_version_number = 0;
+}
+
+/**
+  Take a reference to an SPDM local context.
+
+  @param  local_context                 A pointer to the SPDM local context.
+**/
+static void internal_spdm_get_local_context(IN spdm_local_context_t *local_context)
+{
+#if defined(__GNUC__) || defined(__clang__)
+	__atomic_fetch_add(&local_context->ref_count, 1, __ATOMIC_RELAXED);
+#elif defined(_MSC_EXTENSIONS)
+	_InterlockedIncrement((volatile long *)&local_context->ref_count);
+#else
+	//
+	// No atomic operation. The SPDM contexts sharing the local context
+	// must not be initialized or deinitialized concurrently.
+	//
+	local_context->ref_count++;
+#endif
+}
+
+/**
+  Drop a reference to an SPDM local context.
+
+  @param  local_context                 A pointer to the SPDM local context.
+**/
+static void internal_spdm_put_local_context(IN spdm_local_context_t *local_context)
+{
+	uint32 ref_count;
+
+#if defined(__GNUC__) || defined(__clang__)
+	ref_count = __atomic_fetch_sub(&local_context->ref_count, 1,
+				       __ATOMIC_ACQ_REL);
+#elif defined(_MSC_EXTENSIONS)
+	ref_count = (uint32)_InterlockedDecrement(
+			    (volatile long *)&local_context->ref_count) +
+		    1;
+#else
+	ref_count = local_context->ref_count--;
+#endif
+	ASSERT(ref_count != 0);
+}
+
+/**
+  Initialize an SPDM context on top of its own or a shared local context.
 
   @param  spdm_context                  A pointer to the SPDM context.
+  @param  max_session_count             The maximum number of concurrent sessions.
+  @param  local_context                 A pointer to a shared SPDM local context, or NULL to
+                                       place a local context behind the SPDM context.
 */
-void spdm_init_context(IN void *context)
+static void internal_spdm_init_context(IN void *context,
+				       IN uintn max_session_count,
+				       IN void *local_context)
 {
 	spdm_context_t *spdm_context;
+	spdm_session_info_t *session_info;
 	void *secured_message_context;
 	uintn SecuredMessageContextSize;
+	uint32 *session_hash_bucket;
+	uintn bucket_count;
 	uintn index;
 
+	ASSERT((max_session_count != 0) && (max_session_count < 0xFFFF));
+
 	spdm_context = context;
 	zero_mem(spdm_context, sizeof(spdm_context_t));
 	spdm_context->version = spdm_context_struct_VERSION;
 	spdm_context->transcript.message_a.max_buffer_size =
 		MAX_SPDM_MESSAGE_SMALL_BUFFER_SIZE;
-	spdm_context->transcript.message_b.max_buffer_size =
-		MAX_SPDM_MESSAGE_BUFFER_SIZE;
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	spdm_context->transcript.message_c.max_buffer_size =
 		MAX_SPDM_MESSAGE_SMALL_BUFFER_SIZE;
-	spdm_context->transcript.message_mut_b.max_buffer_size =
-		MAX_SPDM_MESSAGE_BUFFER_SIZE;
 	spdm_context->transcript.message_mut_c.max_buffer_size =
 		MAX_SPDM_MESSAGE_SMALL_BUFFER_SIZE;
+#endif
+#if OPENSPDM_ARENA_MANAGED_BUFFER_SUPPORT == 1
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
+	init_arena_managed_buffer(&spdm_context->transcript.message_b,
+				  MAX_SPDM_MESSAGE_BUFFER_SIZE,
+				  &spdm_context->arena);
+	init_arena_managed_buffer(&spdm_context->transcript.message_mut_b,
+				  MAX_SPDM_MESSAGE_BUFFER_SIZE,
+				  &spdm_context->arena);
+#endif
+	init_arena_managed_buffer(&spdm_context->transcript.message_m,
+				  MAX_SPDM_MESSAGE_BUFFER_SIZE,
+				  &spdm_context->arena);
+	init_arena_managed_buffer(
+		&spdm_context->encap_context.certificate_chain_buffer,
+		MAX_SPDM_MESSAGE_BUFFER_SIZE, &spdm_context->arena);
+	init_arena_managed_buffer(
+		&spdm_context->requester_step.certificate_chain_buffer,
+		MAX_SPDM_MESSAGE_BUFFER_SIZE, &spdm_context->arena);
+#else
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
+	spdm_context->transcript.message_b.max_buffer_size =
+		MAX_SPDM_MESSAGE_BUFFER_SIZE;
+	spdm_context->transcript.message_mut_b.max_buffer_size =
+		MAX_SPDM_MESSAGE_BUFFER_SIZE;
+#endif
 	spdm_context->transcript.message_m.max_buffer_size =
 		MAX_SPDM_MESSAGE_BUFFER_SIZE;
+	spdm_context->encap_context.certificate_chain_buffer.max_buffer_size =
+		MAX_SPDM_MESSAGE_BUFFER_SIZE;
+	spdm_context->requester_step.certificate_chain_buffer.max_buffer_size =
+		MAX_SPDM_MESSAGE_BUFFER_SIZE;
+#endif
 	spdm_context->retry_times = MAX_SPDM_REQUEST_RETRY_TIMES;
 	spdm_context->response_state = SPDM_RESPONSE_STATE_NORMAL;
 	spdm_context->current_token = 0;
-	spdm_context->local_context.version.spdm_version_count = 2;
-	spdm_context->local_context.version.spdm_version[0].major_version = 1;
-	spdm_context->local_context.version.spdm_version[0].minor_version = 0;
-	spdm_context->local_context.version.spdm_version[0].alpha = 0;
-	spdm_context->local_context.version.spdm_version[0]
-		.update_version_number = 0;
-	spdm_context->local_context.version.spdm_version[1].major_version = 1;
-	spdm_context->local_context.version.spdm_version[1].minor_version = 1;
-	spdm_context->local_context.version.spdm_version[1].alpha = 0;
-	spdm_context->local_context.version.spdm_version[1]
-		.update_version_number = 0;
-	spdm_context->local_context.secured_message_version.spdm_version_count =
-		1;
-	spdm_context->local_context.secured_message_version.spdm_version[0]
-		.major_version = 1;
-	spdm_context->local_context.secured_message_version.spdm_version[0]
-		.minor_version = 1;
-	spdm_context->local_context.secured_message_version.spdm_version[0]
-		.alpha = 0;
-	spdm_context->local_context.secured_message_version.spdm_version[0]
-		.update_version_number = 0;
-	spdm_context->encap_context.certificate_chain_buffer.max_buffer_size =
-		MAX_SPDM_MESSAGE_BUFFER_SIZE;
 
-	secured_message_context = (void *)((uintn)(spdm_context + 1));
+	//
+	// The own local context, the session table, the secured message contexts and
+	// the session hash buckets follow the SPDM context.
+	//
+	if (local_context == NULL) {
+		local_context = (void *)((uintn)(spdm_context + 1));
+		spdm_init_local_context(local_context);
+		session_info = (void *)((uintn)local_context +
+					sizeof(spdm_local_context_t));
+	} else {
+		session_info = (void *)((uintn)(spdm_context + 1));
+	}
+	spdm_context->local_context = local_context;
+	internal_spdm_get_local_context(spdm_context->local_context);
+
+	secured_message_context = (void *)(session_info + max_session_count);
 	SecuredMessageContextSize = spdm_secured_message_get_context_size();
-	for (index = 0; index < MAX_SPDM_SESSION_COUNT; index++) {
-		spdm_context->session_info[index].secured_message_context =
+	session_hash_bucket =
+		(void *)((uintn)secured_message_context +
+			 SecuredMessageContextSize * max_session_count);
+	bucket_count = spdm_get_session_hash_bucket_count(max_session_count);
+
+	spdm_context->session_info = session_info;
+	spdm_context->max_session_count = (uint32)max_session_count;
+	spdm_context->session_hash_bucket = session_hash_bucket;
+	spdm_context->session_hash_mask = (uint32)(bucket_count - 1);
+	for (index = 0; index < bucket_count; index++) {
+		session_hash_bucket[index] = INVALID_SESSION_INDEX;
+	}
+
+	//
+	// Only the bookkeeping of each session is set here. The session info and its
+	// secured message context are initialized when the session is assigned, so the
+	// storage of unused sessions is never touched.
+	//
+	spdm_context->free_session_index = INVALID_SESSION_INDEX;
+	for (index = max_session_count; index > 0; index--) {
+		session_info[index - 1].session_id = INVALID_SESSION_ID;
+		session_info[index - 1].secured_message_context =
 			(void *)((uintn)secured_message_context +
-				 SecuredMessageContextSize * index);
-		spdm_secured_message_init_context(
-			spdm_context->session_info[index]
-				.secured_message_context);
+				 SecuredMessageContextSize * (index - 1));
+		session_info[index - 1].next_hash_index =
+			INVALID_SESSION_INDEX;
+		session_info[index - 1].next_free_index =
+			spdm_context->free_session_index;
+		session_info[index - 1].in_free_list = TRUE;
+		session_info[index - 1].storage_initialized = FALSE;
+		spdm_context->free_session_index = (uint32)(index - 1);
 	}
 
 	random_seed(NULL, 0);
 	return;
 }
 
+/**
+  Initialize an SPDM context.
+
+  The size in bytes of the spdm_context can be returned by spdm_get_context_size.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+*/
+void spdm_init_context(IN void *context)
+{
+	spdm_init_context_ex(context, MAX_SPDM_SESSION_COUNT);
+}
+
+/**
+  Initialize an SPDM context with a session table of a given capacity.
+
+  The size in bytes of the spdm_context can be returned by spdm_get_context_size_ex
+  with the same max_session_count.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  max_session_count             The maximum number of concurrent sessions.
+*/
+void spdm_init_context_ex(IN void *context, IN uintn max_session_count)
+{
+	internal_spdm_init_context(context, max_session_count, NULL);
+}
+
+/**
+  Initialize an SPDM context that uses a shared SPDM local context.
+
+  The local context holds the local identity: versions, capabilities, algorithms,
+  certificate chains, PSK hint, opaque data and responder policy. Many SPDM contexts,
+  one per peer, may share it. It must be initialized by spdm_init_local_context and
+  must stay valid until all SPDM contexts using it are released by spdm_deinit_context.
+  Local data set through any of the SPDM contexts applies to all of them.
+
+  While messages are processed the local context is only read, so the SPDM contexts
+  sharing it may serve their peers from different threads. The reference count is
+  updated atomically, so SPDM contexts may be attached by this function and released
+  by spdm_deinit_context on different threads (on compilers without atomic builtins
+  these calls must not run concurrently). spdm_set_data of local data writes the
+  local context and must not run concurrently with any other use of the SPDM
+  contexts sharing it.
+
+  The size in bytes of the spdm_context can be returned by
+  spdm_get_context_size_with_local_context with the same max_session_count.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  max_session_count             The maximum number of concurrent sessions.
+  @param  local_context                 A pointer to the shared SPDM local context.
+*/
+void spdm_init_context_with_local_context(IN void *context,
+					  IN uintn max_session_count,
+					  IN void *local_context)
+{
+	ASSERT(local_context != NULL);
+	internal_spdm_init_context(context, max_session_count, local_context);
+}
+
+/**
+  Release the resources held by an SPDM context.
+
+  The running hash, AEAD and HMAC contexts of the connection and its sessions, the
+  cached peer public key, the DHE key pool and the DHE key of a pending requester
+  step operation are freed, and the reference to the local context is dropped.
+  The SPDM context must be initialized again before reuse.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+*/
+void spdm_deinit_context(IN void *context)
+{
+	spdm_context_t *spdm_context;
+
+	spdm_context = context;
+	if (spdm_context->requester_step.dhe_context != NULL) {
+		spdm_secured_message_dhe_free(
+			spdm_context->connection_info.algorithm.dhe_named_group,
+			spdm_context->requester_step.dhe_context);
+		spdm_context->requester_step.dhe_context = NULL;
+	}
+#if OPENSPDM_ARENA_MANAGED_BUFFER_SUPPORT == 1
+	reset_managed_buffer(
+		&spdm_context->requester_step.certificate_chain_buffer);
+#endif
+	spdm_reset_context(spdm_context);
+#if OPENSPDM_ARENA_MANAGED_BUFFER_SUPPORT == 1
+	//The request buffers are kept across spdm_reset_context, since GET_VERSION resets the
+	//context while its request is held there.
+	spdm_free_arena_request_buffer(&spdm_context->arena,
+				       &spdm_context->last_spdm_request);
+	spdm_free_arena_request_buffer(&spdm_context->arena,
+				       &spdm_context->cache_spdm_request);
+#endif
+	spdm_free_dhe_key_pool(spdm_context);
+	if (spdm_context->local_context != NULL) {
+		internal_spdm_put_local_context(spdm_context->local_context);
+		spdm_context->local_context = NULL;
+	}
+}
+
+/**
+  Return the number of SPDM contexts using an SPDM local context.
+
+  @param  local_context                 A pointer to the SPDM local context.
+
+  @return the number of SPDM contexts using the local context.
+**/
+uint32 spdm_get_local_context_ref_count(IN void *context)
+{
+	spdm_local_context_t *local_context;
+
+	local_context = context;
+#if defined(__GNUC__) || defined(__clang__)
+	return __atomic_load_n(&local_context->ref_count, __ATOMIC_RELAXED);
+#else
+	return local_context->ref_count;
+#endif
+}
+
 /**
   Reset an SPDM context.
 
@@ -1101,6 +1696,25 @@ void spdm_reset_context(IN void *context)
 	uintn index;
 
 	spdm_context = context;
+	//Free the running transcript hash before the hash algorithm is cleared
+	spdm_reset_message_b(spdm_context);
+	spdm_reset_message_c(spdm_context);
+	spdm_reset_message_mut_b(spdm_context);
+	spdm_reset_message_mut_c(spdm_context);
+#if OPENSPDM_ARENA_MANAGED_BUFFER_SUPPORT == 1
+	//Return the arena buffers before the encap context is cleared
+	spdm_reset_message_m(spdm_context);
+	reset_managed_buffer(
+		&spdm_context->encap_context.certificate_chain_buffer);
+#endif
+	for (index = 0; index < spdm_context->max_session_count; index++) {
+		if (spdm_context->session_info[index].storage_initialized) {
+			spdm_session_info_free_digest_context(
+				spdm_context,
+				&spdm_context->session_info[index]);
+		}
+	}
+	spdm_free_peer_public_key(spdm_context);
 	//Clear all info about last connection
 	zero_mem(&spdm_context->connection_info.capability, sizeof(spdm_device_capability_t));
 	zero_mem(&spdm_context->connection_info.algorithm, sizeof(spdm_device_algorithm_t));
@@ -1108,6 +1722,7 @@ void spdm_reset_context(IN void *context)
 	zero_mem(&spdm_context->encap_context, sizeof(spdm_encap_context_t));
 	spdm_context->connection_info.local_used_cert_chain_buffer_size = 0;
 	spdm_context->connection_info.local_used_cert_chain_buffer = NULL;
+	spdm_context->connection_info.peer_digest_slot_mask = 0;
 	spdm_context->cache_spdm_request_size = 0;
 	spdm_context->retry_times = MAX_SPDM_REQUEST_RETRY_TIMES;
 	spdm_context->response_state = SPDM_RESPONSE_STATE_NORMAL;
@@ -1115,9 +1730,18 @@ void spdm_reset_context(IN void *context)
 	spdm_context->last_spdm_request_session_id = INVALID_SESSION_ID;
 	spdm_context->last_spdm_request_session_id_valid = FALSE;
 	spdm_context->last_spdm_request_size = 0;
+#if OPENSPDM_ARENA_MANAGED_BUFFER_SUPPORT == 1
+	init_arena_managed_buffer(
+		&spdm_context->encap_context.certificate_chain_buffer,
+		MAX_SPDM_MESSAGE_BUFFER_SIZE, &spdm_context->arena);
+#else
 	spdm_context->encap_context.certificate_chain_buffer.max_buffer_size = MAX_SPDM_MESSAGE_BUFFER_SIZE;
-	for (index = 0; index < MAX_SPDM_SESSION_COUNT; index++)
+#endif
+	for (index = 0; index < spdm_context->max_session_count; index++)
 	{
+		if (!spdm_context->session_info[index].storage_initialized) {
+			continue;
+		}
 		spdm_session_info_init(spdm_context,
 							&spdm_context->session_info[index],
 							INVALID_SESSION_ID,
@@ -1130,7 +1754,46 @@ void spdm_reset_context(IN void *context)
   @return the size in bytes of the SPDM context.
 **/
 uintn spdm_get_context_size(void)
+{
+	return spdm_get_context_size_ex(MAX_SPDM_SESSION_COUNT);
+}
+
+/**
+  Return the size in bytes of the SPDM context with a session table of a given capacity.
+
+  @param  max_session_count             The maximum number of concurrent sessions.
+
+  @return the size in bytes of the SPDM context.
+**/
+uintn spdm_get_context_size_ex(IN uintn max_session_count)
+{
+	return sizeof(spdm_local_context_t) +
+	       spdm_get_context_size_with_local_context(max_session_count);
+}
+
+/**
+  Return the size in bytes of an SPDM context that uses a shared SPDM local context.
+
+  @param  max_session_count             The maximum number of concurrent sessions.
+
+  @return the size in bytes of the SPDM context.
+**/
+uintn spdm_get_context_size_with_local_context(IN uintn max_session_count)
 {
 	return sizeof(spdm_context_t) +
-	       spdm_secured_message_get_context_size() * MAX_SPDM_SESSION_COUNT;
+	       (sizeof(spdm_session_info_t) +
+		spdm_secured_message_get_context_size()) *
+		       max_session_count +
+	       sizeof(uint32) *
+		       spdm_get_session_hash_bucket_count(max_session_count);
+}
+
+/**
+  Return the size in bytes of an SPDM local context.
+
+  @return the size in bytes of the SPDM local context.
+**/
+uintn spdm_get_local_context_size(void)
+{
+	return sizeof(spdm_local_context_t);
 }
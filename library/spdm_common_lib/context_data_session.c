@@ -6,6 +6,123 @@
 
 #include "spdm_common_lib_internal.h"
 
+/**
+  This function frees the running TH hash context of the session info.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  session_info                  A pointer to the SPDM session info.
+**/
+void spdm_session_info_free_digest_context(IN spdm_context_t *spdm_context,
+					   IN spdm_session_info_t *session_info)
+{
+	if (session_info->session_transcript.digest_context_th != NULL) {
+		spdm_hash_free(
+			spdm_context->connection_info.algorithm.base_hash_algo,
+			session_info->session_transcript.digest_context_th);
+		session_info->session_transcript.digest_context_th = NULL;
+	}
+}
+
+/**
+  This function returns the hash bucket of a session ID.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  session_id                    The SPDM session ID.
+
+  @return the index of the session hash bucket.
+**/
+static uint32 spdm_get_session_hash(IN spdm_context_t *spdm_context,
+				    IN uint32 session_id)
+{
+	return (session_id ^ (session_id >> 16)) &
+	       spdm_context->session_hash_mask;
+}
+
+/**
+  This function removes a session info from the session hash table.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  session_info                  A pointer to the SPDM session info.
+**/
+static void spdm_session_info_unlink_hash(IN spdm_context_t *spdm_context,
+					  IN spdm_session_info_t *session_info)
+{
+	uint32 session_index;
+	uint32 *link;
+
+	if (session_info->session_id == INVALID_SESSION_ID) {
+		return;
+	}
+	session_index = (uint32)(session_info - spdm_context->session_info);
+	link = &spdm_context->session_hash_bucket[spdm_get_session_hash(
+		spdm_context, session_info->session_id)];
+	while (*link != INVALID_SESSION_INDEX) {
+		if (*link == session_index) {
+			*link = session_info->next_hash_index;
+			break;
+		}
+		link = &spdm_context->session_info[*link].next_hash_index;
+	}
+	session_info->next_hash_index = INVALID_SESSION_INDEX;
+}
+
+/**
+  This function adds a session info to the session hash table, or to the free list
+  if it has no session ID.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  session_info                  A pointer to the SPDM session info.
+**/
+static void spdm_session_info_link(IN spdm_context_t *spdm_context,
+				   IN spdm_session_info_t *session_info)
+{
+	uint32 session_index;
+	uint32 *bucket;
+
+	session_index = (uint32)(session_info - spdm_context->session_info);
+	if (session_info->session_id == INVALID_SESSION_ID) {
+		if (!session_info->in_free_list) {
+			session_info->next_free_index =
+				spdm_context->free_session_index;
+			session_info->in_free_list = TRUE;
+			spdm_context->free_session_index = session_index;
+		}
+		return;
+	}
+	bucket = &spdm_context->session_hash_bucket[spdm_get_session_hash(
+		spdm_context, session_info->session_id)];
+	session_info->next_hash_index = *bucket;
+	*bucket = session_index;
+}
+
+/**
+  This function returns the index of the next free session info.
+
+  A session info taken by spdm_session_info_init without spdm_assign_session_id
+  may still be in the free list. It is dropped from the list here.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+
+  @return the index of a free session info, or INVALID_SESSION_INDEX if the table is full.
+**/
+static uint32 spdm_get_free_session_index(IN spdm_context_t *spdm_context)
+{
+	spdm_session_info_t *session_info;
+	uint32 index;
+
+	index = spdm_context->free_session_index;
+	while (index != INVALID_SESSION_INDEX) {
+		session_info = &spdm_context->session_info[index];
+		if (session_info->session_id == INVALID_SESSION_ID) {
+			break;
+		}
+		index = session_info->next_free_index;
+		session_info->in_free_list = FALSE;
+	}
+	spdm_context->free_session_index = index;
+	return index;
+}
+
 /**
   This function initializes the session info.
 
@@ -20,7 +137,7 @@ void spdm_session_info_init(IN spdm_context_t *spdm_context,
 	uint32 capabilities_flag;
 
 	capabilities_flag = spdm_context->connection_info.capability.flags &
-			    spdm_context->local_context.capability.flags;
+			    spdm_context->local_context->capability.flags;
 	switch (capabilities_flag &
 		(SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP |
 		 SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP)) {
@@ -40,11 +157,26 @@ void spdm_session_info_init(IN spdm_context_t *spdm_context,
 		break;
 	}
 
+	if (session_info->storage_initialized) {
+		spdm_session_info_free_digest_context(spdm_context,
+						      session_info);
+		spdm_secured_message_free_aead_context(
+			session_info->secured_message_context);
+		spdm_secured_message_free_hmac_context(
+			session_info->secured_message_context);
+#if OPENSPDM_ARENA_MANAGED_BUFFER_SUPPORT == 1
+		reset_managed_buffer(&session_info->session_transcript.message_k);
+		reset_managed_buffer(&session_info->session_transcript.message_f);
+#endif
+	}
+	spdm_session_info_unlink_hash(spdm_context, session_info);
 	zero_mem(session_info,
 		 OFFSET_OF(spdm_session_info_t, secured_message_context));
 	spdm_secured_message_init_context(
 		session_info->secured_message_context);
+	session_info->storage_initialized = TRUE;
 	session_info->session_id = session_id;
+	spdm_session_info_link(spdm_context, session_info);
 	session_info->use_psk = use_psk;
 	spdm_secured_message_set_use_psk(session_info->secured_message_context,
 					 use_psk);
@@ -58,12 +190,21 @@ void spdm_session_info_init(IN spdm_context_t *spdm_context,
 		spdm_context->connection_info.algorithm.key_schedule);
 	spdm_secured_message_set_psk_hint(
 		session_info->secured_message_context,
-		spdm_context->local_context.psk_hint,
-		spdm_context->local_context.psk_hint_size);
+		spdm_context->local_context->psk_hint,
+		spdm_context->local_context->psk_hint_size);
+#if OPENSPDM_ARENA_MANAGED_BUFFER_SUPPORT == 1
+	init_arena_managed_buffer(&session_info->session_transcript.message_k,
+				  MAX_SPDM_MESSAGE_BUFFER_SIZE,
+				  &spdm_context->arena);
+	init_arena_managed_buffer(&session_info->session_transcript.message_f,
+				  MAX_SPDM_MESSAGE_BUFFER_SIZE,
+				  &spdm_context->arena);
+#else
 	session_info->session_transcript.message_k.max_buffer_size =
 		MAX_SPDM_MESSAGE_BUFFER_SIZE;
 	session_info->session_transcript.message_f.max_buffer_size =
 		MAX_SPDM_MESSAGE_BUFFER_SIZE;
+#endif
 }
 
 /**
@@ -79,7 +220,7 @@ void *spdm_get_session_info_via_session_id(IN void *context,
 {
 	spdm_context_t *spdm_context;
 	spdm_session_info_t *session_info;
-	uintn index;
+	uint32 index;
 
 	if (session_id == INVALID_SESSION_ID) {
 		DEBUG((DEBUG_ERROR,
@@ -91,10 +232,13 @@ void *spdm_get_session_info_via_session_id(IN void *context,
 	spdm_context = context;
 
 	session_info = spdm_context->session_info;
-	for (index = 0; index < MAX_SPDM_SESSION_COUNT; index++) {
+	index = spdm_context->session_hash_bucket[spdm_get_session_hash(
+		spdm_context, session_id)];
+	while (index != INVALID_SESSION_INDEX) {
 		if (session_info[index].session_id == session_id) {
 			return &session_info[index];
 		}
+		index = session_info[index].next_hash_index;
 	}
 
 	DEBUG((DEBUG_ERROR,
@@ -157,7 +301,7 @@ void *spdm_assign_session_id(IN void *context, IN uint32 session_id,
 {
 	spdm_context_t *spdm_context;
 	spdm_session_info_t *session_info;
-	uintn index;
+	uint32 index;
 
 	spdm_context = context;
 
@@ -170,27 +314,31 @@ void *spdm_assign_session_id(IN void *context, IN uint32 session_id,
 
 	session_info = spdm_context->session_info;
 
-	for (index = 0; index < MAX_SPDM_SESSION_COUNT; index++) {
+	index = spdm_context->session_hash_bucket[spdm_get_session_hash(
+		spdm_context, session_id)];
+	while (index != INVALID_SESSION_INDEX) {
 		if (session_info[index].session_id == session_id) {
 			DEBUG((DEBUG_ERROR,
 			       "spdm_assign_session_id - Duplicated session_id\n"));
 			ASSERT(FALSE);
 			return NULL;
 		}
+		index = session_info[index].next_hash_index;
 	}
 
-	for (index = 0; index < MAX_SPDM_SESSION_COUNT; index++) {
-		if (session_info[index].session_id == INVALID_SESSION_ID) {
-			spdm_session_info_init(spdm_context,
-					       &session_info[index], session_id,
-					       use_psk);
-			spdm_context->latest_session_id = session_id;
-			return &session_info[index];
-		}
+	index = spdm_get_free_session_index(spdm_context);
+	if (index == INVALID_SESSION_INDEX) {
+		DEBUG((DEBUG_ERROR,
+		       "spdm_assign_session_id - MAX session_id\n"));
+		return NULL;
 	}
+	spdm_context->free_session_index = session_info[index].next_free_index;
+	session_info[index].in_free_list = FALSE;
 
-	DEBUG((DEBUG_ERROR, "spdm_assign_session_id - MAX session_id\n"));
-	return NULL;
+	spdm_session_info_init(spdm_context, &session_info[index], session_id,
+			       use_psk);
+	spdm_context->latest_session_id = session_id;
+	return &session_info[index];
 }
 
 /**
@@ -203,16 +351,12 @@ void *spdm_assign_session_id(IN void *context, IN uint32 session_id,
 uint16 spdm_allocate_req_session_id(IN spdm_context_t *spdm_context)
 {
 	uint16 req_session_id;
-	spdm_session_info_t *session_info;
-	uintn index;
+	uint32 index;
 
-	session_info = spdm_context->session_info;
-	for (index = 0; index < MAX_SPDM_SESSION_COUNT; index++) {
-		if ((session_info[index].session_id & 0xFFFF0000) ==
-		    (INVALID_SESSION_ID & 0xFFFF0000)) {
-			req_session_id = (uint16)(0xFFFF - index);
-			return req_session_id;
-		}
+	index = spdm_get_free_session_index(spdm_context);
+	if (index != INVALID_SESSION_INDEX) {
+		req_session_id = (uint16)(0xFFFF - index);
+		return req_session_id;
 	}
 
 	DEBUG((DEBUG_ERROR, "spdm_allocate_req_session_id - MAX session_id\n"));
@@ -229,16 +373,12 @@ uint16 spdm_allocate_req_session_id(IN spdm_context_t *spdm_context)
 uint16 spdm_allocate_rsp_session_id(IN spdm_context_t *spdm_context)
 {
 	uint16 rsp_session_id;
-	spdm_session_info_t *session_info;
-	uintn index;
+	uint32 index;
 
-	session_info = spdm_context->session_info;
-	for (index = 0; index < MAX_SPDM_SESSION_COUNT; index++) {
-		if ((session_info[index].session_id & 0xFFFF) ==
-		    (INVALID_SESSION_ID & 0xFFFF)) {
-			rsp_session_id = (uint16)(0xFFFF - index);
-			return rsp_session_id;
-		}
+	index = spdm_get_free_session_index(spdm_context);
+	if (index != INVALID_SESSION_INDEX) {
+		rsp_session_id = (uint16)(0xFFFF - index);
+		return rsp_session_id;
 	}
 
 	DEBUG((DEBUG_ERROR, "spdm_allocate_rsp_session_id - MAX session_id\n"));
@@ -257,7 +397,6 @@ void *spdm_free_session_id(IN void *context, IN uint32 session_id)
 {
 	spdm_context_t *spdm_context;
 	spdm_session_info_t *session_info;
-	uintn index;
 
 	spdm_context = context;
 
@@ -268,14 +407,12 @@ void *spdm_free_session_id(IN void *context, IN uint32 session_id)
 		return NULL;
 	}
 
-	session_info = spdm_context->session_info;
-	for (index = 0; index < MAX_SPDM_SESSION_COUNT; index++) {
-		if (session_info[index].session_id == session_id) {
-			spdm_session_info_init(spdm_context,
-					       &session_info[index],
-					       INVALID_SESSION_ID, FALSE);
-			return &session_info[index];
-		}
+	session_info = spdm_get_session_info_via_session_id(spdm_context,
+							    session_id);
+	if (session_info != NULL) {
+		spdm_session_info_init(spdm_context, session_info,
+				       INVALID_SESSION_ID, FALSE);
+		return session_info;
 	}
 
 	DEBUG((DEBUG_ERROR, "spdm_free_session_id - MAX session_id\n"));
@@ -32,12 +32,12 @@ boolean spdm_get_peer_cert_chain_buffer(IN void *context,
 				.peer_used_cert_chain_buffer_size;
 		return TRUE;
 	}
-	if (spdm_context->local_context.peer_cert_chain_provision_size != 0) {
+	if (spdm_context->local_context->peer_cert_chain_provision_size != 0) {
 		*cert_chain_buffer =
-			spdm_context->local_context.peer_cert_chain_provision;
+			spdm_context->local_context->peer_cert_chain_provision;
 		*cert_chain_buffer_size =
 			spdm_context->local_context
-				.peer_cert_chain_provision_size;
+				->peer_cert_chain_provision_size;
 		return TRUE;
 	}
 	return FALSE;
@@ -144,6 +144,7 @@ boolean spdm_get_local_cert_chain_data(IN void *context,
 	return TRUE;
 }
 
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 /*
   This function calculates m1m2.
 
@@ -173,7 +174,8 @@ boolean spdm_calculate_m1m2(IN void *context, IN boolean is_mut,
 
 	if (is_mut) {
 		DEBUG((DEBUG_INFO, "message_mut_b data :\n"));
-		internal_dump_hex(
+		internal_dump_transcript(
+			spdm_context,
 			get_managed_buffer(
 				&spdm_context->transcript.message_mut_b),
 			get_managed_buffer_size(
@@ -189,7 +191,8 @@ boolean spdm_calculate_m1m2(IN void *context, IN boolean is_mut,
 		}
 
 		DEBUG((DEBUG_INFO, "message_mut_c data :\n"));
-		internal_dump_hex(
+		internal_dump_transcript(
+			spdm_context,
 			get_managed_buffer(
 				&spdm_context->transcript.message_mut_c),
 			get_managed_buffer_size(
@@ -215,7 +218,8 @@ boolean spdm_calculate_m1m2(IN void *context, IN boolean is_mut,
 
 	} else {
 		DEBUG((DEBUG_INFO, "message_a data :\n"));
-		internal_dump_hex(
+		internal_dump_transcript(
+			spdm_context,
 			get_managed_buffer(&spdm_context->transcript.message_a),
 			get_managed_buffer_size(
 				&spdm_context->transcript.message_a));
@@ -229,7 +233,8 @@ boolean spdm_calculate_m1m2(IN void *context, IN boolean is_mut,
 		}
 
 		DEBUG((DEBUG_INFO, "message_b data :\n"));
-		internal_dump_hex(
+		internal_dump_transcript(
+			spdm_context,
 			get_managed_buffer(&spdm_context->transcript.message_b),
 			get_managed_buffer_size(
 				&spdm_context->transcript.message_b));
@@ -243,7 +248,8 @@ boolean spdm_calculate_m1m2(IN void *context, IN boolean is_mut,
 		}
 
 		DEBUG((DEBUG_INFO, "message_c data :\n"));
-		internal_dump_hex(
+		internal_dump_transcript(
+			spdm_context,
 			get_managed_buffer(&spdm_context->transcript.message_c),
 			get_managed_buffer_size(
 				&spdm_context->transcript.message_c));
@@ -271,6 +277,123 @@ boolean spdm_calculate_m1m2(IN void *context, IN boolean is_mut,
 
 	return TRUE;
 }
+#endif
+
+/*
+  This function calculates m1m2 hash.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  is_mut                        Indicate if this is from mutual authentication.
+  @param  m1m2_hash                     The buffer to store the m1m2 hash
+
+  @retval TRUE  m1m2 hash is calculated.
+  @retval FALSE m1m2 hash is not calculated.
+*/
+boolean spdm_calculate_m1m2_hash(IN void *context, IN boolean is_mut,
+				 OUT uint8 *m1m2_hash)
+{
+	spdm_context_t *spdm_context;
+	uint32 base_hash_algo;
+	boolean result;
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
+	spdm_iovec_t iov[3];
+	uintn iov_count;
+#else
+	void *digest_context;
+	void *digest_context_m1m2;
+#endif
+
+	spdm_context = context;
+	base_hash_algo = spdm_context->connection_info.algorithm.base_hash_algo;
+
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
+	//
+	// Hash the transcript in place instead of concatenating it first.
+	//
+	if (is_mut) {
+		iov[0].data = get_managed_buffer(
+			&spdm_context->transcript.message_mut_b);
+		iov[0].data_size = get_managed_buffer_size(
+			&spdm_context->transcript.message_mut_b);
+		iov[1].data = get_managed_buffer(
+			&spdm_context->transcript.message_mut_c);
+		iov[1].data_size = get_managed_buffer_size(
+			&spdm_context->transcript.message_mut_c);
+		iov_count = 2;
+	} else {
+		iov[0].data =
+			get_managed_buffer(&spdm_context->transcript.message_a);
+		iov[0].data_size = get_managed_buffer_size(
+			&spdm_context->transcript.message_a);
+		iov[1].data =
+			get_managed_buffer(&spdm_context->transcript.message_b);
+		iov[1].data_size = get_managed_buffer_size(
+			&spdm_context->transcript.message_b);
+		iov[2].data =
+			get_managed_buffer(&spdm_context->transcript.message_c);
+		iov[2].data_size = get_managed_buffer_size(
+			&spdm_context->transcript.message_c);
+		iov_count = 3;
+	}
+	result = spdm_hash_multi(base_hash_algo, iov, iov_count, m1m2_hash);
+	if (!result) {
+		return FALSE;
+	}
+#else
+	//
+	// Without a C message, the transcript is the (A, B) hash.
+	//
+	if (is_mut) {
+		digest_context = spdm_context->transcript.digest_context_mut_m1m2;
+		if (digest_context == NULL) {
+			digest_context =
+				spdm_context->transcript.digest_context_mut_b;
+		}
+	} else {
+		digest_context = spdm_context->transcript.digest_context_m1m2;
+		if (digest_context == NULL) {
+			digest_context =
+				spdm_context->transcript.digest_context_b;
+		}
+	}
+	if (digest_context == NULL) {
+		//
+		// No B or C message is appended, the transcript is A or empty.
+		//
+		if (is_mut) {
+			spdm_hash_all(base_hash_algo, NULL, 0, m1m2_hash);
+		} else {
+			spdm_hash_all(base_hash_algo,
+				      get_managed_buffer(
+					      &spdm_context->transcript.message_a),
+				      get_managed_buffer_size(
+					      &spdm_context->transcript.message_a),
+				      m1m2_hash);
+		}
+	} else {
+		digest_context_m1m2 = spdm_hash_new(base_hash_algo);
+		if (digest_context_m1m2 == NULL) {
+			return FALSE;
+		}
+		result = spdm_hash_duplicate(base_hash_algo, digest_context,
+					     digest_context_m1m2);
+		if (result) {
+			result = spdm_hash_final(base_hash_algo,
+						 digest_context_m1m2, m1m2_hash);
+		}
+		spdm_hash_free(base_hash_algo, digest_context_m1m2);
+		if (!result) {
+			return FALSE;
+		}
+	}
+#endif
+
+	DEBUG((DEBUG_INFO, is_mut ? "m1m2 Mut hash - " : "m1m2 hash - "));
+	internal_dump_data(m1m2_hash, spdm_get_hash_size(base_hash_algo));
+	DEBUG((DEBUG_INFO, "\n"));
+
+	return TRUE;
+}
 
 /*
   This function calculates l1l2.
@@ -294,7 +417,8 @@ boolean spdm_calculate_l1l2(IN void *context, IN OUT uintn *l1l2_buffer_size,
 		spdm_context->connection_info.algorithm.base_hash_algo);
 
 	DEBUG((DEBUG_INFO, "message_m data :\n"));
-	internal_dump_hex(
+	internal_dump_transcript(
+		spdm_context,
 		get_managed_buffer(&spdm_context->transcript.message_m),
 		get_managed_buffer_size(&spdm_context->transcript.message_m));
 
@@ -330,16 +454,278 @@ boolean spdm_calculate_l1l2(IN void *context, IN OUT uintn *l1l2_buffer_size,
 boolean spdm_generate_cert_chain_hash(IN spdm_context_t *spdm_context,
 				      IN uintn slot_id, OUT uint8 *hash)
 {
-	ASSERT(slot_id < spdm_context->local_context.slot_count);
-	spdm_hash_all(
-		spdm_context->connection_info.algorithm.base_hash_algo,
-		spdm_context->local_context.local_cert_chain_provision[slot_id],
+	ASSERT(slot_id < spdm_context->local_context->slot_count);
+	spdm_calculate_cert_chain_hash(
+		spdm_context,
+		spdm_context->local_context->local_cert_chain_provision[slot_id],
 		spdm_context->local_context
-			.local_cert_chain_provision_size[slot_id],
+			->local_cert_chain_provision_size[slot_id],
 		hash);
 	return TRUE;
 }
 
+/**
+  This function looks up a certificate chain in a certificate chain hash cache entry.
+
+  The cache entry is filled for the negotiated hash algorithm if it is invalid.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  cache                         The certificate chain hash cache entry.
+  @param  cert_chain_buffer              Certitiface chain buffer including spdm_cert_chain_t header of the cache entry.
+  @param  cert_chain_buffer_size          size in bytes of the certitiface chain buffer.
+  @param  cert_chain                    The certitiface chain to be looked up.
+  @param  cert_chain_size               size in bytes of the certitiface chain to be looked up.
+  @param  hash                          The buffer to store the certificate chain hash.
+
+  @retval TRUE  the certificate chain belongs to the cache entry and the hash is returned.
+  @retval FALSE the certificate chain does not belong to the cache entry.
+**/
+boolean spdm_lookup_cert_chain_hash_cache(
+	IN spdm_context_t *spdm_context,
+	IN OUT spdm_cert_chain_hash_cache_t *cache, IN void *cert_chain_buffer,
+	IN uintn cert_chain_buffer_size, IN void *cert_chain,
+	IN uintn cert_chain_size, OUT uint8 *hash)
+{
+	uint32 base_hash_algo;
+	uintn hash_size;
+	uintn cert_chain_data_offset;
+	boolean is_cert_chain_data;
+
+	if ((cert_chain_buffer == NULL) || (cert_chain_buffer_size == 0)) {
+		return FALSE;
+	}
+
+	base_hash_algo = spdm_context->connection_info.algorithm.base_hash_algo;
+	hash_size = spdm_get_hash_size(base_hash_algo);
+	cert_chain_data_offset = sizeof(spdm_cert_chain_t) + hash_size;
+	if (cert_chain_buffer_size <= cert_chain_data_offset) {
+		return FALSE;
+	}
+
+	if ((cert_chain == cert_chain_buffer) &&
+	    (cert_chain_size == cert_chain_buffer_size)) {
+		is_cert_chain_data = FALSE;
+	} else if ((cert_chain == (uint8 *)cert_chain_buffer +
+					 cert_chain_data_offset) &&
+		   (cert_chain_size ==
+		    cert_chain_buffer_size - cert_chain_data_offset)) {
+		is_cert_chain_data = TRUE;
+	} else {
+		return FALSE;
+	}
+
+	if ((cache->base_hash_algo != base_hash_algo) ||
+	    (cache->cert_chain_buffer != cert_chain_buffer) ||
+	    (cache->cert_chain_buffer_size != cert_chain_buffer_size)) {
+		spdm_hash_all(base_hash_algo, cert_chain_buffer,
+			      cert_chain_buffer_size, cache->cert_chain_hash);
+		spdm_hash_all(base_hash_algo,
+			      (uint8 *)cert_chain_buffer +
+				      cert_chain_data_offset,
+			      cert_chain_buffer_size - cert_chain_data_offset,
+			      cache->cert_chain_data_hash);
+		cache->base_hash_algo = base_hash_algo;
+		cache->cert_chain_buffer = cert_chain_buffer;
+		cache->cert_chain_buffer_size = cert_chain_buffer_size;
+	}
+
+	if (is_cert_chain_data) {
+		copy_mem(hash, cache->cert_chain_data_hash, hash_size);
+	} else {
+		copy_mem(hash, cache->cert_chain_hash, hash_size);
+	}
+	return TRUE;
+}
+
+/**
+  This function calculates the hash of a certificate chain buffer or certificate chain data.
+
+  If the certificate chain is a local provisioned certificate chain or the peer certificate chain,
+  the hash is taken from the certificate chain hash cache, which is filled on first use for
+  the negotiated hash algorithm. Otherwise, the hash is calculated directly.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  cert_chain                    Certitiface chain buffer including spdm_cert_chain_t header,
+                                        or certitiface chain data without spdm_cert_chain_t header.
+  @param  cert_chain_size               size in bytes of the certitiface chain.
+  @param  hash                          The buffer to store the certificate chain hash.
+**/
+void spdm_calculate_cert_chain_hash(IN spdm_context_t *spdm_context,
+				    IN void *cert_chain,
+				    IN uintn cert_chain_size,
+				    OUT uint8 *hash)
+{
+	uintn index;
+	void *cert_chain_buffer;
+	uintn cert_chain_buffer_size;
+	spdm_cert_chain_hash_cache_t *cache;
+
+	for (index = 0; index < spdm_context->local_context->slot_count;
+	     index++) {
+		cache = &spdm_context->local_cert_chain_hash_cache[index];
+		if (cache->generation !=
+		    spdm_context->local_context
+			    ->local_cert_chain_generation[index]) {
+			cache->base_hash_algo = 0;
+			cache->generation =
+				spdm_context->local_context
+					->local_cert_chain_generation[index];
+		}
+		if (spdm_lookup_cert_chain_hash_cache(
+			    spdm_context, cache,
+			    spdm_context->local_context
+				    ->local_cert_chain_provision[index],
+			    spdm_context->local_context
+				    ->local_cert_chain_provision_size[index],
+			    cert_chain, cert_chain_size, hash)) {
+			return;
+		}
+	}
+
+	if (spdm_get_peer_cert_chain_buffer(spdm_context, &cert_chain_buffer,
+					    &cert_chain_buffer_size)) {
+		cache = &spdm_context->connection_info
+				 .peer_cert_chain_hash_cache;
+		if (cache->generation !=
+		    spdm_context->local_context->peer_cert_chain_generation) {
+			cache->base_hash_algo = 0;
+			cache->generation = spdm_context->local_context
+						    ->peer_cert_chain_generation;
+		}
+		if (spdm_lookup_cert_chain_hash_cache(
+			    spdm_context, cache, cert_chain_buffer,
+			    cert_chain_buffer_size, cert_chain,
+			    cert_chain_size, hash)) {
+			return;
+		}
+	}
+
+	spdm_hash_all(spdm_context->connection_info.algorithm.base_hash_algo,
+		      cert_chain, cert_chain_size, hash);
+}
+
+/**
+  This function invalidates the cached hash and the cached public key of the peer certificate chain.
+
+  It must be called whenever the peer certificate chain buffer is changed.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+**/
+void spdm_invalidate_peer_cert_chain_hash(IN spdm_context_t *spdm_context)
+{
+	spdm_context->connection_info.peer_cert_chain_hash_cache.base_hash_algo =
+		0;
+	spdm_free_peer_public_key(spdm_context);
+}
+
+/**
+  This function returns the public key of the leaf certificate in the peer certificate chain.
+
+  The public key is parsed on first use and kept in the connection info until the peer
+  certificate chain is changed or the SPDM context is reset.
+  The caller must not free the returned public key.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  is_req_asym_algo              TRUE if the peer is a requester and the key uses req_base_asym_alg.
+                                        FALSE if the peer is a responder and the key uses base_asym_algo.
+  @param  public_key                    The public key context of the peer leaf certificate.
+
+  @retval TRUE  The public key is returned.
+  @retval FALSE The public key cannot be retrieved.
+**/
+boolean spdm_get_peer_public_key(IN spdm_context_t *spdm_context,
+				 IN boolean is_req_asym_algo,
+				 OUT void **public_key)
+{
+	spdm_peer_public_key_cache_t *cache;
+	uint8 *cert_chain_data;
+	uintn cert_chain_data_size;
+	uint8 *cert_buffer;
+	uintn cert_buffer_size;
+	uint32 asym_algo;
+	void *context;
+	boolean result;
+
+	if (is_req_asym_algo) {
+		asym_algo = spdm_context->connection_info.algorithm
+				    .req_base_asym_alg;
+	} else {
+		asym_algo =
+			spdm_context->connection_info.algorithm.base_asym_algo;
+	}
+
+	result = spdm_get_peer_cert_chain_data(
+		spdm_context, (void **)&cert_chain_data, &cert_chain_data_size);
+	if (!result) {
+		return FALSE;
+	}
+
+	cache = &spdm_context->connection_info.peer_public_key_cache;
+	if ((cache->public_key != NULL) && (cache->asym_algo == asym_algo) &&
+	    (cache->is_req_asym_algo == is_req_asym_algo) &&
+	    (cache->cert_chain_data == cert_chain_data) &&
+	    (cache->cert_chain_data_size == cert_chain_data_size) &&
+	    (cache->generation ==
+	     spdm_context->local_context->peer_cert_chain_generation)) {
+		*public_key = cache->public_key;
+		return TRUE;
+	}
+	spdm_free_peer_public_key(spdm_context);
+
+	//
+	// Get leaf cert from cert chain
+	//
+	result = x509_get_cert_from_cert_chain(cert_chain_data,
+					       cert_chain_data_size, -1,
+					       &cert_buffer, &cert_buffer_size);
+	if (!result) {
+		return FALSE;
+	}
+
+	if (is_req_asym_algo) {
+		result = spdm_req_asym_get_public_key_from_x509(
+			(uint16)asym_algo, cert_buffer, cert_buffer_size,
+			&context);
+	} else {
+		result = spdm_asym_get_public_key_from_x509(
+			asym_algo, cert_buffer, cert_buffer_size, &context);
+	}
+	if (!result) {
+		return FALSE;
+	}
+
+	cache->public_key = context;
+	cache->asym_algo = asym_algo;
+	cache->is_req_asym_algo = is_req_asym_algo;
+	cache->cert_chain_data = cert_chain_data;
+	cache->cert_chain_data_size = cert_chain_data_size;
+	cache->generation =
+		spdm_context->local_context->peer_cert_chain_generation;
+	*public_key = context;
+	return TRUE;
+}
+
+/**
+  This function frees the cached public key of the peer certificate chain.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+**/
+void spdm_free_peer_public_key(IN spdm_context_t *spdm_context)
+{
+	spdm_peer_public_key_cache_t *cache;
+
+	cache = &spdm_context->connection_info.peer_public_key_cache;
+	if (cache->public_key == NULL) {
+		return;
+	}
+	if (cache->is_req_asym_algo) {
+		spdm_req_asym_free((uint16)cache->asym_algo, cache->public_key);
+	} else {
+		spdm_asym_free(cache->asym_algo, cache->public_key);
+	}
+	zero_mem(cache, sizeof(spdm_peer_public_key_cache_t));
+}
+
 /**
   This function verifies the digest.
 
@@ -361,18 +747,17 @@ boolean spdm_verify_peer_digests(IN spdm_context_t *spdm_context,
 	uintn index;
 
 	cert_chain_buffer =
-		spdm_context->local_context.peer_cert_chain_provision;
+		spdm_context->local_context->peer_cert_chain_provision;
 	cert_chain_buffer_size =
-		spdm_context->local_context.peer_cert_chain_provision_size;
+		spdm_context->local_context->peer_cert_chain_provision_size;
 	if ((cert_chain_buffer != NULL) && (cert_chain_buffer_size != 0)) {
 		hash_size = spdm_get_hash_size(
 			spdm_context->connection_info.algorithm.base_hash_algo);
 		hash_buffer = digest;
 
-		spdm_hash_all(
-			spdm_context->connection_info.algorithm.base_hash_algo,
-			cert_chain_buffer, cert_chain_buffer_size,
-			cert_chain_buffer_hash);
+		spdm_calculate_cert_chain_hash(spdm_context, cert_chain_buffer,
+					       cert_chain_buffer_size,
+					       cert_chain_buffer_hash);
 
 		for (index = 0; index < digest_count; index++)
 		{
@@ -406,27 +791,50 @@ boolean spdm_verify_peer_cert_chain_buffer(IN spdm_context_t *spdm_context,
 					   IN void *cert_chain_buffer,
 					   IN uintn cert_chain_buffer_size)
 {
-	uint8 *cert_chain_data;
-	uintn cert_chain_data_size;
-	uintn hash_size;
-	uint8 *root_cert_hash;
-	uintn root_cert_hash_size;
 	boolean result;
 
-	result = spdm_verify_certificate_chain_buffer(
+	result = spdm_verify_certificate_chain_buffer_with_cache(
+		spdm_context->cert_chain_verify_cache,
 		spdm_context->connection_info.algorithm.base_hash_algo,
 		cert_chain_buffer, cert_chain_buffer_size);
 	if (!result) {
 		return FALSE;
 	}
 
+	return spdm_verify_peer_cert_chain_buffer_provision(
+		spdm_context, cert_chain_buffer, cert_chain_buffer_size);
+}
+
+/**
+  This function verifies peer certificate chain buffer including spdm_cert_chain_t header
+  against the provisioned peer root certificate hash or peer certificate chain.
+
+  The integrity of the certificate chain itself is not verified.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  cert_chain_buffer              Certitiface chain buffer including spdm_cert_chain_t header.
+  @param  cert_chain_buffer_size          size in bytes of the certitiface chain buffer.
+
+  @retval TRUE  Peer certificate chain buffer matches the provisioned trust anchor.
+  @retval FALSE Peer certificate chain buffer does not match the provisioned trust anchor.
+**/
+boolean spdm_verify_peer_cert_chain_buffer_provision(
+	IN spdm_context_t *spdm_context, IN void *cert_chain_buffer,
+	IN uintn cert_chain_buffer_size)
+{
+	uint8 *cert_chain_data;
+	uintn cert_chain_data_size;
+	uintn hash_size;
+	uint8 *root_cert_hash;
+	uintn root_cert_hash_size;
+
 	root_cert_hash =
-		spdm_context->local_context.peer_root_cert_hash_provision;
+		spdm_context->local_context->peer_root_cert_hash_provision;
 	root_cert_hash_size =
-		spdm_context->local_context.peer_root_cert_hash_provision_size;
-	cert_chain_data = spdm_context->local_context.peer_cert_chain_provision;
+		spdm_context->local_context->peer_root_cert_hash_provision_size;
+	cert_chain_data = spdm_context->local_context->peer_cert_chain_provision;
 	cert_chain_data_size =
-		spdm_context->local_context.peer_cert_chain_provision_size;
+		spdm_context->local_context->peer_cert_chain_provision_size;
 
 	if ((root_cert_hash != NULL) && (root_cert_hash_size != 0)) {
 		hash_size = spdm_get_hash_size(
@@ -478,34 +886,42 @@ boolean spdm_generate_challenge_auth_signature(IN spdm_context_t *spdm_context,
 {
 	boolean result;
 	uintn signature_size;
-	uint8 m1m2_buffer[MAX_SPDM_MESSAGE_BUFFER_SIZE];
-	uintn m1m2_buffer_size;
-
-	m1m2_buffer_size = sizeof(m1m2_buffer);
-	result = spdm_calculate_m1m2(spdm_context, is_requester,
-				     &m1m2_buffer_size, &m1m2_buffer);
+	uint8 m1m2_hash[MAX_HASH_SIZE];
+	uintn m1m2_hash_size;
+#if OPENSPDM_RESPONDER_STATISTICS_SUPPORT == 1
+	uint64 sign_start_time;
+#endif
+
+	result = spdm_calculate_m1m2_hash(spdm_context, is_requester,
+					  m1m2_hash);
 	if (!result) {
 		return FALSE;
 	}
+	m1m2_hash_size = spdm_get_hash_size(
+		spdm_context->connection_info.algorithm.base_hash_algo);
 
 	if (is_requester) {
 		signature_size = spdm_get_req_asym_signature_size(
 			spdm_context->connection_info.algorithm
 				.req_base_asym_alg);
-		result = spdm_requester_data_sign(
+		result = spdm_requester_data_sign_hash(
 			spdm_context->connection_info.algorithm
 				.req_base_asym_alg,
 			spdm_context->connection_info.algorithm.base_hash_algo,
-			m1m2_buffer, m1m2_buffer_size, signature,
-			&signature_size);
+			m1m2_hash, m1m2_hash_size, signature, &signature_size);
 	} else {
 		signature_size = spdm_get_asym_signature_size(
 			spdm_context->connection_info.algorithm.base_asym_algo);
-		result = spdm_responder_data_sign(
+#if OPENSPDM_RESPONDER_STATISTICS_SUPPORT == 1
+		sign_start_time = spdm_statistics_get_timestamp(spdm_context);
+#endif
+		result = spdm_responder_data_sign_hash(
 			spdm_context->connection_info.algorithm.base_asym_algo,
 			spdm_context->connection_info.algorithm.base_hash_algo,
-			m1m2_buffer, m1m2_buffer_size, signature,
-			&signature_size);
+			m1m2_hash, m1m2_hash_size, signature, &signature_size);
+#if OPENSPDM_RESPONDER_STATISTICS_SUPPORT == 1
+		spdm_statistics_add_sign_time(spdm_context, sign_start_time);
+#endif
 	}
 
 	return result;
@@ -541,9 +957,9 @@ boolean spdm_verify_certificate_chain_hash(IN spdm_context_t *spdm_context,
 	hash_size = spdm_get_hash_size(
 		spdm_context->connection_info.algorithm.base_hash_algo);
 
-	spdm_hash_all(spdm_context->connection_info.algorithm.base_hash_algo,
-		      cert_chain_buffer, cert_chain_buffer_size,
-		      cert_chain_buffer_hash);
+	spdm_calculate_cert_chain_hash(spdm_context, cert_chain_buffer,
+				       cert_chain_buffer_size,
+				       cert_chain_buffer_hash);
 
 	if (hash_size != certificate_chain_hash_size) {
 		DEBUG((DEBUG_INFO,
@@ -577,71 +993,46 @@ boolean spdm_verify_challenge_auth_signature(IN spdm_context_t *spdm_context,
 					     IN uintn sign_data_size)
 {
 	boolean result;
-	uint8 *cert_buffer;
-	uintn cert_buffer_size;
 	void *context;
-	uint8 *cert_chain_data;
-	uintn cert_chain_data_size;
-	uint8 m1m2_buffer[MAX_SPDM_MESSAGE_BUFFER_SIZE];
-	uintn m1m2_buffer_size;
-
-	m1m2_buffer_size = sizeof(m1m2_buffer);
-	result = spdm_calculate_m1m2(spdm_context, !is_requester,
-				     &m1m2_buffer_size, &m1m2_buffer);
-	if (!result) {
-		return FALSE;
-	}
-
-	result = spdm_get_peer_cert_chain_data(
-		spdm_context, (void **)&cert_chain_data, &cert_chain_data_size);
+	uint8 m1m2_hash[MAX_HASH_SIZE];
+	uintn m1m2_hash_size;
+#if OPENSPDM_REQUESTER_STATISTICS_SUPPORT == 1
+	uint64 verify_start_time;
+#endif
+
+	result = spdm_calculate_m1m2_hash(spdm_context, !is_requester,
+					  m1m2_hash);
 	if (!result) {
 		return FALSE;
 	}
+	m1m2_hash_size = spdm_get_hash_size(
+		spdm_context->connection_info.algorithm.base_hash_algo);
 
-	//
-	// Get leaf cert from cert chain
-	//
-	result = x509_get_cert_from_cert_chain(cert_chain_data,
-					       cert_chain_data_size, -1,
-					       &cert_buffer, &cert_buffer_size);
+	result = spdm_get_peer_public_key(spdm_context, !is_requester,
+					  &context);
 	if (!result) {
 		return FALSE;
 	}
 
 	if (is_requester) {
-		result = spdm_asym_get_public_key_from_x509(
-			spdm_context->connection_info.algorithm.base_asym_algo,
-			cert_buffer, cert_buffer_size, &context);
-		if (!result) {
-			return FALSE;
-		}
-
-		result = spdm_asym_verify(
+#if OPENSPDM_REQUESTER_STATISTICS_SUPPORT == 1
+		verify_start_time = spdm_statistics_get_timestamp(spdm_context);
+#endif
+		result = spdm_asym_verify_hash(
 			spdm_context->connection_info.algorithm.base_asym_algo,
 			spdm_context->connection_info.algorithm.base_hash_algo,
-			context, m1m2_buffer, m1m2_buffer_size, sign_data,
+			context, m1m2_hash, m1m2_hash_size, sign_data,
 			sign_data_size);
-		spdm_asym_free(
-			spdm_context->connection_info.algorithm.base_asym_algo,
-			context);
+#if OPENSPDM_REQUESTER_STATISTICS_SUPPORT == 1
+		spdm_statistics_add_verify_time(spdm_context, verify_start_time);
+#endif
 	} else {
-		result = spdm_req_asym_get_public_key_from_x509(
-			spdm_context->connection_info.algorithm
-				.req_base_asym_alg,
-			cert_buffer, cert_buffer_size, &context);
-		if (!result) {
-			return FALSE;
-		}
-
-		result = spdm_req_asym_verify(
+		result = spdm_req_asym_verify_hash(
 			spdm_context->connection_info.algorithm
 				.req_base_asym_alg,
 			spdm_context->connection_info.algorithm.base_hash_algo,
-			context, m1m2_buffer, m1m2_buffer_size, sign_data,
+			context, m1m2_hash, m1m2_hash_size, sign_data,
 			sign_data_size);
-		spdm_req_asym_free(spdm_context->connection_info.algorithm
-					   .req_base_asym_alg,
-				   context);
 	}
 
 	if (!result) {
@@ -838,6 +1229,9 @@ boolean spdm_generate_measurement_signature(IN spdm_context_t *spdm_context,
 	boolean result;
 	uint8 l1l2_buffer[MAX_SPDM_MESSAGE_BUFFER_SIZE];
 	uintn l1l2_buffer_size;
+#if OPENSPDM_RESPONDER_STATISTICS_SUPPORT == 1
+	uint64 sign_start_time;
+#endif
 
 	l1l2_buffer_size = sizeof(l1l2_buffer);
 	result = spdm_calculate_l1l2(spdm_context, &l1l2_buffer_size,
@@ -848,10 +1242,16 @@ boolean spdm_generate_measurement_signature(IN spdm_context_t *spdm_context,
 
 	signature_size = spdm_get_asym_signature_size(
 		spdm_context->connection_info.algorithm.base_asym_algo);
+#if OPENSPDM_RESPONDER_STATISTICS_SUPPORT == 1
+	sign_start_time = spdm_statistics_get_timestamp(spdm_context);
+#endif
 	result = spdm_responder_data_sign(
 		spdm_context->connection_info.algorithm.base_asym_algo,
 		spdm_context->connection_info.algorithm.base_hash_algo,
 		l1l2_buffer, l1l2_buffer_size, signature, &signature_size);
+#if OPENSPDM_RESPONDER_STATISTICS_SUPPORT == 1
+	spdm_statistics_add_sign_time(spdm_context, sign_start_time);
+#endif
 	return result;
 }
 
@@ -870,13 +1270,12 @@ boolean spdm_verify_measurement_signature(IN spdm_context_t *spdm_context,
 					  IN uintn sign_data_size)
 {
 	boolean result;
-	uint8 *cert_buffer;
-	uintn cert_buffer_size;
 	void *context;
-	uint8 *cert_chain_data;
-	uintn cert_chain_data_size;
 	uint8 l1l2_buffer[MAX_SPDM_MESSAGE_BUFFER_SIZE];
 	uintn l1l2_buffer_size;
+#if OPENSPDM_REQUESTER_STATISTICS_SUPPORT == 1
+	uint64 verify_start_time;
+#endif
 
 	l1l2_buffer_size = sizeof(l1l2_buffer);
 	result = spdm_calculate_l1l2(spdm_context, &l1l2_buffer_size,
@@ -885,35 +1284,21 @@ boolean spdm_verify_measurement_signature(IN spdm_context_t *spdm_context,
 		return FALSE;
 	}
 
-	result = spdm_get_peer_cert_chain_data(
-		spdm_context, (void **)&cert_chain_data, &cert_chain_data_size);
-	if (!result) {
-		return FALSE;
-	}
-
-	//
-	// Get leaf cert from cert chain
-	//
-	result = x509_get_cert_from_cert_chain(cert_chain_data,
-					       cert_chain_data_size, -1,
-					       &cert_buffer, &cert_buffer_size);
-	if (!result) {
-		return FALSE;
-	}
-
-	result = spdm_asym_get_public_key_from_x509(
-		spdm_context->connection_info.algorithm.base_asym_algo,
-		cert_buffer, cert_buffer_size, &context);
+	result = spdm_get_peer_public_key(spdm_context, FALSE, &context);
 	if (!result) {
 		return FALSE;
 	}
 
+#if OPENSPDM_REQUESTER_STATISTICS_SUPPORT == 1
+	verify_start_time = spdm_statistics_get_timestamp(spdm_context);
+#endif
 	result = spdm_asym_verify(
 		spdm_context->connection_info.algorithm.base_asym_algo,
 		spdm_context->connection_info.algorithm.base_hash_algo, context,
 		l1l2_buffer, l1l2_buffer_size, sign_data, sign_data_size);
-	spdm_asym_free(spdm_context->connection_info.algorithm.base_asym_algo,
-		       context);
+#if OPENSPDM_REQUESTER_STATISTICS_SUPPORT == 1
+	spdm_statistics_add_verify_time(spdm_context, verify_start_time);
+#endif
 	if (!result) {
 		DEBUG((DEBUG_INFO,
 		       "!!! verify_measurement_signature - FAIL !!!\n"));
@@ -7,85 +7,156 @@
 #include "spdm_common_lib_internal.h"
 
 /*
-  This function calculates current TH data with message A and message K.
+  This function builds the scatter-gather list of current TH data without copying the transcript.
 
   @param  spdm_context                  A pointer to the SPDM context.
   @param  session_info                  The SPDM session ID.
   @param  cert_chain_data                Certitiface chain data without spdm_cert_chain_t header.
   @param  cert_chain_data_size            size in bytes of the certitiface chain data.
-  @param  th_data_buffer_size             size in bytes of the th_data_buffer
-  @param  th_data_buffer                 The buffer to store the th_data_buffer
-
-  @retval RETURN_SUCCESS  current TH data is calculated.
+  @param  mut_cert_chain_data             Certitiface chain data without spdm_cert_chain_t header in mutual authentication.
+  @param  mut_cert_chain_data_size         size in bytes of the certitiface chain data in mutual authentication.
+  @param  include_message_f              Indicate if message F is appended.
+  @param  th_iov                         The scatter-gather list of TH data.
 */
-boolean spdm_calculate_th_for_exchange(
-	IN void *context, IN void *spdm_session_info, IN uint8 *cert_chain_data,
-	OPTIONAL IN uintn cert_chain_data_size,
-	OPTIONAL IN OUT uintn *th_data_buffer_size, OUT void *th_data_buffer)
+void spdm_build_th_iov(IN spdm_context_t *spdm_context,
+		       IN spdm_session_info_t *session_info,
+		       OPTIONAL IN uint8 *cert_chain_data,
+		       OPTIONAL IN uintn cert_chain_data_size,
+		       OPTIONAL IN uint8 *mut_cert_chain_data,
+		       OPTIONAL IN uintn mut_cert_chain_data_size,
+		       IN boolean include_message_f, OUT spdm_th_iov_t *th_iov)
 {
-	spdm_context_t *spdm_context;
-	spdm_session_info_t *session_info;
-	uint8 cert_chain_data_hash[MAX_HASH_SIZE];
 	uint32 hash_size;
-	return_status status;
-	large_managed_buffer_t th_curr;
-
-	spdm_context = context;
-	session_info = spdm_session_info;
+	spdm_iovec_t *iov;
 
 	hash_size = spdm_get_hash_size(
 		spdm_context->connection_info.algorithm.base_hash_algo);
-
-	ASSERT(*th_data_buffer_size >= MAX_SPDM_MESSAGE_BUFFER_SIZE);
-	init_managed_buffer(&th_curr, MAX_SPDM_MESSAGE_BUFFER_SIZE);
+	iov = th_iov->iov;
 
 	DEBUG((DEBUG_INFO, "message_a data :\n"));
-	internal_dump_hex(
-		get_managed_buffer(&spdm_context->transcript.message_a),
-		get_managed_buffer_size(&spdm_context->transcript.message_a));
-	status = append_managed_buffer(
-		&th_curr,
+	internal_dump_transcript(
+		spdm_context,
 		get_managed_buffer(&spdm_context->transcript.message_a),
 		get_managed_buffer_size(&spdm_context->transcript.message_a));
-	if (RETURN_ERROR(status)) {
-		return FALSE;
-	}
+	iov->data = get_managed_buffer(&spdm_context->transcript.message_a);
+	iov->data_size =
+		get_managed_buffer_size(&spdm_context->transcript.message_a);
+	iov++;
 
 	if (cert_chain_data != NULL) {
 		DEBUG((DEBUG_INFO, "th_message_ct data :\n"));
-		internal_dump_hex(cert_chain_data, cert_chain_data_size);
-		spdm_hash_all(
-			spdm_context->connection_info.algorithm.base_hash_algo,
-			cert_chain_data, cert_chain_data_size,
-			cert_chain_data_hash);
-		status = append_managed_buffer(&th_curr, cert_chain_data_hash,
-					       hash_size);
-		if (RETURN_ERROR(status)) {
-			return FALSE;
-		}
+		internal_dump_transcript(spdm_context, cert_chain_data,
+					 cert_chain_data_size);
+		spdm_calculate_cert_chain_hash(spdm_context, cert_chain_data,
+					       cert_chain_data_size,
+					       th_iov->cert_chain_data_hash);
+		iov->data = th_iov->cert_chain_data_hash;
+		iov->data_size = hash_size;
+		iov++;
 	}
 
 	DEBUG((DEBUG_INFO, "message_k data :\n"));
-	internal_dump_hex(
+	internal_dump_transcript(
+		spdm_context,
 		get_managed_buffer(&session_info->session_transcript.message_k),
 		get_managed_buffer_size(
 			&session_info->session_transcript.message_k));
-	status = append_managed_buffer(
-		&th_curr,
-		get_managed_buffer(&session_info->session_transcript.message_k),
-		get_managed_buffer_size(
-			&session_info->session_transcript.message_k));
-	if (RETURN_ERROR(status)) {
-		return FALSE;
+	iov->data =
+		get_managed_buffer(&session_info->session_transcript.message_k);
+	iov->data_size = get_managed_buffer_size(
+		&session_info->session_transcript.message_k);
+	iov++;
+
+	if (mut_cert_chain_data != NULL) {
+		DEBUG((DEBUG_INFO, "th_message_cm data :\n"));
+		internal_dump_transcript(spdm_context, mut_cert_chain_data,
+					 mut_cert_chain_data_size);
+		spdm_calculate_cert_chain_hash(spdm_context,
+					       mut_cert_chain_data,
+					       mut_cert_chain_data_size,
+					       th_iov->mut_cert_chain_data_hash);
+		iov->data = th_iov->mut_cert_chain_data_hash;
+		iov->data_size = hash_size;
+		iov++;
 	}
 
-	*th_data_buffer_size = get_managed_buffer_size(&th_curr);
-	copy_mem(th_data_buffer, get_managed_buffer(&th_curr),
-		 *th_data_buffer_size);
+	if (include_message_f) {
+		DEBUG((DEBUG_INFO, "message_f data :\n"));
+		internal_dump_transcript(
+			spdm_context,
+			get_managed_buffer(
+				&session_info->session_transcript.message_f),
+			get_managed_buffer_size(
+				&session_info->session_transcript.message_f));
+		iov->data = get_managed_buffer(
+			&session_info->session_transcript.message_f);
+		iov->data_size = get_managed_buffer_size(
+			&session_info->session_transcript.message_f);
+		iov++;
+	}
+
+	th_iov->iov_count = iov - th_iov->iov;
+	ASSERT(th_iov->iov_count <= SPDM_TH_IOV_MAX_COUNT);
+}
+
+/*
+  This function copies the scatter-gather list of TH data into one buffer.
+
+  @param  th_iov                         The scatter-gather list of TH data.
+  @param  th_data_buffer_size             size in bytes of the th_data_buffer
+  @param  th_data_buffer                 The buffer to store the th_data_buffer
+
+  @retval TRUE  TH data is copied.
+  @retval FALSE th_data_buffer is too small.
+*/
+boolean spdm_gather_th_iov(IN spdm_th_iov_t *th_iov,
+			   IN OUT uintn *th_data_buffer_size,
+			   OUT void *th_data_buffer)
+{
+	uintn index;
+	uintn offset;
+
+	offset = 0;
+	for (index = 0; index < th_iov->iov_count; index++) {
+		if (th_iov->iov[index].data_size >
+		    *th_data_buffer_size - offset) {
+			return FALSE;
+		}
+		copy_mem((uint8 *)th_data_buffer + offset,
+			 th_iov->iov[index].data,
+			 th_iov->iov[index].data_size);
+		offset += th_iov->iov[index].data_size;
+	}
+	*th_data_buffer_size = offset;
 
 	return TRUE;
 }
 
+/*
+  This function calculates current TH data with message A and message K.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  session_info                  The SPDM session ID.
+  @param  cert_chain_data                Certitiface chain data without spdm_cert_chain_t header.
+  @param  cert_chain_data_size            size in bytes of the certitiface chain data.
+  @param  th_data_buffer_size             size in bytes of the th_data_buffer
+  @param  th_data_buffer                 The buffer to store the th_data_buffer
+
+  @retval RETURN_SUCCESS  current TH data is calculated.
+*/
+boolean spdm_calculate_th_for_exchange(
+	IN void *context, IN void *spdm_session_info, IN uint8 *cert_chain_data,
+	OPTIONAL IN uintn cert_chain_data_size,
+	OPTIONAL IN OUT uintn *th_data_buffer_size, OUT void *th_data_buffer)
+{
+	spdm_th_iov_t th_iov;
+
+	spdm_build_th_iov(context, spdm_session_info, cert_chain_data,
+			  cert_chain_data_size, NULL, 0, FALSE, &th_iov);
+	return spdm_gather_th_iov(&th_iov, th_data_buffer_size,
+				  th_data_buffer);
+}
+
 /*
   This function calculates current TH data with message A, message K and message F.
 
@@ -109,95 +180,209 @@ boolean spdm_calculate_th_for_finish(IN void *context,
 				     OPTIONAL IN OUT uintn *th_data_buffer_size,
 				     OUT void *th_data_buffer)
 {
-	spdm_context_t *spdm_context;
-	spdm_session_info_t *session_info;
-	uint8 cert_chain_data_hash[MAX_HASH_SIZE];
-	uint8 MutCertChainDataHash[MAX_HASH_SIZE];
-	uint32 hash_size;
-	return_status status;
-	large_managed_buffer_t th_curr;
+	spdm_th_iov_t th_iov;
 
-	spdm_context = context;
-	session_info = spdm_session_info;
+	spdm_build_th_iov(context, spdm_session_info, cert_chain_data,
+			  cert_chain_data_size, mut_cert_chain_data,
+			  mut_cert_chain_data_size, TRUE, &th_iov);
+	return spdm_gather_th_iov(&th_iov, th_data_buffer_size,
+				  th_data_buffer);
+}
 
-	hash_size = spdm_get_hash_size(
-		spdm_context->connection_info.algorithm.base_hash_algo);
+/*
+  This function finalizes TH hash from a copy of the TH hash context of the session.
 
-	ASSERT(*th_data_buffer_size >= MAX_SPDM_MESSAGE_BUFFER_SIZE);
-	init_managed_buffer(&th_curr, MAX_SPDM_MESSAGE_BUFFER_SIZE);
+  The TH hash context of the session covers Concatenate (A, Ct, K).
 
-	DEBUG((DEBUG_INFO, "message_a data :\n"));
-	internal_dump_hex(
-		get_managed_buffer(&spdm_context->transcript.message_a),
-		get_managed_buffer_size(&spdm_context->transcript.message_a));
-	status = append_managed_buffer(
-		&th_curr,
-		get_managed_buffer(&spdm_context->transcript.message_a),
-		get_managed_buffer_size(&spdm_context->transcript.message_a));
-	if (RETURN_ERROR(status)) {
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  session_info                  The SPDM session ID.
+  @param  mut_cert_chain_data             Certitiface chain data without spdm_cert_chain_t header in mutual authentication.
+  @param  mut_cert_chain_data_size         size in bytes of the certitiface chain data in mutual authentication.
+  @param  include_message_f              Indicate if message F is appended.
+  @param  th_hash                        The buffer to store the TH hash.
+
+  @retval TRUE  TH hash is calculated.
+  @retval FALSE TH hash is not calculated.
+*/
+boolean spdm_finalize_th_hash_from_digest_context(
+	IN spdm_context_t *spdm_context, IN spdm_session_info_t *session_info,
+	OPTIONAL IN uint8 *mut_cert_chain_data,
+	OPTIONAL IN uintn mut_cert_chain_data_size,
+	IN boolean include_message_f, OUT uint8 *th_hash)
+{
+	uint32 base_hash_algo;
+	void *digest_context_th;
+	uint8 mut_cert_chain_data_hash[MAX_HASH_SIZE];
+	boolean result;
+
+	base_hash_algo = spdm_context->connection_info.algorithm.base_hash_algo;
+
+	ASSERT(session_info->session_transcript.digest_context_th != NULL);
+	digest_context_th = spdm_hash_new(base_hash_algo);
+	if (digest_context_th == NULL) {
 		return FALSE;
 	}
+	result = spdm_hash_duplicate(
+		base_hash_algo,
+		session_info->session_transcript.digest_context_th,
+		digest_context_th);
+	if (result && (mut_cert_chain_data != NULL)) {
+		DEBUG((DEBUG_INFO, "th_message_cm data :\n"));
+		internal_dump_transcript(spdm_context, mut_cert_chain_data,
+					 mut_cert_chain_data_size);
+		spdm_calculate_cert_chain_hash(spdm_context,
+					       mut_cert_chain_data,
+					       mut_cert_chain_data_size,
+					       mut_cert_chain_data_hash);
+		result = spdm_hash_update(base_hash_algo, digest_context_th,
+					  mut_cert_chain_data_hash,
+					  spdm_get_hash_size(base_hash_algo));
+	}
+	if (result && include_message_f) {
+		DEBUG((DEBUG_INFO, "message_f data :\n"));
+		internal_dump_transcript(
+			spdm_context,
+			get_managed_buffer(
+				&session_info->session_transcript.message_f),
+			get_managed_buffer_size(
+				&session_info->session_transcript.message_f));
+		result = spdm_hash_update(
+			base_hash_algo, digest_context_th,
+			get_managed_buffer(
+				&session_info->session_transcript.message_f),
+			get_managed_buffer_size(
+				&session_info->session_transcript.message_f));
+	}
+	if (result) {
+		result = spdm_hash_final(base_hash_algo, digest_context_th,
+					 th_hash);
+	}
+	spdm_hash_free(base_hash_algo, digest_context_th);
 
-	if (cert_chain_data != NULL) {
-		DEBUG((DEBUG_INFO, "th_message_ct data :\n"));
-		internal_dump_hex(cert_chain_data, cert_chain_data_size);
-		spdm_hash_all(
-			spdm_context->connection_info.algorithm.base_hash_algo,
-			cert_chain_data, cert_chain_data_size,
-			cert_chain_data_hash);
-		status = append_managed_buffer(&th_curr, cert_chain_data_hash,
-					       hash_size);
-		if (RETURN_ERROR(status)) {
+	return result;
+}
+
+/*
+  This function calculates current TH hash with message A and message K.
+
+  If the TH hash context of the session is available, the hash is finalized from a copy of it,
+  which has already covered the certificate chain.
+  Otherwise, the TH data is built from the transcript buffers and hashed.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  session_info                  The SPDM session ID.
+  @param  cert_chain_data                Certitiface chain data without spdm_cert_chain_t header.
+  @param  cert_chain_data_size            size in bytes of the certitiface chain data.
+  @param  th_hash                        The buffer to store the TH hash.
+
+  @retval TRUE  current TH hash is calculated.
+  @retval FALSE current TH hash is not calculated.
+*/
+boolean spdm_calculate_th_hash_for_exchange(
+	IN void *context, IN void *spdm_session_info, IN uint8 *cert_chain_data,
+	OPTIONAL IN uintn cert_chain_data_size, OUT uint8 *th_hash)
+{
+	spdm_context_t *spdm_context;
+	spdm_session_info_t *session_info;
+	uint32 base_hash_algo;
+	boolean result;
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
+	spdm_th_iov_t th_iov;
+#endif
+
+	spdm_context = context;
+	session_info = spdm_session_info;
+	base_hash_algo = spdm_context->connection_info.algorithm.base_hash_algo;
+
+	if (session_info->session_transcript.digest_context_th != NULL) {
+		result = spdm_finalize_th_hash_from_digest_context(
+			spdm_context, session_info, NULL, 0, FALSE, th_hash);
+		if (!result) {
 			return FALSE;
 		}
-	}
-
-	DEBUG((DEBUG_INFO, "message_k data :\n"));
-	internal_dump_hex(
-		get_managed_buffer(&session_info->session_transcript.message_k),
-		get_managed_buffer_size(
-			&session_info->session_transcript.message_k));
-	status = append_managed_buffer(
-		&th_curr,
-		get_managed_buffer(&session_info->session_transcript.message_k),
-		get_managed_buffer_size(
-			&session_info->session_transcript.message_k));
-	if (RETURN_ERROR(status)) {
+	} else {
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
+		spdm_build_th_iov(spdm_context, session_info, cert_chain_data,
+				  cert_chain_data_size, NULL, 0, FALSE,
+				  &th_iov);
+		result = spdm_hash_multi(base_hash_algo, th_iov.iov,
+					 th_iov.iov_count, th_hash);
+		if (!result) {
+			return FALSE;
+		}
+#else
 		return FALSE;
+#endif
 	}
 
-	if (mut_cert_chain_data != NULL) {
-		DEBUG((DEBUG_INFO, "th_message_cm data :\n"));
-		internal_dump_hex(mut_cert_chain_data,
-				  mut_cert_chain_data_size);
-		spdm_hash_all(
-			spdm_context->connection_info.algorithm.base_hash_algo,
-			mut_cert_chain_data, mut_cert_chain_data_size,
-			MutCertChainDataHash);
-		status = append_managed_buffer(&th_curr, MutCertChainDataHash,
-					       hash_size);
-		if (RETURN_ERROR(status)) {
+	DEBUG((DEBUG_INFO, "th_curr hash - "));
+	internal_dump_data(th_hash, spdm_get_hash_size(base_hash_algo));
+	DEBUG((DEBUG_INFO, "\n"));
+
+	return TRUE;
+}
+
+/*
+  This function calculates current TH hash with message A, message K and message F.
+
+  If the TH hash context of the session is available, the mutual certificate chain hash and
+  message F are fed into a copy of it, which has already covered the certificate chain and message K.
+  Otherwise, the TH data is built from the transcript buffers and hashed.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  session_info                  The SPDM session ID.
+  @param  cert_chain_data                Certitiface chain data without spdm_cert_chain_t header.
+  @param  cert_chain_data_size            size in bytes of the certitiface chain data.
+  @param  mut_cert_chain_data             Certitiface chain data without spdm_cert_chain_t header in mutual authentication.
+  @param  mut_cert_chain_data_size         size in bytes of the certitiface chain data in mutual authentication.
+  @param  th_hash                        The buffer to store the TH hash.
+
+  @retval TRUE  current TH hash is calculated.
+  @retval FALSE current TH hash is not calculated.
+*/
+boolean spdm_calculate_th_hash_for_finish(
+	IN void *context, IN void *spdm_session_info, IN uint8 *cert_chain_data,
+	OPTIONAL IN uintn cert_chain_data_size,
+	OPTIONAL IN uint8 *mut_cert_chain_data,
+	OPTIONAL IN uintn mut_cert_chain_data_size, OUT uint8 *th_hash)
+{
+	spdm_context_t *spdm_context;
+	spdm_session_info_t *session_info;
+	uint32 base_hash_algo;
+	boolean result;
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
+	spdm_th_iov_t th_iov;
+#endif
+
+	spdm_context = context;
+	session_info = spdm_session_info;
+	base_hash_algo = spdm_context->connection_info.algorithm.base_hash_algo;
+
+	if (session_info->session_transcript.digest_context_th != NULL) {
+		result = spdm_finalize_th_hash_from_digest_context(
+			spdm_context, session_info, mut_cert_chain_data,
+			mut_cert_chain_data_size, TRUE, th_hash);
+		if (!result) {
 			return FALSE;
 		}
-	}
-
-	DEBUG((DEBUG_INFO, "message_f data :\n"));
-	internal_dump_hex(
-		get_managed_buffer(&session_info->session_transcript.message_f),
-		get_managed_buffer_size(
-			&session_info->session_transcript.message_f));
-	status = append_managed_buffer(
-		&th_curr,
-		get_managed_buffer(&session_info->session_transcript.message_f),
-		get_managed_buffer_size(
-			&session_info->session_transcript.message_f));
-	if (RETURN_ERROR(status)) {
+	} else {
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
+		spdm_build_th_iov(spdm_context, session_info, cert_chain_data,
+				  cert_chain_data_size, mut_cert_chain_data,
+				  mut_cert_chain_data_size, TRUE, &th_iov);
+		result = spdm_hash_multi(base_hash_algo, th_iov.iov,
+					 th_iov.iov_count, th_hash);
+		if (!result) {
+			return FALSE;
+		}
+#else
 		return FALSE;
+#endif
 	}
 
-	*th_data_buffer_size = get_managed_buffer_size(&th_curr);
-	copy_mem(th_data_buffer, get_managed_buffer(&th_curr),
-		 *th_data_buffer_size);
+	DEBUG((DEBUG_INFO, "th_curr hash - "));
+	internal_dump_data(th_hash, spdm_get_hash_size(base_hash_algo));
+	DEBUG((DEBUG_INFO, "\n"));
 
 	return TRUE;
 }
@@ -223,8 +408,9 @@ spdm_generate_key_exchange_rsp_signature(IN spdm_context_t *spdm_context,
 	boolean result;
 	uintn signature_size;
 	uint32 hash_size;
-	uint8 th_curr_data[MAX_SPDM_MESSAGE_BUFFER_SIZE];
-	uintn th_curr_data_size;
+#if OPENSPDM_RESPONDER_STATISTICS_SUPPORT == 1
+	uint64 sign_start_time;
+#endif
 
 	signature_size = spdm_get_asym_signature_size(
 		spdm_context->connection_info.algorithm.base_asym_algo);
@@ -237,25 +423,23 @@ spdm_generate_key_exchange_rsp_signature(IN spdm_context_t *spdm_context,
 		return FALSE;
 	}
 
-	th_curr_data_size = sizeof(th_curr_data);
-	result = spdm_calculate_th_for_exchange(
+	result = spdm_calculate_th_hash_for_exchange(
 		spdm_context, session_info, cert_chain_data,
-		cert_chain_data_size, &th_curr_data_size, th_curr_data);
+		cert_chain_data_size, hash_data);
 	if (!result) {
 		return FALSE;
 	}
 
-	// debug only
-	spdm_hash_all(spdm_context->connection_info.algorithm.base_hash_algo,
-		      th_curr_data, th_curr_data_size, hash_data);
-	DEBUG((DEBUG_INFO, "th_curr hash - "));
-	internal_dump_data(hash_data, hash_size);
-	DEBUG((DEBUG_INFO, "\n"));
-
-	result = spdm_responder_data_sign(
+#if OPENSPDM_RESPONDER_STATISTICS_SUPPORT == 1
+	sign_start_time = spdm_statistics_get_timestamp(spdm_context);
+#endif
+	result = spdm_responder_data_sign_hash(
 		spdm_context->connection_info.algorithm.base_asym_algo,
 		spdm_context->connection_info.algorithm.base_hash_algo,
-		th_curr_data, th_curr_data_size, signature, &signature_size);
+		hash_data, hash_size, signature, &signature_size);
+#if OPENSPDM_RESPONDER_STATISTICS_SUPPORT == 1
+	spdm_statistics_add_sign_time(spdm_context, sign_start_time);
+#endif
 	if (result) {
 		DEBUG((DEBUG_INFO, "signature - "));
 		internal_dump_data(signature, signature_size);
@@ -283,8 +467,7 @@ spdm_generate_key_exchange_rsp_hmac(IN spdm_context_t *spdm_context,
 	uint8 *cert_chain_data;
 	uintn cert_chain_data_size;
 	uint32 hash_size;
-	uint8 th_curr_data[MAX_SPDM_MESSAGE_BUFFER_SIZE];
-	uintn th_curr_data_size;
+	spdm_th_iov_t th_iov;
 	boolean result;
 
 	hash_size = spdm_get_hash_size(
@@ -296,17 +479,15 @@ spdm_generate_key_exchange_rsp_hmac(IN spdm_context_t *spdm_context,
 		return FALSE;
 	}
 
-	th_curr_data_size = sizeof(th_curr_data);
-	result = spdm_calculate_th_for_exchange(
-		spdm_context, session_info, cert_chain_data,
-		cert_chain_data_size, &th_curr_data_size, th_curr_data);
+	spdm_build_th_iov(spdm_context, session_info, cert_chain_data,
+			  cert_chain_data_size, NULL, 0, FALSE, &th_iov);
+
+	result = spdm_hmac_multi_with_response_finished_key(
+		session_info->secured_message_context, th_iov.iov,
+		th_iov.iov_count, hmac_data);
 	if (!result) {
 		return FALSE;
 	}
-
-	spdm_hmac_all_with_response_finished_key(
-		session_info->secured_message_context, th_curr_data,
-		th_curr_data_size, hmac_data);
 	DEBUG((DEBUG_INFO, "th_curr hmac - "));
 	internal_dump_data(hmac_data, hash_size);
 	DEBUG((DEBUG_INFO, "\n"));
@@ -336,11 +517,10 @@ boolean spdm_verify_key_exchange_rsp_signature(
 	boolean result;
 	uint8 *cert_chain_data;
 	uintn cert_chain_data_size;
-	uint8 *cert_buffer;
-	uintn cert_buffer_size;
 	void *context;
-	uint8 th_curr_data[MAX_SPDM_MESSAGE_BUFFER_SIZE];
-	uintn th_curr_data_size;
+#if OPENSPDM_REQUESTER_STATISTICS_SUPPORT == 1
+	uint64 verify_start_time;
+#endif
 
 	hash_size = spdm_get_hash_size(
 		spdm_context->connection_info.algorithm.base_hash_algo);
@@ -351,48 +531,32 @@ boolean spdm_verify_key_exchange_rsp_signature(
 		return FALSE;
 	}
 
-	th_curr_data_size = sizeof(th_curr_data);
-	result = spdm_calculate_th_for_exchange(
+	result = spdm_calculate_th_hash_for_exchange(
 		spdm_context, session_info, cert_chain_data,
-		cert_chain_data_size, &th_curr_data_size, th_curr_data);
+		cert_chain_data_size, hash_data);
 	if (!result) {
 		return FALSE;
 	}
 
-	// debug only
-	spdm_hash_all(spdm_context->connection_info.algorithm.base_hash_algo,
-		      th_curr_data, th_curr_data_size, hash_data);
-	DEBUG((DEBUG_INFO, "th_curr hash - "));
-	internal_dump_data(hash_data, hash_size);
-	DEBUG((DEBUG_INFO, "\n"));
-
 	DEBUG((DEBUG_INFO, "signature - "));
 	internal_dump_data(sign_data, sign_data_size);
 	DEBUG((DEBUG_INFO, "\n"));
 
-	//
-	// Get leaf cert from cert chain
-	//
-	result = x509_get_cert_from_cert_chain(cert_chain_data,
-					       cert_chain_data_size, -1,
-					       &cert_buffer, &cert_buffer_size);
+	result = spdm_get_peer_public_key(spdm_context, FALSE, &context);
 	if (!result) {
 		return FALSE;
 	}
 
-	result = spdm_asym_get_public_key_from_x509(
-		spdm_context->connection_info.algorithm.base_asym_algo,
-		cert_buffer, cert_buffer_size, &context);
-	if (!result) {
-		return FALSE;
-	}
-
-	result = spdm_asym_verify(
+#if OPENSPDM_REQUESTER_STATISTICS_SUPPORT == 1
+	verify_start_time = spdm_statistics_get_timestamp(spdm_context);
+#endif
+	result = spdm_asym_verify_hash(
 		spdm_context->connection_info.algorithm.base_asym_algo,
 		spdm_context->connection_info.algorithm.base_hash_algo, context,
-		th_curr_data, th_curr_data_size, sign_data, sign_data_size);
-	spdm_asym_free(spdm_context->connection_info.algorithm.base_asym_algo,
-		       context);
+		hash_data, hash_size, sign_data, sign_data_size);
+#if OPENSPDM_REQUESTER_STATISTICS_SUPPORT == 1
+	spdm_statistics_add_verify_time(spdm_context, verify_start_time);
+#endif
 	if (!result) {
 		DEBUG((DEBUG_INFO,
 		       "!!! verify_key_exchange_signature - FAIL !!!\n"));
@@ -424,8 +588,7 @@ boolean spdm_verify_key_exchange_rsp_hmac(IN spdm_context_t *spdm_context,
 	uint8 *cert_chain_data;
 	uintn cert_chain_data_size;
 	boolean result;
-	uint8 th_curr_data[MAX_SPDM_MESSAGE_BUFFER_SIZE];
-	uintn th_curr_data_size;
+	spdm_th_iov_t th_iov;
 
 	hash_size = spdm_get_hash_size(
 		spdm_context->connection_info.algorithm.base_hash_algo);
@@ -437,17 +600,15 @@ boolean spdm_verify_key_exchange_rsp_hmac(IN spdm_context_t *spdm_context,
 		return FALSE;
 	}
 
-	th_curr_data_size = sizeof(th_curr_data);
-	result = spdm_calculate_th_for_exchange(
-		spdm_context, session_info, cert_chain_data,
-		cert_chain_data_size, &th_curr_data_size, th_curr_data);
+	spdm_build_th_iov(spdm_context, session_info, cert_chain_data,
+			  cert_chain_data_size, NULL, 0, FALSE, &th_iov);
+
+	result = spdm_hmac_multi_with_response_finished_key(
+		session_info->secured_message_context, th_iov.iov,
+		th_iov.iov_count, calc_hmac_data);
 	if (!result) {
 		return FALSE;
 	}
-
-	spdm_hmac_all_with_response_finished_key(
-		session_info->secured_message_context, th_curr_data,
-		th_curr_data_size, calc_hmac_data);
 	DEBUG((DEBUG_INFO, "th_curr hmac - "));
 	internal_dump_data(calc_hmac_data, hash_size);
 	DEBUG((DEBUG_INFO, "\n"));
@@ -484,8 +645,6 @@ boolean spdm_generate_finish_req_signature(IN spdm_context_t *spdm_context,
 	boolean result;
 	uintn signature_size;
 	uint32 hash_size;
-	uint8 th_curr_data[MAX_SPDM_MESSAGE_BUFFER_SIZE];
-	uintn th_curr_data_size;
 
 	signature_size = spdm_get_req_asym_signature_size(
 		spdm_context->connection_info.algorithm.req_base_asym_alg);
@@ -505,26 +664,18 @@ boolean spdm_generate_finish_req_signature(IN spdm_context_t *spdm_context,
 		return FALSE;
 	}
 
-	th_curr_data_size = sizeof(th_curr_data);
-	result = spdm_calculate_th_for_finish(
+	result = spdm_calculate_th_hash_for_finish(
 		spdm_context, session_info, cert_chain_data,
 		cert_chain_data_size, mut_cert_chain_data,
-		mut_cert_chain_data_size, &th_curr_data_size, th_curr_data);
+		mut_cert_chain_data_size, hash_data);
 	if (!result) {
 		return FALSE;
 	}
 
-	// debug only
-	spdm_hash_all(spdm_context->connection_info.algorithm.base_hash_algo,
-		      th_curr_data, th_curr_data_size, hash_data);
-	DEBUG((DEBUG_INFO, "th_curr hash - "));
-	internal_dump_data(hash_data, hash_size);
-	DEBUG((DEBUG_INFO, "\n"));
-
-	result = spdm_requester_data_sign(
+	result = spdm_requester_data_sign_hash(
 		spdm_context->connection_info.algorithm.req_base_asym_alg,
 		spdm_context->connection_info.algorithm.base_hash_algo,
-		th_curr_data, th_curr_data_size, signature, &signature_size);
+		hash_data, hash_size, signature, &signature_size);
 	if (result) {
 		DEBUG((DEBUG_INFO, "signature - "));
 		internal_dump_data(signature, signature_size);
@@ -555,8 +706,7 @@ boolean spdm_generate_finish_req_hmac(IN spdm_context_t *spdm_context,
 	uint8 *mut_cert_chain_data;
 	uintn mut_cert_chain_data_size;
 	boolean result;
-	uint8 th_curr_data[MAX_SPDM_MESSAGE_BUFFER_SIZE];
-	uintn th_curr_data_size;
+	spdm_th_iov_t th_iov;
 
 	hash_size = spdm_get_hash_size(
 		spdm_context->connection_info.algorithm.base_hash_algo);
@@ -579,18 +729,16 @@ boolean spdm_generate_finish_req_hmac(IN spdm_context_t *spdm_context,
 		mut_cert_chain_data_size = 0;
 	}
 
-	th_curr_data_size = sizeof(th_curr_data);
-	result = spdm_calculate_th_for_finish(
-		spdm_context, session_info, cert_chain_data,
-		cert_chain_data_size, mut_cert_chain_data,
-		mut_cert_chain_data_size, &th_curr_data_size, th_curr_data);
+	spdm_build_th_iov(spdm_context, session_info, cert_chain_data,
+			  cert_chain_data_size, mut_cert_chain_data,
+			  mut_cert_chain_data_size, TRUE, &th_iov);
+
+	result = spdm_hmac_multi_with_request_finished_key(
+		session_info->secured_message_context, th_iov.iov,
+		th_iov.iov_count, calc_hmac_data);
 	if (!result) {
 		return FALSE;
 	}
-
-	spdm_hmac_all_with_request_finished_key(
-		session_info->secured_message_context, th_curr_data,
-		th_curr_data_size, calc_hmac_data);
 	DEBUG((DEBUG_INFO, "th_curr hmac - "));
 	internal_dump_data(calc_hmac_data, hash_size);
 	DEBUG((DEBUG_INFO, "\n"));
@@ -623,11 +771,7 @@ boolean spdm_verify_finish_req_signature(IN spdm_context_t *spdm_context,
 	uintn cert_chain_data_size;
 	uint8 *mut_cert_chain_data;
 	uintn mut_cert_chain_data_size;
-	uint8 *mut_cert_buffer;
-	uintn mut_cert_buffer_size;
 	void *context;
-	uint8 th_curr_data[MAX_SPDM_MESSAGE_BUFFER_SIZE];
-	uintn th_curr_data_size;
 
 	hash_size = spdm_get_hash_size(
 		spdm_context->connection_info.algorithm.base_hash_algo);
@@ -645,51 +789,27 @@ boolean spdm_verify_finish_req_signature(IN spdm_context_t *spdm_context,
 		return FALSE;
 	}
 
-	th_curr_data_size = sizeof(th_curr_data);
-	result = spdm_calculate_th_for_finish(
+	result = spdm_calculate_th_hash_for_finish(
 		spdm_context, session_info, cert_chain_data,
 		cert_chain_data_size, mut_cert_chain_data,
-		mut_cert_chain_data_size, &th_curr_data_size, th_curr_data);
+		mut_cert_chain_data_size, hash_data);
 	if (!result) {
 		return FALSE;
 	}
 
-	// debug only
-	spdm_hash_all(spdm_context->connection_info.algorithm.base_hash_algo,
-		      th_curr_data, th_curr_data_size, hash_data);
-	DEBUG((DEBUG_INFO, "th_curr hash - "));
-	internal_dump_data(hash_data, hash_size);
-	DEBUG((DEBUG_INFO, "\n"));
-
 	DEBUG((DEBUG_INFO, "signature - "));
 	internal_dump_data(sign_data, sign_data_size);
 	DEBUG((DEBUG_INFO, "\n"));
 
-	//
-	// Get leaf cert from cert chain
-	//
-	result = x509_get_cert_from_cert_chain(mut_cert_chain_data,
-					       mut_cert_chain_data_size, -1,
-					       &mut_cert_buffer,
-					       &mut_cert_buffer_size);
+	result = spdm_get_peer_public_key(spdm_context, TRUE, &context);
 	if (!result) {
 		return FALSE;
 	}
 
-	result = spdm_req_asym_get_public_key_from_x509(
-		spdm_context->connection_info.algorithm.req_base_asym_alg,
-		mut_cert_buffer, mut_cert_buffer_size, &context);
-	if (!result) {
-		return FALSE;
-	}
-
-	result = spdm_req_asym_verify(
+	result = spdm_req_asym_verify_hash(
 		spdm_context->connection_info.algorithm.req_base_asym_alg,
 		spdm_context->connection_info.algorithm.base_hash_algo, context,
-		th_curr_data, th_curr_data_size, sign_data, sign_data_size);
-	spdm_req_asym_free(
-		spdm_context->connection_info.algorithm.req_base_asym_alg,
-		context);
+		hash_data, hash_size, sign_data, sign_data_size);
 	if (!result) {
 		DEBUG((DEBUG_INFO, "!!! VerifyFinishSignature - FAIL !!!\n"));
 		return FALSE;
@@ -721,8 +841,7 @@ boolean spdm_verify_finish_req_hmac(IN spdm_context_t *spdm_context,
 	uintn mut_cert_chain_data_size;
 	uintn hash_size;
 	boolean result;
-	uint8 th_curr_data[MAX_SPDM_MESSAGE_BUFFER_SIZE];
-	uintn th_curr_data_size;
+	spdm_th_iov_t th_iov;
 
 	hash_size = spdm_get_hash_size(
 		spdm_context->connection_info.algorithm.base_hash_algo);
@@ -746,18 +865,16 @@ boolean spdm_verify_finish_req_hmac(IN spdm_context_t *spdm_context,
 		mut_cert_chain_data_size = 0;
 	}
 
-	th_curr_data_size = sizeof(th_curr_data);
-	result = spdm_calculate_th_for_finish(
-		spdm_context, session_info, cert_chain_data,
-		cert_chain_data_size, mut_cert_chain_data,
-		mut_cert_chain_data_size, &th_curr_data_size, th_curr_data);
+	spdm_build_th_iov(spdm_context, session_info, cert_chain_data,
+			  cert_chain_data_size, mut_cert_chain_data,
+			  mut_cert_chain_data_size, TRUE, &th_iov);
+
+	result = spdm_hmac_multi_with_request_finished_key(
+		session_info->secured_message_context, th_iov.iov,
+		th_iov.iov_count, hmac_data);
 	if (!result) {
 		return FALSE;
 	}
-
-	spdm_hmac_all_with_request_finished_key(
-		session_info->secured_message_context, th_curr_data,
-		th_curr_data_size, hmac_data);
 	DEBUG((DEBUG_INFO, "th_curr hmac - "));
 	internal_dump_data(hmac_data, hash_size);
 	DEBUG((DEBUG_INFO, "\n"));
@@ -791,8 +908,7 @@ boolean spdm_generate_finish_rsp_hmac(IN spdm_context_t *spdm_context,
 	uintn mut_cert_chain_data_size;
 	uint32 hash_size;
 	boolean result;
-	uint8 th_curr_data[MAX_SPDM_MESSAGE_BUFFER_SIZE];
-	uintn th_curr_data_size;
+	spdm_th_iov_t th_iov;
 
 	hash_size = spdm_get_hash_size(
 		spdm_context->connection_info.algorithm.base_hash_algo);
@@ -815,18 +931,16 @@ boolean spdm_generate_finish_rsp_hmac(IN spdm_context_t *spdm_context,
 		mut_cert_chain_data_size = 0;
 	}
 
-	th_curr_data_size = sizeof(th_curr_data);
-	result = spdm_calculate_th_for_finish(
-		spdm_context, session_info, cert_chain_data,
-		cert_chain_data_size, mut_cert_chain_data,
-		mut_cert_chain_data_size, &th_curr_data_size, th_curr_data);
+	spdm_build_th_iov(spdm_context, session_info, cert_chain_data,
+			  cert_chain_data_size, mut_cert_chain_data,
+			  mut_cert_chain_data_size, TRUE, &th_iov);
+
+	result = spdm_hmac_multi_with_response_finished_key(
+		session_info->secured_message_context, th_iov.iov,
+		th_iov.iov_count, hmac_data);
 	if (!result) {
 		return FALSE;
 	}
-
-	spdm_hmac_all_with_response_finished_key(
-		session_info->secured_message_context, th_curr_data,
-		th_curr_data_size, hmac_data);
 	DEBUG((DEBUG_INFO, "th_curr hmac - "));
 	internal_dump_data(hmac_data, hash_size);
 	DEBUG((DEBUG_INFO, "\n"));
@@ -858,8 +972,7 @@ boolean spdm_verify_finish_rsp_hmac(IN spdm_context_t *spdm_context,
 	uint8 *mut_cert_chain_data;
 	uintn mut_cert_chain_data_size;
 	boolean result;
-	uint8 th_curr_data[MAX_SPDM_MESSAGE_BUFFER_SIZE];
-	uintn th_curr_data_size;
+	spdm_th_iov_t th_iov;
 
 	hash_size = spdm_get_hash_size(
 		spdm_context->connection_info.algorithm.base_hash_algo);
@@ -883,18 +996,16 @@ boolean spdm_verify_finish_rsp_hmac(IN spdm_context_t *spdm_context,
 		mut_cert_chain_data_size = 0;
 	}
 
-	th_curr_data_size = sizeof(th_curr_data);
-	result = spdm_calculate_th_for_finish(
-		spdm_context, session_info, cert_chain_data,
-		cert_chain_data_size, mut_cert_chain_data,
-		mut_cert_chain_data_size, &th_curr_data_size, th_curr_data);
+	spdm_build_th_iov(spdm_context, session_info, cert_chain_data,
+			  cert_chain_data_size, mut_cert_chain_data,
+			  mut_cert_chain_data_size, TRUE, &th_iov);
+
+	result = spdm_hmac_multi_with_response_finished_key(
+		session_info->secured_message_context, th_iov.iov,
+		th_iov.iov_count, calc_hmac_data);
 	if (!result) {
 		return FALSE;
 	}
-
-	spdm_hmac_all_with_response_finished_key(
-		session_info->secured_message_context, th_curr_data,
-		th_curr_data_size, calc_hmac_data);
 	DEBUG((DEBUG_INFO, "th_curr hmac - "));
 	internal_dump_data(calc_hmac_data, hash_size);
 	DEBUG((DEBUG_INFO, "\n"));
@@ -926,23 +1037,20 @@ spdm_generate_psk_exchange_rsp_hmac(IN spdm_context_t *spdm_context,
 	uint8 hmac_data[MAX_HASH_SIZE];
 	uint32 hash_size;
 	boolean result;
-	uint8 th_curr_data[MAX_SPDM_MESSAGE_BUFFER_SIZE];
-	uintn th_curr_data_size;
+	spdm_th_iov_t th_iov;
 
 	hash_size = spdm_get_hash_size(
 		spdm_context->connection_info.algorithm.base_hash_algo);
 
-	th_curr_data_size = sizeof(th_curr_data);
-	result = spdm_calculate_th_for_exchange(spdm_context, session_info,
-						NULL, 0, &th_curr_data_size,
-						th_curr_data);
+	spdm_build_th_iov(spdm_context, session_info, NULL, 0, NULL, 0, FALSE,
+			  &th_iov);
+
+	result = spdm_hmac_multi_with_response_finished_key(
+		session_info->secured_message_context, th_iov.iov,
+		th_iov.iov_count, hmac_data);
 	if (!result) {
 		return FALSE;
 	}
-
-	spdm_hmac_all_with_response_finished_key(
-		session_info->secured_message_context, th_curr_data,
-		th_curr_data_size, hmac_data);
 	DEBUG((DEBUG_INFO, "th_curr hmac - "));
 	internal_dump_data(hmac_data, hash_size);
 	DEBUG((DEBUG_INFO, "\n"));
@@ -971,24 +1079,21 @@ boolean spdm_verify_psk_exchange_rsp_hmac(IN spdm_context_t *spdm_context,
 	uintn hash_size;
 	uint8 calc_hmac_data[MAX_HASH_SIZE];
 	boolean result;
-	uint8 th_curr_data[MAX_SPDM_MESSAGE_BUFFER_SIZE];
-	uintn th_curr_data_size;
+	spdm_th_iov_t th_iov;
 
 	hash_size = spdm_get_hash_size(
 		spdm_context->connection_info.algorithm.base_hash_algo);
 	ASSERT(hash_size == hmac_data_size);
 
-	th_curr_data_size = sizeof(th_curr_data);
-	result = spdm_calculate_th_for_exchange(spdm_context, session_info,
-						NULL, 0, &th_curr_data_size,
-						th_curr_data);
+	spdm_build_th_iov(spdm_context, session_info, NULL, 0, NULL, 0, FALSE,
+			  &th_iov);
+
+	result = spdm_hmac_multi_with_response_finished_key(
+		session_info->secured_message_context, th_iov.iov,
+		th_iov.iov_count, calc_hmac_data);
 	if (!result) {
 		return FALSE;
 	}
-
-	spdm_hmac_all_with_response_finished_key(
-		session_info->secured_message_context, th_curr_data,
-		th_curr_data_size, calc_hmac_data);
 	DEBUG((DEBUG_INFO, "th_curr hmac - "));
 	internal_dump_data(calc_hmac_data, hash_size);
 	DEBUG((DEBUG_INFO, "\n"));
@@ -1021,23 +1126,20 @@ spdm_generate_psk_exchange_req_hmac(IN spdm_context_t *spdm_context,
 	uintn hash_size;
 	uint8 calc_hmac_data[MAX_HASH_SIZE];
 	boolean result;
-	uint8 th_curr_data[MAX_SPDM_MESSAGE_BUFFER_SIZE];
-	uintn th_curr_data_size;
+	spdm_th_iov_t th_iov;
 
 	hash_size = spdm_get_hash_size(
 		spdm_context->connection_info.algorithm.base_hash_algo);
 
-	th_curr_data_size = sizeof(th_curr_data);
-	result = spdm_calculate_th_for_finish(spdm_context, session_info, NULL,
-					      0, NULL, 0, &th_curr_data_size,
-					      th_curr_data);
+	spdm_build_th_iov(spdm_context, session_info, NULL, 0, NULL, 0, TRUE,
+			  &th_iov);
+
+	result = spdm_hmac_multi_with_request_finished_key(
+		session_info->secured_message_context, th_iov.iov,
+		th_iov.iov_count, calc_hmac_data);
 	if (!result) {
 		return FALSE;
 	}
-
-	spdm_hmac_all_with_request_finished_key(
-		session_info->secured_message_context, th_curr_data,
-		th_curr_data_size, calc_hmac_data);
 	DEBUG((DEBUG_INFO, "th_curr hmac - "));
 	internal_dump_data(calc_hmac_data, hash_size);
 	DEBUG((DEBUG_INFO, "\n"));
@@ -1065,24 +1167,21 @@ boolean spdm_verify_psk_finish_req_hmac(IN spdm_context_t *spdm_context,
 	uint8 hmac_data[MAX_HASH_SIZE];
 	uint32 hash_size;
 	boolean result;
-	uint8 th_curr_data[MAX_SPDM_MESSAGE_BUFFER_SIZE];
-	uintn th_curr_data_size;
+	spdm_th_iov_t th_iov;
 
 	hash_size = spdm_get_hash_size(
 		spdm_context->connection_info.algorithm.base_hash_algo);
 	ASSERT(hmac_size == hash_size);
 
-	th_curr_data_size = sizeof(th_curr_data);
-	result = spdm_calculate_th_for_finish(spdm_context, session_info, NULL,
-					      0, NULL, 0, &th_curr_data_size,
-					      th_curr_data);
+	spdm_build_th_iov(spdm_context, session_info, NULL, 0, NULL, 0, TRUE,
+			  &th_iov);
+
+	result = spdm_hmac_multi_with_request_finished_key(
+		session_info->secured_message_context, th_iov.iov,
+		th_iov.iov_count, hmac_data);
 	if (!result) {
 		return FALSE;
 	}
-
-	spdm_hmac_all_with_request_finished_key(
-		session_info->secured_message_context, th_curr_data,
-		th_curr_data_size, hmac_data);
 	DEBUG((DEBUG_INFO, "Calc th_curr hmac - "));
 	internal_dump_data(hmac_data, hash_size);
 	DEBUG((DEBUG_INFO, "\n"));
@@ -1117,8 +1216,11 @@ return_status spdm_calculate_th1_hash(IN void *context,
 	uintn cert_chain_data_size;
 	spdm_session_info_t *session_info;
 	boolean result;
-	uint8 th_curr_data[MAX_SPDM_MESSAGE_BUFFER_SIZE];
-	uintn th_curr_data_size;
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
+	spdm_th_iov_t th_iov;
+	uintn index;
+	void *digest_context_th;
+#endif
 
 	spdm_context = context;
 
@@ -1147,16 +1249,44 @@ return_status spdm_calculate_th1_hash(IN void *context,
 		cert_chain_data_size = 0;
 	}
 
-	th_curr_data_size = sizeof(th_curr_data);
-	result = spdm_calculate_th_for_exchange(
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
+	//
+	// Snapshot Concatenate (A, Ct, K) into the TH hash context of the session,
+	// so that TH2 does not need to hash the KEY_EXCHANGE transcript again.
+	//
+	spdm_build_th_iov(spdm_context, session_info, cert_chain_data,
+			  cert_chain_data_size, NULL, 0, FALSE, &th_iov);
+	spdm_session_info_free_digest_context(spdm_context, session_info);
+	digest_context_th = spdm_hash_new(
+		spdm_context->connection_info.algorithm.base_hash_algo);
+	if (digest_context_th == NULL) {
+		return RETURN_OUT_OF_RESOURCES;
+	}
+	result = spdm_hash_init(
+		spdm_context->connection_info.algorithm.base_hash_algo,
+		digest_context_th);
+	for (index = 0; result && (index < th_iov.iov_count); index++) {
+		result = spdm_hash_update(
+			spdm_context->connection_info.algorithm.base_hash_algo,
+			digest_context_th, th_iov.iov[index].data,
+			th_iov.iov[index].data_size);
+	}
+	if (!result) {
+		spdm_hash_free(
+			spdm_context->connection_info.algorithm.base_hash_algo,
+			digest_context_th);
+		return RETURN_DEVICE_ERROR;
+	}
+	session_info->session_transcript.digest_context_th = digest_context_th;
+#endif
+
+	result = spdm_calculate_th_hash_for_exchange(
 		spdm_context, session_info, cert_chain_data,
-		cert_chain_data_size, &th_curr_data_size, th_curr_data);
+		cert_chain_data_size, th1_hash_data);
 	if (!result) {
 		return RETURN_SECURITY_VIOLATION;
 	}
 
-	spdm_hash_all(spdm_context->connection_info.algorithm.base_hash_algo,
-		      th_curr_data, th_curr_data_size, th1_hash_data);
 	DEBUG((DEBUG_INFO, "th1 hash - "));
 	internal_dump_data(th1_hash_data, hash_size);
 	DEBUG((DEBUG_INFO, "\n"));
@@ -1187,8 +1317,6 @@ return_status spdm_calculate_th2_hash(IN void *context,
 	uintn mut_cert_chain_data_size;
 	spdm_session_info_t *session_info;
 	boolean result;
-	uint8 th_curr_data[MAX_SPDM_MESSAGE_BUFFER_SIZE];
-	uintn th_curr_data_size;
 
 	spdm_context = context;
 
@@ -1238,20 +1366,239 @@ return_status spdm_calculate_th2_hash(IN void *context,
 		mut_cert_chain_data_size = 0;
 	}
 
-	th_curr_data_size = sizeof(th_curr_data);
-	result = spdm_calculate_th_for_finish(
+	result = spdm_calculate_th_hash_for_finish(
 		spdm_context, session_info, cert_chain_data,
 		cert_chain_data_size, mut_cert_chain_data,
-		mut_cert_chain_data_size, &th_curr_data_size, th_curr_data);
+		mut_cert_chain_data_size, th2_hash_data);
 	if (!result) {
 		return RETURN_SECURITY_VIOLATION;
 	}
 
-	spdm_hash_all(spdm_context->connection_info.algorithm.base_hash_algo,
-		      th_curr_data, th_curr_data_size, th2_hash_data);
 	DEBUG((DEBUG_INFO, "th2 hash - "));
 	internal_dump_data(th2_hash_data, hash_size);
 	DEBUG((DEBUG_INFO, "\n"));
 
 	return RETURN_SUCCESS;
 }
+
+#if MAX_SPDM_DHE_KEY_POOL_COUNT > 0
+/**
+  Return the DHE key pool of an SPDM context for a DHE group.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  dhe_named_group                SPDM dhe_named_group
+
+  @return the DHE key pool, or NULL if the DHE group is not a single SPDM DHE group.
+**/
+spdm_dhe_key_pool_t *spdm_get_dhe_key_pool(IN spdm_context_t *spdm_context,
+					   IN uint16 dhe_named_group)
+{
+	uintn index;
+
+	for (index = 0; index < SPDM_DHE_KEY_POOL_GROUP_COUNT; index++) {
+		if (dhe_named_group == (1 << index)) {
+			return &spdm_context->dhe_key_pool[index];
+		}
+	}
+	return NULL;
+}
+
+/**
+  Fill the DHE key pool of one DHE group with ephemeral key pairs.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  dhe_named_group                SPDM dhe_named_group
+
+  @retval RETURN_SUCCESS               The DHE key pool is full.
+  @retval RETURN_DEVICE_ERROR          A key pair cannot be generated.
+**/
+static return_status
+internal_spdm_refill_dhe_key_pool(IN spdm_context_t *spdm_context,
+				  IN uint16 dhe_named_group)
+{
+	spdm_dhe_key_pool_t *pool;
+	spdm_dhe_key_pool_entry_t *entry;
+	boolean result;
+	uintn index;
+
+	pool = spdm_get_dhe_key_pool(spdm_context, dhe_named_group);
+	if (pool == NULL) {
+		return RETURN_SUCCESS;
+	}
+
+	for (index = 0; index < MAX_SPDM_DHE_KEY_POOL_COUNT; index++) {
+		entry = &pool->entry[index];
+		if (entry->dhe_context != NULL) {
+			continue;
+		}
+
+		entry->dhe_context =
+			spdm_secured_message_dhe_new(dhe_named_group);
+		if (entry->dhe_context == NULL) {
+			return RETURN_DEVICE_ERROR;
+		}
+		entry->public_key_size = sizeof(entry->public_key);
+		result = spdm_secured_message_dhe_generate_key(
+			dhe_named_group, entry->dhe_context, entry->public_key,
+			&entry->public_key_size);
+		if (!result) {
+			spdm_secured_message_dhe_free(dhe_named_group,
+						      entry->dhe_context);
+			zero_mem(entry, sizeof(spdm_dhe_key_pool_entry_t));
+			return RETURN_DEVICE_ERROR;
+		}
+	}
+
+	return RETURN_SUCCESS;
+}
+#endif
+
+/**
+  Fill the DHE key pools of an SPDM context with ephemeral key pairs.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+
+  @retval RETURN_SUCCESS               The DHE key pools are full.
+  @retval RETURN_DEVICE_ERROR          A key pair cannot be generated.
+**/
+return_status spdm_refill_dhe_key_pool(IN void *context)
+{
+#if MAX_SPDM_DHE_KEY_POOL_COUNT > 0
+	spdm_context_t *spdm_context;
+	uint16 dhe_named_group;
+	return_status status;
+	uintn index;
+
+	spdm_context = context;
+	dhe_named_group =
+		spdm_context->connection_info.algorithm.dhe_named_group;
+	if (dhe_named_group == 0) {
+		dhe_named_group =
+			spdm_context->local_context->algorithm.dhe_named_group;
+	}
+
+	for (index = 0; index < SPDM_DHE_KEY_POOL_GROUP_COUNT; index++) {
+		if ((dhe_named_group & (1 << index)) == 0) {
+			continue;
+		}
+		status = internal_spdm_refill_dhe_key_pool(
+			spdm_context, (uint16)(1 << index));
+		if (RETURN_ERROR(status)) {
+			return status;
+		}
+	}
+#endif
+	return RETURN_SUCCESS;
+}
+
+/**
+  Refill the DHE key pools that gave a key pair to KEY_EXCHANGE.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+**/
+void spdm_refill_used_dhe_key_pool(IN spdm_context_t *spdm_context)
+{
+#if MAX_SPDM_DHE_KEY_POOL_COUNT > 0
+	uintn index;
+
+	for (index = 0; index < SPDM_DHE_KEY_POOL_GROUP_COUNT; index++) {
+		if ((spdm_context->dhe_key_pool_used_group & (1 << index)) ==
+		    0) {
+			continue;
+		}
+		internal_spdm_refill_dhe_key_pool(spdm_context,
+						  (uint16)(1 << index));
+	}
+	spdm_context->dhe_key_pool_used_group = 0;
+#endif
+}
+
+/**
+  Release all key pairs in the DHE key pools of an SPDM context.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+**/
+void spdm_free_dhe_key_pool(IN void *context)
+{
+#if MAX_SPDM_DHE_KEY_POOL_COUNT > 0
+	spdm_context_t *spdm_context;
+	spdm_dhe_key_pool_entry_t *entry;
+	uintn group_index;
+	uintn index;
+
+	spdm_context = context;
+	for (group_index = 0; group_index < SPDM_DHE_KEY_POOL_GROUP_COUNT;
+	     group_index++) {
+		for (index = 0; index < MAX_SPDM_DHE_KEY_POOL_COUNT; index++) {
+			entry = &spdm_context->dhe_key_pool[group_index]
+					 .entry[index];
+			if (entry->dhe_context != NULL) {
+				spdm_secured_message_dhe_free(
+					(uint16)(1 << group_index),
+					entry->dhe_context);
+			}
+			zero_mem(entry, sizeof(spdm_dhe_key_pool_entry_t));
+		}
+	}
+	spdm_context->dhe_key_pool_used_group = 0;
+#endif
+}
+
+/**
+  Return a DHE context with a generated ephemeral key pair.
+
+  A pre-generated key pair is taken from the DHE key pool if one is available for
+  the DHE group. Otherwise, the key pair is generated inline.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  dhe_named_group                SPDM dhe_named_group
+  @param  public_key                    Pointer to the buffer to receive generated public key.
+  @param  public_key_size                On input, the size of public_key buffer in bytes.
+                                       On output, the size of data returned in public_key buffer in bytes.
+
+  @return the DHE context, or NULL if the key pair cannot be generated.
+**/
+void *spdm_acquire_dhe_key(IN spdm_context_t *spdm_context,
+			   IN uint16 dhe_named_group, OUT uint8 *public_key,
+			   IN OUT uintn *public_key_size)
+{
+#if MAX_SPDM_DHE_KEY_POOL_COUNT > 0
+	spdm_dhe_key_pool_t *pool;
+	spdm_dhe_key_pool_entry_t *entry;
+	uintn index;
+#endif
+	void *dhe_context;
+	boolean result;
+
+#if MAX_SPDM_DHE_KEY_POOL_COUNT > 0
+	pool = spdm_get_dhe_key_pool(spdm_context, dhe_named_group);
+	for (index = 0; (pool != NULL) && (index < MAX_SPDM_DHE_KEY_POOL_COUNT);
+	     index++) {
+		entry = &pool->entry[index];
+		if (entry->dhe_context == NULL) {
+			continue;
+		}
+		if (*public_key_size < entry->public_key_size) {
+			return NULL;
+		}
+		dhe_context = entry->dhe_context;
+		*public_key_size = entry->public_key_size;
+		copy_mem(public_key, entry->public_key, entry->public_key_size);
+		zero_mem(entry, sizeof(spdm_dhe_key_pool_entry_t));
+		spdm_context->dhe_key_pool_used_group |= dhe_named_group;
+		return dhe_context;
+	}
+#endif
+
+	dhe_context = spdm_secured_message_dhe_new(dhe_named_group);
+	if (dhe_context == NULL) {
+		return NULL;
+	}
+	result = spdm_secured_message_dhe_generate_key(
+		dhe_named_group, dhe_context, public_key, public_key_size);
+	if (!result) {
+		spdm_secured_message_dhe_free(dhe_named_group, dhe_context);
+		return NULL;
+	}
+	return dhe_context;
+}
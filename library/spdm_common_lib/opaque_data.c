@@ -18,7 +18,7 @@ uintn spdm_get_opaque_data_version_selection_data_size(
 {
 	uintn size;
 
-	if (spdm_context->local_context.secured_message_version
+	if (spdm_context->local_context->secured_message_version
 		    .spdm_version_count == 0) {
 		return 0;
 	}
@@ -42,7 +42,7 @@ uintn spdm_get_opaque_data_supported_version_data_size(
 {
 	uintn size;
 
-	if (spdm_context->local_context.secured_message_version
+	if (spdm_context->local_context->secured_message_version
 		    .spdm_version_count == 0) {
 		return 0;
 	}
@@ -84,7 +84,7 @@ spdm_build_opaque_data_supported_version_data(IN spdm_context_t *spdm_context,
 	spdm_version_number_t *versions_list;
 	void *end;
 
-	if (spdm_context->local_context.secured_message_version
+	if (spdm_context->local_context->secured_message_version
 		    .spdm_version_count == 0) {
 		*data_out_size = 0;
 		return RETURN_SUCCESS;
@@ -158,7 +158,7 @@ spdm_process_opaque_data_supported_version_data(IN spdm_context_t *spdm_context,
 		*opaque_element_support_version;
 	spdm_version_number_t *versions_list;
 
-	if (spdm_context->local_context.secured_message_version
+	if (spdm_context->local_context->secured_message_version
 		    .spdm_version_count == 0) {
 		return RETURN_SUCCESS;
 	}
@@ -231,7 +231,7 @@ spdm_build_opaque_data_version_selection_data(IN spdm_context_t *spdm_context,
 		*OpaqueElementVersionSection;
 	void *end;
 
-	if (spdm_context->local_context.secured_message_version
+	if (spdm_context->local_context->secured_message_version
 		    .spdm_version_count == 0) {
 		*data_out_size = 0;
 		return RETURN_SUCCESS;
@@ -299,7 +299,7 @@ spdm_process_opaque_data_version_selection_data(IN spdm_context_t *spdm_context,
 	secured_message_opaque_element_version_selection_t
 		*OpaqueElementVersionSection;
 
-	if (spdm_context->local_context.secured_message_version
+	if (spdm_context->local_context->secured_message_version
 		    .spdm_version_count == 0) {
 		return RETURN_SUCCESS;
 	}
@@ -11,6 +11,7 @@
 #include <library/spdm_secured_message_lib.h>
 
 #define INVALID_SESSION_ID 0
+#define INVALID_SESSION_INDEX 0xFFFFFFFF
 
 typedef struct {
 	uint8 spdm_version_count;
@@ -33,6 +34,99 @@ typedef struct {
 	uint16 key_schedule;
 } spdm_device_algorithm_t;
 
+typedef struct {
+	//
+	// The hash algorithm of the cached hash. 0 means the cache is invalid.
+	//
+	uint32 base_hash_algo;
+	//
+	// The certificate chain buffer of the cached hash.
+	//
+	void *cert_chain_buffer;
+	uintn cert_chain_buffer_size;
+	//
+	// Provisioning generation of the local certificate chain slot, or of the provisioned
+	// peer certificate chain, of the cached hash.
+	//
+	uint32 generation;
+	//
+	// Hash of the certificate chain buffer including spdm_cert_chain_t header, used in DIGESTS and CHALLENGE_AUTH.
+	//
+	uint8 cert_chain_hash[MAX_HASH_SIZE];
+	//
+	// Hash of the certificate chain data without spdm_cert_chain_t header, used in TH as Ct or CM.
+	//
+	uint8 cert_chain_data_hash[MAX_HASH_SIZE];
+} spdm_cert_chain_hash_cache_t;
+
+typedef struct {
+	//
+	// The public key context of the leaf certificate. NULL means the cache is invalid.
+	//
+	void *public_key;
+	//
+	// The asymmetric algorithm of the public key, base_asym_algo or req_base_asym_alg.
+	//
+	uint32 asym_algo;
+	boolean is_req_asym_algo;
+	//
+	// The certificate chain data the public key is parsed from.
+	//
+	void *cert_chain_data;
+	uintn cert_chain_data_size;
+	//
+	// Provisioning generation of the provisioned peer certificate chain of the public key.
+	//
+	uint32 generation;
+} spdm_peer_public_key_cache_t;
+
+typedef struct {
+	//
+	// The hash algorithm of the digest. 0 means the entry is empty.
+	//
+	uint32 base_hash_algo;
+	//
+	// Digest of the certificate chain buffer, as reported in DIGESTS.
+	//
+	uint8 digest[MAX_HASH_SIZE];
+	//
+	// Stamp of the last use, for least-recently-used replacement. 0 while the entry is empty.
+	//
+	uint32 last_used;
+	//
+	// Verified certificate chain buffer including spdm_cert_chain_t header.
+	//
+	uintn cert_chain_size;
+	uint8 cert_chain[MAX_SPDM_CERT_CHAIN_SIZE];
+} spdm_cert_chain_cache_entry_t;
+
+typedef struct {
+	uint32 entry_count;
+	uint32 use_count;
+	//
+	// Entries placed behind this header, sized by spdm_init_cert_chain_cache.
+	//
+	spdm_cert_chain_cache_entry_t *entry;
+} spdm_cert_chain_cache_t;
+
+typedef struct {
+	void *dhe_context;
+	uintn public_key_size;
+	uint8 public_key[MAX_DHE_KEY_SIZE];
+} spdm_dhe_key_pool_entry_t;
+
+//
+// One DHE key pool per SPDM DHE group, indexed by the bit position of
+// SPDM_ALGORITHMS_DHE_NAMED_GROUP_*.
+//
+#define SPDM_DHE_KEY_POOL_GROUP_COUNT 6
+
+#if MAX_SPDM_DHE_KEY_POOL_COUNT > 0
+typedef struct {
+	spdm_dhe_key_pool_entry_t entry[MAX_SPDM_DHE_KEY_POOL_COUNT];
+} spdm_dhe_key_pool_t;
+#endif
+
 typedef struct {
 	//
 	// Local device info
@@ -46,6 +140,11 @@ typedef struct {
 	//
 	void *local_cert_chain_provision[MAX_SPDM_SLOT_COUNT];
 	uintn local_cert_chain_provision_size[MAX_SPDM_SLOT_COUNT];
+	//
+	// Bumped each time a slot is provisioned, so that the certificate chain hash
+	// cache of every SPDM context sharing this local context drops the old hash.
+	//
+	uint32 local_cert_chain_generation[MAX_SPDM_SLOT_COUNT];
 	uint8 slot_count;
 	// My provisioned certificate (for slot_id - 0xFF, default 0)
 	uint8 provisioned_slot_id;
@@ -60,6 +159,12 @@ typedef struct {
 	void *peer_cert_chain_provision;
 	uintn peer_cert_chain_provision_size;
 	//
+	// Bumped each time the peer certificate chain is provisioned, so that the peer
+	// certificate chain hash and public key caches of every SPDM context sharing this
+	// local context drop the old entry, even if the new chain is at the same address.
+	//
+	uint32 peer_cert_chain_generation;
+	//
 	// PSK provision locally
 	//
 	uintn psk_hint_size;
@@ -76,6 +181,10 @@ typedef struct {
 	//
 	boolean basic_mut_auth_requested;
 	uint8 mut_auth_requested;
+	//
+	// Number of SPDM contexts using this local context
+	//
+	uint32 ref_count;
 } spdm_local_context_t;
 
 typedef struct {
@@ -96,30 +205,78 @@ typedef struct {
 	uint8 peer_used_cert_chain_buffer[MAX_SPDM_CERT_CHAIN_SIZE];
 	uintn peer_used_cert_chain_buffer_size;
 	//
+	// Digests of the peer certificate chains in the last DIGESTS, indexed by slot
+	//
+	uint8 peer_digest_slot_mask;
+	uint8 peer_digest[MAX_SPDM_SLOT_COUNT][MAX_HASH_SIZE];
+	//
+	// Cached hash of the peer certificate chain returned by spdm_get_peer_cert_chain_buffer
+	//
+	spdm_cert_chain_hash_cache_t peer_cert_chain_hash_cache;
+	//
+	// Cached public key of the leaf certificate in the peer certificate chain
+	//
+	spdm_peer_public_key_cache_t peer_public_key_cache;
+	//
 	// Local Used CertificateChain (for responder, or requester in mut auth)
 	//
 	uint8 *local_used_cert_chain_buffer;
 	uintn local_used_cert_chain_buffer_size;
 } spdm_connection_info_t;
 
+typedef struct {
+	void *arena;
+	spdm_arena_allocate_func allocate_func;
+	spdm_arena_free_func free_func;
+} spdm_arena_t;
+
 typedef struct {
 	uintn max_buffer_size;
 	uintn buffer_size;
+#if OPENSPDM_ARENA_MANAGED_BUFFER_SUPPORT == 1
+	//
+	// If arena is NULL, the data follows the header.
+	// Otherwise, the data is arena_buffer, allocated from the arena with arena_buffer_capacity bytes.
+	//
+	spdm_arena_t *arena;
+	uintn arena_buffer_capacity;
+	uint8 *arena_buffer;
+#endif
 	//uint8   buffer[max_buffer_size];
 } managed_buffer_t;
 
 typedef struct {
 	uintn max_buffer_size;
 	uintn buffer_size;
+#if OPENSPDM_ARENA_MANAGED_BUFFER_SUPPORT == 1
+	spdm_arena_t *arena;
+	uintn arena_buffer_capacity;
+	uint8 *arena_buffer;
+#endif
 	uint8 buffer[MAX_SPDM_MESSAGE_BUFFER_SIZE];
 } large_managed_buffer_t;
 
 typedef struct {
 	uintn max_buffer_size;
 	uintn buffer_size;
+#if OPENSPDM_ARENA_MANAGED_BUFFER_SUPPORT == 1
+	spdm_arena_t *arena;
+	uintn arena_buffer_capacity;
+	uint8 *arena_buffer;
+#endif
 	uint8 buffer[MAX_SPDM_MESSAGE_SMALL_BUFFER_SIZE];
 } small_managed_buffer_t;
 
+//
+// The large buffers kept in the SPDM context and the session info.
+// They are backed by the registered arena if OPENSPDM_ARENA_MANAGED_BUFFER_SUPPORT is 1.
+//
+#if OPENSPDM_ARENA_MANAGED_BUFFER_SUPPORT == 1
+typedef managed_buffer_t large_arena_managed_buffer_t;
+#else
+typedef large_managed_buffer_t large_arena_managed_buffer_t;
+#endif
+
 typedef struct {
 	//
 	// signature = Sign(SK, hash(M1))
@@ -135,10 +292,23 @@ typedef struct {
 	// MutC = Concatenate (CHALLENGE, CHALLENGE_AUTH\signature)
 	//
 	small_managed_buffer_t message_a;
-	large_managed_buffer_t message_b;
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
+	large_arena_managed_buffer_t message_b;
 	small_managed_buffer_t message_c;
-	large_managed_buffer_t message_mut_b;
+	large_arena_managed_buffer_t message_mut_b;
 	small_managed_buffer_t message_mut_c;
+#else
+	//
+	// Running hash of Concatenate (A, B), started at the first B message.
+	// Running hash of M1/M2 = Concatenate (A, B, C), duplicated from the (A, B) hash
+	// at the first C message, so that resetting C keeps B.
+	// The same applies to MutB and Mut M1/M2 = Concatenate (MutB, MutC).
+	//
+	void *digest_context_b;
+	void *digest_context_m1m2;
+	void *digest_context_mut_b;
+	void *digest_context_mut_m1m2;
+#endif
 	//
 	// signature = Sign(SK, hash(L1))
 	// Verify(PK, hash(L2), signature)
@@ -146,7 +316,7 @@ typedef struct {
 	// L1/L2 = Concatenate (M)
 	// M = Concatenate (GET_MEASUREMENT, MEASUREMENT\signature)
 	//
-	large_managed_buffer_t message_m;
+	large_arena_managed_buffer_t message_m;
 } spdm_transcript_t;
 
 typedef struct {
@@ -181,8 +351,15 @@ typedef struct {
 	// CM = mutual certificate chain *
 	// F  = Concatenate (FINISH request, FINISH response)
 	//
-	large_managed_buffer_t message_k;
-	large_managed_buffer_t message_f;
+	large_arena_managed_buffer_t message_k;
+	large_arena_managed_buffer_t message_f;
+	//
+	// Running hash of Concatenate (A, Ct, K). Ct is skipped for PSK.
+	// If the transcript is recorded, it is snapshotted from the transcript buffers at TH1.
+	// Otherwise, it is started at the first K message.
+	// TH2 and FINISH TH are finalized from a copy of it extended with CM and F.
+	//
+	void *digest_context_th;
 	//
 	// TH for PSK_EXCHANGE response HMAC: Concatenate (A, K)
 	// K  = Concatenate (PSK_EXCHANGE request, PSK_EXCHANGE response\verify_data)
@@ -211,6 +388,13 @@ typedef struct {
 	uint8 end_session_attributes;
 	spdm_session_transcript_t session_transcript;
 	void *secured_message_context;
+	//
+	// Session table bookkeeping, kept across spdm_session_info_init
+	//
+	uint32 next_hash_index;
+	uint32 next_free_index;
+	boolean in_free_list;
+	boolean storage_initialized;
 } spdm_session_info_t;
 
 #define MAX_ENCAP_REQUEST_OP_CODE_SEQUENCE_COUNT 3
@@ -226,9 +410,44 @@ typedef struct {
 	uint8 req_slot_id;
 	spdm_message_header_t last_encap_request_header;
 	uintn last_encap_request_size;
-	large_managed_buffer_t certificate_chain_buffer;
+	large_arena_managed_buffer_t certificate_chain_buffer;
 } spdm_encap_context_t;
 
+typedef struct {
+	// Operation started by spdm_begin_*, SPDM_REQUESTER_STEP_OPERATION_NONE if idle
+	uint8 operation;
+	// Next action reported by spdm_requester_step
+	uint8 action;
+	// Request code of the request held in last_spdm_request
+	uint8 request_code;
+	// A RESPOND_IF_READY is sent instead of the held request
+	boolean respond_if_ready;
+	return_status status;
+	uintn retry;
+	//
+	// Parameters and outputs of the operation
+	//
+	boolean get_version_only;
+	boolean use_psk;
+	uint8 slot_id;
+	uint8 measurement_hash_type;
+	uint8 req_slot_id_param;
+	uint8 request_attribute;
+	uint8 measurement_operation;
+	uint8 *slot_mask;
+	void *total_digest_buffer;
+	uintn *cert_chain_size;
+	void *cert_chain;
+	uint32 *session_id;
+	uint8 *heartbeat_period;
+	void *measurement_hash;
+	uint8 *number_of_blocks;
+	uint32 *measurement_record_length;
+	void *measurement_record;
+	void *dhe_context;
+	large_arena_managed_buffer_t certificate_chain_buffer;
+} spdm_requester_step_context_t;
+
 #define spdm_context_struct_VERSION 0x1
 
 typedef struct {
@@ -243,6 +462,36 @@ typedef struct {
 	//
 	spdm_transport_encode_message_func transport_encode_message;
 	spdm_transport_decode_message_func transport_decode_message;
+	//
+	// Arena for the large managed buffers
+	//
+	spdm_arena_t arena;
+	//
+	// Register timestamp function for the statistics and the trace
+	//
+	uintn get_timestamp_func;
+	//
+	// Trace buffer, possibly shared by many SPDM contexts
+	//
+	spdm_trace_buffer_t *trace_buffer;
+#if OPENSPDM_RESPONDER_STATISTICS_SUPPORT == 1
+	//
+	// Statistics of the handled requests (responder only)
+	// The signing of the current request is accumulated in statistics_sign_time/count.
+	//
+	spdm_responder_statistics_t responder_statistics;
+	uint64 statistics_sign_time;
+	uint32 statistics_sign_count;
+#endif
+#if OPENSPDM_REQUESTER_STATISTICS_SUPPORT == 1
+	//
+	// Statistics of the sent requests (requester only)
+	// The transport and verify time is recorded for statistics_request_code,
+	// the code of the last sent request.
+	//
+	spdm_requester_statistics_t requester_statistics;
+	uint8 statistics_request_code;
+#endif
 
 	//
 	// command status
@@ -251,8 +500,14 @@ typedef struct {
 	//
 	// Cached plain text command
 	// If the command is cipher text, decrypt then cache it.
+	// The requester holds the outstanding request of spdm_requester_step here.
+	// It is allocated from the arena on first use if OPENSPDM_ARENA_MANAGED_BUFFER_SUPPORT is 1.
 	//
+#if OPENSPDM_ARENA_MANAGED_BUFFER_SUPPORT == 1
+	uint8 *last_spdm_request;
+#else
 	uint8 last_spdm_request[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+#endif
 	uintn last_spdm_request_size;
 	//
 	// Cache session_id in this spdm_message, only valid for secured message.
@@ -274,6 +529,20 @@ typedef struct {
 	uintn get_encap_response_func;
 	spdm_encap_context_t encap_context;
 	//
+	// Verified peer certificate chain cache and its persistent store (requester only)
+	//
+	spdm_cert_chain_cache_t *cert_chain_cache;
+	uintn cert_chain_store_load_func;
+	uintn cert_chain_store_save_func;
+	//
+	// Certificate chain verify cache of spdm_crypt_lib, or NULL to verify peer chains in full
+	//
+	void *cert_chain_verify_cache;
+	//
+	// Resumable operation driven by spdm_requester_step (requester only)
+	//
+	spdm_requester_step_context_t requester_step;
+	//
 	// Register spdm_session_state_callback function (responder only)
 	// Register can know the state after StartSession / EndSession.
 	//
@@ -285,12 +554,41 @@ typedef struct {
 	uintn spdm_connection_state_callback
 		[MAX_SPDM_CONNECTION_STATE_CALLBACK_NUM];
 
-	spdm_local_context_t local_context;
+	//
+	// Local identity, either placed behind this context or shared by many
+	// SPDM contexts through spdm_init_context_with_local_context.
+	//
+	spdm_local_context_t *local_context;
+	//
+	// Cached hashes of the local certificate chains. They are kept per SPDM context,
+	// so that the shared local context is only read while messages are processed.
+	//
+	spdm_cert_chain_hash_cache_t
+		local_cert_chain_hash_cache[MAX_SPDM_SLOT_COUNT];
 
 	spdm_connection_info_t connection_info;
 	spdm_transcript_t transcript;
 
-	spdm_session_info_t session_info[MAX_SPDM_SESSION_COUNT];
+	//
+	// Session table placed behind the SPDM context, sized by spdm_init_context_ex.
+	// A session is found by the hash of its session ID and assigned from a free list.
+	//
+	spdm_session_info_t *session_info;
+	uint32 max_session_count;
+	uint32 *session_hash_bucket;
+	uint32 session_hash_mask;
+	uint32 free_session_index;
+#if MAX_SPDM_DHE_KEY_POOL_COUNT > 0
+	//
+	// Pre-generated ephemeral DHE key pairs, filled by spdm_refill_dhe_key_pool
+	//
+	spdm_dhe_key_pool_t dhe_key_pool[SPDM_DHE_KEY_POOL_GROUP_COUNT];
+	//
+	// DHE groups whose pool gave a key pair to KEY_EXCHANGE, refilled by
+	// spdm_refill_used_dhe_key_pool once the session handshake completes.
+	//
+	uint16 dhe_key_pool_used_group;
+#endif
 	//
 	// Cache lastest session ID for HANDSHAKE_IN_THE_CLEAR
 	//
@@ -301,9 +599,15 @@ typedef struct {
 	spdm_response_state_t response_state;
 	//
 	// Cached data for SPDM_ERROR_CODE_RESPONSE_NOT_READY/SPDM_RESPOND_IF_READY
+	// The request is allocated from the arena on the first ResponseNotReady
+	// if OPENSPDM_ARENA_MANAGED_BUFFER_SUPPORT is 1.
 	//
 	spdm_error_data_response_not_ready_t error_data;
+#if OPENSPDM_ARENA_MANAGED_BUFFER_SUPPORT == 1
+	uint8 *cache_spdm_request;
+#else
 	uint8 cache_spdm_request[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+#endif
 	uintn cache_spdm_request_size;
 	uint8 current_token;
 	//
@@ -336,6 +640,62 @@ void internal_dump_data(IN uint8 *data, IN uintn size);
 **/
 void internal_dump_hex(IN uint8 *data, IN uintn size);
 
+/**
+  This function dump a transcript with colume format.
+
+  Nothing is dumped if the messages of the SPDM context are traced,
+  because the transcript repeats them.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  data  raw data
+  @param  size  raw data size
+**/
+void internal_dump_transcript(IN spdm_context_t *spdm_context,
+			      IN uint8 *data, IN uintn size);
+
+/**
+  Record an SPDM or APP message in the trace buffer of an SPDM context.
+
+  If no trace buffer is registered, or OPENSPDM_TRACE_SUPPORT is 0,
+  the message is dumped in hex through DEBUG.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  event_type                    The trace event type (SPDM_TRACE_EVENT_*).
+  @param  session_id                    The session ID of a secured message, or NULL.
+  @param  is_app_message                 Indicates if it is an APP message or SPDM message.
+  @param  message                       A pointer to the message.
+  @param  message_size                  size in bytes of the message.
+**/
+void spdm_trace_message(IN spdm_context_t *spdm_context, IN uint8 event_type,
+			IN uint32 *session_id OPTIONAL,
+			IN boolean is_app_message, IN void *message,
+			IN uintn message_size);
+
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 0
+/**
+  Append a message to the running hash of a transcript.
+
+  The hash context is created on first use, as a duplicate of the prefix hash context
+  if it is present. Otherwise, if message A is requested, it is fed into the new hash
+  context before the message.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  digest_context                A pointer to the running hash context of the transcript.
+  @param  prefix_digest_context         The running hash context of the transcript prefix, or NULL.
+  @param  include_message_a             Indicate if message A is the prefix of the transcript.
+  @param  message                      message buffer.
+  @param  message_size                  size in bytes of message buffer.
+
+  @return RETURN_SUCCESS          message is appended.
+  @return RETURN_OUT_OF_RESOURCES message is not appended because the hash context cannot be created.
+  @return RETURN_DEVICE_ERROR     message is not appended because the hash operation fails.
+**/
+return_status spdm_append_message_to_digest_context(
+	IN spdm_context_t *spdm_context, IN OUT void **digest_context,
+	IN void *prefix_digest_context OPTIONAL, IN boolean include_message_a,
+	IN void *message, IN uintn message_size);
+#endif
+
 /**
   Append a new data buffer to the managed buffer.
 
@@ -398,6 +758,109 @@ void *get_managed_buffer(IN void *managed_buffer_t);
 void init_managed_buffer(IN OUT void *managed_buffer_t,
 			 IN uintn max_buffer_size);
 
+#if OPENSPDM_ARENA_MANAGED_BUFFER_SUPPORT == 1
+/**
+  Init the managed buffer whose data is allocated from an arena.
+
+  No data is allocated here. The data grows from the arena when it is appended,
+  and is returned to the arena when the managed buffer is reset.
+
+  @param  managed_buffer_t                The managed buffer.
+  @param  max_buffer_size                The maximum size in bytes of the managed buffer.
+  @param  arena                         The arena to allocate the data from.
+**/
+void init_arena_managed_buffer(IN OUT void *managed_buffer_t,
+			       IN uintn max_buffer_size,
+			       IN spdm_arena_t *arena);
+
+/**
+  Allocate a request buffer of MAX_SPDM_MESSAGE_BUFFER_SIZE bytes from an arena on first use.
+
+  Nothing is allocated if the request buffer is already allocated.
+
+  @param  arena                         The arena to allocate the request buffer from.
+  @param  request_buffer                On input, the request buffer or NULL.
+                                       On output, the allocated request buffer.
+
+  @retval RETURN_SUCCESS               The request buffer is allocated.
+  @retval RETURN_OUT_OF_RESOURCES      No arena is registered, or the arena cannot allocate the buffer.
+**/
+return_status spdm_allocate_arena_request_buffer(IN spdm_arena_t *arena,
+						 IN OUT uint8 **request_buffer);
+
+/**
+  Return a request buffer allocated by spdm_allocate_arena_request_buffer to the arena.
+
+  @param  arena                         The arena the request buffer is allocated from.
+  @param  request_buffer                On input, the request buffer or NULL.
+                                       On output, NULL.
+**/
+void spdm_free_arena_request_buffer(IN spdm_arena_t *arena,
+				    IN OUT uint8 **request_buffer);
+#endif
+
+/**
+  Get the timestamp from the function registered by spdm_register_get_timestamp_func.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+
+  @return The current timestamp, or 0 if no function is registered.
+**/
+uint64 spdm_statistics_get_timestamp(IN spdm_context_t *spdm_context);
+
+/**
+  Record one time sample in the time statistics.
+
+  @param  time_statistics               A pointer to the time statistics.
+  @param  elapsed_time                  The elapsed time of the sample.
+**/
+void spdm_statistics_record_time(IN OUT spdm_statistics_time_t *time_statistics,
+				 IN uint64 elapsed_time);
+
+/**
+  Record the time elapsed since start_time in the time statistics.
+
+  Nothing is recorded if no timestamp function is registered.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  time_statistics               A pointer to the time statistics.
+  @param  start_time                    The timestamp taken at the start.
+**/
+void spdm_statistics_record_elapsed_time(
+	IN spdm_context_t *spdm_context,
+	IN OUT spdm_statistics_time_t *time_statistics, IN uint64 start_time);
+
+#if OPENSPDM_RESPONDER_STATISTICS_SUPPORT == 1
+/**
+  Add the time of one signing to the statistics of the request being handled.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  sign_start_time               The timestamp taken before the signing.
+**/
+void spdm_statistics_add_sign_time(IN spdm_context_t *spdm_context,
+				   IN uint64 sign_start_time);
+#endif
+
+#if OPENSPDM_REQUESTER_STATISTICS_SUPPORT == 1
+/**
+  Record the time of one signature verification for the last sent request.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  verify_start_time             The timestamp taken before the verification.
+**/
+void spdm_statistics_add_verify_time(IN spdm_context_t *spdm_context,
+				     IN uint64 verify_start_time);
+#endif
+
+/**
+  This function frees the running TH hash context of the session info.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  session_info                  A pointer to the SPDM session info.
+**/
+void spdm_session_info_free_digest_context(IN spdm_context_t *spdm_context,
+					   IN spdm_session_info_t *session_info);
+
 /**
   This function initializes the session info.
 
@@ -465,9 +928,24 @@ spdm_is_capabilities_flag_supported(IN spdm_context_t *spdm_context,
 
   @retval RETURN_SUCCESS  m1m2 is calculated.
 */
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 boolean spdm_calculate_m1m2(IN void *context, IN boolean is_mut,
 			    IN OUT uintn *m1m2_buffer_size,
 			    OUT void *m1m2_buffer);
+#endif
+
+/*
+  This function calculates m1m2 hash.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  is_mut                        Indicate if this is from mutual authentication.
+  @param  m1m2_hash                     The buffer to store the m1m2 hash
+
+  @retval TRUE  m1m2 hash is calculated.
+  @retval FALSE m1m2 hash is not calculated.
+*/
+boolean spdm_calculate_m1m2_hash(IN void *context, IN boolean is_mut,
+				 OUT uint8 *m1m2_hash);
 
 /*
   This function calculates l1l2.
@@ -494,6 +972,135 @@ boolean spdm_calculate_l1l2(IN void *context, IN OUT uintn *l1l2_buffer_size,
 boolean spdm_generate_cert_chain_hash(IN spdm_context_t *spdm_context,
 				      IN uintn slot_id, OUT uint8 *hash);
 
+/**
+  This function calculates the hash of a certificate chain buffer or certificate chain data.
+
+  If the certificate chain is a local provisioned certificate chain or the peer certificate chain,
+  the hash is taken from the certificate chain hash cache, which is filled on first use for
+  the negotiated hash algorithm. Otherwise, the hash is calculated directly.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  cert_chain                    Certitiface chain buffer including spdm_cert_chain_t header,
+                                        or certitiface chain data without spdm_cert_chain_t header.
+  @param  cert_chain_size               size in bytes of the certitiface chain.
+  @param  hash                          The buffer to store the certificate chain hash.
+**/
+void spdm_calculate_cert_chain_hash(IN spdm_context_t *spdm_context,
+				    IN void *cert_chain,
+				    IN uintn cert_chain_size,
+				    OUT uint8 *hash);
+
+/**
+  This function invalidates the cached hash and the cached public key of the peer certificate chain.
+
+  It must be called whenever the peer certificate chain buffer is changed.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+**/
+void spdm_invalidate_peer_cert_chain_hash(IN spdm_context_t *spdm_context);
+
+/**
+  This function returns the public key of the leaf certificate in the peer certificate chain.
+
+  The public key is parsed on first use and kept in the connection info until the peer
+  certificate chain is changed or the SPDM context is reset.
+  The caller must not free the returned public key.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  is_req_asym_algo              TRUE if the peer is a requester and the key uses req_base_asym_alg.
+                                        FALSE if the peer is a responder and the key uses base_asym_algo.
+  @param  public_key                    The public key context of the peer leaf certificate.
+
+  @retval TRUE  The public key is returned.
+  @retval FALSE The public key cannot be retrieved.
+**/
+boolean spdm_get_peer_public_key(IN spdm_context_t *spdm_context,
+				 IN boolean is_req_asym_algo,
+				 OUT void **public_key);
+
+/**
+  This function frees the cached public key of the peer certificate chain.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+**/
+void spdm_free_peer_public_key(IN spdm_context_t *spdm_context);
+
+/**
+  Return a DHE context with a generated ephemeral key pair.
+
+  A pre-generated key pair is taken from the DHE key pool if one is available for
+  the DHE group. Otherwise, the key pair is generated inline.
+  The caller owns the returned context and frees it with spdm_secured_message_dhe_free.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  dhe_named_group                SPDM dhe_named_group
+  @param  public_key                    Pointer to the buffer to receive generated public key.
+  @param  public_key_size                On input, the size of public_key buffer in bytes.
+                                       On output, the size of data returned in public_key buffer in bytes.
+
+  @return the DHE context, or NULL if the key pair cannot be generated.
+**/
+void *spdm_acquire_dhe_key(IN spdm_context_t *spdm_context,
+			   IN uint16 dhe_named_group, OUT uint8 *public_key,
+			   IN OUT uintn *public_key_size);
+
+#if MAX_SPDM_DHE_KEY_POOL_COUNT > 0
+/**
+  Return the DHE key pool of an SPDM context for a DHE group.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  dhe_named_group                SPDM dhe_named_group
+
+  @return the DHE key pool, or NULL if the DHE group is not a single SPDM DHE group.
+**/
+spdm_dhe_key_pool_t *spdm_get_dhe_key_pool(IN spdm_context_t *spdm_context,
+					   IN uint16 dhe_named_group);
+#endif
+
+/**
+  Refill the DHE key pools that gave a key pair to KEY_EXCHANGE.
+
+  It is called when a DHE session handshake completes, so that the next KEY_EXCHANGE
+  again finds a ready key pair without the integrator calling spdm_refill_dhe_key_pool.
+  A failure to generate a key pair is ignored; KEY_EXCHANGE then generates one inline.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+**/
+void spdm_refill_used_dhe_key_pool(IN spdm_context_t *spdm_context);
+
+#define SPDM_TH_IOV_MAX_COUNT 5
+
+///
+/// Scatter-gather list of TH data: Concatenate (A, Ct, K, CM, F).
+/// Ct and CM are replaced by the certificate chain hashes held in this structure.
+///
+typedef struct {
+	spdm_iovec_t iov[SPDM_TH_IOV_MAX_COUNT];
+	uintn iov_count;
+	uint8 cert_chain_data_hash[MAX_HASH_SIZE];
+	uint8 mut_cert_chain_data_hash[MAX_HASH_SIZE];
+} spdm_th_iov_t;
+
+/**
+  This function builds the scatter-gather list of current TH data without copying the transcript.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  session_info                  The SPDM session ID.
+  @param  cert_chain_data                Certitiface chain data without spdm_cert_chain_t header.
+  @param  cert_chain_data_size            size in bytes of the certitiface chain data.
+  @param  mut_cert_chain_data             Certitiface chain data without spdm_cert_chain_t header in mutual authentication.
+  @param  mut_cert_chain_data_size         size in bytes of the certitiface chain data in mutual authentication.
+  @param  include_message_f              Indicate if message F is appended.
+  @param  th_iov                         The scatter-gather list of TH data.
+**/
+void spdm_build_th_iov(IN spdm_context_t *spdm_context,
+		       IN spdm_session_info_t *session_info,
+		       OPTIONAL IN uint8 *cert_chain_data,
+		       OPTIONAL IN uintn cert_chain_data_size,
+		       OPTIONAL IN uint8 *mut_cert_chain_data,
+		       OPTIONAL IN uintn mut_cert_chain_data_size,
+		       IN boolean include_message_f, OUT spdm_th_iov_t *th_iov);
+
 /**
   This function verifies the digest.
 
@@ -521,6 +1128,23 @@ boolean spdm_verify_peer_cert_chain_buffer(IN spdm_context_t *spdm_context,
 					   IN void *cert_chain_buffer,
 					   IN uintn cert_chain_buffer_size);
 
+/**
+  This function verifies peer certificate chain buffer including spdm_cert_chain_t header
+  against the provisioned peer root certificate hash or peer certificate chain.
+
+  The integrity of the certificate chain itself is not verified.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  cert_chain_buffer              Certitiface chain buffer including spdm_cert_chain_t header.
+  @param  cert_chain_buffer_size          size in bytes of the certitiface chain buffer.
+
+  @retval TRUE  Peer certificate chain buffer matches the provisioned trust anchor.
+  @retval FALSE Peer certificate chain buffer does not match the provisioned trust anchor.
+**/
+boolean spdm_verify_peer_cert_chain_buffer_provision(
+	IN spdm_context_t *spdm_context, IN void *cert_chain_buffer,
+	IN uintn cert_chain_buffer_size);
+
 /**
   This function generates the challenge signature based upon m1m2 for authentication.
 
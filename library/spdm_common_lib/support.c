@@ -63,6 +63,27 @@ void internal_dump_hex(IN uint8 *data, IN uintn size)
 	}
 }
 
+/**
+  This function dump a transcript with colume format.
+
+  Nothing is dumped if the messages of the SPDM context are traced,
+  because the transcript repeats them.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  data  raw data
+  @param  size  raw data size
+**/
+void internal_dump_transcript(IN spdm_context_t *spdm_context,
+			      IN uint8 *data, IN uintn size)
+{
+#if OPENSPDM_TRACE_SUPPORT == 1
+	if (spdm_context->trace_buffer != NULL) {
+		return;
+	}
+#endif
+	internal_dump_hex(data, size);
+}
+
 /**
   Reads a 24-bit value from memory that may be unaligned.
 
@@ -91,6 +112,87 @@ uint32 spdm_write_uint24(IN uint8 *buffer, IN uint32 value)
 	return value;
 }
 
+/**
+  Return the address of the data of the managed buffer.
+
+  @param  managed_buffer                The managed buffer.
+
+  @return the address of the data of the managed buffer.
+**/
+static uint8 *internal_get_managed_buffer_data(IN managed_buffer_t *managed_buffer)
+{
+#if OPENSPDM_ARENA_MANAGED_BUFFER_SUPPORT == 1
+	if (managed_buffer->arena != NULL) {
+		return managed_buffer->arena_buffer;
+	}
+#endif
+	return (uint8 *)(managed_buffer + 1);
+}
+
+#if OPENSPDM_ARENA_MANAGED_BUFFER_SUPPORT == 1
+/**
+  Grow the data of an arena managed buffer to hold at least a given size.
+
+  The capacity is doubled, starting from MAX_SPDM_MESSAGE_SMALL_BUFFER_SIZE, and capped
+  at the max_buffer_size. The recorded data is moved to the new allocation.
+
+  @param  managed_buffer                The managed buffer.
+  @param  required_size                 The size in bytes the data must hold.
+
+  @retval RETURN_SUCCESS               The managed buffer holds at least required_size bytes.
+  @retval RETURN_OUT_OF_RESOURCES      The arena cannot allocate the data.
+**/
+static return_status
+internal_grow_arena_managed_buffer(IN OUT managed_buffer_t *managed_buffer,
+				   IN uintn required_size)
+{
+	spdm_arena_t *arena;
+	uintn capacity;
+	uint8 *arena_buffer;
+
+	ASSERT(required_size <= managed_buffer->max_buffer_size);
+	if (required_size <= managed_buffer->arena_buffer_capacity) {
+		return RETURN_SUCCESS;
+	}
+
+	arena = managed_buffer->arena;
+	if ((arena->allocate_func == NULL) || (arena->free_func == NULL)) {
+		DEBUG((DEBUG_ERROR,
+		       "append_managed_buffer - no arena registered by spdm_register_arena_func\n"));
+		return RETURN_OUT_OF_RESOURCES;
+	}
+
+	capacity = managed_buffer->arena_buffer_capacity;
+	if (capacity == 0) {
+		capacity = MAX_SPDM_MESSAGE_SMALL_BUFFER_SIZE;
+	}
+	while (capacity < required_size) {
+		capacity = capacity * 2;
+	}
+	if (capacity > managed_buffer->max_buffer_size) {
+		capacity = managed_buffer->max_buffer_size;
+	}
+
+	arena_buffer = arena->allocate_func(arena->arena, capacity);
+	if (arena_buffer == NULL) {
+		DEBUG((DEBUG_ERROR,
+		       "append_managed_buffer - arena allocate 0x%x fail\n",
+		       (uint32)capacity));
+		return RETURN_OUT_OF_RESOURCES;
+	}
+	if (managed_buffer->arena_buffer != NULL) {
+		copy_mem(arena_buffer, managed_buffer->arena_buffer,
+			 managed_buffer->buffer_size);
+		zero_mem(managed_buffer->arena_buffer,
+			 managed_buffer->arena_buffer_capacity);
+		arena->free_func(arena->arena, managed_buffer->arena_buffer);
+	}
+	managed_buffer->arena_buffer = arena_buffer;
+	managed_buffer->arena_buffer_capacity = capacity;
+	return RETURN_SUCCESS;
+}
+#endif
+
 /**
   Append a new data buffer to the managed buffer.
 
@@ -100,11 +202,15 @@ uint32 spdm_write_uint24(IN uint8 *buffer, IN uint32 value)
 
   @retval RETURN_SUCCESS               The new data buffer is appended to the managed buffer.
   @retval RETURN_BUFFER_TOO_SMALL      The managed buffer is too small to be appended.
+  @retval RETURN_OUT_OF_RESOURCES      The arena cannot allocate the data of the managed buffer.
 **/
 return_status append_managed_buffer(IN OUT void *m_buffer, IN void *buffer,
 				    IN uintn buffer_size)
 {
 	managed_buffer_t *managed_buffer;
+#if OPENSPDM_ARENA_MANAGED_BUFFER_SUPPORT == 1
+	return_status status;
+#endif
 
 	managed_buffer = m_buffer;
 
@@ -134,7 +240,19 @@ return_status append_managed_buffer(IN OUT void *m_buffer, IN void *buffer,
 	ASSERT(buffer_size <=
 	       managed_buffer->max_buffer_size - managed_buffer->buffer_size);
 
-	copy_mem((uint8 *)(managed_buffer + 1) + managed_buffer->buffer_size,
+#if OPENSPDM_ARENA_MANAGED_BUFFER_SUPPORT == 1
+	if (managed_buffer->arena != NULL) {
+		status = internal_grow_arena_managed_buffer(
+			managed_buffer,
+			managed_buffer->buffer_size + buffer_size);
+		if (RETURN_ERROR(status)) {
+			return status;
+		}
+	}
+#endif
+
+	copy_mem(internal_get_managed_buffer_data(managed_buffer) +
+			 managed_buffer->buffer_size,
 		 buffer, buffer_size);
 	managed_buffer->buffer_size += buffer_size;
 	return RETURN_SUCCESS;
@@ -177,7 +295,8 @@ return_status shrink_managed_buffer(IN OUT void *m_buffer, IN uintn buffer_size)
   Reset the managed buffer.
   The buffer_size is reset to 0.
   The max_buffer_size is unchanged.
-  The buffer is not freed.
+  The buffer is not freed, unless it is allocated from an arena.
+  Then it is returned to the arena.
 
   @param  managed_buffer_t                The managed buffer to be shrinked.
 **/
@@ -192,6 +311,20 @@ void reset_managed_buffer(IN OUT void *m_buffer)
 	       (managed_buffer->max_buffer_size ==
 		MAX_SPDM_MESSAGE_SMALL_BUFFER_SIZE));
 	managed_buffer->buffer_size = 0;
+#if OPENSPDM_ARENA_MANAGED_BUFFER_SUPPORT == 1
+	if (managed_buffer->arena != NULL) {
+		if (managed_buffer->arena_buffer != NULL) {
+			zero_mem(managed_buffer->arena_buffer,
+				 managed_buffer->arena_buffer_capacity);
+			managed_buffer->arena->free_func(
+				managed_buffer->arena->arena,
+				managed_buffer->arena_buffer);
+			managed_buffer->arena_buffer = NULL;
+			managed_buffer->arena_buffer_capacity = 0;
+		}
+		return;
+	}
+#endif
 	zero_mem(managed_buffer + 1, managed_buffer->max_buffer_size);
 }
 
@@ -232,7 +365,7 @@ void *get_managed_buffer(IN OUT void *m_buffer)
 		MAX_SPDM_MESSAGE_BUFFER_SIZE) ||
 	       (managed_buffer->max_buffer_size ==
 		MAX_SPDM_MESSAGE_SMALL_BUFFER_SIZE));
-	return (managed_buffer + 1);
+	return internal_get_managed_buffer_data(managed_buffer);
 }
 
 /**
@@ -251,5 +384,242 @@ void init_managed_buffer(IN OUT void *m_buffer, IN uintn max_buffer_size)
 	       (max_buffer_size == MAX_SPDM_MESSAGE_SMALL_BUFFER_SIZE));
 
 	managed_buffer->max_buffer_size = max_buffer_size;
+#if OPENSPDM_ARENA_MANAGED_BUFFER_SUPPORT == 1
+	managed_buffer->arena = NULL;
+	managed_buffer->arena_buffer_capacity = 0;
+	managed_buffer->arena_buffer = NULL;
+#endif
 	reset_managed_buffer(m_buffer);
-}
\ No newline at end of file
+}
+
+#if OPENSPDM_ARENA_MANAGED_BUFFER_SUPPORT == 1
+/**
+  Init the managed buffer whose data is allocated from an arena.
+
+  No data is allocated here. The data grows from the arena when it is appended,
+  and is returned to the arena when the managed buffer is reset.
+
+  @param  managed_buffer_t                The managed buffer.
+  @param  max_buffer_size                The maximum size in bytes of the managed buffer.
+  @param  arena                         The arena to allocate the data from.
+**/
+void init_arena_managed_buffer(IN OUT void *m_buffer,
+			       IN uintn max_buffer_size,
+			       IN spdm_arena_t *arena)
+{
+	managed_buffer_t *managed_buffer;
+
+	managed_buffer = m_buffer;
+
+	ASSERT((max_buffer_size == MAX_SPDM_MESSAGE_BUFFER_SIZE) ||
+	       (max_buffer_size == MAX_SPDM_MESSAGE_SMALL_BUFFER_SIZE));
+	ASSERT(arena != NULL);
+
+	managed_buffer->max_buffer_size = max_buffer_size;
+	managed_buffer->buffer_size = 0;
+	managed_buffer->arena = arena;
+	managed_buffer->arena_buffer_capacity = 0;
+	managed_buffer->arena_buffer = NULL;
+}
+
+/**
+  Allocate a request buffer of MAX_SPDM_MESSAGE_BUFFER_SIZE bytes from an arena on first use.
+
+  Nothing is allocated if the request buffer is already allocated.
+
+  @param  arena                         The arena to allocate the request buffer from.
+  @param  request_buffer                On input, the request buffer or NULL.
+                                       On output, the allocated request buffer.
+
+  @retval RETURN_SUCCESS               The request buffer is allocated.
+  @retval RETURN_OUT_OF_RESOURCES      No arena is registered, or the arena cannot allocate the buffer.
+**/
+return_status spdm_allocate_arena_request_buffer(IN spdm_arena_t *arena,
+						 IN OUT uint8 **request_buffer)
+{
+	if (*request_buffer != NULL) {
+		return RETURN_SUCCESS;
+	}
+	if ((arena->allocate_func == NULL) || (arena->free_func == NULL)) {
+		DEBUG((DEBUG_ERROR,
+		       "spdm_allocate_arena_request_buffer - no arena registered by spdm_register_arena_func\n"));
+		return RETURN_OUT_OF_RESOURCES;
+	}
+	*request_buffer = arena->allocate_func(arena->arena,
+					       MAX_SPDM_MESSAGE_BUFFER_SIZE);
+	if (*request_buffer == NULL) {
+		DEBUG((DEBUG_ERROR,
+		       "spdm_allocate_arena_request_buffer - arena allocate 0x%x fail\n",
+		       (uint32)MAX_SPDM_MESSAGE_BUFFER_SIZE));
+		return RETURN_OUT_OF_RESOURCES;
+	}
+	return RETURN_SUCCESS;
+}
+
+/**
+  Return a request buffer allocated by spdm_allocate_arena_request_buffer to the arena.
+
+  @param  arena                         The arena the request buffer is allocated from.
+  @param  request_buffer                On input, the request buffer or NULL.
+                                       On output, NULL.
+**/
+void spdm_free_arena_request_buffer(IN spdm_arena_t *arena,
+				    IN OUT uint8 **request_buffer)
+{
+	if (*request_buffer == NULL) {
+		return;
+	}
+	zero_mem(*request_buffer, MAX_SPDM_MESSAGE_BUFFER_SIZE);
+	arena->free_func(arena->arena, *request_buffer);
+	*request_buffer = NULL;
+}
+#endif
+
+/**
+  Get the timestamp from the function registered by spdm_register_get_timestamp_func.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+
+  @return The current timestamp, or 0 if no function is registered.
+**/
+uint64 spdm_statistics_get_timestamp(IN spdm_context_t *spdm_context)
+{
+	if (spdm_context->get_timestamp_func == 0) {
+		return 0;
+	}
+	return ((spdm_get_timestamp_func)spdm_context->get_timestamp_func)();
+}
+
+/**
+  Record one time sample in the time statistics.
+
+  @param  time_statistics               A pointer to the time statistics.
+  @param  elapsed_time                  The elapsed time of the sample.
+**/
+void spdm_statistics_record_time(IN OUT spdm_statistics_time_t *time_statistics,
+				 IN uint64 elapsed_time)
+{
+	uintn index;
+
+	for (index = 0; index < SPDM_STATISTICS_HISTOGRAM_BUCKET_COUNT - 1;
+	     index++) {
+		if (elapsed_time < ((uint64)16 << (2 * index))) {
+			break;
+		}
+	}
+	time_statistics->histogram[index]++;
+
+	if ((time_statistics->count == 0) ||
+	    (elapsed_time < time_statistics->min_time)) {
+		time_statistics->min_time = elapsed_time;
+	}
+	if (elapsed_time > time_statistics->max_time) {
+		time_statistics->max_time = elapsed_time;
+	}
+	time_statistics->total_time += elapsed_time;
+	time_statistics->count++;
+}
+
+/**
+  Record the time elapsed since start_time in the time statistics.
+
+  Nothing is recorded if no timestamp function is registered.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  time_statistics               A pointer to the time statistics.
+  @param  start_time                    The timestamp taken at the start.
+**/
+void spdm_statistics_record_elapsed_time(
+	IN spdm_context_t *spdm_context,
+	IN OUT spdm_statistics_time_t *time_statistics, IN uint64 start_time)
+{
+	if (spdm_context->get_timestamp_func == 0) {
+		return;
+	}
+	spdm_statistics_record_time(
+		time_statistics,
+		spdm_statistics_get_timestamp(spdm_context) - start_time);
+}
+
+//
+// The request codes with their own request statistics, in the order of their index.
+//
+static const uint8 m_spdm_statistics_request_code[] = {
+	SPDM_GET_DIGESTS,
+	SPDM_GET_CERTIFICATE,
+	SPDM_CHALLENGE,
+	SPDM_GET_VERSION,
+	SPDM_GET_MEASUREMENTS,
+	SPDM_GET_CAPABILITIES,
+	SPDM_NEGOTIATE_ALGORITHMS,
+	SPDM_KEY_EXCHANGE,
+	SPDM_FINISH,
+	SPDM_PSK_EXCHANGE,
+	SPDM_PSK_FINISH,
+	SPDM_HEARTBEAT,
+	SPDM_KEY_UPDATE,
+	SPDM_GET_ENCAPSULATED_REQUEST,
+	SPDM_DELIVER_ENCAPSULATED_RESPONSE,
+	SPDM_END_SESSION,
+	SPDM_VENDOR_DEFINED_REQUEST,
+	SPDM_RESPOND_IF_READY,
+};
+
+/**
+  Return the request statistics index of an SPDM request code.
+
+  @param  request_code                  The SPDM request code.
+
+  @return The index in the request statistics,
+          or SPDM_STATISTICS_REQUEST_CODE_INDEX_OTHER for an unknown request code.
+**/
+uintn spdm_get_statistics_request_code_index(IN uint8 request_code)
+{
+	uintn index;
+
+	ASSERT(ARRAY_SIZE(m_spdm_statistics_request_code) ==
+	       SPDM_STATISTICS_REQUEST_CODE_INDEX_OTHER);
+	for (index = 0; index < ARRAY_SIZE(m_spdm_statistics_request_code);
+	     index++) {
+		if (m_spdm_statistics_request_code[index] == request_code) {
+			return index;
+		}
+	}
+	return SPDM_STATISTICS_REQUEST_CODE_INDEX_OTHER;
+}
+
+#if OPENSPDM_RESPONDER_STATISTICS_SUPPORT == 1
+/**
+  Add the time of one signing to the statistics of the request being handled.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  sign_start_time               The timestamp taken before the signing.
+**/
+void spdm_statistics_add_sign_time(IN spdm_context_t *spdm_context,
+				   IN uint64 sign_start_time)
+{
+	spdm_context->statistics_sign_time +=
+		spdm_statistics_get_timestamp(spdm_context) - sign_start_time;
+	spdm_context->statistics_sign_count++;
+}
+#endif
+
+#if OPENSPDM_REQUESTER_STATISTICS_SUPPORT == 1
+/**
+  Record the time of one signature verification for the last sent request.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  verify_start_time             The timestamp taken before the verification.
+**/
+void spdm_statistics_add_verify_time(IN spdm_context_t *spdm_context,
+				     IN uint64 verify_start_time)
+{
+	spdm_statistics_record_elapsed_time(
+		spdm_context,
+		&spdm_context->requester_statistics
+			 .request[spdm_get_statistics_request_code_index(
+				 spdm_context->statistics_request_code)]
+			 .verify_time,
+		verify_start_time);
+}
+#endif
\ No newline at end of file
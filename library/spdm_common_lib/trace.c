@@ -0,0 +1,216 @@
+/**
+    Copyright Notice:
+    Copyright 2021 DMTF. All rights reserved.
+    License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+**/
+
+#include "spdm_common_lib_internal.h"
+
+#if (OPENSPDM_TRACE_SUPPORT == 1) && !defined(__GNUC__) && \
+	!defined(__clang__) && defined(_MSC_EXTENSIONS)
+#include <intrin.h>
+#endif
+
+/**
+  Return the size in bytes of a trace buffer.
+
+  @param  event_count                   The number of events the trace buffer holds.
+
+  @return the size in bytes of the trace buffer.
+**/
+uintn spdm_get_trace_buffer_size(IN uint32 event_count)
+{
+	return sizeof(spdm_trace_buffer_t) +
+	       sizeof(spdm_trace_event_t) * event_count;
+}
+
+/**
+  Initialize an empty trace buffer.
+
+  @param  trace_buffer                   A pointer to the trace buffer.
+  @param  event_count                   The number of events the trace buffer holds.
+  @param  flags                         The trace buffer flags (SPDM_TRACE_BUFFER_FLAG_*).
+**/
+void spdm_init_trace_buffer(IN void *trace_buffer, IN uint32 event_count,
+			    IN uint32 flags)
+{
+	spdm_trace_buffer_t *buffer;
+
+	ASSERT((event_count != 0) && ((event_count & (event_count - 1)) == 0));
+
+	buffer = trace_buffer;
+	zero_mem(buffer, spdm_get_trace_buffer_size(event_count));
+	buffer->signature = SPDM_TRACE_BUFFER_SIGNATURE;
+	buffer->version = SPDM_TRACE_BUFFER_VERSION;
+	buffer->event_size = sizeof(spdm_trace_event_t);
+	buffer->event_count = event_count;
+	buffer->flags = flags;
+}
+
+/**
+  Register a trace buffer to record the messages of an SPDM context.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  trace_buffer                   A pointer to the trace buffer, or NULL.
+**/
+void spdm_register_trace_buffer(IN void *context,
+				IN void *trace_buffer OPTIONAL)
+{
+	spdm_context_t *spdm_context;
+
+	spdm_context = context;
+	spdm_context->trace_buffer = trace_buffer;
+	return;
+}
+
+#if OPENSPDM_TRACE_SUPPORT == 1
+/**
+  Reserve the write index of an event in the trace buffer.
+
+  @param  trace_buffer                   A pointer to the trace buffer.
+
+  @return the reserved write index.
+**/
+static uint32 internal_spdm_trace_reserve(IN spdm_trace_buffer_t *trace_buffer)
+{
+#if defined(__GNUC__) || defined(__clang__)
+	return __atomic_fetch_add(&trace_buffer->write_index, 1,
+				  __ATOMIC_RELAXED);
+#elif defined(_MSC_EXTENSIONS)
+	return (uint32)_InterlockedIncrement(
+		       (volatile long *)&trace_buffer->write_index) -
+	       1;
+#else
+	//
+	// No atomic operation. The SPDM contexts sharing the trace buffer
+	// must not be used concurrently.
+	//
+	return trace_buffer->write_index++;
+#endif
+}
+
+/**
+  Claim the slot of an event in the trace buffer before the event is written.
+
+  The sequence of the slot is set to 0 before any other field of the event is written,
+  so that a reader never sees the old sequence with the new fields.
+
+  @param  event                         A pointer to the event.
+**/
+static void internal_spdm_trace_claim(IN spdm_trace_event_t *event)
+{
+#if defined(__GNUC__) || defined(__clang__)
+	__atomic_exchange_n(&event->sequence, 0, __ATOMIC_ACQUIRE);
+#elif defined(_MSC_EXTENSIONS)
+	_InterlockedExchange((volatile long *)&event->sequence, 0);
+#else
+	event->sequence = 0;
+#endif
+}
+
+/**
+  Publish an event written to the trace buffer.
+
+  When the ring laps while the event is written, a writer with a later write index claims
+  the same slot and the fields of both events are mixed. The writer that finds the sequence
+  of the slot changed after its claim leaves the slot invalid (sequence 0), and counts the
+  collision in the trace buffer.
+
+  @param  trace_buffer                   A pointer to the trace buffer.
+  @param  event                         A pointer to the event.
+  @param  sequence                      The sequence of the event.
+**/
+static void internal_spdm_trace_publish(IN spdm_trace_buffer_t *trace_buffer,
+					IN spdm_trace_event_t *event,
+					IN uint32 sequence)
+{
+#if defined(__GNUC__) || defined(__clang__)
+	uint32 expected;
+
+	expected = 0;
+	if (!__atomic_compare_exchange_n(&event->sequence, &expected, sequence,
+					 FALSE, __ATOMIC_RELEASE,
+					 __ATOMIC_RELAXED)) {
+		__atomic_store_n(&event->sequence, 0, __ATOMIC_RELAXED);
+		__atomic_fetch_add(&trace_buffer->collision_count, 1,
+				   __ATOMIC_RELAXED);
+	}
+#elif defined(_MSC_EXTENSIONS)
+	if (_InterlockedCompareExchange((volatile long *)&event->sequence,
+					sequence, 0) != 0) {
+		_InterlockedExchange((volatile long *)&event->sequence, 0);
+		_InterlockedIncrement(
+			(volatile long *)&trace_buffer->collision_count);
+	}
+#else
+	event->sequence = sequence;
+#endif
+}
+#endif
+
+/**
+  Record an SPDM or APP message in the trace buffer of an SPDM context.
+
+  If no trace buffer is registered, or OPENSPDM_TRACE_SUPPORT is 0,
+  the message is dumped in hex through DEBUG.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  event_type                    The trace event type (SPDM_TRACE_EVENT_*).
+  @param  session_id                    The session ID of a secured message, or NULL.
+  @param  is_app_message                 Indicates if it is an APP message or SPDM message.
+  @param  message                       A pointer to the message.
+  @param  message_size                  size in bytes of the message.
+**/
+void spdm_trace_message(IN spdm_context_t *spdm_context, IN uint8 event_type,
+			IN uint32 *session_id OPTIONAL,
+			IN boolean is_app_message, IN void *message,
+			IN uintn message_size)
+{
+#if OPENSPDM_TRACE_SUPPORT == 1
+	spdm_trace_buffer_t *trace_buffer;
+	spdm_trace_event_t *event;
+	spdm_message_header_t *spdm_message;
+	uint32 index;
+
+	trace_buffer = spdm_context->trace_buffer;
+	if (trace_buffer == NULL) {
+		internal_dump_hex(message, message_size);
+		return;
+	}
+
+	index = internal_spdm_trace_reserve(trace_buffer);
+	event = (spdm_trace_event_t *)(trace_buffer + 1) +
+		(index & (trace_buffer->event_count - 1));
+
+	internal_spdm_trace_claim(event);
+	event->event_type = event_type;
+	event->flags = 0;
+	event->opcode = 0;
+	event->param1 = 0;
+	event->session_id = 0;
+	if (is_app_message) {
+		event->flags |= SPDM_TRACE_EVENT_FLAG_APP_MESSAGE;
+	} else if (message_size >= sizeof(spdm_message_header_t)) {
+		spdm_message = message;
+		event->opcode = spdm_message->request_response_code;
+		event->param1 = spdm_message->param1;
+	}
+	if (session_id != NULL) {
+		event->flags |= SPDM_TRACE_EVENT_FLAG_SESSION_ID_VALID;
+		event->session_id = *session_id;
+	}
+	event->message_size = (uint32)message_size;
+	event->timestamp = spdm_statistics_get_timestamp(spdm_context);
+	event->spdm_context = (uint64)(uintn)spdm_context;
+	if ((trace_buffer->flags &
+	     SPDM_TRACE_BUFFER_FLAG_RECORD_MESSAGE_POINTER) != 0) {
+		event->message = (uint64)(uintn)message;
+	} else {
+		event->message = 0;
+	}
+
+	internal_spdm_trace_publish(trace_buffer, event, index + 1);
+#else
+	internal_dump_hex(message, message_size);
+#endif
+}
\ No newline at end of file
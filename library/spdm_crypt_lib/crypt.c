@@ -120,66 +120,776 @@ boolean spdm_hash_all(IN uint32 base_hash_algo, IN const void *data,
 	return hash_function(data, data_size, hash_value);
 }
 
+/**
+  Return hash NEW function, based upon the negotiated hash algorithm.
+
+  @param  base_hash_algo                  SPDM base_hash_algo
+
+  @return hash NEW function
+**/
+hash_new_func get_spdm_hash_new_func(IN uint32 base_hash_algo)
+{
+	switch (base_hash_algo) {
+	case SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_256:
+#if OPENSPDM_SHA256_SUPPORT == 1
+		return sha256_new;
+#else
+		ASSERT(FALSE);
+		break;
+#endif
+	case SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_384:
+#if OPENSPDM_SHA384_SUPPORT == 1
+		return sha384_new;
+#else
+		ASSERT(FALSE);
+		break;
+#endif
+	case SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_512:
+#if OPENSPDM_SHA512_SUPPORT == 1
+		return sha512_new;
+#else
+		ASSERT(FALSE);
+		break;
+#endif
+	case SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA3_256:
+	case SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA3_384:
+	case SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA3_512:
+		ASSERT(FALSE);
+		break;
+	}
+	ASSERT(FALSE);
+	return NULL;
+}
+
+/**
+  Allocates and initializes one HASH_CTX context for subsequent hash use, based upon the negotiated hash algorithm.
+
+  @param  base_hash_algo                 SPDM base_hash_algo
+
+  @return  Pointer to the HASH_CTX context that has been initialized.
+           If the allocations fails, spdm_hash_new() returns NULL.
+**/
+void *spdm_hash_new(IN uint32 base_hash_algo)
+{
+	hash_new_func hash_function;
+	hash_function = get_spdm_hash_new_func(base_hash_algo);
+	if (hash_function == NULL) {
+		return NULL;
+	}
+	return hash_function();
+}
+
+/**
+  Return hash FREE function, based upon the negotiated hash algorithm.
+
+  @param  base_hash_algo                  SPDM base_hash_algo
+
+  @return hash FREE function
+**/
+hash_free_func get_spdm_hash_free_func(IN uint32 base_hash_algo)
+{
+	switch (base_hash_algo) {
+	case SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_256:
+#if OPENSPDM_SHA256_SUPPORT == 1
+		return sha256_free;
+#else
+		ASSERT(FALSE);
+		break;
+#endif
+	case SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_384:
+#if OPENSPDM_SHA384_SUPPORT == 1
+		return sha384_free;
+#else
+		ASSERT(FALSE);
+		break;
+#endif
+	case SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_512:
+#if OPENSPDM_SHA512_SUPPORT == 1
+		return sha512_free;
+#else
+		ASSERT(FALSE);
+		break;
+#endif
+	case SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA3_256:
+	case SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA3_384:
+	case SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA3_512:
+		ASSERT(FALSE);
+		break;
+	}
+	ASSERT(FALSE);
+	return NULL;
+}
+
+/**
+  Release the specified HASH_CTX context, based upon the negotiated hash algorithm.
+
+  @param  base_hash_algo                 SPDM base_hash_algo
+  @param  hash_context                   Pointer to the HASH_CTX context to be released.
+**/
+void spdm_hash_free(IN uint32 base_hash_algo, IN void *hash_context)
+{
+	hash_free_func hash_function;
+	hash_function = get_spdm_hash_free_func(base_hash_algo);
+	if (hash_function == NULL) {
+		return;
+	}
+	hash_function(hash_context);
+}
+
+/**
+  Return hash INIT function, based upon the negotiated hash algorithm.
+
+  @param  base_hash_algo                  SPDM base_hash_algo
+
+  @return hash INIT function
+**/
+hash_init_func get_spdm_hash_init_func(IN uint32 base_hash_algo)
+{
+	switch (base_hash_algo) {
+	case SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_256:
+#if OPENSPDM_SHA256_SUPPORT == 1
+		return sha256_init;
+#else
+		ASSERT(FALSE);
+		break;
+#endif
+	case SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_384:
+#if OPENSPDM_SHA384_SUPPORT == 1
+		return sha384_init;
+#else
+		ASSERT(FALSE);
+		break;
+#endif
+	case SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_512:
+#if OPENSPDM_SHA512_SUPPORT == 1
+		return sha512_init;
+#else
+		ASSERT(FALSE);
+		break;
+#endif
+	case SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA3_256:
+	case SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA3_384:
+	case SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA3_512:
+		ASSERT(FALSE);
+		break;
+	}
+	ASSERT(FALSE);
+	return NULL;
+}
+
+/**
+  Initializes user-supplied memory pointed by hash_context as hash context for
+  subsequent use, based upon the negotiated hash algorithm.
+
+  @param  base_hash_algo                 SPDM base_hash_algo
+  @param  hash_context                   Pointer to hash context being initialized.
+
+  @retval TRUE   hash context initialization succeeded.
+  @retval FALSE  hash context initialization failed.
+**/
+boolean spdm_hash_init(IN uint32 base_hash_algo, OUT void *hash_context)
+{
+	hash_init_func hash_function;
+	hash_function = get_spdm_hash_init_func(base_hash_algo);
+	if (hash_function == NULL) {
+		return FALSE;
+	}
+	return hash_function(hash_context);
+}
+
+/**
+  Return hash DUPLICATE function, based upon the negotiated hash algorithm.
+
+  @param  base_hash_algo                  SPDM base_hash_algo
+
+  @return hash DUPLICATE function
+**/
+hash_duplicate_func get_spdm_hash_duplicate_func(IN uint32 base_hash_algo)
+{
+	switch (base_hash_algo) {
+	case SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_256:
+#if OPENSPDM_SHA256_SUPPORT == 1
+		return sha256_duplicate;
+#else
+		ASSERT(FALSE);
+		break;
+#endif
+	case SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_384:
+#if OPENSPDM_SHA384_SUPPORT == 1
+		return sha384_duplicate;
+#else
+		ASSERT(FALSE);
+		break;
+#endif
+	case SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_512:
+#if OPENSPDM_SHA512_SUPPORT == 1
+		return sha512_duplicate;
+#else
+		ASSERT(FALSE);
+		break;
+#endif
+	case SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA3_256:
+	case SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA3_384:
+	case SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA3_512:
+		ASSERT(FALSE);
+		break;
+	}
+	ASSERT(FALSE);
+	return NULL;
+}
+
+/**
+  Makes a copy of an existing hash context, based upon the negotiated hash algorithm.
+
+  @param  base_hash_algo                 SPDM base_hash_algo
+  @param  hash_context                   Pointer to hash context being copied.
+  @param  new_hash_context               Pointer to new hash context.
+
+  @retval TRUE   hash context copy succeeded.
+  @retval FALSE  hash context copy failed.
+**/
+boolean spdm_hash_duplicate(IN uint32 base_hash_algo,
+			    IN const void *hash_context,
+			    OUT void *new_hash_context)
+{
+	hash_duplicate_func hash_function;
+	hash_function = get_spdm_hash_duplicate_func(base_hash_algo);
+	if (hash_function == NULL) {
+		return FALSE;
+	}
+	return hash_function(hash_context, new_hash_context);
+}
+
+/**
+  Return hash UPDATE function, based upon the negotiated hash algorithm.
+
+  @param  base_hash_algo                  SPDM base_hash_algo
+
+  @return hash UPDATE function
+**/
+hash_update_func get_spdm_hash_update_func(IN uint32 base_hash_algo)
+{
+	switch (base_hash_algo) {
+	case SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_256:
+#if OPENSPDM_SHA256_SUPPORT == 1
+		return sha256_update;
+#else
+		ASSERT(FALSE);
+		break;
+#endif
+	case SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_384:
+#if OPENSPDM_SHA384_SUPPORT == 1
+		return sha384_update;
+#else
+		ASSERT(FALSE);
+		break;
+#endif
+	case SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_512:
+#if OPENSPDM_SHA512_SUPPORT == 1
+		return sha512_update;
+#else
+		ASSERT(FALSE);
+		break;
+#endif
+	case SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA3_256:
+	case SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA3_384:
+	case SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA3_512:
+		ASSERT(FALSE);
+		break;
+	}
+	ASSERT(FALSE);
+	return NULL;
+}
+
+/**
+  Digests the input data and updates hash context, based upon the negotiated hash algorithm.
+
+  This function can be called multiple times to compute the digest of long or discontinuous data streams.
+
+  @param  base_hash_algo                 SPDM base_hash_algo
+  @param  hash_context                   Pointer to the hash context.
+  @param  data                         Pointer to the buffer containing the data to be hashed.
+  @param  data_size                     size of data buffer in bytes.
+
+  @retval TRUE   hash data digest succeeded.
+  @retval FALSE  hash data digest failed.
+**/
+boolean spdm_hash_update(IN uint32 base_hash_algo, IN OUT void *hash_context,
+			 IN const void *data, IN uintn data_size)
+{
+	hash_update_func hash_function;
+	hash_function = get_spdm_hash_update_func(base_hash_algo);
+	if (hash_function == NULL) {
+		return FALSE;
+	}
+	return hash_function(hash_context, data, data_size);
+}
+
+/**
+  Return hash FINAL function, based upon the negotiated hash algorithm.
+
+  @param  base_hash_algo                  SPDM base_hash_algo
+
+  @return hash FINAL function
+**/
+hash_final_func get_spdm_hash_final_func(IN uint32 base_hash_algo)
+{
+	switch (base_hash_algo) {
+	case SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_256:
+#if OPENSPDM_SHA256_SUPPORT == 1
+		return sha256_final;
+#else
+		ASSERT(FALSE);
+		break;
+#endif
+	case SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_384:
+#if OPENSPDM_SHA384_SUPPORT == 1
+		return sha384_final;
+#else
+		ASSERT(FALSE);
+		break;
+#endif
+	case SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_512:
+#if OPENSPDM_SHA512_SUPPORT == 1
+		return sha512_final;
+#else
+		ASSERT(FALSE);
+		break;
+#endif
+	case SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA3_256:
+	case SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA3_384:
+	case SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA3_512:
+		ASSERT(FALSE);
+		break;
+	}
+	ASSERT(FALSE);
+	return NULL;
+}
+
+/**
+  Completes computation of the hash digest value, based upon the negotiated hash algorithm.
+
+  The hash context cannot be used for further update after this call.
+
+  @param  base_hash_algo                 SPDM base_hash_algo
+  @param  hash_context                   Pointer to the hash context.
+  @param  hash_value                    Pointer to a buffer that receives the hash value.
+
+  @retval TRUE   hash digest computation succeeded.
+  @retval FALSE  hash digest computation failed.
+**/
+boolean spdm_hash_final(IN uint32 base_hash_algo, IN OUT void *hash_context,
+			OUT uint8 *hash_value)
+{
+	hash_final_func hash_function;
+	hash_function = get_spdm_hash_final_func(base_hash_algo);
+	if (hash_function == NULL) {
+		return FALSE;
+	}
+	return hash_function(hash_context, hash_value);
+}
+
+/**
+  Computes the hash of a list of discontinuous data buffers, based upon the negotiated hash algorithm.
+
+  @param  base_hash_algo                 SPDM base_hash_algo
+  @param  iov                          Pointer to the array of data buffers to be hashed, in order.
+  @param  iov_count                     Number of elements in iov.
+  @param  hash_value                    Pointer to a buffer that receives the hash value.
+
+  @retval TRUE   hash computation succeeded.
+  @retval FALSE  hash computation failed.
+**/
+boolean spdm_hash_multi(IN uint32 base_hash_algo, IN const spdm_iovec_t *iov,
+			IN uintn iov_count, OUT uint8 *hash_value)
+{
+	void *hash_context;
+	uintn index;
+	boolean result;
+
+	if (iov_count == 1) {
+		return spdm_hash_all(base_hash_algo, iov[0].data,
+				     iov[0].data_size, hash_value);
+	}
+
+	hash_context = spdm_hash_new(base_hash_algo);
+	if (hash_context == NULL) {
+		return FALSE;
+	}
+	result = spdm_hash_init(base_hash_algo, hash_context);
+	for (index = 0; result && (index < iov_count); index++) {
+		if (iov[index].data_size == 0) {
+			continue;
+		}
+		result = spdm_hash_update(base_hash_algo, hash_context,
+					  iov[index].data, iov[index].data_size);
+	}
+	if (result) {
+		result = spdm_hash_final(base_hash_algo, hash_context,
+					 hash_value);
+	}
+	spdm_hash_free(base_hash_algo, hash_context);
+	return result;
+}
+
 /**
   This function returns the SPDM measurement hash algorithm size.
 
   @param  measurement_hash_algo          SPDM measurement_hash_algo
 
-  @return SPDM measurement hash algorithm size.
-  @return 0xFFFFFFFF for RAW_BIT_STREAM_ONLY.
+  @return SPDM measurement hash algorithm size.
+  @return 0xFFFFFFFF for RAW_BIT_STREAM_ONLY.
+**/
+uint32 spdm_get_measurement_hash_size(IN uint32 measurement_hash_algo)
+{
+	switch (measurement_hash_algo) {
+	case SPDM_ALGORITHMS_MEASUREMENT_HASH_ALGO_TPM_ALG_SHA_256:
+	case SPDM_ALGORITHMS_MEASUREMENT_HASH_ALGO_TPM_ALG_SHA3_256:
+		return 32;
+	case SPDM_ALGORITHMS_MEASUREMENT_HASH_ALGO_TPM_ALG_SHA_384:
+	case SPDM_ALGORITHMS_MEASUREMENT_HASH_ALGO_TPM_ALG_SHA3_384:
+		return 48;
+	case SPDM_ALGORITHMS_MEASUREMENT_HASH_ALGO_TPM_ALG_SHA_512:
+	case SPDM_ALGORITHMS_MEASUREMENT_HASH_ALGO_TPM_ALG_SHA3_512:
+		return 64;
+	case SPDM_ALGORITHMS_MEASUREMENT_HASH_ALGO_RAW_BIT_STREAM_ONLY:
+		return 0xFFFFFFFF;
+	}
+	return 0;
+}
+
+/**
+  Return hash function, based upon the negotiated measurement hash algorithm.
+
+  @param  measurement_hash_algo          SPDM measurement_hash_algo
+
+  @return hash function
+**/
+hash_all_func get_spdm_measurement_hash_func(IN uint32 measurement_hash_algo)
+{
+	switch (measurement_hash_algo) {
+	case SPDM_ALGORITHMS_MEASUREMENT_HASH_ALGO_TPM_ALG_SHA_256:
+#if OPENSPDM_SHA256_SUPPORT == 1
+		return sha256_hash_all;
+#else
+		ASSERT(FALSE);
+		break;
+#endif
+	case SPDM_ALGORITHMS_MEASUREMENT_HASH_ALGO_TPM_ALG_SHA_384:
+#if OPENSPDM_SHA384_SUPPORT == 1
+		return sha384_hash_all;
+#else
+		ASSERT(FALSE);
+		break;
+#endif
+	case SPDM_ALGORITHMS_MEASUREMENT_HASH_ALGO_TPM_ALG_SHA_512:
+#if OPENSPDM_SHA512_SUPPORT == 1
+		return sha512_hash_all;
+#else
+		ASSERT(FALSE);
+		break;
+#endif
+	case SPDM_ALGORITHMS_MEASUREMENT_HASH_ALGO_TPM_ALG_SHA3_256:
+	case SPDM_ALGORITHMS_MEASUREMENT_HASH_ALGO_TPM_ALG_SHA3_384:
+	case SPDM_ALGORITHMS_MEASUREMENT_HASH_ALGO_TPM_ALG_SHA3_512:
+		ASSERT(FALSE);
+		break;
+	}
+	ASSERT(FALSE);
+	return NULL;
+}
+
+/**
+  Computes the hash of a input data buffer, based upon the negotiated measurement hash algorithm.
+
+  This function performs the hash of a given data buffer, and return the hash value.
+
+  @param  measurement_hash_algo          SPDM measurement_hash_algo
+  @param  data                         Pointer to the buffer containing the data to be hashed.
+  @param  data_size                     size of data buffer in bytes.
+  @param  hash_value                    Pointer to a buffer that receives the hash value.
+
+  @retval TRUE   hash computation succeeded.
+  @retval FALSE  hash computation failed.
 **/
-uint32 spdm_get_measurement_hash_size(IN uint32 measurement_hash_algo)
+boolean spdm_measurement_hash_all(IN uint32 measurement_hash_algo,
+				  IN const void *data, IN uintn data_size,
+				  OUT uint8 *hash_value)
 {
-	switch (measurement_hash_algo) {
-	case SPDM_ALGORITHMS_MEASUREMENT_HASH_ALGO_TPM_ALG_SHA_256:
-	case SPDM_ALGORITHMS_MEASUREMENT_HASH_ALGO_TPM_ALG_SHA3_256:
-		return 32;
-	case SPDM_ALGORITHMS_MEASUREMENT_HASH_ALGO_TPM_ALG_SHA_384:
-	case SPDM_ALGORITHMS_MEASUREMENT_HASH_ALGO_TPM_ALG_SHA3_384:
-		return 48;
-	case SPDM_ALGORITHMS_MEASUREMENT_HASH_ALGO_TPM_ALG_SHA_512:
-	case SPDM_ALGORITHMS_MEASUREMENT_HASH_ALGO_TPM_ALG_SHA3_512:
-		return 64;
-	case SPDM_ALGORITHMS_MEASUREMENT_HASH_ALGO_RAW_BIT_STREAM_ONLY:
-		return 0xFFFFFFFF;
+	hash_all_func hash_function;
+	hash_function = get_spdm_measurement_hash_func(measurement_hash_algo);
+	if (hash_function == NULL) {
+		return FALSE;
+	}
+	return hash_function(data, data_size, hash_value);
+}
+
+/**
+  Return HMAC function, based upon the negotiated HMAC algorithm.
+
+  @param  base_hash_algo                 SPDM base_hash_algo
+
+  @return HMAC function
+**/
+hmac_all_func get_spdm_hmac_func(IN uint32 base_hash_algo)
+{
+	switch (base_hash_algo) {
+	case SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_256:
+#if OPENSPDM_SHA256_SUPPORT == 1
+		return hmac_sha256_all;
+#else
+		ASSERT(FALSE);
+		break;
+#endif
+	case SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_384:
+#if OPENSPDM_SHA384_SUPPORT == 1
+		return hmac_sha384_all;
+#else
+		ASSERT(FALSE);
+		break;
+#endif
+	case SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_512:
+#if OPENSPDM_SHA512_SUPPORT == 1
+		return hmac_sha512_all;
+#else
+		ASSERT(FALSE);
+		break;
+#endif
+	case SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA3_256:
+	case SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA3_384:
+	case SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA3_512:
+		ASSERT(FALSE);
+		break;
+	}
+	ASSERT(FALSE);
+	return NULL;
+}
+
+/**
+  Computes the HMAC of a input data buffer, based upon the negotiated HMAC algorithm.
+
+  This function performs the HMAC of a given data buffer, and return the hash value.
+
+  @param  base_hash_algo                 SPDM base_hash_algo
+  @param  data                         Pointer to the buffer containing the data to be HMACed.
+  @param  data_size                     size of data buffer in bytes.
+  @param  key                          Pointer to the user-supplied key.
+  @param  key_size                      key size in bytes.
+  @param  hash_value                    Pointer to a buffer that receives the HMAC value.
+
+  @retval TRUE   HMAC computation succeeded.
+  @retval FALSE  HMAC computation failed.
+**/
+boolean spdm_hmac_all(IN uint32 base_hash_algo, IN const void *data,
+		      IN uintn data_size, IN const uint8 *key,
+		      IN uintn key_size, OUT uint8 *hmac_value)
+{
+	hmac_all_func hmac_function;
+	hmac_function = get_spdm_hmac_func(base_hash_algo);
+	if (hmac_function == NULL) {
+		return FALSE;
+	}
+	return hmac_function(data, data_size, key, key_size, hmac_value);
+}
+
+/**
+  Return HMAC NEW function, based upon the negotiated HMAC algorithm.
+
+  @param  base_hash_algo                 SPDM base_hash_algo
+
+  @return HMAC NEW function
+**/
+hmac_new_func get_spdm_hmac_new_func(IN uint32 base_hash_algo)
+{
+	switch (base_hash_algo) {
+	case SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_256:
+#if OPENSPDM_SHA256_SUPPORT == 1
+		return hmac_sha256_new;
+#else
+		ASSERT(FALSE);
+		break;
+#endif
+	case SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_384:
+#if OPENSPDM_SHA384_SUPPORT == 1
+		return hmac_sha384_new;
+#else
+		ASSERT(FALSE);
+		break;
+#endif
+	case SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_512:
+#if OPENSPDM_SHA512_SUPPORT == 1
+		return hmac_sha512_new;
+#else
+		ASSERT(FALSE);
+		break;
+#endif
+	case SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA3_256:
+	case SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA3_384:
+	case SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA3_512:
+		ASSERT(FALSE);
+		break;
+	}
+	ASSERT(FALSE);
+	return NULL;
+}
+
+/**
+  Return HMAC FREE function, based upon the negotiated HMAC algorithm.
+
+  @param  base_hash_algo                 SPDM base_hash_algo
+
+  @return HMAC FREE function
+**/
+hmac_free_func get_spdm_hmac_free_func(IN uint32 base_hash_algo)
+{
+	switch (base_hash_algo) {
+	case SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_256:
+#if OPENSPDM_SHA256_SUPPORT == 1
+		return hmac_sha256_free;
+#else
+		ASSERT(FALSE);
+		break;
+#endif
+	case SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_384:
+#if OPENSPDM_SHA384_SUPPORT == 1
+		return hmac_sha384_free;
+#else
+		ASSERT(FALSE);
+		break;
+#endif
+	case SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_512:
+#if OPENSPDM_SHA512_SUPPORT == 1
+		return hmac_sha512_free;
+#else
+		ASSERT(FALSE);
+		break;
+#endif
+	case SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA3_256:
+	case SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA3_384:
+	case SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA3_512:
+		ASSERT(FALSE);
+		break;
+	}
+	ASSERT(FALSE);
+	return NULL;
+}
+
+/**
+  Return HMAC SET_KEY function, based upon the negotiated HMAC algorithm.
+
+  @param  base_hash_algo                 SPDM base_hash_algo
+
+  @return HMAC SET_KEY function
+**/
+hmac_set_key_func get_spdm_hmac_set_key_func(IN uint32 base_hash_algo)
+{
+	switch (base_hash_algo) {
+	case SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_256:
+#if OPENSPDM_SHA256_SUPPORT == 1
+		return hmac_sha256_set_key;
+#else
+		ASSERT(FALSE);
+		break;
+#endif
+	case SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_384:
+#if OPENSPDM_SHA384_SUPPORT == 1
+		return hmac_sha384_set_key;
+#else
+		ASSERT(FALSE);
+		break;
+#endif
+	case SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_512:
+#if OPENSPDM_SHA512_SUPPORT == 1
+		return hmac_sha512_set_key;
+#else
+		ASSERT(FALSE);
+		break;
+#endif
+	case SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA3_256:
+	case SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA3_384:
+	case SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA3_512:
+		ASSERT(FALSE);
+		break;
+	}
+	ASSERT(FALSE);
+	return NULL;
+}
+
+/**
+  Return HMAC UPDATE function, based upon the negotiated HMAC algorithm.
+
+  @param  base_hash_algo                 SPDM base_hash_algo
+
+  @return HMAC UPDATE function
+**/
+hmac_update_func get_spdm_hmac_update_func(IN uint32 base_hash_algo)
+{
+	switch (base_hash_algo) {
+	case SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_256:
+#if OPENSPDM_SHA256_SUPPORT == 1
+		return hmac_sha256_update;
+#else
+		ASSERT(FALSE);
+		break;
+#endif
+	case SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_384:
+#if OPENSPDM_SHA384_SUPPORT == 1
+		return hmac_sha384_update;
+#else
+		ASSERT(FALSE);
+		break;
+#endif
+	case SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_512:
+#if OPENSPDM_SHA512_SUPPORT == 1
+		return hmac_sha512_update;
+#else
+		ASSERT(FALSE);
+		break;
+#endif
+	case SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA3_256:
+	case SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA3_384:
+	case SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA3_512:
+		ASSERT(FALSE);
+		break;
 	}
-	return 0;
+	ASSERT(FALSE);
+	return NULL;
 }
 
 /**
-  Return hash function, based upon the negotiated measurement hash algorithm.
+  Return HMAC FINAL function, based upon the negotiated HMAC algorithm.
 
-  @param  measurement_hash_algo          SPDM measurement_hash_algo
+  @param  base_hash_algo                 SPDM base_hash_algo
 
-  @return hash function
+  @return HMAC FINAL function
 **/
-hash_all_func get_spdm_measurement_hash_func(IN uint32 measurement_hash_algo)
+hmac_final_func get_spdm_hmac_final_func(IN uint32 base_hash_algo)
 {
-	switch (measurement_hash_algo) {
-	case SPDM_ALGORITHMS_MEASUREMENT_HASH_ALGO_TPM_ALG_SHA_256:
+	switch (base_hash_algo) {
+	case SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_256:
 #if OPENSPDM_SHA256_SUPPORT == 1
-		return sha256_hash_all;
+		return hmac_sha256_final;
 #else
 		ASSERT(FALSE);
 		break;
 #endif
-	case SPDM_ALGORITHMS_MEASUREMENT_HASH_ALGO_TPM_ALG_SHA_384:
+	case SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_384:
 #if OPENSPDM_SHA384_SUPPORT == 1
-		return sha384_hash_all;
+		return hmac_sha384_final;
 #else
 		ASSERT(FALSE);
 		break;
 #endif
-	case SPDM_ALGORITHMS_MEASUREMENT_HASH_ALGO_TPM_ALG_SHA_512:
+	case SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_512:
 #if OPENSPDM_SHA512_SUPPORT == 1
-		return sha512_hash_all;
+		return hmac_sha512_final;
 #else
 		ASSERT(FALSE);
 		break;
 #endif
-	case SPDM_ALGORITHMS_MEASUREMENT_HASH_ALGO_TPM_ALG_SHA3_256:
-	case SPDM_ALGORITHMS_MEASUREMENT_HASH_ALGO_TPM_ALG_SHA3_384:
-	case SPDM_ALGORITHMS_MEASUREMENT_HASH_ALGO_TPM_ALG_SHA3_512:
+	case SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA3_256:
+	case SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA3_384:
+	case SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA3_512:
 		ASSERT(FALSE);
 		break;
 	}
@@ -188,57 +898,32 @@ hash_all_func get_spdm_measurement_hash_func(IN uint32 measurement_hash_algo)
 }
 
 /**
-  Computes the hash of a input data buffer, based upon the negotiated measurement hash algorithm.
-
-  This function performs the hash of a given data buffer, and return the hash value.
-
-  @param  measurement_hash_algo          SPDM measurement_hash_algo
-  @param  data                         Pointer to the buffer containing the data to be hashed.
-  @param  data_size                     size of data buffer in bytes.
-  @param  hash_value                    Pointer to a buffer that receives the hash value.
-
-  @retval TRUE   hash computation succeeded.
-  @retval FALSE  hash computation failed.
-**/
-boolean spdm_measurement_hash_all(IN uint32 measurement_hash_algo,
-				  IN const void *data, IN uintn data_size,
-				  OUT uint8 *hash_value)
-{
-	hash_all_func hash_function;
-	hash_function = get_spdm_measurement_hash_func(measurement_hash_algo);
-	if (hash_function == NULL) {
-		return FALSE;
-	}
-	return hash_function(data, data_size, hash_value);
-}
-
-/**
-  Return HMAC function, based upon the negotiated HMAC algorithm.
+  Return HMAC DUPLICATE function, based upon the negotiated HMAC algorithm.
 
   @param  base_hash_algo                 SPDM base_hash_algo
 
-  @return HMAC function
+  @return HMAC DUPLICATE function
 **/
-hmac_all_func get_spdm_hmac_func(IN uint32 base_hash_algo)
+hmac_duplicate_func get_spdm_hmac_duplicate_func(IN uint32 base_hash_algo)
 {
 	switch (base_hash_algo) {
 	case SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_256:
 #if OPENSPDM_SHA256_SUPPORT == 1
-		return hmac_sha256_all;
+		return hmac_sha256_duplicate;
 #else
 		ASSERT(FALSE);
 		break;
 #endif
 	case SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_384:
 #if OPENSPDM_SHA384_SUPPORT == 1
-		return hmac_sha384_all;
+		return hmac_sha384_duplicate;
 #else
 		ASSERT(FALSE);
 		break;
 #endif
 	case SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_512:
 #if OPENSPDM_SHA512_SUPPORT == 1
-		return hmac_sha512_all;
+		return hmac_sha512_duplicate;
 #else
 		ASSERT(FALSE);
 		break;
@@ -254,30 +939,214 @@ hmac_all_func get_spdm_hmac_func(IN uint32 base_hash_algo)
 }
 
 /**
-  Computes the HMAC of a input data buffer, based upon the negotiated HMAC algorithm.
+  Computes the HMAC of a list of discontinuous data buffers, based upon the negotiated HMAC algorithm.
 
-  This function performs the HMAC of a given data buffer, and return the hash value.
+  @param  base_hash_algo                 SPDM base_hash_algo
+  @param  iov                          Pointer to the array of data buffers to be HMACed, in order.
+  @param  iov_count                     Number of elements in iov.
+  @param  key                          Pointer to the user-supplied key.
+  @param  key_size                      key size in bytes.
+  @param  hmac_value                    Pointer to a buffer that receives the HMAC value.
+
+  @retval TRUE   HMAC computation succeeded.
+  @retval FALSE  HMAC computation failed.
+**/
+boolean spdm_hmac_multi(IN uint32 base_hash_algo, IN const spdm_iovec_t *iov,
+			IN uintn iov_count, IN const uint8 *key,
+			IN uintn key_size, OUT uint8 *hmac_value)
+{
+	hmac_new_func hmac_new_function;
+	hmac_free_func hmac_free_function;
+	hmac_set_key_func hmac_set_key_function;
+	hmac_update_func hmac_update_function;
+	hmac_final_func hmac_final_function;
+	void *hmac_context;
+	uintn index;
+	boolean result;
+
+	if (iov_count == 1) {
+		return spdm_hmac_all(base_hash_algo, iov[0].data,
+				     iov[0].data_size, key, key_size,
+				     hmac_value);
+	}
+
+	hmac_new_function = get_spdm_hmac_new_func(base_hash_algo);
+	hmac_free_function = get_spdm_hmac_free_func(base_hash_algo);
+	hmac_set_key_function = get_spdm_hmac_set_key_func(base_hash_algo);
+	hmac_update_function = get_spdm_hmac_update_func(base_hash_algo);
+	hmac_final_function = get_spdm_hmac_final_func(base_hash_algo);
+	if ((hmac_new_function == NULL) || (hmac_free_function == NULL) ||
+	    (hmac_set_key_function == NULL) || (hmac_update_function == NULL) ||
+	    (hmac_final_function == NULL)) {
+		return FALSE;
+	}
+
+	hmac_context = hmac_new_function();
+	if (hmac_context == NULL) {
+		return FALSE;
+	}
+	result = hmac_set_key_function(hmac_context, key, key_size);
+	for (index = 0; result && (index < iov_count); index++) {
+		if (iov[index].data_size == 0) {
+			continue;
+		}
+		result = hmac_update_function(hmac_context, iov[index].data,
+					      iov[index].data_size);
+	}
+	if (result) {
+		result = hmac_final_function(hmac_context, hmac_value);
+	}
+	hmac_free_function(hmac_context);
+	return result;
+}
+
+/**
+  Allocates one HMAC context and sets the key, based upon the negotiated HMAC algorithm.
+
+  The returned keyed HMAC context holds the inner and outer padded key state,
+  so one secret used for several HMAC or HKDF-Expand operations pays the
+  key setup once.
 
   @param  base_hash_algo                 SPDM base_hash_algo
-  @param  data                         Pointer to the buffer containing the data to be HMACed.
-  @param  data_size                     size of data buffer in bytes.
   @param  key                          Pointer to the user-supplied key.
   @param  key_size                      key size in bytes.
-  @param  hash_value                    Pointer to a buffer that receives the HMAC value.
+
+  @return  Pointer to the keyed HMAC context.
+           If the allocation or the key setup fails, NULL is returned.
+**/
+void *spdm_hmac_new_with_key(IN uint32 base_hash_algo, IN const uint8 *key,
+			     IN uintn key_size)
+{
+	hmac_new_func hmac_new_function;
+	hmac_free_func hmac_free_function;
+	hmac_set_key_func hmac_set_key_function;
+	void *hmac_key_context;
+
+	hmac_new_function = get_spdm_hmac_new_func(base_hash_algo);
+	hmac_free_function = get_spdm_hmac_free_func(base_hash_algo);
+	hmac_set_key_function = get_spdm_hmac_set_key_func(base_hash_algo);
+	if ((hmac_new_function == NULL) || (hmac_free_function == NULL) ||
+	    (hmac_set_key_function == NULL)) {
+		return NULL;
+	}
+
+	hmac_key_context = hmac_new_function();
+	if (hmac_key_context == NULL) {
+		return NULL;
+	}
+	if (!hmac_set_key_function(hmac_key_context, key, key_size)) {
+		hmac_free_function(hmac_key_context);
+		return NULL;
+	}
+	return hmac_key_context;
+}
+
+
+/**
+  Release the keyed HMAC context, based upon the negotiated HMAC algorithm.
+
+  @param  base_hash_algo                 SPDM base_hash_algo
+  @param  hmac_key_context               Pointer to the keyed HMAC context to be released.
+**/
+void spdm_hmac_free_with_key(IN uint32 base_hash_algo,
+			     IN void *hmac_key_context)
+{
+	hmac_free_func hmac_free_function;
+
+	hmac_free_function = get_spdm_hmac_free_func(base_hash_algo);
+	if (hmac_free_function == NULL) {
+		return;
+	}
+	hmac_free_function(hmac_key_context);
+}
+
+
+/**
+  Computes the HMAC of a input data buffer with a keyed HMAC context, based upon the negotiated HMAC algorithm.
+
+  The keyed HMAC context is not modified, so it can be used again.
+
+  @param  base_hash_algo                 SPDM base_hash_algo
+  @param  hmac_key_context               Pointer to the keyed HMAC context.
+  @param  data                         Pointer to the buffer containing the data to be HMACed.
+  @param  data_size                     size of data buffer in bytes.
+  @param  hmac_value                    Pointer to a buffer that receives the HMAC value.
 
   @retval TRUE   HMAC computation succeeded.
   @retval FALSE  HMAC computation failed.
 **/
-boolean spdm_hmac_all(IN uint32 base_hash_algo, IN const void *data,
-		      IN uintn data_size, IN const uint8 *key,
-		      IN uintn key_size, OUT uint8 *hmac_value)
+boolean spdm_hmac_all_with_key(IN uint32 base_hash_algo,
+			       IN const void *hmac_key_context,
+			       IN const void *data, IN uintn data_size,
+			       OUT uint8 *hmac_value)
 {
-	hmac_all_func hmac_function;
-	hmac_function = get_spdm_hmac_func(base_hash_algo);
-	if (hmac_function == NULL) {
+	spdm_iovec_t iov;
+
+	iov.data = data;
+	iov.data_size = data_size;
+	return spdm_hmac_multi_with_key(base_hash_algo, hmac_key_context, &iov,
+					1, hmac_value);
+}
+
+
+/**
+  Computes the HMAC of a list of discontinuous data buffers with a keyed HMAC context,
+  based upon the negotiated HMAC algorithm.
+
+  The keyed HMAC context is not modified, so it can be used again.
+
+  @param  base_hash_algo                 SPDM base_hash_algo
+  @param  hmac_key_context               Pointer to the keyed HMAC context.
+  @param  iov                          Pointer to the array of data buffers to be HMACed, in order.
+                                       An element with data_size 0 is skipped.
+  @param  iov_count                     Number of elements in iov.
+  @param  hmac_value                    Pointer to a buffer that receives the HMAC value.
+
+  @retval TRUE   HMAC computation succeeded.
+  @retval FALSE  HMAC computation failed.
+**/
+boolean spdm_hmac_multi_with_key(IN uint32 base_hash_algo,
+				 IN const void *hmac_key_context,
+				 IN const spdm_iovec_t *iov, IN uintn iov_count,
+				 OUT uint8 *hmac_value)
+{
+	hmac_new_func hmac_new_function;
+	hmac_free_func hmac_free_function;
+	hmac_duplicate_func hmac_duplicate_function;
+	hmac_update_func hmac_update_function;
+	hmac_final_func hmac_final_function;
+	void *hmac_context;
+	uintn index;
+	boolean result;
+
+	hmac_new_function = get_spdm_hmac_new_func(base_hash_algo);
+	hmac_free_function = get_spdm_hmac_free_func(base_hash_algo);
+	hmac_duplicate_function = get_spdm_hmac_duplicate_func(base_hash_algo);
+	hmac_update_function = get_spdm_hmac_update_func(base_hash_algo);
+	hmac_final_function = get_spdm_hmac_final_func(base_hash_algo);
+	if ((hmac_new_function == NULL) || (hmac_free_function == NULL) ||
+	    (hmac_duplicate_function == NULL) ||
+	    (hmac_update_function == NULL) || (hmac_final_function == NULL)) {
 		return FALSE;
 	}
-	return hmac_function(data, data_size, key, key_size, hmac_value);
+
+	hmac_context = hmac_new_function();
+	if (hmac_context == NULL) {
+		return FALSE;
+	}
+	result = hmac_duplicate_function(hmac_key_context, hmac_context);
+	for (index = 0; result && (index < iov_count); index++) {
+		if (iov[index].data_size == 0) {
+			continue;
+		}
+		result = hmac_update_function(hmac_context, iov[index].data,
+					      iov[index].data_size);
+	}
+	if (result) {
+		result = hmac_final_function(hmac_context, hmac_value);
+	}
+	hmac_free_function(hmac_context);
+	return result;
 }
 
 /**
@@ -348,6 +1217,99 @@ boolean spdm_hkdf_expand(IN uint32 base_hash_algo, IN const uint8 *prk,
 				    out_size);
 }
 
+/**
+  Derive HMAC-based Expand key Derivation Function (HKDF) Expand with a keyed HMAC context,
+  based upon the negotiated HKDF algorithm.
+
+  The keyed HMAC context is created by spdm_hmac_new_with_key() with the PRK,
+  and is not modified, so it can be used again for another info.
+
+  @param  base_hash_algo                 SPDM base_hash_algo
+  @param  prk_hmac_key_context           Pointer to the HMAC context keyed with the PRK.
+  @param  info                         Pointer to the application specific info.
+  @param  info_size                     info size in bytes.
+  @param  out                          Pointer to buffer to receive hkdf value.
+  @param  out_size                      size of hkdf bytes to generate.
+
+  @retval TRUE   Hkdf generated successfully.
+  @retval FALSE  Hkdf generation failed.
+**/
+boolean spdm_hkdf_expand_with_key(IN uint32 base_hash_algo,
+				  IN const void *prk_hmac_key_context,
+				  IN const uint8 *info, IN uintn info_size,
+				  OUT uint8 *out, IN uintn out_size)
+{
+	hmac_new_func hmac_new_function;
+	hmac_free_func hmac_free_function;
+	hmac_duplicate_func hmac_duplicate_function;
+	hmac_update_func hmac_update_function;
+	hmac_final_func hmac_final_function;
+	void *hmac_context;
+	uint8 t_value[MAX_HASH_SIZE];
+	uintn hash_size;
+	uintn offset;
+	uintn copy_size;
+	uint8 counter;
+	boolean result;
+
+	hash_size = spdm_get_hash_size(base_hash_algo);
+	if ((hash_size == 0) || (out_size > 255 * hash_size)) {
+		return FALSE;
+	}
+
+	hmac_new_function = get_spdm_hmac_new_func(base_hash_algo);
+	hmac_free_function = get_spdm_hmac_free_func(base_hash_algo);
+	hmac_duplicate_function = get_spdm_hmac_duplicate_func(base_hash_algo);
+	hmac_update_function = get_spdm_hmac_update_func(base_hash_algo);
+	hmac_final_function = get_spdm_hmac_final_func(base_hash_algo);
+	if ((hmac_new_function == NULL) || (hmac_free_function == NULL) ||
+	    (hmac_duplicate_function == NULL) ||
+	    (hmac_update_function == NULL) || (hmac_final_function == NULL)) {
+		return FALSE;
+	}
+
+	hmac_context = hmac_new_function();
+	if (hmac_context == NULL) {
+		return FALSE;
+	}
+
+	//
+	// T(N) = HMAC(PRK, T(N-1) | info | N), out = T(1) | T(2) | ...
+	//
+	result = TRUE;
+	counter = 0;
+	for (offset = 0; result && (offset < out_size); offset += copy_size) {
+		counter++;
+		result = hmac_duplicate_function(prk_hmac_key_context,
+						 hmac_context);
+		if (result && (counter > 1)) {
+			result = hmac_update_function(hmac_context, t_value,
+						      hash_size);
+		}
+		if (result && (info_size != 0)) {
+			result = hmac_update_function(hmac_context, info,
+						      info_size);
+		}
+		if (result) {
+			result = hmac_update_function(hmac_context, &counter,
+						      sizeof(counter));
+		}
+		if (result) {
+			result = hmac_final_function(hmac_context, t_value);
+		}
+		copy_size = out_size - offset;
+		if (copy_size > hash_size) {
+			copy_size = hash_size;
+		}
+		if (result) {
+			copy_mem(out + offset, t_value, copy_size);
+		}
+	}
+	zero_mem_secure(t_value, sizeof(t_value));
+	hmac_free_function(hmac_context);
+	return result;
+}
+
 /**
   This function returns the SPDM asymmetric algorithm size.
 
@@ -612,6 +1574,46 @@ boolean spdm_asym_verify(IN uint32 base_asym_algo, IN uint32 base_hash_algo,
 	}
 }
 
+/**
+  Verifies the asymmetric signature of a message hash,
+  based upon negotiated asymmetric algorithm.
+
+  @param  base_asym_algo                 SPDM base_asym_algo
+  @param  base_hash_algo                 SPDM base_hash_algo
+  @param  context                      Pointer to asymmetric context for signature verification.
+  @param  message_hash                  Pointer to the hash of the message to be checked.
+  @param  hash_size                     size of the message hash in bytes.
+  @param  signature                    Pointer to asymmetric signature to be verified.
+  @param  sig_size                      size of signature in bytes.
+
+  @retval  TRUE   Valid asymmetric signature.
+  @retval  FALSE  Invalid asymmetric signature or invalid asymmetric context.
+**/
+boolean spdm_asym_verify_hash(IN uint32 base_asym_algo,
+			      IN uint32 base_hash_algo, IN void *context,
+			      IN const uint8 *message_hash, IN uintn hash_size,
+			      IN const uint8 *signature, IN uintn sig_size)
+{
+	asym_verify_func verify_function;
+	boolean need_hash;
+	uintn hash_nid;
+
+	hash_nid = get_spdm_hash_nid(base_hash_algo);
+	need_hash = spdm_asym_func_need_hash(base_asym_algo);
+	if (!need_hash) {
+		ASSERT(FALSE);
+		return FALSE;
+	}
+	ASSERT(hash_size == spdm_get_hash_size(base_hash_algo));
+
+	verify_function = get_spdm_asym_verify(base_asym_algo);
+	if (verify_function == NULL) {
+		return FALSE;
+	}
+	return verify_function(context, hash_nid, message_hash, hash_size,
+			       signature, sig_size);
+}
+
 /**
   Return asymmetric GET_PRIVATE_KEY_FROM_PEM function, based upon the asymmetric algorithm.
 
@@ -773,6 +1775,50 @@ boolean spdm_asym_sign(IN uint32 base_asym_algo, IN uint32 base_hash_algo,
 	}
 }
 
+/**
+  Carries out the signature generation of a message hash.
+
+  If the signature buffer is too small to hold the contents of signature, FALSE
+  is returned and sig_size is set to the required buffer size to obtain the signature.
+
+  @param  base_asym_algo                 SPDM base_asym_algo
+  @param  base_hash_algo                 SPDM base_hash_algo
+  @param  context                      Pointer to asymmetric context for signature generation.
+  @param  message_hash                  Pointer to the hash of the message to be signed.
+  @param  hash_size                     size of the message hash in bytes.
+  @param  signature                    Pointer to buffer to receive signature.
+  @param  sig_size                      On input, the size of signature buffer in bytes.
+                                       On output, the size of data returned in signature buffer in bytes.
+
+  @retval  TRUE   signature successfully generated.
+  @retval  FALSE  signature generation failed.
+  @retval  FALSE  sig_size is too small.
+**/
+boolean spdm_asym_sign_hash(IN uint32 base_asym_algo, IN uint32 base_hash_algo,
+			    IN void *context, IN const uint8 *message_hash,
+			    IN uintn hash_size, OUT uint8 *signature,
+			    IN OUT uintn *sig_size)
+{
+	asym_sign_func asym_sign;
+	boolean need_hash;
+	uintn hash_nid;
+
+	hash_nid = get_spdm_hash_nid(base_hash_algo);
+	need_hash = spdm_asym_func_need_hash(base_asym_algo);
+	if (!need_hash) {
+		ASSERT(FALSE);
+		return FALSE;
+	}
+	ASSERT(hash_size == spdm_get_hash_size(base_hash_algo));
+
+	asym_sign = get_spdm_asym_sign(base_asym_algo);
+	if (asym_sign == NULL) {
+		return FALSE;
+	}
+	return asym_sign(context, hash_nid, message_hash, hash_size, signature,
+			 sig_size);
+}
+
 /**
   This function returns the SPDM requester asymmetric algorithm size.
 
@@ -928,6 +1974,32 @@ boolean spdm_req_asym_verify(IN uint16 req_base_asym_alg,
 	}
 }
 
+/**
+  Verifies the asymmetric signature of a message hash,
+  based upon negotiated requester asymmetric algorithm.
+
+  @param  req_base_asym_alg               SPDM req_base_asym_alg
+  @param  base_hash_algo                 SPDM base_hash_algo
+  @param  context                      Pointer to asymmetric context for signature verification.
+  @param  message_hash                  Pointer to the hash of the message to be checked.
+  @param  hash_size                     size of the message hash in bytes.
+  @param  signature                    Pointer to asymmetric signature to be verified.
+  @param  sig_size                      size of signature in bytes.
+
+  @retval  TRUE   Valid asymmetric signature.
+  @retval  FALSE  Invalid asymmetric signature or invalid asymmetric context.
+**/
+boolean spdm_req_asym_verify_hash(IN uint16 req_base_asym_alg,
+				  IN uint32 base_hash_algo, IN void *context,
+				  IN const uint8 *message_hash,
+				  IN uintn hash_size, IN const uint8 *signature,
+				  IN uintn sig_size)
+{
+	return spdm_asym_verify_hash(req_base_asym_alg, base_hash_algo, context,
+				     message_hash, hash_size, signature,
+				     sig_size);
+}
+
 /**
   Return asymmetric GET_PRIVATE_KEY_FROM_PEM function, based upon the asymmetric algorithm.
 
@@ -1035,6 +2107,35 @@ boolean spdm_req_asym_sign(IN uint16 req_base_asym_alg,
 	}
 }
 
+/**
+  Carries out the signature generation of a message hash.
+
+  If the signature buffer is too small to hold the contents of signature, FALSE
+  is returned and sig_size is set to the required buffer size to obtain the signature.
+
+  @param  req_base_asym_alg               SPDM req_base_asym_alg
+  @param  base_hash_algo                 SPDM base_hash_algo
+  @param  context                      Pointer to asymmetric context for signature generation.
+  @param  message_hash                  Pointer to the hash of the message to be signed.
+  @param  hash_size                     size of the message hash in bytes.
+  @param  signature                    Pointer to buffer to receive signature.
+  @param  sig_size                      On input, the size of signature buffer in bytes.
+                                       On output, the size of data returned in signature buffer in bytes.
+
+  @retval  TRUE   signature successfully generated.
+  @retval  FALSE  signature generation failed.
+  @retval  FALSE  sig_size is too small.
+**/
+boolean spdm_req_asym_sign_hash(IN uint16 req_base_asym_alg,
+				IN uint32 base_hash_algo, IN void *context,
+				IN const uint8 *message_hash, IN uintn hash_size,
+				OUT uint8 *signature, IN OUT uintn *sig_size)
+{
+	return spdm_asym_sign_hash(req_base_asym_alg, base_hash_algo, context,
+				   message_hash, hash_size, signature,
+				   sig_size);
+}
+
 /**
   This function returns the SPDM DHE algorithm key size.
 
@@ -1341,76 +2442,340 @@ uint32 spdm_get_aead_key_size(IN uint16 aead_cipher_suite)
 	case SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_CHACHA20_POLY1305:
 		return 32;
 	}
-	return 0;
+	return 0;
+}
+
+/**
+  This function returns the SPDM AEAD algorithm iv size.
+
+  @param  aead_cipher_suite              SPDM aead_cipher_suite
+
+  @return SPDM AEAD algorithm iv size.
+**/
+uint32 spdm_get_aead_iv_size(IN uint16 aead_cipher_suite)
+{
+	switch (aead_cipher_suite) {
+	case SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_AES_128_GCM:
+		return 12;
+	case SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_AES_256_GCM:
+		return 12;
+	case SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_CHACHA20_POLY1305:
+		return 12;
+	}
+	return 0;
+}
+
+/**
+  This function returns the SPDM AEAD algorithm tag size.
+
+  @param  aead_cipher_suite              SPDM aead_cipher_suite
+
+  @return SPDM AEAD algorithm tag size.
+**/
+uint32 spdm_get_aead_tag_size(IN uint16 aead_cipher_suite)
+{
+	switch (aead_cipher_suite) {
+	case SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_AES_128_GCM:
+		return 16;
+	case SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_AES_256_GCM:
+		return 16;
+	case SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_CHACHA20_POLY1305:
+		return 16;
+	}
+	return 0;
+}
+
+/**
+  Return AEAD encryption function, based upon the negotiated AEAD algorithm.
+
+  @param  aead_cipher_suite              SPDM aead_cipher_suite
+
+  @return AEAD encryption function
+**/
+aead_encrypt_func get_spdm_aead_enc_func(IN uint16 aead_cipher_suite)
+{
+	switch (aead_cipher_suite) {
+	case SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_AES_128_GCM:
+#if OPENSPDM_AEAD_GCM_SUPPORT == 1
+		return aead_aes_gcm_encrypt;
+#else
+		ASSERT(FALSE);
+		break;
+#endif
+	case SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_AES_256_GCM:
+#if OPENSPDM_AEAD_GCM_SUPPORT == 1
+		return aead_aes_gcm_encrypt;
+#else
+		ASSERT(FALSE);
+		break;
+#endif
+	case SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_CHACHA20_POLY1305:
+#if OPENSPDM_AEAD_CHACHA20_POLY1305_SUPPORT == 1
+		return aead_chacha20_poly1305_encrypt;
+#else
+		ASSERT(FALSE);
+		break;
+#endif
+	}
+	ASSERT(FALSE);
+	return NULL;
+}
+
+/**
+  Performs AEAD authenticated encryption on a data buffer and additional authenticated data (AAD),
+  based upon negotiated AEAD algorithm.
+
+  @param  aead_cipher_suite              SPDM aead_cipher_suite
+  @param  key                          Pointer to the encryption key.
+  @param  key_size                      size of the encryption key in bytes.
+  @param  iv                           Pointer to the IV value.
+  @param  iv_size                       size of the IV value in bytes.
+  @param  a_data                        Pointer to the additional authenticated data (AAD).
+  @param  a_data_size                    size of the additional authenticated data (AAD) in bytes.
+  @param  data_in                       Pointer to the input data buffer to be encrypted.
+  @param  data_in_size                   size of the input data buffer in bytes.
+  @param  tag_out                       Pointer to a buffer that receives the authentication tag output.
+  @param  tag_size                      size of the authentication tag in bytes.
+  @param  data_out                      Pointer to a buffer that receives the encryption output.
+  @param  data_out_size                  size of the output data buffer in bytes.
+
+  @retval TRUE   AEAD authenticated encryption succeeded.
+  @retval FALSE  AEAD authenticated encryption failed.
+**/
+boolean spdm_aead_encryption(IN uint16 aead_cipher_suite, IN const uint8 *key,
+			     IN uintn key_size, IN const uint8 *iv,
+			     IN uintn iv_size, IN const uint8 *a_data,
+			     IN uintn a_data_size, IN const uint8 *data_in,
+			     IN uintn data_in_size, OUT uint8 *tag_out,
+			     IN uintn tag_size, OUT uint8 *data_out,
+			     OUT uintn *data_out_size)
+{
+	aead_encrypt_func aead_enc_function;
+	aead_enc_function = get_spdm_aead_enc_func(aead_cipher_suite);
+	if (aead_enc_function == NULL) {
+		return FALSE;
+	}
+	return aead_enc_function(key, key_size, iv, iv_size, a_data,
+				 a_data_size, data_in, data_in_size, tag_out,
+				 tag_size, data_out, data_out_size);
+}
+
+/**
+  Return AEAD decryption function, based upon the negotiated AEAD algorithm.
+
+  @param  aead_cipher_suite              SPDM aead_cipher_suite
+
+  @return AEAD decryption function
+**/
+aead_decrypt_func get_spdm_aead_dec_func(IN uint16 aead_cipher_suite)
+{
+	switch (aead_cipher_suite) {
+	case SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_AES_128_GCM:
+#if OPENSPDM_AEAD_GCM_SUPPORT == 1
+		return aead_aes_gcm_decrypt;
+#else
+		ASSERT(FALSE);
+		break;
+#endif
+	case SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_AES_256_GCM:
+#if OPENSPDM_AEAD_GCM_SUPPORT == 1
+		return aead_aes_gcm_decrypt;
+#else
+		ASSERT(FALSE);
+		break;
+#endif
+	case SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_CHACHA20_POLY1305:
+#if OPENSPDM_AEAD_CHACHA20_POLY1305_SUPPORT == 1
+		return aead_chacha20_poly1305_decrypt;
+#else
+		ASSERT(FALSE);
+		break;
+#endif
+	}
+	ASSERT(FALSE);
+	return NULL;
+}
+
+/**
+  Performs AEAD authenticated decryption on a data buffer and additional authenticated data (AAD),
+  based upon negotiated AEAD algorithm.
+
+  @param  aead_cipher_suite              SPDM aead_cipher_suite
+  @param  key                          Pointer to the encryption key.
+  @param  key_size                      size of the encryption key in bytes.
+  @param  iv                           Pointer to the IV value.
+  @param  iv_size                       size of the IV value in bytes.
+  @param  a_data                        Pointer to the additional authenticated data (AAD).
+  @param  a_data_size                    size of the additional authenticated data (AAD) in bytes.
+  @param  data_in                       Pointer to the input data buffer to be decrypted.
+  @param  data_in_size                   size of the input data buffer in bytes.
+  @param  tag                          Pointer to a buffer that contains the authentication tag.
+  @param  tag_size                      size of the authentication tag in bytes.
+  @param  data_out                      Pointer to a buffer that receives the decryption output.
+  @param  data_out_size                  size of the output data buffer in bytes.
+
+  @retval TRUE   AEAD authenticated decryption succeeded.
+  @retval FALSE  AEAD authenticated decryption failed.
+**/
+boolean spdm_aead_decryption(IN uint16 aead_cipher_suite, IN const uint8 *key,
+			     IN uintn key_size, IN const uint8 *iv,
+			     IN uintn iv_size, IN const uint8 *a_data,
+			     IN uintn a_data_size, IN const uint8 *data_in,
+			     IN uintn data_in_size, IN const uint8 *tag,
+			     IN uintn tag_size, OUT uint8 *data_out,
+			     OUT uintn *data_out_size)
+{
+	aead_decrypt_func aead_dec_function;
+	aead_dec_function = get_spdm_aead_dec_func(aead_cipher_suite);
+	if (aead_dec_function == NULL) {
+		return FALSE;
+	}
+	return aead_dec_function(key, key_size, iv, iv_size, a_data,
+				 a_data_size, data_in, data_in_size, tag,
+				 tag_size, data_out, data_out_size);
+}
+
+/**
+  Return AEAD NEW function, based upon the negotiated AEAD algorithm.
+
+  @param  aead_cipher_suite              SPDM aead_cipher_suite
+
+  @return AEAD NEW function
+**/
+aead_new_func get_spdm_aead_new_func(IN uint16 aead_cipher_suite)
+{
+	switch (aead_cipher_suite) {
+	case SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_AES_128_GCM:
+#if OPENSPDM_AEAD_GCM_SUPPORT == 1
+		return aead_aes_gcm_new;
+#else
+		ASSERT(FALSE);
+		break;
+#endif
+	case SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_AES_256_GCM:
+#if OPENSPDM_AEAD_GCM_SUPPORT == 1
+		return aead_aes_gcm_new;
+#else
+		ASSERT(FALSE);
+		break;
+#endif
+	case SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_CHACHA20_POLY1305:
+#if OPENSPDM_AEAD_CHACHA20_POLY1305_SUPPORT == 1
+		return aead_chacha20_poly1305_new;
+#else
+		ASSERT(FALSE);
+		break;
+#endif
+	}
+	ASSERT(FALSE);
+	return NULL;
+}
+
+/**
+  Allocates and initializes one AEAD context with the key, based upon negotiated AEAD algorithm.
+
+  The key schedule is performed once, so the context should be kept for all records
+  protected by the same key.
+
+  @param  aead_cipher_suite              SPDM aead_cipher_suite
+  @param  key                          Pointer to the encryption key.
+  @param  key_size                      size of the encryption key in bytes.
+
+  @return  Pointer to the AEAD context that has been initialized.
+           If the allocations fails, spdm_aead_new() returns NULL.
+**/
+void *spdm_aead_new(IN uint16 aead_cipher_suite, IN const uint8 *key,
+		    IN uintn key_size)
+{
+	aead_new_func aead_new_function;
+	aead_new_function = get_spdm_aead_new_func(aead_cipher_suite);
+	if (aead_new_function == NULL) {
+		return NULL;
+	}
+	return aead_new_function(key, key_size);
 }
 
 /**
-  This function returns the SPDM AEAD algorithm iv size.
+  Return AEAD FREE function, based upon the negotiated AEAD algorithm.
 
   @param  aead_cipher_suite              SPDM aead_cipher_suite
 
-  @return SPDM AEAD algorithm iv size.
+  @return AEAD FREE function
 **/
-uint32 spdm_get_aead_iv_size(IN uint16 aead_cipher_suite)
+aead_free_func get_spdm_aead_free_func(IN uint16 aead_cipher_suite)
 {
 	switch (aead_cipher_suite) {
 	case SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_AES_128_GCM:
-		return 12;
+#if OPENSPDM_AEAD_GCM_SUPPORT == 1
+		return aead_aes_gcm_free;
+#else
+		ASSERT(FALSE);
+		break;
+#endif
 	case SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_AES_256_GCM:
-		return 12;
+#if OPENSPDM_AEAD_GCM_SUPPORT == 1
+		return aead_aes_gcm_free;
+#else
+		ASSERT(FALSE);
+		break;
+#endif
 	case SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_CHACHA20_POLY1305:
-		return 12;
+#if OPENSPDM_AEAD_CHACHA20_POLY1305_SUPPORT == 1
+		return aead_chacha20_poly1305_free;
+#else
+		ASSERT(FALSE);
+		break;
+#endif
 	}
-	return 0;
+	ASSERT(FALSE);
+	return NULL;
 }
 
+
 /**
-  This function returns the SPDM AEAD algorithm tag size.
+  Release the specified AEAD context, based upon negotiated AEAD algorithm.
 
   @param  aead_cipher_suite              SPDM aead_cipher_suite
-
-  @return SPDM AEAD algorithm tag size.
+  @param  aead_context                   Pointer to the AEAD context to be released.
 **/
-uint32 spdm_get_aead_tag_size(IN uint16 aead_cipher_suite)
+void spdm_aead_free(IN uint16 aead_cipher_suite, IN void *aead_context)
 {
-	switch (aead_cipher_suite) {
-	case SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_AES_128_GCM:
-		return 16;
-	case SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_AES_256_GCM:
-		return 16;
-	case SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_CHACHA20_POLY1305:
-		return 16;
+	aead_free_func aead_free_function;
+	aead_free_function = get_spdm_aead_free_func(aead_cipher_suite);
+	if (aead_free_function == NULL) {
+		return;
 	}
-	return 0;
+	aead_free_function(aead_context);
 }
 
 /**
-  Return AEAD encryption function, based upon the negotiated AEAD algorithm.
+  Return AEAD encryption with context function, based upon the negotiated AEAD algorithm.
 
   @param  aead_cipher_suite              SPDM aead_cipher_suite
 
-  @return AEAD encryption function
+  @return AEAD encryption with context function
 **/
-aead_encrypt_func get_spdm_aead_enc_func(IN uint16 aead_cipher_suite)
+aead_encrypt_with_context_func
+get_spdm_aead_enc_with_context_func(IN uint16 aead_cipher_suite)
 {
 	switch (aead_cipher_suite) {
 	case SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_AES_128_GCM:
 #if OPENSPDM_AEAD_GCM_SUPPORT == 1
-		return aead_aes_gcm_encrypt;
+		return aead_aes_gcm_encrypt_with_context;
 #else
 		ASSERT(FALSE);
 		break;
 #endif
 	case SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_AES_256_GCM:
 #if OPENSPDM_AEAD_GCM_SUPPORT == 1
-		return aead_aes_gcm_encrypt;
+		return aead_aes_gcm_encrypt_with_context;
 #else
 		ASSERT(FALSE);
 		break;
 #endif
 	case SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_CHACHA20_POLY1305:
 #if OPENSPDM_AEAD_CHACHA20_POLY1305_SUPPORT == 1
-		return aead_chacha20_poly1305_encrypt;
+		return aead_chacha20_poly1305_encrypt_with_context;
 #else
 		ASSERT(FALSE);
 		break;
@@ -1420,13 +2785,13 @@ aead_encrypt_func get_spdm_aead_enc_func(IN uint16 aead_cipher_suite)
 	return NULL;
 }
 
+
 /**
   Performs AEAD authenticated encryption on a data buffer and additional authenticated data (AAD),
-  based upon negotiated AEAD algorithm.
+  with a keyed AEAD context, based upon negotiated AEAD algorithm.
 
   @param  aead_cipher_suite              SPDM aead_cipher_suite
-  @param  key                          Pointer to the encryption key.
-  @param  key_size                      size of the encryption key in bytes.
+  @param  aead_context                   Pointer to the AEAD context.
   @param  iv                           Pointer to the IV value.
   @param  iv_size                       size of the IV value in bytes.
   @param  a_data                        Pointer to the additional authenticated data (AAD).
@@ -1441,51 +2806,50 @@ aead_encrypt_func get_spdm_aead_enc_func(IN uint16 aead_cipher_suite)
   @retval TRUE   AEAD authenticated encryption succeeded.
   @retval FALSE  AEAD authenticated encryption failed.
 **/
-boolean spdm_aead_encryption(IN uint16 aead_cipher_suite, IN const uint8 *key,
-			     IN uintn key_size, IN const uint8 *iv,
-			     IN uintn iv_size, IN const uint8 *a_data,
-			     IN uintn a_data_size, IN const uint8 *data_in,
-			     IN uintn data_in_size, OUT uint8 *tag_out,
-			     IN uintn tag_size, OUT uint8 *data_out,
-			     OUT uintn *data_out_size)
+boolean spdm_aead_encryption_with_context(
+	IN uint16 aead_cipher_suite, IN void *aead_context, IN const uint8 *iv,
+	IN uintn iv_size, IN const uint8 *a_data, IN uintn a_data_size,
+	IN const uint8 *data_in, IN uintn data_in_size, OUT uint8 *tag_out,
+	IN uintn tag_size, OUT uint8 *data_out, OUT uintn *data_out_size)
 {
-	aead_encrypt_func aead_enc_function;
-	aead_enc_function = get_spdm_aead_enc_func(aead_cipher_suite);
+	aead_encrypt_with_context_func aead_enc_function;
+	aead_enc_function = get_spdm_aead_enc_with_context_func(aead_cipher_suite);
 	if (aead_enc_function == NULL) {
 		return FALSE;
 	}
-	return aead_enc_function(key, key_size, iv, iv_size, a_data,
-				 a_data_size, data_in, data_in_size, tag_out,
-				 tag_size, data_out, data_out_size);
+	return aead_enc_function(aead_context, iv, iv_size, a_data, a_data_size,
+				 data_in, data_in_size, tag_out, tag_size,
+				 data_out, data_out_size);
 }
 
 /**
-  Return AEAD decryption function, based upon the negotiated AEAD algorithm.
+  Return AEAD decryption with context function, based upon the negotiated AEAD algorithm.
 
   @param  aead_cipher_suite              SPDM aead_cipher_suite
 
-  @return AEAD decryption function
+  @return AEAD decryption with context function
 **/
-aead_decrypt_func get_spdm_aead_dec_func(IN uint16 aead_cipher_suite)
+aead_decrypt_with_context_func
+get_spdm_aead_dec_with_context_func(IN uint16 aead_cipher_suite)
 {
 	switch (aead_cipher_suite) {
 	case SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_AES_128_GCM:
 #if OPENSPDM_AEAD_GCM_SUPPORT == 1
-		return aead_aes_gcm_decrypt;
+		return aead_aes_gcm_decrypt_with_context;
 #else
 		ASSERT(FALSE);
 		break;
 #endif
 	case SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_AES_256_GCM:
 #if OPENSPDM_AEAD_GCM_SUPPORT == 1
-		return aead_aes_gcm_decrypt;
+		return aead_aes_gcm_decrypt_with_context;
 #else
 		ASSERT(FALSE);
 		break;
 #endif
 	case SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_CHACHA20_POLY1305:
 #if OPENSPDM_AEAD_CHACHA20_POLY1305_SUPPORT == 1
-		return aead_chacha20_poly1305_decrypt;
+		return aead_chacha20_poly1305_decrypt_with_context;
 #else
 		ASSERT(FALSE);
 		break;
@@ -1495,13 +2859,13 @@ aead_decrypt_func get_spdm_aead_dec_func(IN uint16 aead_cipher_suite)
 	return NULL;
 }
 
+
 /**
   Performs AEAD authenticated decryption on a data buffer and additional authenticated data (AAD),
-  based upon negotiated AEAD algorithm.
+  with a keyed AEAD context, based upon negotiated AEAD algorithm.
 
   @param  aead_cipher_suite              SPDM aead_cipher_suite
-  @param  key                          Pointer to the encryption key.
-  @param  key_size                      size of the encryption key in bytes.
+  @param  aead_context                   Pointer to the AEAD context.
   @param  iv                           Pointer to the IV value.
   @param  iv_size                       size of the IV value in bytes.
   @param  a_data                        Pointer to the additional authenticated data (AAD).
@@ -1516,22 +2880,20 @@ aead_decrypt_func get_spdm_aead_dec_func(IN uint16 aead_cipher_suite)
   @retval TRUE   AEAD authenticated decryption succeeded.
   @retval FALSE  AEAD authenticated decryption failed.
 **/
-boolean spdm_aead_decryption(IN uint16 aead_cipher_suite, IN const uint8 *key,
-			     IN uintn key_size, IN const uint8 *iv,
-			     IN uintn iv_size, IN const uint8 *a_data,
-			     IN uintn a_data_size, IN const uint8 *data_in,
-			     IN uintn data_in_size, IN const uint8 *tag,
-			     IN uintn tag_size, OUT uint8 *data_out,
-			     OUT uintn *data_out_size)
+boolean spdm_aead_decryption_with_context(
+	IN uint16 aead_cipher_suite, IN void *aead_context, IN const uint8 *iv,
+	IN uintn iv_size, IN const uint8 *a_data, IN uintn a_data_size,
+	IN const uint8 *data_in, IN uintn data_in_size, IN const uint8 *tag,
+	IN uintn tag_size, OUT uint8 *data_out, OUT uintn *data_out_size)
 {
-	aead_decrypt_func aead_dec_function;
-	aead_dec_function = get_spdm_aead_dec_func(aead_cipher_suite);
+	aead_decrypt_with_context_func aead_dec_function;
+	aead_dec_function = get_spdm_aead_dec_with_context_func(aead_cipher_suite);
 	if (aead_dec_function == NULL) {
 		return FALSE;
 	}
-	return aead_dec_function(key, key_size, iv, iv_size, a_data,
-				 a_data_size, data_in, data_in_size, tag,
-				 tag_size, data_out, data_out_size);
+	return aead_dec_function(aead_context, iv, iv_size, a_data, a_data_size,
+				 data_in, data_in_size, tag, tag_size,
+				 data_out, data_out_size);
 }
 
 /**
@@ -1548,10 +2910,30 @@ void spdm_get_random_number(IN uintn size, OUT uint8 *rand)
 	return;
 }
 
+static spdm_get_current_date_time_func m_spdm_get_current_date_time_func;
+
+/**
+  This function registers the platform function that returns the current date and time.
+
+  Once it is registered, the validity of a leaf certificate is checked against the current
+  date and time, both by spdm_x509_certificate_check and on every hit of the certificate
+  chain verify cache. Without it, only the bounds 1970 to 9999 are checked. The function
+  is process-global: it must be registered before any certificate is checked.
+
+  @param  get_current_date_time_func      The function to get the current date and time, or NULL.
+**/
+void spdm_register_current_date_time_func(
+	IN spdm_get_current_date_time_func get_current_date_time_func OPTIONAL)
+{
+	m_spdm_get_current_date_time_func = get_current_date_time_func;
+}
+
 /**
   Check the X509 DataTime is within a valid range.
 
-  @param  spdm_context                  A pointer to the SPDM context.
+  The range is 1970 to 9999, narrowed to the current date and time if
+  spdm_register_current_date_time_func registered a function.
+
   @param  from                         notBefore Pointer to date_time object.
   @param  from_size                     notBefore date_time object size.
   @param  to                           notAfter Pointer to date_time object.
@@ -1571,6 +2953,9 @@ static boolean internal_spdm_x509_date_time_check(IN uint8 *from,
 	uint8 t0[64];
 	uintn f0_size;
 	uintn t0_size;
+	char8 now_str[SPDM_DATE_TIME_STRING_SIZE];
+	uint8 now[64];
+	uintn now_size;
 
 	f0_size = 64;
 	t0_size = 64;
@@ -1597,12 +2982,40 @@ static boolean internal_spdm_x509_date_time_check(IN uint8 *from,
 		return FALSE;
 	}
 
+	if (m_spdm_get_current_date_time_func == NULL) {
+		return TRUE;
+	}
+
+	zero_mem(now_str, sizeof(now_str));
+	if (!m_spdm_get_current_date_time_func(now_str)) {
+		return FALSE;
+	}
+	now_str[sizeof(now_str) - 1] = 0;
+	now_size = 64;
+	status = x509_set_date_time(now_str, now, &now_size);
+	if (status != RETURN_SUCCESS) {
+		return FALSE;
+	}
+
+	// from <= now <= to
+	ret = x509_compare_date_time(now, from);
+	if (ret < 0) {
+		return FALSE;
+	}
+	ret = x509_compare_date_time(to, now);
+	if (ret < 0) {
+		return FALSE;
+	}
+
 	return TRUE;
 }
 
 /**
   Certificate Check for SPDM leaf cert.
 
+  The validity is checked against the current date and time if
+  spdm_register_current_date_time_func registered a function.
+
   @param[in]  cert            Pointer to the DER-encoded certificate data.
   @param[in]  cert_size        The size of certificate data in bytes.
 
@@ -1885,6 +3298,232 @@ spdm_get_dmtf_subject_alt_name(IN const uint8 *cert, IN intn cert_size,
 		name_buffer_size, oid, oid_size);
 }
 
+#if MAX_SPDM_CERT_CHAIN_VERIFY_CACHE_COUNT > 0
+//
+// The verified certificates are keyed by their hash with the strongest hash algorithm compiled in.
+//
+#if OPENSPDM_SHA512_SUPPORT == 1
+#define SPDM_CERT_CHAIN_VERIFY_CACHE_HASH_ALGO \
+	SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_512
+#elif OPENSPDM_SHA384_SUPPORT == 1
+#define SPDM_CERT_CHAIN_VERIFY_CACHE_HASH_ALGO \
+	SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_384
+#else
+#define SPDM_CERT_CHAIN_VERIFY_CACHE_HASH_ALGO \
+	SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_256
+#endif
+
+typedef struct {
+	//
+	// base_hash_algo of a certificate chain buffer, or 0 for certificate chain data.
+	//
+	uint32 base_hash_algo;
+	//
+	// Stamp of the last use, for least-recently-used replacement. 0 means the entry is empty.
+	//
+	uint32 last_used;
+	//
+	// The verified certificates before the leaf certificate (the root and the intermediate
+	// certificates), preceded by the root certificate hash for a certificate chain buffer.
+	//
+	uintn prefix_size;
+	uint8 prefix_hash[MAX_HASH_SIZE];
+} spdm_cert_chain_verify_cache_entry_t;
+
+typedef struct {
+	uint32 use_count;
+	spdm_cert_chain_verify_cache_entry_t
+		entry[MAX_SPDM_CERT_CHAIN_VERIFY_CACHE_COUNT];
+} spdm_cert_chain_verify_cache_t;
+#endif
+
+/**
+  Select the entry of a cache table to fill: the first empty entry, or else the least recently
+  used one.
+
+  Each entry holds a uint32 stamp of its last use at the same offset. A stamp of 0 marks an
+  empty entry.
+
+  @param  last_used                     A pointer to the last use stamp of the first entry.
+  @param  entry_count                   The number of entries in the table. It must not be 0.
+  @param  entry_size                    size in bytes of one entry.
+
+  @return the index of the selected entry.
+**/
+uintn spdm_select_lru_cache_entry(IN const uint32 *last_used,
+				  IN uintn entry_count, IN uintn entry_size)
+{
+	const uint32 *stamp;
+	uint32 lru_stamp;
+	uintn lru_index;
+	uintn index;
+
+	lru_stamp = MAX_UINT32;
+	lru_index = 0;
+	for (index = 0; index < entry_count; index++) {
+		stamp = (const uint32 *)((const uint8 *)last_used +
+					 index * entry_size);
+		if (*stamp == 0) {
+			return index;
+		}
+		if (*stamp < lru_stamp) {
+			lru_stamp = *stamp;
+			lru_index = index;
+		}
+	}
+	return lru_index;
+}
+
+/**
+  Return the size in bytes of a certificate chain verify cache.
+
+  @return the size in bytes of the certificate chain verify cache,
+          or 0 if MAX_SPDM_CERT_CHAIN_VERIFY_CACHE_COUNT is 0.
+**/
+uintn spdm_get_cert_chain_verify_cache_size(void)
+{
+#if MAX_SPDM_CERT_CHAIN_VERIFY_CACHE_COUNT > 0
+	return sizeof(spdm_cert_chain_verify_cache_t);
+#else
+	return 0;
+#endif
+}
+
+/**
+  This function forgets every certificate chain remembered as verified by a certificate
+  chain verify cache. It also initializes a new certificate chain verify cache.
+
+  A certificate chain is verified in full again the next time it is checked.
+  It should be called when the trust policy changes.
+
+  @param  cert_chain_verify_cache         A pointer to the certificate chain verify cache of
+                                       spdm_get_cert_chain_verify_cache_size bytes.
+**/
+void spdm_flush_cert_chain_verify_cache(IN OUT void *cert_chain_verify_cache)
+{
+#if MAX_SPDM_CERT_CHAIN_VERIFY_CACHE_COUNT > 0
+	zero_mem(cert_chain_verify_cache,
+		 sizeof(spdm_cert_chain_verify_cache_t));
+#endif
+}
+
+/**
+  Look up the verified certificates before the leaf certificate of a certificate chain.
+
+  @param  cert_chain_verify_cache         The certificate chain verify cache, or NULL.
+  @param  base_hash_algo                 base_hash_algo of a certificate chain buffer, or 0 for certificate chain data.
+  @param  prefix                       The certificates before the leaf certificate, preceded by
+                                       the root certificate hash for a certificate chain buffer.
+  @param  prefix_size                   size in bytes of the prefix.
+  @param  prefix_hash                   On output, the hash of the prefix, for
+                                       internal_spdm_cert_chain_verify_cache_insert.
+
+  @retval TRUE   The prefix was verified. Only the leaf certificate must be verified.
+  @retval FALSE  The certificate chain must be verified in full.
+**/
+static boolean internal_spdm_cert_chain_verify_cache_lookup(
+	IN void *cert_chain_verify_cache, IN uint32 base_hash_algo,
+	IN const uint8 *prefix, IN uintn prefix_size, OUT uint8 *prefix_hash)
+{
+#if MAX_SPDM_CERT_CHAIN_VERIFY_CACHE_COUNT > 0
+	spdm_cert_chain_verify_cache_t *cache;
+	spdm_cert_chain_verify_cache_entry_t *entry;
+	uintn hash_size;
+	uintn index;
+
+	cache = cert_chain_verify_cache;
+	hash_size = spdm_get_hash_size(SPDM_CERT_CHAIN_VERIFY_CACHE_HASH_ALGO);
+	zero_mem(prefix_hash, hash_size);
+	if (cache == NULL) {
+		return FALSE;
+	}
+	if (!spdm_hash_all(SPDM_CERT_CHAIN_VERIFY_CACHE_HASH_ALGO, prefix,
+			   prefix_size, prefix_hash)) {
+		return FALSE;
+	}
+
+	for (index = 0; index < MAX_SPDM_CERT_CHAIN_VERIFY_CACHE_COUNT;
+	     index++) {
+		entry = &cache->entry[index];
+		if ((entry->last_used == 0) ||
+		    (entry->base_hash_algo != base_hash_algo) ||
+		    (entry->prefix_size != prefix_size) ||
+		    (const_compare_mem(entry->prefix_hash, prefix_hash,
+				       hash_size) != 0)) {
+			continue;
+		}
+		entry->last_used = ++cache->use_count;
+		return TRUE;
+	}
+#endif
+	return FALSE;
+}
+
+/**
+  Remember the verified certificates before the leaf certificate of a certificate chain,
+  replacing the least recently used entry.
+
+  @param  cert_chain_verify_cache         The certificate chain verify cache, or NULL.
+  @param  base_hash_algo                 base_hash_algo of a certificate chain buffer, or 0 for certificate chain data.
+  @param  prefix_size                   size in bytes of the prefix.
+  @param  prefix_hash                   The hash of the prefix from internal_spdm_cert_chain_verify_cache_lookup.
+**/
+static void internal_spdm_cert_chain_verify_cache_insert(
+	IN void *cert_chain_verify_cache, IN uint32 base_hash_algo,
+	IN uintn prefix_size, IN const uint8 *prefix_hash)
+{
+#if MAX_SPDM_CERT_CHAIN_VERIFY_CACHE_COUNT > 0
+	spdm_cert_chain_verify_cache_t *cache;
+	spdm_cert_chain_verify_cache_entry_t *entry;
+
+	cache = cert_chain_verify_cache;
+	if (cache == NULL) {
+		return;
+	}
+	entry = &cache->entry[spdm_select_lru_cache_entry(
+		&cache->entry[0].last_used,
+		MAX_SPDM_CERT_CHAIN_VERIFY_CACHE_COUNT,
+		sizeof(cache->entry[0]))];
+
+	entry->base_hash_algo = base_hash_algo;
+	entry->prefix_size = prefix_size;
+	copy_mem(entry->prefix_hash, prefix_hash,
+		 spdm_get_hash_size(SPDM_CERT_CHAIN_VERIFY_CACHE_HASH_ALGO));
+	entry->last_used = ++cache->use_count;
+#endif
+}
+
+/**
+  Verify the leaf certificate of a certificate chain whose other certificates are verified.
+
+  @param  cert_chain_data          The certificate chain data without spdm_cert_chain_t header.
+  @param  leaf_cert_buffer          The leaf certificate in the certificate chain data.
+                                   It must not be the first certificate.
+  @param  leaf_cert_buffer_size      size in bytes of the leaf certificate.
+
+  @retval TRUE  The leaf certificate is signed by the previous certificate and is valid.
+  @retval FALSE The leaf certificate verification fail.
+**/
+static boolean internal_spdm_verify_leaf_cert(IN uint8 *cert_chain_data,
+					      IN uint8 *leaf_cert_buffer,
+					      IN uintn leaf_cert_buffer_size)
+{
+	uint8 *issuer_cert_buffer;
+	uintn issuer_cert_buffer_size;
+
+	if (!x509_get_cert_from_cert_chain(
+		    cert_chain_data, leaf_cert_buffer - cert_chain_data, -1,
+		    &issuer_cert_buffer, &issuer_cert_buffer_size)) {
+		return FALSE;
+	}
+	if (!x509_verify_cert(leaf_cert_buffer, leaf_cert_buffer_size,
+			      issuer_cert_buffer, issuer_cert_buffer_size)) {
+		return FALSE;
+	}
+	return spdm_x509_certificate_check(leaf_cert_buffer,
+					   leaf_cert_buffer_size);
+}
+
 /**
   This function verifies the integrity of certificate chain data without spdm_cert_chain_t header.
 
@@ -1896,11 +3535,36 @@ spdm_get_dmtf_subject_alt_name(IN const uint8 *cert, IN intn cert_size,
 **/
 boolean spdm_verify_cert_chain_data(IN uint8 *cert_chain_data,
 				    IN uintn cert_chain_data_size)
+{
+	return spdm_verify_cert_chain_data_with_cache(NULL, cert_chain_data,
+						      cert_chain_data_size);
+}
+
+/**
+  This function verifies the integrity of certificate chain data without spdm_cert_chain_t header,
+  with a certificate chain verify cache.
+
+  The root and intermediate certificates are remembered in the cache once verified. A chain
+  whose root and intermediate certificates are in the cache only has its leaf certificate
+  verified.
+
+  @param  cert_chain_verify_cache         The certificate chain verify cache, or NULL to verify the chain in full.
+  @param  cert_chain_data          The certificate chain data without spdm_cert_chain_t header.
+  @param  cert_chain_data_size      size in bytes of the certificate chain data.
+
+  @retval TRUE  certificate chain data integrity verification pass.
+  @retval FALSE certificate chain data integrity verification fail.
+**/
+boolean spdm_verify_cert_chain_data_with_cache(
+	IN OUT void *cert_chain_verify_cache OPTIONAL, IN uint8 *cert_chain_data,
+	IN uintn cert_chain_data_size)
 {
 	uint8 *root_cert_buffer;
 	uintn root_cert_buffer_size;
 	uint8 *leaf_cert_buffer;
 	uintn leaf_cert_buffer_size;
+	uintn prefix_size;
+	uint8 prefix_hash[MAX_HASH_SIZE];
 
 	if (cert_chain_data_size >
 	    MAX_UINT16 - (sizeof(spdm_cert_chain_t) + MAX_HASH_SIZE)) {
@@ -1909,6 +3573,29 @@ boolean spdm_verify_cert_chain_data(IN uint8 *cert_chain_data,
 		return FALSE;
 	}
 
+	if (!x509_get_cert_from_cert_chain(
+		    cert_chain_data, cert_chain_data_size, -1,
+		    &leaf_cert_buffer, &leaf_cert_buffer_size)) {
+		DEBUG((DEBUG_INFO,
+		       "!!! VerifyCertificateChainData - FAIL (get leaf certificate failed)!!!\n"));
+		return FALSE;
+	}
+
+	prefix_size = leaf_cert_buffer - cert_chain_data;
+	if ((prefix_size != 0) &&
+	    internal_spdm_cert_chain_verify_cache_lookup(
+		    cert_chain_verify_cache, 0, cert_chain_data, prefix_size,
+		    prefix_hash)) {
+		if (!internal_spdm_verify_leaf_cert(cert_chain_data,
+						    leaf_cert_buffer,
+						    leaf_cert_buffer_size)) {
+			DEBUG((DEBUG_INFO,
+			       "!!! VerifyCertificateChainData - FAIL (leaf certificate check failed)!!!\n"));
+			return FALSE;
+		}
+		return TRUE;
+	}
+
 	if (!x509_get_cert_from_cert_chain(
 		    cert_chain_data, cert_chain_data_size, 0, &root_cert_buffer,
 		    &root_cert_buffer_size)) {
@@ -1924,14 +3611,6 @@ boolean spdm_verify_cert_chain_data(IN uint8 *cert_chain_data,
 		return FALSE;
 	}
 
-	if (!x509_get_cert_from_cert_chain(
-		    cert_chain_data, cert_chain_data_size, -1,
-		    &leaf_cert_buffer, &leaf_cert_buffer_size)) {
-		DEBUG((DEBUG_INFO,
-		       "!!! VerifyCertificateChainData - FAIL (get leaf certificate failed)!!!\n"));
-		return FALSE;
-	}
-
 	if (!spdm_x509_certificate_check(leaf_cert_buffer,
 					 leaf_cert_buffer_size)) {
 		DEBUG((DEBUG_INFO,
@@ -1939,6 +3618,10 @@ boolean spdm_verify_cert_chain_data(IN uint8 *cert_chain_data,
 		return FALSE;
 	}
 
+	if (prefix_size != 0) {
+		internal_spdm_cert_chain_verify_cache_insert(
+			cert_chain_verify_cache, 0, prefix_size, prefix_hash);
+	}
 	return TRUE;
 }
 
@@ -1955,6 +3638,31 @@ boolean spdm_verify_cert_chain_data(IN uint8 *cert_chain_data,
 boolean spdm_verify_certificate_chain_buffer(IN uint32 base_hash_algo,
 					     IN void *cert_chain_buffer,
 					     IN uintn cert_chain_buffer_size)
+{
+	return spdm_verify_certificate_chain_buffer_with_cache(
+		NULL, base_hash_algo, cert_chain_buffer,
+		cert_chain_buffer_size);
+}
+
+/**
+  This function verifies the integrity of certificate chain buffer including spdm_cert_chain_t header,
+  with a certificate chain verify cache.
+
+  The root certificate hash, the root and the intermediate certificates are remembered in the
+  cache once verified. A chain whose root certificate hash, root and intermediate certificates
+  are in the cache only has its leaf certificate verified.
+
+  @param  cert_chain_verify_cache         The certificate chain verify cache, or NULL to verify the chain in full.
+  @param  base_hash_algo                 SPDM base_hash_algo
+  @param  cert_chain_buffer              The certificate chain buffer including spdm_cert_chain_t header.
+  @param  cert_chain_buffer_size          size in bytes of the certificate chain buffer.
+
+  @retval TRUE  certificate chain buffer integrity verification pass.
+  @retval FALSE certificate chain buffer integrity verification fail.
+**/
+boolean spdm_verify_certificate_chain_buffer_with_cache(
+	IN OUT void *cert_chain_verify_cache OPTIONAL, IN uint32 base_hash_algo,
+	IN void *cert_chain_buffer, IN uintn cert_chain_buffer_size)
 {
 	uint8 *cert_chain_data;
 	uintn cert_chain_data_size;
@@ -1964,6 +3672,9 @@ boolean spdm_verify_certificate_chain_buffer(IN uint32 base_hash_algo,
 	uint8 calc_root_cert_hash[MAX_HASH_SIZE];
 	uint8 *leaf_cert_buffer;
 	uintn leaf_cert_buffer_size;
+	uint8 *prefix;
+	uintn prefix_size;
+	uint8 prefix_hash[MAX_HASH_SIZE];
 
 	hash_size = spdm_get_hash_size(base_hash_algo);
 
@@ -1983,6 +3694,34 @@ boolean spdm_verify_certificate_chain_buffer(IN uint32 base_hash_algo,
 			  sizeof(spdm_cert_chain_t) + hash_size;
 	cert_chain_data_size =
 		cert_chain_buffer_size - sizeof(spdm_cert_chain_t) - hash_size;
+	if (!x509_get_cert_from_cert_chain(
+		    cert_chain_data, cert_chain_data_size, -1,
+		    &leaf_cert_buffer, &leaf_cert_buffer_size)) {
+		DEBUG((DEBUG_INFO,
+		       "!!! VerifyCertificateChainBuffer - FAIL (get leaf certificate failed)!!!\n"));
+		return FALSE;
+	}
+
+	//
+	// The root certificate hash is directly followed by the certificate chain data,
+	// so the prefix covers the root certificate hash and the certificates before the leaf.
+	//
+	prefix = (uint8 *)cert_chain_buffer + sizeof(spdm_cert_chain_t);
+	prefix_size = leaf_cert_buffer - prefix;
+	if ((leaf_cert_buffer != cert_chain_data) &&
+	    internal_spdm_cert_chain_verify_cache_lookup(
+		    cert_chain_verify_cache, base_hash_algo, prefix,
+		    prefix_size, prefix_hash)) {
+		if (!internal_spdm_verify_leaf_cert(cert_chain_data,
+						    leaf_cert_buffer,
+						    leaf_cert_buffer_size)) {
+			DEBUG((DEBUG_INFO,
+			       "!!! VerifyCertificateChainBuffer - FAIL (leaf certificate check failed)!!!\n"));
+			return FALSE;
+		}
+		return TRUE;
+	}
+
 	if (!x509_get_cert_from_cert_chain(
 		    cert_chain_data, cert_chain_data_size, 0, &root_cert_buffer,
 		    &root_cert_buffer_size)) {
@@ -2007,14 +3746,6 @@ boolean spdm_verify_certificate_chain_buffer(IN uint32 base_hash_algo,
 		return FALSE;
 	}
 
-	if (!x509_get_cert_from_cert_chain(
-		    cert_chain_data, cert_chain_data_size, -1,
-		    &leaf_cert_buffer, &leaf_cert_buffer_size)) {
-		DEBUG((DEBUG_INFO,
-		       "!!! VerifyCertificateChainBuffer - FAIL (get leaf certificate failed)!!!\n"));
-		return FALSE;
-	}
-
 	if (!spdm_x509_certificate_check(leaf_cert_buffer,
 					 leaf_cert_buffer_size)) {
 		DEBUG((DEBUG_INFO,
@@ -2022,5 +3753,10 @@ boolean spdm_verify_certificate_chain_buffer(IN uint32 base_hash_algo,
 		return FALSE;
 	}
 
+	if (leaf_cert_buffer != cert_chain_data) {
+		internal_spdm_cert_chain_verify_cache_insert(
+			cert_chain_verify_cache, base_hash_algo, prefix_size,
+			prefix_hash);
+	}
 	return TRUE;
 }
@@ -0,0 +1,284 @@
+/**
+    Copyright Notice:
+    Copyright 2021 DMTF. All rights reserved.
+    License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+**/
+
+#include "spdm_requester_lib_internal.h"
+
+/**
+  Start the current stage of a device.
+
+  The stage_time of the stage holds its start time until the stage is complete.
+
+  @param  device                       The device to attest.
+  @param  get_time                      A function to time the stages, or NULL.
+
+  @retval RETURN_SUCCESS               The stage is started, or the device reached SPDM_ATTESTATION_STAGE_DONE.
+  @return other                        The stage cannot be started.
+**/
+static return_status
+internal_spdm_attestation_begin_stage(IN OUT spdm_attestation_device_t *device,
+				      IN spdm_attestation_get_time_func get_time)
+{
+	if ((device->stage == SPDM_ATTESTATION_STAGE_GET_MEASUREMENT) &&
+	    (device->measurement_record == NULL)) {
+		device->stage = SPDM_ATTESTATION_STAGE_DONE;
+	}
+	if (device->stage == SPDM_ATTESTATION_STAGE_DONE) {
+		return RETURN_SUCCESS;
+	}
+
+	if (get_time != NULL) {
+		device->stage_time[device->stage] = get_time();
+	}
+
+	switch (device->stage) {
+	case SPDM_ATTESTATION_STAGE_INIT_CONNECTION:
+		return spdm_begin_init_connection(device->spdm_context, FALSE);
+	case SPDM_ATTESTATION_STAGE_GET_DIGEST:
+		return spdm_begin_get_digest(device->spdm_context,
+					     &device->slot_mask,
+					     device->total_digest_buffer);
+	case SPDM_ATTESTATION_STAGE_GET_CERTIFICATE:
+		return spdm_begin_get_certificate(device->spdm_context,
+						  device->slot_id,
+						  &device->cert_chain_size,
+						  device->cert_chain);
+	case SPDM_ATTESTATION_STAGE_CHALLENGE:
+		return spdm_begin_challenge(device->spdm_context,
+					    device->slot_id,
+					    device->measurement_hash_type,
+					    device->measurement_hash);
+	case SPDM_ATTESTATION_STAGE_GET_MEASUREMENT:
+		return spdm_begin_get_measurement(
+			device->spdm_context, NULL,
+			device->measurement_attribute,
+			SPDM_GET_MEASUREMENTS_REQUEST_MEASUREMENT_OPERATION_ALL_MEASUREMENTS,
+			device->slot_id, &device->number_of_blocks,
+			&device->measurement_record_length,
+			device->measurement_record);
+	default:
+		ASSERT(FALSE);
+		return RETURN_UNSUPPORTED;
+	}
+}
+
+/**
+  Record the end of the current stage of a device.
+
+  @param  device                       The device to attest.
+  @param  get_time                      A function to time the stages, or NULL.
+  @param  status                       The status of the stage.
+**/
+static void
+internal_spdm_attestation_end_stage(IN OUT spdm_attestation_device_t *device,
+				    IN spdm_attestation_get_time_func get_time,
+				    IN return_status status)
+{
+	if (get_time != NULL) {
+		device->stage_time[device->stage] =
+			get_time() - device->stage_time[device->stage];
+	}
+	//
+	// RETURN_NOT_READY marks a device that is still pending, so a stage that
+	// fails with it is reported as a device error.
+	//
+	if (status == RETURN_NOT_READY) {
+		status = RETURN_DEVICE_ERROR;
+	}
+	if (RETURN_ERROR(status)) {
+		device->status = status;
+	}
+}
+
+/**
+  Record the end of the attestation of a device.
+
+  @param  device                       The device to attest.
+  @param  get_time                      A function to time the stages, or NULL.
+**/
+static void
+internal_spdm_attestation_finish(IN OUT spdm_attestation_device_t *device,
+				 IN spdm_attestation_get_time_func get_time)
+{
+	if (device->stage == SPDM_ATTESTATION_STAGE_DONE) {
+		device->status = RETURN_SUCCESS;
+	}
+	if (get_time != NULL) {
+		device->total_time = get_time() - device->total_time;
+	}
+}
+
+/**
+  Drive a device until it waits for a response that is not ready, or its attestation ends.
+
+  @param  device                       The device to attest.
+  @param  poll_timeout                  The timeout passed to receive_message.
+  @param  get_time                      A function to time the stages, or NULL.
+
+  @retval TRUE                         The device waits for a response.
+  @retval FALSE                        The attestation of the device ended.
+**/
+static boolean internal_spdm_attestation_run(IN OUT spdm_attestation_device_t *device,
+					     IN uint64 poll_timeout,
+					     IN spdm_attestation_get_time_func get_time)
+{
+	spdm_context_t *spdm_context;
+	spdm_requester_step_action_t action;
+	uint8 transport_message[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+	uintn transport_message_size;
+	return_status status;
+
+	spdm_context = device->spdm_context;
+	while (TRUE) {
+		transport_message_size = sizeof(transport_message);
+		status = spdm_requester_step(spdm_context, &action,
+					     &transport_message_size,
+					     transport_message);
+		switch (action) {
+		case SPDM_REQUESTER_STEP_ACTION_SEND:
+			status = spdm_context->send_message(
+				spdm_context, transport_message_size,
+				transport_message, 0);
+			if (RETURN_ERROR(status)) {
+				spdm_requester_step_abort(spdm_context);
+				internal_spdm_attestation_end_stage(
+					device, get_time, RETURN_DEVICE_ERROR);
+				internal_spdm_attestation_finish(device,
+								 get_time);
+				return FALSE;
+			}
+			break;
+
+		case SPDM_REQUESTER_STEP_ACTION_RECEIVE:
+			status = spdm_context->receive_message(
+				spdm_context, &transport_message_size,
+				transport_message, poll_timeout);
+			if (status == RETURN_TIMEOUT) {
+				return TRUE;
+			}
+			if (RETURN_ERROR(status)) {
+				spdm_requester_step_receive(spdm_context, 0,
+							    NULL);
+			} else {
+				spdm_requester_step_receive(
+					spdm_context, transport_message_size,
+					transport_message);
+			}
+			break;
+
+		default:
+			internal_spdm_attestation_end_stage(device, get_time,
+							    status);
+			if (RETURN_ERROR(status)) {
+				internal_spdm_attestation_finish(device,
+								 get_time);
+				return FALSE;
+			}
+			device->stage = (spdm_attestation_stage_t)(device->stage + 1);
+			status = internal_spdm_attestation_begin_stage(device,
+								       get_time);
+			if (RETURN_ERROR(status)) {
+				internal_spdm_attestation_end_stage(
+					device, get_time, status);
+			}
+			if (RETURN_ERROR(status) ||
+			    (device->stage == SPDM_ATTESTATION_STAGE_DONE)) {
+				internal_spdm_attestation_finish(device,
+								 get_time);
+				return FALSE;
+			}
+			break;
+		}
+	}
+}
+
+/**
+  Attest a set of devices: VCA, GET_DIGEST, GET_CERTIFICATE, CHALLENGE and GET_MEASUREMENT.
+
+  The devices are attested concurrently from the calling thread: every device sends its
+  next request as soon as its previous response is processed, and the responses are polled
+  with the receive_message function registered on each SPDM context with poll_timeout.
+  A device whose response is not ready (RETURN_TIMEOUT) does not block the other devices.
+
+  Each device needs its own SPDM context. The contexts may share the immutable local state,
+  such as the trusted root certificate hash and the local key, by being initialized with
+  spdm_init_context_with_local_context.
+
+  All devices are driven from the calling thread, so their SPDM contexts may share one
+  certificate chain verify cache registered by spdm_register_cert_chain_verify_cache.
+  Several spdm_attest_devices may run on different threads for disjoint sets of devices,
+  as long as the threads do not share a certificate chain cache or a certificate chain
+  verify cache, and the shared local context is not modified by spdm_set_data while they run.
+
+  The result of each device is returned in its spdm_attestation_device_t.
+
+  @param  device                       An array of devices to attest.
+  @param  device_count                  The number of devices in the array.
+  @param  poll_timeout                  The timeout passed to receive_message, in the unit of 100ns.
+                                       It must not be 0, which would wait for each device in turn.
+  @param  get_time                      A function to time the stages. NULL means the stages are not timed.
+
+  @retval RETURN_SUCCESS               All devices are attested.
+  @retval RETURN_INVALID_PARAMETER     poll_timeout is 0.
+  @retval RETURN_DEVICE_ERROR          At least one device failed. See its stage and status.
+**/
+return_status spdm_attest_devices(IN OUT spdm_attestation_device_t *device,
+				  IN uintn device_count,
+				  IN uint64 poll_timeout,
+				  IN spdm_attestation_get_time_func get_time OPTIONAL)
+{
+	uintn index;
+	uintn pending_count;
+	return_status status;
+
+	if (poll_timeout == 0) {
+		return RETURN_INVALID_PARAMETER;
+	}
+
+	//
+	// Send the first request of every device before waiting for any response.
+	//
+	pending_count = 0;
+	for (index = 0; index < device_count; index++) {
+		zero_mem(device[index].stage_time,
+			 sizeof(device[index].stage_time));
+		device[index].total_time = (get_time != NULL) ? get_time() : 0;
+		device[index].stage = SPDM_ATTESTATION_STAGE_INIT_CONNECTION;
+		device[index].status = RETURN_NOT_READY;
+		status = internal_spdm_attestation_begin_stage(&device[index],
+							       get_time);
+		if (RETURN_ERROR(status)) {
+			internal_spdm_attestation_end_stage(&device[index],
+							    get_time, status);
+			internal_spdm_attestation_finish(&device[index],
+							 get_time);
+			continue;
+		}
+		pending_count++;
+	}
+
+	//
+	// Round-robin over the devices which still wait for a response.
+	//
+	while (pending_count != 0) {
+		for (index = 0; index < device_count; index++) {
+			if (device[index].status != RETURN_NOT_READY) {
+				continue;
+			}
+			if (!internal_spdm_attestation_run(&device[index],
+							   poll_timeout,
+							   get_time)) {
+				pending_count--;
+			}
+		}
+	}
+
+	for (index = 0; index < device_count; index++) {
+		if (device[index].stage != SPDM_ATTESTATION_STAGE_DONE) {
+			return RETURN_DEVICE_ERROR;
+		}
+	}
+	return RETURN_SUCCESS;
+}
@@ -0,0 +1,287 @@
+/**
+    Copyright Notice:
+    Copyright 2021 DMTF. All rights reserved.
+    License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+**/
+
+#include "spdm_requester_lib_internal.h"
+
+/**
+  Return the size in bytes of a certificate chain cache.
+
+  @param  entry_count                   The number of certificate chains the cache holds.
+
+  @return the size in bytes of the certificate chain cache.
+**/
+uintn spdm_get_cert_chain_cache_size(IN uintn entry_count)
+{
+	return sizeof(spdm_cert_chain_cache_t) +
+	       sizeof(spdm_cert_chain_cache_entry_t) * entry_count;
+}
+
+/**
+  Initialize an empty certificate chain cache.
+
+  @param  cert_chain_cache               A pointer to the certificate chain cache.
+  @param  entry_count                   The number of certificate chains the cache holds.
+**/
+void spdm_init_cert_chain_cache(IN void *cert_chain_cache,
+				IN uintn entry_count)
+{
+	spdm_cert_chain_cache_t *cache;
+
+	cache = cert_chain_cache;
+	zero_mem(cache, spdm_get_cert_chain_cache_size(entry_count));
+	cache->entry_count = (uint32)entry_count;
+	cache->entry = (void *)(cache + 1);
+}
+
+/**
+  Register a verified peer certificate chain cache and its persistent store.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  cert_chain_cache               A pointer to the certificate chain cache, or NULL.
+  @param  load_func                     The function to load a chain from the persistent store, or NULL.
+  @param  save_func                     The function to save a chain to the persistent store, or NULL.
+**/
+void spdm_register_cert_chain_cache(
+	IN void *context, IN void *cert_chain_cache OPTIONAL,
+	IN spdm_cert_chain_store_load_func load_func OPTIONAL,
+	IN spdm_cert_chain_store_save_func save_func OPTIONAL)
+{
+	spdm_context_t *spdm_context;
+
+	spdm_context = context;
+	spdm_context->cert_chain_cache = cert_chain_cache;
+	spdm_context->cert_chain_store_load_func = (uintn)load_func;
+	spdm_context->cert_chain_store_save_func = (uintn)save_func;
+	return;
+}
+
+/**
+  Find the entry of a digest in the certificate chain cache.
+
+  @param  cache                         A pointer to the certificate chain cache.
+  @param  base_hash_algo                 The hash algorithm of the digest.
+  @param  digest                       The digest of the certificate chain buffer.
+  @param  hash_size                     The size in bytes of the digest.
+
+  @return the entry, or NULL if the digest is not cached.
+**/
+static spdm_cert_chain_cache_entry_t *
+internal_spdm_find_cert_chain_cache_entry(IN spdm_cert_chain_cache_t *cache,
+					  IN uint32 base_hash_algo,
+					  IN void *digest, IN uintn hash_size)
+{
+	uint32 index;
+
+	for (index = 0; index < cache->entry_count; index++) {
+		if ((cache->entry[index].base_hash_algo == base_hash_algo) &&
+		    (const_compare_mem(cache->entry[index].digest, digest,
+				       hash_size) == 0)) {
+			return &cache->entry[index];
+		}
+	}
+	return NULL;
+}
+
+/**
+  Insert a certificate chain into the in-memory cache, replacing the least recently used entry.
+
+  @param  cache                         A pointer to the certificate chain cache.
+  @param  base_hash_algo                 The hash algorithm of the digest.
+  @param  digest                       The digest of the certificate chain buffer.
+  @param  hash_size                     The size in bytes of the digest.
+  @param  cert_chain_size                size in bytes of the certificate chain buffer.
+  @param  cert_chain                    The certificate chain buffer including spdm_cert_chain_t header.
+**/
+static void internal_spdm_insert_cert_chain_cache_entry(
+	IN spdm_cert_chain_cache_t *cache, IN uint32 base_hash_algo,
+	IN void *digest, IN uintn hash_size, IN uintn cert_chain_size,
+	IN void *cert_chain)
+{
+	spdm_cert_chain_cache_entry_t *entry;
+
+	if ((cache->entry_count == 0) ||
+	    (cert_chain_size > MAX_SPDM_CERT_CHAIN_SIZE)) {
+		return;
+	}
+
+	entry = internal_spdm_find_cert_chain_cache_entry(cache, base_hash_algo,
+							  digest, hash_size);
+	if (entry == NULL) {
+		entry = &cache->entry[spdm_select_lru_cache_entry(
+			&cache->entry[0].last_used, cache->entry_count,
+			sizeof(cache->entry[0]))];
+	}
+
+	zero_mem(entry->digest, sizeof(entry->digest));
+	copy_mem(entry->digest, digest, hash_size);
+	entry->base_hash_algo = base_hash_algo;
+	entry->last_used = ++cache->use_count;
+	entry->cert_chain_size = cert_chain_size;
+	copy_mem(entry->cert_chain, cert_chain, cert_chain_size);
+}
+
+/**
+  This function gets the certificate chain in one slot from the certificate chain cache,
+  instead of GET_CERTIFICATE.
+
+  The cache is looked up by the digest of the slot in the last DIGESTS. A cached chain
+  was verified when it was inserted, so only its digest and the provisioned root
+  certificate hash or certificate chain are checked. No message is added to message_b,
+  as no GET_CERTIFICATE is exchanged with the device.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  slot_id                      The number of slot for the certificate chain.
+  @param  cert_chain_size                On input, indicate the size in bytes of the destination buffer to store the digest buffer.
+                                       On output, indicate the size in bytes of the certificate chain.
+  @param  cert_chain                    A pointer to a destination buffer to store the certificate chain.
+
+  @retval RETURN_SUCCESS               The certificate chain is got from the cache.
+  @retval RETURN_NOT_FOUND             The certificate chain is not cached. GET_CERTIFICATE is needed.
+  @retval RETURN_BUFFER_TOO_SMALL      The cert_chain is too small.
+**/
+return_status spdm_get_cached_certificate(IN spdm_context_t *spdm_context,
+					  IN uint8 slot_id,
+					  IN OUT uintn *cert_chain_size,
+					  OUT void *cert_chain)
+{
+	spdm_cert_chain_cache_t *cache;
+	spdm_cert_chain_cache_entry_t *entry;
+	spdm_cert_chain_store_load_func load_func;
+	spdm_connection_info_t *connection_info;
+	uint32 base_hash_algo;
+	uintn hash_size;
+	uint8 *digest;
+	uint8 hash[MAX_HASH_SIZE];
+	uintn size;
+
+	cache = spdm_context->cert_chain_cache;
+	load_func = (spdm_cert_chain_store_load_func)
+			    spdm_context->cert_chain_store_load_func;
+	connection_info = &spdm_context->connection_info;
+	if ((cache == NULL) && (load_func == NULL)) {
+		return RETURN_NOT_FOUND;
+	}
+	if ((connection_info->connection_state !=
+	     SPDM_CONNECTION_STATE_AFTER_DIGESTS) &&
+	    (connection_info->connection_state !=
+	     SPDM_CONNECTION_STATE_AFTER_CERTIFICATE)) {
+		return RETURN_NOT_FOUND;
+	}
+	if ((connection_info->peer_digest_slot_mask & (1 << slot_id)) == 0) {
+		return RETURN_NOT_FOUND;
+	}
+
+	base_hash_algo = connection_info->algorithm.base_hash_algo;
+	hash_size = spdm_get_hash_size(base_hash_algo);
+	digest = connection_info->peer_digest[slot_id];
+
+	entry = NULL;
+	if (cache != NULL) {
+		entry = internal_spdm_find_cert_chain_cache_entry(
+			cache, base_hash_algo, digest, hash_size);
+	}
+	if (entry != NULL) {
+		entry->last_used = ++cache->use_count;
+		size = entry->cert_chain_size;
+		copy_mem(connection_info->peer_used_cert_chain_buffer,
+			 entry->cert_chain, size);
+	} else {
+		if (load_func == NULL) {
+			return RETURN_NOT_FOUND;
+		}
+		size = sizeof(connection_info->peer_used_cert_chain_buffer);
+		if (!load_func(spdm_context, base_hash_algo, digest, &size,
+			       connection_info->peer_used_cert_chain_buffer)) {
+			return RETURN_NOT_FOUND;
+		}
+	}
+	connection_info->peer_used_cert_chain_buffer_size = size;
+	spdm_invalidate_peer_cert_chain_hash(spdm_context);
+
+	//
+	// The hash fills the peer certificate chain hash cache for CHALLENGE_AUTH.
+	//
+	spdm_calculate_cert_chain_hash(spdm_context,
+				       connection_info->peer_used_cert_chain_buffer,
+				       size, hash);
+	if ((const_compare_mem(hash, digest, hash_size) != 0) ||
+	    !spdm_verify_peer_cert_chain_buffer_provision(
+		    spdm_context, connection_info->peer_used_cert_chain_buffer,
+		    size)) {
+		DEBUG((DEBUG_INFO,
+		       "spdm_get_cached_certificate - stale entry for slot %d\n",
+		       slot_id));
+		if (entry != NULL) {
+			entry->base_hash_algo = 0;
+			entry->last_used = 0;
+		}
+		connection_info->peer_used_cert_chain_buffer_size = 0;
+		spdm_invalidate_peer_cert_chain_hash(spdm_context);
+		return RETURN_NOT_FOUND;
+	}
+	if ((entry == NULL) && (cache != NULL)) {
+		internal_spdm_insert_cert_chain_cache_entry(
+			cache, base_hash_algo, digest, hash_size, size,
+			connection_info->peer_used_cert_chain_buffer);
+	}
+
+	DEBUG((DEBUG_INFO, "spdm_get_cached_certificate - hit for slot %d\n",
+	       slot_id));
+	connection_info->connection_state =
+		SPDM_CONNECTION_STATE_AFTER_CERTIFICATE;
+	spdm_context->error_state = SPDM_STATUS_SUCCESS;
+
+	if (cert_chain_size != NULL) {
+		if (*cert_chain_size < size) {
+			*cert_chain_size = size;
+			return RETURN_BUFFER_TOO_SMALL;
+		}
+		*cert_chain_size = size;
+		if (cert_chain != NULL) {
+			copy_mem(cert_chain,
+				 connection_info->peer_used_cert_chain_buffer,
+				 size);
+		}
+	}
+	return RETURN_SUCCESS;
+}
+
+/**
+  This function records a certificate chain verified after GET_CERTIFICATE
+  in the certificate chain cache and its persistent store.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  cert_chain_size                size in bytes of the certificate chain buffer.
+  @param  cert_chain                    The verified certificate chain buffer including spdm_cert_chain_t header.
+**/
+void spdm_cache_verified_certificate(IN spdm_context_t *spdm_context,
+				     IN uintn cert_chain_size,
+				     IN void *cert_chain)
+{
+	spdm_cert_chain_store_save_func save_func;
+	uint32 base_hash_algo;
+	uint8 digest[MAX_HASH_SIZE];
+
+	save_func = (spdm_cert_chain_store_save_func)
+			    spdm_context->cert_chain_store_save_func;
+	if ((spdm_context->cert_chain_cache == NULL) && (save_func == NULL)) {
+		return;
+	}
+
+	base_hash_algo = spdm_context->connection_info.algorithm.base_hash_algo;
+	spdm_calculate_cert_chain_hash(spdm_context, cert_chain,
+				       cert_chain_size, digest);
+	if (spdm_context->cert_chain_cache != NULL) {
+		internal_spdm_insert_cert_chain_cache_entry(
+			spdm_context->cert_chain_cache, base_hash_algo, digest,
+			spdm_get_hash_size(base_hash_algo), cert_chain_size,
+			cert_chain);
+	}
+	if (save_func != NULL) {
+		save_func(spdm_context, base_hash_algo, digest,
+			  cert_chain_size, cert_chain);
+	}
+}
@@ -21,46 +21,27 @@ typedef struct {
 #pragma pack()
 
 /**
-  This function sends CHALLENGE
+  This function builds CHALLENGE
   to authenticate the device based upon the key in one slot.
 
-  This function verifies the signature in the challenge auth.
-
-  If basic mutual authentication is requested from the responder,
-  this function also perform the basic mutual authentication.
-
   @param  spdm_context                  A pointer to the SPDM context.
   @param  slot_id                      The number of slot for the challenge.
   @param  measurement_hash_type          The type of the measurement hash.
-  @param  measurement_hash              A pointer to a destination buffer to store the measurement hash.
+  @param  request                      A pointer to a destination buffer to store the CHALLENGE request.
 
-  @retval RETURN_SUCCESS               The challenge auth is got successfully.
-  @retval RETURN_DEVICE_ERROR          A device error occurs when communicates with the device.
-  @retval RETURN_SECURITY_VIOLATION    Any verification fails.
+  @retval RETURN_SUCCESS               The CHALLENGE is built.
+  @retval RETURN_UNSUPPORTED           The capabilities or the connection state do not allow CHALLENGE.
+  @retval RETURN_INVALID_PARAMETER     The slot_id is invalid.
 **/
-return_status try_spdm_challenge(IN void *context, IN uint8 slot_id,
-				 IN uint8 measurement_hash_type,
-				 OUT void *measurement_hash)
+return_status spdm_build_challenge_request(IN spdm_context_t *spdm_context,
+					   IN uint8 slot_id,
+					   IN uint8 measurement_hash_type,
+					   OUT void *request)
 {
-	return_status status;
-	boolean result;
-	spdm_challenge_request_t spdm_request;
-	spdm_challenge_auth_response_max_t spdm_response;
-	uintn spdm_response_size;
-	uint8 *ptr;
-	void *cert_chain_hash;
-	uintn hash_size;
-	uintn measurement_summary_hash_size;
-	void *nonce;
-	void *measurement_summary_hash;
-	uint16 opaque_length;
-	void *opaque;
-	void *signature;
-	uintn signature_size;
-	spdm_context_t *spdm_context;
-	spdm_challenge_auth_response_attribute_t auth_attribute;
+	spdm_challenge_request_t *spdm_request;
+
+	spdm_request = request;
 
-	spdm_context = context;
 	spdm_reset_message_buffer_via_request_code(spdm_context,
 									SPDM_CHALLENGE);
 	if (!spdm_is_capabilities_flag_supported(
@@ -77,76 +58,112 @@ return_status try_spdm_challenge(IN void *context, IN uint8 slot_id,
 		return RETURN_INVALID_PARAMETER;
 	}
 	if ((slot_id == 0xFF) &&
-	    (spdm_context->local_context.peer_cert_chain_provision_size == 0)) {
+	    (spdm_context->local_context->peer_cert_chain_provision_size == 0)) {
 		return RETURN_INVALID_PARAMETER;
 	}
 
 	spdm_context->error_state = SPDM_STATUS_ERROR_DEVICE_NO_CAPABILITIES;
 
 	if (spdm_is_version_supported(spdm_context, SPDM_MESSAGE_VERSION_11)) {
-		spdm_request.header.spdm_version = SPDM_MESSAGE_VERSION_11;
+		spdm_request->header.spdm_version = SPDM_MESSAGE_VERSION_11;
 	} else {
-		spdm_request.header.spdm_version = SPDM_MESSAGE_VERSION_10;
+		spdm_request->header.spdm_version = SPDM_MESSAGE_VERSION_10;
 	}
-	spdm_request.header.request_response_code = SPDM_CHALLENGE;
-	spdm_request.header.param1 = slot_id;
-	spdm_request.header.param2 = measurement_hash_type;
-	spdm_get_random_number(SPDM_NONCE_SIZE, spdm_request.nonce);
+	spdm_request->header.request_response_code = SPDM_CHALLENGE;
+	spdm_request->header.param1 = slot_id;
+	spdm_request->header.param2 = measurement_hash_type;
+	spdm_get_random_number(SPDM_NONCE_SIZE, spdm_request->nonce);
 	DEBUG((DEBUG_INFO, "ClientNonce - "));
-	internal_dump_data(spdm_request.nonce, SPDM_NONCE_SIZE);
+	internal_dump_data(spdm_request->nonce, SPDM_NONCE_SIZE);
 	DEBUG((DEBUG_INFO, "\n"));
-	status = spdm_send_spdm_request(spdm_context, NULL,
-					sizeof(spdm_request), &spdm_request);
-	if (RETURN_ERROR(status)) {
-		return RETURN_DEVICE_ERROR;
-	}
+	return RETURN_SUCCESS;
+}
+
+/**
+  This function processes CHALLENGE_AUTH, the response to CHALLENGE.
+
+  This function verifies the signature in the challenge auth.
+  The connection state is not changed, because basic mutual authentication
+  may still be requested.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  slot_id                      The number of slot for the challenge.
+  @param  measurement_hash_type          The type of the measurement hash.
+  @param  request                      A pointer to the CHALLENGE request.
+  @param  spdm_response_size            size in bytes of the response.
+  @param  response                     A pointer to the response.
+  @param  measurement_hash              A pointer to a destination buffer to store the measurement hash.
+  @param  basic_mut_auth_req            On output, indicates if basic mutual authentication is requested.
+
+  @retval RETURN_SUCCESS               The CHALLENGE_AUTH is processed.
+  @retval RETURN_DEVICE_ERROR          The response is invalid.
+  @retval RETURN_SECURITY_VIOLATION    Any verification fails.
+  @retval RETURN_NO_RESPONSE           The responder is busy.
+**/
+return_status spdm_process_challenge_auth_response(
+	IN spdm_context_t *spdm_context, IN uint8 slot_id,
+	IN uint8 measurement_hash_type, IN void *request,
+	IN uintn spdm_response_size, IN void *response,
+	OUT void *measurement_hash, OUT boolean *basic_mut_auth_req)
+{
+	return_status status;
+	boolean result;
+	spdm_challenge_request_t *spdm_request;
+	spdm_challenge_auth_response_max_t *spdm_response;
+	uint8 *ptr;
+	void *cert_chain_hash;
+	uintn hash_size;
+	uintn measurement_summary_hash_size;
+	void *nonce;
+	void *measurement_summary_hash;
+	uint16 opaque_length;
+	void *opaque;
+	void *signature;
+	uintn signature_size;
+	spdm_challenge_auth_response_attribute_t auth_attribute;
+
+	spdm_request = request;
+	spdm_response = response;
 
-	spdm_response_size = sizeof(spdm_response);
-	zero_mem(&spdm_response, sizeof(spdm_response));
-	status = spdm_receive_spdm_response(
-		spdm_context, NULL, &spdm_response_size, &spdm_response);
-	if (RETURN_ERROR(status)) {
-		return RETURN_DEVICE_ERROR;
-	}
 	if (spdm_response_size < sizeof(spdm_message_header_t)) {
 		return RETURN_DEVICE_ERROR;
 	}
-	if (spdm_response.header.spdm_version != spdm_request.header.spdm_version) {
+	if (spdm_response->header.spdm_version != spdm_request->header.spdm_version) {
 		return RETURN_DEVICE_ERROR;
 	}
-	if (spdm_response.header.request_response_code == SPDM_ERROR) {
+	if (spdm_response->header.request_response_code == SPDM_ERROR) {
 		status = spdm_handle_error_response_main(
 			spdm_context, NULL, 
 			NULL, 0, &spdm_response_size,
-			&spdm_response, SPDM_CHALLENGE, SPDM_CHALLENGE_AUTH,
+			spdm_response, SPDM_CHALLENGE, SPDM_CHALLENGE_AUTH,
 			sizeof(spdm_challenge_auth_response_max_t));
 		if (RETURN_ERROR(status)) {
 			return status;
 		}
-	} else if (spdm_response.header.request_response_code !=
+	} else if (spdm_response->header.request_response_code !=
 		   SPDM_CHALLENGE_AUTH) {
 		return RETURN_DEVICE_ERROR;
 	}
 	if (spdm_response_size < sizeof(spdm_challenge_auth_response_t)) {
 		return RETURN_DEVICE_ERROR;
 	}
-	if (spdm_response_size > sizeof(spdm_response)) {
+	if (spdm_response_size > sizeof(spdm_challenge_auth_response_max_t)) {
 		return RETURN_DEVICE_ERROR;
 	}
-	*(uint8 *)&auth_attribute = spdm_response.header.param1;
-	if (spdm_response.header.spdm_version == SPDM_MESSAGE_VERSION_11 && slot_id == 0xFF) {
+	*(uint8 *)&auth_attribute = spdm_response->header.param1;
+	if (spdm_response->header.spdm_version == SPDM_MESSAGE_VERSION_11 && slot_id == 0xFF) {
 		if (auth_attribute.slot_id != 0xF) {
 			return RETURN_DEVICE_ERROR;
 		}
-		if (spdm_response.header.param2 != 0) {
+		if (spdm_response->header.param2 != 0) {
 			return RETURN_DEVICE_ERROR;
 		}
 	} else {
-		if ((spdm_response.header.spdm_version == SPDM_MESSAGE_VERSION_11 && auth_attribute.slot_id != slot_id) ||
-		    (spdm_response.header.spdm_version == SPDM_MESSAGE_VERSION_10 && *(uint8 *)&auth_attribute != slot_id)) {
+		if ((spdm_response->header.spdm_version == SPDM_MESSAGE_VERSION_11 && auth_attribute.slot_id != slot_id) ||
+		    (spdm_response->header.spdm_version == SPDM_MESSAGE_VERSION_10 && *(uint8 *)&auth_attribute != slot_id)) {
 			return RETURN_DEVICE_ERROR;
 		}
-		if (spdm_response.header.param2 != (1 << slot_id)) {
+		if (spdm_response->header.param2 != (1 << slot_id)) {
 			return RETURN_DEVICE_ERROR;
 		}
 	}
@@ -172,7 +189,7 @@ return_status try_spdm_challenge(IN void *context, IN uint8 slot_id,
 		return RETURN_DEVICE_ERROR;
 	}
 
-	ptr = spdm_response.cert_chain_hash;
+	ptr = spdm_response->cert_chain_hash;
 
 	cert_chain_hash = ptr;
 	ptr += hash_size;
@@ -209,8 +226,8 @@ return_status try_spdm_challenge(IN void *context, IN uint8 slot_id,
 	//
 	// Cache data
 	//
-	status = spdm_append_message_c(spdm_context, &spdm_request,
-				       sizeof(spdm_request));
+	status = spdm_append_message_c(spdm_context, spdm_request,
+				       sizeof(spdm_challenge_request_t));
 	if (RETURN_ERROR(status)) {
 		return RETURN_SECURITY_VIOLATION;
 	}
@@ -224,7 +241,7 @@ return_status try_spdm_challenge(IN void *context, IN uint8 slot_id,
 			     hash_size + SPDM_NONCE_SIZE +
 			     measurement_summary_hash_size + sizeof(uint16) +
 			     opaque_length + signature_size;
-	status = spdm_append_message_c(spdm_context, &spdm_response,
+	status = spdm_append_message_c(spdm_context, spdm_response,
 				       spdm_response_size - signature_size);
 	if (RETURN_ERROR(status)) {
 		return RETURN_SECURITY_VIOLATION;
@@ -253,7 +270,69 @@ return_status try_spdm_challenge(IN void *context, IN uint8 slot_id,
 			 measurement_summary_hash_size);
 	}
 
-	if (auth_attribute.basic_mut_auth_req == 1) {
+	*basic_mut_auth_req = (boolean)(auth_attribute.basic_mut_auth_req == 1);
+	return RETURN_SUCCESS;
+}
+
+/**
+  This function sends CHALLENGE
+  to authenticate the device based upon the key in one slot.
+
+  This function verifies the signature in the challenge auth.
+
+  If basic mutual authentication is requested from the responder,
+  this function also perform the basic mutual authentication.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  slot_id                      The number of slot for the challenge.
+  @param  measurement_hash_type          The type of the measurement hash.
+  @param  measurement_hash              A pointer to a destination buffer to store the measurement hash.
+
+  @retval RETURN_SUCCESS               The challenge auth is got successfully.
+  @retval RETURN_DEVICE_ERROR          A device error occurs when communicates with the device.
+  @retval RETURN_SECURITY_VIOLATION    Any verification fails.
+**/
+return_status try_spdm_challenge(IN void *context, IN uint8 slot_id,
+				 IN uint8 measurement_hash_type,
+				 OUT void *measurement_hash)
+{
+	return_status status;
+	spdm_challenge_request_t spdm_request;
+	spdm_challenge_auth_response_max_t spdm_response;
+	uintn spdm_response_size;
+	boolean basic_mut_auth_req;
+	spdm_context_t *spdm_context;
+
+	spdm_context = context;
+	status = spdm_build_challenge_request(spdm_context, slot_id,
+					      measurement_hash_type,
+					      &spdm_request);
+	if (RETURN_ERROR(status)) {
+		return status;
+	}
+
+	status = spdm_send_spdm_request(spdm_context, NULL,
+					sizeof(spdm_request), &spdm_request);
+	if (RETURN_ERROR(status)) {
+		return RETURN_DEVICE_ERROR;
+	}
+
+	spdm_response_size = sizeof(spdm_response);
+	zero_mem(&spdm_response, sizeof(spdm_response));
+	status = spdm_receive_spdm_response(
+		spdm_context, NULL, &spdm_response_size, &spdm_response);
+	if (RETURN_ERROR(status)) {
+		return RETURN_DEVICE_ERROR;
+	}
+	status = spdm_process_challenge_auth_response(
+		spdm_context, slot_id, measurement_hash_type, &spdm_request,
+		spdm_response_size, &spdm_response, measurement_hash,
+		&basic_mut_auth_req);
+	if (RETURN_ERROR(status)) {
+		return status;
+	}
+
+	if (basic_mut_auth_req) {
 		DEBUG((DEBUG_INFO, "BasicMutAuth :\n"));
 		status = spdm_encapsulated_request(spdm_context, NULL, 0, NULL);
 		DEBUG((DEBUG_INFO,
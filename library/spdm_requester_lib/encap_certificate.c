@@ -57,7 +57,7 @@ return_status spdm_get_encap_response_certificate(IN void *context,
 		return RETURN_SUCCESS;
 	}
 
-	if (spdm_context->local_context.local_cert_chain_provision == NULL) {
+	if (spdm_context->local_context->local_cert_chain_provision == NULL) {
 		spdm_generate_encap_error_response(
 			spdm_context, SPDM_ERROR_CODE_UNSUPPORTED_REQUEST,
 			SPDM_GET_CERTIFICATE, response_size, response);
@@ -66,7 +66,7 @@ return_status spdm_get_encap_response_certificate(IN void *context,
 
 	slot_id = spdm_request->header.param1;
 
-	if (slot_id >= spdm_context->local_context.slot_count) {
+	if (slot_id >= spdm_context->local_context->slot_count) {
 		spdm_generate_encap_error_response(
 			spdm_context, SPDM_ERROR_CODE_INVALID_REQUEST, 0,
 			response_size, response);
@@ -80,7 +80,7 @@ return_status spdm_get_encap_response_certificate(IN void *context,
 	}
 
 	if (offset >= spdm_context->local_context
-			      .local_cert_chain_provision_size[slot_id]) {
+			      ->local_cert_chain_provision_size[slot_id]) {
 		spdm_generate_encap_error_response(
 			spdm_context, SPDM_ERROR_CODE_INVALID_REQUEST, 0,
 			response_size, response);
@@ -89,14 +89,14 @@ return_status spdm_get_encap_response_certificate(IN void *context,
 
 	if ((uintn)(offset + length) >
 	    spdm_context->local_context
-		    .local_cert_chain_provision_size[slot_id]) {
+		    ->local_cert_chain_provision_size[slot_id]) {
 		length = (uint16)(
 			spdm_context->local_context
-				.local_cert_chain_provision_size[slot_id] -
+				->local_cert_chain_provision_size[slot_id] -
 			offset);
 	}
 	remainder_length = spdm_context->local_context
-				   .local_cert_chain_provision_size[slot_id] -
+				   ->local_cert_chain_provision_size[slot_id] -
 			   (length + offset);
 
 	spdm_reset_message_buffer_via_request_code(spdm_context,
@@ -119,7 +119,7 @@ return_status spdm_get_encap_response_certificate(IN void *context,
 	spdm_response->remainder_length = (uint16)remainder_length;
 	copy_mem(spdm_response + 1,
 		 (uint8 *)spdm_context->local_context
-				 .local_cert_chain_provision[slot_id] +
+				 ->local_cert_chain_provision[slot_id] +
 			 offset,
 		 length);
 	//
@@ -62,7 +62,7 @@ return_status spdm_get_encap_response_challenge_auth(
 	slot_id = spdm_request->header.param1;
 
 	if ((slot_id != 0xFF) &&
-	    (slot_id >= spdm_context->local_context.slot_count)) {
+	    (slot_id >= spdm_context->local_context->slot_count)) {
 		spdm_generate_encap_error_response(
 			spdm_context, SPDM_ERROR_CODE_INVALID_REQUEST, 0,
 			response_size, response);
@@ -82,7 +82,7 @@ return_status spdm_get_encap_response_challenge_auth(
 		sizeof(spdm_challenge_auth_response_t) + hash_size +
 		SPDM_NONCE_SIZE + measurement_summary_hash_size +
 		sizeof(uint16) +
-		spdm_context->local_context.opaque_challenge_auth_rsp_size +
+		spdm_context->local_context->opaque_challenge_auth_rsp_size +
 		signature_size;
 
 	ASSERT(*response_size >= total_size);
@@ -104,7 +104,7 @@ return_status spdm_get_encap_response_challenge_auth(
 	if (slot_id == 0xFF) {
 		spdm_response->header.param2 = 0;
 
-		slot_id = spdm_context->local_context.provisioned_slot_id;
+		slot_id = spdm_context->local_context->provisioned_slot_id;
 	}
 
 	ptr = (void *)(spdm_response + 1);
@@ -117,11 +117,11 @@ return_status spdm_get_encap_response_challenge_auth(
 	ptr += measurement_summary_hash_size;
 
 	*(uint16 *)ptr = (uint16)spdm_context->local_context
-				 .opaque_challenge_auth_rsp_size;
+				 ->opaque_challenge_auth_rsp_size;
 	ptr += sizeof(uint16);
-	copy_mem(ptr, spdm_context->local_context.opaque_challenge_auth_rsp,
-		 spdm_context->local_context.opaque_challenge_auth_rsp_size);
-	ptr += spdm_context->local_context.opaque_challenge_auth_rsp_size;
+	copy_mem(ptr, spdm_context->local_context->opaque_challenge_auth_rsp,
+		 spdm_context->local_context->opaque_challenge_auth_rsp_size);
+	ptr += spdm_context->local_context->opaque_challenge_auth_rsp_size;
 
 	//
 	// Calc Sign
@@ -138,7 +138,7 @@ return_status spdm_get_encap_response_challenge_auth(
 	status = spdm_append_message_mut_c(spdm_context, spdm_response,
 					   (uintn)ptr - (uintn)spdm_response);
 	if (RETURN_ERROR(status)) {
-		reset_managed_buffer(&spdm_context->transcript.message_mut_c);
+		spdm_reset_message_mut_c(spdm_context);
 		spdm_generate_encap_error_response(
 			spdm_context, SPDM_ERROR_CODE_UNSPECIFIED, 0,
 			response_size, response);
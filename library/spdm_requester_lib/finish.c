@@ -22,32 +22,38 @@ typedef struct {
 #pragma pack()
 
 /**
-  This function sends FINISH and receives FINISH_RSP for SPDM finish.
+  This function builds FINISH for SPDM finish.
+
+  The request is appended to the session transcript.
 
   @param  spdm_context                  A pointer to the SPDM context.
   @param  session_id                    session_id to the FINISH request.
   @param  req_slot_id_param               req_slot_id_param to the FINISH request.
+  @param  spdm_request_size             On output, size in bytes of the FINISH request.
+  @param  request                      A pointer to a destination buffer to store the FINISH request.
 
-  @retval RETURN_SUCCESS               The FINISH is sent and the FINISH_RSP is received.
-  @retval RETURN_DEVICE_ERROR          A device error occurs when communicates with the device.
+  @retval RETURN_SUCCESS               The FINISH is built.
+  @retval RETURN_UNSUPPORTED           The capabilities or the session state do not allow FINISH.
+  @retval RETURN_INVALID_PARAMETER     The req_slot_id_param is invalid.
+  @retval RETURN_SECURITY_VIOLATION    The signature or the HMAC cannot be generated.
 **/
-return_status try_spdm_send_receive_finish(IN spdm_context_t *spdm_context,
-					   IN uint32 session_id,
-					   IN uint8 req_slot_id_param)
+return_status spdm_build_finish_request(IN spdm_context_t *spdm_context,
+					IN uint32 session_id,
+					IN uint8 req_slot_id_param,
+					OUT uintn *spdm_request_size,
+					OUT void *request)
 {
 	return_status status;
-	spdm_finish_request_mine_t spdm_request;
-	uintn spdm_request_size;
+	spdm_finish_request_mine_t *spdm_request;
 	uintn signature_size;
 	uintn hmac_size;
-	spdm_finish_response_mine_t spdm_response;
-	uintn spdm_response_size;
 	spdm_session_info_t *session_info;
 	uint8 *ptr;
 	boolean result;
-	uint8 th2_hash_data[64];
 	spdm_session_state_t session_state;
 
+	spdm_request = request;
+
 	if (!spdm_is_capabilities_flag_supported(
 		    spdm_context, TRUE,
 		    SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP,
@@ -75,7 +81,7 @@ return_status try_spdm_send_receive_finish(IN spdm_context_t *spdm_context,
 
 	if (session_info->mut_auth_requested != 0) {
 		if ((req_slot_id_param >=
-		     spdm_context->local_context.slot_count) &&
+		     spdm_context->local_context->slot_count) &&
 		    (req_slot_id_param != 0xFF)) {
 			return RETURN_INVALID_PARAMETER;
 		}
@@ -87,43 +93,43 @@ return_status try_spdm_send_receive_finish(IN spdm_context_t *spdm_context,
 
 	spdm_context->error_state = SPDM_STATUS_ERROR_DEVICE_NO_CAPABILITIES;
 
-	spdm_request.header.spdm_version = SPDM_MESSAGE_VERSION_11;
-	spdm_request.header.request_response_code = SPDM_FINISH;
+	spdm_request->header.spdm_version = SPDM_MESSAGE_VERSION_11;
+	spdm_request->header.request_response_code = SPDM_FINISH;
 	if (session_info->mut_auth_requested) {
-		spdm_request.header.param1 =
+		spdm_request->header.param1 =
 			SPDM_FINISH_REQUEST_ATTRIBUTES_SIGNATURE_INCLUDED;
-		spdm_request.header.param2 = req_slot_id_param;
+		spdm_request->header.param2 = req_slot_id_param;
 		signature_size = spdm_get_req_asym_signature_size(
 			spdm_context->connection_info.algorithm
 				.req_base_asym_alg);
 	} else {
-		spdm_request.header.param1 = 0;
-		spdm_request.header.param2 = 0;
+		spdm_request->header.param1 = 0;
+		spdm_request->header.param2 = 0;
 		signature_size = 0;
 	}
 
 	if (req_slot_id_param == 0xFF) {
 		req_slot_id_param =
-			spdm_context->local_context.provisioned_slot_id;
+			spdm_context->local_context->provisioned_slot_id;
 	}
 
 	if (session_info->mut_auth_requested) {
 		spdm_context->connection_info.local_used_cert_chain_buffer =
 			spdm_context->local_context
-				.local_cert_chain_provision[req_slot_id_param];
+				->local_cert_chain_provision[req_slot_id_param];
 		spdm_context->connection_info.local_used_cert_chain_buffer_size =
 			spdm_context->local_context
-				.local_cert_chain_provision_size
+				->local_cert_chain_provision_size
 					[req_slot_id_param];
 	}
 
 	hmac_size = spdm_get_hash_size(
 		spdm_context->connection_info.algorithm.base_hash_algo);
-	spdm_request_size =
+	*spdm_request_size =
 		sizeof(spdm_finish_request_t) + signature_size + hmac_size;
-	ptr = spdm_request.signature;
+	ptr = spdm_request->signature;
 
-	status = spdm_append_message_f(session_info, (uint8 *)&spdm_request,
+	status = spdm_append_message_f(session_info, (uint8 *)spdm_request,
 				       sizeof(spdm_finish_request_t));
 	if (RETURN_ERROR(status)) {
 		return RETURN_SECURITY_VIOLATION;
@@ -152,33 +158,62 @@ return_status try_spdm_send_receive_finish(IN spdm_context_t *spdm_context,
 		return RETURN_SECURITY_VIOLATION;
 	}
 
-	status = spdm_send_spdm_request(spdm_context, &session_id,
-					spdm_request_size, &spdm_request);
-	if (RETURN_ERROR(status)) {
-		return RETURN_DEVICE_ERROR;
-	}
+	return RETURN_SUCCESS;
+}
 
-	spdm_response_size = sizeof(spdm_response);
-	zero_mem(&spdm_response, sizeof(spdm_response));
-	status = spdm_receive_spdm_response(
-		spdm_context, &session_id, &spdm_response_size, &spdm_response);
-	if (RETURN_ERROR(status)) {
-		return RETURN_DEVICE_ERROR;
+/**
+  This function processes FINISH_RSP, the response to FINISH.
+
+  On success, the session data keys are generated and the session is established.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  session_id                    session_id to the FINISH request.
+  @param  spdm_request_size             size in bytes of the FINISH request.
+  @param  spdm_response_size            size in bytes of the response.
+  @param  response                     A pointer to the response.
+
+  @retval RETURN_SUCCESS               The FINISH_RSP is processed.
+  @retval RETURN_DEVICE_ERROR          The response is invalid.
+  @retval RETURN_SECURITY_VIOLATION    Any verification fails.
+  @retval RETURN_NO_RESPONSE           The responder is busy.
+**/
+return_status spdm_process_finish_rsp_response(IN spdm_context_t *spdm_context,
+					       IN uint32 session_id,
+					       IN uintn spdm_request_size,
+					       IN uintn spdm_response_size,
+					       IN void *response)
+{
+	return_status status;
+	uintn hmac_size;
+	spdm_finish_response_mine_t *spdm_response;
+	spdm_session_info_t *session_info;
+	boolean result;
+	uint8 th2_hash_data[64];
+
+	spdm_response = response;
+	session_info =
+		spdm_get_session_info_via_session_id(spdm_context, session_id);
+	if (session_info == NULL) {
+		ASSERT(FALSE);
+		return RETURN_UNSUPPORTED;
 	}
+	hmac_size = spdm_get_hash_size(
+		spdm_context->connection_info.algorithm.base_hash_algo);
+
 	if (spdm_response_size < sizeof(spdm_message_header_t)) {
 		return RETURN_DEVICE_ERROR;
 	}
-	if (spdm_response.header.request_response_code == SPDM_ERROR) {
+	if (spdm_response->header.request_response_code == SPDM_ERROR) {
 		status = spdm_handle_error_response_main(
 			spdm_context, &session_id,
 			&session_info->session_transcript.message_f,
-			spdm_request_size, &spdm_response_size, &spdm_response,
+			spdm_request_size, &spdm_response_size, spdm_response,
 			SPDM_FINISH, SPDM_FINISH_RSP,
 			sizeof(spdm_finish_response_mine_t));
 		if (RETURN_ERROR(status)) {
 			return status;
 		}
-	} else if (spdm_response.header.request_response_code !=
+	} else if (spdm_response->header.request_response_code !=
 		   SPDM_FINISH_RSP) {
 		return RETURN_DEVICE_ERROR;
 	}
@@ -194,7 +229,7 @@ return_status try_spdm_send_receive_finish(IN spdm_context_t *spdm_context,
 		return RETURN_DEVICE_ERROR;
 	}
 
-	status = spdm_append_message_f(session_info, &spdm_response,
+	status = spdm_append_message_f(session_info, spdm_response,
 				       sizeof(spdm_finish_response_t));
 	if (RETURN_ERROR(status)) {
 		return RETURN_SECURITY_VIOLATION;
@@ -205,9 +240,9 @@ return_status try_spdm_send_receive_finish(IN spdm_context_t *spdm_context,
 		    SPDM_GET_CAPABILITIES_REQUEST_FLAGS_HANDSHAKE_IN_THE_CLEAR_CAP,
 		    SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_HANDSHAKE_IN_THE_CLEAR_CAP)) {
 		DEBUG((DEBUG_INFO, "verify_data (0x%x):\n", hmac_size));
-		internal_dump_hex(spdm_response.verify_data, hmac_size);
+		internal_dump_hex(spdm_response->verify_data, hmac_size);
 		result = spdm_verify_finish_rsp_hmac(spdm_context, session_info,
-						     spdm_response.verify_data,
+						     spdm_response->verify_data,
 						     hmac_size);
 		if (!result) {
 			return RETURN_SECURITY_VIOLATION;
@@ -215,7 +250,7 @@ return_status try_spdm_send_receive_finish(IN spdm_context_t *spdm_context,
 
 		status = spdm_append_message_f(
 			session_info,
-			(uint8 *)&spdm_response +
+			(uint8 *)spdm_response +
 				sizeof(spdm_finish_response_t),
 			hmac_size);
 		if (RETURN_ERROR(status)) {
@@ -240,9 +275,60 @@ return_status try_spdm_send_receive_finish(IN spdm_context_t *spdm_context,
 		SPDM_SESSION_STATE_ESTABLISHED);
 	spdm_context->error_state = SPDM_STATUS_SUCCESS;
 
+	//
+	// The handshake is complete. Replace the DHE key pair KEY_EXCHANGE took from the pool.
+	//
+	spdm_refill_used_dhe_key_pool(spdm_context);
+
 	return RETURN_SUCCESS;
 }
 
+/**
+  This function sends FINISH and receives FINISH_RSP for SPDM finish.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  session_id                    session_id to the FINISH request.
+  @param  req_slot_id_param               req_slot_id_param to the FINISH request.
+
+  @retval RETURN_SUCCESS               The FINISH is sent and the FINISH_RSP is received.
+  @retval RETURN_DEVICE_ERROR          A device error occurs when communicates with the device.
+**/
+return_status try_spdm_send_receive_finish(IN spdm_context_t *spdm_context,
+					   IN uint32 session_id,
+					   IN uint8 req_slot_id_param)
+{
+	return_status status;
+	spdm_finish_request_mine_t spdm_request;
+	uintn spdm_request_size;
+	spdm_finish_response_mine_t spdm_response;
+	uintn spdm_response_size;
+
+	status = spdm_build_finish_request(spdm_context, session_id,
+					   req_slot_id_param,
+					   &spdm_request_size, &spdm_request);
+	if (RETURN_ERROR(status)) {
+		return status;
+	}
+
+	status = spdm_send_spdm_request(spdm_context, &session_id,
+					spdm_request_size, &spdm_request);
+	if (RETURN_ERROR(status)) {
+		return RETURN_DEVICE_ERROR;
+	}
+
+	spdm_response_size = sizeof(spdm_response);
+	zero_mem(&spdm_response, sizeof(spdm_response));
+	status = spdm_receive_spdm_response(
+		spdm_context, &session_id, &spdm_response_size, &spdm_response);
+	if (RETURN_ERROR(status)) {
+		return RETURN_DEVICE_ERROR;
+	}
+	return spdm_process_finish_rsp_response(spdm_context, session_id,
+						spdm_request_size,
+						spdm_response_size,
+						&spdm_response);
+}
+
 return_status spdm_send_receive_finish(IN spdm_context_t *spdm_context,
 				       IN uint32 session_id,
 				       IN uint8 req_slot_id_param)
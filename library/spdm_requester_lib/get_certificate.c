@@ -18,40 +18,19 @@ typedef struct {
 #pragma pack()
 
 /**
-  This function sends GET_CERTIFICATE
-  to get certificate chain in one slot from device.
-
-  This function verify the integrity of the certificate chain.
-  root_hash -> Root certificate -> Intermediate certificate -> Leaf certificate.
-
-  If the peer root certificate hash is deployed,
-  this function also verifies the digest with the root hash in the certificate chain.
+  This function checks that the certificate chain in one slot can be got from device,
+  before the first GET_CERTIFICATE is built.
 
   @param  spdm_context                  A pointer to the SPDM context.
   @param  slot_id                      The number of slot for the certificate chain.
-  @param  length                       length parameter in the get_certificate message (limited by MAX_SPDM_CERT_CHAIN_BLOCK_LEN).
-  @param  cert_chain_size                On input, indicate the size in bytes of the destination buffer to store the digest buffer.
-                                       On output, indicate the size in bytes of the certificate chain.
-  @param  cert_chain                    A pointer to a destination buffer to store the certificate chain.
 
-  @retval RETURN_SUCCESS               The certificate chain is got successfully.
-  @retval RETURN_DEVICE_ERROR          A device error occurs when communicates with the device.
-  @retval RETURN_SECURITY_VIOLATION    Any verification fails.
+  @retval RETURN_SUCCESS               GET_CERTIFICATE can be sent.
+  @retval RETURN_UNSUPPORTED           The capabilities or the connection state do not allow GET_CERTIFICATE.
+  @retval RETURN_INVALID_PARAMETER     The slot_id is invalid.
 **/
-return_status try_spdm_get_certificate(IN void *context, IN uint8 slot_id,
-				       IN uint16 length,
-				       IN OUT uintn *cert_chain_size,
-				       OUT void *cert_chain)
+return_status spdm_start_get_certificate(IN spdm_context_t *spdm_context,
+					 IN uint8 slot_id)
 {
-	boolean result;
-	return_status status;
-	spdm_get_certificate_request_t spdm_request;
-	spdm_certificate_response_max_t spdm_response;
-	uintn spdm_response_size;
-	large_managed_buffer_t certificate_chain_buffer;
-	spdm_context_t *spdm_context;
-
-	spdm_context = context;
 	if (!spdm_is_capabilities_flag_supported(
 		    spdm_context, TRUE, 0,
 		    SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP)) {
@@ -68,165 +47,291 @@ return_status try_spdm_get_certificate(IN void *context, IN uint8 slot_id,
 		return RETURN_UNSUPPORTED;
 	}
 
-	init_managed_buffer(&certificate_chain_buffer,
-			    MAX_SPDM_MESSAGE_BUFFER_SIZE);
-	length = MIN(length, MAX_SPDM_CERT_CHAIN_BLOCK_LEN);
-
 	if (slot_id >= MAX_SPDM_SLOT_COUNT) {
 		return RETURN_INVALID_PARAMETER;
 	}
 
 	spdm_context->error_state = SPDM_STATUS_ERROR_DEVICE_NO_CAPABILITIES;
+	return RETURN_SUCCESS;
+}
 
-	do {
-		if (spdm_is_version_supported(spdm_context,
-					      SPDM_MESSAGE_VERSION_11)) {
-			spdm_request.header.spdm_version =
-				SPDM_MESSAGE_VERSION_11;
-		} else {
-			spdm_request.header.spdm_version =
-				SPDM_MESSAGE_VERSION_10;
-		}
-		spdm_request.header.request_response_code =
-			SPDM_GET_CERTIFICATE;
-		spdm_request.header.param1 = slot_id;
-		spdm_request.header.param2 = 0;
-		spdm_request.offset = (uint16)get_managed_buffer_size(
-			&certificate_chain_buffer);
-		spdm_request.length = length;
-		DEBUG((DEBUG_INFO, "request (offset 0x%x, size 0x%x):\n",
-		       spdm_request.offset, spdm_request.length));
+/**
+  This function builds GET_CERTIFICATE for the next portion of the certificate chain.
 
-		status = spdm_send_spdm_request(spdm_context, NULL,
-						sizeof(spdm_request),
-						&spdm_request);
-		if (RETURN_ERROR(status)) {
-			status = RETURN_DEVICE_ERROR;
-			goto done;
-		}
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  slot_id                      The number of slot for the certificate chain.
+  @param  offset                       The offset of the portion in the certificate chain.
+  @param  length                       length parameter in the get_certificate message (limited by MAX_SPDM_CERT_CHAIN_BLOCK_LEN).
+  @param  request                      A pointer to a destination buffer to store the GET_CERTIFICATE request.
+**/
+void spdm_build_get_certificate_request(IN spdm_context_t *spdm_context,
+					IN uint8 slot_id, IN uint16 offset,
+					IN uint16 length, OUT void *request)
+{
+	spdm_get_certificate_request_t *spdm_request;
 
-		spdm_response_size = sizeof(spdm_response);
-		zero_mem(&spdm_response, sizeof(spdm_response));
-		status = spdm_receive_spdm_response(spdm_context, NULL,
-						    &spdm_response_size,
-						    &spdm_response);
-		if (RETURN_ERROR(status)) {
-			status = RETURN_DEVICE_ERROR;
-			goto done;
-		}
-		if (spdm_response_size < sizeof(spdm_message_header_t)) {
-			status = RETURN_DEVICE_ERROR;
-			goto done;
-		}
-		if (spdm_response.header.request_response_code == SPDM_ERROR) {
-			status = spdm_handle_error_response_main(
-				spdm_context, NULL,
-				NULL, 0, &spdm_response_size,
-				&spdm_response, SPDM_GET_CERTIFICATE,
-				SPDM_CERTIFICATE,
-				sizeof(spdm_certificate_response_max_t));
-			if (RETURN_ERROR(status)) {
-				goto done;
-			}
-		} else if (spdm_response.header.request_response_code !=
-			   SPDM_CERTIFICATE) {
-			status = RETURN_DEVICE_ERROR;
-			goto done;
-		}
-		if (spdm_response_size < sizeof(spdm_certificate_response_t)) {
-			status = RETURN_DEVICE_ERROR;
-			goto done;
-		}
-		if (spdm_response_size > sizeof(spdm_response)) {
-			status = RETURN_DEVICE_ERROR;
-			goto done;
-		}
-		if (spdm_response.portion_length >
-		    MAX_SPDM_CERT_CHAIN_BLOCK_LEN) {
-			status = RETURN_DEVICE_ERROR;
-			goto done;
-		}
-		if (spdm_response.header.param1 != slot_id) {
-			status = RETURN_DEVICE_ERROR;
-			goto done;
-		}
-		if (spdm_response_size < sizeof(spdm_certificate_response_t) +
-						 spdm_response.portion_length) {
-			status = RETURN_DEVICE_ERROR;
-			goto done;
-		}
-		spdm_response_size = sizeof(spdm_certificate_response_t) +
-				     spdm_response.portion_length;
-		//
-		// Cache data
-		//
-		status = spdm_append_message_b(spdm_context, &spdm_request,
-					       sizeof(spdm_request));
-		if (RETURN_ERROR(status)) {
-			status = RETURN_SECURITY_VIOLATION;
-			goto done;
-		}
-		status = spdm_append_message_b(spdm_context, &spdm_response,
-					       spdm_response_size);
-		if (RETURN_ERROR(status)) {
-			status = RETURN_SECURITY_VIOLATION;
-			goto done;
-		}
+	spdm_request = request;
 
-		DEBUG((DEBUG_INFO, "Certificate (offset 0x%x, size 0x%x):\n",
-		       spdm_request.offset, spdm_response.portion_length));
-		internal_dump_hex(spdm_response.cert_chain,
-				  spdm_response.portion_length);
+	if (spdm_is_version_supported(spdm_context, SPDM_MESSAGE_VERSION_11)) {
+		spdm_request->header.spdm_version = SPDM_MESSAGE_VERSION_11;
+	} else {
+		spdm_request->header.spdm_version = SPDM_MESSAGE_VERSION_10;
+	}
+	spdm_request->header.request_response_code = SPDM_GET_CERTIFICATE;
+	spdm_request->header.param1 = slot_id;
+	spdm_request->header.param2 = 0;
+	spdm_request->offset = offset;
+	spdm_request->length = length;
+	DEBUG((DEBUG_INFO, "request (offset 0x%x, size 0x%x):\n",
+	       spdm_request->offset, spdm_request->length));
+}
+
+/**
+  This function processes CERTIFICATE, the response to GET_CERTIFICATE,
+  and appends the portion of the certificate chain.
 
-		status = append_managed_buffer(&certificate_chain_buffer,
-					       spdm_response.cert_chain,
-					       spdm_response.portion_length);
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  slot_id                      The number of slot for the certificate chain.
+  @param  request                      A pointer to the GET_CERTIFICATE request.
+  @param  spdm_response_size            size in bytes of the response.
+  @param  response                     A pointer to the response.
+  @param  certificate_chain_buffer       The managed buffer to append the portion to.
+  @param  remainder_length              On output, the remainder length of the certificate chain.
+
+  @retval RETURN_SUCCESS               The CERTIFICATE is processed.
+  @retval RETURN_DEVICE_ERROR          The response is invalid.
+  @retval RETURN_SECURITY_VIOLATION    The certificate chain is too large.
+  @retval RETURN_NO_RESPONSE           The responder is busy.
+**/
+return_status spdm_process_certificate_response(
+	IN spdm_context_t *spdm_context, IN uint8 slot_id, IN void *request,
+	IN uintn spdm_response_size, IN void *response,
+	IN OUT void *certificate_chain_buffer, OUT uint16 *remainder_length)
+{
+	return_status status;
+	spdm_get_certificate_request_t *spdm_request;
+	spdm_certificate_response_max_t *spdm_response;
+
+	spdm_request = request;
+	spdm_response = response;
+
+	if (spdm_response_size < sizeof(spdm_message_header_t)) {
+		return RETURN_DEVICE_ERROR;
+	}
+	if (spdm_response->header.request_response_code == SPDM_ERROR) {
+		status = spdm_handle_error_response_main(
+			spdm_context, NULL,
+			NULL, 0, &spdm_response_size,
+			spdm_response, SPDM_GET_CERTIFICATE,
+			SPDM_CERTIFICATE,
+			sizeof(spdm_certificate_response_max_t));
 		if (RETURN_ERROR(status)) {
-			status = RETURN_SECURITY_VIOLATION;
-			goto done;
+			return status;
 		}
-		spdm_context->connection_info.connection_state =
-			SPDM_CONNECTION_STATE_AFTER_CERTIFICATE;
+	} else if (spdm_response->header.request_response_code !=
+		   SPDM_CERTIFICATE) {
+		return RETURN_DEVICE_ERROR;
+	}
+	if (spdm_response_size < sizeof(spdm_certificate_response_t)) {
+		return RETURN_DEVICE_ERROR;
+	}
+	if (spdm_response_size > sizeof(spdm_certificate_response_max_t)) {
+		return RETURN_DEVICE_ERROR;
+	}
+	if (spdm_response->portion_length > MAX_SPDM_CERT_CHAIN_BLOCK_LEN) {
+		return RETURN_DEVICE_ERROR;
+	}
+	if (spdm_response->header.param1 != slot_id) {
+		return RETURN_DEVICE_ERROR;
+	}
+	if (spdm_response_size < sizeof(spdm_certificate_response_t) +
+					 spdm_response->portion_length) {
+		return RETURN_DEVICE_ERROR;
+	}
+	spdm_response_size = sizeof(spdm_certificate_response_t) +
+			     spdm_response->portion_length;
+	//
+	// Cache data
+	//
+	status = spdm_append_message_b(spdm_context, spdm_request,
+				       sizeof(spdm_get_certificate_request_t));
+	if (RETURN_ERROR(status)) {
+		return RETURN_SECURITY_VIOLATION;
+	}
+	status = spdm_append_message_b(spdm_context, spdm_response,
+				       spdm_response_size);
+	if (RETURN_ERROR(status)) {
+		return RETURN_SECURITY_VIOLATION;
+	}
 
-	} while (spdm_response.remainder_length != 0);
+	DEBUG((DEBUG_INFO, "Certificate (offset 0x%x, size 0x%x):\n",
+	       spdm_request->offset, spdm_response->portion_length));
+	internal_dump_hex(spdm_response->cert_chain,
+			  spdm_response->portion_length);
+
+	status = append_managed_buffer(certificate_chain_buffer,
+				       spdm_response->cert_chain,
+				       spdm_response->portion_length);
+	if (RETURN_ERROR(status)) {
+		return RETURN_SECURITY_VIOLATION;
+	}
+	spdm_context->connection_info.connection_state =
+		SPDM_CONNECTION_STATE_AFTER_CERTIFICATE;
+
+	*remainder_length = spdm_response->remainder_length;
+	return RETURN_SUCCESS;
+}
+
+/**
+  This function verifies the certificate chain got by GET_CERTIFICATE,
+  and records it as the peer used certificate chain and in the certificate chain cache.
+
+  This function verify the integrity of the certificate chain.
+  root_hash -> Root certificate -> Intermediate certificate -> Leaf certificate.
+
+  If the peer root certificate hash is deployed,
+  this function also verifies the digest with the root hash in the certificate chain.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  certificate_chain_buffer       The managed buffer holding the certificate chain.
+  @param  cert_chain_size                On input, indicate the size in bytes of the destination buffer to store the digest buffer.
+                                       On output, indicate the size in bytes of the certificate chain.
+  @param  cert_chain                    A pointer to a destination buffer to store the certificate chain.
+
+  @retval RETURN_SUCCESS               The certificate chain is verified.
+  @retval RETURN_SECURITY_VIOLATION    Any verification fails.
+  @retval RETURN_BUFFER_TOO_SMALL      The cert_chain is too small.
+**/
+return_status spdm_finish_get_certificate(IN spdm_context_t *spdm_context,
+					  IN void *certificate_chain_buffer,
+					  IN OUT uintn *cert_chain_size,
+					  OUT void *cert_chain)
+{
+	boolean result;
 
 	result = spdm_verify_peer_cert_chain_buffer(
-		spdm_context, get_managed_buffer(&certificate_chain_buffer),
-		get_managed_buffer_size(&certificate_chain_buffer));
+		spdm_context, get_managed_buffer(certificate_chain_buffer),
+		get_managed_buffer_size(certificate_chain_buffer));
 	if (!result) {
 		spdm_context->error_state =
 			SPDM_STATUS_ERROR_CERTIFICATE_FAILURE;
-		status = RETURN_SECURITY_VIOLATION;
-		goto done;
+		return RETURN_SECURITY_VIOLATION;
 	}
 	spdm_context->connection_info.peer_used_cert_chain_buffer_size =
-		get_managed_buffer_size(&certificate_chain_buffer);
+		get_managed_buffer_size(certificate_chain_buffer);
 	copy_mem(spdm_context->connection_info.peer_used_cert_chain_buffer,
-		 get_managed_buffer(&certificate_chain_buffer),
-		 get_managed_buffer_size(&certificate_chain_buffer));
+		 get_managed_buffer(certificate_chain_buffer),
+		 get_managed_buffer_size(certificate_chain_buffer));
+	spdm_invalidate_peer_cert_chain_hash(spdm_context);
+	spdm_cache_verified_certificate(
+		spdm_context,
+		spdm_context->connection_info.peer_used_cert_chain_buffer_size,
+		spdm_context->connection_info.peer_used_cert_chain_buffer);
 
 	spdm_context->error_state = SPDM_STATUS_SUCCESS;
 
 	if (cert_chain_size != NULL) {
 		if (*cert_chain_size <
-		    get_managed_buffer_size(&certificate_chain_buffer)) {
+		    get_managed_buffer_size(certificate_chain_buffer)) {
 			*cert_chain_size = get_managed_buffer_size(
-				&certificate_chain_buffer);
+				certificate_chain_buffer);
 			return RETURN_BUFFER_TOO_SMALL;
 		}
 		*cert_chain_size =
-			get_managed_buffer_size(&certificate_chain_buffer);
+			get_managed_buffer_size(certificate_chain_buffer);
 		if (cert_chain != NULL) {
 			copy_mem(cert_chain,
-				 get_managed_buffer(&certificate_chain_buffer),
+				 get_managed_buffer(certificate_chain_buffer),
 				 get_managed_buffer_size(
-					 &certificate_chain_buffer));
+					 certificate_chain_buffer));
 		}
 	}
 
-	status = RETURN_SUCCESS;
-done:
-	return status;
+	return RETURN_SUCCESS;
+}
+
+/**
+  This function sends GET_CERTIFICATE
+  to get certificate chain in one slot from device.
+
+  This function verify the integrity of the certificate chain.
+  root_hash -> Root certificate -> Intermediate certificate -> Leaf certificate.
+
+  If the peer root certificate hash is deployed,
+  this function also verifies the digest with the root hash in the certificate chain.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  slot_id                      The number of slot for the certificate chain.
+  @param  length                       length parameter in the get_certificate message (limited by MAX_SPDM_CERT_CHAIN_BLOCK_LEN).
+  @param  cert_chain_size                On input, indicate the size in bytes of the destination buffer to store the digest buffer.
+                                       On output, indicate the size in bytes of the certificate chain.
+  @param  cert_chain                    A pointer to a destination buffer to store the certificate chain.
+
+  @retval RETURN_SUCCESS               The certificate chain is got successfully.
+  @retval RETURN_DEVICE_ERROR          A device error occurs when communicates with the device.
+  @retval RETURN_SECURITY_VIOLATION    Any verification fails.
+**/
+return_status try_spdm_get_certificate(IN void *context, IN uint8 slot_id,
+				       IN uint16 length,
+				       IN OUT uintn *cert_chain_size,
+				       OUT void *cert_chain)
+{
+	return_status status;
+	spdm_get_certificate_request_t spdm_request;
+	spdm_certificate_response_max_t spdm_response;
+	uintn spdm_response_size;
+	uint16 remainder_length;
+	large_managed_buffer_t certificate_chain_buffer;
+	spdm_context_t *spdm_context;
+
+	spdm_context = context;
+	status = spdm_start_get_certificate(spdm_context, slot_id);
+	if (RETURN_ERROR(status)) {
+		return status;
+	}
+	status = spdm_get_cached_certificate(spdm_context, slot_id,
+					     cert_chain_size, cert_chain);
+	if (status != RETURN_NOT_FOUND) {
+		return status;
+	}
+
+	init_managed_buffer(&certificate_chain_buffer,
+			    MAX_SPDM_MESSAGE_BUFFER_SIZE);
+	length = MIN(length, MAX_SPDM_CERT_CHAIN_BLOCK_LEN);
+
+	do {
+		spdm_build_get_certificate_request(
+			spdm_context, slot_id,
+			(uint16)get_managed_buffer_size(&certificate_chain_buffer),
+			length, &spdm_request);
+
+		status = spdm_send_spdm_request(spdm_context, NULL,
+						sizeof(spdm_request),
+						&spdm_request);
+		if (RETURN_ERROR(status)) {
+			return RETURN_DEVICE_ERROR;
+		}
+
+		spdm_response_size = sizeof(spdm_response);
+		zero_mem(&spdm_response, sizeof(spdm_response));
+		status = spdm_receive_spdm_response(spdm_context, NULL,
+						    &spdm_response_size,
+						    &spdm_response);
+		if (RETURN_ERROR(status)) {
+			return RETURN_DEVICE_ERROR;
+		}
+		status = spdm_process_certificate_response(
+			spdm_context, slot_id, &spdm_request,
+			spdm_response_size, &spdm_response,
+			&certificate_chain_buffer, &remainder_length);
+		if (RETURN_ERROR(status)) {
+			return status;
+		}
+	} while (remainder_length != 0);
+
+	return spdm_finish_get_certificate(spdm_context,
+					   &certificate_chain_buffer,
+					   cert_chain_size, cert_chain);
 }
 
 /**
@@ -16,36 +16,21 @@ typedef struct {
 #pragma pack()
 
 /**
-  This function sends GET_DIGEST
-  to get all digest of the certificate chains from device.
-
-  If the peer certificate chain is deployed,
-  this function also verifies the digest with the certificate chain.
-
-  TotalDigestSize = sizeof(digest) * count in slot_mask
+  This function builds GET_DIGEST.
 
   @param  spdm_context                  A pointer to the SPDM context.
-  @param  slot_mask                     The slots which deploy the CertificateChain.
-  @param  total_digest_buffer            A pointer to a destination buffer to store the digest buffer.
+  @param  request                      A pointer to a destination buffer to store the GET_DIGEST request.
 
-  @retval RETURN_SUCCESS               The digests are got successfully.
-  @retval RETURN_DEVICE_ERROR          A device error occurs when communicates with the device.
-  @retval RETURN_SECURITY_VIOLATION    Any verification fails.
+  @retval RETURN_SUCCESS               The GET_DIGEST is built.
+  @retval RETURN_UNSUPPORTED           The capabilities or the connection state do not allow GET_DIGEST.
 **/
-return_status try_spdm_get_digest(IN void *context, OUT uint8 *slot_mask,
-				  OUT void *total_digest_buffer)
+return_status spdm_build_get_digest_request(IN spdm_context_t *spdm_context,
+					    OUT void *request)
 {
-	boolean result;
-	return_status status;
-	spdm_get_digest_request_t spdm_request;
-	spdm_digests_response_max_t spdm_response;
-	uintn spdm_response_size;
-	uintn digest_size;
-	uintn digest_count;
-	uintn index;
-	spdm_context_t *spdm_context;
+	spdm_get_digest_request_t *spdm_request;
+
+	spdm_request = request;
 
-	spdm_context = context;
 	if (!spdm_is_capabilities_flag_supported(
 		    spdm_context, TRUE, 0,
 		    SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP)) {
@@ -61,55 +46,82 @@ return_status try_spdm_get_digest(IN void *context, OUT uint8 *slot_mask,
 	spdm_context->error_state = SPDM_STATUS_ERROR_DEVICE_NO_CAPABILITIES;
 
 	if (spdm_is_version_supported(spdm_context, SPDM_MESSAGE_VERSION_11)) {
-		spdm_request.header.spdm_version = SPDM_MESSAGE_VERSION_11;
+		spdm_request->header.spdm_version = SPDM_MESSAGE_VERSION_11;
 	} else {
-		spdm_request.header.spdm_version = SPDM_MESSAGE_VERSION_10;
-	}
-	spdm_request.header.request_response_code = SPDM_GET_DIGESTS;
-	spdm_request.header.param1 = 0;
-	spdm_request.header.param2 = 0;
-	status = spdm_send_spdm_request(spdm_context, NULL,
-					sizeof(spdm_request), &spdm_request);
-	if (RETURN_ERROR(status)) {
-		return RETURN_DEVICE_ERROR;
-	}
-	spdm_response_size = sizeof(spdm_response);
-	zero_mem(&spdm_response, sizeof(spdm_response));
-	status = spdm_receive_spdm_response(
-		spdm_context, NULL, &spdm_response_size, &spdm_response);
-	if (RETURN_ERROR(status)) {
-		return RETURN_DEVICE_ERROR;
+		spdm_request->header.spdm_version = SPDM_MESSAGE_VERSION_10;
 	}
+	spdm_request->header.request_response_code = SPDM_GET_DIGESTS;
+	spdm_request->header.param1 = 0;
+	spdm_request->header.param2 = 0;
+	return RETURN_SUCCESS;
+}
+
+/**
+  This function processes DIGESTS, the response to GET_DIGEST.
+
+  If the peer certificate chain is deployed,
+  this function also verifies the digest with the certificate chain.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  request                      A pointer to the GET_DIGEST request.
+  @param  spdm_response_size            size in bytes of the response.
+  @param  response                     A pointer to the response.
+  @param  slot_mask                     The slots which deploy the CertificateChain.
+  @param  total_digest_buffer            A pointer to a destination buffer to store the digest buffer.
+
+  @retval RETURN_SUCCESS               The DIGESTS is processed.
+  @retval RETURN_DEVICE_ERROR          The response is invalid.
+  @retval RETURN_SECURITY_VIOLATION    Any verification fails.
+  @retval RETURN_NO_RESPONSE           The responder is busy.
+**/
+return_status spdm_process_digests_response(IN spdm_context_t *spdm_context,
+					    IN void *request,
+					    IN uintn spdm_response_size,
+					    IN void *response,
+					    OUT uint8 *slot_mask,
+					    OUT void *total_digest_buffer)
+{
+	boolean result;
+	return_status status;
+	spdm_get_digest_request_t *spdm_request;
+	spdm_digests_response_max_t *spdm_response;
+	uintn digest_size;
+	uintn digest_count;
+	uintn index;
+
+	spdm_request = request;
+	spdm_response = response;
+
 	if (spdm_response_size < sizeof(spdm_message_header_t)) {
 		return RETURN_DEVICE_ERROR;
 	}
-	if (spdm_response.header.request_response_code == SPDM_ERROR) {
+	if (spdm_response->header.request_response_code == SPDM_ERROR) {
 		status = spdm_handle_error_response_main(
 			spdm_context, NULL, NULL,
 			0, &spdm_response_size,
-			&spdm_response, SPDM_GET_DIGESTS, SPDM_DIGESTS,
+			spdm_response, SPDM_GET_DIGESTS, SPDM_DIGESTS,
 			sizeof(spdm_digests_response_max_t));
 		if (RETURN_ERROR(status)) {
 			return status;
 		}
-	} else if (spdm_response.header.request_response_code != SPDM_DIGESTS) {
+	} else if (spdm_response->header.request_response_code != SPDM_DIGESTS) {
 		return RETURN_DEVICE_ERROR;
 	}
 	if (spdm_response_size < sizeof(spdm_digest_response_t)) {
 		return RETURN_DEVICE_ERROR;
 	}
-	if (spdm_response_size > sizeof(spdm_response)) {
+	if (spdm_response_size > sizeof(spdm_digests_response_max_t)) {
 		return RETURN_DEVICE_ERROR;
 	}
 
 	digest_size = spdm_get_hash_size(
 		spdm_context->connection_info.algorithm.base_hash_algo);
 	if (slot_mask != NULL) {
-		*slot_mask = spdm_response.header.param2;
+		*slot_mask = spdm_response->header.param2;
 	}
 	digest_count = 0;
 	for (index = 0; index < MAX_SPDM_SLOT_COUNT; index++) {
-		if (spdm_response.header.param2 & (1 << index)) {
+		if (spdm_response->header.param2 & (1 << index)) {
 			digest_count++;
 		}
 	}
@@ -125,13 +137,13 @@ return_status try_spdm_get_digest(IN void *context, OUT uint8 *slot_mask,
 	//
 	// Cache data
 	//
-	status = spdm_append_message_b(spdm_context, &spdm_request,
-				       sizeof(spdm_request));
+	status = spdm_append_message_b(spdm_context, spdm_request,
+				       sizeof(spdm_get_digest_request_t));
 	if (RETURN_ERROR(status)) {
 		return RETURN_SECURITY_VIOLATION;
 	}
 
-	status = spdm_append_message_b(spdm_context, &spdm_response,
+	status = spdm_append_message_b(spdm_context, spdm_response,
 				       spdm_response_size);
 	if (RETURN_ERROR(status)) {
 		return RETURN_SECURITY_VIOLATION;
@@ -139,13 +151,13 @@ return_status try_spdm_get_digest(IN void *context, OUT uint8 *slot_mask,
 
 	for (index = 0; index < digest_count; index++) {
 		DEBUG((DEBUG_INFO, "digest (0x%x) - ", index));
-		internal_dump_data(&spdm_response.digest[digest_size * index],
+		internal_dump_data(&spdm_response->digest[digest_size * index],
 				   digest_size);
 		DEBUG((DEBUG_INFO, "\n"));
 	}
 
 	result = spdm_verify_peer_digests(
-		spdm_context, spdm_response.digest, digest_count);
+		spdm_context, spdm_response->digest, digest_count);
 	if (!result) {
 		spdm_context->error_state =
 			SPDM_STATUS_ERROR_CERTIFICATE_FAILURE;
@@ -154,8 +166,24 @@ return_status try_spdm_get_digest(IN void *context, OUT uint8 *slot_mask,
 
 	spdm_context->error_state = SPDM_STATUS_SUCCESS;
 
+	//
+	// Remember the digest of each slot to look up the certificate chain cache.
+	//
+	spdm_context->connection_info.peer_digest_slot_mask =
+		spdm_response->header.param2;
+	digest_count = 0;
+	for (index = 0; index < MAX_SPDM_SLOT_COUNT; index++) {
+		if (spdm_response->header.param2 & (1 << index)) {
+			copy_mem(spdm_context->connection_info.peer_digest[index],
+				 &spdm_response->digest[digest_size *
+							digest_count],
+				 digest_size);
+			digest_count++;
+		}
+	}
+
 	if (total_digest_buffer != NULL) {
-		copy_mem(total_digest_buffer, spdm_response.digest,
+		copy_mem(total_digest_buffer, spdm_response->digest,
 			 digest_size * digest_count);
 	}
 
@@ -164,6 +192,55 @@ return_status try_spdm_get_digest(IN void *context, OUT uint8 *slot_mask,
 	return RETURN_SUCCESS;
 }
 
+/**
+  This function sends GET_DIGEST
+  to get all digest of the certificate chains from device.
+
+  If the peer certificate chain is deployed,
+  this function also verifies the digest with the certificate chain.
+
+  TotalDigestSize = sizeof(digest) * count in slot_mask
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  slot_mask                     The slots which deploy the CertificateChain.
+  @param  total_digest_buffer            A pointer to a destination buffer to store the digest buffer.
+
+  @retval RETURN_SUCCESS               The digests are got successfully.
+  @retval RETURN_DEVICE_ERROR          A device error occurs when communicates with the device.
+  @retval RETURN_SECURITY_VIOLATION    Any verification fails.
+**/
+return_status try_spdm_get_digest(IN void *context, OUT uint8 *slot_mask,
+				  OUT void *total_digest_buffer)
+{
+	return_status status;
+	spdm_get_digest_request_t spdm_request;
+	spdm_digests_response_max_t spdm_response;
+	uintn spdm_response_size;
+	spdm_context_t *spdm_context;
+
+	spdm_context = context;
+	status = spdm_build_get_digest_request(spdm_context, &spdm_request);
+	if (RETURN_ERROR(status)) {
+		return status;
+	}
+
+	status = spdm_send_spdm_request(spdm_context, NULL,
+					sizeof(spdm_request), &spdm_request);
+	if (RETURN_ERROR(status)) {
+		return RETURN_DEVICE_ERROR;
+	}
+	spdm_response_size = sizeof(spdm_response);
+	zero_mem(&spdm_response, sizeof(spdm_response));
+	status = spdm_receive_spdm_response(
+		spdm_context, NULL, &spdm_response_size, &spdm_response);
+	if (RETURN_ERROR(status)) {
+		return RETURN_DEVICE_ERROR;
+	}
+	return spdm_process_digests_response(spdm_context, &spdm_request,
+					     spdm_response_size, &spdm_response,
+					     slot_mask, total_digest_buffer);
+}
+
 /**
   This function sends GET_DIGEST
   to get all digest of the certificate chains from device.
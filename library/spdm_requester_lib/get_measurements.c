@@ -22,11 +22,9 @@ typedef struct {
 #pragma pack()
 
 /**
-  This function sends GET_MEASUREMENT
+  This function builds GET_MEASUREMENT
   to get measurement from the device.
 
-  If the signature is requested, this function verifies the signature of the measurement.
-
   @param  spdm_context                  A pointer to the SPDM context.
   @param  session_id                    Indicates if it is a secured message protected via SPDM session.
                                        If session_id is NULL, it is a normal message.
@@ -34,45 +32,25 @@ typedef struct {
   @param  request_attribute             The request attribute of the request message.
   @param  measurement_operation         The measurement operation of the request message.
   @param  slot_id                      The number of slot for the certificate chain.
-  @param  number_of_blocks               The number of blocks of the measurement record.
-  @param  measurement_record_length      On input, indicate the size in bytes of the destination buffer to store the measurement record.
-                                       On output, indicate the size in bytes of the measurement record.
-  @param  measurement_record            A pointer to a destination buffer to store the measurement record.
+  @param  spdm_request_size             On output, size in bytes of the GET_MEASUREMENT request.
+  @param  request                      A pointer to a destination buffer to store the GET_MEASUREMENT request.
 
-  @retval RETURN_SUCCESS               The measurement is got successfully.
-  @retval RETURN_DEVICE_ERROR          A device error occurs when communicates with the device.
-  @retval RETURN_SECURITY_VIOLATION    Any verification fails.
+  @retval RETURN_SUCCESS               The GET_MEASUREMENT is built.
+  @retval RETURN_UNSUPPORTED           The capabilities or the connection state do not allow GET_MEASUREMENT.
+  @retval RETURN_INVALID_PARAMETER     The slot_id or the request attribute is invalid.
 **/
-return_status try_spdm_get_measurement(IN void *context, IN uint32 *session_id,
-				       IN uint8 request_attribute,
-				       IN uint8 measurement_operation,
-				       IN uint8 slot_id_param,
-				       OUT uint8 *number_of_blocks,
-				       IN OUT uint32 *measurement_record_length,
-				       OUT void *measurement_record)
+return_status spdm_build_get_measurement_request(
+	IN spdm_context_t *spdm_context, IN uint32 *session_id,
+	IN uint8 request_attribute, IN uint8 measurement_operation,
+	IN uint8 slot_id_param, OUT uintn *spdm_request_size,
+	OUT void *request)
 {
-	boolean result;
-	return_status status;
-	spdm_get_measurements_request_t spdm_request;
-	uintn spdm_request_size;
-	spdm_measurements_response_max_t spdm_response;
-	uintn spdm_response_size;
-	uint32 measurement_record_data_length;
-	uint8 *measurement_record_data;
-	spdm_measurement_block_common_header_t *measurement_block_header;
-	uint32 measurement_block_size;
-	uint8 measurement_block_count;
-	uint8 *ptr;
-	void *nonce;
-	uint16 opaque_length;
-	void *opaque;
-	void *signature;
-	uintn signature_size;
-	spdm_context_t *spdm_context;
+	spdm_get_measurements_request_t *spdm_request;
 	spdm_session_info_t *session_info;
 	spdm_session_state_t session_state;
 
-	spdm_context = context;
+	spdm_request = request;
+
 	if (!spdm_is_capabilities_flag_supported(
 		    spdm_context, TRUE, 0,
 		    SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MEAS_CAP)) {
@@ -107,7 +85,7 @@ return_status try_spdm_get_measurement(IN void *context, IN uint32 *session_id,
 		return RETURN_INVALID_PARAMETER;
 	}
 	if ((slot_id_param == 0xF) &&
-	    (spdm_context->local_context.peer_cert_chain_provision_size == 0)) {
+	    (spdm_context->local_context->peer_cert_chain_provision_size == 0)) {
 		return RETURN_INVALID_PARAMETER;
 	}
 
@@ -120,68 +98,111 @@ return_status try_spdm_get_measurement(IN void *context, IN uint32 *session_id,
 		return RETURN_INVALID_PARAMETER;
 	}
 
-	if (request_attribute ==
-	    SPDM_GET_MEASUREMENTS_REQUEST_ATTRIBUTES_GENERATE_SIGNATURE) {
-		signature_size = spdm_get_asym_signature_size(
-			spdm_context->connection_info.algorithm.base_asym_algo);
-	} else {
-		signature_size = 0;
-	}
-
 	if (spdm_is_version_supported(spdm_context, SPDM_MESSAGE_VERSION_11)) {
-		spdm_request.header.spdm_version = SPDM_MESSAGE_VERSION_11;
+		spdm_request->header.spdm_version = SPDM_MESSAGE_VERSION_11;
 	} else {
-		spdm_request.header.spdm_version = SPDM_MESSAGE_VERSION_10;
+		spdm_request->header.spdm_version = SPDM_MESSAGE_VERSION_10;
 	}
-	spdm_request.header.request_response_code = SPDM_GET_MEASUREMENTS;
-	spdm_request.header.param1 = request_attribute;
-	spdm_request.header.param2 = measurement_operation;
+	spdm_request->header.request_response_code = SPDM_GET_MEASUREMENTS;
+	spdm_request->header.param1 = request_attribute;
+	spdm_request->header.param2 = measurement_operation;
 	if (request_attribute ==
 	    SPDM_GET_MEASUREMENTS_REQUEST_ATTRIBUTES_GENERATE_SIGNATURE) {
 		if (spdm_is_version_supported(spdm_context,
 					      SPDM_MESSAGE_VERSION_11)) {
-			spdm_request_size = sizeof(spdm_request);
+			*spdm_request_size = sizeof(spdm_get_measurements_request_t);
 		} else {
-			spdm_request_size = sizeof(spdm_request) -
-					    sizeof(spdm_request.SlotIDParam);
+			*spdm_request_size = sizeof(spdm_get_measurements_request_t) -
+					    sizeof(spdm_request->SlotIDParam);
 		}
 
-		spdm_get_random_number(SPDM_NONCE_SIZE, spdm_request.nonce);
+		spdm_get_random_number(SPDM_NONCE_SIZE, spdm_request->nonce);
 		DEBUG((DEBUG_INFO, "ClientNonce - "));
-		internal_dump_data(spdm_request.nonce, SPDM_NONCE_SIZE);
+		internal_dump_data(spdm_request->nonce, SPDM_NONCE_SIZE);
 		DEBUG((DEBUG_INFO, "\n"));
-		spdm_request.SlotIDParam = slot_id_param;
+		spdm_request->SlotIDParam = slot_id_param;
 	} else {
-		spdm_request_size = sizeof(spdm_request.header);
+		*spdm_request_size = sizeof(spdm_request->header);
 	}
 
-	status = spdm_send_spdm_request(spdm_context, session_id,
-					spdm_request_size, &spdm_request);
-	if (RETURN_ERROR(status)) {
-		return RETURN_DEVICE_ERROR;
-	}
+	return RETURN_SUCCESS;
+}
 
-	spdm_response_size = sizeof(spdm_response);
-	zero_mem(&spdm_response, sizeof(spdm_response));
-	status = spdm_receive_spdm_response(
-		spdm_context, session_id, &spdm_response_size, &spdm_response);
-	if (RETURN_ERROR(status)) {
-		return RETURN_DEVICE_ERROR;
+/**
+  This function processes MEASUREMENTS, the response to GET_MEASUREMENT.
+
+  If the signature is requested, this function verifies the signature of the measurement.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  session_id                    Indicates if it is a secured message protected via SPDM session.
+                                       If session_id is NULL, it is a normal message.
+                                       If session_id is NOT NULL, it is a secured message.
+  @param  request_attribute             The request attribute of the request message.
+  @param  measurement_operation         The measurement operation of the request message.
+  @param  slot_id                      The number of slot for the certificate chain.
+  @param  spdm_request_size             size in bytes of the GET_MEASUREMENT request.
+  @param  request                      A pointer to the GET_MEASUREMENT request.
+  @param  spdm_response_size            size in bytes of the response.
+  @param  response                     A pointer to the response.
+  @param  number_of_blocks               The number of blocks of the measurement record.
+  @param  measurement_record_length      On input, indicate the size in bytes of the destination buffer to store the measurement record.
+                                       On output, indicate the size in bytes of the measurement record.
+  @param  measurement_record            A pointer to a destination buffer to store the measurement record.
+
+  @retval RETURN_SUCCESS               The MEASUREMENTS is processed.
+  @retval RETURN_DEVICE_ERROR          The response is invalid.
+  @retval RETURN_SECURITY_VIOLATION    Any verification fails.
+  @retval RETURN_NO_RESPONSE           The responder is busy.
+**/
+return_status spdm_process_measurements_response(
+	IN spdm_context_t *spdm_context, IN uint32 *session_id,
+	IN uint8 request_attribute, IN uint8 measurement_operation,
+	IN uint8 slot_id_param, IN uintn spdm_request_size, IN void *request,
+	IN uintn spdm_response_size, IN void *response,
+	OUT uint8 *number_of_blocks, IN OUT uint32 *measurement_record_length,
+	OUT void *measurement_record)
+{
+	boolean result;
+	return_status status;
+	spdm_get_measurements_request_t *spdm_request;
+	spdm_measurements_response_max_t *spdm_response;
+	uint32 measurement_record_data_length;
+	uint8 *measurement_record_data;
+	spdm_measurement_block_common_header_t *measurement_block_header;
+	uint32 measurement_block_size;
+	uint8 measurement_block_count;
+	uint8 *ptr;
+	void *nonce;
+	uint16 opaque_length;
+	void *opaque;
+	void *signature;
+	uintn signature_size;
+
+	spdm_request = request;
+	spdm_response = response;
+
+	if (request_attribute ==
+	    SPDM_GET_MEASUREMENTS_REQUEST_ATTRIBUTES_GENERATE_SIGNATURE) {
+		signature_size = spdm_get_asym_signature_size(
+			spdm_context->connection_info.algorithm.base_asym_algo);
+	} else {
+		signature_size = 0;
 	}
+
 	if (spdm_response_size < sizeof(spdm_message_header_t)) {
 		return RETURN_DEVICE_ERROR;
 	}
-	if (spdm_response.header.request_response_code == SPDM_ERROR) {
+	if (spdm_response->header.request_response_code == SPDM_ERROR) {
 		status = spdm_handle_error_response_main(
 			spdm_context, session_id,
 			NULL, 0,
-			&spdm_response_size, &spdm_response,
+			&spdm_response_size, spdm_response,
 			SPDM_GET_MEASUREMENTS, SPDM_MEASUREMENTS,
 			sizeof(spdm_measurements_response_max_t));
 		if (RETURN_ERROR(status)) {
 			return status;
 		}
-	} else if (spdm_response.header.request_response_code !=
+	} else if (spdm_response->header.request_response_code !=
 		   SPDM_MEASUREMENTS) {
 		reset_managed_buffer(&spdm_context->transcript.message_m);
 		return RETURN_DEVICE_ERROR;
@@ -189,30 +210,30 @@ return_status try_spdm_get_measurement(IN void *context, IN uint32 *session_id,
 	if (spdm_response_size < sizeof(spdm_measurements_response_t)) {
 		return RETURN_DEVICE_ERROR;
 	}
-	if (spdm_response_size > sizeof(spdm_response)) {
+	if (spdm_response_size > sizeof(spdm_measurements_response_max_t)) {
 		return RETURN_DEVICE_ERROR;
 	}
 
 	if (measurement_operation ==
 	    SPDM_GET_MEASUREMENTS_REQUEST_MEASUREMENT_OPERATION_TOTAL_NUMBER_OF_MEASUREMENTS) {
-		if (spdm_response.number_of_blocks != 0) {
+		if (spdm_response->number_of_blocks != 0) {
 			reset_managed_buffer(
 				&spdm_context->transcript.message_m);
 			return RETURN_DEVICE_ERROR;
 		}
 	} else if (measurement_operation ==
 		   SPDM_GET_MEASUREMENTS_REQUEST_MEASUREMENT_OPERATION_ALL_MEASUREMENTS) {
-		if (spdm_response.number_of_blocks == 0) {
+		if (spdm_response->number_of_blocks == 0) {
 			return RETURN_DEVICE_ERROR;
 		}
 	} else {
-		if (spdm_response.number_of_blocks != 1) {
+		if (spdm_response->number_of_blocks != 1) {
 			return RETURN_DEVICE_ERROR;
 		}
 	}
 
 	measurement_record_data_length =
-		spdm_read_uint24(spdm_response.measurement_record_length);
+		spdm_read_uint24(spdm_response->measurement_record_length);
 	if (measurement_operation ==
 	    SPDM_GET_MEASUREMENTS_REQUEST_MEASUREMENT_OPERATION_TOTAL_NUMBER_OF_MEASUREMENTS) {
 		if (measurement_record_data_length != 0) {
@@ -227,14 +248,14 @@ return_status try_spdm_get_measurement(IN void *context, IN uint32 *session_id,
 			return RETURN_DEVICE_ERROR;
 		}
 		if (measurement_record_data_length >=
-		    sizeof(spdm_response.measurement_record)) {
+		    sizeof(spdm_response->measurement_record)) {
 			return RETURN_DEVICE_ERROR;
 		}
 		DEBUG((DEBUG_INFO, "measurement_record_length - 0x%06x\n",
 		       measurement_record_data_length));
 	}
 
-	measurement_record_data = spdm_response.measurement_record;
+	measurement_record_data = spdm_response->measurement_record;
 
 	if (request_attribute ==
 	    SPDM_GET_MEASUREMENTS_REQUEST_ATTRIBUTES_GENERATE_SIGNATURE) {
@@ -248,7 +269,7 @@ return_status try_spdm_get_measurement(IN void *context, IN uint32 *session_id,
 		}
 		if (spdm_is_version_supported(spdm_context,
 					      SPDM_MESSAGE_VERSION_11) &&
-		    spdm_response.header.param2 != slot_id_param) {
+		    spdm_response->header.param2 != slot_id_param) {
 			reset_managed_buffer(
 				&spdm_context->transcript.message_m);
 			return RETURN_SECURITY_VIOLATION;
@@ -279,13 +300,13 @@ return_status try_spdm_get_measurement(IN void *context, IN uint32 *session_id,
 		//
 		// Cache data
 		//
-		status = spdm_append_message_m(spdm_context, &spdm_request,
+		status = spdm_append_message_m(spdm_context, spdm_request,
 						spdm_request_size);
 		if (RETURN_ERROR(status)) {
 			return RETURN_SECURITY_VIOLATION;
 		}
 
-		status = spdm_append_message_m(spdm_context, &spdm_response,
+		status = spdm_append_message_m(spdm_context, spdm_response,
 					       spdm_response_size -
 						       signature_size);
 		if (RETURN_ERROR(status)) {
@@ -347,13 +368,13 @@ return_status try_spdm_get_measurement(IN void *context, IN uint32 *session_id,
 		//
 		// Cache data
 		//
-		status = spdm_append_message_m(spdm_context, &spdm_request,
+		status = spdm_append_message_m(spdm_context, spdm_request,
 						spdm_request_size);
 		if (RETURN_ERROR(status)) {
 			return RETURN_SECURITY_VIOLATION;
 		}
 
-		status = spdm_append_message_m(spdm_context, &spdm_response,
+		status = spdm_append_message_m(spdm_context, spdm_response,
 					       spdm_response_size);
 		if (RETURN_ERROR(status)) {
 			reset_managed_buffer(
@@ -364,7 +385,7 @@ return_status try_spdm_get_measurement(IN void *context, IN uint32 *session_id,
 
 	if (measurement_operation ==
 	    SPDM_GET_MEASUREMENTS_REQUEST_MEASUREMENT_OPERATION_TOTAL_NUMBER_OF_MEASUREMENTS) {
-		*number_of_blocks = spdm_response.header.param1;
+		*number_of_blocks = spdm_response->header.param1;
 		if (*number_of_blocks == 0xFF) {
 			// the number of block cannot be 0xFF, because index 0xFF will brings confusing.
 			return RETURN_DEVICE_ERROR;
@@ -374,7 +395,7 @@ return_status try_spdm_get_measurement(IN void *context, IN uint32 *session_id,
 			return RETURN_DEVICE_ERROR;
 		}
 	} else {
-		*number_of_blocks = spdm_response.number_of_blocks;
+		*number_of_blocks = spdm_response->number_of_blocks;
 		if (*measurement_record_length <
 		    measurement_record_data_length) {
 			return RETURN_BUFFER_TOO_SMALL;
@@ -441,6 +462,73 @@ return_status try_spdm_get_measurement(IN void *context, IN uint32 *session_id,
 	return RETURN_SUCCESS;
 }
 
+/**
+  This function sends GET_MEASUREMENT
+  to get measurement from the device.
+
+  If the signature is requested, this function verifies the signature of the measurement.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  session_id                    Indicates if it is a secured message protected via SPDM session.
+                                       If session_id is NULL, it is a normal message.
+                                       If session_id is NOT NULL, it is a secured message.
+  @param  request_attribute             The request attribute of the request message.
+  @param  measurement_operation         The measurement operation of the request message.
+  @param  slot_id                      The number of slot for the certificate chain.
+  @param  number_of_blocks               The number of blocks of the measurement record.
+  @param  measurement_record_length      On input, indicate the size in bytes of the destination buffer to store the measurement record.
+                                       On output, indicate the size in bytes of the measurement record.
+  @param  measurement_record            A pointer to a destination buffer to store the measurement record.
+
+  @retval RETURN_SUCCESS               The measurement is got successfully.
+  @retval RETURN_DEVICE_ERROR          A device error occurs when communicates with the device.
+  @retval RETURN_SECURITY_VIOLATION    Any verification fails.
+**/
+return_status try_spdm_get_measurement(IN void *context, IN uint32 *session_id,
+				       IN uint8 request_attribute,
+				       IN uint8 measurement_operation,
+				       IN uint8 slot_id_param,
+				       OUT uint8 *number_of_blocks,
+				       IN OUT uint32 *measurement_record_length,
+				       OUT void *measurement_record)
+{
+	return_status status;
+	spdm_get_measurements_request_t spdm_request;
+	uintn spdm_request_size;
+	spdm_measurements_response_max_t spdm_response;
+	uintn spdm_response_size;
+	spdm_context_t *spdm_context;
+
+	spdm_context = context;
+	status = spdm_build_get_measurement_request(
+		spdm_context, session_id, request_attribute,
+		measurement_operation, slot_id_param, &spdm_request_size,
+		&spdm_request);
+	if (RETURN_ERROR(status)) {
+		return status;
+	}
+
+	status = spdm_send_spdm_request(spdm_context, session_id,
+					spdm_request_size, &spdm_request);
+	if (RETURN_ERROR(status)) {
+		return RETURN_DEVICE_ERROR;
+	}
+
+	spdm_response_size = sizeof(spdm_response);
+	zero_mem(&spdm_response, sizeof(spdm_response));
+	status = spdm_receive_spdm_response(
+		spdm_context, session_id, &spdm_response_size, &spdm_response);
+	if (RETURN_ERROR(status)) {
+		return RETURN_DEVICE_ERROR;
+	}
+	return spdm_process_measurements_response(
+		spdm_context, session_id, request_attribute,
+		measurement_operation, slot_id_param, spdm_request_size,
+		&spdm_request, spdm_response_size, &spdm_response,
+		number_of_blocks, measurement_record_length,
+		measurement_record);
+}
+
 return_status spdm_get_measurement(IN void *context, IN uint32 *session_id,
 				   IN uint8 request_attribute,
 				   IN uint8 measurement_operation,
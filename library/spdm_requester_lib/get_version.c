@@ -16,100 +16,115 @@ typedef struct {
 #pragma pack()
 
 /**
-  This function sends GET_VERSION and receives VERSION.
+  This function builds GET_VERSION.
+
+  The SPDM context is reset, because GET_VERSION starts a new connection.
 
   @param  spdm_context                  A pointer to the SPDM context.
+  @param  request                      A pointer to a destination buffer to store the GET_VERSION request.
 
-  @retval RETURN_SUCCESS               The GET_VERSION is sent and the VERSION is received.
-  @retval RETURN_DEVICE_ERROR          A device error occurs when communicates with the device.
+  @retval RETURN_SUCCESS               The GET_VERSION is built.
 **/
-return_status try_spdm_get_version(IN spdm_context_t *spdm_context)
+return_status spdm_build_get_version_request(IN spdm_context_t *spdm_context,
+					     OUT void *request)
 {
-	return_status status;
-	spdm_get_version_request_t spdm_request;
-	spdm_version_response_max_t spdm_response;
-	uintn spdm_response_size;
-	uintn index;
-	uint8 version;
-	uint8 compatible_version_count;
-	spdm_version_number_t
-		compatible_version_number_entry[MAX_SPDM_VERSION_COUNT];
+	spdm_get_version_request_t *spdm_request;
+
+	spdm_request = request;
 
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_NOT_STARTED;
 
-	spdm_request.header.spdm_version = SPDM_MESSAGE_VERSION_10;
-	spdm_request.header.request_response_code = SPDM_GET_VERSION;
-	spdm_request.header.param1 = 0;
-	spdm_request.header.param2 = 0;
+	spdm_request->header.spdm_version = SPDM_MESSAGE_VERSION_10;
+	spdm_request->header.request_response_code = SPDM_GET_VERSION;
+	spdm_request->header.param1 = 0;
+	spdm_request->header.param2 = 0;
 
 	spdm_reset_context(spdm_context);
 
 	spdm_reset_message_buffer_via_request_code(spdm_context,
-						spdm_request.header.request_response_code);
+						spdm_request->header.request_response_code);
 
-	status = spdm_send_spdm_request(spdm_context, NULL,
-					sizeof(spdm_request), &spdm_request);
-	if (RETURN_ERROR(status)) {
-		return RETURN_DEVICE_ERROR;
-	}
+	spdm_reset_message_a(spdm_context);
+	spdm_reset_message_b(spdm_context);
+	spdm_reset_message_c(spdm_context);
+	return RETURN_SUCCESS;
+}
 
-	reset_managed_buffer(&spdm_context->transcript.message_a);
-	reset_managed_buffer(&spdm_context->transcript.message_b);
-	reset_managed_buffer(&spdm_context->transcript.message_c);
+/**
+  This function processes VERSION, the response to GET_VERSION.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  request                      A pointer to the GET_VERSION request.
+  @param  spdm_response_size            size in bytes of the response.
+  @param  response                     A pointer to the response.
+
+  @retval RETURN_SUCCESS               The VERSION is processed.
+  @retval RETURN_DEVICE_ERROR          The response is invalid.
+  @retval RETURN_NO_RESPONSE           The responder is busy.
+**/
+return_status spdm_process_version_response(IN spdm_context_t *spdm_context,
+					    IN void *request,
+					    IN uintn spdm_response_size,
+					    IN void *response)
+{
+	return_status status;
+	spdm_get_version_request_t *spdm_request;
+	spdm_version_response_max_t *spdm_response;
+	uintn index;
+	uint8 version;
+	uint8 compatible_version_count;
+	spdm_version_number_t
+		compatible_version_number_entry[MAX_SPDM_VERSION_COUNT];
+
+	spdm_request = request;
+	spdm_response = response;
 
-	spdm_response_size = sizeof(spdm_response);
-	zero_mem(&spdm_response, sizeof(spdm_response));
-	status = spdm_receive_spdm_response(
-		spdm_context, NULL, &spdm_response_size, &spdm_response);
-	if (RETURN_ERROR(status)) {
-		return RETURN_DEVICE_ERROR;
-	}
 	if (spdm_response_size < sizeof(spdm_message_header_t)) {
 		return RETURN_DEVICE_ERROR;
 	}
-	if (spdm_response.header.spdm_version != SPDM_MESSAGE_VERSION_10) {
+	if (spdm_response->header.spdm_version != SPDM_MESSAGE_VERSION_10) {
 		return RETURN_DEVICE_ERROR;
 	}
-	if (spdm_response.header.request_response_code == SPDM_ERROR) {
+	if (spdm_response->header.request_response_code == SPDM_ERROR) {
 		status = spdm_handle_simple_error_response(
-			spdm_context, spdm_response.header.param1);
+			spdm_context, spdm_response->header.param1);
 		if (RETURN_ERROR(status)) {
 			return status;
 		}
-	} else if (spdm_response.header.request_response_code != SPDM_VERSION) {
+	} else if (spdm_response->header.request_response_code != SPDM_VERSION) {
 		return RETURN_DEVICE_ERROR;
 	}
 	if (spdm_response_size < sizeof(spdm_version_response)) {
 		return RETURN_DEVICE_ERROR;
 	}
-	if (spdm_response_size > sizeof(spdm_response)) {
+	if (spdm_response_size > sizeof(spdm_version_response_max_t)) {
 		return RETURN_DEVICE_ERROR;
 	}
-	if (spdm_response.version_number_entry_count > MAX_SPDM_VERSION_COUNT) {
+	if (spdm_response->version_number_entry_count > MAX_SPDM_VERSION_COUNT) {
 		return RETURN_DEVICE_ERROR;
 	}
-	if (spdm_response.version_number_entry_count == 0) {
+	if (spdm_response->version_number_entry_count == 0) {
 		return RETURN_DEVICE_ERROR;
 	}
 	if (spdm_response_size <
 	    sizeof(spdm_version_response) +
-		    spdm_response.version_number_entry_count *
+		    spdm_response->version_number_entry_count *
 			    sizeof(spdm_version_number_t)) {
 		return RETURN_DEVICE_ERROR;
 	}
 	spdm_response_size = sizeof(spdm_version_response) +
-			     spdm_response.version_number_entry_count *
+			     spdm_response->version_number_entry_count *
 				     sizeof(spdm_version_number_t);
 	//
 	// Cache data
 	//
-	status = spdm_append_message_a(spdm_context, &spdm_request,
-				       sizeof(spdm_request));
+	status = spdm_append_message_a(spdm_context, spdm_request,
+				       sizeof(spdm_get_version_request_t));
 	if (RETURN_ERROR(status)) {
 		return RETURN_SECURITY_VIOLATION;
 	}
-	status = spdm_append_message_a(spdm_context, &spdm_response,
+	status = spdm_append_message_a(spdm_context, spdm_response,
 				       spdm_response_size);
 	if (RETURN_ERROR(status)) {
 		reset_managed_buffer(&spdm_context->transcript.message_a);
@@ -119,17 +134,17 @@ return_status try_spdm_get_version(IN spdm_context_t *spdm_context)
 
 	zero_mem(&compatible_version_number_entry,
 		 sizeof(compatible_version_number_entry));
-	for (index = 0; index < spdm_response.version_number_entry_count;
+	for (index = 0; index < spdm_response->version_number_entry_count;
 	     index++) {
 		version = (uint8)(
-			(spdm_response.version_number_entry[index].major_version
+			(spdm_response->version_number_entry[index].major_version
 			 << 4) |
-			spdm_response.version_number_entry[index].minor_version);
+			spdm_response->version_number_entry[index].minor_version);
 
 		if (version == SPDM_MESSAGE_VERSION_11 ||
 		    version == SPDM_MESSAGE_VERSION_10) {
 			compatible_version_number_entry[compatible_version_count] =
-				spdm_response.version_number_entry[index];
+				spdm_response->version_number_entry[index];
 			compatible_version_count++;
 		}
 	}
@@ -147,6 +162,44 @@ return_status try_spdm_get_version(IN spdm_context_t *spdm_context)
 	return RETURN_SUCCESS;
 }
 
+/**
+  This function sends GET_VERSION and receives VERSION.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+
+  @retval RETURN_SUCCESS               The GET_VERSION is sent and the VERSION is received.
+  @retval RETURN_DEVICE_ERROR          A device error occurs when communicates with the device.
+**/
+return_status try_spdm_get_version(IN spdm_context_t *spdm_context)
+{
+	return_status status;
+	spdm_get_version_request_t spdm_request;
+	spdm_version_response_max_t spdm_response;
+	uintn spdm_response_size;
+
+	status = spdm_build_get_version_request(spdm_context, &spdm_request);
+	if (RETURN_ERROR(status)) {
+		return status;
+	}
+
+	status = spdm_send_spdm_request(spdm_context, NULL,
+					sizeof(spdm_request), &spdm_request);
+	if (RETURN_ERROR(status)) {
+		return RETURN_DEVICE_ERROR;
+	}
+
+	spdm_response_size = sizeof(spdm_response);
+	zero_mem(&spdm_response, sizeof(spdm_response));
+	status = spdm_receive_spdm_response(
+		spdm_context, NULL, &spdm_response_size, &spdm_response);
+	if (RETURN_ERROR(status)) {
+		return RETURN_DEVICE_ERROR;
+	}
+	return spdm_process_version_response(spdm_context, &spdm_request,
+					     spdm_response_size,
+					     &spdm_response);
+}
+
 /**
   This function sends GET_VERSION and receives VERSION.
 
@@ -35,45 +35,38 @@ typedef struct {
 #pragma pack()
 
 /**
-  This function sends KEY_EXCHANGE and receives KEY_EXCHANGE_RSP for SPDM key exchange.
+  This function builds KEY_EXCHANGE for SPDM key exchange.
+
+  A requester session ID is allocated and a DHE key pair is generated.
+  The caller owns the returned DHE context until it is passed to
+  spdm_process_key_exchange_rsp_response.
 
   @param  spdm_context                  A pointer to the SPDM context.
   @param  measurement_hash_type          measurement_hash_type to the KEY_EXCHANGE request.
   @param  slot_id                      slot_id to the KEY_EXCHANGE request.
-  @param  heartbeat_period              heartbeat_period from the KEY_EXCHANGE_RSP response.
-  @param  session_id                    session_id from the KEY_EXCHANGE_RSP response.
-  @param  req_slot_id_param               req_slot_id_param from the KEY_EXCHANGE_RSP response.
-  @param  measurement_hash              measurement_hash from the KEY_EXCHANGE_RSP response.
-
-  @retval RETURN_SUCCESS               The KEY_EXCHANGE is sent and the KEY_EXCHANGE_RSP is received.
-  @retval RETURN_DEVICE_ERROR          A device error occurs when communicates with the device.
+  @param  spdm_request_size             On output, size in bytes of the KEY_EXCHANGE request.
+  @param  request                      A pointer to a destination buffer to store the KEY_EXCHANGE request.
+  @param  dhe_context                   On output, the DHE context of the requester.
+
+  @retval RETURN_SUCCESS               The KEY_EXCHANGE is built.
+  @retval RETURN_UNSUPPORTED           The capabilities or the connection state do not allow KEY_EXCHANGE.
+  @retval RETURN_INVALID_PARAMETER     The slot_id is invalid.
+  @retval RETURN_DEVICE_ERROR          The DHE key cannot be generated.
 **/
-return_status try_spdm_send_receive_key_exchange(
-	IN spdm_context_t *spdm_context, IN uint8 measurement_hash_type,
-	IN uint8 slot_id, OUT uint32 *session_id, OUT uint8 *heartbeat_period,
-	OUT uint8 *req_slot_id_param, OUT void *measurement_hash)
+return_status spdm_build_key_exchange_request(IN spdm_context_t *spdm_context,
+					      IN uint8 measurement_hash_type,
+					      IN uint8 slot_id,
+					      OUT uintn *spdm_request_size,
+					      OUT void *request,
+					      OUT void **dhe_context)
 {
-	boolean result;
 	return_status status;
-	spdm_key_exchange_request_mine_t spdm_request;
-	uintn spdm_request_size;
-	spdm_key_exchange_response_max_t spdm_response;
-	uintn spdm_response_size;
+	spdm_key_exchange_request_mine_t *spdm_request;
 	uintn dhe_key_size;
-	uint32 measurement_summary_hash_size;
-	uint32 signature_size;
-	uint32 hmac_size;
 	uint8 *ptr;
-	void *measurement_summary_hash;
-	uint16 opaque_length;
-	uint8 *signature;
-	uint8 *verify_data;
-	void *dhe_context;
-	uint16 req_session_id;
-	uint16 rsp_session_id;
-	spdm_session_info_t *session_info;
 	uintn opaque_key_exchange_req_size;
-	uint8 th1_hash_data[64];
+
+	spdm_request = request;
 
 	if (!spdm_is_capabilities_flag_supported(
 		    spdm_context, TRUE,
@@ -92,34 +85,35 @@ return_status try_spdm_send_receive_key_exchange(
 		return RETURN_INVALID_PARAMETER;
 	}
 	if ((slot_id == 0xFF) &&
-	    (spdm_context->local_context.peer_cert_chain_provision_size == 0)) {
+	    (spdm_context->local_context->peer_cert_chain_provision_size == 0)) {
 		return RETURN_INVALID_PARAMETER;
 	}
 
 	spdm_context->error_state = SPDM_STATUS_ERROR_DEVICE_NO_CAPABILITIES;
 
-	spdm_request.header.spdm_version = SPDM_MESSAGE_VERSION_11;
-	spdm_request.header.request_response_code = SPDM_KEY_EXCHANGE;
-	spdm_request.header.param1 = measurement_hash_type;
-	spdm_request.header.param2 = slot_id;
-	spdm_get_random_number(SPDM_RANDOM_DATA_SIZE, spdm_request.random_data);
+	spdm_request->header.spdm_version = SPDM_MESSAGE_VERSION_11;
+	spdm_request->header.request_response_code = SPDM_KEY_EXCHANGE;
+	spdm_request->header.param1 = measurement_hash_type;
+	spdm_request->header.param2 = slot_id;
+	spdm_get_random_number(SPDM_RANDOM_DATA_SIZE, spdm_request->random_data);
 	DEBUG((DEBUG_INFO, "ClientRandomData (0x%x) - ",
 	       SPDM_RANDOM_DATA_SIZE));
-	internal_dump_data(spdm_request.random_data, SPDM_RANDOM_DATA_SIZE);
+	internal_dump_data(spdm_request->random_data, SPDM_RANDOM_DATA_SIZE);
 	DEBUG((DEBUG_INFO, "\n"));
 
-	req_session_id = spdm_allocate_req_session_id(spdm_context);
-	spdm_request.req_session_id = req_session_id;
-	spdm_request.reserved = 0;
+	spdm_request->req_session_id = spdm_allocate_req_session_id(spdm_context);
+	spdm_request->reserved = 0;
 
-	ptr = spdm_request.exchange_data;
+	ptr = spdm_request->exchange_data;
 	dhe_key_size = spdm_get_dhe_pub_key_size(
 		spdm_context->connection_info.algorithm.dhe_named_group);
-	dhe_context = spdm_secured_message_dhe_new(
-		spdm_context->connection_info.algorithm.dhe_named_group);
-	spdm_secured_message_dhe_generate_key(
-		spdm_context->connection_info.algorithm.dhe_named_group,
-		dhe_context, ptr, &dhe_key_size);
+	*dhe_context = spdm_acquire_dhe_key(
+		spdm_context,
+		spdm_context->connection_info.algorithm.dhe_named_group, ptr,
+		&dhe_key_size);
+	if (*dhe_context == NULL) {
+		return RETURN_DEVICE_ERROR;
+	}
 	DEBUG((DEBUG_INFO, "ClientKey (0x%x):\n", dhe_key_size));
 	internal_dump_hex(ptr, dhe_key_size);
 	ptr += dhe_key_size;
@@ -133,36 +127,71 @@ return_status try_spdm_send_receive_key_exchange(
 	ASSERT_RETURN_ERROR(status);
 	ptr += opaque_key_exchange_req_size;
 
-	spdm_request_size = (uintn)ptr - (uintn)&spdm_request;
-	status = spdm_send_spdm_request(spdm_context, NULL, spdm_request_size,
-					&spdm_request);
-	if (RETURN_ERROR(status)) {
-		spdm_secured_message_dhe_free(
-			spdm_context->connection_info.algorithm.dhe_named_group,
-			dhe_context);
-		return RETURN_DEVICE_ERROR;
-	}
+	*spdm_request_size = (uintn)ptr - (uintn)spdm_request;
+	return RETURN_SUCCESS;
+}
+
+/**
+  This function processes KEY_EXCHANGE_RSP, the response to KEY_EXCHANGE.
+
+  The DHE context is always freed by this function.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  measurement_hash_type          measurement_hash_type to the KEY_EXCHANGE request.
+  @param  spdm_request_size             size in bytes of the KEY_EXCHANGE request.
+  @param  request                      A pointer to the KEY_EXCHANGE request.
+  @param  dhe_context                   The DHE context returned by spdm_build_key_exchange_request.
+  @param  spdm_response_size            size in bytes of the response.
+  @param  response                     A pointer to the response.
+  @param  session_id                    session_id from the KEY_EXCHANGE_RSP response.
+  @param  heartbeat_period              heartbeat_period from the KEY_EXCHANGE_RSP response.
+  @param  req_slot_id_param               req_slot_id_param from the KEY_EXCHANGE_RSP response.
+  @param  measurement_hash              measurement_hash from the KEY_EXCHANGE_RSP response.
+
+  @retval RETURN_SUCCESS               The KEY_EXCHANGE_RSP is processed.
+  @retval RETURN_DEVICE_ERROR          The response is invalid.
+  @retval RETURN_SECURITY_VIOLATION    Any verification fails.
+  @retval RETURN_NO_RESPONSE           The responder is busy.
+**/
+return_status spdm_process_key_exchange_rsp_response(
+	IN spdm_context_t *spdm_context, IN uint8 measurement_hash_type,
+	IN uintn spdm_request_size, IN void *request, IN void *dhe_context,
+	IN uintn spdm_response_size, IN void *response, OUT uint32 *session_id,
+	OUT uint8 *heartbeat_period, OUT uint8 *req_slot_id_param,
+	OUT void *measurement_hash)
+{
+	boolean result;
+	return_status status;
+	spdm_key_exchange_request_mine_t *spdm_request;
+	spdm_key_exchange_response_max_t *spdm_response;
+	uintn dhe_key_size;
+	uint32 measurement_summary_hash_size;
+	uint32 signature_size;
+	uint32 hmac_size;
+	uint8 *ptr;
+	void *measurement_summary_hash;
+	uint16 opaque_length;
+	uint8 *signature;
+	uint8 *verify_data;
+	uint16 rsp_session_id;
+	spdm_session_info_t *session_info;
+	uint8 th1_hash_data[64];
+
+	spdm_request = request;
+	spdm_response = response;
+	dhe_key_size = spdm_get_dhe_pub_key_size(
+		spdm_context->connection_info.algorithm.dhe_named_group);
 
-	spdm_response_size = sizeof(spdm_response);
-	zero_mem(&spdm_response, sizeof(spdm_response));
-	status = spdm_receive_spdm_response(
-		spdm_context, NULL, &spdm_response_size, &spdm_response);
-	if (RETURN_ERROR(status)) {
-		spdm_secured_message_dhe_free(
-			spdm_context->connection_info.algorithm.dhe_named_group,
-			dhe_context);
-		return RETURN_DEVICE_ERROR;
-	}
 	if (spdm_response_size < sizeof(spdm_message_header_t)) {
 		spdm_secured_message_dhe_free(
 			spdm_context->connection_info.algorithm.dhe_named_group,
 			dhe_context);
 		return RETURN_DEVICE_ERROR;
 	}
-	if (spdm_response.header.request_response_code == SPDM_ERROR) {
+	if (spdm_response->header.request_response_code == SPDM_ERROR) {
 		status = spdm_handle_error_response_main(
 			spdm_context, NULL, NULL, 0, &spdm_response_size,
-			&spdm_response, SPDM_KEY_EXCHANGE,
+			spdm_response, SPDM_KEY_EXCHANGE,
 			SPDM_KEY_EXCHANGE_RSP,
 			sizeof(spdm_key_exchange_response_max_t));
 		if (RETURN_ERROR(status)) {
@@ -172,7 +201,7 @@ return_status try_spdm_send_receive_key_exchange(
 				dhe_context);
 			return status;
 		}
-	} else if (spdm_response.header.request_response_code !=
+	} else if (spdm_response->header.request_response_code !=
 		   SPDM_KEY_EXCHANGE_RSP) {
 		spdm_secured_message_dhe_free(
 			spdm_context->connection_info.algorithm.dhe_named_group,
@@ -185,7 +214,7 @@ return_status try_spdm_send_receive_key_exchange(
 			dhe_context);
 		return RETURN_DEVICE_ERROR;
 	}
-	if (spdm_response_size > sizeof(spdm_response)) {
+	if (spdm_response_size > sizeof(spdm_key_exchange_response_max_t)) {
 		spdm_secured_message_dhe_free(
 			spdm_context->connection_info.algorithm.dhe_named_group,
 			dhe_context);
@@ -193,13 +222,13 @@ return_status try_spdm_send_receive_key_exchange(
 	}
 
 	if (heartbeat_period != NULL) {
-		*heartbeat_period = spdm_response.header.param1;
+		*heartbeat_period = spdm_response->header.param1;
 	}
-	*req_slot_id_param = spdm_response.req_slot_id_param;
-	if (spdm_response.mut_auth_requested != 0) {
+	*req_slot_id_param = spdm_response->req_slot_id_param;
+	if (spdm_response->mut_auth_requested != 0) {
 		if ((*req_slot_id_param != 0xF) &&
 		    (*req_slot_id_param >=
-		     spdm_context->local_context.slot_count)) {
+		     spdm_context->local_context->slot_count)) {
 			spdm_secured_message_dhe_free(
 				spdm_context->connection_info.algorithm
 					.dhe_named_group,
@@ -215,8 +244,8 @@ return_status try_spdm_send_receive_key_exchange(
 			return RETURN_DEVICE_ERROR;
 		}
 	}
-	rsp_session_id = spdm_response.rsp_session_id;
-	*session_id = (req_session_id << 16) | rsp_session_id;
+	rsp_session_id = spdm_response->rsp_session_id;
+	*session_id = (spdm_request->req_session_id << 16) | rsp_session_id;
 	session_info = spdm_assign_session_id(spdm_context, *session_id, FALSE);
 	if (session_info == NULL) {
 		spdm_secured_message_dhe_free(
@@ -252,13 +281,13 @@ return_status try_spdm_send_receive_key_exchange(
 
 	DEBUG((DEBUG_INFO, "ServerRandomData (0x%x) - ",
 	       SPDM_RANDOM_DATA_SIZE));
-	internal_dump_data(spdm_response.random_data, SPDM_RANDOM_DATA_SIZE);
+	internal_dump_data(spdm_response->random_data, SPDM_RANDOM_DATA_SIZE);
 	DEBUG((DEBUG_INFO, "\n"));
 
 	DEBUG((DEBUG_INFO, "ServerKey (0x%x):\n", dhe_key_size));
-	internal_dump_hex(spdm_response.exchange_data, dhe_key_size);
+	internal_dump_hex(spdm_response->exchange_data, dhe_key_size);
 
-	ptr = spdm_response.exchange_data;
+	ptr = spdm_response->exchange_data;
 	ptr += dhe_key_size;
 
 	measurement_summary_hash = ptr;
@@ -272,6 +301,10 @@ return_status try_spdm_send_receive_key_exchange(
 
 	opaque_length = *(uint16 *)ptr;
 	if (opaque_length > MAX_SPDM_OPAQUE_DATA_SIZE) {
+		spdm_free_session_id(spdm_context, *session_id);
+		spdm_secured_message_dhe_free(
+			spdm_context->connection_info.algorithm.dhe_named_group,
+			dhe_context);
 		return RETURN_SECURITY_VIOLATION;
 	}
 	ptr += sizeof(uint16);
@@ -305,7 +338,8 @@ return_status try_spdm_send_receive_key_exchange(
 	//
 	// Cache session data
 	//
-	status = spdm_append_message_k(session_info, &spdm_request,
+	status = spdm_append_message_k(spdm_context, session_info, TRUE,
+				       spdm_request,
 				       spdm_request_size);
 	if (RETURN_ERROR(status)) {
 		spdm_free_session_id(spdm_context, *session_id);
@@ -315,7 +349,8 @@ return_status try_spdm_send_receive_key_exchange(
 		return RETURN_SECURITY_VIOLATION;
 	}
 
-	status = spdm_append_message_k(session_info, &spdm_response,
+	status = spdm_append_message_k(spdm_context, session_info, TRUE,
+				       spdm_response,
 				       spdm_response_size - signature_size -
 					       hmac_size);
 	if (RETURN_ERROR(status)) {
@@ -342,7 +377,8 @@ return_status try_spdm_send_receive_key_exchange(
 		return RETURN_SECURITY_VIOLATION;
 	}
 
-	status = spdm_append_message_k(session_info, signature, signature_size);
+	status = spdm_append_message_k(spdm_context, session_info, TRUE,
+				       signature, signature_size);
 	if (RETURN_ERROR(status)) {
 		spdm_free_session_id(spdm_context, *session_id);
 		spdm_secured_message_dhe_free(
@@ -356,7 +392,7 @@ return_status try_spdm_send_receive_key_exchange(
 	//
 	result = spdm_secured_message_dhe_compute_key(
 		spdm_context->connection_info.algorithm.dhe_named_group,
-		dhe_context, spdm_response.exchange_data, dhe_key_size,
+		dhe_context, spdm_response->exchange_data, dhe_key_size,
 		session_info->secured_message_context);
 	spdm_secured_message_dhe_free(
 		spdm_context->connection_info.algorithm.dhe_named_group,
@@ -398,8 +434,8 @@ return_status try_spdm_send_receive_key_exchange(
 		}
 		ptr += hmac_size;
 
-		status = spdm_append_message_k(session_info, verify_data,
-					       hmac_size);
+		status = spdm_append_message_k(spdm_context, session_info,
+					       TRUE, verify_data, hmac_size);
 		if (RETURN_ERROR(status)) {
 			spdm_free_session_id(spdm_context, *session_id);
 			return RETURN_SECURITY_VIOLATION;
@@ -410,7 +446,7 @@ return_status try_spdm_send_receive_key_exchange(
 		copy_mem(measurement_hash, measurement_summary_hash,
 			 measurement_summary_hash_size);
 	}
-	session_info->mut_auth_requested = spdm_response.mut_auth_requested;
+	session_info->mut_auth_requested = spdm_response->mut_auth_requested;
 
 	spdm_secured_message_set_session_state(
 		session_info->secured_message_context,
@@ -420,6 +456,66 @@ return_status try_spdm_send_receive_key_exchange(
 	return RETURN_SUCCESS;
 }
 
+/**
+  This function sends KEY_EXCHANGE and receives KEY_EXCHANGE_RSP for SPDM key exchange.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  measurement_hash_type          measurement_hash_type to the KEY_EXCHANGE request.
+  @param  slot_id                      slot_id to the KEY_EXCHANGE request.
+  @param  heartbeat_period              heartbeat_period from the KEY_EXCHANGE_RSP response.
+  @param  session_id                    session_id from the KEY_EXCHANGE_RSP response.
+  @param  req_slot_id_param               req_slot_id_param from the KEY_EXCHANGE_RSP response.
+  @param  measurement_hash              measurement_hash from the KEY_EXCHANGE_RSP response.
+
+  @retval RETURN_SUCCESS               The KEY_EXCHANGE is sent and the KEY_EXCHANGE_RSP is received.
+  @retval RETURN_DEVICE_ERROR          A device error occurs when communicates with the device.
+**/
+return_status try_spdm_send_receive_key_exchange(
+	IN spdm_context_t *spdm_context, IN uint8 measurement_hash_type,
+	IN uint8 slot_id, OUT uint32 *session_id, OUT uint8 *heartbeat_period,
+	OUT uint8 *req_slot_id_param, OUT void *measurement_hash)
+{
+	return_status status;
+	spdm_key_exchange_request_mine_t spdm_request;
+	uintn spdm_request_size;
+	spdm_key_exchange_response_max_t spdm_response;
+	uintn spdm_response_size;
+	void *dhe_context;
+
+	status = spdm_build_key_exchange_request(spdm_context,
+						 measurement_hash_type, slot_id,
+						 &spdm_request_size,
+						 &spdm_request, &dhe_context);
+	if (RETURN_ERROR(status)) {
+		return status;
+	}
+
+	status = spdm_send_spdm_request(spdm_context, NULL, spdm_request_size,
+					&spdm_request);
+	if (RETURN_ERROR(status)) {
+		spdm_secured_message_dhe_free(
+			spdm_context->connection_info.algorithm.dhe_named_group,
+			dhe_context);
+		return RETURN_DEVICE_ERROR;
+	}
+
+	spdm_response_size = sizeof(spdm_response);
+	zero_mem(&spdm_response, sizeof(spdm_response));
+	status = spdm_receive_spdm_response(
+		spdm_context, NULL, &spdm_response_size, &spdm_response);
+	if (RETURN_ERROR(status)) {
+		spdm_secured_message_dhe_free(
+			spdm_context->connection_info.algorithm.dhe_named_group,
+			dhe_context);
+		return RETURN_DEVICE_ERROR;
+	}
+	return spdm_process_key_exchange_rsp_response(
+		spdm_context, measurement_hash_type, spdm_request_size,
+		&spdm_request, dhe_context, spdm_response_size, &spdm_response,
+		session_id, heartbeat_period, req_slot_id_param,
+		measurement_hash);
+}
+
 return_status spdm_send_receive_key_exchange(
 	IN spdm_context_t *spdm_context, IN uint8 measurement_hash_type,
 	IN uint8 slot_id, OUT uint32 *session_id, OUT uint8 *heartbeat_period,
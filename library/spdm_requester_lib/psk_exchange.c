@@ -34,41 +34,32 @@ typedef struct {
 #pragma pack()
 
 /**
-  This function sends PSK_EXCHANGE and receives PSK_EXCHANGE_RSP for SPDM PSK exchange.
+  This function builds PSK_EXCHANGE for SPDM PSK exchange.
+
+  A requester session ID is allocated for the new session.
 
   @param  spdm_context                  A pointer to the SPDM context.
   @param  measurement_hash_type          measurement_hash_type to the PSK_EXCHANGE request.
-  @param  heartbeat_period              heartbeat_period from the PSK_EXCHANGE_RSP response.
-  @param  session_id                    session_id from the PSK_EXCHANGE_RSP response.
-  @param  measurement_hash              measurement_hash from the PSK_EXCHANGE_RSP response.
+  @param  spdm_request_size             On output, size in bytes of the PSK_EXCHANGE request.
+  @param  request                      A pointer to a destination buffer to store the PSK_EXCHANGE request.
 
-  @retval RETURN_SUCCESS               The PSK_EXCHANGE is sent and the PSK_EXCHANGE_RSP is received.
-  @retval RETURN_DEVICE_ERROR          A device error occurs when communicates with the device.
+  @retval RETURN_SUCCESS               The PSK_EXCHANGE is built.
+  @retval RETURN_UNSUPPORTED           The capabilities or the connection state do not allow PSK_EXCHANGE.
+  @retval RETURN_DEVICE_ERROR          The negotiated algorithms are invalid.
 **/
-return_status try_spdm_send_receive_psk_exchange(
-	IN spdm_context_t *spdm_context, IN uint8 measurement_hash_type,
-	OUT uint32 *session_id, OUT uint8 *heartbeat_period,
-	OUT void *measurement_hash)
+return_status spdm_build_psk_exchange_request(IN spdm_context_t *spdm_context,
+					      IN uint8 measurement_hash_type,
+					      OUT uintn *spdm_request_size,
+					      OUT void *request)
 {
-	boolean result;
 	return_status status;
-	spdm_psk_exchange_request_mine_t spdm_request;
-	uintn spdm_request_size;
-	spdm_psk_exchange_response_max_t spdm_response;
-	uintn spdm_response_size;
-	uint32 measurement_summary_hash_size;
-	uint32 hmac_size;
+	spdm_psk_exchange_request_mine_t *spdm_request;
 	uint8 *ptr;
-	void *measurement_summary_hash;
-	uint8 *verify_data;
-	uint16 req_session_id;
-	uint16 rsp_session_id;
-	spdm_session_info_t *session_info;
 	uintn opaque_psk_exchange_req_size;
-	uint8 th1_hash_data[64];
-	uint8 th2_hash_data[64];
 	uint32 algo_size;
 
+	spdm_request = request;
+
 	// Check capabilities even if GET_CAPABILITIES is not sent.
 	// Assuming capabilities are provisioned.
 	if (!spdm_is_capabilities_flag_supported(
@@ -114,81 +105,113 @@ return_status try_spdm_send_receive_psk_exchange(
 
 	spdm_context->error_state = SPDM_STATUS_ERROR_DEVICE_NO_CAPABILITIES;
 
-	spdm_request.header.spdm_version = SPDM_MESSAGE_VERSION_11;
-	spdm_request.header.request_response_code = SPDM_PSK_EXCHANGE;
-	spdm_request.header.param1 = measurement_hash_type;
-	spdm_request.header.param2 = 0;
-	spdm_request.psk_hint_length =
-		(uint16)spdm_context->local_context.psk_hint_size;
-	spdm_request.context_length = DEFAULT_CONTEXT_LENGTH;
+	spdm_request->header.spdm_version = SPDM_MESSAGE_VERSION_11;
+	spdm_request->header.request_response_code = SPDM_PSK_EXCHANGE;
+	spdm_request->header.param1 = measurement_hash_type;
+	spdm_request->header.param2 = 0;
+	spdm_request->psk_hint_length =
+		(uint16)spdm_context->local_context->psk_hint_size;
+	spdm_request->context_length = DEFAULT_CONTEXT_LENGTH;
 	opaque_psk_exchange_req_size =
 		spdm_get_opaque_data_supported_version_data_size(spdm_context);
-	spdm_request.opaque_length = (uint16)opaque_psk_exchange_req_size;
+	spdm_request->opaque_length = (uint16)opaque_psk_exchange_req_size;
 
-	req_session_id = spdm_allocate_req_session_id(spdm_context);
-	spdm_request.req_session_id = req_session_id;
+	spdm_request->req_session_id = spdm_allocate_req_session_id(spdm_context);
 
-	ptr = spdm_request.psk_hint;
-	copy_mem(ptr, spdm_context->local_context.psk_hint,
-		 spdm_context->local_context.psk_hint_size);
-	DEBUG((DEBUG_INFO, "psk_hint (0x%x) - ", spdm_request.psk_hint_length));
-	internal_dump_data(ptr, spdm_request.psk_hint_length);
+	ptr = spdm_request->psk_hint;
+	copy_mem(ptr, spdm_context->local_context->psk_hint,
+		 spdm_context->local_context->psk_hint_size);
+	DEBUG((DEBUG_INFO, "psk_hint (0x%x) - ", spdm_request->psk_hint_length));
+	internal_dump_data(ptr, spdm_request->psk_hint_length);
 	DEBUG((DEBUG_INFO, "\n"));
-	ptr += spdm_request.psk_hint_length;
+	ptr += spdm_request->psk_hint_length;
 
 	spdm_get_random_number(DEFAULT_CONTEXT_LENGTH, ptr);
 	DEBUG((DEBUG_INFO, "ClientRandomData (0x%x) - ",
-	       spdm_request.context_length));
-	internal_dump_data(ptr, spdm_request.context_length);
+	       spdm_request->context_length));
+	internal_dump_data(ptr, spdm_request->context_length);
 	DEBUG((DEBUG_INFO, "\n"));
-	ptr += spdm_request.context_length;
+	ptr += spdm_request->context_length;
 
 	status = spdm_build_opaque_data_supported_version_data(
 		spdm_context, &opaque_psk_exchange_req_size, ptr);
 	ASSERT_RETURN_ERROR(status);
 	ptr += opaque_psk_exchange_req_size;
 
-	spdm_request_size = (uintn)ptr - (uintn)&spdm_request;
-	status = spdm_send_spdm_request(spdm_context, NULL, spdm_request_size,
-					&spdm_request);
-	if (RETURN_ERROR(status)) {
-		return RETURN_DEVICE_ERROR;
-	}
+	*spdm_request_size = (uintn)ptr - (uintn)spdm_request;
+	return RETURN_SUCCESS;
+}
+
+/**
+  This function processes PSK_EXCHANGE_RSP, the response to PSK_EXCHANGE.
+
+  If the responder does not support PSK_FINISH, the session is established directly.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  measurement_hash_type          measurement_hash_type to the PSK_EXCHANGE request.
+  @param  spdm_request_size             size in bytes of the PSK_EXCHANGE request.
+  @param  request                      A pointer to the PSK_EXCHANGE request.
+  @param  spdm_response_size            size in bytes of the response.
+  @param  response                     A pointer to the response.
+  @param  session_id                    session_id from the PSK_EXCHANGE_RSP response.
+  @param  heartbeat_period              heartbeat_period from the PSK_EXCHANGE_RSP response.
+  @param  measurement_hash              measurement_hash from the PSK_EXCHANGE_RSP response.
+
+  @retval RETURN_SUCCESS               The PSK_EXCHANGE_RSP is processed.
+  @retval RETURN_DEVICE_ERROR          The response is invalid.
+  @retval RETURN_SECURITY_VIOLATION    Any verification fails.
+  @retval RETURN_NO_RESPONSE           The responder is busy.
+**/
+return_status spdm_process_psk_exchange_rsp_response(
+	IN spdm_context_t *spdm_context, IN uint8 measurement_hash_type,
+	IN uintn spdm_request_size, IN void *request,
+	IN uintn spdm_response_size, IN void *response, OUT uint32 *session_id,
+	OUT uint8 *heartbeat_period, OUT void *measurement_hash)
+{
+	boolean result;
+	return_status status;
+	spdm_psk_exchange_request_mine_t *spdm_request;
+	spdm_psk_exchange_response_max_t *spdm_response;
+	uint32 measurement_summary_hash_size;
+	uint32 hmac_size;
+	uint8 *ptr;
+	void *measurement_summary_hash;
+	uint8 *verify_data;
+	uint16 rsp_session_id;
+	spdm_session_info_t *session_info;
+	uint8 th1_hash_data[64];
+	uint8 th2_hash_data[64];
+
+	spdm_request = request;
+	spdm_response = response;
 
-	spdm_response_size = sizeof(spdm_response);
-	zero_mem(&spdm_response, sizeof(spdm_response));
-	status = spdm_receive_spdm_response(
-		spdm_context, NULL, &spdm_response_size, &spdm_response);
-	if (RETURN_ERROR(status)) {
-		return RETURN_DEVICE_ERROR;
-	}
 	if (spdm_response_size < sizeof(spdm_message_header_t)) {
 		return RETURN_DEVICE_ERROR;
 	}
-	if (spdm_response.header.request_response_code == SPDM_ERROR) {
+	if (spdm_response->header.request_response_code == SPDM_ERROR) {
 		status = spdm_handle_error_response_main(
 			spdm_context, NULL, NULL, 0, &spdm_response_size,
-			&spdm_response, SPDM_PSK_EXCHANGE,
+			spdm_response, SPDM_PSK_EXCHANGE,
 			SPDM_PSK_EXCHANGE_RSP,
 			sizeof(spdm_psk_exchange_response_max_t));
 		if (RETURN_ERROR(status)) {
 			return status;
 		}
-	} else if (spdm_response.header.request_response_code !=
+	} else if (spdm_response->header.request_response_code !=
 		   SPDM_PSK_EXCHANGE_RSP) {
 		return RETURN_DEVICE_ERROR;
 	}
 	if (spdm_response_size < sizeof(spdm_psk_exchange_response_t)) {
 		return RETURN_DEVICE_ERROR;
 	}
-	if (spdm_response_size > sizeof(spdm_response)) {
+	if (spdm_response_size > sizeof(spdm_psk_exchange_response_max_t)) {
 		return RETURN_DEVICE_ERROR;
 	}
 	if (heartbeat_period != NULL) {
-		*heartbeat_period = spdm_response.header.param1;
+		*heartbeat_period = spdm_response->header.param1;
 	}
-	rsp_session_id = spdm_response.rsp_session_id;
-	*session_id = (req_session_id << 16) | rsp_session_id;
+	rsp_session_id = spdm_response->rsp_session_id;
+	*session_id = (spdm_request->req_session_id << 16) | rsp_session_id;
 	session_info = spdm_assign_session_id(spdm_context, *session_id, TRUE);
 	if (session_info == NULL) {
 		return RETURN_DEVICE_ERROR;
@@ -201,27 +224,27 @@ return_status try_spdm_send_receive_psk_exchange(
 
 	if (spdm_response_size <
 	    sizeof(spdm_psk_exchange_response_t) +
-		    spdm_response.context_length + spdm_response.opaque_length +
+		    spdm_response->context_length + spdm_response->opaque_length +
 		    measurement_summary_hash_size + hmac_size) {
 		spdm_free_session_id(spdm_context, *session_id);
 		return RETURN_DEVICE_ERROR;
 	}
 
-	ptr = (uint8 *)&spdm_response + sizeof(spdm_psk_exchange_response_t) +
-	      measurement_summary_hash_size + spdm_response.context_length;
+	ptr = (uint8 *)spdm_response + sizeof(spdm_psk_exchange_response_t) +
+	      measurement_summary_hash_size + spdm_response->context_length;
 	status = spdm_process_opaque_data_version_selection_data(
-		spdm_context, spdm_response.opaque_length, ptr);
+		spdm_context, spdm_response->opaque_length, ptr);
 	if (RETURN_ERROR(status)) {
 		spdm_free_session_id(spdm_context, *session_id);
 		return RETURN_UNSUPPORTED;
 	}
 
 	spdm_response_size = sizeof(spdm_psk_exchange_response_t) +
-			     spdm_response.context_length +
-			     spdm_response.opaque_length +
+			     spdm_response->context_length +
+			     spdm_response->opaque_length +
 			     measurement_summary_hash_size + hmac_size;
 
-	ptr = (uint8 *)(spdm_response.measurement_summary_hash);
+	ptr = (uint8 *)(spdm_response->measurement_summary_hash);
 	measurement_summary_hash = ptr;
 	DEBUG((DEBUG_INFO, "measurement_summary_hash (0x%x) - ",
 	       measurement_summary_hash_size));
@@ -232,24 +255,26 @@ return_status try_spdm_send_receive_psk_exchange(
 	ptr += measurement_summary_hash_size;
 
 	DEBUG((DEBUG_INFO, "ServerRandomData (0x%x) - ",
-	       spdm_response.context_length));
-	internal_dump_data(ptr, spdm_response.context_length);
+	       spdm_response->context_length));
+	internal_dump_data(ptr, spdm_response->context_length);
 	DEBUG((DEBUG_INFO, "\n"));
 
-	ptr += spdm_response.context_length;
+	ptr += spdm_response->context_length;
 
-	ptr += spdm_response.opaque_length;
+	ptr += spdm_response->opaque_length;
 
 	//
 	// Cache session data
 	//
-	status = spdm_append_message_k(session_info, &spdm_request,
+	status = spdm_append_message_k(spdm_context, session_info, TRUE,
+				       spdm_request,
 				       spdm_request_size);
 	if (RETURN_ERROR(status)) {
 		return RETURN_SECURITY_VIOLATION;
 	}
 
-	status = spdm_append_message_k(session_info, &spdm_response,
+	status = spdm_append_message_k(spdm_context, session_info, TRUE,
+				       spdm_response,
 				       spdm_response_size - hmac_size);
 	if (RETURN_ERROR(status)) {
 		spdm_free_session_id(spdm_context, *session_id);
@@ -283,7 +308,8 @@ return_status try_spdm_send_receive_psk_exchange(
 		return RETURN_SECURITY_VIOLATION;
 	}
 
-	status = spdm_append_message_k(session_info, verify_data, hmac_size);
+	status = spdm_append_message_k(spdm_context, session_info, TRUE,
+				       verify_data, hmac_size);
 	if (RETURN_ERROR(status)) {
 		spdm_free_session_id(spdm_context, *session_id);
 		return RETURN_SECURITY_VIOLATION;
@@ -325,6 +351,56 @@ return_status try_spdm_send_receive_psk_exchange(
 	return RETURN_SUCCESS;
 }
 
+/**
+  This function sends PSK_EXCHANGE and receives PSK_EXCHANGE_RSP for SPDM PSK exchange.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  measurement_hash_type          measurement_hash_type to the PSK_EXCHANGE request.
+  @param  heartbeat_period              heartbeat_period from the PSK_EXCHANGE_RSP response.
+  @param  session_id                    session_id from the PSK_EXCHANGE_RSP response.
+  @param  measurement_hash              measurement_hash from the PSK_EXCHANGE_RSP response.
+
+  @retval RETURN_SUCCESS               The PSK_EXCHANGE is sent and the PSK_EXCHANGE_RSP is received.
+  @retval RETURN_DEVICE_ERROR          A device error occurs when communicates with the device.
+**/
+return_status try_spdm_send_receive_psk_exchange(
+	IN spdm_context_t *spdm_context, IN uint8 measurement_hash_type,
+	OUT uint32 *session_id, OUT uint8 *heartbeat_period,
+	OUT void *measurement_hash)
+{
+	return_status status;
+	spdm_psk_exchange_request_mine_t spdm_request;
+	uintn spdm_request_size;
+	spdm_psk_exchange_response_max_t spdm_response;
+	uintn spdm_response_size;
+
+	status = spdm_build_psk_exchange_request(spdm_context,
+						 measurement_hash_type,
+						 &spdm_request_size,
+						 &spdm_request);
+	if (RETURN_ERROR(status)) {
+		return status;
+	}
+
+	status = spdm_send_spdm_request(spdm_context, NULL, spdm_request_size,
+					&spdm_request);
+	if (RETURN_ERROR(status)) {
+		return RETURN_DEVICE_ERROR;
+	}
+
+	spdm_response_size = sizeof(spdm_response);
+	zero_mem(&spdm_response, sizeof(spdm_response));
+	status = spdm_receive_spdm_response(
+		spdm_context, NULL, &spdm_response_size, &spdm_response);
+	if (RETURN_ERROR(status)) {
+		return RETURN_DEVICE_ERROR;
+	}
+	return spdm_process_psk_exchange_rsp_response(
+		spdm_context, measurement_hash_type, spdm_request_size,
+		&spdm_request, spdm_response_size, &spdm_response, session_id,
+		heartbeat_period, measurement_hash);
+}
+
 return_status spdm_send_receive_psk_exchange(IN spdm_context_t *spdm_context,
 					     IN uint8 measurement_hash_type,
 					     OUT uint32 *session_id,
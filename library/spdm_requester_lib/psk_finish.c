@@ -21,27 +21,32 @@ typedef struct {
 #pragma pack()
 
 /**
-  This function sends PSK_FINISH and receives PSK_FINISH_RSP for SPDM PSK finish.
+  This function builds PSK_FINISH for SPDM PSK finish.
+
+  The request is appended to the session transcript.
 
   @param  spdm_context                  A pointer to the SPDM context.
   @param  session_id                    session_id to the PSK_FINISH request.
+  @param  spdm_request_size             On output, size in bytes of the PSK_FINISH request.
+  @param  request                      A pointer to a destination buffer to store the PSK_FINISH request.
 
-  @retval RETURN_SUCCESS               The PSK_FINISH is sent and the PSK_FINISH_RSP is received.
-  @retval RETURN_DEVICE_ERROR          A device error occurs when communicates with the device.
+  @retval RETURN_SUCCESS               The PSK_FINISH is built.
+  @retval RETURN_UNSUPPORTED           The capabilities or the session state do not allow PSK_FINISH.
+  @retval RETURN_SECURITY_VIOLATION    The transcript cannot be updated.
 **/
-return_status try_spdm_send_receive_psk_finish(IN spdm_context_t *spdm_context,
-					       IN uint32 session_id)
+return_status spdm_build_psk_finish_request(IN spdm_context_t *spdm_context,
+					    IN uint32 session_id,
+					    OUT uintn *spdm_request_size,
+					    OUT void *request)
 {
 	return_status status;
-	spdm_psk_finish_request_mine_t spdm_request;
-	uintn spdm_request_size;
+	spdm_psk_finish_request_mine_t *spdm_request;
 	uintn hmac_size;
-	spdm_psk_finish_response_max_t spdm_response;
-	uintn spdm_response_size;
 	spdm_session_info_t *session_info;
-	uint8 th2_hash_data[64];
 	spdm_session_state_t session_state;
 
+	spdm_request = request;
+
 	if (!spdm_is_capabilities_flag_supported(
 		    spdm_context, TRUE,
 		    SPDM_GET_CAPABILITIES_REQUEST_FLAGS_PSK_CAP,
@@ -69,59 +74,83 @@ return_status try_spdm_send_receive_psk_finish(IN spdm_context_t *spdm_context,
 
 	spdm_context->error_state = SPDM_STATUS_ERROR_DEVICE_NO_CAPABILITIES;
 
-	spdm_request.header.spdm_version = SPDM_MESSAGE_VERSION_11;
-	spdm_request.header.request_response_code = SPDM_PSK_FINISH;
-	spdm_request.header.param1 = 0;
-	spdm_request.header.param2 = 0;
+	spdm_request->header.spdm_version = SPDM_MESSAGE_VERSION_11;
+	spdm_request->header.request_response_code = SPDM_PSK_FINISH;
+	spdm_request->header.param1 = 0;
+	spdm_request->header.param2 = 0;
 
 	hmac_size = spdm_get_hash_size(
 		spdm_context->connection_info.algorithm.base_hash_algo);
-	spdm_request_size = sizeof(spdm_finish_request_t) + hmac_size;
+	*spdm_request_size = sizeof(spdm_finish_request_t) + hmac_size;
 
-	status = spdm_append_message_f(session_info, (uint8 *)&spdm_request,
-				       spdm_request_size - hmac_size);
+	status = spdm_append_message_f(session_info, (uint8 *)spdm_request,
+				       *spdm_request_size - hmac_size);
 	if (RETURN_ERROR(status)) {
 		return RETURN_SECURITY_VIOLATION;
 	}
 
 	spdm_generate_psk_exchange_req_hmac(spdm_context, session_info,
-					    spdm_request.verify_data);
+					    spdm_request->verify_data);
 
 	status = spdm_append_message_f(session_info,
-				       (uint8 *)&spdm_request +
-					       spdm_request_size - hmac_size,
+				       (uint8 *)spdm_request +
+					       *spdm_request_size - hmac_size,
 				       hmac_size);
 	if (RETURN_ERROR(status)) {
 		return RETURN_SECURITY_VIOLATION;
 	}
 
-	status = spdm_send_spdm_request(spdm_context, &session_id,
-					spdm_request_size, &spdm_request);
-	if (RETURN_ERROR(status)) {
-		return RETURN_DEVICE_ERROR;
-	}
+	return RETURN_SUCCESS;
+}
 
-	spdm_response_size = sizeof(spdm_response);
-	zero_mem(&spdm_response, sizeof(spdm_response));
-	status = spdm_receive_spdm_response(
-		spdm_context, &session_id, &spdm_response_size, &spdm_response);
-	if (RETURN_ERROR(status)) {
-		return RETURN_DEVICE_ERROR;
+/**
+  This function processes PSK_FINISH_RSP, the response to PSK_FINISH.
+
+  On success, the session data keys are generated and the session is established.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  session_id                    session_id to the PSK_FINISH request.
+  @param  spdm_request_size             size in bytes of the PSK_FINISH request.
+  @param  spdm_response_size            size in bytes of the response.
+  @param  response                     A pointer to the response.
+
+  @retval RETURN_SUCCESS               The PSK_FINISH_RSP is processed.
+  @retval RETURN_DEVICE_ERROR          The response is invalid.
+  @retval RETURN_SECURITY_VIOLATION    Any verification fails.
+  @retval RETURN_NO_RESPONSE           The responder is busy.
+**/
+return_status spdm_process_psk_finish_rsp_response(
+	IN spdm_context_t *spdm_context, IN uint32 session_id,
+	IN uintn spdm_request_size, IN uintn spdm_response_size,
+	IN void *response)
+{
+	return_status status;
+	spdm_psk_finish_response_max_t *spdm_response;
+	spdm_session_info_t *session_info;
+	uint8 th2_hash_data[64];
+
+	spdm_response = response;
+	session_info =
+		spdm_get_session_info_via_session_id(spdm_context, session_id);
+	if (session_info == NULL) {
+		ASSERT(FALSE);
+		return RETURN_UNSUPPORTED;
 	}
+
 	if (spdm_response_size < sizeof(spdm_message_header_t)) {
 		return RETURN_DEVICE_ERROR;
 	}
-	if (spdm_response.header.request_response_code == SPDM_ERROR) {
+	if (spdm_response->header.request_response_code == SPDM_ERROR) {
 		status = spdm_handle_error_response_main(
 			spdm_context, &session_id,
 			&session_info->session_transcript.message_f,
-			spdm_request_size, &spdm_response_size, &spdm_response,
+			spdm_request_size, &spdm_response_size, spdm_response,
 			SPDM_PSK_FINISH, SPDM_PSK_FINISH_RSP,
 			sizeof(spdm_psk_finish_response_max_t));
 		if (RETURN_ERROR(status)) {
 			return status;
 		}
-	} else if (spdm_response.header.request_response_code !=
+	} else if (spdm_response->header.request_response_code !=
 		   SPDM_PSK_FINISH_RSP) {
 		return RETURN_DEVICE_ERROR;
 	}
@@ -129,7 +158,7 @@ return_status try_spdm_send_receive_psk_finish(IN spdm_context_t *spdm_context,
 		return RETURN_DEVICE_ERROR;
 	}
 
-	status = spdm_append_message_f(session_info, &spdm_response,
+	status = spdm_append_message_f(session_info, spdm_response,
 				       spdm_response_size);
 	if (RETURN_ERROR(status)) {
 		return RETURN_SECURITY_VIOLATION;
@@ -155,6 +184,50 @@ return_status try_spdm_send_receive_psk_finish(IN spdm_context_t *spdm_context,
 	return RETURN_SUCCESS;
 }
 
+/**
+  This function sends PSK_FINISH and receives PSK_FINISH_RSP for SPDM PSK finish.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  session_id                    session_id to the PSK_FINISH request.
+
+  @retval RETURN_SUCCESS               The PSK_FINISH is sent and the PSK_FINISH_RSP is received.
+  @retval RETURN_DEVICE_ERROR          A device error occurs when communicates with the device.
+**/
+return_status try_spdm_send_receive_psk_finish(IN spdm_context_t *spdm_context,
+					       IN uint32 session_id)
+{
+	return_status status;
+	spdm_psk_finish_request_mine_t spdm_request;
+	uintn spdm_request_size;
+	spdm_psk_finish_response_max_t spdm_response;
+	uintn spdm_response_size;
+
+	status = spdm_build_psk_finish_request(spdm_context, session_id,
+					       &spdm_request_size,
+					       &spdm_request);
+	if (RETURN_ERROR(status)) {
+		return status;
+	}
+
+	status = spdm_send_spdm_request(spdm_context, &session_id,
+					spdm_request_size, &spdm_request);
+	if (RETURN_ERROR(status)) {
+		return RETURN_DEVICE_ERROR;
+	}
+
+	spdm_response_size = sizeof(spdm_response);
+	zero_mem(&spdm_response, sizeof(spdm_response));
+	status = spdm_receive_spdm_response(
+		spdm_context, &session_id, &spdm_response_size, &spdm_response);
+	if (RETURN_ERROR(status)) {
+		return RETURN_DEVICE_ERROR;
+	}
+	return spdm_process_psk_finish_rsp_response(spdm_context, session_id,
+						    spdm_request_size,
+						    spdm_response_size,
+						    &spdm_response);
+}
+
 return_status spdm_send_receive_psk_finish(IN spdm_context_t *spdm_context,
 					   IN uint32 session_id)
 {
@@ -6,8 +6,25 @@
 
 #include "spdm_requester_lib_internal.h"
 
+#if OPENSPDM_REQUESTER_STATISTICS_SUPPORT == 1
 /**
-  Send an SPDM or an APP request to a device.
+  Return the statistics of the last sent request.
+
+  @param  spdm_context                  The SPDM context for the device.
+
+  @return The statistics of the last sent request.
+**/
+static spdm_requester_request_statistics_t *
+internal_spdm_get_request_statistics(IN spdm_context_t *spdm_context)
+{
+	return &spdm_context->requester_statistics.request
+			[spdm_get_statistics_request_code_index(
+				spdm_context->statistics_request_code)];
+}
+#endif
+
+/**
+  Encode an SPDM or an APP request to a transport layer message.
 
   @param  spdm_context                  The SPDM context for the device.
   @param  session_id                    Indicate if the request is a secured message.
@@ -15,95 +32,126 @@
                                        If session_id is NOT NULL, it is a secured message.
   @param  is_app_message                 Indicates if it is an APP message or SPDM message.
   @param  request_size                  size in bytes of the request data buffer.
-  @param  request                      A pointer to a destination buffer to store the request.
-                                       The caller is responsible for having
-                                       either implicit or explicit ownership of the buffer.
+  @param  request                      A pointer to a source buffer to store the request.
+  @param  transport_message_size         size in bytes of the transport message data buffer.
+                                       On output, the size in bytes of the encoded transport message.
+  @param  transport_message             A pointer to a destination buffer to store the transport message.
 
-  @retval RETURN_SUCCESS               The SPDM request is sent successfully.
-  @retval RETURN_DEVICE_ERROR          A device error occurs when the SPDM request is sent to the device.
+  @retval RETURN_SUCCESS               The SPDM request is encoded successfully.
 **/
-return_status spdm_send_request(IN void *context, IN uint32 *session_id,
-				IN boolean is_app_message,
-				IN uintn request_size, IN void *request)
+static return_status
+internal_spdm_encode_request(IN spdm_context_t *spdm_context,
+			     IN uint32 *session_id, IN boolean is_app_message,
+			     IN uintn request_size, IN void *request,
+			     IN OUT uintn *transport_message_size,
+			     OUT void *transport_message)
 {
-	spdm_context_t *spdm_context;
 	return_status status;
-	uint8 message[MAX_SPDM_MESSAGE_BUFFER_SIZE];
-	uintn message_size;
-
-	spdm_context = context;
+#if OPENSPDM_REQUESTER_STATISTICS_SUPPORT == 1
+	spdm_message_header_t *spdm_request;
+	uint64 start_time;
+#endif
 
 	DEBUG((DEBUG_INFO, "spdm_send_spdm_request[%x] (0x%x): \n",
 	       (session_id != NULL) ? *session_id : 0x0, request_size));
-	internal_dump_hex(request, request_size);
+	spdm_trace_message(spdm_context, SPDM_TRACE_EVENT_REQUEST_SENT,
+			   session_id, is_app_message, request, request_size);
 
-	message_size = sizeof(message);
+#if OPENSPDM_REQUESTER_STATISTICS_SUPPORT == 1
+	if (!is_app_message && (request_size >= sizeof(spdm_message_header_t))) {
+		spdm_request = request;
+		if (spdm_request->request_response_code ==
+		    SPDM_RESPOND_IF_READY) {
+			spdm_context->statistics_request_code =
+				spdm_request->param1;
+		} else {
+			spdm_context->statistics_request_code =
+				spdm_request->request_response_code;
+		}
+		internal_spdm_get_request_statistics(spdm_context)
+			->request_count++;
+	}
+	start_time = spdm_statistics_get_timestamp(spdm_context);
+#endif
 	status = spdm_context->transport_encode_message(
 		spdm_context, session_id, is_app_message, TRUE, request_size,
-		request, &message_size, message);
+		request, transport_message_size, transport_message);
+#if OPENSPDM_REQUESTER_STATISTICS_SUPPORT == 1
+	if (!is_app_message) {
+		spdm_statistics_record_elapsed_time(
+			spdm_context,
+			&internal_spdm_get_request_statistics(spdm_context)
+				 ->encode_time,
+			start_time);
+	}
+#endif
 	if (RETURN_ERROR(status)) {
 		DEBUG((DEBUG_INFO, "transport_encode_message status - %p\n",
 		       status));
-		return status;
 	}
-
-	status = spdm_context->send_message(spdm_context, message_size, message,
-					    0);
-	if (RETURN_ERROR(status)) {
-		DEBUG((DEBUG_INFO, "spdm_send_spdm_request[%x] status - %p\n",
-		       (session_id != NULL) ? *session_id : 0x0, status));
-	}
-
 	return status;
 }
 
 /**
-  Receive an SPDM or an APP response from a device.
+  Decode an SPDM or an APP response from a transport layer message.
 
   @param  spdm_context                  The SPDM context for the device.
   @param  session_id                    Indicate if the response is a secured message.
                                        If session_id is NULL, it is a normal message.
                                        If session_id is NOT NULL, it is a secured message.
   @param  is_app_message                 Indicates if it is an APP message or SPDM message.
+  @param  transport_message_size         size in bytes of the transport message data buffer.
+  @param  transport_message             A pointer to a source buffer to store the transport message.
   @param  response_size                 size in bytes of the response data buffer.
   @param  response                     A pointer to a destination buffer to store the response.
-                                       The caller is responsible for having
-                                       either implicit or explicit ownership of the buffer.
 
-  @retval RETURN_SUCCESS               The SPDM response is received successfully.
-  @retval RETURN_DEVICE_ERROR          A device error occurs when the SPDM response is received from the device.
+  @retval RETURN_SUCCESS               The SPDM response is decoded successfully.
+  @retval RETURN_DEVICE_ERROR          The session or the message type does not match the expected response.
 **/
-return_status spdm_receive_response(IN void *context, IN uint32 *session_id,
-				    IN boolean is_app_message,
-				    IN OUT uintn *response_size,
-				    OUT void *response)
+static return_status
+internal_spdm_decode_response(IN spdm_context_t *spdm_context,
+			      IN uint32 *session_id, IN boolean is_app_message,
+			      IN uintn transport_message_size,
+			      IN OUT void *transport_message,
+			      IN OUT uintn *response_size, OUT void *response)
 {
-	spdm_context_t *spdm_context;
 	return_status status;
-	uint8 message[MAX_SPDM_MESSAGE_BUFFER_SIZE];
-	uintn message_size;
 	uint32 *message_session_id;
 	boolean is_message_app_message;
+#if OPENSPDM_REQUESTER_STATISTICS_SUPPORT == 1
+	spdm_requester_request_statistics_t *request_statistics;
+	spdm_message_header_t *spdm_response;
+	uint64 start_time;
 
-	spdm_context = context;
-
-	ASSERT(*response_size <= MAX_SPDM_MESSAGE_BUFFER_SIZE);
-
-	message_size = sizeof(message);
-	status = spdm_context->receive_message(spdm_context, &message_size,
-					       message, 0);
-	if (RETURN_ERROR(status)) {
-		DEBUG((DEBUG_INFO,
-		       "spdm_receive_spdm_response[%x] status - %p\n",
-		       (session_id != NULL) ? *session_id : 0x0, status));
-		return status;
-	}
+	start_time = spdm_statistics_get_timestamp(spdm_context);
+#endif
 
 	message_session_id = NULL;
 	is_message_app_message = FALSE;
 	status = spdm_context->transport_decode_message(
 		spdm_context, &message_session_id, &is_message_app_message,
-		FALSE, message_size, message, response_size, response);
+		FALSE, transport_message_size, transport_message,
+		response_size, response);
+#if OPENSPDM_REQUESTER_STATISTICS_SUPPORT == 1
+	if (!is_app_message) {
+		request_statistics =
+			internal_spdm_get_request_statistics(spdm_context);
+		spdm_statistics_record_elapsed_time(
+			spdm_context, &request_statistics->decode_time,
+			start_time);
+		spdm_response = response;
+		if (!RETURN_ERROR(status) && !is_message_app_message &&
+		    (*response_size >= sizeof(spdm_message_header_t)) &&
+		    (spdm_response->request_response_code == SPDM_ERROR)) {
+			if (spdm_response->param1 == SPDM_ERROR_CODE_BUSY) {
+				request_statistics->busy_count++;
+			} else if (spdm_response->param1 ==
+				   SPDM_ERROR_CODE_RESPONSE_NOT_READY) {
+				request_statistics->not_ready_count++;
+			}
+		}
+	}
+#endif
 
 	if (session_id != NULL) {
 		if (message_session_id == NULL) {
@@ -144,18 +192,21 @@ return_status spdm_receive_response(IN void *context, IN uint32 *session_id,
 		       "spdm_receive_spdm_response[%x] status - %p\n",
 		       (session_id != NULL) ? *session_id : 0x0, status));
 	} else {
-		internal_dump_hex(response, *response_size);
+		spdm_trace_message(spdm_context,
+				   SPDM_TRACE_EVENT_RESPONSE_RECEIVED, session_id,
+				   is_app_message, response, *response_size);
 	}
 	return status;
 }
 
 /**
-  Send an SPDM request to a device.
+  Send an SPDM or an APP request to a device.
 
   @param  spdm_context                  The SPDM context for the device.
   @param  session_id                    Indicate if the request is a secured message.
                                        If session_id is NULL, it is a normal message.
                                        If session_id is NOT NULL, it is a secured message.
+  @param  is_app_message                 Indicates if it is an APP message or SPDM message.
   @param  request_size                  size in bytes of the request data buffer.
   @param  request                      A pointer to a destination buffer to store the request.
                                        The caller is responsible for having
@@ -163,21 +214,147 @@ return_status spdm_receive_response(IN void *context, IN uint32 *session_id,
 
   @retval RETURN_SUCCESS               The SPDM request is sent successfully.
   @retval RETURN_DEVICE_ERROR          A device error occurs when the SPDM request is sent to the device.
+  @retval RETURN_OUT_OF_RESOURCES      No arena is registered while OPENSPDM_ARENA_MANAGED_BUFFER_SUPPORT is 1.
 **/
-return_status spdm_send_spdm_request(IN spdm_context_t *spdm_context,
-				     IN uint32 *session_id,
-				     IN uintn request_size, IN void *request)
+return_status spdm_send_request(IN void *context, IN uint32 *session_id,
+				IN boolean is_app_message,
+				IN uintn request_size, IN void *request)
+{
+	spdm_context_t *spdm_context;
+	return_status status;
+	uint8 message[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+	uintn message_size;
+#if OPENSPDM_REQUESTER_STATISTICS_SUPPORT == 1
+	uint64 start_time;
+#endif
+
+	spdm_context = context;
+
+#if OPENSPDM_ARENA_MANAGED_BUFFER_SUPPORT == 1
+	if (spdm_context->arena.allocate_func == NULL) {
+		DEBUG((DEBUG_ERROR,
+		       "spdm_send_request - no arena registered by spdm_register_arena_func\n"));
+		return RETURN_OUT_OF_RESOURCES;
+	}
+#endif
+
+	message_size = sizeof(message);
+	status = internal_spdm_encode_request(spdm_context, session_id,
+					      is_app_message, request_size,
+					      request, &message_size, message);
+	if (RETURN_ERROR(status)) {
+		return status;
+	}
+
+#if OPENSPDM_REQUESTER_STATISTICS_SUPPORT == 1
+	start_time = spdm_statistics_get_timestamp(spdm_context);
+#endif
+	status = spdm_context->send_message(spdm_context, message_size, message,
+					    0);
+#if OPENSPDM_REQUESTER_STATISTICS_SUPPORT == 1
+	if (!is_app_message) {
+		spdm_statistics_record_elapsed_time(
+			spdm_context,
+			&internal_spdm_get_request_statistics(spdm_context)
+				 ->send_time,
+			start_time);
+	}
+#endif
+	if (RETURN_ERROR(status)) {
+		DEBUG((DEBUG_INFO, "spdm_send_spdm_request[%x] status - %p\n",
+		       (session_id != NULL) ? *session_id : 0x0, status));
+	}
+
+	return status;
+}
+
+/**
+  Receive an SPDM or an APP response from a device.
+
+  @param  spdm_context                  The SPDM context for the device.
+  @param  session_id                    Indicate if the response is a secured message.
+                                       If session_id is NULL, it is a normal message.
+                                       If session_id is NOT NULL, it is a secured message.
+  @param  is_app_message                 Indicates if it is an APP message or SPDM message.
+  @param  response_size                 size in bytes of the response data buffer.
+  @param  response                     A pointer to a destination buffer to store the response.
+                                       The caller is responsible for having
+                                       either implicit or explicit ownership of the buffer.
+
+  @retval RETURN_SUCCESS               The SPDM response is received successfully.
+  @retval RETURN_DEVICE_ERROR          A device error occurs when the SPDM response is received from the device.
+**/
+return_status spdm_receive_response(IN void *context, IN uint32 *session_id,
+				    IN boolean is_app_message,
+				    IN OUT uintn *response_size,
+				    OUT void *response)
+{
+	spdm_context_t *spdm_context;
+	return_status status;
+	uint8 message[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+	uintn message_size;
+#if OPENSPDM_REQUESTER_STATISTICS_SUPPORT == 1
+	uint64 start_time;
+#endif
+
+	spdm_context = context;
+
+	ASSERT(*response_size <= MAX_SPDM_MESSAGE_BUFFER_SIZE);
+
+	message_size = sizeof(message);
+#if OPENSPDM_REQUESTER_STATISTICS_SUPPORT == 1
+	start_time = spdm_statistics_get_timestamp(spdm_context);
+#endif
+	status = spdm_context->receive_message(spdm_context, &message_size,
+					       message, 0);
+#if OPENSPDM_REQUESTER_STATISTICS_SUPPORT == 1
+	if (!is_app_message) {
+		spdm_statistics_record_elapsed_time(
+			spdm_context,
+			&internal_spdm_get_request_statistics(spdm_context)
+				 ->receive_time,
+			start_time);
+	}
+#endif
+	if (RETURN_ERROR(status)) {
+		DEBUG((DEBUG_INFO,
+		       "spdm_receive_spdm_response[%x] status - %p\n",
+		       (session_id != NULL) ? *session_id : 0x0, status));
+		return status;
+	}
+
+	return internal_spdm_decode_response(spdm_context, session_id,
+					     is_app_message, message_size,
+					     message, response_size, response);
+}
+
+/**
+  Return the session ID used to carry an SPDM message of a session.
+
+  In HANDSHAKE_IN_THE_CLEAR mode, the handshake messages of a KEY_EXCHANGE session
+  are sent and received in the clear.
+
+  @param  spdm_context                  The SPDM context for the device.
+  @param  session_id                    On input, the session ID of the SPDM message, or NULL.
+                                       On output, the session ID of the transport message, or NULL.
+
+  @retval RETURN_SUCCESS               The session ID is returned.
+  @retval RETURN_DEVICE_ERROR          The session is not found.
+**/
+static return_status
+internal_spdm_get_message_session_id(IN spdm_context_t *spdm_context,
+				     IN OUT uint32 **session_id)
 {
 	spdm_session_info_t *session_info;
 	spdm_session_state_t session_state;
 
-	if ((session_id != NULL) &&
+	if ((*session_id != NULL) &&
 	    spdm_is_capabilities_flag_supported(
 		    spdm_context, TRUE,
 		    SPDM_GET_CAPABILITIES_REQUEST_FLAGS_HANDSHAKE_IN_THE_CLEAR_CAP,
 		    SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_HANDSHAKE_IN_THE_CLEAR_CAP)) {
 		session_info = spdm_get_session_info_via_session_id(
-			spdm_context, *session_id);
+			spdm_context, **session_id);
 		ASSERT(session_info != NULL);
 		if (session_info == NULL) {
 			return RETURN_DEVICE_ERROR;
@@ -186,9 +363,38 @@ return_status spdm_send_spdm_request(IN spdm_context_t *spdm_context,
 			session_info->secured_message_context);
 		if ((session_state == SPDM_SESSION_STATE_HANDSHAKING) &&
 		    !session_info->use_psk) {
-			session_id = NULL;
+			*session_id = NULL;
 		}
 	}
+	return RETURN_SUCCESS;
+}
+
+/**
+  Send an SPDM request to a device.
+
+  @param  spdm_context                  The SPDM context for the device.
+  @param  session_id                    Indicate if the request is a secured message.
+                                       If session_id is NULL, it is a normal message.
+                                       If session_id is NOT NULL, it is a secured message.
+  @param  request_size                  size in bytes of the request data buffer.
+  @param  request                      A pointer to a destination buffer to store the request.
+                                       The caller is responsible for having
+                                       either implicit or explicit ownership of the buffer.
+
+  @retval RETURN_SUCCESS               The SPDM request is sent successfully.
+  @retval RETURN_DEVICE_ERROR          A device error occurs when the SPDM request is sent to the device.
+**/
+return_status spdm_send_spdm_request(IN spdm_context_t *spdm_context,
+				     IN uint32 *session_id,
+				     IN uintn request_size, IN void *request)
+{
+	return_status status;
+
+	status = internal_spdm_get_message_session_id(spdm_context,
+						      &session_id);
+	if (RETURN_ERROR(status)) {
+		return status;
+	}
 
 	return spdm_send_request(spdm_context, session_id, FALSE, request_size,
 				 request);
@@ -214,28 +420,86 @@ return_status spdm_receive_spdm_response(IN spdm_context_t *spdm_context,
 					 IN OUT uintn *response_size,
 					 OUT void *response)
 {
-	spdm_session_info_t *session_info;
-	spdm_session_state_t session_state;
+	return_status status;
 
-	if ((session_id != NULL) &&
-	    spdm_is_capabilities_flag_supported(
-		    spdm_context, TRUE,
-		    SPDM_GET_CAPABILITIES_REQUEST_FLAGS_HANDSHAKE_IN_THE_CLEAR_CAP,
-		    SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_HANDSHAKE_IN_THE_CLEAR_CAP)) {
-		session_info = spdm_get_session_info_via_session_id(
-			spdm_context, *session_id);
-		ASSERT(session_info != NULL);
-		if (session_info == NULL) {
-			return RETURN_DEVICE_ERROR;
-		}
-		session_state = spdm_secured_message_get_session_state(
-			session_info->secured_message_context);
-		if ((session_state == SPDM_SESSION_STATE_HANDSHAKING) &&
-		    !session_info->use_psk) {
-			session_id = NULL;
-		}
+	status = internal_spdm_get_message_session_id(spdm_context,
+						      &session_id);
+	if (RETURN_ERROR(status)) {
+		return status;
 	}
 
 	return spdm_receive_response(spdm_context, session_id, FALSE,
 				     response_size, response);
+}
+
+/**
+  Encode an SPDM request to a transport layer message, without sending it.
+
+  @param  spdm_context                  The SPDM context for the device.
+  @param  session_id                    Indicate if the request is a secured message.
+                                       If session_id is NULL, it is a normal message.
+                                       If session_id is NOT NULL, it is a secured message.
+  @param  request_size                  size in bytes of the request data buffer.
+  @param  request                      A pointer to a source buffer to store the request.
+  @param  transport_message_size         size in bytes of the transport message data buffer.
+                                       On output, the size in bytes of the encoded transport message.
+  @param  transport_message             A pointer to a destination buffer to store the transport message.
+
+  @retval RETURN_SUCCESS               The SPDM request is encoded successfully.
+  @retval RETURN_DEVICE_ERROR          The session is not found.
+**/
+return_status spdm_encode_spdm_request(IN spdm_context_t *spdm_context,
+				       IN uint32 *session_id,
+				       IN uintn request_size, IN void *request,
+				       IN OUT uintn *transport_message_size,
+				       OUT void *transport_message)
+{
+	return_status status;
+
+	status = internal_spdm_get_message_session_id(spdm_context,
+						      &session_id);
+	if (RETURN_ERROR(status)) {
+		return status;
+	}
+
+	return internal_spdm_encode_request(spdm_context, session_id, FALSE,
+					    request_size, request,
+					    transport_message_size,
+					    transport_message);
+}
+
+/**
+  Decode an SPDM response from a received transport layer message.
+
+  @param  spdm_context                  The SPDM context for the device.
+  @param  session_id                    Indicate if the response is a secured message.
+                                       If session_id is NULL, it is a normal message.
+                                       If session_id is NOT NULL, it is a secured message.
+  @param  transport_message_size         size in bytes of the transport message data buffer.
+  @param  transport_message             A pointer to a source buffer to store the transport message.
+  @param  response_size                 size in bytes of the response data buffer.
+  @param  response                     A pointer to a destination buffer to store the response.
+
+  @retval RETURN_SUCCESS               The SPDM response is decoded successfully.
+  @retval RETURN_DEVICE_ERROR          The session or the message type does not match the expected response.
+**/
+return_status spdm_decode_spdm_response(IN spdm_context_t *spdm_context,
+					IN uint32 *session_id,
+					IN uintn transport_message_size,
+					IN OUT void *transport_message,
+					IN OUT uintn *response_size,
+					OUT void *response)
+{
+	return_status status;
+
+	status = internal_spdm_get_message_session_id(spdm_context,
+						      &session_id);
+	if (RETURN_ERROR(status)) {
+		return status;
+	}
+
+	return internal_spdm_decode_response(spdm_context, session_id, FALSE,
+					     transport_message_size,
+					     transport_message, response_size,
+					     response);
 }
\ No newline at end of file
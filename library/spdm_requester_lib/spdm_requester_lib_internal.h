@@ -316,4 +316,575 @@ return_status spdm_receive_spdm_response(IN spdm_context_t *spdm_context,
 					 IN OUT uintn *response_size,
 					 OUT void *response);
 
+/**
+  Encode an SPDM request to a transport layer message, without sending it.
+
+  @param  spdm_context                  The SPDM context for the device.
+  @param  session_id                    Indicate if the request is a secured message.
+                                       If session_id is NULL, it is a normal message.
+                                       If session_id is NOT NULL, it is a secured message.
+  @param  request_size                  size in bytes of the request data buffer.
+  @param  request                      A pointer to a source buffer to store the request.
+  @param  transport_message_size         size in bytes of the transport message data buffer.
+                                       On output, the size in bytes of the encoded transport message.
+  @param  transport_message             A pointer to a destination buffer to store the transport message.
+
+  @retval RETURN_SUCCESS               The SPDM request is encoded successfully.
+  @retval RETURN_DEVICE_ERROR          The session is not found.
+**/
+return_status spdm_encode_spdm_request(IN spdm_context_t *spdm_context,
+				       IN uint32 *session_id,
+				       IN uintn request_size, IN void *request,
+				       IN OUT uintn *transport_message_size,
+				       OUT void *transport_message);
+
+/**
+  Decode an SPDM response from a received transport layer message.
+
+  @param  spdm_context                  The SPDM context for the device.
+  @param  session_id                    Indicate if the response is a secured message.
+                                       If session_id is NULL, it is a normal message.
+                                       If session_id is NOT NULL, it is a secured message.
+  @param  transport_message_size         size in bytes of the transport message data buffer.
+  @param  transport_message             A pointer to a source buffer to store the transport message.
+  @param  response_size                 size in bytes of the response data buffer.
+  @param  response                     A pointer to a destination buffer to store the response.
+
+  @retval RETURN_SUCCESS               The SPDM response is decoded successfully.
+  @retval RETURN_DEVICE_ERROR          The session or the message type does not match the expected response.
+**/
+return_status spdm_decode_spdm_response(IN spdm_context_t *spdm_context,
+					IN uint32 *session_id,
+					IN uintn transport_message_size,
+					IN OUT void *transport_message,
+					IN OUT uintn *response_size,
+					OUT void *response);
+
+/**
+  This function builds GET_VERSION.
+
+  The SPDM context is reset, because GET_VERSION starts a new connection.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  request                      A pointer to a destination buffer to store the GET_VERSION request.
+
+  @retval RETURN_SUCCESS               The GET_VERSION is built.
+**/
+return_status spdm_build_get_version_request(IN spdm_context_t *spdm_context,
+					     OUT void *request);
+
+/**
+  This function processes VERSION, the response to GET_VERSION.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  request                      A pointer to the GET_VERSION request.
+  @param  spdm_response_size            size in bytes of the response.
+  @param  response                     A pointer to the response.
+
+  @retval RETURN_SUCCESS               The VERSION is processed.
+  @retval RETURN_DEVICE_ERROR          The response is invalid.
+  @retval RETURN_NO_RESPONSE           The responder is busy.
+**/
+return_status spdm_process_version_response(IN spdm_context_t *spdm_context,
+					    IN void *request,
+					    IN uintn spdm_response_size,
+					    IN void *response);
+
+/**
+  This function builds GET_CAPABILITIES.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  spdm_request_size             On output, the size in bytes of the GET_CAPABILITIES request.
+  @param  request                      A pointer to a destination buffer to store the GET_CAPABILITIES request.
+
+  @retval RETURN_SUCCESS               The GET_CAPABILITIES is built.
+  @retval RETURN_UNSUPPORTED           The connection state does not allow GET_CAPABILITIES.
+**/
+return_status spdm_build_get_capabilities_request(
+	IN spdm_context_t *spdm_context, OUT uintn *spdm_request_size,
+	OUT void *request);
+
+/**
+  This function processes CAPABILITIES, the response to GET_CAPABILITIES.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  spdm_request_size             size in bytes of the GET_CAPABILITIES request.
+  @param  request                      A pointer to the GET_CAPABILITIES request.
+  @param  spdm_response_size            size in bytes of the response.
+  @param  response                     A pointer to the response.
+
+  @retval RETURN_SUCCESS               The CAPABILITIES is processed.
+  @retval RETURN_DEVICE_ERROR          The response is invalid.
+  @retval RETURN_NO_RESPONSE           The responder is busy.
+**/
+return_status spdm_process_capabilities_response(
+	IN spdm_context_t *spdm_context, IN uintn spdm_request_size,
+	IN void *request, IN uintn spdm_response_size, IN void *response);
+
+/**
+  This function builds NEGOTIATE_ALGORITHMS.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  request                      A pointer to a destination buffer to store the NEGOTIATE_ALGORITHMS request.
+                                       The size in bytes of the request is in its length field.
+
+  @retval RETURN_SUCCESS               The NEGOTIATE_ALGORITHMS is built.
+  @retval RETURN_UNSUPPORTED           The connection state does not allow NEGOTIATE_ALGORITHMS.
+**/
+return_status
+spdm_build_negotiate_algorithms_request(IN spdm_context_t *spdm_context,
+					OUT void *request);
+
+/**
+  This function processes ALGORITHMS, the response to NEGOTIATE_ALGORITHMS.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  request                      A pointer to the NEGOTIATE_ALGORITHMS request.
+  @param  spdm_response_size            size in bytes of the response.
+  @param  response                     A pointer to the response.
+
+  @retval RETURN_SUCCESS               The ALGORITHMS is processed.
+  @retval RETURN_DEVICE_ERROR          The response is invalid.
+  @retval RETURN_SECURITY_VIOLATION    The negotiated algorithms are not acceptable.
+  @retval RETURN_NO_RESPONSE           The responder is busy.
+**/
+return_status spdm_process_algorithms_response(IN spdm_context_t *spdm_context,
+					       IN void *request,
+					       IN uintn spdm_response_size,
+					       IN void *response);
+
+/**
+  This function builds GET_DIGEST.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  request                      A pointer to a destination buffer to store the GET_DIGEST request.
+
+  @retval RETURN_SUCCESS               The GET_DIGEST is built.
+  @retval RETURN_UNSUPPORTED           The capabilities or the connection state do not allow GET_DIGEST.
+**/
+return_status spdm_build_get_digest_request(IN spdm_context_t *spdm_context,
+					    OUT void *request);
+
+/**
+  This function processes DIGESTS, the response to GET_DIGEST.
+
+  If the peer certificate chain is deployed,
+  this function also verifies the digest with the certificate chain.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  request                      A pointer to the GET_DIGEST request.
+  @param  spdm_response_size            size in bytes of the response.
+  @param  response                     A pointer to the response.
+  @param  slot_mask                     The slots which deploy the CertificateChain.
+  @param  total_digest_buffer            A pointer to a destination buffer to store the digest buffer.
+
+  @retval RETURN_SUCCESS               The DIGESTS is processed.
+  @retval RETURN_DEVICE_ERROR          The response is invalid.
+  @retval RETURN_SECURITY_VIOLATION    Any verification fails.
+  @retval RETURN_NO_RESPONSE           The responder is busy.
+**/
+return_status spdm_process_digests_response(IN spdm_context_t *spdm_context,
+					    IN void *request,
+					    IN uintn spdm_response_size,
+					    IN void *response,
+					    OUT uint8 *slot_mask,
+					    OUT void *total_digest_buffer);
+
+/**
+  This function checks that the certificate chain in one slot can be got from device,
+  before the first GET_CERTIFICATE is built.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  slot_id                      The number of slot for the certificate chain.
+
+  @retval RETURN_SUCCESS               GET_CERTIFICATE can be sent.
+  @retval RETURN_UNSUPPORTED           The capabilities or the connection state do not allow GET_CERTIFICATE.
+  @retval RETURN_INVALID_PARAMETER     The slot_id is invalid.
+**/
+return_status spdm_start_get_certificate(IN spdm_context_t *spdm_context,
+					 IN uint8 slot_id);
+
+/**
+  This function builds GET_CERTIFICATE for the next portion of the certificate chain.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  slot_id                      The number of slot for the certificate chain.
+  @param  offset                       The offset of the portion in the certificate chain.
+  @param  length                       length parameter in the get_certificate message (limited by MAX_SPDM_CERT_CHAIN_BLOCK_LEN).
+  @param  request                      A pointer to a destination buffer to store the GET_CERTIFICATE request.
+**/
+void spdm_build_get_certificate_request(IN spdm_context_t *spdm_context,
+					IN uint8 slot_id, IN uint16 offset,
+					IN uint16 length, OUT void *request);
+
+/**
+  This function processes CERTIFICATE, the response to GET_CERTIFICATE,
+  and appends the portion of the certificate chain.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  slot_id                      The number of slot for the certificate chain.
+  @param  request                      A pointer to the GET_CERTIFICATE request.
+  @param  spdm_response_size            size in bytes of the response.
+  @param  response                     A pointer to the response.
+  @param  certificate_chain_buffer       The managed buffer to append the portion to.
+  @param  remainder_length              On output, the remainder length of the certificate chain.
+
+  @retval RETURN_SUCCESS               The CERTIFICATE is processed.
+  @retval RETURN_DEVICE_ERROR          The response is invalid.
+  @retval RETURN_SECURITY_VIOLATION    The certificate chain is too large.
+  @retval RETURN_NO_RESPONSE           The responder is busy.
+**/
+return_status spdm_process_certificate_response(
+	IN spdm_context_t *spdm_context, IN uint8 slot_id, IN void *request,
+	IN uintn spdm_response_size, IN void *response,
+	IN OUT void *certificate_chain_buffer, OUT uint16 *remainder_length);
+
+/**
+  This function verifies the certificate chain got by GET_CERTIFICATE,
+  and records it as the peer used certificate chain.
+
+  This function verify the integrity of the certificate chain.
+  root_hash -> Root certificate -> Intermediate certificate -> Leaf certificate.
+
+  If the peer root certificate hash is deployed,
+  this function also verifies the digest with the root hash in the certificate chain.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  certificate_chain_buffer       The managed buffer holding the certificate chain.
+  @param  cert_chain_size                On input, indicate the size in bytes of the destination buffer to store the digest buffer.
+                                       On output, indicate the size in bytes of the certificate chain.
+  @param  cert_chain                    A pointer to a destination buffer to store the certificate chain.
+
+  @retval RETURN_SUCCESS               The certificate chain is verified.
+  @retval RETURN_SECURITY_VIOLATION    Any verification fails.
+  @retval RETURN_BUFFER_TOO_SMALL      The cert_chain is too small.
+**/
+return_status spdm_finish_get_certificate(IN spdm_context_t *spdm_context,
+					  IN void *certificate_chain_buffer,
+					  IN OUT uintn *cert_chain_size,
+					  OUT void *cert_chain);
+
+/**
+  This function builds CHALLENGE
+  to authenticate the device based upon the key in one slot.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  slot_id                      The number of slot for the challenge.
+  @param  measurement_hash_type          The type of the measurement hash.
+  @param  request                      A pointer to a destination buffer to store the CHALLENGE request.
+
+  @retval RETURN_SUCCESS               The CHALLENGE is built.
+  @retval RETURN_UNSUPPORTED           The capabilities or the connection state do not allow CHALLENGE.
+  @retval RETURN_INVALID_PARAMETER     The slot_id is invalid.
+**/
+return_status spdm_build_challenge_request(IN spdm_context_t *spdm_context,
+					   IN uint8 slot_id,
+					   IN uint8 measurement_hash_type,
+					   OUT void *request);
+
+/**
+  This function processes CHALLENGE_AUTH, the response to CHALLENGE.
+
+  This function verifies the signature in the challenge auth.
+  The connection state is not changed, because basic mutual authentication
+  may still be requested.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  slot_id                      The number of slot for the challenge.
+  @param  measurement_hash_type          The type of the measurement hash.
+  @param  request                      A pointer to the CHALLENGE request.
+  @param  spdm_response_size            size in bytes of the response.
+  @param  response                     A pointer to the response.
+  @param  measurement_hash              A pointer to a destination buffer to store the measurement hash.
+  @param  basic_mut_auth_req            On output, indicates if basic mutual authentication is requested.
+
+  @retval RETURN_SUCCESS               The CHALLENGE_AUTH is processed.
+  @retval RETURN_DEVICE_ERROR          The response is invalid.
+  @retval RETURN_SECURITY_VIOLATION    Any verification fails.
+  @retval RETURN_NO_RESPONSE           The responder is busy.
+**/
+return_status spdm_process_challenge_auth_response(
+	IN spdm_context_t *spdm_context, IN uint8 slot_id,
+	IN uint8 measurement_hash_type, IN void *request,
+	IN uintn spdm_response_size, IN void *response,
+	OUT void *measurement_hash, OUT boolean *basic_mut_auth_req);
+
+/**
+  This function builds KEY_EXCHANGE for SPDM key exchange.
+
+  A requester session ID is allocated and a DHE key pair is generated.
+  The caller owns the returned DHE context until it is passed to
+  spdm_process_key_exchange_rsp_response.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  measurement_hash_type          measurement_hash_type to the KEY_EXCHANGE request.
+  @param  slot_id                      slot_id to the KEY_EXCHANGE request.
+  @param  spdm_request_size             On output, size in bytes of the KEY_EXCHANGE request.
+  @param  request                      A pointer to a destination buffer to store the KEY_EXCHANGE request.
+  @param  dhe_context                   On output, the DHE context of the requester.
+
+  @retval RETURN_SUCCESS               The KEY_EXCHANGE is built.
+  @retval RETURN_UNSUPPORTED           The capabilities or the connection state do not allow KEY_EXCHANGE.
+  @retval RETURN_INVALID_PARAMETER     The slot_id is invalid.
+  @retval RETURN_DEVICE_ERROR          The DHE key cannot be generated.
+**/
+return_status spdm_build_key_exchange_request(IN spdm_context_t *spdm_context,
+					      IN uint8 measurement_hash_type,
+					      IN uint8 slot_id,
+					      OUT uintn *spdm_request_size,
+					      OUT void *request,
+					      OUT void **dhe_context);
+
+/**
+  This function processes KEY_EXCHANGE_RSP, the response to KEY_EXCHANGE.
+
+  The DHE context is always freed by this function.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  measurement_hash_type          measurement_hash_type to the KEY_EXCHANGE request.
+  @param  spdm_request_size             size in bytes of the KEY_EXCHANGE request.
+  @param  request                      A pointer to the KEY_EXCHANGE request.
+  @param  dhe_context                   The DHE context returned by spdm_build_key_exchange_request.
+  @param  spdm_response_size            size in bytes of the response.
+  @param  response                     A pointer to the response.
+  @param  session_id                    session_id from the KEY_EXCHANGE_RSP response.
+  @param  heartbeat_period              heartbeat_period from the KEY_EXCHANGE_RSP response.
+  @param  req_slot_id_param               req_slot_id_param from the KEY_EXCHANGE_RSP response.
+  @param  measurement_hash              measurement_hash from the KEY_EXCHANGE_RSP response.
+
+  @retval RETURN_SUCCESS               The KEY_EXCHANGE_RSP is processed.
+  @retval RETURN_DEVICE_ERROR          The response is invalid.
+  @retval RETURN_SECURITY_VIOLATION    Any verification fails.
+  @retval RETURN_NO_RESPONSE           The responder is busy.
+**/
+return_status spdm_process_key_exchange_rsp_response(
+	IN spdm_context_t *spdm_context, IN uint8 measurement_hash_type,
+	IN uintn spdm_request_size, IN void *request, IN void *dhe_context,
+	IN uintn spdm_response_size, IN void *response, OUT uint32 *session_id,
+	OUT uint8 *heartbeat_period, OUT uint8 *req_slot_id_param,
+	OUT void *measurement_hash);
+
+/**
+  This function builds FINISH for SPDM finish.
+
+  The request is appended to the session transcript.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  session_id                    session_id to the FINISH request.
+  @param  req_slot_id_param               req_slot_id_param to the FINISH request.
+  @param  spdm_request_size             On output, size in bytes of the FINISH request.
+  @param  request                      A pointer to a destination buffer to store the FINISH request.
+
+  @retval RETURN_SUCCESS               The FINISH is built.
+  @retval RETURN_UNSUPPORTED           The capabilities or the session state do not allow FINISH.
+  @retval RETURN_INVALID_PARAMETER     The req_slot_id_param is invalid.
+  @retval RETURN_SECURITY_VIOLATION    The signature or the HMAC cannot be generated.
+**/
+return_status spdm_build_finish_request(IN spdm_context_t *spdm_context,
+					IN uint32 session_id,
+					IN uint8 req_slot_id_param,
+					OUT uintn *spdm_request_size,
+					OUT void *request);
+
+/**
+  This function processes FINISH_RSP, the response to FINISH.
+
+  On success, the session data keys are generated and the session is established.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  session_id                    session_id to the FINISH request.
+  @param  spdm_request_size             size in bytes of the FINISH request.
+  @param  spdm_response_size            size in bytes of the response.
+  @param  response                     A pointer to the response.
+
+  @retval RETURN_SUCCESS               The FINISH_RSP is processed.
+  @retval RETURN_DEVICE_ERROR          The response is invalid.
+  @retval RETURN_SECURITY_VIOLATION    Any verification fails.
+  @retval RETURN_NO_RESPONSE           The responder is busy.
+**/
+return_status spdm_process_finish_rsp_response(IN spdm_context_t *spdm_context,
+					       IN uint32 session_id,
+					       IN uintn spdm_request_size,
+					       IN uintn spdm_response_size,
+					       IN void *response);
+
+/**
+  This function builds PSK_EXCHANGE for SPDM PSK exchange.
+
+  A requester session ID is allocated for the new session.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  measurement_hash_type          measurement_hash_type to the PSK_EXCHANGE request.
+  @param  spdm_request_size             On output, size in bytes of the PSK_EXCHANGE request.
+  @param  request                      A pointer to a destination buffer to store the PSK_EXCHANGE request.
+
+  @retval RETURN_SUCCESS               The PSK_EXCHANGE is built.
+  @retval RETURN_UNSUPPORTED           The capabilities or the connection state do not allow PSK_EXCHANGE.
+  @retval RETURN_DEVICE_ERROR          The negotiated algorithms are invalid.
+**/
+return_status spdm_build_psk_exchange_request(IN spdm_context_t *spdm_context,
+					      IN uint8 measurement_hash_type,
+					      OUT uintn *spdm_request_size,
+					      OUT void *request);
+
+/**
+  This function processes PSK_EXCHANGE_RSP, the response to PSK_EXCHANGE.
+
+  If the responder does not support PSK_FINISH, the session is established directly.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  measurement_hash_type          measurement_hash_type to the PSK_EXCHANGE request.
+  @param  spdm_request_size             size in bytes of the PSK_EXCHANGE request.
+  @param  request                      A pointer to the PSK_EXCHANGE request.
+  @param  spdm_response_size            size in bytes of the response.
+  @param  response                     A pointer to the response.
+  @param  session_id                    session_id from the PSK_EXCHANGE_RSP response.
+  @param  heartbeat_period              heartbeat_period from the PSK_EXCHANGE_RSP response.
+  @param  measurement_hash              measurement_hash from the PSK_EXCHANGE_RSP response.
+
+  @retval RETURN_SUCCESS               The PSK_EXCHANGE_RSP is processed.
+  @retval RETURN_DEVICE_ERROR          The response is invalid.
+  @retval RETURN_SECURITY_VIOLATION    Any verification fails.
+  @retval RETURN_NO_RESPONSE           The responder is busy.
+**/
+return_status spdm_process_psk_exchange_rsp_response(
+	IN spdm_context_t *spdm_context, IN uint8 measurement_hash_type,
+	IN uintn spdm_request_size, IN void *request,
+	IN uintn spdm_response_size, IN void *response, OUT uint32 *session_id,
+	OUT uint8 *heartbeat_period, OUT void *measurement_hash);
+
+/**
+  This function builds PSK_FINISH for SPDM PSK finish.
+
+  The request is appended to the session transcript.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  session_id                    session_id to the PSK_FINISH request.
+  @param  spdm_request_size             On output, size in bytes of the PSK_FINISH request.
+  @param  request                      A pointer to a destination buffer to store the PSK_FINISH request.
+
+  @retval RETURN_SUCCESS               The PSK_FINISH is built.
+  @retval RETURN_UNSUPPORTED           The capabilities or the session state do not allow PSK_FINISH.
+  @retval RETURN_SECURITY_VIOLATION    The transcript cannot be updated.
+**/
+return_status spdm_build_psk_finish_request(IN spdm_context_t *spdm_context,
+					    IN uint32 session_id,
+					    OUT uintn *spdm_request_size,
+					    OUT void *request);
+
+/**
+  This function processes PSK_FINISH_RSP, the response to PSK_FINISH.
+
+  On success, the session data keys are generated and the session is established.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  session_id                    session_id to the PSK_FINISH request.
+  @param  spdm_request_size             size in bytes of the PSK_FINISH request.
+  @param  spdm_response_size            size in bytes of the response.
+  @param  response                     A pointer to the response.
+
+  @retval RETURN_SUCCESS               The PSK_FINISH_RSP is processed.
+  @retval RETURN_DEVICE_ERROR          The response is invalid.
+  @retval RETURN_SECURITY_VIOLATION    Any verification fails.
+  @retval RETURN_NO_RESPONSE           The responder is busy.
+**/
+return_status spdm_process_psk_finish_rsp_response(
+	IN spdm_context_t *spdm_context, IN uint32 session_id,
+	IN uintn spdm_request_size, IN uintn spdm_response_size,
+	IN void *response);
+
+/**
+  This function builds GET_MEASUREMENT
+  to get measurement from the device.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  session_id                    Indicates if it is a secured message protected via SPDM session.
+                                       If session_id is NULL, it is a normal message.
+                                       If session_id is NOT NULL, it is a secured message.
+  @param  request_attribute             The request attribute of the request message.
+  @param  measurement_operation         The measurement operation of the request message.
+  @param  slot_id                      The number of slot for the certificate chain.
+  @param  spdm_request_size             On output, size in bytes of the GET_MEASUREMENT request.
+  @param  request                      A pointer to a destination buffer to store the GET_MEASUREMENT request.
+
+  @retval RETURN_SUCCESS               The GET_MEASUREMENT is built.
+  @retval RETURN_UNSUPPORTED           The capabilities or the connection state do not allow GET_MEASUREMENT.
+  @retval RETURN_INVALID_PARAMETER     The slot_id or the request attribute is invalid.
+**/
+return_status spdm_build_get_measurement_request(
+	IN spdm_context_t *spdm_context, IN uint32 *session_id,
+	IN uint8 request_attribute, IN uint8 measurement_operation,
+	IN uint8 slot_id_param, OUT uintn *spdm_request_size,
+	OUT void *request);
+
+/**
+  This function processes MEASUREMENTS, the response to GET_MEASUREMENT.
+
+  If the signature is requested, this function verifies the signature of the measurement.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  session_id                    Indicates if it is a secured message protected via SPDM session.
+                                       If session_id is NULL, it is a normal message.
+                                       If session_id is NOT NULL, it is a secured message.
+  @param  request_attribute             The request attribute of the request message.
+  @param  measurement_operation         The measurement operation of the request message.
+  @param  slot_id                      The number of slot for the certificate chain.
+  @param  spdm_request_size             size in bytes of the GET_MEASUREMENT request.
+  @param  request                      A pointer to the GET_MEASUREMENT request.
+  @param  spdm_response_size            size in bytes of the response.
+  @param  response                     A pointer to the response.
+  @param  number_of_blocks               The number of blocks of the measurement record.
+  @param  measurement_record_length      On input, indicate the size in bytes of the destination buffer to store the measurement record.
+                                       On output, indicate the size in bytes of the measurement record.
+  @param  measurement_record            A pointer to a destination buffer to store the measurement record.
+
+  @retval RETURN_SUCCESS               The MEASUREMENTS is processed.
+  @retval RETURN_DEVICE_ERROR          The response is invalid.
+  @retval RETURN_SECURITY_VIOLATION    Any verification fails.
+  @retval RETURN_NO_RESPONSE           The responder is busy.
+**/
+return_status spdm_process_measurements_response(
+	IN spdm_context_t *spdm_context, IN uint32 *session_id,
+	IN uint8 request_attribute, IN uint8 measurement_operation,
+	IN uint8 slot_id_param, IN uintn spdm_request_size, IN void *request,
+	IN uintn spdm_response_size, IN void *response,
+	OUT uint8 *number_of_blocks, IN OUT uint32 *measurement_record_length,
+	OUT void *measurement_record);
+
+/**
+  This function gets the certificate chain in one slot from the certificate chain cache,
+  instead of GET_CERTIFICATE.
+
+  The cache is looked up by the digest of the slot in the last DIGESTS. A cached chain
+  was verified when it was inserted, so only its digest and the provisioned root
+  certificate hash or certificate chain are checked. No message is added to message_b,
+  as no GET_CERTIFICATE is exchanged with the device.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  slot_id                      The number of slot for the certificate chain.
+  @param  cert_chain_size                On input, indicate the size in bytes of the destination buffer to store the digest buffer.
+                                       On output, indicate the size in bytes of the certificate chain.
+  @param  cert_chain                    A pointer to a destination buffer to store the certificate chain.
+
+  @retval RETURN_SUCCESS               The certificate chain is got from the cache.
+  @retval RETURN_NOT_FOUND             The certificate chain is not cached. GET_CERTIFICATE is needed.
+  @retval RETURN_BUFFER_TOO_SMALL      The cert_chain is too small.
+**/
+return_status spdm_get_cached_certificate(IN spdm_context_t *spdm_context,
+					  IN uint8 slot_id,
+					  IN OUT uintn *cert_chain_size,
+					  OUT void *cert_chain);
+
+/**
+  This function records a certificate chain verified after GET_CERTIFICATE
+  in the certificate chain cache and its persistent store.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  cert_chain_size                size in bytes of the certificate chain buffer.
+  @param  cert_chain                    The verified certificate chain buffer including spdm_cert_chain_t header.
+**/
+void spdm_cache_verified_certificate(IN spdm_context_t *spdm_context,
+				     IN uintn cert_chain_size,
+				     IN void *cert_chain);
+
 #endif
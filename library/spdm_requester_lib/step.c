@@ -0,0 +1,829 @@
+/**
+    Copyright Notice:
+    Copyright 2021 DMTF. All rights reserved.
+    License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+**/
+
+#include "spdm_requester_lib_internal.h"
+
+#define SPDM_REQUESTER_STEP_OPERATION_NONE 0
+#define SPDM_REQUESTER_STEP_OPERATION_INIT_CONNECTION 1
+#define SPDM_REQUESTER_STEP_OPERATION_GET_DIGEST 2
+#define SPDM_REQUESTER_STEP_OPERATION_GET_CERTIFICATE 3
+#define SPDM_REQUESTER_STEP_OPERATION_CHALLENGE 4
+#define SPDM_REQUESTER_STEP_OPERATION_START_SESSION 5
+#define SPDM_REQUESTER_STEP_OPERATION_GET_MEASUREMENT 6
+
+/**
+  Return the session ID used to send the held request.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+
+  @return the session ID of the request, or NULL for a normal message.
+**/
+static uint32 *
+internal_spdm_requester_step_session_id(IN spdm_context_t *spdm_context)
+{
+	switch (spdm_context->requester_step.request_code) {
+	case SPDM_FINISH:
+	case SPDM_PSK_FINISH:
+	case SPDM_GET_MEASUREMENTS:
+		return spdm_context->requester_step.session_id;
+	default:
+		return NULL;
+	}
+}
+
+/**
+  Complete the pending operation with a status.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  status                       The status of the operation.
+**/
+static void internal_spdm_requester_step_complete(IN spdm_context_t *spdm_context,
+						  IN return_status status)
+{
+	spdm_requester_step_context_t *step;
+
+	step = &spdm_context->requester_step;
+	if (step->dhe_context != NULL) {
+		spdm_secured_message_dhe_free(
+			spdm_context->connection_info.algorithm.dhe_named_group,
+			step->dhe_context);
+		step->dhe_context = NULL;
+	}
+	reset_managed_buffer(&step->certificate_chain_buffer);
+	step->respond_if_ready = FALSE;
+	step->status = status;
+	step->action = SPDM_REQUESTER_STEP_ACTION_DONE;
+}
+
+/**
+  Build the next request of the pending operation into last_spdm_request.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  request_code                  The request code of the request to build.
+
+  @retval RETURN_SUCCESS               The request is built.
+  @return other                        The request cannot be built.
+**/
+static return_status
+internal_spdm_requester_step_build(IN spdm_context_t *spdm_context,
+				   IN uint8 request_code)
+{
+	spdm_requester_step_context_t *step;
+	void *request;
+	uintn request_size;
+	return_status status;
+
+	step = &spdm_context->requester_step;
+#if OPENSPDM_ARENA_MANAGED_BUFFER_SUPPORT == 1
+	status = spdm_allocate_arena_request_buffer(
+		&spdm_context->arena, &spdm_context->last_spdm_request);
+	if (RETURN_ERROR(status)) {
+		return status;
+	}
+#endif
+	request = spdm_context->last_spdm_request;
+	request_size = 0;
+	status = RETURN_SUCCESS;
+
+	switch (request_code) {
+	case SPDM_GET_VERSION:
+		status = spdm_build_get_version_request(spdm_context, request);
+		request_size = sizeof(spdm_get_version_request_t);
+		break;
+	case SPDM_GET_CAPABILITIES:
+		status = spdm_build_get_capabilities_request(
+			spdm_context, &request_size, request);
+		break;
+	case SPDM_NEGOTIATE_ALGORITHMS:
+		status = spdm_build_negotiate_algorithms_request(spdm_context,
+								 request);
+		request_size = ((spdm_negotiate_algorithms_request_t *)request)
+				       ->length;
+		break;
+	case SPDM_GET_DIGESTS:
+		status = spdm_build_get_digest_request(spdm_context, request);
+		request_size = sizeof(spdm_get_digest_request_t);
+		break;
+	case SPDM_GET_CERTIFICATE:
+		spdm_build_get_certificate_request(
+			spdm_context, step->slot_id,
+			(uint16)get_managed_buffer_size(
+				&step->certificate_chain_buffer),
+			MAX_SPDM_CERT_CHAIN_BLOCK_LEN, request);
+		request_size = sizeof(spdm_get_certificate_request_t);
+		break;
+	case SPDM_CHALLENGE:
+		status = spdm_build_challenge_request(
+			spdm_context, step->slot_id,
+			step->measurement_hash_type, request);
+		request_size = sizeof(spdm_challenge_request_t);
+		break;
+	case SPDM_KEY_EXCHANGE:
+		status = spdm_build_key_exchange_request(
+			spdm_context, step->measurement_hash_type,
+			step->slot_id, &request_size, request,
+			&step->dhe_context);
+		break;
+	case SPDM_FINISH:
+		if (step->req_slot_id_param == 0xF) {
+			step->req_slot_id_param = 0xFF;
+		}
+		status = spdm_build_finish_request(spdm_context,
+						   *step->session_id,
+						   step->req_slot_id_param,
+						   &request_size, request);
+		break;
+	case SPDM_PSK_EXCHANGE:
+		status = spdm_build_psk_exchange_request(
+			spdm_context, step->measurement_hash_type,
+			&request_size, request);
+		break;
+	case SPDM_PSK_FINISH:
+		status = spdm_build_psk_finish_request(
+			spdm_context, *step->session_id, &request_size,
+			request);
+		break;
+	case SPDM_GET_MEASUREMENTS:
+		status = spdm_build_get_measurement_request(
+			spdm_context, step->session_id, step->request_attribute,
+			step->measurement_operation, step->slot_id,
+			&request_size, request);
+		break;
+	default:
+		ASSERT(FALSE);
+		status = RETURN_UNSUPPORTED;
+		break;
+	}
+	if (RETURN_ERROR(status)) {
+		return status;
+	}
+
+	step->request_code = request_code;
+	spdm_context->last_spdm_request_size = request_size;
+	step->action = SPDM_REQUESTER_STEP_ACTION_SEND;
+	return RETURN_SUCCESS;
+}
+
+/**
+  Process the response to the held request and select the next request.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  response_size                 size in bytes of the response.
+  @param  response                     A pointer to the response.
+  @param  next_request_code              On output, the request code of the next request,
+                                       or 0 if the operation is complete.
+
+  @retval RETURN_SUCCESS               The response is processed.
+  @return other                        The response is rejected.
+**/
+static return_status
+internal_spdm_requester_step_process(IN spdm_context_t *spdm_context,
+				     IN uintn response_size, IN void *response,
+				     OUT uint8 *next_request_code)
+{
+	spdm_requester_step_context_t *step;
+	void *request;
+	uintn request_size;
+	return_status status;
+	uint16 remainder_length;
+	boolean basic_mut_auth_req;
+	spdm_session_info_t *session_info;
+
+	step = &spdm_context->requester_step;
+	request = spdm_context->last_spdm_request;
+	request_size = spdm_context->last_spdm_request_size;
+	*next_request_code = 0;
+
+	switch (step->request_code) {
+	case SPDM_GET_VERSION:
+		status = spdm_process_version_response(spdm_context, request,
+						       response_size, response);
+		if (!RETURN_ERROR(status) && !step->get_version_only) {
+			*next_request_code = SPDM_GET_CAPABILITIES;
+		}
+		return status;
+	case SPDM_GET_CAPABILITIES:
+		status = spdm_process_capabilities_response(
+			spdm_context, request_size, request, response_size,
+			response);
+		if (!RETURN_ERROR(status)) {
+			*next_request_code = SPDM_NEGOTIATE_ALGORITHMS;
+		}
+		return status;
+	case SPDM_NEGOTIATE_ALGORITHMS:
+		return spdm_process_algorithms_response(spdm_context, request,
+							response_size,
+							response);
+	case SPDM_GET_DIGESTS:
+		return spdm_process_digests_response(
+			spdm_context, request, response_size, response,
+			step->slot_mask, step->total_digest_buffer);
+	case SPDM_GET_CERTIFICATE:
+		status = spdm_process_certificate_response(
+			spdm_context, step->slot_id, request, response_size,
+			response, &step->certificate_chain_buffer,
+			&remainder_length);
+		if (RETURN_ERROR(status)) {
+			return status;
+		}
+		if (remainder_length != 0) {
+			*next_request_code = SPDM_GET_CERTIFICATE;
+			return RETURN_SUCCESS;
+		}
+		return spdm_finish_get_certificate(
+			spdm_context, &step->certificate_chain_buffer,
+			step->cert_chain_size, step->cert_chain);
+	case SPDM_CHALLENGE:
+		status = spdm_process_challenge_auth_response(
+			spdm_context, step->slot_id,
+			step->measurement_hash_type, request, response_size,
+			response, step->measurement_hash,
+			&basic_mut_auth_req);
+		if (RETURN_ERROR(status)) {
+			return status;
+		}
+		if (basic_mut_auth_req) {
+			DEBUG((DEBUG_INFO,
+			       "spdm_requester_step - BasicMutAuth is not supported\n"));
+			return RETURN_UNSUPPORTED;
+		}
+		spdm_context->connection_info.connection_state =
+			SPDM_CONNECTION_STATE_AUTHENTICATED;
+		return RETURN_SUCCESS;
+	case SPDM_KEY_EXCHANGE:
+		status = spdm_process_key_exchange_rsp_response(
+			spdm_context, step->measurement_hash_type,
+			request_size, request, step->dhe_context,
+			response_size, response, step->session_id,
+			step->heartbeat_period, &step->req_slot_id_param,
+			step->measurement_hash);
+		step->dhe_context = NULL;
+		if (RETURN_ERROR(status)) {
+			return status;
+		}
+		session_info = spdm_get_session_info_via_session_id(
+			spdm_context, *step->session_id);
+		if (session_info == NULL) {
+			ASSERT(FALSE);
+			return RETURN_UNSUPPORTED;
+		}
+		switch (session_info->mut_auth_requested) {
+		case 0:
+		case SPDM_KEY_EXCHANGE_RESPONSE_MUT_AUTH_REQUESTED:
+			*next_request_code = SPDM_FINISH;
+			return RETURN_SUCCESS;
+		default:
+			DEBUG((DEBUG_INFO,
+			       "spdm_requester_step - unsupported mut_auth_requested - 0x%x\n",
+			       session_info->mut_auth_requested));
+			return RETURN_UNSUPPORTED;
+		}
+	case SPDM_FINISH:
+		return spdm_process_finish_rsp_response(
+			spdm_context, *step->session_id, request_size,
+			response_size, response);
+	case SPDM_PSK_EXCHANGE:
+		status = spdm_process_psk_exchange_rsp_response(
+			spdm_context, step->measurement_hash_type,
+			request_size, request, response_size, response,
+			step->session_id, step->heartbeat_period,
+			step->measurement_hash);
+		// send PSK_FINISH only if Responder supports context.
+		if (!RETURN_ERROR(status) &&
+		    spdm_is_capabilities_flag_supported(
+			    spdm_context, TRUE, 0,
+			    SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_PSK_CAP_RESPONDER_WITH_CONTEXT)) {
+			*next_request_code = SPDM_PSK_FINISH;
+		}
+		return status;
+	case SPDM_PSK_FINISH:
+		return spdm_process_psk_finish_rsp_response(
+			spdm_context, *step->session_id, request_size,
+			response_size, response);
+	case SPDM_GET_MEASUREMENTS:
+		return spdm_process_measurements_response(
+			spdm_context, step->session_id, step->request_attribute,
+			step->measurement_operation, step->slot_id,
+			request_size, request, response_size, response,
+			step->number_of_blocks, step->measurement_record_length,
+			step->measurement_record);
+	default:
+		ASSERT(FALSE);
+		return RETURN_UNSUPPORTED;
+	}
+}
+
+/**
+  Start an operation with its first request.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  request_code                  The request code of the first request.
+
+  @retval RETURN_SUCCESS               The operation is started.
+  @return other                        The first request cannot be built.
+**/
+static return_status
+internal_spdm_requester_step_begin(IN spdm_context_t *spdm_context,
+				   IN uint8 request_code)
+{
+	spdm_requester_step_context_t *step;
+	return_status status;
+
+	step = &spdm_context->requester_step;
+	step->retry = spdm_context->retry_times;
+	step->respond_if_ready = FALSE;
+	step->dhe_context = NULL;
+	status = internal_spdm_requester_step_build(spdm_context, request_code);
+	if (RETURN_ERROR(status)) {
+		step->operation = SPDM_REQUESTER_STEP_OPERATION_NONE;
+	}
+	return status;
+}
+
+/**
+  This function begins to send GET_VERSION, GET_CAPABILITIES, NEGOTIATE_ALGORITHM
+  to initialize the connection with SPDM responder, without blocking on the transport.
+
+  The operation is driven by spdm_requester_step and spdm_requester_step_receive.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  get_version_only              TRUE means only GET_VERSION is sent.
+
+  @retval RETURN_SUCCESS               The operation is started.
+  @retval RETURN_ALREADY_STARTED       Another operation is pending on the SPDM context.
+**/
+return_status spdm_begin_init_connection(IN void *context,
+					 IN boolean get_version_only)
+{
+	spdm_context_t *spdm_context;
+
+	spdm_context = context;
+	if (spdm_context->requester_step.operation !=
+	    SPDM_REQUESTER_STEP_OPERATION_NONE) {
+		return RETURN_ALREADY_STARTED;
+	}
+	spdm_context->requester_step.operation =
+		SPDM_REQUESTER_STEP_OPERATION_INIT_CONNECTION;
+	spdm_context->requester_step.get_version_only = get_version_only;
+	return internal_spdm_requester_step_begin(spdm_context,
+						  SPDM_GET_VERSION);
+}
+
+/**
+  This function begins to send GET_DIGEST
+  to get all digest of the certificate chains from device, without blocking on the transport.
+
+  The operation is driven by spdm_requester_step and spdm_requester_step_receive.
+  The output buffers must stay valid until the operation is complete.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  slot_mask                     The slots which deploy the CertificateChain.
+  @param  total_digest_buffer            A pointer to a destination buffer to store the digest buffer.
+
+  @retval RETURN_SUCCESS               The operation is started.
+  @retval RETURN_ALREADY_STARTED       Another operation is pending on the SPDM context.
+  @retval RETURN_UNSUPPORTED           The capabilities or the connection state do not allow GET_DIGEST.
+**/
+return_status spdm_begin_get_digest(IN void *context, OUT uint8 *slot_mask,
+				    OUT void *total_digest_buffer)
+{
+	spdm_context_t *spdm_context;
+
+	spdm_context = context;
+	if (spdm_context->requester_step.operation !=
+	    SPDM_REQUESTER_STEP_OPERATION_NONE) {
+		return RETURN_ALREADY_STARTED;
+	}
+	spdm_context->requester_step.operation =
+		SPDM_REQUESTER_STEP_OPERATION_GET_DIGEST;
+	spdm_context->requester_step.slot_mask = slot_mask;
+	spdm_context->requester_step.total_digest_buffer = total_digest_buffer;
+	return internal_spdm_requester_step_begin(spdm_context,
+						  SPDM_GET_DIGESTS);
+}
+
+/**
+  This function begins to send GET_CERTIFICATE
+  to get certificate chain in one slot from device, without blocking on the transport.
+
+  The operation is driven by spdm_requester_step and spdm_requester_step_receive.
+  The output buffers must stay valid until the operation is complete.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  slot_id                      The number of slot for the certificate chain.
+  @param  cert_chain_size                On input, indicate the size in bytes of the destination buffer to store the digest buffer.
+                                       On output, indicate the size in bytes of the certificate chain.
+  @param  cert_chain                    A pointer to a destination buffer to store the certificate chain.
+
+  @retval RETURN_SUCCESS               The operation is started.
+  @retval RETURN_ALREADY_STARTED       Another operation is pending on the SPDM context.
+  @retval RETURN_UNSUPPORTED           The capabilities or the connection state do not allow GET_CERTIFICATE.
+  @retval RETURN_INVALID_PARAMETER     The slot_id is invalid.
+**/
+return_status spdm_begin_get_certificate(IN void *context, IN uint8 slot_id,
+					 IN OUT uintn *cert_chain_size,
+					 OUT void *cert_chain)
+{
+	spdm_context_t *spdm_context;
+	return_status status;
+
+	spdm_context = context;
+	if (spdm_context->requester_step.operation !=
+	    SPDM_REQUESTER_STEP_OPERATION_NONE) {
+		return RETURN_ALREADY_STARTED;
+	}
+	status = spdm_start_get_certificate(spdm_context, slot_id);
+	if (RETURN_ERROR(status)) {
+		return status;
+	}
+	status = spdm_get_cached_certificate(spdm_context, slot_id,
+					     cert_chain_size, cert_chain);
+	if (status != RETURN_NOT_FOUND) {
+		//
+		// No GET_CERTIFICATE is needed. The next step reports the status.
+		//
+		spdm_context->requester_step.operation =
+			SPDM_REQUESTER_STEP_OPERATION_GET_CERTIFICATE;
+		internal_spdm_requester_step_complete(spdm_context, status);
+		return RETURN_SUCCESS;
+	}
+	reset_managed_buffer(
+		&spdm_context->requester_step.certificate_chain_buffer);
+	spdm_context->requester_step.operation =
+		SPDM_REQUESTER_STEP_OPERATION_GET_CERTIFICATE;
+	spdm_context->requester_step.slot_id = slot_id;
+	spdm_context->requester_step.cert_chain_size = cert_chain_size;
+	spdm_context->requester_step.cert_chain = cert_chain;
+	return internal_spdm_requester_step_begin(spdm_context,
+						  SPDM_GET_CERTIFICATE);
+}
+
+/**
+  This function begins to send CHALLENGE
+  to authenticate the device based upon the key in one slot, without blocking on the transport.
+
+  The operation is driven by spdm_requester_step and spdm_requester_step_receive.
+  The output buffer must stay valid until the operation is complete.
+  If basic mutual authentication is requested from the responder, the operation
+  completes with RETURN_UNSUPPORTED. spdm_challenge handles it.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  slot_id                      The number of slot for the challenge.
+  @param  measurement_hash_type          The type of the measurement hash.
+  @param  measurement_hash              A pointer to a destination buffer to store the measurement hash.
+
+  @retval RETURN_SUCCESS               The operation is started.
+  @retval RETURN_ALREADY_STARTED       Another operation is pending on the SPDM context.
+  @retval RETURN_UNSUPPORTED           The capabilities or the connection state do not allow CHALLENGE.
+  @retval RETURN_INVALID_PARAMETER     The slot_id is invalid.
+**/
+return_status spdm_begin_challenge(IN void *context, IN uint8 slot_id,
+				   IN uint8 measurement_hash_type,
+				   OUT void *measurement_hash)
+{
+	spdm_context_t *spdm_context;
+
+	spdm_context = context;
+	if (spdm_context->requester_step.operation !=
+	    SPDM_REQUESTER_STEP_OPERATION_NONE) {
+		return RETURN_ALREADY_STARTED;
+	}
+	spdm_context->requester_step.operation =
+		SPDM_REQUESTER_STEP_OPERATION_CHALLENGE;
+	spdm_context->requester_step.slot_id = slot_id;
+	spdm_context->requester_step.measurement_hash_type =
+		measurement_hash_type;
+	spdm_context->requester_step.measurement_hash = measurement_hash;
+	return internal_spdm_requester_step_begin(spdm_context,
+						  SPDM_CHALLENGE);
+}
+
+/**
+  This function begins to send KEY_EXCHANGE/FINISH or PSK_EXCHANGE/PSK_FINISH
+  to start an SPDM Session, without blocking on the transport.
+
+  The operation is driven by spdm_requester_step and spdm_requester_step_receive.
+  The output buffers must stay valid until the operation is complete.
+  If encapsulated mutual authentication is requested from the responder, the
+  operation completes with RETURN_UNSUPPORTED. spdm_start_session handles it.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  use_psk                       FALSE means to use KEY_EXCHANGE/FINISH to start a session.
+                                       TRUE means to use PSK_EXCHANGE/PSK_FINISH to start a session.
+  @param  measurement_hash_type          The type of the measurement hash.
+  @param  slot_id                      The number of slot for the certificate chain.
+  @param  session_id                    The session ID of the session.
+  @param  heartbeat_period              The heartbeat period for the session.
+  @param  measurement_hash              A pointer to a destination buffer to store the measurement hash.
+
+  @retval RETURN_SUCCESS               The operation is started.
+  @retval RETURN_ALREADY_STARTED       Another operation is pending on the SPDM context.
+  @retval RETURN_UNSUPPORTED           The capabilities or the connection state do not allow the session.
+**/
+return_status spdm_begin_start_session(IN void *context, IN boolean use_psk,
+				       IN uint8 measurement_hash_type,
+				       IN uint8 slot_id, OUT uint32 *session_id,
+				       OUT uint8 *heartbeat_period,
+				       OUT void *measurement_hash)
+{
+	spdm_context_t *spdm_context;
+
+	spdm_context = context;
+	if (spdm_context->requester_step.operation !=
+	    SPDM_REQUESTER_STEP_OPERATION_NONE) {
+		return RETURN_ALREADY_STARTED;
+	}
+	spdm_context->requester_step.operation =
+		SPDM_REQUESTER_STEP_OPERATION_START_SESSION;
+	spdm_context->requester_step.use_psk = use_psk;
+	spdm_context->requester_step.slot_id = slot_id;
+	spdm_context->requester_step.measurement_hash_type =
+		measurement_hash_type;
+	spdm_context->requester_step.session_id = session_id;
+	spdm_context->requester_step.heartbeat_period = heartbeat_period;
+	spdm_context->requester_step.measurement_hash = measurement_hash;
+	spdm_context->requester_step.req_slot_id_param = 0;
+	return internal_spdm_requester_step_begin(
+		spdm_context, use_psk ? SPDM_PSK_EXCHANGE : SPDM_KEY_EXCHANGE);
+}
+
+/**
+  This function begins to send GET_MEASUREMENT
+  to get measurement from the device, without blocking on the transport.
+
+  The operation is driven by spdm_requester_step and spdm_requester_step_receive.
+  The session ID and the output buffers must stay valid until the operation is complete.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  session_id                    Indicates if it is a secured message protected via SPDM session.
+                                       If session_id is NULL, it is a normal message.
+                                       If session_id is NOT NULL, it is a secured message.
+  @param  request_attribute             The request attribute of the request message.
+  @param  measurement_operation         The measurement operation of the request message.
+  @param  slot_id                      The number of slot for the certificate chain.
+  @param  number_of_blocks               The number of blocks of the measurement record.
+  @param  measurement_record_length      On input, indicate the size in bytes of the destination buffer to store the measurement record.
+                                       On output, indicate the size in bytes of the measurement record.
+  @param  measurement_record            A pointer to a destination buffer to store the measurement record.
+
+  @retval RETURN_SUCCESS               The operation is started.
+  @retval RETURN_ALREADY_STARTED       Another operation is pending on the SPDM context.
+  @retval RETURN_UNSUPPORTED           The capabilities or the connection state do not allow GET_MEASUREMENT.
+  @retval RETURN_INVALID_PARAMETER     The slot_id or the request attribute is invalid.
+**/
+return_status spdm_begin_get_measurement(IN void *context, IN uint32 *session_id,
+					 IN uint8 request_attribute,
+					 IN uint8 measurement_operation,
+					 IN uint8 slot_id_param,
+					 OUT uint8 *number_of_blocks,
+					 IN OUT uint32 *measurement_record_length,
+					 OUT void *measurement_record)
+{
+	spdm_context_t *spdm_context;
+
+	spdm_context = context;
+	if (spdm_context->requester_step.operation !=
+	    SPDM_REQUESTER_STEP_OPERATION_NONE) {
+		return RETURN_ALREADY_STARTED;
+	}
+	spdm_context->requester_step.operation =
+		SPDM_REQUESTER_STEP_OPERATION_GET_MEASUREMENT;
+	spdm_context->requester_step.session_id = session_id;
+	spdm_context->requester_step.request_attribute = request_attribute;
+	spdm_context->requester_step.measurement_operation =
+		measurement_operation;
+	spdm_context->requester_step.slot_id = slot_id_param;
+	spdm_context->requester_step.number_of_blocks = number_of_blocks;
+	spdm_context->requester_step.measurement_record_length =
+		measurement_record_length;
+	spdm_context->requester_step.measurement_record = measurement_record;
+	return internal_spdm_requester_step_begin(spdm_context,
+						  SPDM_GET_MEASUREMENTS);
+}
+
+/**
+  Advance the operation started by spdm_begin_* on an SPDM context.
+
+  If the action is SPDM_REQUESTER_STEP_ACTION_SEND, the next request is encoded to
+  the transport message, and the caller sends it to the device.
+  If the action is SPDM_REQUESTER_STEP_ACTION_RECEIVE, the caller receives a transport
+  message from the device and passes it to spdm_requester_step_receive.
+  If the action is SPDM_REQUESTER_STEP_ACTION_DONE, the operation is complete, its status
+  is returned, and a new operation can be started.
+
+  The requester statistics count the requests, BUSY and ResponseNotReady, and record the
+  encode, decode and verify time as for the blocking API. The send and receive time is not
+  recorded, because the caller moves the transport messages.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  action                       On output, the action required from the caller.
+  @param  transport_message_size         size in bytes of the transport message data buffer.
+                                       On output, the size in bytes of the transport message to send.
+  @param  transport_message             A pointer to a destination buffer to store the transport message to send.
+
+  @retval RETURN_SUCCESS               The action is returned, or the operation succeeded.
+  @retval RETURN_NOT_STARTED           No operation is pending on the SPDM context.
+  @retval others                       The operation failed, with the status of the blocking API.
+**/
+return_status spdm_requester_step(IN void *context,
+				  OUT spdm_requester_step_action_t *action,
+				  IN OUT uintn *transport_message_size,
+				  OUT void *transport_message)
+{
+	spdm_context_t *spdm_context;
+	spdm_requester_step_context_t *step;
+	spdm_response_if_ready_request_t spdm_request;
+	return_status status;
+
+	spdm_context = context;
+	step = &spdm_context->requester_step;
+	if (step->operation == SPDM_REQUESTER_STEP_OPERATION_NONE) {
+		*action = SPDM_REQUESTER_STEP_ACTION_DONE;
+		return RETURN_NOT_STARTED;
+	}
+
+	switch (step->action) {
+	case SPDM_REQUESTER_STEP_ACTION_SEND:
+		if (step->respond_if_ready) {
+			if (spdm_is_version_supported(spdm_context,
+						      SPDM_MESSAGE_VERSION_11)) {
+				spdm_request.header.spdm_version =
+					SPDM_MESSAGE_VERSION_11;
+			} else {
+				spdm_request.header.spdm_version =
+					SPDM_MESSAGE_VERSION_10;
+			}
+			spdm_request.header.request_response_code =
+				SPDM_RESPOND_IF_READY;
+			spdm_request.header.param1 =
+				spdm_context->error_data.request_code;
+			spdm_request.header.param2 =
+				spdm_context->error_data.token;
+			status = spdm_encode_spdm_request(
+				spdm_context,
+				internal_spdm_requester_step_session_id(
+					spdm_context),
+				sizeof(spdm_request), &spdm_request,
+				transport_message_size, transport_message);
+		} else {
+			status = spdm_encode_spdm_request(
+				spdm_context,
+				internal_spdm_requester_step_session_id(
+					spdm_context),
+				spdm_context->last_spdm_request_size,
+				spdm_context->last_spdm_request,
+				transport_message_size, transport_message);
+		}
+		if (!RETURN_ERROR(status)) {
+			step->action = SPDM_REQUESTER_STEP_ACTION_RECEIVE;
+			*action = SPDM_REQUESTER_STEP_ACTION_SEND;
+			return RETURN_SUCCESS;
+		}
+		internal_spdm_requester_step_complete(spdm_context,
+						      RETURN_DEVICE_ERROR);
+		break;
+	case SPDM_REQUESTER_STEP_ACTION_RECEIVE:
+		*action = SPDM_REQUESTER_STEP_ACTION_RECEIVE;
+		return RETURN_SUCCESS;
+	default:
+		break;
+	}
+
+	*action = SPDM_REQUESTER_STEP_ACTION_DONE;
+	step->operation = SPDM_REQUESTER_STEP_OPERATION_NONE;
+	return step->status;
+}
+
+/**
+  Feed a transport message received from the device to the pending operation.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  transport_message_size         size in bytes of the transport message.
+  @param  transport_message             A pointer to the received transport message.
+                                       NULL means the transport failed to receive a message,
+                                       and the operation completes with RETURN_DEVICE_ERROR.
+
+  @retval RETURN_SUCCESS               The transport message is consumed. Call spdm_requester_step for the next action.
+  @retval RETURN_NOT_STARTED           No operation is waiting for a response.
+**/
+return_status spdm_requester_step_receive(IN void *context,
+					  IN uintn transport_message_size,
+					  IN void *transport_message)
+{
+	spdm_context_t *spdm_context;
+	spdm_requester_step_context_t *step;
+	uint8 response[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+	uintn response_size;
+	spdm_error_response_t *spdm_response;
+	spdm_error_data_response_not_ready_t *extend_error_data;
+	uint8 next_request_code;
+	return_status status;
+
+	spdm_context = context;
+	step = &spdm_context->requester_step;
+	if ((step->operation == SPDM_REQUESTER_STEP_OPERATION_NONE) ||
+	    (step->action != SPDM_REQUESTER_STEP_ACTION_RECEIVE)) {
+		return RETURN_NOT_STARTED;
+	}
+	if (transport_message == NULL) {
+		internal_spdm_requester_step_complete(spdm_context,
+						      RETURN_DEVICE_ERROR);
+		return RETURN_SUCCESS;
+	}
+
+	response_size = sizeof(response);
+	zero_mem(response, sizeof(response));
+	status = spdm_decode_spdm_response(
+		spdm_context, internal_spdm_requester_step_session_id(spdm_context),
+		transport_message_size, transport_message, &response_size,
+		response);
+	if (RETURN_ERROR(status)) {
+		internal_spdm_requester_step_complete(spdm_context,
+						      RETURN_DEVICE_ERROR);
+		return RETURN_SUCCESS;
+	}
+
+	spdm_response = (void *)response;
+	if (step->respond_if_ready) {
+		//
+		// The response to RESPOND_IF_READY must be the expected response.
+		//
+		step->respond_if_ready = FALSE;
+		if ((response_size < sizeof(spdm_message_header_t)) ||
+		    (spdm_response->header.request_response_code ==
+		     SPDM_ERROR)) {
+			internal_spdm_requester_step_complete(
+				spdm_context, RETURN_DEVICE_ERROR);
+			return RETURN_SUCCESS;
+		}
+	} else if ((step->request_code != SPDM_GET_VERSION) &&
+		   (step->request_code != SPDM_GET_CAPABILITIES) &&
+		   (step->request_code != SPDM_NEGOTIATE_ALGORITHMS) &&
+		   (response_size == sizeof(spdm_error_response_t) +
+					     sizeof(spdm_error_data_response_not_ready_t)) &&
+		   (spdm_response->header.request_response_code ==
+		    SPDM_ERROR) &&
+		   (spdm_response->header.param1 ==
+		    SPDM_ERROR_CODE_RESPONSE_NOT_READY)) {
+		//
+		// Send RESPOND_IF_READY on the next step instead of waiting here.
+		//
+		extend_error_data =
+			(spdm_error_data_response_not_ready_t *)(spdm_response +
+								 1);
+		spdm_context->error_data.rd_exponent =
+			extend_error_data->rd_exponent;
+		spdm_context->error_data.request_code =
+			extend_error_data->request_code;
+		spdm_context->error_data.token = extend_error_data->token;
+		spdm_context->error_data.rd_tm = extend_error_data->rd_tm;
+		step->respond_if_ready = TRUE;
+		step->action = SPDM_REQUESTER_STEP_ACTION_SEND;
+		return RETURN_SUCCESS;
+	}
+
+	status = internal_spdm_requester_step_process(
+		spdm_context, response_size, response, &next_request_code);
+	if ((status == RETURN_NO_RESPONSE) && (step->retry-- != 0)) {
+		next_request_code = step->request_code;
+	} else if (RETURN_ERROR(status)) {
+		internal_spdm_requester_step_complete(spdm_context, status);
+		return RETURN_SUCCESS;
+	}
+
+	if (next_request_code == 0) {
+		internal_spdm_requester_step_complete(spdm_context,
+						      RETURN_SUCCESS);
+		return RETURN_SUCCESS;
+	}
+	status = internal_spdm_requester_step_build(spdm_context,
+						    next_request_code);
+	if (RETURN_ERROR(status)) {
+		internal_spdm_requester_step_complete(spdm_context, status);
+	}
+	return RETURN_SUCCESS;
+}
+
+/**
+  Abort the operation pending on an SPDM context.
+
+  The resources held by the operation are released and a new operation can be started.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+**/
+void spdm_requester_step_abort(IN void *context)
+{
+	spdm_context_t *spdm_context;
+
+	spdm_context = context;
+	if (spdm_context->requester_step.operation ==
+	    SPDM_REQUESTER_STEP_OPERATION_NONE) {
+		return;
+	}
+	internal_spdm_requester_step_complete(spdm_context, RETURN_ABORTED);
+	spdm_context->requester_step.operation =
+		SPDM_REQUESTER_STEP_OPERATION_NONE;
+}
@@ -312,7 +312,7 @@ return_status spdm_get_response_algorithms(IN void *context,
 	spdm_context->connection_info.algorithm.measurement_spec =
 		spdm_request->measurement_specification;
 	spdm_context->connection_info.algorithm.measurement_hash_algo =
-		spdm_context->local_context.algorithm.measurement_hash_algo;
+		spdm_context->local_context->algorithm.measurement_hash_algo;
 	spdm_context->connection_info.algorithm.base_asym_algo =
 		spdm_request->base_asym_algo;
 	spdm_context->connection_info.algorithm.base_hash_algo =
@@ -358,21 +358,21 @@ return_status spdm_get_response_algorithms(IN void *context,
 		(uint8)spdm_prioritize_algorithm(
 			m_measurement_spec_priority_table,
 			ARRAY_SIZE(m_measurement_spec_priority_table),
-			spdm_context->local_context.algorithm.measurement_spec,
+			spdm_context->local_context->algorithm.measurement_spec,
 			spdm_context->connection_info.algorithm
 				.measurement_spec);
 	spdm_response->measurement_hash_algo = spdm_prioritize_algorithm(
 		m_measurement_hash_priority_table,
 		ARRAY_SIZE(m_measurement_hash_priority_table),
-		spdm_context->local_context.algorithm.measurement_hash_algo,
+		spdm_context->local_context->algorithm.measurement_hash_algo,
 		spdm_context->connection_info.algorithm.measurement_hash_algo);
 	spdm_response->base_asym_sel = spdm_prioritize_algorithm(
 		m_asym_priority_table, ARRAY_SIZE(m_asym_priority_table),
-		spdm_context->local_context.algorithm.base_asym_algo,
+		spdm_context->local_context->algorithm.base_asym_algo,
 		spdm_context->connection_info.algorithm.base_asym_algo);
 	spdm_response->base_hash_sel = spdm_prioritize_algorithm(
 		m_hash_priority_table, ARRAY_SIZE(m_hash_priority_table),
-		spdm_context->local_context.algorithm.base_hash_algo,
+		spdm_context->local_context->algorithm.base_hash_algo,
 		spdm_context->connection_info.algorithm.base_hash_algo);
 	spdm_response->struct_table[0].alg_type =
 		SPDM_NEGOTIATE_ALGORITHMS_STRUCT_TABLE_ALG_TYPE_DHE;
@@ -380,7 +380,7 @@ return_status spdm_get_response_algorithms(IN void *context,
 	spdm_response->struct_table[0].alg_supported =
 		(uint16)spdm_prioritize_algorithm(
 			m_dhe_priority_table, ARRAY_SIZE(m_dhe_priority_table),
-			spdm_context->local_context.algorithm.dhe_named_group,
+			spdm_context->local_context->algorithm.dhe_named_group,
 			spdm_context->connection_info.algorithm.dhe_named_group);
 	spdm_response->struct_table[1].alg_type =
 		SPDM_NEGOTIATE_ALGORITHMS_STRUCT_TABLE_ALG_TYPE_AEAD;
@@ -388,7 +388,7 @@ return_status spdm_get_response_algorithms(IN void *context,
 	spdm_response->struct_table[1]
 		.alg_supported = (uint16)spdm_prioritize_algorithm(
 		m_aead_priority_table, ARRAY_SIZE(m_aead_priority_table),
-		spdm_context->local_context.algorithm.aead_cipher_suite,
+		spdm_context->local_context->algorithm.aead_cipher_suite,
 		spdm_context->connection_info.algorithm.aead_cipher_suite);
 	spdm_response->struct_table[2].alg_type =
 		SPDM_NEGOTIATE_ALGORITHMS_STRUCT_TABLE_ALG_TYPE_REQ_BASE_ASYM_ALG;
@@ -397,7 +397,7 @@ return_status spdm_get_response_algorithms(IN void *context,
 		.alg_supported = (uint16)spdm_prioritize_algorithm(
 		m_req_asym_priority_table,
 		ARRAY_SIZE(m_req_asym_priority_table),
-		spdm_context->local_context.algorithm.req_base_asym_alg,
+		spdm_context->local_context->algorithm.req_base_asym_alg,
 		spdm_context->connection_info.algorithm.req_base_asym_alg);
 	spdm_response->struct_table[3].alg_type =
 		SPDM_NEGOTIATE_ALGORITHMS_STRUCT_TABLE_ALG_TYPE_KEY_SCHEDULE;
@@ -406,7 +406,7 @@ return_status spdm_get_response_algorithms(IN void *context,
 		(uint16)spdm_prioritize_algorithm(
 			m_key_schedule_priority_table,
 			ARRAY_SIZE(m_key_schedule_priority_table),
-			spdm_context->local_context.algorithm.key_schedule,
+			spdm_context->local_context->algorithm.key_schedule,
 			spdm_context->connection_info.algorithm.key_schedule);
 
 	spdm_context->connection_info.algorithm.measurement_spec =
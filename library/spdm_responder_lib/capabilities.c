@@ -182,8 +182,8 @@ return_status spdm_get_response_capabilities(IN void *context,
 	spdm_response->header.param1 = 0;
 	spdm_response->header.param2 = 0;
 	spdm_response->ct_exponent =
-		spdm_context->local_context.capability.ct_exponent;
-	spdm_response->flags = spdm_context->local_context.capability.flags;
+		spdm_context->local_context->capability.ct_exponent;
+	spdm_response->flags = spdm_context->local_context->capability.flags;
 	//
 	// Cache
 	//
@@ -81,7 +81,7 @@ return_status spdm_get_response_challenge_auth(IN void *context,
 	slot_id = spdm_request->header.param1;
 
 	if ((slot_id != 0xFF) &&
-	    (slot_id >= spdm_context->local_context.slot_count)) {
+	    (slot_id >= spdm_context->local_context->slot_count)) {
 		return spdm_generate_error_response(spdm_context,
 					     SPDM_ERROR_CODE_INVALID_REQUEST, 0,
 					     response_size, response);
@@ -98,7 +98,7 @@ return_status spdm_get_response_challenge_auth(IN void *context,
 		sizeof(spdm_challenge_auth_response_t) + hash_size +
 		SPDM_NONCE_SIZE + measurement_summary_hash_size +
 		sizeof(uint16) +
-		spdm_context->local_context.opaque_challenge_auth_rsp_size +
+		spdm_context->local_context->opaque_challenge_auth_rsp_size +
 		signature_size;
 
 	ASSERT(*response_size >= total_size);
@@ -140,7 +140,7 @@ return_status spdm_get_response_challenge_auth(IN void *context,
 			     spdm_context, FALSE,
 			     SPDM_GET_CAPABILITIES_REQUEST_FLAGS_PUB_KEY_ID_CAP, 0))) {
 			auth_attribute.basic_mut_auth_req =
-				spdm_context->local_context.basic_mut_auth_requested;
+				spdm_context->local_context->basic_mut_auth_requested;
 		}
 		if (auth_attribute.basic_mut_auth_req != 0) {
 			spdm_init_basic_mut_auth_encap_state(
@@ -153,7 +153,7 @@ return_status spdm_get_response_challenge_auth(IN void *context,
 	if (slot_id == 0xFF) {
 		spdm_response->header.param2 = 0;
 
-		slot_id = spdm_context->local_context.provisioned_slot_id;
+		slot_id = spdm_context->local_context->provisioned_slot_id;
 	}
 
 	ptr = (void *)(spdm_response + 1);
@@ -173,11 +173,11 @@ return_status spdm_get_response_challenge_auth(IN void *context,
 	ptr += measurement_summary_hash_size;
 
 	*(uint16 *)ptr = (uint16)spdm_context->local_context
-				 .opaque_challenge_auth_rsp_size;
+				 ->opaque_challenge_auth_rsp_size;
 	ptr += sizeof(uint16);
-	copy_mem(ptr, spdm_context->local_context.opaque_challenge_auth_rsp,
-		 spdm_context->local_context.opaque_challenge_auth_rsp_size);
-	ptr += spdm_context->local_context.opaque_challenge_auth_rsp_size;
+	copy_mem(ptr, spdm_context->local_context->opaque_challenge_auth_rsp,
+		 spdm_context->local_context->opaque_challenge_auth_rsp_size);
+	ptr += spdm_context->local_context->opaque_challenge_auth_rsp_size;
 
 	//
 	// Calc Sign
@@ -194,7 +194,7 @@ return_status spdm_get_response_challenge_auth(IN void *context,
 	status = spdm_append_message_c(spdm_context, spdm_response,
 				       (uintn)ptr - (uintn)spdm_response);
 	if (RETURN_ERROR(status)) {
-		reset_managed_buffer(&spdm_context->transcript.message_c);
+		spdm_reset_message_c(spdm_context);
 		return spdm_generate_error_response(spdm_context,
 					     SPDM_ERROR_CODE_UNSPECIFIED, 0,
 					     response_size, response);
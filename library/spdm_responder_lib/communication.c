@@ -100,5 +100,11 @@ return_status spdm_responder_dispatch_message(IN void *context)
 	status = spdm_context->send_message(spdm_context, response_size,
 					    response, 0);
 
+	//
+	// Replace the DHE key pair KEY_EXCHANGE took from the pool while the requester
+	// works on the response, so that the next KEY_EXCHANGE finds one ready.
+	//
+	spdm_refill_used_dhe_key_pool(spdm_context);
+
 	return status;
 }
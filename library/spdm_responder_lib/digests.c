@@ -75,7 +75,7 @@ return_status spdm_get_response_digests(IN void *context, IN uintn request_size,
 
 	spdm_request_size = request_size;
 
-	if (spdm_context->local_context.local_cert_chain_provision == NULL) {
+	if (spdm_context->local_context->local_cert_chain_provision == NULL) {
 		spdm_generate_error_response(
 			spdm_context, SPDM_ERROR_CODE_UNSUPPORTED_REQUEST,
 			SPDM_GET_DIGESTS, response_size, response);
@@ -85,7 +85,7 @@ return_status spdm_get_response_digests(IN void *context, IN uintn request_size,
 	no_local_cert_chain = TRUE;
 	for (index = 0; index < MAX_SPDM_SLOT_COUNT; index++) {
 		if (spdm_context->local_context
-			    .local_cert_chain_provision[index] != NULL) {
+			    ->local_cert_chain_provision[index] != NULL) {
 			no_local_cert_chain = FALSE;
 		}
 	}
@@ -101,9 +101,9 @@ return_status spdm_get_response_digests(IN void *context, IN uintn request_size,
 
 	ASSERT(*response_size >=
 	       sizeof(spdm_digest_response_t) +
-		       hash_size * spdm_context->local_context.slot_count);
+		       hash_size * spdm_context->local_context->slot_count);
 	*response_size = sizeof(spdm_digest_response_t) +
-			 hash_size * spdm_context->local_context.slot_count;
+			 hash_size * spdm_context->local_context->slot_count;
 	zero_mem(response, *response_size);
 	spdm_response = response;
 
@@ -117,7 +117,7 @@ return_status spdm_get_response_digests(IN void *context, IN uintn request_size,
 	spdm_response->header.param2 = 0;
 
 	digest = (void *)(spdm_response + 1);
-	for (index = 0; index < spdm_context->local_context.slot_count;
+	for (index = 0; index < spdm_context->local_context->slot_count;
 	     index++) {
 		spdm_response->header.param2 |= (1 << index);
 		spdm_generate_cert_chain_hash(spdm_context, index,
@@ -106,7 +106,11 @@ return_status spdm_process_encap_response_certificate(
 	}
 	if (spdm_response->header.request_response_code == SPDM_ERROR) {
 		status = spdm_handle_encap_error_response_main(
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 			spdm_context, &spdm_context->transcript.message_mut_b,
+#else
+			spdm_context, NULL,
+#endif
 			spdm_context->encap_context.last_encap_request_size,
 			spdm_response->header.param1);
 		if (RETURN_ERROR(status)) {
@@ -181,6 +185,7 @@ return_status spdm_process_encap_response_certificate(
 			&spdm_context->encap_context.certificate_chain_buffer),
 		get_managed_buffer_size(
 			&spdm_context->encap_context.certificate_chain_buffer));
+	spdm_invalidate_peer_cert_chain_hash(spdm_context);
 
 	spdm_context->encap_context.error_state = SPDM_STATUS_SUCCESS;
 
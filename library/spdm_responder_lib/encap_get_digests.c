@@ -102,7 +102,11 @@ return_status spdm_process_encap_response_digest(
 	}
 	if (spdm_response->header.request_response_code == SPDM_ERROR) {
 		status = spdm_handle_encap_error_response_main(
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 			spdm_context, &spdm_context->transcript.message_mut_b,
+#else
+			spdm_context, NULL,
+#endif
 			spdm_context->encap_context.last_encap_request_size,
 			spdm_response->header.param1);
 		if (RETURN_ERROR(status)) {
@@ -198,8 +198,8 @@ void spdm_init_mut_auth_encap_state(IN spdm_context_t *spdm_context,
 	//
 	// Clear Cache
 	//
-	reset_managed_buffer(&spdm_context->transcript.message_mut_b);
-	reset_managed_buffer(&spdm_context->transcript.message_mut_c);
+	spdm_reset_message_mut_b(spdm_context);
+	spdm_reset_message_mut_c(spdm_context);
 
 	//
 	// Possible Sequence:
@@ -252,8 +252,8 @@ void spdm_init_basic_mut_auth_encap_state(IN spdm_context_t *spdm_context,
 	//
 	// Clear Cache
 	//
-	reset_managed_buffer(&spdm_context->transcript.message_mut_b);
-	reset_managed_buffer(&spdm_context->transcript.message_mut_c);
+	spdm_reset_message_mut_b(spdm_context);
+	spdm_reset_message_mut_c(spdm_context);
 
 	//
 	// Possible Sequence:
@@ -308,8 +308,8 @@ void spdm_init_key_update_encap_state(IN void *context)
 	spdm_context->encap_context.certificate_chain_buffer.buffer_size = 0;
 	spdm_context->response_state = SPDM_RESPONSE_STATE_PROCESSING_ENCAP;
 
-	reset_managed_buffer(&spdm_context->transcript.message_mut_b);
-	reset_managed_buffer(&spdm_context->transcript.message_mut_c);
+	spdm_reset_message_mut_b(spdm_context);
+	spdm_reset_message_mut_c(spdm_context);
 
 	zero_mem(spdm_context->encap_context.request_op_code_sequence,
 		 sizeof(spdm_context->encap_context.request_op_code_sequence));
@@ -561,7 +561,7 @@ return_status spdm_get_response_encapsulated_response_ack(
   This function handles the encap error response.
 
   @param  spdm_context                  A pointer to the SPDM context.
-  @param  managed_buffer_t                The managed buffer to be shrinked.
+  @param  managed_buffer_t                The managed buffer to be shrinked, or NULL.
   @param  shrink_buffer_size             The size in bytes of the size of the buffer to be shrinked.
   @param  error_code                    Indicate the error code.
 
@@ -581,7 +581,10 @@ return_status spdm_handle_encap_error_response_main(
 	// The sequence is fixed in CHALLENG_AUTH or KEY_EXCHANGE_RSP, the responder cannot issue encap request again.
 	// If the requester restarts the mutual auth via CHALLENG or KEY_EXCHANGE, the encap will also restart.
 	// Do it here just to align with requester.
+	// m_buffer is NULL if the transcript is not recorded, because a running hash cannot be shrinked.
 	//
-	shrink_managed_buffer(m_buffer, shrink_buffer_size);
+	if (m_buffer != NULL) {
+		shrink_managed_buffer(m_buffer, shrink_buffer_size);
+	}
 	return RETURN_DEVICE_ERROR;
 }
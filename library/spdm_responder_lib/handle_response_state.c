@@ -47,6 +47,17 @@ return_status spdm_responder_handle_response_state(IN void *context,
 	case SPDM_RESPONSE_STATE_NOT_READY:
 		//do not update ErrorData if a previous request has not been completed
 		if(request_code != SPDM_RESPOND_IF_READY) {
+#if OPENSPDM_ARENA_MANAGED_BUFFER_SUPPORT == 1
+			if (RETURN_ERROR(spdm_allocate_arena_request_buffer(
+				    &spdm_context->arena,
+				    &spdm_context->cache_spdm_request))) {
+				spdm_generate_error_response(
+					spdm_context,
+					SPDM_ERROR_CODE_UNSPECIFIED, 0,
+					response_size, response);
+				return RETURN_SUCCESS;
+			}
+#endif
 			spdm_context->cache_spdm_request_size =
 				spdm_context->last_spdm_request_size;
 			copy_mem(spdm_context->cache_spdm_request,
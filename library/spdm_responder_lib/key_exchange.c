@@ -93,7 +93,7 @@ return_status spdm_get_response_key_exchange(IN void *context,
 
 	slot_id = spdm_request->header.param2;
 	if ((slot_id != 0xFF) &&
-	    (slot_id >= spdm_context->local_context.slot_count)) {
+	    (slot_id >= spdm_context->local_context->slot_count)) {
 		spdm_generate_error_response(spdm_context,
 					     SPDM_ERROR_CODE_INVALID_REQUEST, 0,
 					     response_size, response);
@@ -101,7 +101,7 @@ return_status spdm_get_response_key_exchange(IN void *context,
 	}
 
 	if (slot_id == 0xFF) {
-		slot_id = spdm_context->local_context.provisioned_slot_id;
+		slot_id = spdm_context->local_context->provisioned_slot_id;
 	}
 
 	signature_size = spdm_get_asym_signature_size(
@@ -201,7 +201,7 @@ return_status spdm_get_response_key_exchange(IN void *context,
 		     spdm_context, FALSE,
 		     SPDM_GET_CAPABILITIES_REQUEST_FLAGS_PUB_KEY_ID_CAP, 0))) {
 		spdm_response->mut_auth_requested =
-			spdm_context->local_context.mut_auth_requested;
+			spdm_context->local_context->mut_auth_requested;
 	}
 	if (spdm_response->mut_auth_requested != 0) {
 		spdm_init_mut_auth_encap_state(
@@ -216,11 +216,17 @@ return_status spdm_get_response_key_exchange(IN void *context,
 			       spdm_response->random_data);
 
 	ptr = (void *)(spdm_response + 1);
-	dhe_context = spdm_secured_message_dhe_new(
-		spdm_context->connection_info.algorithm.dhe_named_group);
-	spdm_secured_message_dhe_generate_key(
-		spdm_context->connection_info.algorithm.dhe_named_group,
-		dhe_context, ptr, &dhe_key_size);
+	dhe_context = spdm_acquire_dhe_key(
+		spdm_context,
+		spdm_context->connection_info.algorithm.dhe_named_group, ptr,
+		&dhe_key_size);
+	if (dhe_context == NULL) {
+		spdm_free_session_id(spdm_context, session_id);
+		spdm_generate_error_response(spdm_context,
+					     SPDM_ERROR_CODE_UNSPECIFIED, 0,
+					     response_size, response);
+		return RETURN_SUCCESS;
+	}
 	DEBUG((DEBUG_INFO, "Calc SelfKey (0x%x):\n", dhe_key_size));
 	internal_dump_hex(ptr, dhe_key_size);
 
@@ -266,12 +272,13 @@ return_status spdm_get_response_key_exchange(IN void *context,
 	ptr += opaque_key_exchange_rsp_size;
 
 	spdm_context->connection_info.local_used_cert_chain_buffer =
-		spdm_context->local_context.local_cert_chain_provision[slot_id];
+		spdm_context->local_context->local_cert_chain_provision[slot_id];
 	spdm_context->connection_info.local_used_cert_chain_buffer_size =
 		spdm_context->local_context
-			.local_cert_chain_provision_size[slot_id];
+			->local_cert_chain_provision_size[slot_id];
 
-	status = spdm_append_message_k(session_info, request, request_size);
+	status = spdm_append_message_k(spdm_context, session_info, FALSE,
+				       request, request_size);
 	if (RETURN_ERROR(status)) {
 		spdm_free_session_id(spdm_context, session_id);
 		spdm_generate_error_response(spdm_context,
@@ -280,7 +287,8 @@ return_status spdm_get_response_key_exchange(IN void *context,
 		return RETURN_SUCCESS;
 	}
 
-	status = spdm_append_message_k(session_info, spdm_response,
+	status = spdm_append_message_k(spdm_context, session_info, FALSE,
+				       spdm_response,
 				       (uintn)ptr - (uintn)spdm_response);
 	if (RETURN_ERROR(status)) {
 		spdm_free_session_id(spdm_context, session_id);
@@ -299,7 +307,8 @@ return_status spdm_get_response_key_exchange(IN void *context,
 		return RETURN_SUCCESS;
 	}
 
-	status = spdm_append_message_k(session_info, ptr, signature_size);
+	status = spdm_append_message_k(spdm_context, session_info, FALSE,
+				       ptr, signature_size);
 	if (RETURN_ERROR(status)) {
 		spdm_free_session_id(spdm_context, session_id);
 		spdm_generate_error_response(spdm_context,
@@ -345,7 +354,8 @@ return_status spdm_get_response_key_exchange(IN void *context,
 				0, response_size, response);
 			return RETURN_SUCCESS;
 		}
-		status = spdm_append_message_k(session_info, ptr, hmac_size);
+		status = spdm_append_message_k(spdm_context, session_info,
+					       FALSE, ptr, hmac_size);
 		if (RETURN_ERROR(status)) {
 			spdm_free_session_id(spdm_context, session_id);
 			spdm_generate_error_response(
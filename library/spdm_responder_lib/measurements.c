@@ -29,7 +29,7 @@ boolean spdm_create_measurement_signature(IN spdm_context_t *spdm_context,
 		spdm_context->connection_info.algorithm.base_asym_algo);
 	measurment_sig_size =
 		SPDM_NONCE_SIZE + sizeof(uint16) +
-		spdm_context->local_context.opaque_measurement_rsp_size +
+		spdm_context->local_context->opaque_measurement_rsp_size +
 		signature_size;
 	ASSERT(response_message_size > measurment_sig_size);
 	ptr = (void *)((uint8 *)response_message + response_message_size -
@@ -39,11 +39,11 @@ boolean spdm_create_measurement_signature(IN spdm_context_t *spdm_context,
 	ptr += SPDM_NONCE_SIZE;
 
 	*(uint16 *)ptr =
-		(uint16)spdm_context->local_context.opaque_measurement_rsp_size;
+		(uint16)spdm_context->local_context->opaque_measurement_rsp_size;
 	ptr += sizeof(uint16);
-	copy_mem(ptr, spdm_context->local_context.opaque_measurement_rsp,
-		 spdm_context->local_context.opaque_measurement_rsp_size);
-	ptr += spdm_context->local_context.opaque_measurement_rsp_size;
+	copy_mem(ptr, spdm_context->local_context->opaque_measurement_rsp,
+		 spdm_context->local_context->opaque_measurement_rsp_size);
+	ptr += spdm_context->local_context->opaque_measurement_rsp_size;
 
 	status = spdm_append_message_m(spdm_context, response_message,
 				       response_message_size - signature_size);
@@ -71,7 +71,7 @@ void spdm_create_measurement_opaque(IN spdm_context_t *spdm_context,
 
 	measurment_no_sig_size =
 		SPDM_NONCE_SIZE + sizeof(uint16) +
-		spdm_context->local_context.opaque_measurement_rsp_size;
+		spdm_context->local_context->opaque_measurement_rsp_size;
 	ASSERT(response_message_size > measurment_no_sig_size);
 	ptr = (void *)((uint8 *)response_message + response_message_size -
 		       measurment_no_sig_size);
@@ -80,11 +80,11 @@ void spdm_create_measurement_opaque(IN spdm_context_t *spdm_context,
 	ptr += SPDM_NONCE_SIZE;
 	
 	*(uint16 *)ptr =
-		(uint16)spdm_context->local_context.opaque_measurement_rsp_size;
+		(uint16)spdm_context->local_context->opaque_measurement_rsp_size;
 	ptr += sizeof(uint16);
-	copy_mem(ptr, spdm_context->local_context.opaque_measurement_rsp,
-		 spdm_context->local_context.opaque_measurement_rsp_size);
-	ptr += spdm_context->local_context.opaque_measurement_rsp_size;
+	copy_mem(ptr, spdm_context->local_context->opaque_measurement_rsp,
+		 spdm_context->local_context->opaque_measurement_rsp_size);
+	ptr += spdm_context->local_context->opaque_measurement_rsp_size;
 
 	return;
 }
@@ -256,11 +256,11 @@ return_status spdm_get_response_measurements(IN void *context,
 		spdm_context->connection_info.algorithm.base_asym_algo);
 	measurment_sig_size =
 		SPDM_NONCE_SIZE + sizeof(uint16) +
-		spdm_context->local_context.opaque_measurement_rsp_size +
+		spdm_context->local_context->opaque_measurement_rsp_size +
 		signature_size;
 	measurment_no_sig_size =
 		SPDM_NONCE_SIZE + sizeof(uint16) +
-		spdm_context->local_context.opaque_measurement_rsp_size;
+		spdm_context->local_context->opaque_measurement_rsp_size;
 
 	switch (spdm_request->header.param2) {
 	case SPDM_GET_MEASUREMENTS_REQUEST_MEASUREMENT_OPERATION_TOTAL_NUMBER_OF_MEASUREMENTS:
@@ -300,7 +300,7 @@ return_status spdm_get_response_measurements(IN void *context,
 				slot_id_param = spdm_request->SlotIDParam;
 				if ((slot_id_param != 0xF) &&
 				    (slot_id_param >=
-				     spdm_context->local_context.slot_count)) {
+				     spdm_context->local_context->slot_count)) {
 					spdm_generate_error_response(
 						spdm_context,
 						SPDM_ERROR_CODE_INVALID_REQUEST,
@@ -386,7 +386,7 @@ return_status spdm_get_response_measurements(IN void *context,
 				slot_id_param = spdm_request->SlotIDParam;
 				if ((slot_id_param != 0xF) &&
 				    (slot_id_param >=
-				     spdm_context->local_context.slot_count)) {
+				     spdm_context->local_context->slot_count)) {
 					spdm_generate_error_response(
 						spdm_context,
 						SPDM_ERROR_CODE_INVALID_REQUEST,
@@ -471,7 +471,7 @@ return_status spdm_get_response_measurements(IN void *context,
 					if ((slot_id_param != 0xF) &&
 					    (slot_id_param >=
 					     spdm_context->local_context
-						     .slot_count)) {
+						     ->slot_count)) {
 						spdm_generate_error_response(
 							spdm_context,
 							SPDM_ERROR_CODE_INVALID_REQUEST,
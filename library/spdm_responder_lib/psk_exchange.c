@@ -139,7 +139,7 @@ return_status spdm_get_response_psk_exchange(IN void *context,
 	}
 
 	slot_id = spdm_request->header.param2;
-	if (slot_id >= spdm_context->local_context.slot_count) {
+	if (slot_id >= spdm_context->local_context->slot_count) {
 		spdm_generate_error_response(spdm_context,
 					     SPDM_ERROR_CODE_INVALID_REQUEST, 0,
 					     response_size, response);
@@ -254,7 +254,8 @@ return_status spdm_get_response_psk_exchange(IN void *context,
 	ptr += opaque_psk_exchange_rsp_size;
 
 
-	status = spdm_append_message_k(session_info, request, request_size);
+	status = spdm_append_message_k(spdm_context, session_info, FALSE,
+				       request, request_size);
 	if (RETURN_ERROR(status)) {
 		spdm_free_session_id(spdm_context, session_id);
 		spdm_generate_error_response(spdm_context,
@@ -263,7 +264,8 @@ return_status spdm_get_response_psk_exchange(IN void *context,
 		return RETURN_SUCCESS;
 	}
 	
-	status = spdm_append_message_k(session_info, spdm_response,
+	status = spdm_append_message_k(spdm_context, session_info, FALSE,
+				       spdm_response,
 				       (uintn)ptr - (uintn)spdm_response);
 	if (RETURN_ERROR(status)) {
 		spdm_free_session_id(spdm_context, session_id);
@@ -303,7 +305,8 @@ return_status spdm_get_response_psk_exchange(IN void *context,
 			0, response_size, response);
 		return RETURN_SUCCESS;
 	}
-	status = spdm_append_message_k(session_info, ptr, hmac_size);
+	status = spdm_append_message_k(spdm_context, session_info, FALSE,
+				       ptr, hmac_size);
 	if (RETURN_ERROR(status)) {
 		spdm_free_session_id(spdm_context, session_id);
 		spdm_generate_error_response(spdm_context,
@@ -90,6 +90,7 @@ spdm_get_response_func_via_last_request(IN spdm_context_t *spdm_context)
 
   @retval RETURN_SUCCESS               The SPDM request is received successfully.
   @retval RETURN_DEVICE_ERROR          A device error occurs when the SPDM request is received from the device.
+  @retval RETURN_OUT_OF_RESOURCES      No arena is registered while OPENSPDM_ARENA_MANAGED_BUFFER_SUPPORT is 1.
 **/
 return_status spdm_process_request(IN void *context, OUT uint32 **session_id,
 				   OUT boolean *is_app_message,
@@ -108,13 +109,24 @@ return_status spdm_process_request(IN void *context, OUT uint32 **session_id,
 	if (request_size == 0) {
 		return RETURN_INVALID_PARAMETER;
 	}
+#if OPENSPDM_ARENA_MANAGED_BUFFER_SUPPORT == 1
+	if (spdm_context->arena.allocate_func == NULL) {
+		DEBUG((DEBUG_ERROR,
+		       "spdm_process_request - no arena registered by spdm_register_arena_func\n"));
+		return RETURN_OUT_OF_RESOURCES;
+	}
+	status = spdm_allocate_arena_request_buffer(
+		&spdm_context->arena, &spdm_context->last_spdm_request);
+	if (RETURN_ERROR(status)) {
+		return status;
+	}
+#endif
 
 	DEBUG((DEBUG_INFO, "SpdmReceiveRequest[.] ...\n"));
 
 	message_session_id = NULL;
 	spdm_context->last_spdm_request_session_id_valid = FALSE;
-	spdm_context->last_spdm_request_size =
-		sizeof(spdm_context->last_spdm_request);
+	spdm_context->last_spdm_request_size = MAX_SPDM_MESSAGE_BUFFER_SIZE;
 	status = spdm_context->transport_decode_message(
 		spdm_context, &message_session_id, is_app_message, TRUE,
 		request_size, request, &spdm_context->last_spdm_request_size,
@@ -153,8 +165,10 @@ return_status spdm_process_request(IN void *context, OUT uint32 **session_id,
 	DEBUG((DEBUG_INFO, "SpdmReceiveRequest[%x] (0x%x): \n",
 	       (message_session_id != NULL) ? *message_session_id : 0,
 	       spdm_context->last_spdm_request_size));
-	internal_dump_hex((uint8 *)spdm_context->last_spdm_request,
-			  spdm_context->last_spdm_request_size);
+	spdm_trace_message(spdm_context, SPDM_TRACE_EVENT_REQUEST_RECEIVED,
+			   message_session_id, *is_app_message,
+			   spdm_context->last_spdm_request,
+			   spdm_context->last_spdm_request_size);
 
 	return RETURN_SUCCESS;
 }
@@ -252,6 +266,73 @@ void spdm_set_connection_state(IN spdm_context_t *spdm_context,
 	}
 }
 
+#if OPENSPDM_RESPONDER_STATISTICS_SUPPORT == 1
+/**
+  Return the error response counter index of an SPDM error code.
+
+  @param  error_code                    The SPDM error code.
+
+  @return The index in error_response_count.
+**/
+uintn spdm_get_statistics_error_code_index(IN uint8 error_code)
+{
+	if (error_code < 0x10) {
+		return error_code;
+	}
+	if ((error_code >= SPDM_ERROR_CODE_MAJOR_VERSION_MISMATCH) &&
+	    (error_code <= SPDM_ERROR_CODE_REQUEST_RESYNCH)) {
+		return 0x10 + error_code -
+		       SPDM_ERROR_CODE_MAJOR_VERSION_MISMATCH;
+	}
+	return SPDM_STATISTICS_ERROR_CODE_INDEX_OTHER;
+}
+
+/**
+  Record the statistics of a handled request.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  request_code                  The request code of the handled request.
+  @param  spdm_response                 The response generated for the request.
+  @param  handler_time                  The time spent in the handler, including the signing.
+  @param  encode_time                   The time spent in the transport encode.
+**/
+void spdm_record_request_statistics(IN spdm_context_t *spdm_context,
+				    IN uint8 request_code,
+				    IN spdm_message_header_t *spdm_response,
+				    IN uint64 handler_time,
+				    IN uint64 encode_time)
+{
+	spdm_responder_request_statistics_t *request_statistics;
+	uint64 sign_time;
+
+	request_statistics =
+		&spdm_context->responder_statistics.request
+			 [spdm_get_statistics_request_code_index(request_code)];
+	request_statistics->invocation_count++;
+	if (spdm_response->request_response_code == SPDM_ERROR) {
+		request_statistics->error_response_count
+			[spdm_get_statistics_error_code_index(
+				spdm_response->param1)]++;
+	}
+
+	if (spdm_context->get_timestamp_func == 0) {
+		return;
+	}
+	sign_time = spdm_context->statistics_sign_time;
+	if (sign_time > handler_time) {
+		sign_time = handler_time;
+	}
+	spdm_statistics_record_time(&request_statistics->handler_time,
+				    handler_time - sign_time);
+	if (spdm_context->statistics_sign_count != 0) {
+		spdm_statistics_record_time(&request_statistics->sign_time,
+					    sign_time);
+	}
+	spdm_statistics_record_time(&request_statistics->encode_time,
+				    encode_time);
+}
+#endif
+
 /**
   Build a SPDM response to a device.
 
@@ -281,6 +362,10 @@ return_status spdm_build_response(IN void *context, IN uint32 *session_id,
 	spdm_session_info_t *session_info;
 	spdm_message_header_t *spdm_request;
 	spdm_message_header_t *spdm_response;
+#if OPENSPDM_RESPONDER_STATISTICS_SUPPORT == 1
+	uint64 handler_time;
+	uint64 encode_time;
+#endif
 
 	spdm_context = context;
 
@@ -313,7 +398,9 @@ return_status spdm_build_response(IN void *context, IN uint32 *session_id,
 		DEBUG((DEBUG_INFO, "SpdmSendResponse[%x] (0x%x): \n",
 		       (session_id != NULL) ? *session_id : 0,
 		       my_response_size));
-		internal_dump_hex(my_response, my_response_size);
+		spdm_trace_message(spdm_context, SPDM_TRACE_EVENT_RESPONSE_SENT,
+				   session_id, FALSE, my_response,
+				   my_response_size);
 
 		status = spdm_context->transport_encode_message(
 			spdm_context, session_id, FALSE, FALSE,
@@ -358,6 +445,11 @@ return_status spdm_build_response(IN void *context, IN uint32 *session_id,
 
 	my_response_size = sizeof(my_response);
 	zero_mem(my_response, sizeof(my_response));
+#if OPENSPDM_RESPONDER_STATISTICS_SUPPORT == 1
+	spdm_context->statistics_sign_time = 0;
+	spdm_context->statistics_sign_count = 0;
+	handler_time = spdm_statistics_get_timestamp(spdm_context);
+#endif
 	get_response_func = NULL;
 	if (!is_app_message) {
 		get_response_func =
@@ -388,14 +480,30 @@ return_status spdm_build_response(IN void *context, IN uint32 *session_id,
 			spdm_request->request_response_code, &my_response_size,
 			my_response);
 	}
+#if OPENSPDM_RESPONDER_STATISTICS_SUPPORT == 1
+	handler_time = spdm_statistics_get_timestamp(spdm_context) - handler_time;
+#endif
 
 	DEBUG((DEBUG_INFO, "SpdmSendResponse[%x] (0x%x): \n",
 	       (session_id != NULL) ? *session_id : 0, my_response_size));
-	internal_dump_hex(my_response, my_response_size);
+	spdm_trace_message(spdm_context, SPDM_TRACE_EVENT_RESPONSE_SENT,
+			   session_id, is_app_message, my_response,
+			   my_response_size);
 
+#if OPENSPDM_RESPONDER_STATISTICS_SUPPORT == 1
+	encode_time = spdm_statistics_get_timestamp(spdm_context);
+#endif
 	status = spdm_context->transport_encode_message(
 		spdm_context, session_id, is_app_message, FALSE,
 		my_response_size, my_response, response_size, response);
+#if OPENSPDM_RESPONDER_STATISTICS_SUPPORT == 1
+	encode_time = spdm_statistics_get_timestamp(spdm_context) - encode_time;
+	if (!is_app_message) {
+		spdm_record_request_statistics(
+			spdm_context, spdm_request->request_response_code,
+			(void *)my_response, handler_time, encode_time);
+	}
+#endif
 	if (RETURN_ERROR(status)) {
 		DEBUG((DEBUG_INFO, "transport_encode_message : %p\n", status));
 		return status;
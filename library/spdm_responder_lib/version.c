@@ -81,9 +81,9 @@ return_status spdm_get_response_version(IN void *context, IN uintn request_size,
 	//
 	// Cache
 	//
-	reset_managed_buffer(&spdm_context->transcript.message_a);
-	reset_managed_buffer(&spdm_context->transcript.message_b);
-	reset_managed_buffer(&spdm_context->transcript.message_c);
+	spdm_reset_message_a(spdm_context);
+	spdm_reset_message_b(spdm_context);
+	spdm_reset_message_c(spdm_context);
 	status = spdm_append_message_a(spdm_context, spdm_request,
 				       spdm_request_size);
 	if (RETURN_ERROR(status)) {
@@ -98,7 +98,7 @@ return_status spdm_get_response_version(IN void *context, IN uintn request_size,
 	ASSERT(*response_size >= sizeof(spdm_version_response_mine_t));
 	*response_size =
 		sizeof(spdm_version_response) +
-		spdm_context->local_context.version.spdm_version_count *
+		spdm_context->local_context->version.spdm_version_count *
 			sizeof(spdm_version_number_t);
 	zero_mem(response, *response_size);
 	spdm_response = response;
@@ -108,12 +108,12 @@ return_status spdm_get_response_version(IN void *context, IN uintn request_size,
 	spdm_response->header.param1 = 0;
 	spdm_response->header.param2 = 0;
 	spdm_response->version_number_entry_count =
-		spdm_context->local_context.version.spdm_version_count;
+		spdm_context->local_context->version.spdm_version_count;
 	copy_mem(
 		spdm_response->version_number_entry,
-		spdm_context->local_context.version.spdm_version,
+		spdm_context->local_context->version.spdm_version,
 		sizeof(spdm_version_number_t) *
-			spdm_context->local_context.version.spdm_version_count);
+			spdm_context->local_context->version.spdm_version_count);
 
 	//
 	// Cache
@@ -129,12 +129,12 @@ return_status spdm_get_response_version(IN void *context, IN uintn request_size,
 	}
 
 	spdm_context->connection_info.version.spdm_version_count =
-		spdm_context->local_context.version.spdm_version_count;
+		spdm_context->local_context->version.spdm_version_count;
 	copy_mem(
 		spdm_context->connection_info.version.spdm_version,
-		spdm_context->local_context.version.spdm_version,
+		spdm_context->local_context->version.spdm_version,
 		sizeof(spdm_version_number_t) *
-			spdm_context->local_context.version.spdm_version_count);
+			spdm_context->local_context->version.spdm_version_count);
 
 	spdm_set_connection_state(spdm_context,
 				  SPDM_CONNECTION_STATE_AFTER_VERSION);
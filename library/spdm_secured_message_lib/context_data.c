@@ -28,12 +28,155 @@ void spdm_secured_message_init_context(IN void *spdm_secured_message_context)
 	spdm_secured_message_context_t *secured_message_context;
 
 	secured_message_context = spdm_secured_message_context;
-	zero_mem(secured_message_context,
-		 sizeof(spdm_secured_message_context_t));
+	zero_mem_secure(secured_message_context,
+			sizeof(spdm_secured_message_context_t));
 
 	random_seed(NULL, 0);
 }
 
+/**
+  Return the keyed AEAD context for one direction of the current session phase.
+
+  The AEAD context is created from the encryption key on first use and kept
+  until the key changes.
+
+  @param  secured_message_context        A pointer to the SPDM secured message context.
+  @param  aead_context                   A pointer to the AEAD context slot.
+  @param  key                          Pointer to the encryption key of this slot.
+
+  @return the keyed AEAD context, or NULL if it cannot be created.
+**/
+void *spdm_secured_message_get_aead_context(
+	IN spdm_secured_message_context_t *secured_message_context,
+	IN OUT void **aead_context, IN const uint8 *key)
+{
+	if (*aead_context == NULL) {
+		*aead_context = spdm_aead_new(
+			secured_message_context->aead_cipher_suite, key,
+			secured_message_context->aead_key_size);
+	}
+	return *aead_context;
+}
+
+/**
+  Release the keyed AEAD context in one slot, so it is rebuilt from the new key.
+
+  @param  secured_message_context        A pointer to the SPDM secured message context.
+  @param  aead_context                   A pointer to the AEAD context slot.
+**/
+void spdm_secured_message_release_aead_context(
+	IN spdm_secured_message_context_t *secured_message_context,
+	IN OUT void **aead_context)
+{
+	if (*aead_context != NULL) {
+		spdm_aead_free(secured_message_context->aead_cipher_suite,
+			       *aead_context);
+		*aead_context = NULL;
+	}
+}
+
+/**
+  Return the HMAC context keyed with one finished_key.
+
+  The keyed HMAC context is created on first use and kept until the key changes.
+
+  @param  secured_message_context        A pointer to the SPDM secured message context.
+  @param  hmac_context                   A pointer to the keyed HMAC context slot.
+  @param  key                          Pointer to the HMAC key of this slot.
+
+  @return the keyed HMAC context, or NULL if it cannot be created.
+**/
+void *spdm_secured_message_get_hmac_context(
+	IN spdm_secured_message_context_t *secured_message_context,
+	IN OUT void **hmac_context, IN const uint8 *key)
+{
+	if (*hmac_context == NULL) {
+		*hmac_context = spdm_hmac_new_with_key(
+			secured_message_context->base_hash_algo, key,
+			secured_message_context->hash_size);
+	}
+	return *hmac_context;
+}
+
+/**
+  Release the keyed HMAC context in one slot, so it is rebuilt from the new key.
+
+  @param  secured_message_context        A pointer to the SPDM secured message context.
+  @param  hmac_context                   A pointer to the keyed HMAC context slot.
+**/
+void spdm_secured_message_release_hmac_context(
+	IN spdm_secured_message_context_t *secured_message_context,
+	IN OUT void **hmac_context)
+{
+	if (*hmac_context != NULL) {
+		spdm_hmac_free_with_key(secured_message_context->base_hash_algo,
+					*hmac_context);
+		*hmac_context = NULL;
+	}
+}
+
+/**
+  Release the keyed AEAD contexts held by an SPDM secured message context.
+
+  It must be called before the SPDM secured message context is initialized again or discarded.
+
+  @param  spdm_secured_message_context    A pointer to the SPDM secured message context.
+*/
+void spdm_secured_message_free_aead_context(
+	IN void *spdm_secured_message_context)
+{
+	spdm_secured_message_context_t *secured_message_context;
+
+	secured_message_context = spdm_secured_message_context;
+	spdm_secured_message_release_aead_context(
+		secured_message_context,
+		&secured_message_context->handshake_secret
+			 .request_handshake_aead_context);
+	spdm_secured_message_release_aead_context(
+		secured_message_context,
+		&secured_message_context->handshake_secret
+			 .response_handshake_aead_context);
+	spdm_secured_message_release_aead_context(
+		secured_message_context,
+		&secured_message_context->application_secret
+			 .request_data_aead_context);
+	spdm_secured_message_release_aead_context(
+		secured_message_context,
+		&secured_message_context->application_secret
+			 .response_data_aead_context);
+	spdm_secured_message_release_aead_context(
+		secured_message_context,
+		&secured_message_context->application_secret_backup
+			 .request_data_aead_context);
+	spdm_secured_message_release_aead_context(
+		secured_message_context,
+		&secured_message_context->application_secret_backup
+			 .response_data_aead_context);
+}
+
+/**
+  Release the keyed HMAC contexts held by an SPDM secured message context.
+
+  It must be called before the SPDM secured message context is initialized again or discarded.
+
+  @param  spdm_secured_message_context    A pointer to the SPDM secured message context.
+*/
+void spdm_secured_message_free_hmac_context(
+	IN void *spdm_secured_message_context)
+{
+	spdm_secured_message_context_t *secured_message_context;
+
+	secured_message_context = spdm_secured_message_context;
+	spdm_secured_message_release_hmac_context(
+		secured_message_context,
+		&secured_message_context->handshake_secret
+			 .request_finished_key_hmac_context);
+	spdm_secured_message_release_hmac_context(
+		secured_message_context,
+		&secured_message_context->handshake_secret
+			 .response_finished_key_hmac_context);
+}
+
 /**
   Set use_psk to an SPDM secured message context.
 
@@ -63,6 +206,22 @@ void spdm_secured_message_set_session_state(
 
 	secured_message_context = spdm_secured_message_context;
 	secured_message_context->session_state = session_state;
+
+	if (session_state == SPDM_SESSION_STATE_ESTABLISHED) {
+		//
+		// Handshake keys are not used any more.
+		//
+		spdm_secured_message_release_aead_context(
+			secured_message_context,
+			&secured_message_context->handshake_secret
+				 .request_handshake_aead_context);
+		spdm_secured_message_release_aead_context(
+			secured_message_context,
+			&secured_message_context->handshake_secret
+				 .response_handshake_aead_context);
+		spdm_secured_message_free_hmac_context(
+			secured_message_context);
+	}
 }
 
 /**
@@ -310,6 +469,15 @@ spdm_secured_message_import_session_keys(IN void *spdm_secured_message_context,
 		return RETURN_INVALID_PARAMETER;
 	}
 
+	spdm_secured_message_release_aead_context(
+		secured_message_context,
+		&secured_message_context->application_secret
+			 .request_data_aead_context);
+	spdm_secured_message_release_aead_context(
+		secured_message_context,
+		&secured_message_context->application_secret
+			 .response_data_aead_context);
+
 	ptr = (void *)(session_keys_struct + 1);
 	copy_mem(secured_message_context->application_secret
 			 .request_data_encryption_key,
@@ -7,173 +7,232 @@
 #include "spdm_secured_message_lib_internal.h"
 
 /**
-  Encode an application message to a secured message.
+  Return the size in bytes in front of the application message in a secured message.
+
+  It covers the record header and, for an encrypted session, the cipher header.
 
   @param  spdm_secured_message_context    A pointer to the SPDM secured message context.
-  @param  session_id                    The session ID of the SPDM session.
-  @param  is_requester                  Indicates if it is a requester message.
-  @param  app_message_size               size in bytes of the application message data buffer.
-  @param  app_message                   A pointer to a source buffer to store the application message.
-  @param  secured_message_size           size in bytes of the secured message data buffer.
-  @param  secured_message               A pointer to a destination buffer to store the secured message.
   @param  spdm_secured_message_callbacks_t  A pointer to a secured message callback functions structure.
 
-  @retval RETURN_SUCCESS               The application message is encoded successfully.
-  @retval RETURN_INVALID_PARAMETER     The message is NULL or the message_size is zero.
+  @return the headroom in bytes of the secured message.
 **/
-return_status spdm_encode_secured_message(
-	IN void *spdm_secured_message_context, IN uint32 session_id,
-	IN boolean is_requester, IN uintn app_message_size,
-	IN void *app_message, IN OUT uintn *secured_message_size,
-	OUT void *secured_message,
+uintn spdm_secured_message_get_headroom(
+	IN void *spdm_secured_message_context,
 	IN spdm_secured_message_callbacks_t *spdm_secured_message_callbacks_t)
 {
 	spdm_secured_message_context_t *secured_message_context;
-	uintn total_secured_message_size;
-	uintn plain_text_size;
-	uintn cipher_text_size;
-	uintn aead_pad_size;
-	uintn aead_tag_size;
-	uintn aead_key_size;
-	uintn aead_iv_size;
-	uint8 *a_data;
-	uint8 *enc_msg;
-	uint8 *dec_msg;
-	uint8 *tag;
-	spdm_secured_message_a_data_header1_t *record_header1;
-	spdm_secured_message_a_data_header2_t *record_header2;
-	uintn record_header_size;
-	spdm_secured_message_cipher_header_t *enc_msg_header;
-	boolean result;
-	uint8 key[MAX_AEAD_KEY_SIZE];
-	uint8 salt[MAX_AEAD_IV_SIZE];
-	uint64 sequence_number;
 	uint64 sequence_num_in_header;
 	uint8 sequence_num_in_header_size;
-	spdm_session_type_t session_type;
-	uint32 rand_count;
-	uint32 max_rand_count;
-	spdm_session_state_t session_state;
+	uintn headroom;
 
 	secured_message_context = spdm_secured_message_context;
 
-	session_type = secured_message_context->session_type;
-	ASSERT((session_type == SPDM_SESSION_TYPE_MAC_ONLY) ||
-	       (session_type == SPDM_SESSION_TYPE_ENC_MAC));
-	session_state = secured_message_context->session_state;
-	ASSERT((session_state == SPDM_SESSION_STATE_HANDSHAKING) ||
-	       (session_state == SPDM_SESSION_STATE_ESTABLISHED));
+	sequence_num_in_header = 0;
+	sequence_num_in_header_size =
+		spdm_secured_message_callbacks_t->get_sequence_number(
+			0, (uint8 *)&sequence_num_in_header);
+	headroom = sizeof(spdm_secured_message_a_data_header1_t) +
+		   sequence_num_in_header_size +
+		   sizeof(spdm_secured_message_a_data_header2_t);
+	if (secured_message_context->session_type ==
+	    SPDM_SESSION_TYPE_ENC_MAC) {
+		headroom += sizeof(spdm_secured_message_cipher_header_t);
+	}
+	return headroom;
+}
+
+/**
+  Return the maximum size in bytes behind the application message in a secured message.
 
-	aead_tag_size = secured_message_context->aead_tag_size;
-	aead_key_size = secured_message_context->aead_key_size;
-	aead_iv_size = secured_message_context->aead_iv_size;
+  It covers the random padding of an encrypted session and the AEAD tag.
 
-	switch (session_state) {
+  @param  spdm_secured_message_context    A pointer to the SPDM secured message context.
+  @param  spdm_secured_message_callbacks_t  A pointer to a secured message callback functions structure.
+
+  @return the tailroom in bytes of the secured message.
+**/
+uintn spdm_secured_message_get_tailroom(
+	IN void *spdm_secured_message_context,
+	IN spdm_secured_message_callbacks_t *spdm_secured_message_callbacks_t)
+{
+	spdm_secured_message_context_t *secured_message_context;
+	uintn tailroom;
+
+	secured_message_context = spdm_secured_message_context;
+
+	tailroom = secured_message_context->aead_tag_size;
+	if (secured_message_context->session_type ==
+	    SPDM_SESSION_TYPE_ENC_MAC) {
+		tailroom += spdm_secured_message_callbacks_t
+				    ->get_max_random_number_count();
+	}
+	return tailroom;
+}
+
+/**
+  Get the keyed AEAD context, the salt and the sequence number of the current session key.
+
+  The key is selected by the session state and the message direction.
+
+  @param  secured_message_context        A pointer to the SPDM secured message context.
+  @param  is_requester                  Indicates if it is a requester message.
+  @param  salt                         A pointer to a destination buffer to store the salt of the key.
+  @param  sequence_number               On output, a pointer to the sequence number of the key.
+  @param  aead_context                   On output, the keyed AEAD context of the key.
+
+  @retval RETURN_SUCCESS               The session key is ready.
+  @retval RETURN_OUT_OF_RESOURCES      The AEAD context cannot be created.
+  @retval RETURN_UNSUPPORTED           The session state is unsupported.
+**/
+static return_status internal_spdm_secured_message_get_record_key(
+	IN spdm_secured_message_context_t *secured_message_context,
+	IN boolean is_requester, OUT uint8 *salt,
+	OUT uint64 **sequence_number, OUT void **aead_context)
+{
+	uint8 *key;
+	void **aead_context_slot;
+
+	switch (secured_message_context->session_state) {
 	case SPDM_SESSION_STATE_HANDSHAKING:
 		if (is_requester) {
-			copy_mem(key,
-				 secured_message_context->handshake_secret
-					 .request_handshake_encryption_key,
-				 secured_message_context->aead_key_size);
+			key = secured_message_context->handshake_secret
+				      .request_handshake_encryption_key;
 			copy_mem(salt,
 				 secured_message_context->handshake_secret
 					 .request_handshake_salt,
 				 secured_message_context->aead_iv_size);
-			sequence_number =
-				secured_message_context->handshake_secret
-					.request_handshake_sequence_number;
+			*sequence_number =
+				&secured_message_context->handshake_secret
+					 .request_handshake_sequence_number;
+			aead_context_slot =
+				&secured_message_context->handshake_secret
+					 .request_handshake_aead_context;
 		} else {
-			copy_mem(key,
-				 secured_message_context->handshake_secret
-					 .response_handshake_encryption_key,
-				 secured_message_context->aead_key_size);
+			key = secured_message_context->handshake_secret
+				      .response_handshake_encryption_key;
 			copy_mem(salt,
 				 secured_message_context->handshake_secret
 					 .response_handshake_salt,
 				 secured_message_context->aead_iv_size);
-			sequence_number =
-				secured_message_context->handshake_secret
-					.response_handshake_sequence_number;
+			*sequence_number =
+				&secured_message_context->handshake_secret
+					 .response_handshake_sequence_number;
+			aead_context_slot =
+				&secured_message_context->handshake_secret
+					 .response_handshake_aead_context;
 		}
 		break;
 	case SPDM_SESSION_STATE_ESTABLISHED:
 		if (is_requester) {
-			copy_mem(key,
-				 secured_message_context->application_secret
-					 .request_data_encryption_key,
-				 secured_message_context->aead_key_size);
+			key = secured_message_context->application_secret
+				      .request_data_encryption_key;
 			copy_mem(salt,
 				 secured_message_context->application_secret
 					 .request_data_salt,
 				 secured_message_context->aead_iv_size);
-			sequence_number =
-				secured_message_context->application_secret
-					.request_data_sequence_number;
+			*sequence_number =
+				&secured_message_context->application_secret
+					 .request_data_sequence_number;
+			aead_context_slot =
+				&secured_message_context->application_secret
+					 .request_data_aead_context;
 		} else {
-			copy_mem(key,
-				 secured_message_context->application_secret
-					 .response_data_encryption_key,
-				 secured_message_context->aead_key_size);
+			key = secured_message_context->application_secret
+				      .response_data_encryption_key;
 			copy_mem(salt,
 				 secured_message_context->application_secret
 					 .response_data_salt,
 				 secured_message_context->aead_iv_size);
-			sequence_number =
-				secured_message_context->application_secret
-					.response_data_sequence_number;
+			*sequence_number =
+				&secured_message_context->application_secret
+					 .response_data_sequence_number;
+			aead_context_slot =
+				&secured_message_context->application_secret
+					 .response_data_aead_context;
 		}
 		break;
 	default:
 		ASSERT(FALSE);
 		return RETURN_UNSUPPORTED;
-		break;
 	}
 
-	if (sequence_number == (uint64)-1) {
+	*aead_context = spdm_secured_message_get_aead_context(
+		secured_message_context, aead_context_slot, key);
+	if (*aead_context == NULL) {
 		return RETURN_OUT_OF_RESOURCES;
 	}
+	return RETURN_SUCCESS;
+}
 
-	*(uint64 *)salt = *(uint64 *)salt ^ sequence_number;
+/**
+  Encode one secured message record in place with a prepared session key.
+
+  @param  secured_message_context        A pointer to the SPDM secured message context.
+  @param  session_id                    The session ID of the SPDM session.
+  @param  aead_context                   The keyed AEAD context of the session key.
+  @param  salt                         The salt of the session key.
+  @param  sequence_number               The sequence number of the record. It is advanced on return.
+  @param  app_message_size               size in bytes of the application message in the buffer.
+  @param  secured_message_size           On input, size in bytes of the secured message buffer.
+                                       On output, size in bytes of the secured message.
+  @param  secured_message               A pointer to the buffer holding the application message at the headroom offset.
+  @param  spdm_secured_message_callbacks_t  A pointer to a secured message callback functions structure.
+
+  @retval RETURN_SUCCESS               The record is encoded successfully.
+  @retval RETURN_BUFFER_TOO_SMALL      The buffer is too small to hold the secured message.
+  @retval RETURN_OUT_OF_RESOURCES      The sequence number is exhausted or the encryption fails.
+**/
+static return_status internal_spdm_encode_secured_record(
+	IN spdm_secured_message_context_t *secured_message_context,
+	IN uint32 session_id, IN void *aead_context, IN uint8 *salt,
+	IN OUT uint64 *sequence_number, IN uintn app_message_size,
+	IN OUT uintn *secured_message_size, IN OUT void *secured_message,
+	IN spdm_secured_message_callbacks_t *spdm_secured_message_callbacks_t)
+{
+	uintn total_secured_message_size;
+	uintn plain_text_size;
+	uintn cipher_text_size;
+	uintn aead_pad_size;
+	uintn aead_tag_size;
+	uintn aead_iv_size;
+	uint8 *a_data;
+	uint8 *enc_msg;
+	uint8 *dec_msg;
+	uint8 *tag;
+	spdm_secured_message_a_data_header1_t *record_header1;
+	spdm_secured_message_a_data_header2_t *record_header2;
+	uintn record_header_size;
+	spdm_secured_message_cipher_header_t *enc_msg_header;
+	boolean result;
+	uint8 iv[MAX_AEAD_IV_SIZE];
+	uint64 sequence_num_in_header;
+	uint8 sequence_num_in_header_size;
+	uint32 rand_count;
+	uint32 max_rand_count;
+
+	aead_tag_size = secured_message_context->aead_tag_size;
+	aead_iv_size = secured_message_context->aead_iv_size;
+
+	if (*sequence_number == (uint64)-1) {
+		return RETURN_OUT_OF_RESOURCES;
+	}
+
+	copy_mem(iv, salt, aead_iv_size);
+	*(uint64 *)iv = *(uint64 *)iv ^ *sequence_number;
 
 	sequence_num_in_header = 0;
 	sequence_num_in_header_size =
 		spdm_secured_message_callbacks_t->get_sequence_number(
-			sequence_number, (uint8 *)&sequence_num_in_header);
+			*sequence_number, (uint8 *)&sequence_num_in_header);
 	ASSERT(sequence_num_in_header_size <= sizeof(sequence_num_in_header));
 
-	sequence_number++;
-	switch (session_state) {
-	case SPDM_SESSION_STATE_HANDSHAKING:
-		if (is_requester) {
-			secured_message_context->handshake_secret
-				.request_handshake_sequence_number =
-				sequence_number;
-		} else {
-			secured_message_context->handshake_secret
-				.response_handshake_sequence_number =
-				sequence_number;
-		}
-		break;
-	case SPDM_SESSION_STATE_ESTABLISHED:
-		if (is_requester) {
-			secured_message_context->application_secret
-				.request_data_sequence_number = sequence_number;
-		} else {
-			secured_message_context->application_secret
-				.response_data_sequence_number =
-				sequence_number;
-		}
-		break;
-	default:
-		ASSERT(FALSE);
-		return RETURN_UNSUPPORTED;
-	}
+	(*sequence_number)++;
 
 	record_header_size = sizeof(spdm_secured_message_a_data_header1_t) +
 			     sequence_num_in_header_size +
 			     sizeof(spdm_secured_message_a_data_header2_t);
 
-	switch (session_type) {
+	switch (secured_message_context->session_type) {
 	case SPDM_SESSION_TYPE_ENC_MAC:
 		max_rand_count = spdm_secured_message_callbacks_t
 					 ->get_max_random_number_count();
@@ -211,7 +270,6 @@ return_status spdm_encode_secured_message(
 		enc_msg_header = (void *)(record_header2 + 1);
 		enc_msg_header->application_data_length =
 			(uint16)app_message_size;
-		copy_mem(enc_msg_header + 1, app_message, app_message_size);
 		random_bytes(
 			(uint8 *)enc_msg_header +
 				sizeof(spdm_secured_message_cipher_header_t) +
@@ -226,9 +284,9 @@ return_status spdm_encode_secured_message(
 		tag = (uint8 *)record_header1 + record_header_size +
 		      cipher_text_size;
 
-		result = spdm_aead_encryption(
-			secured_message_context->aead_cipher_suite, key,
-			aead_key_size, salt, aead_iv_size, (uint8 *)a_data,
+		result = spdm_aead_encryption_with_context(
+			secured_message_context->aead_cipher_suite,
+			aead_context, iv, aead_iv_size, (uint8 *)a_data,
 			record_header_size, dec_msg, cipher_text_size, tag,
 			aead_tag_size, enc_msg, &cipher_text_size);
 		break;
@@ -253,14 +311,13 @@ return_status spdm_encode_secured_message(
 			 sequence_num_in_header_size);
 		record_header2->length =
 			(uint16)(app_message_size + aead_tag_size);
-		copy_mem(record_header2 + 1, app_message, app_message_size);
 		a_data = (uint8 *)record_header1;
 		tag = (uint8 *)record_header1 + record_header_size +
 		      app_message_size;
 
-		result = spdm_aead_encryption(
-			secured_message_context->aead_cipher_suite, key,
-			aead_key_size, salt, aead_iv_size, (uint8 *)a_data,
+		result = spdm_aead_encryption_with_context(
+			secured_message_context->aead_cipher_suite,
+			aead_context, iv, aead_iv_size, (uint8 *)a_data,
 			record_header_size + app_message_size, NULL, 0, tag,
 			aead_tag_size, NULL, NULL);
 		break;
@@ -276,33 +333,33 @@ return_status spdm_encode_secured_message(
 }
 
 /**
-  Decode an application message from a secured message.
+  Decode one secured message record in place with a prepared session key.
 
-  @param  spdm_secured_message_context    A pointer to the SPDM secured message context.
+  @param  secured_message_context        A pointer to the SPDM secured message context.
   @param  session_id                    The session ID of the SPDM session.
-  @param  is_requester                  Indicates if it is a requester message.
+  @param  aead_context                   The keyed AEAD context of the session key.
+  @param  salt                         The salt of the session key.
+  @param  sequence_number               The sequence number of the record. It is advanced on return.
   @param  secured_message_size           size in bytes of the secured message data buffer.
-  @param  secured_message               A pointer to a source buffer to store the secured message.
-  @param  app_message_size               size in bytes of the application message data buffer.
-  @param  app_message                   A pointer to a destination buffer to store the application message.
+  @param  secured_message               A pointer to the buffer holding the secured message.
+  @param  app_message_size               size in bytes of the application message.
+  @param  app_message                   A pointer to the application message inside the secured message buffer.
   @param  spdm_secured_message_callbacks_t  A pointer to a secured message callback functions structure.
 
-  @retval RETURN_SUCCESS               The application message is decoded successfully.
-  @retval RETURN_INVALID_PARAMETER     The message is NULL or the message_size is zero.
-  @retval RETURN_UNSUPPORTED           The secured_message is unsupported.
+  @retval RETURN_SUCCESS               The record is decoded successfully.
+  @retval RETURN_SECURITY_VIOLATION    The record fails verification.
 **/
-return_status spdm_decode_secured_message(
-	IN void *spdm_secured_message_context, IN uint32 session_id,
-	IN boolean is_requester, IN uintn secured_message_size,
-	IN void *secured_message, IN OUT uintn *app_message_size,
-	OUT void *app_message,
+static return_status internal_spdm_decode_secured_record(
+	IN spdm_secured_message_context_t *secured_message_context,
+	IN uint32 session_id, IN void *aead_context, IN uint8 *salt,
+	IN OUT uint64 *sequence_number, IN uintn secured_message_size,
+	IN OUT void *secured_message, OUT uintn *app_message_size,
+	OUT void **app_message,
 	IN spdm_secured_message_callbacks_t *spdm_secured_message_callbacks_t)
 {
-	spdm_secured_message_context_t *secured_message_context;
 	uintn plain_text_size;
 	uintn cipher_text_size;
 	uintn aead_tag_size;
-	uintn aead_key_size;
 	uintn aead_iv_size;
 	uint8 *a_data;
 	uint8 *enc_msg;
@@ -313,148 +370,43 @@ return_status spdm_decode_secured_message(
 	uintn record_header_size;
 	spdm_secured_message_cipher_header_t *enc_msg_header;
 	boolean result;
-	uint8 key[MAX_AEAD_KEY_SIZE];
-	uint8 salt[MAX_AEAD_IV_SIZE];
-	uint64 sequence_number;
+	uint8 iv[MAX_AEAD_IV_SIZE];
 	uint64 sequence_num_in_header;
 	uint8 sequence_num_in_header_size;
-	spdm_session_type_t session_type;
-	spdm_session_state_t session_state;
 	spdm_error_struct_t spdm_error;
-	uint8 dec_message[MAX_SPDM_MESSAGE_BUFFER_SIZE];
-
-	spdm_error.error_code = 0;
-	spdm_error.session_id = 0;
-	spdm_secured_message_set_last_spdm_error_struct(
-		spdm_secured_message_context, &spdm_error);
 
 	spdm_error.error_code = SPDM_ERROR_CODE_DECRYPT_ERROR;
 	spdm_error.session_id = session_id;
 
-	secured_message_context = spdm_secured_message_context;
-
-	session_type = secured_message_context->session_type;
-	ASSERT((session_type == SPDM_SESSION_TYPE_MAC_ONLY) ||
-	       (session_type == SPDM_SESSION_TYPE_ENC_MAC));
-	session_state = secured_message_context->session_state;
-	ASSERT((session_state == SPDM_SESSION_STATE_HANDSHAKING) ||
-	       (session_state == SPDM_SESSION_STATE_ESTABLISHED));
-
 	aead_tag_size = secured_message_context->aead_tag_size;
-	aead_key_size = secured_message_context->aead_key_size;
 	aead_iv_size = secured_message_context->aead_iv_size;
 
-	switch (session_state) {
-	case SPDM_SESSION_STATE_HANDSHAKING:
-		if (is_requester) {
-			copy_mem(key,
-				 secured_message_context->handshake_secret
-					 .request_handshake_encryption_key,
-				 secured_message_context->aead_key_size);
-			copy_mem(salt,
-				 secured_message_context->handshake_secret
-					 .request_handshake_salt,
-				 secured_message_context->aead_iv_size);
-			sequence_number =
-				secured_message_context->handshake_secret
-					.request_handshake_sequence_number;
-		} else {
-			copy_mem(key,
-				 secured_message_context->handshake_secret
-					 .response_handshake_encryption_key,
-				 secured_message_context->aead_key_size);
-			copy_mem(salt,
-				 secured_message_context->handshake_secret
-					 .response_handshake_salt,
-				 secured_message_context->aead_iv_size);
-			sequence_number =
-				secured_message_context->handshake_secret
-					.response_handshake_sequence_number;
-		}
-		break;
-	case SPDM_SESSION_STATE_ESTABLISHED:
-		if (is_requester) {
-			copy_mem(key,
-				 secured_message_context->application_secret
-					 .request_data_encryption_key,
-				 secured_message_context->aead_key_size);
-			copy_mem(salt,
-				 secured_message_context->application_secret
-					 .request_data_salt,
-				 secured_message_context->aead_iv_size);
-			sequence_number =
-				secured_message_context->application_secret
-					.request_data_sequence_number;
-		} else {
-			copy_mem(key,
-				 secured_message_context->application_secret
-					 .response_data_encryption_key,
-				 secured_message_context->aead_key_size);
-			copy_mem(salt,
-				 secured_message_context->application_secret
-					 .response_data_salt,
-				 secured_message_context->aead_iv_size);
-			sequence_number =
-				secured_message_context->application_secret
-					.response_data_sequence_number;
-		}
-		break;
-	default:
-		ASSERT(FALSE);
-		return RETURN_UNSUPPORTED;
-	}
-
-	if (sequence_number == (uint64)-1) {
+	if (*sequence_number == (uint64)-1) {
 		spdm_secured_message_set_last_spdm_error_struct(
-			spdm_secured_message_context, &spdm_error);
+			secured_message_context, &spdm_error);
 		return RETURN_SECURITY_VIOLATION;
 	}
 
-	*(uint64 *)salt = *(uint64 *)salt ^ sequence_number;
+	copy_mem(iv, salt, aead_iv_size);
+	*(uint64 *)iv = *(uint64 *)iv ^ *sequence_number;
 
 	sequence_num_in_header = 0;
 	sequence_num_in_header_size =
 		spdm_secured_message_callbacks_t->get_sequence_number(
-			sequence_number, (uint8 *)&sequence_num_in_header);
+			*sequence_number, (uint8 *)&sequence_num_in_header);
 	ASSERT(sequence_num_in_header_size <= sizeof(sequence_num_in_header));
 
-	sequence_number++;
-	switch (session_state) {
-	case SPDM_SESSION_STATE_HANDSHAKING:
-		if (is_requester) {
-			secured_message_context->handshake_secret
-				.request_handshake_sequence_number =
-				sequence_number;
-		} else {
-			secured_message_context->handshake_secret
-				.response_handshake_sequence_number =
-				sequence_number;
-		}
-		break;
-	case SPDM_SESSION_STATE_ESTABLISHED:
-		if (is_requester) {
-			secured_message_context->application_secret
-				.request_data_sequence_number = sequence_number;
-		} else {
-			secured_message_context->application_secret
-				.response_data_sequence_number =
-				sequence_number;
-		}
-		break;
-	default:
-		ASSERT(FALSE);
-		return RETURN_UNSUPPORTED;
-	}
+	(*sequence_number)++;
 
 	record_header_size = sizeof(spdm_secured_message_a_data_header1_t) +
 			     sequence_num_in_header_size +
 			     sizeof(spdm_secured_message_a_data_header2_t);
 
-	switch (session_type) {
+	switch (secured_message_context->session_type) {
 	case SPDM_SESSION_TYPE_ENC_MAC:
 		if (secured_message_size < record_header_size + aead_tag_size) {
 			spdm_secured_message_set_last_spdm_error_struct(
-				spdm_secured_message_context, &spdm_error);
+				secured_message_context, &spdm_error);
 			return RETURN_SECURITY_VIOLATION;
 		}
 		record_header1 = (void *)secured_message;
@@ -464,68 +416,59 @@ return_status spdm_decode_secured_message(
 				 sequence_num_in_header_size);
 		if (record_header1->session_id != session_id) {
 			spdm_secured_message_set_last_spdm_error_struct(
-				spdm_secured_message_context, &spdm_error);
+				secured_message_context, &spdm_error);
 			return RETURN_SECURITY_VIOLATION;
 		}
 		if (const_compare_mem(record_header1 + 1, &sequence_num_in_header,
 				sequence_num_in_header_size) != 0) {
 			spdm_secured_message_set_last_spdm_error_struct(
-				spdm_secured_message_context, &spdm_error);
+				secured_message_context, &spdm_error);
 			return RETURN_SECURITY_VIOLATION;
 		}
 		if (record_header2->length >
 		    secured_message_size - record_header_size) {
 			spdm_secured_message_set_last_spdm_error_struct(
-				spdm_secured_message_context, &spdm_error);
+				secured_message_context, &spdm_error);
 			return RETURN_SECURITY_VIOLATION;
 		}
 		if (record_header2->length < aead_tag_size) {
 			spdm_secured_message_set_last_spdm_error_struct(
-				spdm_secured_message_context, &spdm_error);
+				secured_message_context, &spdm_error);
 			return RETURN_SECURITY_VIOLATION;
 		}
 		cipher_text_size = (record_header2->length - aead_tag_size);
-		if (cipher_text_size > sizeof(dec_message)) {
-			return RETURN_OUT_OF_RESOURCES;
-		}
-		zero_mem(dec_message, sizeof(dec_message));
 		enc_msg_header = (void *)(record_header2 + 1);
 		a_data = (uint8 *)record_header1;
 		enc_msg = (uint8 *)enc_msg_header;
-		dec_msg = (uint8 *)dec_message;
-		enc_msg_header = (void *)dec_msg;
+		dec_msg = (uint8 *)enc_msg_header;
 		tag = (uint8 *)record_header1 + record_header_size +
 		      cipher_text_size;
-		result = spdm_aead_decryption(
-			secured_message_context->aead_cipher_suite, key,
-			aead_key_size, salt, aead_iv_size, (uint8 *)a_data,
+		result = spdm_aead_decryption_with_context(
+			secured_message_context->aead_cipher_suite,
+			aead_context, iv, aead_iv_size, (uint8 *)a_data,
 			record_header_size, enc_msg, cipher_text_size, tag,
 			aead_tag_size, dec_msg, &cipher_text_size);
 		if (!result) {
 			spdm_secured_message_set_last_spdm_error_struct(
-				spdm_secured_message_context, &spdm_error);
+				secured_message_context, &spdm_error);
 			return RETURN_SECURITY_VIOLATION;
 		}
 		plain_text_size = enc_msg_header->application_data_length;
-		if (plain_text_size > cipher_text_size) {
+		if (plain_text_size + sizeof(spdm_secured_message_cipher_header_t) >
+		    cipher_text_size) {
 			spdm_secured_message_set_last_spdm_error_struct(
-				spdm_secured_message_context, &spdm_error);
+				secured_message_context, &spdm_error);
 			return RETURN_SECURITY_VIOLATION;
 		}
 
-		ASSERT(*app_message_size >= plain_text_size);
-		if (*app_message_size < plain_text_size) {
-			*app_message_size = plain_text_size;
-			return RETURN_BUFFER_TOO_SMALL;
-		}
 		*app_message_size = plain_text_size;
-		copy_mem(app_message, enc_msg_header + 1, plain_text_size);
+		*app_message = enc_msg_header + 1;
 		break;
 
 	case SPDM_SESSION_TYPE_MAC_ONLY:
 		if (secured_message_size < record_header_size + aead_tag_size) {
 			spdm_secured_message_set_last_spdm_error_struct(
-				spdm_secured_message_context, &spdm_error);
+				secured_message_context, &spdm_error);
 			return RETURN_SECURITY_VIOLATION;
 		}
 		record_header1 = (void *)secured_message;
@@ -535,49 +478,44 @@ return_status spdm_decode_secured_message(
 				 sequence_num_in_header_size);
 		if (record_header1->session_id != session_id) {
 			spdm_secured_message_set_last_spdm_error_struct(
-				spdm_secured_message_context, &spdm_error);
+				secured_message_context, &spdm_error);
 			return RETURN_SECURITY_VIOLATION;
 		}
 		if (const_compare_mem(record_header1 + 1, &sequence_num_in_header,
 				sequence_num_in_header_size) != 0) {
 			spdm_secured_message_set_last_spdm_error_struct(
-				spdm_secured_message_context, &spdm_error);
+				secured_message_context, &spdm_error);
 			return RETURN_SECURITY_VIOLATION;
 		}
 		if (record_header2->length >
 		    secured_message_size - record_header_size) {
 			spdm_secured_message_set_last_spdm_error_struct(
-				spdm_secured_message_context, &spdm_error);
+				secured_message_context, &spdm_error);
 			return RETURN_SECURITY_VIOLATION;
 		}
 		if (record_header2->length < aead_tag_size) {
 			spdm_secured_message_set_last_spdm_error_struct(
-				spdm_secured_message_context, &spdm_error);
+				secured_message_context, &spdm_error);
 			return RETURN_SECURITY_VIOLATION;
 		}
 		a_data = (uint8 *)record_header1;
 		tag = (uint8 *)record_header1 + record_header_size +
 		      record_header2->length - aead_tag_size;
-		result = spdm_aead_decryption(
-			secured_message_context->aead_cipher_suite, key,
-			aead_key_size, salt, aead_iv_size, (uint8 *)a_data,
+		result = spdm_aead_decryption_with_context(
+			secured_message_context->aead_cipher_suite,
+			aead_context, iv, aead_iv_size, (uint8 *)a_data,
 			record_header_size + record_header2->length -
 				aead_tag_size,
 			NULL, 0, tag, aead_tag_size, NULL, NULL);
 		if (!result) {
 			spdm_secured_message_set_last_spdm_error_struct(
-				spdm_secured_message_context, &spdm_error);
+				secured_message_context, &spdm_error);
 			return RETURN_SECURITY_VIOLATION;
 		}
 
 		plain_text_size = record_header2->length - aead_tag_size;
-		ASSERT(*app_message_size >= plain_text_size);
-		if (*app_message_size < plain_text_size) {
-			*app_message_size = plain_text_size;
-			return RETURN_BUFFER_TOO_SMALL;
-		}
 		*app_message_size = plain_text_size;
-		copy_mem(app_message, record_header2 + 1, plain_text_size);
+		*app_message = record_header2 + 1;
 		break;
 
 	default:
@@ -587,3 +525,398 @@ return_status spdm_decode_secured_message(
 
 	return RETURN_SUCCESS;
 }
+
+/**
+  Encode an application message to a secured message.
+
+  @param  spdm_secured_message_context    A pointer to the SPDM secured message context.
+  @param  session_id                    The session ID of the SPDM session.
+  @param  is_requester                  Indicates if it is a requester message.
+  @param  app_message_size               size in bytes of the application message data buffer.
+  @param  app_message                   A pointer to a source buffer to store the application message.
+  @param  secured_message_size           size in bytes of the secured message data buffer.
+  @param  secured_message               A pointer to a destination buffer to store the secured message.
+  @param  spdm_secured_message_callbacks_t  A pointer to a secured message callback functions structure.
+
+  @retval RETURN_SUCCESS               The application message is encoded successfully.
+  @retval RETURN_INVALID_PARAMETER     The message is NULL or the message_size is zero.
+**/
+return_status spdm_encode_secured_message(
+	IN void *spdm_secured_message_context, IN uint32 session_id,
+	IN boolean is_requester, IN uintn app_message_size,
+	IN void *app_message, IN OUT uintn *secured_message_size,
+	OUT void *secured_message,
+	IN spdm_secured_message_callbacks_t *spdm_secured_message_callbacks_t)
+{
+	uintn headroom;
+	uintn tailroom;
+
+	headroom = spdm_secured_message_get_headroom(
+		spdm_secured_message_context, spdm_secured_message_callbacks_t);
+	tailroom = spdm_secured_message_get_tailroom(
+		spdm_secured_message_context, spdm_secured_message_callbacks_t);
+
+	ASSERT(*secured_message_size >= headroom + app_message_size);
+	if (*secured_message_size < headroom + app_message_size) {
+		*secured_message_size = headroom + app_message_size + tailroom;
+		return RETURN_BUFFER_TOO_SMALL;
+	}
+	copy_mem((uint8 *)secured_message + headroom, app_message,
+		 app_message_size);
+
+	return spdm_encode_secured_message_in_place(
+		spdm_secured_message_context, session_id, is_requester,
+		app_message_size, secured_message_size, secured_message,
+		spdm_secured_message_callbacks_t);
+}
+
+/**
+  Encode an application message to a secured message in place.
+
+  The application message must already be placed in the secured message buffer at
+  the offset returned by spdm_secured_message_get_headroom. The record header is
+  written in front of it, and the padding and the AEAD tag are written behind it.
+  The buffer should have spdm_secured_message_get_tailroom bytes after the
+  application message. For an encrypted session, the message is encrypted in place.
+
+  @param  spdm_secured_message_context    A pointer to the SPDM secured message context.
+  @param  session_id                    The session ID of the SPDM session.
+  @param  is_requester                  Indicates if it is a requester message.
+  @param  app_message_size               size in bytes of the application message in the buffer.
+  @param  secured_message_size           On input, size in bytes of the secured message buffer.
+                                       On output, size in bytes of the secured message.
+  @param  secured_message               A pointer to the buffer holding the application message at the headroom offset.
+                                       On output, it holds the secured message.
+  @param  spdm_secured_message_callbacks_t  A pointer to a secured message callback functions structure.
+
+  @retval RETURN_SUCCESS               The application message is encoded successfully.
+  @retval RETURN_BUFFER_TOO_SMALL      The buffer is too small to hold the secured message.
+**/
+return_status spdm_encode_secured_message_in_place(
+	IN void *spdm_secured_message_context, IN uint32 session_id,
+	IN boolean is_requester, IN uintn app_message_size,
+	IN OUT uintn *secured_message_size, IN OUT void *secured_message,
+	IN spdm_secured_message_callbacks_t *spdm_secured_message_callbacks_t)
+{
+	spdm_secured_message_context_t *secured_message_context;
+	uint8 salt[MAX_AEAD_IV_SIZE];
+	uint64 *sequence_number;
+	void *aead_context;
+	return_status status;
+
+	secured_message_context = spdm_secured_message_context;
+
+	ASSERT((secured_message_context->session_type ==
+		SPDM_SESSION_TYPE_MAC_ONLY) ||
+	       (secured_message_context->session_type ==
+		SPDM_SESSION_TYPE_ENC_MAC));
+	ASSERT((secured_message_context->session_state ==
+		SPDM_SESSION_STATE_HANDSHAKING) ||
+	       (secured_message_context->session_state ==
+		SPDM_SESSION_STATE_ESTABLISHED));
+
+	status = internal_spdm_secured_message_get_record_key(
+		secured_message_context, is_requester, salt, &sequence_number,
+		&aead_context);
+	if (RETURN_ERROR(status)) {
+		return status;
+	}
+
+	return internal_spdm_encode_secured_record(
+		secured_message_context, session_id, aead_context, salt,
+		sequence_number, app_message_size, secured_message_size,
+		secured_message, spdm_secured_message_callbacks_t);
+}
+
+/**
+  Decode an application message from a secured message.
+
+  @param  spdm_secured_message_context    A pointer to the SPDM secured message context.
+  @param  session_id                    The session ID of the SPDM session.
+  @param  is_requester                  Indicates if it is a requester message.
+  @param  secured_message_size           size in bytes of the secured message data buffer.
+  @param  secured_message               A pointer to a source buffer to store the secured message.
+  @param  app_message_size               size in bytes of the application message data buffer.
+  @param  app_message                   A pointer to a destination buffer to store the application message.
+  @param  spdm_secured_message_callbacks_t  A pointer to a secured message callback functions structure.
+
+  @retval RETURN_SUCCESS               The application message is decoded successfully.
+  @retval RETURN_INVALID_PARAMETER     The message is NULL or the message_size is zero.
+  @retval RETURN_UNSUPPORTED           The secured_message is unsupported.
+**/
+return_status spdm_decode_secured_message(
+	IN void *spdm_secured_message_context, IN uint32 session_id,
+	IN boolean is_requester, IN uintn secured_message_size,
+	IN void *secured_message, IN OUT uintn *app_message_size,
+	OUT void *app_message,
+	IN spdm_secured_message_callbacks_t *spdm_secured_message_callbacks_t)
+{
+	return_status status;
+	uint8 dec_message[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+	void *plain_text;
+	uintn plain_text_size;
+
+	//
+	// Keep the caller's secured message intact and decode a copy of it in place.
+	//
+	if (secured_message_size > sizeof(dec_message)) {
+		return RETURN_OUT_OF_RESOURCES;
+	}
+	copy_mem(dec_message, secured_message, secured_message_size);
+
+	status = spdm_decode_secured_message_in_place(
+		spdm_secured_message_context, session_id, is_requester,
+		secured_message_size, dec_message, &plain_text_size,
+		&plain_text, spdm_secured_message_callbacks_t);
+	if (RETURN_ERROR(status)) {
+		return status;
+	}
+
+	ASSERT(*app_message_size >= plain_text_size);
+	if (*app_message_size < plain_text_size) {
+		*app_message_size = plain_text_size;
+		return RETURN_BUFFER_TOO_SMALL;
+	}
+	*app_message_size = plain_text_size;
+	copy_mem(app_message, plain_text, plain_text_size);
+	return RETURN_SUCCESS;
+}
+
+/**
+  Decode an application message from a secured message in place.
+
+  The secured message is verified, and for an encrypted session decrypted, inside the
+  secured message buffer. No copy of the application message is made. On return,
+  app_message points to the application message inside the secured message buffer.
+  The content of the buffer is undefined if the decode fails.
+
+  @param  spdm_secured_message_context    A pointer to the SPDM secured message context.
+  @param  session_id                    The session ID of the SPDM session.
+  @param  is_requester                  Indicates if it is a requester message.
+  @param  secured_message_size           size in bytes of the secured message data buffer.
+  @param  secured_message               A pointer to the buffer holding the secured message.
+  @param  app_message_size               size in bytes of the application message.
+  @param  app_message                   A pointer to the application message inside the secured message buffer.
+  @param  spdm_secured_message_callbacks_t  A pointer to a secured message callback functions structure.
+
+  @retval RETURN_SUCCESS               The application message is decoded successfully.
+  @retval RETURN_UNSUPPORTED           The secured_message is unsupported.
+  @retval RETURN_SECURITY_VIOLATION    The secured_message fails verification.
+**/
+return_status spdm_decode_secured_message_in_place(
+	IN void *spdm_secured_message_context, IN uint32 session_id,
+	IN boolean is_requester, IN uintn secured_message_size,
+	IN OUT void *secured_message, OUT uintn *app_message_size,
+	OUT void **app_message,
+	IN spdm_secured_message_callbacks_t *spdm_secured_message_callbacks_t)
+{
+	spdm_secured_message_context_t *secured_message_context;
+	uint8 salt[MAX_AEAD_IV_SIZE];
+	uint64 *sequence_number;
+	void *aead_context;
+	return_status status;
+	spdm_error_struct_t spdm_error;
+
+	spdm_error.error_code = 0;
+	spdm_error.session_id = 0;
+	spdm_secured_message_set_last_spdm_error_struct(
+		spdm_secured_message_context, &spdm_error);
+
+	secured_message_context = spdm_secured_message_context;
+
+	ASSERT((secured_message_context->session_type ==
+		SPDM_SESSION_TYPE_MAC_ONLY) ||
+	       (secured_message_context->session_type ==
+		SPDM_SESSION_TYPE_ENC_MAC));
+	ASSERT((secured_message_context->session_state ==
+		SPDM_SESSION_STATE_HANDSHAKING) ||
+	       (secured_message_context->session_state ==
+		SPDM_SESSION_STATE_ESTABLISHED));
+
+	status = internal_spdm_secured_message_get_record_key(
+		secured_message_context, is_requester, salt, &sequence_number,
+		&aead_context);
+	if (RETURN_ERROR(status)) {
+		return status;
+	}
+
+	return internal_spdm_decode_secured_record(
+		secured_message_context, session_id, aead_context, salt,
+		sequence_number, secured_message_size, secured_message,
+		app_message_size, app_message,
+		spdm_secured_message_callbacks_t);
+}
+
+/**
+  Encode a batch of application messages of one session to secured messages.
+
+  The messages are assigned consecutive sequence numbers. The session key and the
+  keyed AEAD context are resolved once for the whole batch. Encoding stops at the
+  first message that fails, and the sequence numbers of the messages before it stay
+  consumed.
+
+  @param  spdm_secured_message_context    A pointer to the SPDM secured message context.
+  @param  session_id                    The session ID of the SPDM session.
+  @param  is_requester                  Indicates if it is a requester message.
+  @param  message_count                 The number of messages in the batch.
+  @param  app_message_size               An array of size in bytes of each application message.
+  @param  app_message                   An array of pointers to each application message.
+  @param  secured_message_size           An array of size in bytes of each secured message buffer.
+                                       On output, the size in bytes of each secured message.
+  @param  secured_message               An array of pointers to each secured message buffer.
+  @param  spdm_secured_message_callbacks_t  A pointer to a secured message callback functions structure.
+
+  @retval RETURN_SUCCESS               All application messages are encoded successfully.
+  @retval RETURN_BUFFER_TOO_SMALL      A secured message buffer is too small.
+  @retval RETURN_OUT_OF_RESOURCES      The sequence number is exhausted or the encryption fails.
+**/
+return_status spdm_encode_secured_messages(
+	IN void *spdm_secured_message_context, IN uint32 session_id,
+	IN boolean is_requester, IN uintn message_count,
+	IN uintn *app_message_size, IN void **app_message,
+	IN OUT uintn *secured_message_size, OUT void **secured_message,
+	IN spdm_secured_message_callbacks_t *spdm_secured_message_callbacks_t)
+{
+	spdm_secured_message_context_t *secured_message_context;
+	uint8 salt[MAX_AEAD_IV_SIZE];
+	uint64 *sequence_number;
+	void *aead_context;
+	uintn headroom;
+	uintn tailroom;
+	uintn index;
+	return_status status;
+
+	secured_message_context = spdm_secured_message_context;
+
+	ASSERT((secured_message_context->session_type ==
+		SPDM_SESSION_TYPE_MAC_ONLY) ||
+	       (secured_message_context->session_type ==
+		SPDM_SESSION_TYPE_ENC_MAC));
+	ASSERT((secured_message_context->session_state ==
+		SPDM_SESSION_STATE_HANDSHAKING) ||
+	       (secured_message_context->session_state ==
+		SPDM_SESSION_STATE_ESTABLISHED));
+
+	headroom = spdm_secured_message_get_headroom(
+		spdm_secured_message_context, spdm_secured_message_callbacks_t);
+	tailroom = spdm_secured_message_get_tailroom(
+		spdm_secured_message_context, spdm_secured_message_callbacks_t);
+
+	status = internal_spdm_secured_message_get_record_key(
+		secured_message_context, is_requester, salt, &sequence_number,
+		&aead_context);
+	if (RETURN_ERROR(status)) {
+		return status;
+	}
+
+	for (index = 0; index < message_count; index++) {
+		if (secured_message_size[index] <
+		    headroom + app_message_size[index]) {
+			secured_message_size[index] =
+				headroom + app_message_size[index] + tailroom;
+			return RETURN_BUFFER_TOO_SMALL;
+		}
+		copy_mem((uint8 *)secured_message[index] + headroom,
+			 app_message[index], app_message_size[index]);
+
+		status = internal_spdm_encode_secured_record(
+			secured_message_context, session_id, aead_context, salt,
+			sequence_number, app_message_size[index],
+			&secured_message_size[index], secured_message[index],
+			spdm_secured_message_callbacks_t);
+		if (RETURN_ERROR(status)) {
+			return status;
+		}
+	}
+	return RETURN_SUCCESS;
+}
+
+/**
+  Decode a batch of secured messages of one session to application messages.
+
+  The messages must carry consecutive sequence numbers. The session key and the
+  keyed AEAD context are resolved once for the whole batch. Decoding stops at the
+  first message that fails.
+
+  @param  spdm_secured_message_context    A pointer to the SPDM secured message context.
+  @param  session_id                    The session ID of the SPDM session.
+  @param  is_requester                  Indicates if it is a requester message.
+  @param  message_count                 The number of messages in the batch.
+  @param  secured_message_size           An array of size in bytes of each secured message.
+  @param  secured_message               An array of pointers to each secured message.
+  @param  app_message_size               An array of size in bytes of each application message buffer.
+                                       On output, the size in bytes of each application message.
+  @param  app_message                   An array of pointers to each application message buffer.
+  @param  spdm_secured_message_callbacks_t  A pointer to a secured message callback functions structure.
+
+  @retval RETURN_SUCCESS               All secured messages are decoded successfully.
+  @retval RETURN_BUFFER_TOO_SMALL      An application message buffer is too small.
+  @retval RETURN_OUT_OF_RESOURCES      A secured message is larger than MAX_SPDM_MESSAGE_BUFFER_SIZE.
+  @retval RETURN_SECURITY_VIOLATION    A secured message fails verification.
+**/
+return_status spdm_decode_secured_messages(
+	IN void *spdm_secured_message_context, IN uint32 session_id,
+	IN boolean is_requester, IN uintn message_count,
+	IN uintn *secured_message_size, IN void **secured_message,
+	IN OUT uintn *app_message_size, OUT void **app_message,
+	IN spdm_secured_message_callbacks_t *spdm_secured_message_callbacks_t)
+{
+	spdm_secured_message_context_t *secured_message_context;
+	uint8 salt[MAX_AEAD_IV_SIZE];
+	uint64 *sequence_number;
+	void *aead_context;
+	uint8 dec_message[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+	void *plain_text;
+	uintn plain_text_size;
+	uintn index;
+	return_status status;
+	spdm_error_struct_t spdm_error;
+
+	spdm_error.error_code = 0;
+	spdm_error.session_id = 0;
+	spdm_secured_message_set_last_spdm_error_struct(
+		spdm_secured_message_context, &spdm_error);
+
+	secured_message_context = spdm_secured_message_context;
+
+	ASSERT((secured_message_context->session_type ==
+		SPDM_SESSION_TYPE_MAC_ONLY) ||
+	       (secured_message_context->session_type ==
+		SPDM_SESSION_TYPE_ENC_MAC));
+	ASSERT((secured_message_context->session_state ==
+		SPDM_SESSION_STATE_HANDSHAKING) ||
+	       (secured_message_context->session_state ==
+		SPDM_SESSION_STATE_ESTABLISHED));
+
+	status = internal_spdm_secured_message_get_record_key(
+		secured_message_context, is_requester, salt, &sequence_number,
+		&aead_context);
+	if (RETURN_ERROR(status)) {
+		return status;
+	}
+
+	for (index = 0; index < message_count; index++) {
+		if (secured_message_size[index] > sizeof(dec_message)) {
+			return RETURN_OUT_OF_RESOURCES;
+		}
+		copy_mem(dec_message, secured_message[index],
+			 secured_message_size[index]);
+
+		status = internal_spdm_decode_secured_record(
+			secured_message_context, session_id, aead_context, salt,
+			sequence_number, secured_message_size[index],
+			dec_message, &plain_text_size, &plain_text,
+			spdm_secured_message_callbacks_t);
+		if (RETURN_ERROR(status)) {
+			return status;
+		}
+
+		if (app_message_size[index] < plain_text_size) {
+			app_message_size[index] = plain_text_size;
+			return RETURN_BUFFER_TOO_SMALL;
+		}
+		app_message_size[index] = plain_text_size;
+		copy_mem(app_message[index], plain_text, plain_text_size);
+	}
+	return RETURN_SUCCESS;
+}
@@ -82,7 +82,7 @@ return_status spdm_bin_concat(IN char8 *label, IN uintn label_size,
   This function generates SPDM AEAD key and IV for a session.
 
   @param  spdm_secured_message_context    A pointer to the SPDM secured message context.
-  @param  major_secret                  The major secret.
+  @param  major_secret_hmac_context       The HMAC context keyed with the major secret.
   @param  key                          The buffer to store the AEAD key.
   @param  iv                           The buffer to store the AEAD IV.
 
@@ -90,7 +90,7 @@ return_status spdm_bin_concat(IN char8 *label, IN uintn label_size,
 **/
 return_status spdm_generate_aead_key_and_iv(
 	IN spdm_secured_message_context_t *secured_message_context,
-	IN uint8 *major_secret, OUT uint8 *key, OUT uint8 *iv)
+	IN const void *major_secret_hmac_context, OUT uint8 *key, OUT uint8 *iv)
 {
 	return_status status;
 	boolean ret_val;
@@ -113,9 +113,9 @@ return_status spdm_generate_aead_key_and_iv(
 	ASSERT_RETURN_ERROR(status);
 	DEBUG((DEBUG_INFO, "bin_str5 (0x%x):\n", bin_str5_size));
 	internal_dump_hex(bin_str5, bin_str5_size);
-	ret_val = spdm_hkdf_expand(secured_message_context->base_hash_algo,
-				   major_secret, hash_size, bin_str5,
-				   bin_str5_size, key, key_length);
+	ret_val = spdm_hkdf_expand_with_key(
+		secured_message_context->base_hash_algo,
+		major_secret_hmac_context, bin_str5, bin_str5_size, key, key_length);
 	ASSERT(ret_val);
 	DEBUG((DEBUG_INFO, "key (0x%x) - ", key_length));
 	internal_dump_data(key, key_length);
@@ -128,9 +128,9 @@ return_status spdm_generate_aead_key_and_iv(
 	ASSERT_RETURN_ERROR(status);
 	DEBUG((DEBUG_INFO, "bin_str6 (0x%x):\n", bin_str6_size));
 	internal_dump_hex(bin_str6, bin_str6_size);
-	ret_val = spdm_hkdf_expand(secured_message_context->base_hash_algo,
-				   major_secret, hash_size, bin_str6,
-				   bin_str6_size, iv, iv_length);
+	ret_val = spdm_hkdf_expand_with_key(
+		secured_message_context->base_hash_algo,
+		major_secret_hmac_context, bin_str6, bin_str6_size, iv, iv_length);
 	ASSERT(ret_val);
 	DEBUG((DEBUG_INFO, "iv (0x%x) - ", iv_length));
 	internal_dump_data(iv, iv_length);
@@ -143,14 +143,14 @@ return_status spdm_generate_aead_key_and_iv(
   This function generates SPDM FinishedKey for a session.
 
   @param  spdm_secured_message_context    A pointer to the SPDM secured message context.
-  @param  handshake_secret              The handshake secret.
+  @param  handshake_secret_hmac_context   The HMAC context keyed with the handshake secret.
   @param  FinishedKey                  The buffer to store the finished key.
 
   @retval RETURN_SUCCESS  SPDM FinishedKey for a session is generated.
 **/
 return_status spdm_generate_finished_key(
 	IN spdm_secured_message_context_t *secured_message_context,
-	IN uint8 *handshake_secret, OUT uint8 *FinishedKey)
+	IN const void *handshake_secret_hmac_context, OUT uint8 *FinishedKey)
 {
 	return_status status;
 	boolean ret_val;
@@ -167,9 +167,10 @@ return_status spdm_generate_finished_key(
 	ASSERT_RETURN_ERROR(status);
 	DEBUG((DEBUG_INFO, "bin_str7 (0x%x):\n", bin_str7_size));
 	internal_dump_hex(bin_str7, bin_str7_size);
-	ret_val = spdm_hkdf_expand(secured_message_context->base_hash_algo,
-				   handshake_secret, hash_size, bin_str7,
-				   bin_str7_size, FinishedKey, hash_size);
+	ret_val = spdm_hkdf_expand_with_key(
+		secured_message_context->base_hash_algo,
+		handshake_secret_hmac_context, bin_str7, bin_str7_size,
+		FinishedKey, hash_size);
 	ASSERT(ret_val);
 	DEBUG((DEBUG_INFO, "FinishedKey (0x%x) - ", hash_size));
 	internal_dump_data(FinishedKey, hash_size);
@@ -199,6 +200,7 @@ spdm_generate_session_handshake_key(IN void *spdm_secured_message_context,
 	uintn bin_str1_size;
 	uint8 bin_str2[128];
 	uintn bin_str2_size;
+	void *hmac_key_context;
 	spdm_secured_message_context_t *secured_message_context;
 
 	secured_message_context = spdm_secured_message_context;
@@ -213,6 +215,7 @@ spdm_generate_session_handshake_key(IN void *spdm_secured_message_context,
 	DEBUG((DEBUG_INFO, "bin_str0 (0x%x):\n", bin_str0_size));
 	internal_dump_hex(bin_str0, bin_str0_size);
 
+	hmac_key_context = NULL;
 	if (secured_message_context->use_psk) {
 		// No handshake_secret generation for PSK.
 	} else {
@@ -233,6 +236,17 @@ spdm_generate_session_handshake_key(IN void *spdm_secured_message_context,
 			secured_message_context->master_secret.handshake_secret,
 			hash_size);
 		DEBUG((DEBUG_INFO, "\n"));
+
+		//
+		// Set the handshake_secret key once for the two HKDF-Expand.
+		//
+		hmac_key_context = spdm_hmac_new_with_key(
+			secured_message_context->base_hash_algo,
+			secured_message_context->master_secret.handshake_secret,
+			hash_size);
+		if (hmac_key_context == NULL) {
+			return RETURN_OUT_OF_RESOURCES;
+		}
 	}
 
 	bin_str1_size = sizeof(bin_str1);
@@ -255,10 +269,9 @@ spdm_generate_session_handshake_key(IN void *spdm_secured_message_context,
 			return RETURN_UNSUPPORTED;
 		}
 	} else {
-		ret_val = spdm_hkdf_expand(
+		ret_val = spdm_hkdf_expand_with_key(
 			secured_message_context->base_hash_algo,
-			secured_message_context->master_secret.handshake_secret,
-			hash_size, bin_str1, bin_str1_size,
+			hmac_key_context, bin_str1, bin_str1_size,
 			secured_message_context->handshake_secret
 				.request_handshake_secret,
 			hash_size);
@@ -289,10 +302,9 @@ spdm_generate_session_handshake_key(IN void *spdm_secured_message_context,
 			return RETURN_UNSUPPORTED;
 		}
 	} else {
-		ret_val = spdm_hkdf_expand(
+		ret_val = spdm_hkdf_expand_with_key(
 			secured_message_context->base_hash_algo,
-			secured_message_context->master_secret.handshake_secret,
-			hash_size, bin_str2, bin_str2_size,
+			hmac_key_context, bin_str2, bin_str2_size,
 			secured_message_context->handshake_secret
 				.response_handshake_secret,
 			hash_size);
@@ -303,37 +315,75 @@ spdm_generate_session_handshake_key(IN void *spdm_secured_message_context,
 				   .response_handshake_secret,
 			   hash_size);
 	DEBUG((DEBUG_INFO, "\n"));
+	if (hmac_key_context != NULL) {
+		spdm_hmac_free_with_key(secured_message_context->base_hash_algo,
+					hmac_key_context);
+	}
 
-	spdm_generate_finished_key(
+	spdm_secured_message_release_aead_context(
+		secured_message_context,
+		&secured_message_context->handshake_secret
+			 .request_handshake_aead_context);
+	spdm_secured_message_release_aead_context(
+		secured_message_context,
+		&secured_message_context->handshake_secret
+			 .response_handshake_aead_context);
+	spdm_secured_message_release_hmac_context(
+		secured_message_context,
+		&secured_message_context->handshake_secret
+			 .request_finished_key_hmac_context);
+	spdm_secured_message_release_hmac_context(
 		secured_message_context,
+		&secured_message_context->handshake_secret
+			 .response_finished_key_hmac_context);
+
+	//
+	// Set the request_handshake_secret key once for FinishedKey, key and IV.
+	//
+	hmac_key_context = spdm_hmac_new_with_key(
+		secured_message_context->base_hash_algo,
 		secured_message_context->handshake_secret
 			.request_handshake_secret,
-		secured_message_context->handshake_secret.request_finished_key);
-
+		hash_size);
+	if (hmac_key_context == NULL) {
+		return RETURN_OUT_OF_RESOURCES;
+	}
 	spdm_generate_finished_key(
-		secured_message_context,
+		secured_message_context, hmac_key_context,
+		secured_message_context->handshake_secret.request_finished_key);
+	spdm_generate_aead_key_and_iv(
+		secured_message_context, hmac_key_context,
 		secured_message_context->handshake_secret
-			.response_handshake_secret,
-		secured_message_context->handshake_secret.response_finished_key);
-
-	spdm_generate_aead_key_and_iv(secured_message_context,
-				      secured_message_context->handshake_secret
-					      .request_handshake_secret,
-				      secured_message_context->handshake_secret
-					      .request_handshake_encryption_key,
-				      secured_message_context->handshake_secret
-					      .request_handshake_salt);
+			.request_handshake_encryption_key,
+		secured_message_context->handshake_secret
+			.request_handshake_salt);
+	spdm_hmac_free_with_key(secured_message_context->base_hash_algo,
+				hmac_key_context);
 	secured_message_context->handshake_secret
 		.request_handshake_sequence_number = 0;
 
-	spdm_generate_aead_key_and_iv(
-		secured_message_context,
+	//
+	// Set the response_handshake_secret key once for FinishedKey, key and IV.
+	//
+	hmac_key_context = spdm_hmac_new_with_key(
+		secured_message_context->base_hash_algo,
 		secured_message_context->handshake_secret
 			.response_handshake_secret,
+		hash_size);
+	if (hmac_key_context == NULL) {
+		return RETURN_OUT_OF_RESOURCES;
+	}
+	spdm_generate_finished_key(
+		secured_message_context, hmac_key_context,
+		secured_message_context->handshake_secret.response_finished_key);
+	spdm_generate_aead_key_and_iv(
+		secured_message_context, hmac_key_context,
 		secured_message_context->handshake_secret
 			.response_handshake_encryption_key,
 		secured_message_context->handshake_secret
 			.response_handshake_salt);
+	spdm_hmac_free_with_key(secured_message_context->base_hash_algo,
+				hmac_key_context);
 	secured_message_context->handshake_secret
 		.response_handshake_sequence_number = 0;
 
@@ -364,12 +414,14 @@ spdm_generate_session_data_key(IN void *spdm_secured_message_context,
 	uintn bin_str4_size;
 	uint8 bin_str8[128];
 	uintn bin_str8_size;
+	void *hmac_key_context;
 	spdm_secured_message_context_t *secured_message_context;
 
 	secured_message_context = spdm_secured_message_context;
 
 	hash_size = secured_message_context->hash_size;
 
+	hmac_key_context = NULL;
 	if (secured_message_context->use_psk) {
 		// No master_secret generation for PSK.
 	} else {
@@ -398,6 +450,17 @@ spdm_generate_session_data_key(IN void *spdm_secured_message_context,
 			secured_message_context->master_secret.master_secret,
 			hash_size);
 		DEBUG((DEBUG_INFO, "\n"));
+
+		//
+		// Set the master_secret key once for the three HKDF-Expand.
+		//
+		hmac_key_context = spdm_hmac_new_with_key(
+			secured_message_context->base_hash_algo,
+			secured_message_context->master_secret.master_secret,
+			hash_size);
+		if (hmac_key_context == NULL) {
+			return RETURN_OUT_OF_RESOURCES;
+		}
 	}
 
 	bin_str3_size = sizeof(bin_str3);
@@ -420,10 +483,9 @@ spdm_generate_session_data_key(IN void *spdm_secured_message_context,
 			return RETURN_UNSUPPORTED;
 		}
 	} else {
-		ret_val = spdm_hkdf_expand(
+		ret_val = spdm_hkdf_expand_with_key(
 			secured_message_context->base_hash_algo,
-			secured_message_context->master_secret.master_secret,
-			hash_size, bin_str3, bin_str3_size,
+			hmac_key_context, bin_str3, bin_str3_size,
 			secured_message_context->application_secret
 				.request_data_secret,
 			hash_size);
@@ -454,10 +516,9 @@ spdm_generate_session_data_key(IN void *spdm_secured_message_context,
 			return RETURN_UNSUPPORTED;
 		}
 	} else {
-		ret_val = spdm_hkdf_expand(
+		ret_val = spdm_hkdf_expand_with_key(
 			secured_message_context->base_hash_algo,
-			secured_message_context->master_secret.master_secret,
-			hash_size, bin_str4, bin_str4_size,
+			hmac_key_context, bin_str4, bin_str4_size,
 			secured_message_context->application_secret
 				.response_data_secret,
 			hash_size);
@@ -489,10 +550,9 @@ spdm_generate_session_data_key(IN void *spdm_secured_message_context,
 			return RETURN_UNSUPPORTED;
 		}
 	} else {
-		ret_val = spdm_hkdf_expand(
+		ret_val = spdm_hkdf_expand_with_key(
 			secured_message_context->base_hash_algo,
-			secured_message_context->master_secret.master_secret,
-			hash_size, bin_str8, bin_str8_size,
+			hmac_key_context, bin_str8, bin_str8_size,
 			secured_message_context->handshake_secret
 				.export_master_secret,
 			hash_size);
@@ -503,22 +563,51 @@ spdm_generate_session_data_key(IN void *spdm_secured_message_context,
 		secured_message_context->handshake_secret.export_master_secret,
 		hash_size);
 	DEBUG((DEBUG_INFO, "\n"));
+	if (hmac_key_context != NULL) {
+		spdm_hmac_free_with_key(secured_message_context->base_hash_algo,
+					hmac_key_context);
+	}
 
-	spdm_generate_aead_key_and_iv(
+	spdm_secured_message_release_aead_context(
 		secured_message_context,
+		&secured_message_context->application_secret
+			 .request_data_aead_context);
+	spdm_secured_message_release_aead_context(
+		secured_message_context,
+		&secured_message_context->application_secret
+			 .response_data_aead_context);
+
+	hmac_key_context = spdm_hmac_new_with_key(
+		secured_message_context->base_hash_algo,
 		secured_message_context->application_secret.request_data_secret,
+		hash_size);
+	if (hmac_key_context == NULL) {
+		return RETURN_OUT_OF_RESOURCES;
+	}
+	spdm_generate_aead_key_and_iv(
+		secured_message_context, hmac_key_context,
 		secured_message_context->application_secret
 			.request_data_encryption_key,
 		secured_message_context->application_secret.request_data_salt);
+	spdm_hmac_free_with_key(secured_message_context->base_hash_algo,
+				hmac_key_context);
 	secured_message_context->application_secret
 		.request_data_sequence_number = 0;
 
-	spdm_generate_aead_key_and_iv(
-		secured_message_context,
+	hmac_key_context = spdm_hmac_new_with_key(
+		secured_message_context->base_hash_algo,
 		secured_message_context->application_secret.response_data_secret,
+		hash_size);
+	if (hmac_key_context == NULL) {
+		return RETURN_OUT_OF_RESOURCES;
+	}
+	spdm_generate_aead_key_and_iv(
+		secured_message_context, hmac_key_context,
 		secured_message_context->application_secret
 			.response_data_encryption_key,
 		secured_message_context->application_secret.response_data_salt);
+	spdm_hmac_free_with_key(secured_message_context->base_hash_algo,
+				hmac_key_context);
 	secured_message_context->application_secret
 		.response_data_sequence_number = 0;
 
@@ -542,6 +631,7 @@ spdm_create_update_session_data_key(IN void *spdm_secured_message_context,
 	uintn hash_size;
 	uint8 bin_str9[128];
 	uintn bin_str9_size;
+	void *hmac_key_context;
 	spdm_secured_message_context_t *secured_message_context;
 
 	secured_message_context = spdm_secured_message_context;
@@ -576,15 +666,37 @@ spdm_create_update_session_data_key(IN void *spdm_secured_message_context,
 			.request_data_sequence_number =
 			secured_message_context->application_secret
 				.request_data_sequence_number;
+		//
+		// Keep the current AEAD context for the old key, in case the
+		// new key is not activated.
+		//
+		spdm_secured_message_release_aead_context(
+			secured_message_context,
+			&secured_message_context->application_secret_backup
+				 .request_data_aead_context);
+		secured_message_context->application_secret_backup
+			.request_data_aead_context =
+			secured_message_context->application_secret
+				.request_data_aead_context;
+		secured_message_context->application_secret
+			.request_data_aead_context = NULL;
 
-		ret_val = spdm_hkdf_expand(
+		hmac_key_context = spdm_hmac_new_with_key(
 			secured_message_context->base_hash_algo,
 			secured_message_context->application_secret
 				.request_data_secret,
-			hash_size, bin_str9, bin_str9_size,
+			hash_size);
+		if (hmac_key_context == NULL) {
+			return RETURN_OUT_OF_RESOURCES;
+		}
+		ret_val = spdm_hkdf_expand_with_key(
+			secured_message_context->base_hash_algo,
+			hmac_key_context, bin_str9, bin_str9_size,
 			secured_message_context->application_secret
 				.request_data_secret,
 			hash_size);
+		spdm_hmac_free_with_key(secured_message_context->base_hash_algo,
+					hmac_key_context);
 		ASSERT(ret_val);
 		DEBUG((DEBUG_INFO, "RequestDataSecretUpdate (0x%x) - ",
 		       hash_size));
@@ -593,14 +705,22 @@ spdm_create_update_session_data_key(IN void *spdm_secured_message_context,
 				   hash_size);
 		DEBUG((DEBUG_INFO, "\n"));
 
-		spdm_generate_aead_key_and_iv(
-			secured_message_context,
+		hmac_key_context = spdm_hmac_new_with_key(
+			secured_message_context->base_hash_algo,
 			secured_message_context->application_secret
 				.request_data_secret,
+			hash_size);
+		if (hmac_key_context == NULL) {
+			return RETURN_OUT_OF_RESOURCES;
+		}
+		spdm_generate_aead_key_and_iv(
+			secured_message_context, hmac_key_context,
 			secured_message_context->application_secret
 				.request_data_encryption_key,
 			secured_message_context->application_secret
 				.request_data_salt);
+		spdm_hmac_free_with_key(secured_message_context->base_hash_algo,
+					hmac_key_context);
 		secured_message_context->application_secret
 			.request_data_sequence_number = 0;
 	}
@@ -625,15 +745,37 @@ spdm_create_update_session_data_key(IN void *spdm_secured_message_context,
 			.response_data_sequence_number =
 			secured_message_context->application_secret
 				.response_data_sequence_number;
+		//
+		// Keep the current AEAD context for the old key, in case the
+		// new key is not activated.
+		//
+		spdm_secured_message_release_aead_context(
+			secured_message_context,
+			&secured_message_context->application_secret_backup
+				 .response_data_aead_context);
+		secured_message_context->application_secret_backup
+			.response_data_aead_context =
+			secured_message_context->application_secret
+				.response_data_aead_context;
+		secured_message_context->application_secret
+			.response_data_aead_context = NULL;
 
-		ret_val = spdm_hkdf_expand(
+		hmac_key_context = spdm_hmac_new_with_key(
 			secured_message_context->base_hash_algo,
 			secured_message_context->application_secret
 				.response_data_secret,
-			hash_size, bin_str9, bin_str9_size,
+			hash_size);
+		if (hmac_key_context == NULL) {
+			return RETURN_OUT_OF_RESOURCES;
+		}
+		ret_val = spdm_hkdf_expand_with_key(
+			secured_message_context->base_hash_algo,
+			hmac_key_context, bin_str9, bin_str9_size,
 			secured_message_context->application_secret
 				.response_data_secret,
 			hash_size);
+		spdm_hmac_free_with_key(secured_message_context->base_hash_algo,
+					hmac_key_context);
 		ASSERT(ret_val);
 		DEBUG((DEBUG_INFO, "ResponseDataSecretUpdate (0x%x) - ",
 		       hash_size));
@@ -642,14 +784,22 @@ spdm_create_update_session_data_key(IN void *spdm_secured_message_context,
 				   hash_size);
 		DEBUG((DEBUG_INFO, "\n"));
 
-		spdm_generate_aead_key_and_iv(
-			secured_message_context,
+		hmac_key_context = spdm_hmac_new_with_key(
+			secured_message_context->base_hash_algo,
 			secured_message_context->application_secret
 				.response_data_secret,
+			hash_size);
+		if (hmac_key_context == NULL) {
+			return RETURN_OUT_OF_RESOURCES;
+		}
+		spdm_generate_aead_key_and_iv(
+			secured_message_context, hmac_key_context,
 			secured_message_context->application_secret
 				.response_data_encryption_key,
 			secured_message_context->application_secret
 				.response_data_salt);
+		spdm_hmac_free_with_key(secured_message_context->base_hash_algo,
+					hmac_key_context);
 		secured_message_context->application_secret
 			.response_data_sequence_number = 0;
 	}
@@ -699,6 +849,17 @@ spdm_activate_update_session_data_key(IN void *spdm_secured_message_context,
 				secured_message_context
 					->application_secret_backup
 					.request_data_sequence_number;
+			spdm_secured_message_release_aead_context(
+				secured_message_context,
+				&secured_message_context->application_secret
+					 .request_data_aead_context);
+			secured_message_context->application_secret
+				.request_data_aead_context =
+				secured_message_context
+					->application_secret_backup
+					.request_data_aead_context;
+			secured_message_context->application_secret_backup
+				.request_data_aead_context = NULL;
 		}
 		if ((action & SPDM_KEY_UPDATE_ACTION_RESPONDER) != 0) {
 			copy_mem(&secured_message_context->application_secret
@@ -724,34 +885,59 @@ spdm_activate_update_session_data_key(IN void *spdm_secured_message_context,
 				secured_message_context
 					->application_secret_backup
 					.response_data_sequence_number;
+			spdm_secured_message_release_aead_context(
+				secured_message_context,
+				&secured_message_context->application_secret
+					 .response_data_aead_context);
+			secured_message_context->application_secret
+				.response_data_aead_context =
+				secured_message_context
+					->application_secret_backup
+					.response_data_aead_context;
+			secured_message_context->application_secret_backup
+				.response_data_aead_context = NULL;
 		}
 	}
 
 	if ((action & SPDM_KEY_UPDATE_ACTION_REQUESTER) != 0) {
-		zero_mem(&secured_message_context->application_secret_backup
-				  .request_data_secret,
-			 MAX_HASH_SIZE);
-		zero_mem(&secured_message_context->application_secret_backup
-				  .request_data_encryption_key,
-			 MAX_AEAD_KEY_SIZE);
-		zero_mem(&secured_message_context->application_secret_backup
-				  .request_data_salt,
-			 MAX_AEAD_IV_SIZE);
+		zero_mem_secure(&secured_message_context
+					 ->application_secret_backup
+					 .request_data_secret,
+				MAX_HASH_SIZE);
+		zero_mem_secure(&secured_message_context
+					 ->application_secret_backup
+					 .request_data_encryption_key,
+				MAX_AEAD_KEY_SIZE);
+		zero_mem_secure(&secured_message_context
+					 ->application_secret_backup
+					 .request_data_salt,
+				MAX_AEAD_IV_SIZE);
 		secured_message_context->application_secret_backup
 			.request_data_sequence_number = 0;
+		spdm_secured_message_release_aead_context(
+			secured_message_context,
+			&secured_message_context->application_secret_backup
+				 .request_data_aead_context);
 	}
 	if ((action & SPDM_KEY_UPDATE_ACTION_RESPONDER) != 0) {
-		zero_mem(&secured_message_context->application_secret_backup
-				  .response_data_secret,
-			 MAX_HASH_SIZE);
-		zero_mem(&secured_message_context->application_secret_backup
-				  .response_data_encryption_key,
-			 MAX_AEAD_KEY_SIZE);
-		zero_mem(&secured_message_context->application_secret_backup
-				  .response_data_salt,
-			 MAX_AEAD_IV_SIZE);
+		zero_mem_secure(&secured_message_context
+					 ->application_secret_backup
+					 .response_data_secret,
+				MAX_HASH_SIZE);
+		zero_mem_secure(&secured_message_context
+					 ->application_secret_backup
+					 .response_data_encryption_key,
+				MAX_AEAD_KEY_SIZE);
+		zero_mem_secure(&secured_message_context
+					 ->application_secret_backup
+					 .response_data_salt,
+				MAX_AEAD_IV_SIZE);
 		secured_message_context->application_secret_backup
 			.response_data_sequence_number = 0;
+		spdm_secured_message_release_aead_context(
+			secured_message_context,
+			&secured_message_context->application_secret_backup
+				 .response_data_aead_context);
 	}
 	return RETURN_SUCCESS;
 }
@@ -773,12 +959,50 @@ spdm_hmac_all_with_request_finished_key(IN void *spdm_secured_message_context,
 					OUT uint8 *hmac_value)
 {
 	spdm_secured_message_context_t *secured_message_context;
+	void *hmac_key_context;
+
+	secured_message_context = spdm_secured_message_context;
+	hmac_key_context = spdm_secured_message_get_hmac_context(
+		secured_message_context,
+		&secured_message_context->handshake_secret
+			 .request_finished_key_hmac_context,
+		secured_message_context->handshake_secret.request_finished_key);
+	if (hmac_key_context == NULL) {
+		return FALSE;
+	}
+	return spdm_hmac_all_with_key(secured_message_context->base_hash_algo,
+				hmac_key_context, data, data_size, hmac_value);
+}
+
+/**
+  Computes the HMAC of a list of discontinuous data buffers, with request_finished_key.
+
+  @param  spdm_secured_message_context    A pointer to the SPDM secured message context.
+  @param  iov                          Pointer to the array of data buffers to be HMACed, in order.
+  @param  iov_count                     Number of elements in iov.
+  @param  hmac_value                    Pointer to a buffer that receives the HMAC value.
+
+  @retval TRUE   HMAC computation succeeded.
+  @retval FALSE  HMAC computation failed.
+**/
+boolean spdm_hmac_multi_with_request_finished_key(
+	IN void *spdm_secured_message_context, IN const spdm_iovec_t *iov,
+	IN uintn iov_count, OUT uint8 *hmac_value)
+{
+	spdm_secured_message_context_t *secured_message_context;
+	void *hmac_key_context;
 
 	secured_message_context = spdm_secured_message_context;
-	return spdm_hmac_all(
-		secured_message_context->base_hash_algo, data, data_size,
-		secured_message_context->handshake_secret.request_finished_key,
-		secured_message_context->hash_size, hmac_value);
+	hmac_key_context = spdm_secured_message_get_hmac_context(
+		secured_message_context,
+		&secured_message_context->handshake_secret
+			 .request_finished_key_hmac_context,
+		secured_message_context->handshake_secret.request_finished_key);
+	if (hmac_key_context == NULL) {
+		return FALSE;
+	}
+	return spdm_hmac_multi_with_key(secured_message_context->base_hash_algo,
+				hmac_key_context, iov, iov_count, hmac_value);
 }
 
 /**
@@ -797,10 +1021,48 @@ boolean spdm_hmac_all_with_response_finished_key(
 	IN uintn data_size, OUT uint8 *hmac_value)
 {
 	spdm_secured_message_context_t *secured_message_context;
+	void *hmac_key_context;
 
 	secured_message_context = spdm_secured_message_context;
-	return spdm_hmac_all(
-		secured_message_context->base_hash_algo, data, data_size,
-		secured_message_context->handshake_secret.response_finished_key,
-		secured_message_context->hash_size, hmac_value);
+	hmac_key_context = spdm_secured_message_get_hmac_context(
+		secured_message_context,
+		&secured_message_context->handshake_secret
+			 .response_finished_key_hmac_context,
+		secured_message_context->handshake_secret.response_finished_key);
+	if (hmac_key_context == NULL) {
+		return FALSE;
+	}
+	return spdm_hmac_all_with_key(secured_message_context->base_hash_algo,
+				hmac_key_context, data, data_size, hmac_value);
+}
+
+/**
+  Computes the HMAC of a list of discontinuous data buffers, with response_finished_key.
+
+  @param  spdm_secured_message_context    A pointer to the SPDM secured message context.
+  @param  iov                          Pointer to the array of data buffers to be HMACed, in order.
+  @param  iov_count                     Number of elements in iov.
+  @param  hmac_value                    Pointer to a buffer that receives the HMAC value.
+
+  @retval TRUE   HMAC computation succeeded.
+  @retval FALSE  HMAC computation failed.
+**/
+boolean spdm_hmac_multi_with_response_finished_key(
+	IN void *spdm_secured_message_context, IN const spdm_iovec_t *iov,
+	IN uintn iov_count, OUT uint8 *hmac_value)
+{
+	spdm_secured_message_context_t *secured_message_context;
+	void *hmac_key_context;
+
+	secured_message_context = spdm_secured_message_context;
+	hmac_key_context = spdm_secured_message_get_hmac_context(
+		secured_message_context,
+		&secured_message_context->handshake_secret
+			 .response_finished_key_hmac_context,
+		secured_message_context->handshake_secret.response_finished_key);
+	if (hmac_key_context == NULL) {
+		return FALSE;
+	}
+	return spdm_hmac_multi_with_key(secured_message_context->base_hash_algo,
+				hmac_key_context, iov, iov_count, hmac_value);
 }
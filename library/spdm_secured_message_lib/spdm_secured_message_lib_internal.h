@@ -21,12 +21,16 @@ typedef struct {
 	uint8 export_master_secret[MAX_HASH_SIZE];
 	uint8 request_finished_key[MAX_HASH_SIZE];
 	uint8 response_finished_key[MAX_HASH_SIZE];
+	void *request_finished_key_hmac_context;
+	void *response_finished_key_hmac_context;
 	uint8 request_handshake_encryption_key[MAX_AEAD_KEY_SIZE];
 	uint8 request_handshake_salt[MAX_AEAD_IV_SIZE];
 	uint64 request_handshake_sequence_number;
+	void *request_handshake_aead_context;
 	uint8 response_handshake_encryption_key[MAX_AEAD_KEY_SIZE];
 	uint8 response_handshake_salt[MAX_AEAD_IV_SIZE];
 	uint64 response_handshake_sequence_number;
+	void *response_handshake_aead_context;
 } spdm_session_info_struct_handshake_secret_t;
 
 typedef struct {
@@ -35,9 +39,11 @@ typedef struct {
 	uint8 request_data_encryption_key[MAX_AEAD_KEY_SIZE];
 	uint8 request_data_salt[MAX_AEAD_IV_SIZE];
 	uint64 request_data_sequence_number;
+	void *request_data_aead_context;
 	uint8 response_data_encryption_key[MAX_AEAD_KEY_SIZE];
 	uint8 response_data_salt[MAX_AEAD_IV_SIZE];
 	uint64 response_data_sequence_number;
+	void *response_data_aead_context;
 } spdm_session_info_struct_application_secret_t;
 
 typedef struct {
@@ -65,4 +71,55 @@ typedef struct {
 	spdm_error_struct_t last_spdm_error;
 } spdm_secured_message_context_t;
 
+/**
+  Return the keyed AEAD context for one direction of the current session phase.
+
+  The AEAD context is created from the encryption key on first use and kept
+  until the key changes.
+
+  @param  secured_message_context        A pointer to the SPDM secured message context.
+  @param  aead_context                   A pointer to the AEAD context slot.
+  @param  key                          Pointer to the encryption key of this slot.
+
+  @return the keyed AEAD context, or NULL if it cannot be created.
+**/
+void *spdm_secured_message_get_aead_context(
+	IN spdm_secured_message_context_t *secured_message_context,
+	IN OUT void **aead_context, IN const uint8 *key);
+
+/**
+  Release the keyed AEAD context in one slot, so it is rebuilt from the new key.
+
+  @param  secured_message_context        A pointer to the SPDM secured message context.
+  @param  aead_context                   A pointer to the AEAD context slot.
+**/
+void spdm_secured_message_release_aead_context(
+	IN spdm_secured_message_context_t *secured_message_context,
+	IN OUT void **aead_context);
+
+/**
+  Return the HMAC context keyed with one finished_key.
+
+  The keyed HMAC context is created on first use and kept until the key changes.
+
+  @param  secured_message_context        A pointer to the SPDM secured message context.
+  @param  hmac_context                   A pointer to the keyed HMAC context slot.
+  @param  key                          Pointer to the HMAC key of this slot.
+
+  @return the keyed HMAC context, or NULL if it cannot be created.
+**/
+void *spdm_secured_message_get_hmac_context(
+	IN spdm_secured_message_context_t *secured_message_context,
+	IN OUT void **hmac_context, IN const uint8 *key);
+
+/**
+  Release the keyed HMAC context in one slot, so it is rebuilt from the new key.
+
+  @param  secured_message_context        A pointer to the SPDM secured message context.
+  @param  hmac_context                   A pointer to the keyed HMAC context slot.
+**/
+void spdm_secured_message_release_hmac_context(
+	IN spdm_secured_message_context_t *secured_message_context,
+	IN OUT void **hmac_context);
+
 #endif
\ No newline at end of file
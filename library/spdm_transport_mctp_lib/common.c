@@ -6,6 +6,7 @@
 
 #include <library/spdm_transport_mctp_lib.h>
 #include <library/spdm_secured_message_lib.h>
+#include <industry_standard/mctp.h>
 
 /**
   Encode a normal message or secured message to a transport message.
@@ -113,11 +114,12 @@ return_status spdm_transport_mctp_encode_message(
 {
 	return_status status;
 	transport_encode_message_func transport_encode_message;
-	uint8 app_message_buffer[MAX_SPDM_MESSAGE_BUFFER_SIZE];
-	void *app_message;
+	uint8 *app_message;
 	uintn app_message_size;
-	uint8 secured_message[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+	uint8 *secured_message;
 	uintn secured_message_size;
+	uintn headroom;
+	uintn tailroom;
 	spdm_secured_message_callbacks_t spdm_secured_message_callbacks_t;
 	void *secured_message_context;
 
@@ -141,14 +143,33 @@ return_status spdm_transport_mctp_encode_message(
 			return RETURN_UNSUPPORTED;
 		}
 
+		//
+		// Build the secured message in place inside the transport message.
+		// The APP message is placed behind the MCTP header and the secured message headroom.
+		//
+		headroom = spdm_secured_message_get_headroom(
+			secured_message_context,
+			&spdm_secured_message_callbacks_t);
+		tailroom = spdm_secured_message_get_tailroom(
+			secured_message_context,
+			&spdm_secured_message_callbacks_t);
+		if (*transport_message_size <
+		    sizeof(mctp_message_header_t) + headroom + tailroom) {
+			return RETURN_BUFFER_TOO_SMALL;
+		}
+		secured_message = (uint8 *)transport_message +
+				  sizeof(mctp_message_header_t);
+		app_message = secured_message + headroom;
+		app_message_size = *transport_message_size -
+				   sizeof(mctp_message_header_t) - headroom -
+				   tailroom;
+
 		if (!is_app_message) {
 			// SPDM message to APP message
-			app_message = app_message_buffer;
-			app_message_size = sizeof(app_message_buffer);
 			status = transport_encode_message(NULL, message_size,
 							  message,
 							  &app_message_size,
-							  app_message_buffer);
+							  app_message);
 			if (RETURN_ERROR(status)) {
 				DEBUG((DEBUG_ERROR,
 				       "transport_encode_message - %p\n",
@@ -156,18 +177,23 @@ return_status spdm_transport_mctp_encode_message(
 				return RETURN_UNSUPPORTED;
 			}
 		} else {
-			app_message = message;
+			if (app_message_size < message_size) {
+				return RETURN_BUFFER_TOO_SMALL;
+			}
 			app_message_size = message_size;
+			copy_mem(app_message, message, message_size);
 		}
 		// APP message to secured message
-		secured_message_size = sizeof(secured_message);
-		status = spdm_encode_secured_message(
+		secured_message_size = *transport_message_size -
+				       sizeof(mctp_message_header_t);
+		status = spdm_encode_secured_message_in_place(
 			secured_message_context, *session_id, is_requester,
-			app_message_size, app_message, &secured_message_size,
+			app_message_size, &secured_message_size,
 			secured_message, &spdm_secured_message_callbacks_t);
 		if (RETURN_ERROR(status)) {
 			DEBUG((DEBUG_ERROR,
-			       "spdm_encode_secured_message - %p\n", status));
+			       "spdm_encode_secured_message_in_place - %p\n",
+			       status));
 			return status;
 		}
 
@@ -214,6 +240,7 @@ return_status spdm_transport_mctp_encode_message(
   @param  is_requester                  Indicates if it is a requester message.
   @param  transport_message_size         size in bytes of the transport message data buffer.
   @param  transport_message             A pointer to a source buffer to store the transport message.
+                                       A secured message is verified and decrypted in place in this buffer.
   @param  message_size                  size in bytes of the message data buffer.
   @param  message                      A pointer to a destination buffer to store the message.
 
@@ -224,15 +251,15 @@ return_status spdm_transport_mctp_encode_message(
 return_status spdm_transport_mctp_decode_message(
 	IN void *spdm_context, OUT uint32 **session_id,
 	OUT boolean *is_app_message, IN boolean is_requester,
-	IN uintn transport_message_size, IN void *transport_message,
+	IN uintn transport_message_size, IN OUT void *transport_message,
 	IN OUT uintn *message_size, OUT void *message)
 {
 	return_status status;
 	transport_decode_message_func transport_decode_message;
 	uint32 *SecuredMessageSessionId;
-	uint8 secured_message[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+	uint8 *secured_message;
 	uintn secured_message_size;
-	uint8 app_message[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+	void *app_message;
 	uintn app_message_size;
 	spdm_secured_message_callbacks_t spdm_secured_message_callbacks_t;
 	void *secured_message_context;
@@ -256,8 +283,9 @@ return_status spdm_transport_mctp_decode_message(
 	transport_decode_message = mctp_decode_message;
 
 	SecuredMessageSessionId = NULL;
-	// Detect received message
-	secured_message_size = sizeof(secured_message);
+	// Detect received message, the payload is left in place behind the transport header.
+	secured_message = (uint8 *)transport_message + sizeof(mctp_message_header_t);
+	secured_message_size = transport_message_size - sizeof(mctp_message_header_t);
 	status = transport_decode_message(
 		&SecuredMessageSessionId, transport_message_size,
 		transport_message, &secured_message_size, secured_message);
@@ -280,16 +308,16 @@ return_status spdm_transport_mctp_decode_message(
 			return RETURN_UNSUPPORTED;
 		}
 
-		// Secured message to APP message
-		app_message_size = sizeof(app_message);
-		status = spdm_decode_secured_message(
+		// Secured message to APP message, in place
+		status = spdm_decode_secured_message_in_place(
 			secured_message_context, *SecuredMessageSessionId,
 			is_requester, secured_message_size, secured_message,
-			&app_message_size, app_message,
+			&app_message_size, &app_message,
 			&spdm_secured_message_callbacks_t);
 		if (RETURN_ERROR(status)) {
 			DEBUG((DEBUG_ERROR,
-			       "spdm_decode_secured_message - %p\n", status));
+			       "spdm_decode_secured_message_in_place - %p\n",
+			       status));
 			spdm_secured_message_get_last_spdm_error_struct(
 				secured_message_context, &spdm_error);
 			spdm_set_last_spdm_error_struct(spdm_context,
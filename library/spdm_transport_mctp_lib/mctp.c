@@ -93,8 +93,15 @@ return_status mctp_encode_message(IN uint32 *session_id, IN uintn message_size,
 	} else {
 		mctp_message_header->message_type = MCTP_MESSAGE_TYPE_SPDM;
 	}
-	copy_mem((uint8 *)transport_message + sizeof(mctp_message_header_t),
-		 message, message_size);
+	//
+	// The message may have been built in place behind the MCTP header.
+	//
+	if (message !=
+	    (uint8 *)transport_message + sizeof(mctp_message_header_t)) {
+		copy_mem((uint8 *)transport_message +
+				 sizeof(mctp_message_header_t),
+			 message, message_size);
+	}
 	zero_mem((uint8 *)transport_message + sizeof(mctp_message_header_t) +
 			 message_size,
 		 *transport_message_size - sizeof(mctp_message_header_t) -
@@ -179,8 +186,15 @@ return_status mctp_decode_message(OUT uint32 **session_id,
 		return RETURN_BUFFER_TOO_SMALL;
 	}
 	*message_size = transport_message_size - sizeof(mctp_message_header_t);
-	copy_mem(message,
-		 (uint8 *)transport_message + sizeof(mctp_message_header_t),
-		 *message_size);
+	//
+	// The caller may decode the message in place behind the MCTP header.
+	//
+	if (message !=
+	    (uint8 *)transport_message + sizeof(mctp_message_header_t)) {
+		copy_mem(message,
+			 (uint8 *)transport_message +
+				 sizeof(mctp_message_header_t),
+			 *message_size);
+	}
 	return RETURN_SUCCESS;
 }
@@ -105,9 +105,15 @@ return_status pci_doe_encode_message(IN uint32 *session_id,
 			(uint32)*transport_message_size / sizeof(uint32);
 	}
 
-	copy_mem((uint8 *)transport_message +
-			 sizeof(pci_doe_data_object_header_t),
-		 message, message_size);
+	//
+	// The message may have been built in place behind the PCI DOE header.
+	//
+	if (message != (uint8 *)transport_message +
+			       sizeof(pci_doe_data_object_header_t)) {
+		copy_mem((uint8 *)transport_message +
+				 sizeof(pci_doe_data_object_header_t),
+			 message, message_size);
+	}
 	zero_mem((uint8 *)transport_message +
 			 sizeof(pci_doe_data_object_header_t) + message_size,
 		 *transport_message_size -
@@ -214,9 +220,15 @@ return_status pci_doe_decode_message(OUT uint32 **session_id,
 	}
 	*message_size =
 		transport_message_size - sizeof(pci_doe_data_object_header_t);
-	copy_mem(message,
-		 (uint8 *)transport_message +
-			 sizeof(pci_doe_data_object_header_t),
-		 *message_size);
+	//
+	// The caller may decode the message in place behind the PCI DOE header.
+	//
+	if (message != (uint8 *)transport_message +
+			       sizeof(pci_doe_data_object_header_t)) {
+		copy_mem(message,
+			 (uint8 *)transport_message +
+				 sizeof(pci_doe_data_object_header_t),
+			 *message_size);
+	}
 	return RETURN_SUCCESS;
 }
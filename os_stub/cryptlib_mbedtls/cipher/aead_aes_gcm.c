@@ -45,24 +45,168 @@ boolean aead_aes_gcm_encrypt(IN const uint8 *key, IN uintn key_size,
 			     OUT uint8 *tag_out, IN uintn tag_size,
 			     OUT uint8 *data_out, OUT uintn *data_out_size)
 {
-	mbedtls_gcm_context ctx;
-	int32 ret;
+	void *aead_aes_gcm_ctx;
+	boolean ret_value;
 
-	if (data_in_size > INT_MAX) {
-		return FALSE;
-	}
-	if (a_data_size > INT_MAX) {
+	aead_aes_gcm_ctx = aead_aes_gcm_new(key, key_size);
+	if (aead_aes_gcm_ctx == NULL) {
 		return FALSE;
 	}
-	if (iv_size != 12) {
+	ret_value = aead_aes_gcm_encrypt_with_context(
+		aead_aes_gcm_ctx, iv, iv_size, a_data, a_data_size, data_in,
+		data_in_size, tag_out, tag_size, data_out, data_out_size);
+	aead_aes_gcm_free(aead_aes_gcm_ctx);
+
+	return ret_value;
+}
+
+/**
+  Performs AEAD AES-GCM authenticated decryption on a data buffer and additional authenticated data (AAD).
+
+  iv_size must be 12, otherwise FALSE is returned.
+  key_size must be 16, 24 or 32, otherwise FALSE is returned.
+  tag_size must be 12, 13, 14, 15, 16, otherwise FALSE is returned.
+  If additional authenticated data verification fails, FALSE is returned.
+
+  @param[in]   key         Pointer to the encryption key.
+  @param[in]   key_size     size of the encryption key in bytes.
+  @param[in]   iv          Pointer to the IV value.
+  @param[in]   iv_size      size of the IV value in bytes.
+  @param[in]   a_data       Pointer to the additional authenticated data (AAD).
+  @param[in]   a_data_size   size of the additional authenticated data (AAD) in bytes.
+  @param[in]   data_in      Pointer to the input data buffer to be decrypted.
+  @param[in]   data_in_size  size of the input data buffer in bytes.
+  @param[in]   tag         Pointer to a buffer that contains the authentication tag.
+  @param[in]   tag_size     size of the authentication tag in bytes.
+  @param[out]  data_out     Pointer to a buffer that receives the decryption output.
+  @param[out]  data_out_size size of the output data buffer in bytes.
+
+  @retval TRUE   AEAD AES-GCM authenticated decryption succeeded.
+  @retval FALSE  AEAD AES-GCM authenticated decryption failed.
+
+**/
+boolean aead_aes_gcm_decrypt(IN const uint8 *key, IN uintn key_size,
+			     IN const uint8 *iv, IN uintn iv_size,
+			     IN const uint8 *a_data, IN uintn a_data_size,
+			     IN const uint8 *data_in, IN uintn data_in_size,
+			     IN const uint8 *tag, IN uintn tag_size,
+			     OUT uint8 *data_out, OUT uintn *data_out_size)
+{
+	void *aead_aes_gcm_ctx;
+	boolean ret_value;
+
+	aead_aes_gcm_ctx = aead_aes_gcm_new(key, key_size);
+	if (aead_aes_gcm_ctx == NULL) {
 		return FALSE;
 	}
+	ret_value = aead_aes_gcm_decrypt_with_context(
+		aead_aes_gcm_ctx, iv, iv_size, a_data, a_data_size, data_in,
+		data_in_size, tag, tag_size, data_out, data_out_size);
+	aead_aes_gcm_free(aead_aes_gcm_ctx);
+
+	return ret_value;
+}
+
+/**
+  Allocates and initializes one AEAD AES-GCM context for subsequent use.
+
+  The key schedule is performed once here, and the context can be used for any number of
+  aead_aes_gcm_encrypt_with_context() and aead_aes_gcm_decrypt_with_context() calls
+  until it is released by aead_aes_gcm_free().
+
+  key_size must be 16, 24 or 32, otherwise NULL is returned.
+
+  @param[in]   key         Pointer to the encryption key.
+  @param[in]   key_size     size of the encryption key in bytes.
+
+  @return  Pointer to the AEAD AES-GCM context that has been initialized.
+           If the allocations fails, aead_aes_gcm_new() returns NULL.
+
+**/
+void *aead_aes_gcm_new(IN const uint8 *key, IN uintn key_size)
+{
+	mbedtls_gcm_context *ctx;
+	int32 ret;
+
 	switch (key_size) {
 	case 16:
 	case 24:
 	case 32:
 		break;
 	default:
+		return NULL;
+	}
+
+	ctx = allocate_zero_pool(sizeof(mbedtls_gcm_context));
+	if (ctx == NULL) {
+		return NULL;
+	}
+
+	mbedtls_gcm_init(ctx);
+	ret = mbedtls_gcm_setkey(ctx, MBEDTLS_CIPHER_ID_AES, key,
+				 (uint32)(key_size * 8));
+	if (ret != 0) {
+		mbedtls_gcm_free(ctx);
+		free_pool(ctx);
+		return NULL;
+	}
+
+	return ctx;
+}
+
+/**
+  Release the specified AEAD AES-GCM context.
+
+  @param[in]  aead_aes_gcm_ctx  Pointer to the AEAD AES-GCM context to be released.
+
+**/
+void aead_aes_gcm_free(IN void *aead_aes_gcm_ctx)
+{
+	if (aead_aes_gcm_ctx == NULL) {
+		return;
+	}
+	mbedtls_gcm_free(aead_aes_gcm_ctx);
+	free_pool(aead_aes_gcm_ctx);
+}
+
+/**
+  Performs AEAD AES-GCM authenticated encryption on a data buffer and additional authenticated data (AAD),
+  with a keyed AEAD AES-GCM context.
+
+  iv_size must be 12, otherwise FALSE is returned.
+  tag_size must be 12, 13, 14, 15, 16, otherwise FALSE is returned.
+
+  @param[in]   aead_aes_gcm_ctx  Pointer to the AEAD AES-GCM context.
+  @param[in]   iv          Pointer to the IV value.
+  @param[in]   iv_size      size of the IV value in bytes.
+  @param[in]   a_data       Pointer to the additional authenticated data (AAD).
+  @param[in]   a_data_size   size of the additional authenticated data (AAD) in bytes.
+  @param[in]   data_in      Pointer to the input data buffer to be encrypted.
+  @param[in]   data_in_size  size of the input data buffer in bytes.
+  @param[out]  tag_out      Pointer to a buffer that receives the authentication tag output.
+  @param[in]   tag_size     size of the authentication tag in bytes.
+  @param[out]  data_out     Pointer to a buffer that receives the encryption output.
+  @param[out]  data_out_size size of the output data buffer in bytes.
+
+  @retval TRUE   AEAD AES-GCM authenticated encryption succeeded.
+  @retval FALSE  AEAD AES-GCM authenticated encryption failed.
+
+**/
+boolean aead_aes_gcm_encrypt_with_context(
+	IN void *aead_aes_gcm_ctx, IN const uint8 *iv, IN uintn iv_size,
+	IN const uint8 *a_data, IN uintn a_data_size, IN const uint8 *data_in,
+	IN uintn data_in_size, OUT uint8 *tag_out, IN uintn tag_size,
+	OUT uint8 *data_out, OUT uintn *data_out_size)
+{
+	int32 ret;
+
+	if (data_in_size > INT_MAX) {
+		return FALSE;
+	}
+	if (a_data_size > INT_MAX) {
+		return FALSE;
+	}
+	if (iv_size != 12) {
 		return FALSE;
 	}
 	if ((tag_size != 12) && (tag_size != 13) && (tag_size != 14) &&
@@ -76,20 +220,15 @@ boolean aead_aes_gcm_encrypt(IN const uint8 *key, IN uintn key_size,
 		}
 	}
 
-	mbedtls_gcm_init(&ctx);
-
-	ret = mbedtls_gcm_setkey(&ctx, MBEDTLS_CIPHER_ID_AES, key,
-				 (uint32)(key_size * 8));
-	if (ret != 0) {
+	if (aead_aes_gcm_ctx == NULL) {
 		return FALSE;
 	}
 
-	ret = mbedtls_gcm_crypt_and_tag(&ctx, MBEDTLS_GCM_ENCRYPT,
+	ret = mbedtls_gcm_crypt_and_tag(aead_aes_gcm_ctx, MBEDTLS_GCM_ENCRYPT,
 					(uint32)data_in_size, iv,
 					(uint32)iv_size, a_data,
 					(uint32)a_data_size, data_in, data_out,
 					tag_size, tag_out);
-	mbedtls_gcm_free(&ctx);
 	if (ret != 0) {
 		return FALSE;
 	}
@@ -101,15 +240,14 @@ boolean aead_aes_gcm_encrypt(IN const uint8 *key, IN uintn key_size,
 }
 
 /**
-  Performs AEAD AES-GCM authenticated decryption on a data buffer and additional authenticated data (AAD).
+  Performs AEAD AES-GCM authenticated decryption on a data buffer and additional authenticated data (AAD),
+  with a keyed AEAD AES-GCM context.
 
   iv_size must be 12, otherwise FALSE is returned.
-  key_size must be 16, 24 or 32, otherwise FALSE is returned.
   tag_size must be 12, 13, 14, 15, 16, otherwise FALSE is returned.
   If additional authenticated data verification fails, FALSE is returned.
 
-  @param[in]   key         Pointer to the encryption key.
-  @param[in]   key_size     size of the encryption key in bytes.
+  @param[in]   aead_aes_gcm_ctx  Pointer to the AEAD AES-GCM context.
   @param[in]   iv          Pointer to the IV value.
   @param[in]   iv_size      size of the IV value in bytes.
   @param[in]   a_data       Pointer to the additional authenticated data (AAD).
@@ -125,14 +263,12 @@ boolean aead_aes_gcm_encrypt(IN const uint8 *key, IN uintn key_size,
   @retval FALSE  AEAD AES-GCM authenticated decryption failed.
 
 **/
-boolean aead_aes_gcm_decrypt(IN const uint8 *key, IN uintn key_size,
-			     IN const uint8 *iv, IN uintn iv_size,
-			     IN const uint8 *a_data, IN uintn a_data_size,
-			     IN const uint8 *data_in, IN uintn data_in_size,
-			     IN const uint8 *tag, IN uintn tag_size,
-			     OUT uint8 *data_out, OUT uintn *data_out_size)
+boolean aead_aes_gcm_decrypt_with_context(
+	IN void *aead_aes_gcm_ctx, IN const uint8 *iv, IN uintn iv_size,
+	IN const uint8 *a_data, IN uintn a_data_size, IN const uint8 *data_in,
+	IN uintn data_in_size, IN const uint8 *tag, IN uintn tag_size,
+	OUT uint8 *data_out, OUT uintn *data_out_size)
 {
-	mbedtls_gcm_context ctx;
 	int32 ret;
 
 	if (data_in_size > INT_MAX) {
@@ -144,14 +280,6 @@ boolean aead_aes_gcm_decrypt(IN const uint8 *key, IN uintn key_size,
 	if (iv_size != 12) {
 		return FALSE;
 	}
-	switch (key_size) {
-	case 16:
-	case 24:
-	case 32:
-		break;
-	default:
-		return FALSE;
-	}
 	if ((tag_size != 12) && (tag_size != 13) && (tag_size != 14) &&
 	    (tag_size != 15) && (tag_size != 16)) {
 		return FALSE;
@@ -163,19 +291,14 @@ boolean aead_aes_gcm_decrypt(IN const uint8 *key, IN uintn key_size,
 		}
 	}
 
-	mbedtls_gcm_init(&ctx);
-
-	ret = mbedtls_gcm_setkey(&ctx, MBEDTLS_CIPHER_ID_AES, key,
-				 (uint32)(key_size * 8));
-	if (ret != 0) {
+	if (aead_aes_gcm_ctx == NULL) {
 		return FALSE;
 	}
 
-	ret = mbedtls_gcm_auth_decrypt(&ctx, (uint32)data_in_size, iv,
-				       (uint32)iv_size, a_data,
+	ret = mbedtls_gcm_auth_decrypt(aead_aes_gcm_ctx, (uint32)data_in_size,
+				       iv, (uint32)iv_size, a_data,
 				       (uint32)a_data_size, tag,
 				       (uint32)tag_size, data_in, data_out);
-	mbedtls_gcm_free(&ctx);
 	if (ret != 0) {
 		return FALSE;
 	}
@@ -44,7 +44,152 @@ boolean aead_chacha20_poly1305_encrypt(
 	IN const uint8 *data_in, IN uintn data_in_size, OUT uint8 *tag_out,
 	IN uintn tag_size, OUT uint8 *data_out, OUT uintn *data_out_size)
 {
-	mbedtls_chachapoly_context ctx;
+	void *aead_chacha20_poly1305_ctx;
+	boolean ret_value;
+
+	aead_chacha20_poly1305_ctx = aead_chacha20_poly1305_new(key, key_size);
+	if (aead_chacha20_poly1305_ctx == NULL) {
+		return FALSE;
+	}
+	ret_value = aead_chacha20_poly1305_encrypt_with_context(
+		aead_chacha20_poly1305_ctx, iv, iv_size, a_data, a_data_size, data_in,
+		data_in_size, tag_out, tag_size, data_out, data_out_size);
+	aead_chacha20_poly1305_free(aead_chacha20_poly1305_ctx);
+
+	return ret_value;
+}
+
+/**
+  Performs AEAD ChaCha20Poly1305 authenticated decryption on a data buffer and additional authenticated data (AAD).
+
+  iv_size must be 12, otherwise FALSE is returned.
+  key_size must be 32, otherwise FALSE is returned.
+  tag_size must be 16, otherwise FALSE is returned.
+  If additional authenticated data verification fails, FALSE is returned.
+
+  @param[in]   key         Pointer to the encryption key.
+  @param[in]   key_size     size of the encryption key in bytes.
+  @param[in]   iv          Pointer to the IV value.
+  @param[in]   iv_size      size of the IV value in bytes.
+  @param[in]   a_data       Pointer to the additional authenticated data (AAD).
+  @param[in]   a_data_size   size of the additional authenticated data (AAD) in bytes.
+  @param[in]   data_in      Pointer to the input data buffer to be decrypted.
+  @param[in]   data_in_size  size of the input data buffer in bytes.
+  @param[in]   tag         Pointer to a buffer that contains the authentication tag.
+  @param[in]   tag_size     size of the authentication tag in bytes.
+  @param[out]  data_out     Pointer to a buffer that receives the decryption output.
+  @param[out]  data_out_size size of the output data buffer in bytes.
+
+  @retval TRUE   AEAD ChaCha20Poly1305 authenticated decryption succeeded.
+  @retval FALSE  AEAD ChaCha20Poly1305 authenticated decryption failed.
+
+**/
+boolean aead_chacha20_poly1305_decrypt(
+	IN const uint8 *key, IN uintn key_size, IN const uint8 *iv,
+	IN uintn iv_size, IN const uint8 *a_data, IN uintn a_data_size,
+	IN const uint8 *data_in, IN uintn data_in_size, IN const uint8 *tag,
+	IN uintn tag_size, OUT uint8 *data_out, OUT uintn *data_out_size)
+{
+	void *aead_chacha20_poly1305_ctx;
+	boolean ret_value;
+
+	aead_chacha20_poly1305_ctx = aead_chacha20_poly1305_new(key, key_size);
+	if (aead_chacha20_poly1305_ctx == NULL) {
+		return FALSE;
+	}
+	ret_value = aead_chacha20_poly1305_decrypt_with_context(
+		aead_chacha20_poly1305_ctx, iv, iv_size, a_data, a_data_size, data_in,
+		data_in_size, tag, tag_size, data_out, data_out_size);
+	aead_chacha20_poly1305_free(aead_chacha20_poly1305_ctx);
+
+	return ret_value;
+}
+
+/**
+  Allocates and initializes one AEAD ChaCha20Poly1305 context for subsequent use.
+
+  The key schedule is performed once here, and the context can be used for any number of
+  aead_chacha20_poly1305_encrypt_with_context() and aead_chacha20_poly1305_decrypt_with_context() calls
+  until it is released by aead_chacha20_poly1305_free().
+
+  key_size must be 32, otherwise NULL is returned.
+
+  @param[in]   key         Pointer to the encryption key.
+  @param[in]   key_size     size of the encryption key in bytes.
+
+  @return  Pointer to the AEAD ChaCha20Poly1305 context that has been initialized.
+           If the allocations fails, aead_chacha20_poly1305_new() returns NULL.
+
+**/
+void *aead_chacha20_poly1305_new(IN const uint8 *key, IN uintn key_size)
+{
+	mbedtls_chachapoly_context *ctx;
+	int32 ret;
+
+	if (key_size != 32) {
+		return NULL;
+	}
+
+	ctx = allocate_zero_pool(sizeof(mbedtls_chachapoly_context));
+	if (ctx == NULL) {
+		return NULL;
+	}
+
+	mbedtls_chachapoly_init(ctx);
+	ret = mbedtls_chachapoly_setkey(ctx, key);
+	if (ret != 0) {
+		mbedtls_chachapoly_free(ctx);
+		free_pool(ctx);
+		return NULL;
+	}
+
+	return ctx;
+}
+
+/**
+  Release the specified AEAD ChaCha20Poly1305 context.
+
+  @param[in]  aead_chacha20_poly1305_ctx  Pointer to the AEAD ChaCha20Poly1305 context to be released.
+
+**/
+void aead_chacha20_poly1305_free(IN void *aead_chacha20_poly1305_ctx)
+{
+	if (aead_chacha20_poly1305_ctx == NULL) {
+		return;
+	}
+	mbedtls_chachapoly_free(aead_chacha20_poly1305_ctx);
+	free_pool(aead_chacha20_poly1305_ctx);
+}
+
+/**
+  Performs AEAD ChaCha20Poly1305 authenticated encryption on a data buffer and additional authenticated data (AAD),
+  with a keyed AEAD ChaCha20Poly1305 context.
+
+  iv_size must be 12, otherwise FALSE is returned.
+  tag_size must be 16, otherwise FALSE is returned.
+
+  @param[in]   aead_chacha20_poly1305_ctx  Pointer to the AEAD ChaCha20Poly1305 context.
+  @param[in]   iv          Pointer to the IV value.
+  @param[in]   iv_size      size of the IV value in bytes.
+  @param[in]   a_data       Pointer to the additional authenticated data (AAD).
+  @param[in]   a_data_size   size of the additional authenticated data (AAD) in bytes.
+  @param[in]   data_in      Pointer to the input data buffer to be encrypted.
+  @param[in]   data_in_size  size of the input data buffer in bytes.
+  @param[out]  tag_out      Pointer to a buffer that receives the authentication tag output.
+  @param[in]   tag_size     size of the authentication tag in bytes.
+  @param[out]  data_out     Pointer to a buffer that receives the encryption output.
+  @param[out]  data_out_size size of the output data buffer in bytes.
+
+  @retval TRUE   AEAD ChaCha20Poly1305 authenticated encryption succeeded.
+  @retval FALSE  AEAD ChaCha20Poly1305 authenticated encryption failed.
+
+**/
+boolean aead_chacha20_poly1305_encrypt_with_context(
+	IN void *aead_chacha20_poly1305_ctx, IN const uint8 *iv, IN uintn iv_size,
+	IN const uint8 *a_data, IN uintn a_data_size, IN const uint8 *data_in,
+	IN uintn data_in_size, OUT uint8 *tag_out, IN uintn tag_size,
+	OUT uint8 *data_out, OUT uintn *data_out_size)
+{
 	int32 ret;
 
 	if (data_in_size > INT_MAX) {
@@ -56,9 +201,6 @@ boolean aead_chacha20_poly1305_encrypt(
 	if (iv_size != 12) {
 		return FALSE;
 	}
-	if (key_size != 32) {
-		return FALSE;
-	}
 	if (tag_size != 16) {
 		return FALSE;
 	}
@@ -69,17 +211,13 @@ boolean aead_chacha20_poly1305_encrypt(
 		}
 	}
 
-	mbedtls_chachapoly_init(&ctx);
-
-	ret = mbedtls_chachapoly_setkey(&ctx, key);
-	if (ret != 0) {
+	if (aead_chacha20_poly1305_ctx == NULL) {
 		return FALSE;
 	}
 
-	ret = mbedtls_chachapoly_encrypt_and_tag(&ctx, (uint32)data_in_size, iv,
-						 a_data, (uint32)a_data_size,
-						 data_in, data_out, tag_out);
-	mbedtls_chachapoly_free(&ctx);
+	ret = mbedtls_chachapoly_encrypt_and_tag(
+		aead_chacha20_poly1305_ctx, (uint32)data_in_size, iv, a_data,
+		(uint32)a_data_size, data_in, data_out, tag_out);
 	if (ret != 0) {
 		return FALSE;
 	}
@@ -91,15 +229,14 @@ boolean aead_chacha20_poly1305_encrypt(
 }
 
 /**
-  Performs AEAD ChaCha20Poly1305 authenticated decryption on a data buffer and additional authenticated data (AAD).
+  Performs AEAD ChaCha20Poly1305 authenticated decryption on a data buffer and additional authenticated data (AAD),
+  with a keyed AEAD ChaCha20Poly1305 context.
 
   iv_size must be 12, otherwise FALSE is returned.
-  key_size must be 32, otherwise FALSE is returned.
   tag_size must be 16, otherwise FALSE is returned.
   If additional authenticated data verification fails, FALSE is returned.
 
-  @param[in]   key         Pointer to the encryption key.
-  @param[in]   key_size     size of the encryption key in bytes.
+  @param[in]   aead_chacha20_poly1305_ctx  Pointer to the AEAD ChaCha20Poly1305 context.
   @param[in]   iv          Pointer to the IV value.
   @param[in]   iv_size      size of the IV value in bytes.
   @param[in]   a_data       Pointer to the additional authenticated data (AAD).
@@ -115,13 +252,12 @@ boolean aead_chacha20_poly1305_encrypt(
   @retval FALSE  AEAD ChaCha20Poly1305 authenticated decryption failed.
 
 **/
-boolean aead_chacha20_poly1305_decrypt(
-	IN const uint8 *key, IN uintn key_size, IN const uint8 *iv,
-	IN uintn iv_size, IN const uint8 *a_data, IN uintn a_data_size,
-	IN const uint8 *data_in, IN uintn data_in_size, IN const uint8 *tag,
-	IN uintn tag_size, OUT uint8 *data_out, OUT uintn *data_out_size)
+boolean aead_chacha20_poly1305_decrypt_with_context(
+	IN void *aead_chacha20_poly1305_ctx, IN const uint8 *iv, IN uintn iv_size,
+	IN const uint8 *a_data, IN uintn a_data_size, IN const uint8 *data_in,
+	IN uintn data_in_size, IN const uint8 *tag, IN uintn tag_size,
+	OUT uint8 *data_out, OUT uintn *data_out_size)
 {
-	mbedtls_chachapoly_context ctx;
 	int32 ret;
 
 	if (data_in_size > INT_MAX) {
@@ -133,9 +269,6 @@ boolean aead_chacha20_poly1305_decrypt(
 	if (iv_size != 12) {
 		return FALSE;
 	}
-	if (key_size != 32) {
-		return FALSE;
-	}
 	if (tag_size != 16) {
 		return FALSE;
 	}
@@ -146,17 +279,13 @@ boolean aead_chacha20_poly1305_decrypt(
 		}
 	}
 
-	mbedtls_chachapoly_init(&ctx);
-
-	ret = mbedtls_chachapoly_setkey(&ctx, key);
-	if (ret != 0) {
+	if (aead_chacha20_poly1305_ctx == NULL) {
 		return FALSE;
 	}
 
-	ret = mbedtls_chachapoly_auth_decrypt(&ctx, (uint32)data_in_size, iv,
-					      a_data, (uint32)a_data_size, tag,
-					      data_in, data_out);
-	mbedtls_chachapoly_free(&ctx);
+	ret = mbedtls_chachapoly_auth_decrypt(
+		aead_chacha20_poly1305_ctx, (uint32)data_in_size, iv, a_data,
+		(uint32)a_data_size, tag, data_in, data_out);
 	if (ret != 0) {
 		return FALSE;
 	}
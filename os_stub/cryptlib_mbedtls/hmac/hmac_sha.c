@@ -100,16 +100,49 @@ boolean hmac_md_set_key(IN mbedtls_md_type_t md_type, OUT void *hmac_md_ctx,
 **/
 boolean hmac_md_duplicate(IN const void *hmac_md_ctx, OUT void *new_hmac_md_ctx)
 {
+	const mbedtls_md_context_t *md_ctx;
+	mbedtls_md_context_t *new_md_ctx;
+	uintn block_size;
 	int32 ret;
 
 	if (hmac_md_ctx == NULL || new_hmac_md_ctx == NULL) {
 		return FALSE;
 	}
 
-	ret = mbedtls_md_clone(new_hmac_md_ctx, hmac_md_ctx);
+	md_ctx = hmac_md_ctx;
+	new_md_ctx = new_hmac_md_ctx;
+	if (md_ctx->md_info == NULL || md_ctx->hmac_ctx == NULL) {
+		return FALSE;
+	}
+
+	if (new_md_ctx->md_info != md_ctx->md_info) {
+		mbedtls_md_free(new_md_ctx);
+		mbedtls_md_init(new_md_ctx);
+		ret = mbedtls_md_setup(new_md_ctx, md_ctx->md_info, 1);
+		if (ret != 0) {
+			return FALSE;
+		}
+	}
+
+	ret = mbedtls_md_clone(new_md_ctx, md_ctx);
 	if (ret != 0) {
 		return FALSE;
 	}
+
+	//
+	// mbedtls_md_clone() only copies the digest state.
+	// Copy the inner and outer padded key as well.
+	//
+	switch (mbedtls_md_get_type(md_ctx->md_info)) {
+	case MBEDTLS_MD_SHA384:
+	case MBEDTLS_MD_SHA512:
+		block_size = 128;
+		break;
+	default:
+		block_size = 64;
+		break;
+	}
+	copy_mem(new_md_ctx->hmac_ctx, md_ctx->hmac_ctx, block_size * 2);
 	return TRUE;
 }
 
@@ -44,6 +44,162 @@ boolean aead_chacha20_poly1305_encrypt(
 	IN uintn iv_size, IN const uint8 *a_data, IN uintn a_data_size,
 	IN const uint8 *data_in, IN uintn data_in_size, OUT uint8 *tag_out,
 	IN uintn tag_size, OUT uint8 *data_out, OUT uintn *data_out_size)
+{
+	void *aead_chacha20_poly1305_ctx;
+	boolean ret_value;
+
+	aead_chacha20_poly1305_ctx = aead_chacha20_poly1305_new(key, key_size);
+	if (aead_chacha20_poly1305_ctx == NULL) {
+		return FALSE;
+	}
+	ret_value = aead_chacha20_poly1305_encrypt_with_context(
+		aead_chacha20_poly1305_ctx, iv, iv_size, a_data, a_data_size, data_in,
+		data_in_size, tag_out, tag_size, data_out, data_out_size);
+	aead_chacha20_poly1305_free(aead_chacha20_poly1305_ctx);
+
+	return ret_value;
+}
+
+/**
+  Performs AEAD ChaCha20Poly1305 authenticated decryption on a data buffer and additional authenticated data (AAD).
+
+  iv_size must be 12, otherwise FALSE is returned.
+  key_size must be 32, otherwise FALSE is returned.
+  tag_size must be 16, otherwise FALSE is returned.
+  If additional authenticated data verification fails, FALSE is returned.
+
+  @param[in]   key         Pointer to the encryption key.
+  @param[in]   key_size     size of the encryption key in bytes.
+  @param[in]   iv          Pointer to the IV value.
+  @param[in]   iv_size      size of the IV value in bytes.
+  @param[in]   a_data       Pointer to the additional authenticated data (AAD).
+  @param[in]   a_data_size   size of the additional authenticated data (AAD) in bytes.
+  @param[in]   data_in      Pointer to the input data buffer to be decrypted.
+  @param[in]   data_in_size  size of the input data buffer in bytes.
+  @param[in]   tag         Pointer to a buffer that contains the authentication tag.
+  @param[in]   tag_size     size of the authentication tag in bytes.
+  @param[out]  data_out     Pointer to a buffer that receives the decryption output.
+  @param[out]  data_out_size size of the output data buffer in bytes.
+
+  @retval TRUE   AEAD ChaCha20Poly1305 authenticated decryption succeeded.
+  @retval FALSE  AEAD ChaCha20Poly1305 authenticated decryption failed.
+
+**/
+boolean aead_chacha20_poly1305_decrypt(
+	IN const uint8 *key, IN uintn key_size, IN const uint8 *iv,
+	IN uintn iv_size, IN const uint8 *a_data, IN uintn a_data_size,
+	IN const uint8 *data_in, IN uintn data_in_size, IN const uint8 *tag,
+	IN uintn tag_size, OUT uint8 *data_out, OUT uintn *data_out_size)
+{
+	void *aead_chacha20_poly1305_ctx;
+	boolean ret_value;
+
+	aead_chacha20_poly1305_ctx = aead_chacha20_poly1305_new(key, key_size);
+	if (aead_chacha20_poly1305_ctx == NULL) {
+		return FALSE;
+	}
+	ret_value = aead_chacha20_poly1305_decrypt_with_context(
+		aead_chacha20_poly1305_ctx, iv, iv_size, a_data, a_data_size, data_in,
+		data_in_size, tag, tag_size, data_out, data_out_size);
+	aead_chacha20_poly1305_free(aead_chacha20_poly1305_ctx);
+
+	return ret_value;
+}
+
+/**
+  Allocates and initializes one AEAD ChaCha20Poly1305 context for subsequent use.
+
+  The key schedule is performed once here, and the context can be used for any number of
+  aead_chacha20_poly1305_encrypt_with_context() and aead_chacha20_poly1305_decrypt_with_context() calls
+  until it is released by aead_chacha20_poly1305_free().
+
+  key_size must be 32, otherwise NULL is returned.
+
+  @param[in]   key         Pointer to the encryption key.
+  @param[in]   key_size     size of the encryption key in bytes.
+
+  @return  Pointer to the AEAD ChaCha20Poly1305 context that has been initialized.
+           If the allocations fails, aead_chacha20_poly1305_new() returns NULL.
+
+**/
+void *aead_chacha20_poly1305_new(IN const uint8 *key, IN uintn key_size)
+{
+	EVP_CIPHER_CTX *ctx;
+	const EVP_CIPHER *cipher;
+	boolean ret_value;
+
+	if (key_size != 32) {
+		return NULL;
+	}
+	cipher = EVP_chacha20_poly1305();
+
+	ctx = EVP_CIPHER_CTX_new();
+	if (ctx == NULL) {
+		return NULL;
+	}
+
+	ret_value =
+		(boolean)EVP_CipherInit_ex(ctx, cipher, NULL, NULL, NULL, 1);
+	if (!ret_value) {
+		goto done;
+	}
+
+	ret_value =
+		(boolean)EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_AEAD_SET_IVLEN, 12, NULL);
+	if (!ret_value) {
+		goto done;
+	}
+
+	ret_value = (boolean)EVP_CipherInit_ex(ctx, NULL, NULL, key, NULL, -1);
+
+done:
+	if (!ret_value) {
+		EVP_CIPHER_CTX_free(ctx);
+		return NULL;
+	}
+
+	return ctx;
+}
+
+/**
+  Release the specified AEAD ChaCha20Poly1305 context.
+
+  @param[in]  aead_chacha20_poly1305_ctx  Pointer to the AEAD ChaCha20Poly1305 context to be released.
+
+**/
+void aead_chacha20_poly1305_free(IN void *aead_chacha20_poly1305_ctx)
+{
+	EVP_CIPHER_CTX_free((EVP_CIPHER_CTX *)aead_chacha20_poly1305_ctx);
+}
+
+/**
+  Performs AEAD ChaCha20Poly1305 authenticated encryption on a data buffer and additional authenticated data (AAD),
+  with a keyed AEAD ChaCha20Poly1305 context.
+
+  iv_size must be 12, otherwise FALSE is returned.
+  tag_size must be 16, otherwise FALSE is returned.
+
+  @param[in]   aead_chacha20_poly1305_ctx  Pointer to the AEAD ChaCha20Poly1305 context.
+  @param[in]   iv          Pointer to the IV value.
+  @param[in]   iv_size      size of the IV value in bytes.
+  @param[in]   a_data       Pointer to the additional authenticated data (AAD).
+  @param[in]   a_data_size   size of the additional authenticated data (AAD) in bytes.
+  @param[in]   data_in      Pointer to the input data buffer to be encrypted.
+  @param[in]   data_in_size  size of the input data buffer in bytes.
+  @param[out]  tag_out      Pointer to a buffer that receives the authentication tag output.
+  @param[in]   tag_size     size of the authentication tag in bytes.
+  @param[out]  data_out     Pointer to a buffer that receives the encryption output.
+  @param[out]  data_out_size size of the output data buffer in bytes.
+
+  @retval TRUE   AEAD ChaCha20Poly1305 authenticated encryption succeeded.
+  @retval FALSE  AEAD ChaCha20Poly1305 authenticated encryption failed.
+
+**/
+boolean aead_chacha20_poly1305_encrypt_with_context(
+	IN void *aead_chacha20_poly1305_ctx, IN const uint8 *iv, IN uintn iv_size,
+	IN const uint8 *a_data, IN uintn a_data_size, IN const uint8 *data_in,
+	IN uintn data_in_size, OUT uint8 *tag_out, IN uintn tag_size,
+	OUT uint8 *data_out, OUT uintn *data_out_size)
 {
 	EVP_CIPHER_CTX *ctx;
 	uintn temp_out_size;
@@ -58,9 +214,6 @@ boolean aead_chacha20_poly1305_encrypt(
 	if (iv_size != 12) {
 		return FALSE;
 	}
-	if (key_size != 32) {
-		return FALSE;
-	}
 	if (tag_size != 16) {
 		return FALSE;
 	}
@@ -71,79 +224,66 @@ boolean aead_chacha20_poly1305_encrypt(
 		}
 	}
 
-	ctx = EVP_CIPHER_CTX_new();
+	ctx = aead_chacha20_poly1305_ctx;
 	if (ctx == NULL) {
 		return FALSE;
 	}
 
-	ret_value = (boolean)EVP_EncryptInit_ex(ctx, EVP_chacha20_poly1305(),
-						NULL, NULL, NULL);
+	//
+	// Only the IV is reset, the key schedule of the context is reused.
+	//
+	ret_value = (boolean)EVP_EncryptInit_ex(ctx, NULL, NULL, NULL, iv);
 	if (!ret_value) {
-		goto done;
-	}
-
-	ret_value = (boolean)EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_AEAD_SET_IVLEN,
-						 (int32)iv_size, NULL);
-	if (!ret_value) {
-		goto done;
+		return FALSE;
 	}
 
 	ret_value = (boolean)EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_AEAD_SET_TAG,
 						 (int32)tag_size, NULL);
 	if (!ret_value) {
-		goto done;
-	}
-
-	ret_value = (boolean)EVP_EncryptInit_ex(ctx, NULL, NULL, key, iv);
-	if (!ret_value) {
-		goto done;
+		return FALSE;
 	}
 
 	ret_value = (boolean)EVP_EncryptUpdate(
 		ctx, NULL, (int32 *)&temp_out_size, a_data, (int32)a_data_size);
 	if (!ret_value) {
-		goto done;
+		return FALSE;
 	}
 
 	ret_value = (boolean)EVP_EncryptUpdate(ctx, data_out,
 					       (int32 *)&temp_out_size, data_in,
 					       (int32)data_in_size);
 	if (!ret_value) {
-		goto done;
+		return FALSE;
 	}
 
 	ret_value = (boolean)EVP_EncryptFinal_ex(ctx, data_out,
 						 (int32 *)&temp_out_size);
 	if (!ret_value) {
-		goto done;
+		return FALSE;
 	}
 
 	ret_value = (boolean)EVP_CIPHER_CTX_ctrl(
 		ctx, EVP_CTRL_AEAD_GET_TAG, (int32)tag_size, (void *)tag_out);
-
-done:
-	EVP_CIPHER_CTX_free(ctx);
 	if (!ret_value) {
-		return ret_value;
+		return FALSE;
 	}
 
 	if (data_out_size != NULL) {
 		*data_out_size = data_in_size;
 	}
 
-	return ret_value;
+	return TRUE;
 }
 
 /**
-  Performs AEAD ChaCha20Poly1305 authenticated decryption on a data buffer and additional authenticated data (AAD).
+  Performs AEAD ChaCha20Poly1305 authenticated decryption on a data buffer and additional authenticated data (AAD),
+  with a keyed AEAD ChaCha20Poly1305 context.
 
   iv_size must be 12, otherwise FALSE is returned.
-  key_size must be 32, otherwise FALSE is returned.
   tag_size must be 16, otherwise FALSE is returned.
   If additional authenticated data verification fails, FALSE is returned.
 
-  @param[in]   key         Pointer to the encryption key.
-  @param[in]   key_size     size of the encryption key in bytes.
+  @param[in]   aead_chacha20_poly1305_ctx  Pointer to the AEAD ChaCha20Poly1305 context.
   @param[in]   iv          Pointer to the IV value.
   @param[in]   iv_size      size of the IV value in bytes.
   @param[in]   a_data       Pointer to the additional authenticated data (AAD).
@@ -159,11 +299,11 @@ done:
   @retval FALSE  AEAD ChaCha20Poly1305 authenticated decryption failed.
 
 **/
-boolean aead_chacha20_poly1305_decrypt(
-	IN const uint8 *key, IN uintn key_size, IN const uint8 *iv,
-	IN uintn iv_size, IN const uint8 *a_data, IN uintn a_data_size,
-	IN const uint8 *data_in, IN uintn data_in_size, IN const uint8 *tag,
-	IN uintn tag_size, OUT uint8 *data_out, OUT uintn *data_out_size)
+boolean aead_chacha20_poly1305_decrypt_with_context(
+	IN void *aead_chacha20_poly1305_ctx, IN const uint8 *iv, IN uintn iv_size,
+	IN const uint8 *a_data, IN uintn a_data_size, IN const uint8 *data_in,
+	IN uintn data_in_size, IN const uint8 *tag, IN uintn tag_size,
+	OUT uint8 *data_out, OUT uintn *data_out_size)
 {
 	EVP_CIPHER_CTX *ctx;
 	uintn temp_out_size;
@@ -178,9 +318,6 @@ boolean aead_chacha20_poly1305_decrypt(
 	if (iv_size != 12) {
 		return FALSE;
 	}
-	if (key_size != 32) {
-		return FALSE;
-	}
 	if (tag_size != 16) {
 		return FALSE;
 	}
@@ -191,59 +328,47 @@ boolean aead_chacha20_poly1305_decrypt(
 		}
 	}
 
-	ctx = EVP_CIPHER_CTX_new();
+	ctx = aead_chacha20_poly1305_ctx;
 	if (ctx == NULL) {
 		return FALSE;
 	}
 
-	ret_value = (boolean)EVP_DecryptInit_ex(ctx, EVP_chacha20_poly1305(),
-						NULL, NULL, NULL);
-	if (!ret_value) {
-		goto done;
-	}
-
-	ret_value = (boolean)EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_AEAD_SET_IVLEN,
-						 (int32)iv_size, NULL);
+	//
+	// Only the IV is reset, the key schedule of the context is reused.
+	//
+	ret_value = (boolean)EVP_DecryptInit_ex(ctx, NULL, NULL, NULL, iv);
 	if (!ret_value) {
-		goto done;
+		return FALSE;
 	}
 
 	ret_value = (boolean)EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_AEAD_SET_TAG,
 						 (int32)tag_size, (void *)tag);
 	if (!ret_value) {
-		goto done;
-	}
-
-	ret_value = (boolean)EVP_DecryptInit_ex(ctx, NULL, NULL, key, iv);
-	if (!ret_value) {
-		goto done;
+		return FALSE;
 	}
 
 	ret_value = (boolean)EVP_DecryptUpdate(
 		ctx, NULL, (int32 *)&temp_out_size, a_data, (int32)a_data_size);
 	if (!ret_value) {
-		goto done;
+		return FALSE;
 	}
 
 	ret_value = (boolean)EVP_DecryptUpdate(ctx, data_out,
 					       (int32 *)&temp_out_size, data_in,
 					       (int32)data_in_size);
 	if (!ret_value) {
-		goto done;
+		return FALSE;
 	}
 
 	ret_value = (boolean)EVP_DecryptFinal_ex(ctx, data_out,
 						 (int32 *)&temp_out_size);
-
-done:
-	EVP_CIPHER_CTX_free(ctx);
 	if (!ret_value) {
-		return ret_value;
+		return FALSE;
 	}
 
 	if (data_out_size != NULL) {
 		*data_out_size = data_in_size;
 	}
 
-	return ret_value;
+	return TRUE;
 }
@@ -0,0 +1,39 @@
+/**
+    Copyright Notice:
+    Copyright 2021 DMTF. All rights reserved.
+    License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+**/
+
+/** @file
+  zero_mem_secure() implementation.
+**/
+
+#include "base.h"
+
+/**
+  Fills a target buffer with zeros, and returns the target buffer.
+
+  This function fills length bytes of buffer with zeros, and returns buffer.
+  The stores are done through volatile pointers, so that they are not removed
+  by the compiler even if buffer is not used afterwards. It should be used to clear secrets.
+
+  If length > 0 and buffer is NULL, then ASSERT().
+  If length is greater than (MAX_ADDRESS - buffer + 1), then ASSERT().
+
+  @param  buffer      The pointer to the target buffer to fill with zeros.
+  @param  length      The number of bytes in buffer to fill with zeros.
+
+  @return buffer.
+
+**/
+void *zero_mem_secure(OUT void *buffer, IN uintn length)
+{
+	volatile uint8 *pointer;
+
+	pointer = (uint8 *)buffer;
+	while (length-- != 0) {
+		*(pointer++) = 0;
+	}
+
+	return buffer;
+}
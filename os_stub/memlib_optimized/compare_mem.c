@@ -0,0 +1,75 @@
+/**
+    Copyright Notice:
+    Copyright 2021 DMTF. All rights reserved.
+    License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+**/
+
+/** @file
+  const_compare_mem() implementation.
+
+  The aligned part of the buffers is compared one uintn at a time.
+**/
+
+#include "base.h"
+
+#define UINTN_ALIGN_MASK (sizeof(uintn) - 1)
+
+/**
+  Compares the contents of two buffers in const time.
+
+  This function compares length bytes of source_buffer to length bytes of destination_buffer.
+  If all length bytes of the two buffers are identical, then 0 is returned.  Otherwise, a
+  non-zero value is returned. The execution time only depends on length and the alignment
+  of the buffers, not on their contents.
+
+  If length > 0 and destination_buffer is NULL, then ASSERT().
+  If length > 0 and source_buffer is NULL, then ASSERT().
+  If length is greater than (MAX_ADDRESS - destination_buffer + 1), then ASSERT().
+  If length is greater than (MAX_ADDRESS - source_buffer + 1), then ASSERT().
+
+  @param  destination_buffer A pointer to the destination buffer to compare.
+  @param  source_buffer      A pointer to the source buffer to compare.
+  @param  length            The number of bytes to compare.
+
+  @return 0                 All length bytes of the two buffers are identical.
+  @retval Non-zero          There is mismatched between source_buffer and destination_buffer.
+
+**/
+intn const_compare_mem(IN const void *destination_buffer,
+		       IN const void *source_buffer, IN uintn length)
+{
+	const uint8 *pointer_dst;
+	const uint8 *pointer_src;
+	const uintn *pointer_dst_n;
+	const uintn *pointer_src_n;
+	uintn delta;
+
+	pointer_dst = (const uint8 *)destination_buffer;
+	pointer_src = (const uint8 *)source_buffer;
+	delta = 0;
+
+	if ((((uintn)pointer_dst ^ (uintn)pointer_src) & UINTN_ALIGN_MASK) ==
+	    0) {
+		while ((((uintn)pointer_dst & UINTN_ALIGN_MASK) != 0) &&
+		       (length != 0)) {
+			delta |= *(pointer_dst++) ^ *(pointer_src++);
+			length--;
+		}
+		pointer_dst_n = (const uintn *)pointer_dst;
+		pointer_src_n = (const uintn *)pointer_src;
+		while (length >= sizeof(uintn)) {
+			delta |= *(pointer_dst_n++) ^ *(pointer_src_n++);
+			length -= sizeof(uintn);
+		}
+		pointer_dst = (const uint8 *)pointer_dst_n;
+		pointer_src = (const uint8 *)pointer_src_n;
+	}
+	while (length-- != 0) {
+		delta |= *(pointer_dst++) ^ *(pointer_src++);
+	}
+
+	//
+	// Fold the difference into 0 or 1 without a data dependent branch.
+	//
+	return (intn)((delta | ((uintn)0 - delta)) >> (sizeof(uintn) * 8 - 1));
+}
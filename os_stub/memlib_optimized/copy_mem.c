@@ -0,0 +1,106 @@
+/**
+    Copyright Notice:
+    Copyright 2021 DMTF. All rights reserved.
+    License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+**/
+
+/** @file
+  copy_mem() implementation.
+
+  The aligned part of the buffers is copied one uintn at a time.
+**/
+
+#include "base.h"
+
+#define UINTN_ALIGN_MASK (sizeof(uintn) - 1)
+
+/**
+  Copies a source buffer to a destination buffer, and returns the destination buffer.
+
+  This function copies length bytes from source_buffer to destination_buffer, and returns
+  destination_buffer.  The implementation must be reentrant, and it must handle the case
+  where source_buffer overlaps destination_buffer.
+
+  If length is greater than (MAX_ADDRESS - destination_buffer + 1), then ASSERT().
+  If length is greater than (MAX_ADDRESS - source_buffer + 1), then ASSERT().
+
+  @param  destination_buffer   A pointer to the destination buffer of the memory copy.
+  @param  source_buffer        A pointer to the source buffer of the memory copy.
+  @param  length              The number of bytes to copy from source_buffer to destination_buffer.
+
+  @return destination_buffer.
+
+**/
+void *copy_mem(OUT void *destination_buffer, IN const void *source_buffer,
+	       IN uintn length)
+{
+	uint8 *pointer_dst;
+	const uint8 *pointer_src;
+	uintn *pointer_dst_n;
+	const uintn *pointer_src_n;
+	boolean is_word_copy;
+
+	pointer_dst = (uint8 *)destination_buffer;
+	pointer_src = (const uint8 *)source_buffer;
+	if ((length == 0) || (pointer_dst == pointer_src)) {
+		return destination_buffer;
+	}
+
+	//
+	// Word copy is only possible if both buffers have the same alignment.
+	//
+	is_word_copy = (boolean)(
+		(((uintn)pointer_dst ^ (uintn)pointer_src) & UINTN_ALIGN_MASK) ==
+		0);
+
+	if ((pointer_dst < pointer_src) ||
+	    (pointer_dst >= pointer_src + length)) {
+		//
+		// Copy forward.
+		//
+		if (is_word_copy) {
+			while ((((uintn)pointer_dst & UINTN_ALIGN_MASK) != 0) &&
+			       (length != 0)) {
+				*(pointer_dst++) = *(pointer_src++);
+				length--;
+			}
+			pointer_dst_n = (uintn *)pointer_dst;
+			pointer_src_n = (const uintn *)pointer_src;
+			while (length >= sizeof(uintn)) {
+				*(pointer_dst_n++) = *(pointer_src_n++);
+				length -= sizeof(uintn);
+			}
+			pointer_dst = (uint8 *)pointer_dst_n;
+			pointer_src = (const uint8 *)pointer_src_n;
+		}
+		while (length-- != 0) {
+			*(pointer_dst++) = *(pointer_src++);
+		}
+	} else {
+		//
+		// destination_buffer overlaps the end of source_buffer, copy backward.
+		//
+		pointer_dst += length;
+		pointer_src += length;
+		if (is_word_copy) {
+			while ((((uintn)pointer_dst & UINTN_ALIGN_MASK) != 0) &&
+			       (length != 0)) {
+				*(--pointer_dst) = *(--pointer_src);
+				length--;
+			}
+			pointer_dst_n = (uintn *)pointer_dst;
+			pointer_src_n = (const uintn *)pointer_src;
+			while (length >= sizeof(uintn)) {
+				*(--pointer_dst_n) = *(--pointer_src_n);
+				length -= sizeof(uintn);
+			}
+			pointer_dst = (uint8 *)pointer_dst_n;
+			pointer_src = (const uint8 *)pointer_src_n;
+		}
+		while (length-- != 0) {
+			*(--pointer_dst) = *(--pointer_src);
+		}
+	}
+
+	return destination_buffer;
+}
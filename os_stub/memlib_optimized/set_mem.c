@@ -0,0 +1,59 @@
+/**
+    Copyright Notice:
+    Copyright 2021 DMTF. All rights reserved.
+    License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+**/
+
+/** @file
+  set_mem() implementation.
+
+  The aligned part of the buffer is filled one uintn at a time.
+**/
+
+#include "base.h"
+
+#define UINTN_ALIGN_MASK (sizeof(uintn) - 1)
+
+/**
+  Fills a target buffer with a byte value, and returns the target buffer.
+
+  This function fills length bytes of buffer with value, and returns buffer.
+
+  If length is greater than (MAX_ADDRESS - buffer + 1), then ASSERT().
+
+  @param  buffer    The memory to set.
+  @param  length    The number of bytes to set.
+  @param  value     The value with which to fill length bytes of buffer.
+
+  @return buffer.
+
+**/
+void *set_mem(OUT void *buffer, IN uintn length, IN uint8 value)
+{
+	uint8 *pointer;
+	uintn *pointer_n;
+	uintn value_n;
+
+	pointer = (uint8 *)buffer;
+	while ((((uintn)pointer & UINTN_ALIGN_MASK) != 0) && (length != 0)) {
+		*(pointer++) = value;
+		length--;
+	}
+
+	//
+	// Replicate the byte value into every byte of a uintn.
+	//
+	value_n = ((uintn)-1 / 0xFF) * value;
+	pointer_n = (uintn *)pointer;
+	while (length >= sizeof(uintn)) {
+		*(pointer_n++) = value_n;
+		length -= sizeof(uintn);
+	}
+
+	pointer = (uint8 *)pointer_n;
+	while (length-- != 0) {
+		*(pointer++) = value;
+	}
+
+	return buffer;
+}
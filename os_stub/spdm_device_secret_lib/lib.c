@@ -23,6 +23,10 @@
 #include <library/memlib.h>
 #include "spdm_device_secret_lib_internal.h"
 
+#if !defined(__GNUC__) && !defined(__clang__) && defined(_MSC_EXTENSIONS)
+#include <intrin.h>
+#endif
+
 boolean read_responder_private_certificate(IN uint32 base_asym_algo,
 					   OUT void **data, OUT uintn *size)
 {
@@ -81,6 +85,327 @@ boolean read_requester_private_certificate(IN uint16 req_base_asym_alg,
 	return res;
 }
 
+#define SPDM_PRIVATE_KEY_CACHE_COUNT 4
+
+typedef struct {
+	uint32 asym_algo;
+	void *context;
+	//
+	// TRUE while a sign function uses the key. A key in use is not shared with another
+	// sign function and is not evicted.
+	//
+	boolean in_use;
+	//
+	// Value of m_private_key_cache_use_count at the last lookup, for LRU eviction.
+	//
+	uint64 last_use;
+} spdm_private_key_cache_entry_t;
+
+//
+// Parsed private keys, loaded on first use and kept until
+// spdm_flush_private_key_cache() is called.
+// When a table is full, the least recently used idle key is evicted.
+// The tables are protected by m_private_key_cache_lock. A key is only used by one
+// sign function at a time, so concurrent sign functions of the same algorithm load
+// their own copy of the key.
+//
+static spdm_private_key_cache_entry_t
+	m_responder_private_key_cache[SPDM_PRIVATE_KEY_CACHE_COUNT];
+static spdm_private_key_cache_entry_t
+	m_requester_private_key_cache[SPDM_PRIVATE_KEY_CACHE_COUNT];
+static uint64 m_private_key_cache_use_count;
+static volatile long m_private_key_cache_lock;
+
+/**
+  Acquire the lock of the private key cache.
+**/
+static void internal_spdm_lock_private_key_cache(void)
+{
+#if defined(__GNUC__) || defined(__clang__)
+	while (__atomic_exchange_n(&m_private_key_cache_lock, 1,
+				   __ATOMIC_ACQUIRE) != 0) {
+	}
+#elif defined(_MSC_EXTENSIONS)
+	while (_InterlockedExchange(&m_private_key_cache_lock, 1) != 0) {
+	}
+#else
+	//
+	// No atomic operation. The sign functions must not be called
+	// from multiple threads concurrently.
+	//
+	m_private_key_cache_lock = 1;
+#endif
+}
+
+/**
+  Release the lock of the private key cache.
+**/
+static void internal_spdm_unlock_private_key_cache(void)
+{
+#if defined(__GNUC__) || defined(__clang__)
+	__atomic_store_n(&m_private_key_cache_lock, 0, __ATOMIC_RELEASE);
+#elif defined(_MSC_EXTENSIONS)
+	_InterlockedExchange(&m_private_key_cache_lock, 0);
+#else
+	m_private_key_cache_lock = 0;
+#endif
+}
+
+/**
+  Free a private key context.
+
+  @param  is_requester                  Indicates if the key is the requester key or the responder key.
+  @param  asym_algo                     Indicates the signing algorithm.
+  @param  context                       The private key context.
+**/
+static void internal_spdm_free_private_key(IN boolean is_requester,
+					   IN uint32 asym_algo,
+					   IN void *context)
+{
+	if (is_requester) {
+		spdm_req_asym_free((uint16)asym_algo, context);
+	} else {
+		spdm_asym_free(asym_algo, context);
+	}
+}
+
+/**
+  Return the private key cache table.
+
+  @param  is_requester                  Indicates if the table is the requester table or the responder table.
+
+  @return the private key cache table.
+**/
+static spdm_private_key_cache_entry_t *
+internal_spdm_get_private_key_cache(IN boolean is_requester)
+{
+	if (is_requester) {
+		return m_requester_private_key_cache;
+	} else {
+		return m_responder_private_key_cache;
+	}
+}
+
+/**
+  Take an idle cached private key context for the signing algorithm.
+
+  The caller must hold the lock of the private key cache.
+
+  @param  cache                         The private key cache table.
+  @param  asym_algo                     Indicates the signing algorithm.
+
+  @return the private key context, or NULL if no idle key is cached.
+**/
+static void *
+internal_spdm_take_cached_private_key(IN spdm_private_key_cache_entry_t *cache,
+				      IN uint32 asym_algo)
+{
+	uintn index;
+
+	m_private_key_cache_use_count++;
+	for (index = 0; index < SPDM_PRIVATE_KEY_CACHE_COUNT; index++) {
+		if ((cache[index].context != NULL) && !cache[index].in_use &&
+		    (cache[index].asym_algo == asym_algo)) {
+			cache[index].in_use = TRUE;
+			cache[index].last_use = m_private_key_cache_use_count;
+			return cache[index].context;
+		}
+	}
+	return NULL;
+}
+
+/**
+  Acquire a private key context for the signing algorithm.
+
+  An idle cached key is returned if there is one. Otherwise the PEM file is read and
+  parsed, and the key is cached in an empty slot, or in the slot of the least recently
+  used idle key. If every slot is in use, the key is not cached and
+  spdm_release_private_key frees it.
+
+  @param  is_requester                  Indicates if the key is the requester key or the responder key.
+  @param  asym_algo                     Indicates the signing algorithm,
+                                        req_base_asym_alg for a requester or base_asym_algo for a responder.
+
+  @return the private key context, or NULL on failure.
+          It must be released with spdm_release_private_key.
+**/
+void *spdm_acquire_private_key(IN boolean is_requester, IN uint32 asym_algo)
+{
+	spdm_private_key_cache_entry_t *cache;
+	spdm_private_key_cache_entry_t *entry;
+	void *context;
+	void *private_pem;
+	uintn private_pem_size;
+	boolean result;
+	uintn index;
+
+	cache = internal_spdm_get_private_key_cache(is_requester);
+
+	internal_spdm_lock_private_key_cache();
+	context = internal_spdm_take_cached_private_key(cache, asym_algo);
+	internal_spdm_unlock_private_key_cache();
+	if (context != NULL) {
+		return context;
+	}
+
+	//
+	// Load the key without the lock, so that other sign functions are not
+	// blocked by the file read and the parsing.
+	//
+	if (is_requester) {
+		result = read_requester_private_certificate(
+			(uint16)asym_algo, &private_pem, &private_pem_size);
+	} else {
+		result = read_responder_private_certificate(
+			asym_algo, &private_pem, &private_pem_size);
+	}
+	if (!result) {
+		return NULL;
+	}
+
+	if (is_requester) {
+		result = spdm_req_asym_get_private_key_from_pem(
+			(uint16)asym_algo, private_pem, private_pem_size, NULL,
+			&context);
+	} else {
+		result = spdm_asym_get_private_key_from_pem(
+			asym_algo, private_pem, private_pem_size, NULL,
+			&context);
+	}
+	zero_mem_secure(private_pem, private_pem_size);
+	free(private_pem);
+	if (!result) {
+		return NULL;
+	}
+
+	internal_spdm_lock_private_key_cache();
+	entry = NULL;
+	for (index = 0; index < SPDM_PRIVATE_KEY_CACHE_COUNT; index++) {
+		if (cache[index].context == NULL) {
+			if ((entry == NULL) || (entry->context != NULL)) {
+				entry = &cache[index];
+			}
+			continue;
+		}
+		if (cache[index].in_use) {
+			continue;
+		}
+		if ((entry == NULL) || ((entry->context != NULL) &&
+					(cache[index].last_use <
+					 entry->last_use))) {
+			entry = &cache[index];
+		}
+	}
+	if (entry == NULL) {
+		internal_spdm_unlock_private_key_cache();
+		return context;
+	}
+	//
+	// entry is an empty slot, or the least recently used idle key if the table is full.
+	//
+	if (entry->context != NULL) {
+		internal_spdm_free_private_key(is_requester, entry->asym_algo,
+					       entry->context);
+	}
+	entry->asym_algo = asym_algo;
+	entry->context = context;
+	entry->in_use = TRUE;
+	entry->last_use = m_private_key_cache_use_count;
+	internal_spdm_unlock_private_key_cache();
+	return context;
+}
+
+/**
+  Release a private key context acquired by spdm_acquire_private_key.
+
+  A cached key becomes idle. A key that is not cached, because every slot was in use
+  or the cache was flushed while the key was used, is freed.
+
+  @param  is_requester                  Indicates if the key is the requester key or the responder key.
+  @param  asym_algo                     Indicates the signing algorithm.
+  @param  context                       The private key context.
+**/
+void spdm_release_private_key(IN boolean is_requester, IN uint32 asym_algo,
+			      IN void *context)
+{
+	spdm_private_key_cache_entry_t *cache;
+	uintn index;
+
+	cache = internal_spdm_get_private_key_cache(is_requester);
+
+	internal_spdm_lock_private_key_cache();
+	for (index = 0; index < SPDM_PRIVATE_KEY_CACHE_COUNT; index++) {
+		if (cache[index].context == context) {
+			cache[index].in_use = FALSE;
+			internal_spdm_unlock_private_key_cache();
+			return;
+		}
+	}
+	internal_spdm_unlock_private_key_cache();
+
+	internal_spdm_free_private_key(is_requester, asym_algo, context);
+}
+
+/**
+  Check if the private key for the signing algorithm is cached, without loading it.
+
+  @param  is_requester                  Indicates if the key is the requester key or the responder key.
+  @param  asym_algo                     Indicates the signing algorithm.
+
+  @retval TRUE  the private key is cached.
+  @retval FALSE the private key is not cached.
+**/
+boolean spdm_is_private_key_cached(IN boolean is_requester,
+				   IN uint32 asym_algo)
+{
+	spdm_private_key_cache_entry_t *cache;
+	boolean result;
+	uintn index;
+
+	cache = internal_spdm_get_private_key_cache(is_requester);
+
+	result = FALSE;
+	internal_spdm_lock_private_key_cache();
+	for (index = 0; index < SPDM_PRIVATE_KEY_CACHE_COUNT; index++) {
+		if ((cache[index].context != NULL) &&
+		    (cache[index].asym_algo == asym_algo)) {
+			result = TRUE;
+			break;
+		}
+	}
+	internal_spdm_unlock_private_key_cache();
+	return result;
+}
+
+/**
+  Free all cached responder and requester private key contexts.
+
+  A key that is in use is removed from the cache, and is freed when it is released.
+  The next signing operation reloads the key from storage.
+**/
+void spdm_flush_private_key_cache(void)
+{
+	spdm_private_key_cache_entry_t *cache;
+	spdm_private_key_cache_entry_t entry;
+	boolean is_requester;
+	uintn index;
+
+	for (is_requester = 0; is_requester <= 1; is_requester++) {
+		cache = internal_spdm_get_private_key_cache(is_requester);
+		for (index = 0; index < SPDM_PRIVATE_KEY_CACHE_COUNT; index++) {
+			internal_spdm_lock_private_key_cache();
+			entry = cache[index];
+			zero_mem(&cache[index], sizeof(cache[index]));
+			internal_spdm_unlock_private_key_cache();
+			if ((entry.context != NULL) && !entry.in_use) {
+				internal_spdm_free_private_key(
+					is_requester, entry.asym_algo,
+					entry.context);
+			}
+		}
+	}
+}
+
 /**
   Collect the device measurement.
 
@@ -204,28 +529,49 @@ boolean spdm_requester_data_sign(IN uint16 req_base_asym_alg,
 				 OUT uint8 *signature, IN OUT uintn *sig_size)
 {
 	void *context;
-	void *private_pem;
-	uintn private_pem_size;
 	boolean result;
 
-	result = read_requester_private_certificate(
-		req_base_asym_alg, &private_pem, &private_pem_size);
-	if (!result) {
-		return FALSE;
-	}
-
-	result = spdm_req_asym_get_private_key_from_pem(req_base_asym_alg,
-							private_pem,
-							private_pem_size, NULL,
-							&context);
-	if (!result) {
+	context = spdm_acquire_private_key(TRUE, req_base_asym_alg);
+	if (context == NULL) {
 		return FALSE;
 	}
 	result = spdm_req_asym_sign(req_base_asym_alg, base_hash_algo, context,
 				    message, message_size, signature, sig_size);
-	spdm_req_asym_free(req_base_asym_alg, context);
-	free(private_pem);
+	spdm_release_private_key(TRUE, req_base_asym_alg, context);
+	return result;
+}
+
+/**
+  Sign an SPDM message hash.
 
+  @param  req_base_asym_alg               Indicates the signing algorithm.
+  @param  base_hash_algo                 Indicates the hash algorithm.
+  @param  message_hash                  A pointer to the hash of the message to be signed.
+  @param  hash_size                     The size in bytes of the message hash to be signed.
+  @param  signature                    A pointer to a destination buffer to store the signature.
+  @param  sig_size                      On input, indicates the size in bytes of the destination buffer to store the signature.
+                                       On output, indicates the size in bytes of the signature in the buffer.
+
+  @retval TRUE  signing success.
+  @retval FALSE signing fail.
+**/
+boolean spdm_requester_data_sign_hash(IN uint16 req_base_asym_alg,
+				      IN uint32 base_hash_algo,
+				      IN const uint8 *message_hash,
+				      IN uintn hash_size, OUT uint8 *signature,
+				      IN OUT uintn *sig_size)
+{
+	void *context;
+	boolean result;
+
+	context = spdm_acquire_private_key(TRUE, req_base_asym_alg);
+	if (context == NULL) {
+		return FALSE;
+	}
+	result = spdm_req_asym_sign_hash(req_base_asym_alg, base_hash_algo,
+					 context, message_hash, hash_size,
+					 signature, sig_size);
+	spdm_release_private_key(TRUE, req_base_asym_alg, context);
 	return result;
 }
 
@@ -249,26 +595,49 @@ boolean spdm_responder_data_sign(IN uint32 base_asym_algo,
 				 OUT uint8 *signature, IN OUT uintn *sig_size)
 {
 	void *context;
-	void *private_pem;
-	uintn private_pem_size;
 	boolean result;
 
-	result = read_responder_private_certificate(
-		base_asym_algo, &private_pem, &private_pem_size);
-	if (!result) {
-		return FALSE;
-	}
-
-	result = spdm_asym_get_private_key_from_pem(
-		base_asym_algo, private_pem, private_pem_size, NULL, &context);
-	if (!result) {
+	context = spdm_acquire_private_key(FALSE, base_asym_algo);
+	if (context == NULL) {
 		return FALSE;
 	}
 	result = spdm_asym_sign(base_asym_algo, base_hash_algo, context,
 				message, message_size, signature, sig_size);
-	spdm_asym_free(base_asym_algo, context);
-	free(private_pem);
+	spdm_release_private_key(FALSE, base_asym_algo, context);
+	return result;
+}
+
+/**
+  Sign an SPDM message hash.
+
+  @param  base_asym_algo                 Indicates the signing algorithm.
+  @param  base_hash_algo                 Indicates the hash algorithm.
+  @param  message_hash                  A pointer to the hash of the message to be signed.
+  @param  hash_size                     The size in bytes of the message hash to be signed.
+  @param  signature                    A pointer to a destination buffer to store the signature.
+  @param  sig_size                      On input, indicates the size in bytes of the destination buffer to store the signature.
+                                       On output, indicates the size in bytes of the signature in the buffer.
+
+  @retval TRUE  signing success.
+  @retval FALSE signing fail.
+**/
+boolean spdm_responder_data_sign_hash(IN uint32 base_asym_algo,
+				      IN uint32 base_hash_algo,
+				      IN const uint8 *message_hash,
+				      IN uintn hash_size, OUT uint8 *signature,
+				      IN OUT uintn *sig_size)
+{
+	void *context;
+	boolean result;
 
+	context = spdm_acquire_private_key(FALSE, base_asym_algo);
+	if (context == NULL) {
+		return FALSE;
+	}
+	result = spdm_asym_sign_hash(base_asym_algo, base_hash_algo, context,
+				     message_hash, hash_size, signature,
+				     sig_size);
+	spdm_release_private_key(FALSE, base_asym_algo, context);
 	return result;
 }
 
@@ -332,7 +701,7 @@ boolean spdm_psk_handshake_secret_hkdf_expand(IN uint32 base_hash_algo,
 
 	result = spdm_hkdf_expand(base_hash_algo, handshake_secret, hash_size,
 				  info, info_size, out, out_size);
-	zero_mem(handshake_secret, hash_size);
+	zero_mem_secure(handshake_secret, hash_size);
 
 	return result;
 }
@@ -391,21 +760,21 @@ boolean spdm_psk_master_secret_hkdf_expand(IN uint32 base_hash_algo,
 	result = spdm_hkdf_expand(base_hash_algo, handshake_secret, hash_size,
 				  m_bin_str0, sizeof(m_bin_str0), salt1,
 				  hash_size);
-	zero_mem(handshake_secret, hash_size);
+	zero_mem_secure(handshake_secret, hash_size);
 	if (!result) {
 		return result;
 	}
 
 	result = spdm_hmac_all(base_hash_algo, m_my_zero_filled_buffer,
 			       hash_size, salt1, hash_size, master_secret);
-	zero_mem(salt1, hash_size);
+	zero_mem_secure(salt1, hash_size);
 	if (!result) {
 		return result;
 	}
 
 	result = spdm_hkdf_expand(base_hash_algo, master_secret, hash_size,
 				  info, info_size, out, out_size);
-	zero_mem(master_secret, hash_size);
+	zero_mem_secure(master_secret, hash_size);
 
 	return result;
 }
@@ -58,6 +58,17 @@ boolean read_responder_root_public_certificate_by_size(
 	OUT void **data, OUT uintn *size, OUT void **hash,
 	OUT uintn *hash_size);
 
+//
+// Private key cache
+//
+void *spdm_acquire_private_key(IN boolean is_requester, IN uint32 asym_algo);
+
+void spdm_release_private_key(IN boolean is_requester, IN uint32 asym_algo,
+			      IN void *context);
+
+boolean spdm_is_private_key_cached(IN boolean is_requester,
+				   IN uint32 asym_algo);
+
 //
 // External
 //
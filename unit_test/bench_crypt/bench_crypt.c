@@ -0,0 +1,693 @@
+/**
+    Copyright Notice:
+    Copyright 2021 DMTF. All rights reserved.
+    License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+**/
+
+/** @file
+  Crypto primitive benchmark.
+
+  It times the cryptlib primitives that SPDM uses and prints one CSV row per
+  primitive and data size, so results from cryptlib_mbedtls and
+  cryptlib_openssl builds can be compared directly.
+**/
+
+#include "test_crypt.h"
+#include <time.h>
+
+#define BENCH_CRYPT_DEFAULT_MIN_TIME_MS 200
+#define BENCH_CRYPT_MAX_ITERATIONS 0x100000
+#define BENCH_CRYPT_MAX_DATA_SIZE 4096
+#define BENCH_CRYPT_MAX_KEY_SIZE 64
+#define BENCH_CRYPT_MAX_PUBLIC_KEY_SIZE 512
+#define BENCH_CRYPT_MAX_SIGNATURE_SIZE 512
+
+#if defined(BENCH_CRYPT_CRYPTO_MBEDTLS)
+#define BENCH_CRYPT_CRYPTO_NAME "mbedtls"
+#elif defined(BENCH_CRYPT_CRYPTO_OPENSSL)
+#define BENCH_CRYPT_CRYPTO_NAME "openssl"
+#else
+#define BENCH_CRYPT_CRYPTO_NAME "unknown"
+#endif
+
+/**
+  Run one operation of a primitive.
+
+  @param  context                       The primitive specific context.
+  @param  data_size                     The size in bytes of the input data.
+
+  @retval TRUE   The operation succeeded.
+  @retval FALSE  The operation failed or is not supported by the backend.
+**/
+typedef boolean (*bench_crypt_func)(IN void *context, IN uintn data_size);
+
+typedef boolean (*bench_crypt_hash_all_func)(IN const void *data,
+					     IN uintn data_size,
+					     OUT uint8 *hash_value);
+
+typedef boolean (*bench_crypt_hmac_all_func)(IN const void *data,
+					     IN uintn data_size,
+					     IN const uint8 *key,
+					     IN uintn key_size,
+					     OUT uint8 *hmac_value);
+
+typedef boolean (*bench_crypt_hkdf_extract_func)(IN const uint8 *key,
+						 IN uintn key_size,
+						 IN const uint8 *salt,
+						 IN uintn salt_size,
+						 OUT uint8 *prk_out,
+						 IN uintn prk_out_size);
+
+typedef boolean (*bench_crypt_hkdf_expand_func)(IN const uint8 *prk,
+						IN uintn prk_size,
+						IN const uint8 *info,
+						IN uintn info_size,
+						OUT uint8 *out,
+						IN uintn out_size);
+
+typedef boolean (*bench_crypt_aead_encrypt_func)(
+	IN const uint8 *key, IN uintn key_size, IN const uint8 *iv,
+	IN uintn iv_size, IN const uint8 *a_data, IN uintn a_data_size,
+	IN const uint8 *data_in, IN uintn data_in_size, OUT uint8 *tag_out,
+	IN uintn tag_size, OUT uint8 *data_out, OUT uintn *data_out_size);
+
+typedef boolean (*bench_crypt_aead_decrypt_func)(
+	IN const uint8 *key, IN uintn key_size, IN const uint8 *iv,
+	IN uintn iv_size, IN const uint8 *a_data, IN uintn a_data_size,
+	IN const uint8 *data_in, IN uintn data_in_size, IN const uint8 *tag,
+	IN uintn tag_size, OUT uint8 *data_out, OUT uintn *data_out_size);
+
+typedef boolean (*bench_crypt_sign_func)(IN void *context, IN uintn hash_nid,
+					 IN const uint8 *message_hash,
+					 IN uintn hash_size,
+					 OUT uint8 *signature,
+					 IN OUT uintn *sig_size);
+
+typedef boolean (*bench_crypt_verify_func)(IN void *context,
+					   IN uintn hash_nid,
+					   IN const uint8 *message_hash,
+					   IN uintn hash_size,
+					   IN const uint8 *signature,
+					   IN uintn sig_size);
+
+typedef void *(*bench_crypt_new_by_nid_func)(IN uintn nid);
+
+typedef boolean (*bench_crypt_generate_key_func)(IN OUT void *context,
+						 OUT uint8 *public_key,
+						 IN OUT uintn *public_key_size);
+
+typedef boolean (*bench_crypt_compute_key_func)(IN OUT void *context,
+						IN const uint8 *peer_public_key,
+						IN uintn peer_public_key_size,
+						OUT uint8 *key,
+						IN OUT uintn *key_size);
+
+typedef void (*bench_crypt_free_func)(IN void *context);
+
+typedef struct {
+	char8 *name;
+	bench_crypt_hash_all_func hash_all;
+} bench_crypt_hash_t;
+
+typedef struct {
+	char8 *name;
+	bench_crypt_hmac_all_func hmac_all;
+	uintn hash_size;
+} bench_crypt_hmac_t;
+
+typedef struct {
+	char8 *name;
+	bench_crypt_hkdf_extract_func extract;
+	bench_crypt_hkdf_expand_func expand;
+	uintn hash_size;
+} bench_crypt_hkdf_t;
+
+typedef struct {
+	char8 *name;
+	bench_crypt_aead_encrypt_func encrypt;
+	bench_crypt_aead_decrypt_func decrypt;
+	uintn key_size;
+} bench_crypt_aead_t;
+
+typedef struct {
+	char8 *name;
+	char8 *path;
+	boolean is_rsa;
+	bench_crypt_sign_func sign;
+	bench_crypt_verify_func verify;
+	uintn hash_nid;
+	uintn hash_size;
+	void *private_context;
+	void *public_context;
+	uint8 signature[BENCH_CRYPT_MAX_SIGNATURE_SIZE];
+	uintn signature_size;
+} bench_crypt_asym_t;
+
+typedef struct {
+	char8 *name;
+	uintn nid;
+	bench_crypt_new_by_nid_func new_by_nid;
+	bench_crypt_generate_key_func generate_key;
+	bench_crypt_compute_key_func compute_key;
+	bench_crypt_free_func free_context;
+	void *context;
+	void *peer_context;
+	uint8 peer_public_key[BENCH_CRYPT_MAX_PUBLIC_KEY_SIZE];
+	uintn peer_public_key_size;
+} bench_crypt_key_exchange_t;
+
+typedef struct {
+	char8 *name;
+	char8 *path;
+	uint8 *root_cert;
+	uintn root_cert_size;
+	uint8 *cert_chain;
+	uintn cert_chain_size;
+} bench_crypt_x509_t;
+
+uintn m_bench_crypt_data_size[] = { 64, 256, 1024, 4096 };
+
+uint8 m_bench_crypt_data[BENCH_CRYPT_MAX_DATA_SIZE];
+uint8 m_bench_crypt_output[BENCH_CRYPT_MAX_DATA_SIZE];
+uint8 m_bench_crypt_key[BENCH_CRYPT_MAX_KEY_SIZE];
+uint8 m_bench_crypt_iv[12];
+uint8 m_bench_crypt_tag[16];
+
+uint64 m_bench_crypt_min_time_ns;
+
+bench_crypt_hash_t m_bench_crypt_hash[] = {
+	{ "sha256", sha256_hash_all },
+	{ "sha384", sha384_hash_all },
+	{ "sha512", sha512_hash_all },
+	{ "sha3_256", sha3_256_hash_all },
+	{ "sha3_384", sha3_384_hash_all },
+	{ "sha3_512", sha3_512_hash_all },
+};
+
+bench_crypt_hmac_t m_bench_crypt_hmac[] = {
+	{ "hmac_sha256", hmac_sha256_all, 32 },
+	{ "hmac_sha384", hmac_sha384_all, 48 },
+	{ "hmac_sha512", hmac_sha512_all, 64 },
+};
+
+bench_crypt_hkdf_t m_bench_crypt_hkdf[] = {
+	{ "hkdf_sha256", hkdf_sha256_extract, hkdf_sha256_expand, 32 },
+	{ "hkdf_sha384", hkdf_sha384_extract, hkdf_sha384_expand, 48 },
+	{ "hkdf_sha512", hkdf_sha512_extract, hkdf_sha512_expand, 64 },
+};
+
+bench_crypt_aead_t m_bench_crypt_aead[] = {
+	{ "aes_128_gcm", aead_aes_gcm_encrypt, aead_aes_gcm_decrypt, 16 },
+	{ "aes_256_gcm", aead_aes_gcm_encrypt, aead_aes_gcm_decrypt, 32 },
+	{ "chacha20_poly1305", aead_chacha20_poly1305_encrypt,
+	  aead_chacha20_poly1305_decrypt, 32 },
+};
+
+bench_crypt_asym_t m_bench_crypt_asym[] = {
+	{ "rsassa_2048", "rsa2048", TRUE, rsa_pkcs1_sign_with_nid,
+	  rsa_pkcs1_verify_with_nid, CRYPTO_NID_SHA256, 32 },
+	{ "rsapss_2048", "rsa2048", TRUE, rsa_pss_sign, rsa_pss_verify,
+	  CRYPTO_NID_SHA256, 32 },
+	{ "rsassa_3072", "rsa3072", TRUE, rsa_pkcs1_sign_with_nid,
+	  rsa_pkcs1_verify_with_nid, CRYPTO_NID_SHA384, 48 },
+	{ "rsapss_3072", "rsa3072", TRUE, rsa_pss_sign, rsa_pss_verify,
+	  CRYPTO_NID_SHA384, 48 },
+	{ "ecdsa_p256", "ecp256", FALSE, ecdsa_sign, ecdsa_verify,
+	  CRYPTO_NID_SHA256, 32 },
+	{ "ecdsa_p384", "ecp384", FALSE, ecdsa_sign, ecdsa_verify,
+	  CRYPTO_NID_SHA384, 48 },
+};
+
+bench_crypt_key_exchange_t m_bench_crypt_key_exchange[] = {
+	{ "ffdhe2048", CRYPTO_NID_FFDHE2048, dh_new_by_nid, dh_generate_key,
+	  dh_compute_key, dh_free },
+	{ "ffdhe3072", CRYPTO_NID_FFDHE3072, dh_new_by_nid, dh_generate_key,
+	  dh_compute_key, dh_free },
+	{ "ffdhe4096", CRYPTO_NID_FFDHE4096, dh_new_by_nid, dh_generate_key,
+	  dh_compute_key, dh_free },
+	{ "secp256r1", CRYPTO_NID_SECP256R1, ec_new_by_nid, ec_generate_key,
+	  ec_compute_key, ec_free },
+	{ "secp384r1", CRYPTO_NID_SECP384R1, ec_new_by_nid, ec_generate_key,
+	  ec_compute_key, ec_free },
+	{ "secp521r1", CRYPTO_NID_SECP521R1, ec_new_by_nid, ec_generate_key,
+	  ec_compute_key, ec_free },
+};
+
+bench_crypt_x509_t m_bench_crypt_x509[] = {
+	{ "x509_chain_rsa2048", "rsa2048" },
+	{ "x509_chain_rsa3072", "rsa3072" },
+	{ "x509_chain_ecp256", "ecp256" },
+	{ "x509_chain_ecp384", "ecp384" },
+};
+
+/**
+  Return a monotonic timestamp in nanoseconds.
+
+  MSVC has no clock_gettime, so the wall clock is used there.
+**/
+uint64 bench_crypt_get_time_ns(void)
+{
+	struct timespec ts;
+
+#if defined(_MSC_VER)
+	timespec_get(&ts, TIME_UTC);
+#else
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+#endif
+	return (uint64)ts.tv_sec * 1000000000ull + (uint64)ts.tv_nsec;
+}
+
+/**
+  Time a primitive and print one CSV row.
+
+  The iteration count doubles until one batch runs for at least the minimum
+  time, so fast and slow primitives get comparable precision.
+
+  @param  name                          The primitive name.
+  @param  data_size                     The size in bytes of the input data, or 0 if not applicable.
+  @param  func                          The operation to time.
+  @param  context                       The primitive specific context.
+**/
+void bench_crypt_run(IN char8 *name, IN uintn data_size,
+		     IN bench_crypt_func func, IN void *context)
+{
+	uintn iterations;
+	uintn index;
+	uint64 start;
+	uint64 elapsed;
+	double ns_per_op;
+
+	if ((context == NULL) || !func(context, data_size)) {
+		printf("%s,%s,%d,0,,,,unsupported\n", BENCH_CRYPT_CRYPTO_NAME,
+		       name, (uint32)data_size);
+		return;
+	}
+
+	iterations = 1;
+	while (TRUE) {
+		start = bench_crypt_get_time_ns();
+		for (index = 0; index < iterations; index++) {
+			if (!func(context, data_size)) {
+				printf("%s,%s,%d,%d,,,,failed\n",
+				       BENCH_CRYPT_CRYPTO_NAME, name,
+				       (uint32)data_size, (uint32)index);
+				return;
+			}
+		}
+		elapsed = bench_crypt_get_time_ns() - start;
+		if ((elapsed >= m_bench_crypt_min_time_ns) ||
+		    (iterations >= BENCH_CRYPT_MAX_ITERATIONS)) {
+			break;
+		}
+		iterations *= 2;
+	}
+
+	ns_per_op = (double)elapsed / (double)iterations;
+	if (ns_per_op == 0) {
+		ns_per_op = 1;
+	}
+	printf("%s,%s,%d,%d,%.1f,%.1f,%.2f,ok\n", BENCH_CRYPT_CRYPTO_NAME, name,
+	       (uint32)data_size, (uint32)iterations, ns_per_op,
+	       1e9 / ns_per_op, (double)data_size * 1e3 / ns_per_op);
+}
+
+boolean bench_crypt_hash(IN void *context, IN uintn data_size)
+{
+	bench_crypt_hash_t *hash;
+
+	hash = context;
+	return hash->hash_all(m_bench_crypt_data, data_size,
+			      m_bench_crypt_output);
+}
+
+boolean bench_crypt_hmac(IN void *context, IN uintn data_size)
+{
+	bench_crypt_hmac_t *hmac;
+
+	hmac = context;
+	return hmac->hmac_all(m_bench_crypt_data, data_size, m_bench_crypt_key,
+			      hmac->hash_size, m_bench_crypt_output);
+}
+
+boolean bench_crypt_hkdf_extract(IN void *context, IN uintn data_size)
+{
+	bench_crypt_hkdf_t *hkdf;
+
+	hkdf = context;
+	return hkdf->extract(m_bench_crypt_data, hkdf->hash_size,
+			     m_bench_crypt_key, hkdf->hash_size,
+			     m_bench_crypt_output, hkdf->hash_size);
+}
+
+boolean bench_crypt_hkdf_expand(IN void *context, IN uintn data_size)
+{
+	bench_crypt_hkdf_t *hkdf;
+
+	hkdf = context;
+	return hkdf->expand(m_bench_crypt_key, hkdf->hash_size,
+			    m_bench_crypt_data, 32, m_bench_crypt_output,
+			    hkdf->hash_size);
+}
+
+boolean bench_crypt_aead_encrypt(IN void *context, IN uintn data_size)
+{
+	bench_crypt_aead_t *aead;
+	uintn data_out_size;
+
+	aead = context;
+	data_out_size = sizeof(m_bench_crypt_output);
+	return aead->encrypt(m_bench_crypt_key, aead->key_size,
+			     m_bench_crypt_iv, sizeof(m_bench_crypt_iv),
+			     m_bench_crypt_iv, sizeof(m_bench_crypt_iv),
+			     m_bench_crypt_data, data_size, m_bench_crypt_tag,
+			     sizeof(m_bench_crypt_tag), m_bench_crypt_output,
+			     &data_out_size);
+}
+
+/**
+  Decrypt the ciphertext produced by one bench_crypt_aead_encrypt call.
+**/
+boolean bench_crypt_aead_decrypt(IN void *context, IN uintn data_size)
+{
+	bench_crypt_aead_t *aead;
+	uintn data_out_size;
+
+	aead = context;
+	data_out_size = sizeof(m_bench_crypt_data);
+	return aead->decrypt(m_bench_crypt_key, aead->key_size,
+			     m_bench_crypt_iv, sizeof(m_bench_crypt_iv),
+			     m_bench_crypt_iv, sizeof(m_bench_crypt_iv),
+			     m_bench_crypt_output, data_size, m_bench_crypt_tag,
+			     sizeof(m_bench_crypt_tag), m_bench_crypt_data,
+			     &data_out_size);
+}
+
+boolean bench_crypt_sign(IN void *context, IN uintn data_size)
+{
+	bench_crypt_asym_t *asym;
+
+	asym = context;
+	asym->signature_size = sizeof(asym->signature);
+	return asym->sign(asym->private_context, asym->hash_nid,
+			  m_bench_crypt_key, asym->hash_size, asym->signature,
+			  &asym->signature_size);
+}
+
+boolean bench_crypt_verify(IN void *context, IN uintn data_size)
+{
+	bench_crypt_asym_t *asym;
+
+	asym = context;
+	return asym->verify(asym->public_context, asym->hash_nid,
+			    m_bench_crypt_key, asym->hash_size,
+			    asym->signature, asym->signature_size);
+}
+
+boolean bench_crypt_generate_key(IN void *context, IN uintn data_size)
+{
+	bench_crypt_key_exchange_t *key_exchange;
+	uint8 public_key[BENCH_CRYPT_MAX_PUBLIC_KEY_SIZE];
+	uintn public_key_size;
+
+	key_exchange = context;
+	public_key_size = sizeof(public_key);
+	return key_exchange->generate_key(key_exchange->context, public_key,
+					  &public_key_size);
+}
+
+boolean bench_crypt_compute_key(IN void *context, IN uintn data_size)
+{
+	bench_crypt_key_exchange_t *key_exchange;
+	uintn key_size;
+
+	key_exchange = context;
+	key_size = sizeof(m_bench_crypt_output);
+	return key_exchange->compute_key(key_exchange->context,
+					 key_exchange->peer_public_key,
+					 key_exchange->peer_public_key_size,
+					 m_bench_crypt_output, &key_size);
+}
+
+boolean bench_crypt_x509_verify_cert_chain(IN void *context,
+					   IN uintn data_size)
+{
+	bench_crypt_x509_t *x509;
+
+	x509 = context;
+	return x509_verify_cert_chain(x509->root_cert, x509->root_cert_size,
+				      x509->cert_chain,
+				      x509->cert_chain_size);
+}
+
+/**
+  Read a sample key file from <path>/<file_name>.
+**/
+boolean bench_crypt_read_sample_file(IN char8 *path, IN char8 *file_name,
+				     OUT void **file_data,
+				     OUT uintn *file_size)
+{
+	char8 full_name[64];
+
+	snprintf(full_name, sizeof(full_name), "%s/%s", path, file_name);
+	return read_input_file(full_name, file_data, file_size);
+}
+
+/**
+  Load the responder key pair of a signing algorithm.
+**/
+boolean bench_crypt_init_asym(IN OUT bench_crypt_asym_t *asym)
+{
+	void *pem;
+	uintn pem_size;
+	void *cert;
+	uintn cert_size;
+	boolean result;
+
+	if (!bench_crypt_read_sample_file(asym->path, "end_responder.key",
+					  &pem, &pem_size)) {
+		return FALSE;
+	}
+	if (!bench_crypt_read_sample_file(asym->path, "end_responder.cert.der",
+					  &cert, &cert_size)) {
+		free(pem);
+		return FALSE;
+	}
+	if (asym->is_rsa) {
+		result = rsa_get_private_key_from_pem(
+				 pem, pem_size, NULL, &asym->private_context) &&
+			 rsa_get_public_key_from_x509(cert, cert_size,
+						      &asym->public_context);
+	} else {
+		result = ec_get_private_key_from_pem(
+				 pem, pem_size, NULL, &asym->private_context) &&
+			 ec_get_public_key_from_x509(cert, cert_size,
+						     &asym->public_context);
+	}
+	free(cert);
+	free(pem);
+	if (!result) {
+		return FALSE;
+	}
+
+	//
+	// Verify times the signature produced here.
+	//
+	return bench_crypt_sign(asym, 0);
+}
+
+void bench_crypt_free_asym(IN OUT bench_crypt_asym_t *asym)
+{
+	if (asym->is_rsa) {
+		if (asym->private_context != NULL) {
+			rsa_free(asym->private_context);
+		}
+		if (asym->public_context != NULL) {
+			rsa_free(asym->public_context);
+		}
+	} else {
+		if (asym->private_context != NULL) {
+			ec_free(asym->private_context);
+		}
+		if (asym->public_context != NULL) {
+			ec_free(asym->public_context);
+		}
+	}
+	asym->private_context = NULL;
+	asym->public_context = NULL;
+}
+
+/**
+  Create a key pair and a peer public key for a DHE group.
+**/
+boolean bench_crypt_init_key_exchange(
+	IN OUT bench_crypt_key_exchange_t *key_exchange)
+{
+	uint8 public_key[BENCH_CRYPT_MAX_PUBLIC_KEY_SIZE];
+	uintn public_key_size;
+
+	key_exchange->context = key_exchange->new_by_nid(key_exchange->nid);
+	key_exchange->peer_context =
+		key_exchange->new_by_nid(key_exchange->nid);
+	if ((key_exchange->context == NULL) ||
+	    (key_exchange->peer_context == NULL)) {
+		return FALSE;
+	}
+	public_key_size = sizeof(public_key);
+	if (!key_exchange->generate_key(key_exchange->context, public_key,
+					&public_key_size)) {
+		return FALSE;
+	}
+	key_exchange->peer_public_key_size =
+		sizeof(key_exchange->peer_public_key);
+	return key_exchange->generate_key(key_exchange->peer_context,
+					  key_exchange->peer_public_key,
+					  &key_exchange->peer_public_key_size);
+}
+
+void bench_crypt_free_key_exchange(
+	IN OUT bench_crypt_key_exchange_t *key_exchange)
+{
+	if (key_exchange->context != NULL) {
+		key_exchange->free_context(key_exchange->context);
+	}
+	if (key_exchange->peer_context != NULL) {
+		key_exchange->free_context(key_exchange->peer_context);
+	}
+	key_exchange->context = NULL;
+	key_exchange->peer_context = NULL;
+}
+
+int main(int argc, char *argv[])
+{
+	uintn index;
+	uintn size_index;
+	uintn min_time_ms;
+	char8 name[64];
+	void *context;
+
+	min_time_ms = BENCH_CRYPT_DEFAULT_MIN_TIME_MS;
+	if (argc > 1) {
+		min_time_ms = (uintn)strtoul(argv[1], NULL, 0);
+		if (min_time_ms == 0) {
+			printf("usage: bench_crypt [min_time_ms]\n");
+			return 1;
+		}
+	}
+	m_bench_crypt_min_time_ns = (uint64)min_time_ms * 1000000;
+
+	random_seed(NULL, 0);
+	random_bytes(m_bench_crypt_data, sizeof(m_bench_crypt_data));
+	random_bytes(m_bench_crypt_key, sizeof(m_bench_crypt_key));
+	random_bytes(m_bench_crypt_iv, sizeof(m_bench_crypt_iv));
+
+	printf("backend,primitive,data_size,iterations,ns_per_op,ops_per_sec,mb_per_sec,status\n");
+
+	for (index = 0; index < ARRAY_SIZE(m_bench_crypt_hash); index++) {
+		for (size_index = 0;
+		     size_index < ARRAY_SIZE(m_bench_crypt_data_size);
+		     size_index++) {
+			bench_crypt_run(m_bench_crypt_hash[index].name,
+					m_bench_crypt_data_size[size_index],
+					bench_crypt_hash,
+					&m_bench_crypt_hash[index]);
+		}
+	}
+
+	for (index = 0; index < ARRAY_SIZE(m_bench_crypt_hmac); index++) {
+		for (size_index = 0;
+		     size_index < ARRAY_SIZE(m_bench_crypt_data_size);
+		     size_index++) {
+			bench_crypt_run(m_bench_crypt_hmac[index].name,
+					m_bench_crypt_data_size[size_index],
+					bench_crypt_hmac,
+					&m_bench_crypt_hmac[index]);
+		}
+	}
+
+	for (index = 0; index < ARRAY_SIZE(m_bench_crypt_hkdf); index++) {
+		snprintf(name, sizeof(name), "%s_extract",
+			 m_bench_crypt_hkdf[index].name);
+		bench_crypt_run(name, 0, bench_crypt_hkdf_extract,
+				&m_bench_crypt_hkdf[index]);
+		snprintf(name, sizeof(name), "%s_expand",
+			 m_bench_crypt_hkdf[index].name);
+		bench_crypt_run(name, 0, bench_crypt_hkdf_expand,
+				&m_bench_crypt_hkdf[index]);
+	}
+
+	for (index = 0; index < ARRAY_SIZE(m_bench_crypt_aead); index++) {
+		for (size_index = 0;
+		     size_index < ARRAY_SIZE(m_bench_crypt_data_size);
+		     size_index++) {
+			snprintf(name, sizeof(name), "%s_encrypt",
+				 m_bench_crypt_aead[index].name);
+			bench_crypt_run(name,
+					m_bench_crypt_data_size[size_index],
+					bench_crypt_aead_encrypt,
+					&m_bench_crypt_aead[index]);
+			snprintf(name, sizeof(name), "%s_decrypt",
+				 m_bench_crypt_aead[index].name);
+			bench_crypt_run(name,
+					m_bench_crypt_data_size[size_index],
+					bench_crypt_aead_decrypt,
+					&m_bench_crypt_aead[index]);
+		}
+	}
+
+	for (index = 0; index < ARRAY_SIZE(m_bench_crypt_asym); index++) {
+		context = &m_bench_crypt_asym[index];
+		if (!bench_crypt_init_asym(&m_bench_crypt_asym[index])) {
+			context = NULL;
+		}
+		snprintf(name, sizeof(name), "%s_sign",
+			 m_bench_crypt_asym[index].name);
+		bench_crypt_run(name, 0, bench_crypt_sign, context);
+		snprintf(name, sizeof(name), "%s_verify",
+			 m_bench_crypt_asym[index].name);
+		bench_crypt_run(name, 0, bench_crypt_verify, context);
+		bench_crypt_free_asym(&m_bench_crypt_asym[index]);
+	}
+
+	for (index = 0; index < ARRAY_SIZE(m_bench_crypt_key_exchange);
+	     index++) {
+		context = &m_bench_crypt_key_exchange[index];
+		if (!bench_crypt_init_key_exchange(
+			    &m_bench_crypt_key_exchange[index])) {
+			context = NULL;
+		}
+		snprintf(name, sizeof(name), "%s_generate_key",
+			 m_bench_crypt_key_exchange[index].name);
+		bench_crypt_run(name, 0, bench_crypt_generate_key, context);
+		snprintf(name, sizeof(name), "%s_compute_key",
+			 m_bench_crypt_key_exchange[index].name);
+		bench_crypt_run(name, 0, bench_crypt_compute_key, context);
+		bench_crypt_free_key_exchange(
+			&m_bench_crypt_key_exchange[index]);
+	}
+
+	for (index = 0; index < ARRAY_SIZE(m_bench_crypt_x509); index++) {
+		context = &m_bench_crypt_x509[index];
+		if (!bench_crypt_read_sample_file(
+			    m_bench_crypt_x509[index].path, "ca.cert.der",
+			    (void **)&m_bench_crypt_x509[index].root_cert,
+			    &m_bench_crypt_x509[index].root_cert_size) ||
+		    !bench_crypt_read_sample_file(
+			    m_bench_crypt_x509[index].path,
+			    "bundle_responder.certchain.der",
+			    (void **)&m_bench_crypt_x509[index].cert_chain,
+			    &m_bench_crypt_x509[index].cert_chain_size)) {
+			context = NULL;
+		}
+		bench_crypt_run(m_bench_crypt_x509[index].name,
+				m_bench_crypt_x509[index].cert_chain_size,
+				bench_crypt_x509_verify_cert_chain, context);
+		if (m_bench_crypt_x509[index].root_cert != NULL) {
+			free(m_bench_crypt_x509[index].root_cert);
+		}
+		if (m_bench_crypt_x509[index].cert_chain != NULL) {
+			free(m_bench_crypt_x509[index].cert_chain);
+		}
+	}
+
+	return 0;
+}
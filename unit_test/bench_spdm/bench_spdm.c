@@ -0,0 +1,637 @@
+/**
+    Copyright Notice:
+    Copyright 2021 DMTF. All rights reserved.
+    License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+**/
+
+/** @file
+  End-to-end SPDM benchmark.
+
+  A requester context and a responder context run back-to-back in one process.
+  The requester device IO hands each request to spdm_responder_dispatch_message
+  and returns the response it produced, so no time is spent outside the SPDM
+  libraries, the transport encoding and the crypto backend.
+**/
+
+#include "spdm_unit_test.h"
+#include <library/spdm_crypt_lib.h>
+#include <time.h>
+
+#define BENCH_SPDM_DEFAULT_ITERATIONS 100
+#define BENCH_SPDM_APP_MESSAGE_SIZE 64
+
+#if defined(BENCH_SPDM_CRYPTO_MBEDTLS)
+#define BENCH_SPDM_CRYPTO_NAME "mbedtls"
+#elif defined(BENCH_SPDM_CRYPTO_OPENSSL)
+#define BENCH_SPDM_CRYPTO_NAME "openssl"
+#else
+#define BENCH_SPDM_CRYPTO_NAME "unknown"
+#endif
+
+typedef struct {
+	char8 *name;
+	uint32 base_hash_algo;
+	uint32 base_asym_algo;
+	uint16 dhe_named_group;
+	uint16 aead_cipher_suite;
+} bench_spdm_suite_t;
+
+bench_spdm_suite_t m_bench_spdm_suite[] = {
+	{ "SHA256/RSASSA2048/FFDHE2048/AES128GCM",
+	  SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_256,
+	  SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_RSASSA_2048,
+	  SPDM_ALGORITHMS_DHE_NAMED_GROUP_FFDHE_2048,
+	  SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_AES_128_GCM },
+	{ "SHA256/RSAPSS2048/FFDHE2048/AES256GCM",
+	  SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_256,
+	  SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_RSAPSS_2048,
+	  SPDM_ALGORITHMS_DHE_NAMED_GROUP_FFDHE_2048,
+	  SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_AES_256_GCM },
+	{ "SHA384/RSASSA3072/FFDHE3072/AES256GCM",
+	  SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_384,
+	  SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_RSASSA_3072,
+	  SPDM_ALGORITHMS_DHE_NAMED_GROUP_FFDHE_3072,
+	  SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_AES_256_GCM },
+	{ "SHA512/RSAPSS3072/FFDHE4096/CHACHA20POLY1305",
+	  SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_512,
+	  SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_RSAPSS_3072,
+	  SPDM_ALGORITHMS_DHE_NAMED_GROUP_FFDHE_4096,
+	  SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_CHACHA20_POLY1305 },
+	{ "SHA256/ECDSAP256/SECP256R1/AES128GCM",
+	  SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_256,
+	  SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_ECDSA_ECC_NIST_P256,
+	  SPDM_ALGORITHMS_DHE_NAMED_GROUP_SECP_256_R1,
+	  SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_AES_128_GCM },
+	{ "SHA256/ECDSAP256/SECP256R1/CHACHA20POLY1305",
+	  SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_256,
+	  SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_ECDSA_ECC_NIST_P256,
+	  SPDM_ALGORITHMS_DHE_NAMED_GROUP_SECP_256_R1,
+	  SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_CHACHA20_POLY1305 },
+	{ "SHA384/ECDSAP384/SECP384R1/AES256GCM",
+	  SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_384,
+	  SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_ECDSA_ECC_NIST_P384,
+	  SPDM_ALGORITHMS_DHE_NAMED_GROUP_SECP_384_R1,
+	  SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_AES_256_GCM },
+	{ "SHA512/ECDSAP384/SECP521R1/AES256GCM",
+	  SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_512,
+	  SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_ECDSA_ECC_NIST_P384,
+	  SPDM_ALGORITHMS_DHE_NAMED_GROUP_SECP_521_R1,
+	  SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_AES_256_GCM },
+};
+
+typedef enum {
+	BENCH_SPDM_OPERATION_VCA,
+	BENCH_SPDM_OPERATION_GET_CERTIFICATE,
+	BENCH_SPDM_OPERATION_CHALLENGE,
+	BENCH_SPDM_OPERATION_KEY_EXCHANGE_FINISH,
+	BENCH_SPDM_OPERATION_PSK_EXCHANGE_PSK_FINISH,
+	BENCH_SPDM_OPERATION_APP_DATA,
+	BENCH_SPDM_OPERATION_MAX,
+} bench_spdm_operation_t;
+
+char8 *m_bench_spdm_operation_name[BENCH_SPDM_OPERATION_MAX] = {
+	"VCA",
+	"GET_CERTIFICATE",
+	"CHALLENGE",
+	"KEY_EXCHANGE+FINISH",
+	"PSK_EXCHANGE+PSK_FINISH",
+	"APP_DATA",
+};
+
+void *m_bench_spdm_requester_context;
+void *m_bench_spdm_responder_context;
+
+//
+// Arenas for the managed buffers, used when OPENSPDM_ARENA_MANAGED_BUFFER_SUPPORT is 1.
+//
+spdm_unit_test_arena_t m_bench_spdm_requester_arena;
+spdm_unit_test_arena_t m_bench_spdm_responder_arena;
+
+//
+// In-memory transport: one request and one response in flight at a time.
+//
+uint8 m_bench_spdm_request[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+uintn m_bench_spdm_request_size;
+uint8 m_bench_spdm_response[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+uintn m_bench_spdm_response_size;
+
+/**
+  Return a monotonic timestamp in nanoseconds.
+
+  MSVC has no clock_gettime, so the wall clock is used there.
+**/
+uint64 bench_spdm_get_time_ns(void)
+{
+	struct timespec ts;
+
+#if defined(_MSC_VER)
+	timespec_get(&ts, TIME_UTC);
+#else
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+#endif
+	return (uint64)ts.tv_sec * 1000000000ull + (uint64)ts.tv_nsec;
+}
+
+return_status bench_spdm_requester_send_message(IN void *spdm_context,
+						IN uintn message_size,
+						IN void *message,
+						IN uint64 timeout)
+{
+	if (message_size > sizeof(m_bench_spdm_request)) {
+		return RETURN_DEVICE_ERROR;
+	}
+	copy_mem(m_bench_spdm_request, message, message_size);
+	m_bench_spdm_request_size = message_size;
+	m_bench_spdm_response_size = 0;
+
+	return spdm_responder_dispatch_message(m_bench_spdm_responder_context);
+}
+
+return_status bench_spdm_requester_receive_message(IN void *spdm_context,
+						   IN OUT uintn *message_size,
+						   IN OUT void *message,
+						   IN uint64 timeout)
+{
+	if (m_bench_spdm_response_size == 0) {
+		return RETURN_DEVICE_ERROR;
+	}
+	if (*message_size < m_bench_spdm_response_size) {
+		return RETURN_DEVICE_ERROR;
+	}
+	copy_mem(message, m_bench_spdm_response, m_bench_spdm_response_size);
+	*message_size = m_bench_spdm_response_size;
+	m_bench_spdm_response_size = 0;
+	return RETURN_SUCCESS;
+}
+
+return_status bench_spdm_responder_send_message(IN void *spdm_context,
+						IN uintn message_size,
+						IN void *message,
+						IN uint64 timeout)
+{
+	if (message_size > sizeof(m_bench_spdm_response)) {
+		return RETURN_DEVICE_ERROR;
+	}
+	copy_mem(m_bench_spdm_response, message, message_size);
+	m_bench_spdm_response_size = message_size;
+	return RETURN_SUCCESS;
+}
+
+return_status bench_spdm_responder_receive_message(IN void *spdm_context,
+						   IN OUT uintn *message_size,
+						   IN OUT void *message,
+						   IN uint64 timeout)
+{
+	if (m_bench_spdm_request_size == 0) {
+		return RETURN_DEVICE_ERROR;
+	}
+	if (*message_size < m_bench_spdm_request_size) {
+		return RETURN_DEVICE_ERROR;
+	}
+	copy_mem(message, m_bench_spdm_request, m_bench_spdm_request_size);
+	*message_size = m_bench_spdm_request_size;
+	m_bench_spdm_request_size = 0;
+	return RETURN_SUCCESS;
+}
+
+/**
+  Echo an APP message back to the requester.
+**/
+return_status bench_spdm_responder_get_response(
+	IN void *spdm_context, IN uint32 *session_id, IN boolean is_app_message,
+	IN uintn request_size, IN void *request, IN OUT uintn *response_size,
+	OUT void *response)
+{
+	if (!is_app_message || (session_id == NULL)) {
+		return RETURN_UNSUPPORTED;
+	}
+	if (*response_size < request_size) {
+		*response_size = request_size;
+		return RETURN_BUFFER_TOO_SMALL;
+	}
+	copy_mem(response, request, request_size);
+	*response_size = request_size;
+	return RETURN_SUCCESS;
+}
+
+/**
+  Create a requester and a responder context configured for one algorithm suite.
+
+  The contexts are released by bench_spdm_deinit_contexts.
+
+  @param  suite                         The algorithm suite to negotiate.
+  @param  cert_chain                    On output, the responder certificate chain. The caller frees it.
+  @param  root_cert                     On output, the responder root certificate. The caller frees it.
+
+  @retval TRUE   Both contexts are created.
+  @retval FALSE  The contexts cannot be created.
+**/
+boolean bench_spdm_init_contexts(IN bench_spdm_suite_t *suite,
+				 OUT void **cert_chain, OUT void **root_cert)
+{
+	void *spdm_context;
+	spdm_data_parameter_t parameter;
+	uint8 data8;
+	uint16 data16;
+	uint32 data32;
+	uintn cert_chain_size;
+	uintn root_cert_size;
+	void *root_cert_hash;
+	uintn root_cert_hash_size;
+
+	*cert_chain = NULL;
+	*root_cert = NULL;
+	if (!read_responder_public_certificate_chain(
+		    suite->base_hash_algo, suite->base_asym_algo, cert_chain,
+		    &cert_chain_size, NULL, NULL)) {
+		return FALSE;
+	}
+	if (!read_responder_root_public_certificate(
+		    suite->base_hash_algo, suite->base_asym_algo, root_cert,
+		    &root_cert_size, &root_cert_hash, &root_cert_hash_size)) {
+		return FALSE;
+	}
+
+	//
+	// Responder
+	//
+	spdm_context = m_bench_spdm_responder_context;
+	spdm_init_context(spdm_context);
+	zero_mem(&m_bench_spdm_responder_arena,
+		 sizeof(m_bench_spdm_responder_arena));
+	spdm_register_arena_func(spdm_context, &m_bench_spdm_responder_arena,
+				 spdm_unit_test_arena_allocate,
+				 spdm_unit_test_arena_free);
+	spdm_register_device_io_func(spdm_context,
+				     bench_spdm_responder_send_message,
+				     bench_spdm_responder_receive_message);
+	spdm_register_transport_layer_func(spdm_context,
+					   spdm_transport_test_encode_message,
+					   spdm_transport_test_decode_message);
+	spdm_register_get_response_func(spdm_context,
+					bench_spdm_responder_get_response);
+
+	zero_mem(&parameter, sizeof(parameter));
+	parameter.location = SPDM_DATA_LOCATION_LOCAL;
+	data8 = 0;
+	spdm_set_data(spdm_context, SPDM_DATA_CAPABILITY_CT_EXPONENT,
+		      &parameter, &data8, sizeof(data8));
+	data32 = SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP |
+		 SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CHAL_CAP |
+		 SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MEAS_CAP_SIG |
+		 SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_ENCRYPT_CAP |
+		 SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MAC_CAP |
+		 SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_KEY_EX_CAP |
+		 SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_PSK_CAP_RESPONDER_WITH_CONTEXT |
+		 SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_HBEAT_CAP |
+		 SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_KEY_UPD_CAP;
+	spdm_set_data(spdm_context, SPDM_DATA_CAPABILITY_FLAGS, &parameter,
+		      &data32, sizeof(data32));
+	data8 = SPDM_MEASUREMENT_BLOCK_HEADER_SPECIFICATION_DMTF;
+	spdm_set_data(spdm_context, SPDM_DATA_MEASUREMENT_SPEC, &parameter,
+		      &data8, sizeof(data8));
+	data32 = SPDM_ALGORITHMS_MEASUREMENT_HASH_ALGO_TPM_ALG_SHA_256;
+	spdm_set_data(spdm_context, SPDM_DATA_MEASUREMENT_HASH_ALGO, &parameter,
+		      &data32, sizeof(data32));
+	data32 = suite->base_asym_algo;
+	spdm_set_data(spdm_context, SPDM_DATA_BASE_ASYM_ALGO, &parameter,
+		      &data32, sizeof(data32));
+	data32 = suite->base_hash_algo;
+	spdm_set_data(spdm_context, SPDM_DATA_BASE_HASH_ALGO, &parameter,
+		      &data32, sizeof(data32));
+	data16 = suite->dhe_named_group;
+	spdm_set_data(spdm_context, SPDM_DATA_DHE_NAME_GROUP, &parameter,
+		      &data16, sizeof(data16));
+	data16 = suite->aead_cipher_suite;
+	spdm_set_data(spdm_context, SPDM_DATA_AEAD_CIPHER_SUITE, &parameter,
+		      &data16, sizeof(data16));
+	data16 = SPDM_ALGORITHMS_KEY_SCHEDULE_HMAC_HASH;
+	spdm_set_data(spdm_context, SPDM_DATA_KEY_SCHEDULE, &parameter, &data16,
+		      sizeof(data16));
+	data8 = 1;
+	spdm_set_data(spdm_context, SPDM_DATA_LOCAL_SLOT_COUNT, &parameter,
+		      &data8, sizeof(data8));
+	parameter.additional_data[0] = 0;
+	spdm_set_data(spdm_context, SPDM_DATA_LOCAL_PUBLIC_CERT_CHAIN,
+		      &parameter, *cert_chain, cert_chain_size);
+
+	//
+	// Requester
+	//
+	spdm_context = m_bench_spdm_requester_context;
+	spdm_init_context(spdm_context);
+	zero_mem(&m_bench_spdm_requester_arena,
+		 sizeof(m_bench_spdm_requester_arena));
+	spdm_register_arena_func(spdm_context, &m_bench_spdm_requester_arena,
+				 spdm_unit_test_arena_allocate,
+				 spdm_unit_test_arena_free);
+	spdm_register_device_io_func(spdm_context,
+				     bench_spdm_requester_send_message,
+				     bench_spdm_requester_receive_message);
+	spdm_register_transport_layer_func(spdm_context,
+					   spdm_transport_test_encode_message,
+					   spdm_transport_test_decode_message);
+
+	zero_mem(&parameter, sizeof(parameter));
+	parameter.location = SPDM_DATA_LOCATION_LOCAL;
+	data8 = 0;
+	spdm_set_data(spdm_context, SPDM_DATA_CAPABILITY_CT_EXPONENT,
+		      &parameter, &data8, sizeof(data8));
+	data32 = SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP |
+		 SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP |
+		 SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP |
+		 SPDM_GET_CAPABILITIES_REQUEST_FLAGS_PSK_CAP_REQUESTER |
+		 SPDM_GET_CAPABILITIES_REQUEST_FLAGS_HBEAT_CAP |
+		 SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_UPD_CAP;
+	spdm_set_data(spdm_context, SPDM_DATA_CAPABILITY_FLAGS, &parameter,
+		      &data32, sizeof(data32));
+	data8 = SPDM_MEASUREMENT_BLOCK_HEADER_SPECIFICATION_DMTF;
+	spdm_set_data(spdm_context, SPDM_DATA_MEASUREMENT_SPEC, &parameter,
+		      &data8, sizeof(data8));
+	data32 = suite->base_asym_algo;
+	spdm_set_data(spdm_context, SPDM_DATA_BASE_ASYM_ALGO, &parameter,
+		      &data32, sizeof(data32));
+	data32 = suite->base_hash_algo;
+	spdm_set_data(spdm_context, SPDM_DATA_BASE_HASH_ALGO, &parameter,
+		      &data32, sizeof(data32));
+	data16 = suite->dhe_named_group;
+	spdm_set_data(spdm_context, SPDM_DATA_DHE_NAME_GROUP, &parameter,
+		      &data16, sizeof(data16));
+	data16 = suite->aead_cipher_suite;
+	spdm_set_data(spdm_context, SPDM_DATA_AEAD_CIPHER_SUITE, &parameter,
+		      &data16, sizeof(data16));
+	data16 = SPDM_ALGORITHMS_KEY_SCHEDULE_HMAC_HASH;
+	spdm_set_data(spdm_context, SPDM_DATA_KEY_SCHEDULE, &parameter, &data16,
+		      sizeof(data16));
+	spdm_set_data(spdm_context, SPDM_DATA_PEER_PUBLIC_ROOT_CERT_HASH,
+		      &parameter, root_cert_hash, root_cert_hash_size);
+
+	return TRUE;
+}
+
+/**
+  Release the requester and the responder context of one algorithm suite.
+**/
+void bench_spdm_deinit_contexts(void)
+{
+	spdm_deinit_context(m_bench_spdm_requester_context);
+	spdm_deinit_context(m_bench_spdm_responder_context);
+}
+
+/**
+  Run VCA, and GET_CERTIFICATE if requested, outside the timed region.
+**/
+return_status bench_spdm_prepare(IN boolean get_certificate)
+{
+	return_status status;
+	uintn cert_chain_size;
+	uint8 cert_chain[MAX_SPDM_CERT_CHAIN_SIZE];
+
+	status = spdm_init_connection(m_bench_spdm_requester_context, FALSE);
+	if (RETURN_ERROR(status) || !get_certificate) {
+		return status;
+	}
+	cert_chain_size = sizeof(cert_chain);
+	return spdm_get_certificate(m_bench_spdm_requester_context, 0,
+				    &cert_chain_size, cert_chain);
+}
+
+/**
+  Run one iteration of an operation and return its latency.
+
+  Any setup the operation depends on (a fresh connection, a verified
+  certificate chain, an open session) is done before the clock starts, and any
+  teardown after it stops.
+
+  @param  operation                     The operation to time.
+  @param  latency                       On output, the latency in nanoseconds.
+
+  @retval RETURN_SUCCESS               The operation completed.
+  @return Other                        The status of the failed SPDM call.
+**/
+return_status bench_spdm_run_once(IN bench_spdm_operation_t operation,
+				  OUT uint64 *latency)
+{
+	void *spdm_context;
+	return_status status;
+	uint64 start;
+	uintn cert_chain_size;
+	uint8 cert_chain[MAX_SPDM_CERT_CHAIN_SIZE];
+	uint8 measurement_hash[MAX_HASH_SIZE];
+	uint32 session_id;
+	uint8 heartbeat_period;
+	uint8 app_request[BENCH_SPDM_APP_MESSAGE_SIZE];
+	uint8 app_response[BENCH_SPDM_APP_MESSAGE_SIZE];
+	uintn app_response_size;
+
+	spdm_context = m_bench_spdm_requester_context;
+	switch (operation) {
+	case BENCH_SPDM_OPERATION_VCA:
+		start = bench_spdm_get_time_ns();
+		status = spdm_init_connection(spdm_context, FALSE);
+		*latency = bench_spdm_get_time_ns() - start;
+		return status;
+
+	case BENCH_SPDM_OPERATION_GET_CERTIFICATE:
+		status = bench_spdm_prepare(FALSE);
+		if (RETURN_ERROR(status)) {
+			return status;
+		}
+		//
+		// No certificate chain verify cache is registered, so the full chain
+		// verification is timed.
+		//
+		cert_chain_size = sizeof(cert_chain);
+		start = bench_spdm_get_time_ns();
+		status = spdm_get_certificate(spdm_context, 0, &cert_chain_size,
+					      cert_chain);
+		*latency = bench_spdm_get_time_ns() - start;
+		return status;
+
+	case BENCH_SPDM_OPERATION_CHALLENGE:
+		status = bench_spdm_prepare(TRUE);
+		if (RETURN_ERROR(status)) {
+			return status;
+		}
+		start = bench_spdm_get_time_ns();
+		status = spdm_challenge(
+			spdm_context, 0,
+			SPDM_CHALLENGE_REQUEST_NO_MEASUREMENT_SUMMARY_HASH,
+			measurement_hash);
+		*latency = bench_spdm_get_time_ns() - start;
+		return status;
+
+	case BENCH_SPDM_OPERATION_KEY_EXCHANGE_FINISH:
+	case BENCH_SPDM_OPERATION_PSK_EXCHANGE_PSK_FINISH:
+		start = bench_spdm_get_time_ns();
+		status = spdm_start_session(
+			spdm_context,
+			(operation ==
+			 BENCH_SPDM_OPERATION_PSK_EXCHANGE_PSK_FINISH),
+			SPDM_KEY_EXCHANGE_REQUEST_NO_MEASUREMENT_SUMMARY_HASH,
+			0, &session_id, &heartbeat_period, measurement_hash);
+		*latency = bench_spdm_get_time_ns() - start;
+		if (RETURN_ERROR(status)) {
+			return status;
+		}
+		return spdm_stop_session(spdm_context, session_id, 0);
+
+	case BENCH_SPDM_OPERATION_APP_DATA:
+		status = spdm_start_session(
+			spdm_context, FALSE,
+			SPDM_KEY_EXCHANGE_REQUEST_NO_MEASUREMENT_SUMMARY_HASH,
+			0, &session_id, &heartbeat_period, measurement_hash);
+		if (RETURN_ERROR(status)) {
+			return status;
+		}
+		//
+		// The first byte is not a test transport message type, so the
+		// responder hands the payload to its get_response function.
+		//
+		set_mem(app_request, sizeof(app_request), 0xA5);
+		app_response_size = sizeof(app_response);
+		start = bench_spdm_get_time_ns();
+		status = spdm_send_receive_data(spdm_context, &session_id, TRUE,
+						app_request, sizeof(app_request),
+						app_response,
+						&app_response_size);
+		*latency = bench_spdm_get_time_ns() - start;
+		if (RETURN_ERROR(status)) {
+			return status;
+		}
+		return spdm_stop_session(spdm_context, session_id, 0);
+
+	default:
+		return RETURN_UNSUPPORTED;
+	}
+}
+
+int bench_spdm_compare_latency(const void *a, const void *b)
+{
+	uint64 left;
+	uint64 right;
+
+	left = *(const uint64 *)a;
+	right = *(const uint64 *)b;
+	if (left < right) {
+		return -1;
+	}
+	return (left > right) ? 1 : 0;
+}
+
+/**
+  Time one operation and print its throughput and p50/p99 latency.
+
+  @retval TRUE   Every iteration succeeded.
+  @retval FALSE  An iteration failed.
+**/
+boolean bench_spdm_run_operation(IN bench_spdm_suite_t *suite,
+				 IN bench_spdm_operation_t operation,
+				 IN uintn iterations, IN uint64 *latency)
+{
+	return_status status;
+	uintn index;
+	uint64 total;
+
+	//
+	// Sessions build on the certificate chain fetched once per suite.
+	//
+	if ((operation == BENCH_SPDM_OPERATION_KEY_EXCHANGE_FINISH) ||
+	    (operation == BENCH_SPDM_OPERATION_PSK_EXCHANGE_PSK_FINISH) ||
+	    (operation == BENCH_SPDM_OPERATION_APP_DATA)) {
+		status = bench_spdm_prepare(TRUE);
+		if (RETURN_ERROR(status)) {
+			printf("%-44s %-24s FAILED (setup %x)\n", suite->name,
+			       m_bench_spdm_operation_name[operation],
+			       (uint32)status);
+			return FALSE;
+		}
+	}
+
+	total = 0;
+	for (index = 0; index < iterations; index++) {
+		status = bench_spdm_run_once(operation, &latency[index]);
+		if (RETURN_ERROR(status)) {
+			printf("%-44s %-24s FAILED (iteration %d, %x)\n",
+			       suite->name,
+			       m_bench_spdm_operation_name[operation],
+			       (uint32)index, (uint32)status);
+			return FALSE;
+		}
+		total += latency[index];
+	}
+
+	qsort(latency, iterations, sizeof(uint64), bench_spdm_compare_latency);
+	printf("%-44s %-24s %10.1f %12.1f %12.1f\n", suite->name,
+	       m_bench_spdm_operation_name[operation],
+	       (total == 0) ? 0.0 : (double)iterations * 1e9 / (double)total,
+	       (double)latency[iterations / 2] / 1000.0,
+	       (double)latency[(iterations * 99) / 100] / 1000.0);
+	return TRUE;
+}
+
+int main(int argc, char *argv[])
+{
+	uintn iterations;
+	uintn suite_index;
+	uintn operation;
+	uint64 *latency;
+	void *cert_chain;
+	void *root_cert;
+	int return_value;
+
+	iterations = BENCH_SPDM_DEFAULT_ITERATIONS;
+	if (argc > 1) {
+		iterations = (uintn)strtoul(argv[1], NULL, 0);
+		if (iterations == 0) {
+			printf("usage: bench_spdm [iterations]\n");
+			return 1;
+		}
+	}
+
+	m_bench_spdm_requester_context = malloc(spdm_get_context_size());
+	m_bench_spdm_responder_context = malloc(spdm_get_context_size());
+	latency = malloc(iterations * sizeof(uint64));
+	if ((m_bench_spdm_requester_context == NULL) ||
+	    (m_bench_spdm_responder_context == NULL) || (latency == NULL)) {
+		printf("bench_spdm: out of memory\n");
+		return 1;
+	}
+
+	printf("crypto %s, %d iterations per operation\n",
+	       BENCH_SPDM_CRYPTO_NAME, (uint32)iterations);
+	printf("%-44s %-24s %10s %12s %12s\n", "suite", "operation", "ops/s",
+	       "p50(us)", "p99(us)");
+
+	return_value = 0;
+	for (suite_index = 0; suite_index < ARRAY_SIZE(m_bench_spdm_suite);
+	     suite_index++) {
+		if (!bench_spdm_init_contexts(&m_bench_spdm_suite[suite_index],
+					      &cert_chain, &root_cert)) {
+			printf("%-44s cannot load the sample certificates\n",
+			       m_bench_spdm_suite[suite_index].name);
+			return_value = 1;
+		} else {
+			for (operation = 0; operation < BENCH_SPDM_OPERATION_MAX;
+			     operation++) {
+				if (!bench_spdm_run_operation(
+					    &m_bench_spdm_suite[suite_index],
+					    operation, iterations, latency)) {
+					return_value = 1;
+				}
+			}
+			bench_spdm_deinit_contexts();
+		}
+		if (cert_chain != NULL) {
+			free(cert_chain);
+		}
+		if (root_cert != NULL) {
+			free(root_cert);
+		}
+	}
+
+	free(latency);
+	free(m_bench_spdm_responder_context);
+	free(m_bench_spdm_requester_context);
+	return return_value;
+}
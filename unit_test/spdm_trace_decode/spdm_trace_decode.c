@@ -0,0 +1,284 @@
+/**
+    Copyright Notice:
+    Copyright 2021 DMTF. All rights reserved.
+    License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+**/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <base.h>
+#include <library/spdm_common_lib.h>
+
+typedef struct {
+	uint8 code;
+	char8 *name;
+} spdm_trace_decode_name_t;
+
+spdm_trace_decode_name_t m_spdm_trace_decode_opcode_name[] = {
+	{ SPDM_DIGESTS, "DIGESTS" },
+	{ SPDM_CERTIFICATE, "CERTIFICATE" },
+	{ SPDM_CHALLENGE_AUTH, "CHALLENGE_AUTH" },
+	{ SPDM_VERSION, "VERSION" },
+	{ SPDM_MEASUREMENTS, "MEASUREMENTS" },
+	{ SPDM_CAPABILITIES, "CAPABILITIES" },
+	{ SPDM_ALGORITHMS, "ALGORITHMS" },
+	{ SPDM_VENDOR_DEFINED_RESPONSE, "VENDOR_DEFINED_RESPONSE" },
+	{ SPDM_ERROR, "ERROR" },
+	{ SPDM_KEY_EXCHANGE_RSP, "KEY_EXCHANGE_RSP" },
+	{ SPDM_FINISH_RSP, "FINISH_RSP" },
+	{ SPDM_PSK_EXCHANGE_RSP, "PSK_EXCHANGE_RSP" },
+	{ SPDM_PSK_FINISH_RSP, "PSK_FINISH_RSP" },
+	{ SPDM_HEARTBEAT_ACK, "HEARTBEAT_ACK" },
+	{ SPDM_KEY_UPDATE_ACK, "KEY_UPDATE_ACK" },
+	{ SPDM_ENCAPSULATED_REQUEST, "ENCAPSULATED_REQUEST" },
+	{ SPDM_ENCAPSULATED_RESPONSE_ACK, "ENCAPSULATED_RESPONSE_ACK" },
+	{ SPDM_END_SESSION_ACK, "END_SESSION_ACK" },
+	{ SPDM_GET_DIGESTS, "GET_DIGESTS" },
+	{ SPDM_GET_CERTIFICATE, "GET_CERTIFICATE" },
+	{ SPDM_CHALLENGE, "CHALLENGE" },
+	{ SPDM_GET_VERSION, "GET_VERSION" },
+	{ SPDM_GET_MEASUREMENTS, "GET_MEASUREMENTS" },
+	{ SPDM_GET_CAPABILITIES, "GET_CAPABILITIES" },
+	{ SPDM_NEGOTIATE_ALGORITHMS, "NEGOTIATE_ALGORITHMS" },
+	{ SPDM_VENDOR_DEFINED_REQUEST, "VENDOR_DEFINED_REQUEST" },
+	{ SPDM_RESPOND_IF_READY, "RESPOND_IF_READY" },
+	{ SPDM_KEY_EXCHANGE, "KEY_EXCHANGE" },
+	{ SPDM_FINISH, "FINISH" },
+	{ SPDM_PSK_EXCHANGE, "PSK_EXCHANGE" },
+	{ SPDM_PSK_FINISH, "PSK_FINISH" },
+	{ SPDM_HEARTBEAT, "HEARTBEAT" },
+	{ SPDM_KEY_UPDATE, "KEY_UPDATE" },
+	{ SPDM_GET_ENCAPSULATED_REQUEST, "GET_ENCAPSULATED_REQUEST" },
+	{ SPDM_DELIVER_ENCAPSULATED_RESPONSE, "DELIVER_ENCAPSULATED_RESPONSE" },
+	{ SPDM_END_SESSION, "END_SESSION" },
+};
+
+spdm_trace_decode_name_t m_spdm_trace_decode_event_name[] = {
+	{ SPDM_TRACE_EVENT_REQUEST_SENT, "REQUEST_SENT" },
+	{ SPDM_TRACE_EVENT_RESPONSE_RECEIVED, "RESPONSE_RECEIVED" },
+	{ SPDM_TRACE_EVENT_REQUEST_RECEIVED, "REQUEST_RECEIVED" },
+	{ SPDM_TRACE_EVENT_RESPONSE_SENT, "RESPONSE_SENT" },
+};
+
+/**
+  Return the name of a code.
+
+  @param  name_table                    The code name table.
+  @param  name_count                    The number of entries in the code name table.
+  @param  code                          The code.
+
+  @return the name of the code, or "UNKNOWN".
+**/
+char8 *spdm_trace_decode_get_name(IN spdm_trace_decode_name_t *name_table,
+				  IN uintn name_count, IN uint8 code)
+{
+	uintn index;
+
+	for (index = 0; index < name_count; index++) {
+		if (name_table[index].code == code) {
+			return name_table[index].name;
+		}
+	}
+	return "UNKNOWN";
+}
+
+/**
+  Compare two trace events by sequence, for qsort.
+**/
+int spdm_trace_decode_compare_event(IN const void *event1,
+				    IN const void *event2)
+{
+	uint32 sequence1;
+	uint32 sequence2;
+
+	sequence1 = (*(spdm_trace_event_t *const *)event1)->sequence;
+	sequence2 = (*(spdm_trace_event_t *const *)event2)->sequence;
+	if (sequence1 < sequence2) {
+		return -1;
+	}
+	if (sequence1 > sequence2) {
+		return 1;
+	}
+	return 0;
+}
+
+/**
+  Read a whole file.
+
+  @param  file_name                     The name of the file.
+  @param  file_data                     On output, the data of the file. The caller frees it.
+  @param  file_size                     On output, the size in bytes of the file.
+
+  @retval TRUE  The file is read.
+  @retval FALSE The file cannot be read.
+**/
+boolean spdm_trace_decode_read_file(IN char8 *file_name, OUT void **file_data,
+				    OUT uintn *file_size)
+{
+	FILE *fp_in;
+	long size;
+
+	fp_in = fopen(file_name, "rb");
+	if (fp_in == NULL) {
+		return FALSE;
+	}
+	fseek(fp_in, 0, SEEK_END);
+	size = ftell(fp_in);
+	fseek(fp_in, 0, SEEK_SET);
+	if (size <= 0) {
+		fclose(fp_in);
+		return FALSE;
+	}
+
+	*file_data = malloc(size);
+	if (*file_data == NULL) {
+		fclose(fp_in);
+		return FALSE;
+	}
+	if (fread(*file_data, 1, size, fp_in) != (size_t)size) {
+		free(*file_data);
+		fclose(fp_in);
+		return FALSE;
+	}
+	*file_size = size;
+
+	fclose(fp_in);
+	return TRUE;
+}
+
+/**
+  Print the events of a trace buffer in the order they were recorded.
+
+  @param  trace_buffer                   A pointer to the trace buffer.
+
+  @retval 0  The events are printed.
+  @retval 1  The trace buffer is invalid.
+**/
+int spdm_trace_decode(IN spdm_trace_buffer_t *trace_buffer)
+{
+	spdm_trace_event_t *event;
+	spdm_trace_event_t **sorted_event;
+	uint32 index;
+	uint32 sorted_count;
+	uint32 torn_count;
+	uint32 lost_count;
+	uint64 first_timestamp;
+
+	event = (void *)(trace_buffer + 1);
+
+	sorted_event = malloc(sizeof(*sorted_event) * trace_buffer->event_count);
+	if (sorted_event == NULL) {
+		return 1;
+	}
+	sorted_count = 0;
+	torn_count = 0;
+	for (index = 0; index < trace_buffer->event_count; index++) {
+		if (event[index].sequence == 0) {
+			//
+			// A slot below write_index was written, and is still being
+			// written or was dropped on a collision.
+			//
+			if ((trace_buffer->write_index >=
+			     trace_buffer->event_count) ||
+			    (index < trace_buffer->write_index)) {
+				torn_count++;
+			}
+			continue;
+		}
+		if (((event[index].sequence - 1) &
+		     (trace_buffer->event_count - 1)) != index) {
+			torn_count++;
+			continue;
+		}
+		sorted_event[sorted_count++] = &event[index];
+	}
+	qsort(sorted_event, sorted_count, sizeof(*sorted_event),
+	      spdm_trace_decode_compare_event);
+
+	if (trace_buffer->write_index > trace_buffer->event_count) {
+		lost_count = trace_buffer->write_index -
+			     trace_buffer->event_count;
+	} else {
+		lost_count = 0;
+	}
+	printf("events: %u recorded, %u decoded, %u overwritten, %u incomplete, %u collided\n",
+	       trace_buffer->write_index, sorted_count, lost_count, torn_count,
+	       trace_buffer->collision_count);
+
+	first_timestamp = (sorted_count != 0) ? sorted_event[0]->timestamp : 0;
+	for (index = 0; index < sorted_count; index++) {
+		event = sorted_event[index];
+		printf("#%u +%llu ctx=0x%llx ", event->sequence,
+		       (unsigned long long)(event->timestamp - first_timestamp),
+		       (unsigned long long)event->spdm_context);
+		if ((event->flags & SPDM_TRACE_EVENT_FLAG_SESSION_ID_VALID) !=
+		    0) {
+			printf("session=0x%08x ", event->session_id);
+		} else {
+			printf("session=-          ");
+		}
+		printf("%-17s ",
+		       spdm_trace_decode_get_name(
+			       m_spdm_trace_decode_event_name,
+			       ARRAY_SIZE(m_spdm_trace_decode_event_name),
+			       event->event_type));
+		if ((event->flags & SPDM_TRACE_EVENT_FLAG_APP_MESSAGE) != 0) {
+			printf("APP_MESSAGE");
+		} else {
+			printf("%s(0x%02x) param1=0x%02x",
+			       spdm_trace_decode_get_name(
+				       m_spdm_trace_decode_opcode_name,
+				       ARRAY_SIZE(m_spdm_trace_decode_opcode_name),
+				       event->opcode),
+			       event->opcode, event->param1);
+		}
+		printf(" size=%u", event->message_size);
+		if (event->message != 0) {
+			printf(" message=0x%llx",
+			       (unsigned long long)event->message);
+		}
+		printf("\n");
+	}
+
+	free(sorted_event);
+	return 0;
+}
+
+int main(int argc, char *argv[])
+{
+	void *file_data;
+	uintn file_size;
+	spdm_trace_buffer_t *trace_buffer;
+	int result;
+
+	if (argc != 2) {
+		printf("usage: spdm_trace_decode <trace_buffer_file>\n");
+		return 1;
+	}
+
+	if (!spdm_trace_decode_read_file(argv[1], &file_data, &file_size)) {
+		printf("cannot read %s\n", argv[1]);
+		return 1;
+	}
+
+	trace_buffer = file_data;
+	if ((file_size < sizeof(spdm_trace_buffer_t)) ||
+	    (trace_buffer->signature != SPDM_TRACE_BUFFER_SIGNATURE) ||
+	    (trace_buffer->version != SPDM_TRACE_BUFFER_VERSION) ||
+	    (trace_buffer->event_size != sizeof(spdm_trace_event_t)) ||
+	    (trace_buffer->event_count == 0) ||
+	    ((trace_buffer->event_count & (trace_buffer->event_count - 1)) !=
+	     0) ||
+	    (file_size < sizeof(spdm_trace_buffer_t) +
+				 sizeof(spdm_trace_event_t) *
+					 trace_buffer->event_count)) {
+		printf("%s is not a trace buffer\n", argv[1]);
+		free(file_data);
+		return 1;
+	}
+
+	result = spdm_trace_decode(trace_buffer);
+	free(file_data);
+	return result;
+}
\ No newline at end of file
@@ -8,6 +8,8 @@
 
 spdm_test_context_t *m_spdm_test_context;
 
+spdm_unit_test_arena_t m_spdm_unit_test_arena;
+
 spdm_test_context_t *get_spdm_test_context(void)
 {
 	return m_spdm_test_context;
@@ -39,6 +41,9 @@ int spdm_unit_test_group_setup(void **state)
 	spdm_register_transport_layer_func(spdm_context,
 					   spdm_transport_test_encode_message,
 					   spdm_transport_test_decode_message);
+	spdm_register_arena_func(spdm_context, &m_spdm_unit_test_arena,
+				 spdm_unit_test_arena_allocate,
+				 spdm_unit_test_arena_free);
 
 	*state = spdm_test_context;
 	return 0;
@@ -68,6 +68,22 @@ typedef struct {
 #define SPDM_TEST_CONTEXT_FROM_SPDM_CONTEXT(a)                                 \
 	BASE_CR(a, spdm_test_context_t, spdm_context)
 
+//
+// Arena registered by spdm_unit_test_group_setup, backed by malloc.
+// max_size limits the bytes allocated at a time. 0 means no limit.
+//
+typedef struct {
+	uintn max_size;
+	uintn allocated_size;
+	uintn allocation_count;
+} spdm_unit_test_arena_t;
+
+extern spdm_unit_test_arena_t m_spdm_unit_test_arena;
+
+void *spdm_unit_test_arena_allocate(IN void *arena, IN uintn size);
+
+void spdm_unit_test_arena_free(IN void *arena, IN void *buffer);
+
 int spdm_unit_test_group_setup(void **state);
 
 int spdm_unit_test_group_teardown(void **state);
@@ -6,6 +6,41 @@
 
 #include "spdm_unit_test.h"
 
+void *spdm_unit_test_arena_allocate(IN void *arena, IN uintn size)
+{
+	spdm_unit_test_arena_t *test_arena;
+	uintn *buffer;
+
+	test_arena = arena;
+	if ((test_arena->max_size != 0) &&
+	    (size > test_arena->max_size - test_arena->allocated_size)) {
+		return NULL;
+	}
+	//
+	// Keep the size in front of the buffer, so that free can account for it.
+	//
+	buffer = malloc(sizeof(uintn) + size);
+	if (buffer == NULL) {
+		return NULL;
+	}
+	buffer[0] = size;
+	test_arena->allocated_size += size;
+	test_arena->allocation_count++;
+	return buffer + 1;
+}
+
+void spdm_unit_test_arena_free(IN void *arena, IN void *buffer)
+{
+	spdm_unit_test_arena_t *test_arena;
+	uintn *header;
+
+	test_arena = arena;
+	header = (uintn *)buffer - 1;
+	test_arena->allocated_size -= header[0];
+	test_arena->allocation_count--;
+	free(header);
+}
+
 void dump_hex_str(IN uint8 *buffer, IN uintn buffer_size)
 {
 	uintn index;
@@ -140,6 +140,8 @@ return_status validate_crypt_aead_cipher(void)
 	uintn OutBufferSize;
 	uint8 OutTag[1024];
 	uintn OutTagSize;
+	void *aead_ctx;
+	uintn index;
 
 	my_print("\nCrypto AEAD Testing: ");
 
@@ -189,6 +191,45 @@ return_status validate_crypt_aead_cipher(void)
 
 	my_print("[Pass]");
 
+	my_print("\n- AES-GCM Keyed Context: ");
+	aead_ctx = aead_aes_gcm_new(m_gcm_key, sizeof(m_gcm_key));
+	if (aead_ctx == NULL) {
+		my_print("[Fail]");
+		return RETURN_ABORTED;
+	}
+	for (index = 0; index < 2; index++) {
+		OutBufferSize = sizeof(OutBuffer);
+		OutTagSize = sizeof(m_gcm_tag);
+		status = aead_aes_gcm_encrypt_with_context(
+			aead_ctx, m_gcm_iv, sizeof(m_gcm_iv), m_gcm_aad,
+			sizeof(m_gcm_aad), m_gcm_pt, sizeof(m_gcm_pt), OutTag,
+			OutTagSize, OutBuffer, &OutBufferSize);
+		if (!status || (OutBufferSize != sizeof(m_gcm_ct)) ||
+		    (const_compare_mem(OutBuffer, m_gcm_ct, sizeof(m_gcm_ct)) !=
+		     0) ||
+		    (const_compare_mem(OutTag, m_gcm_tag, sizeof(m_gcm_tag)) !=
+		     0)) {
+			my_print("[Fail]");
+			aead_aes_gcm_free(aead_ctx);
+			return RETURN_ABORTED;
+		}
+		status = aead_aes_gcm_decrypt_with_context(
+			aead_ctx, m_gcm_iv, sizeof(m_gcm_iv), m_gcm_aad,
+			sizeof(m_gcm_aad), m_gcm_ct, sizeof(m_gcm_ct),
+			m_gcm_tag, sizeof(m_gcm_tag), OutBuffer,
+			&OutBufferSize);
+		if (!status || (OutBufferSize != sizeof(m_gcm_pt)) ||
+		    (const_compare_mem(OutBuffer, m_gcm_pt, sizeof(m_gcm_pt)) !=
+		     0)) {
+			my_print("[Fail]");
+			aead_aes_gcm_free(aead_ctx);
+			return RETURN_ABORTED;
+		}
+	}
+	aead_aes_gcm_free(aead_ctx);
+
+	my_print("[Pass]");
+
 	my_print("\n- ChaCha20Poly1305 Encryption: ");
 	OutBufferSize = sizeof(OutBuffer);
 	OutTagSize = sizeof(m_chacha20_poly1305_tag);
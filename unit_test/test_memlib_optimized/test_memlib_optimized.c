@@ -0,0 +1,309 @@
+/**
+    Copyright Notice:
+    Copyright 2021 DMTF. All rights reserved.
+    License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+**/
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <cmocka.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <assert.h>
+#include <string.h>
+
+#undef NULL
+#include <base.h>
+#include <library/memlib.h>
+
+//
+// Large enough to cover several uintn words after any head and before any tail.
+//
+#define TEST_MEMLIB_OPTIMIZED_BUFFER_SIZE 96
+#define TEST_MEMLIB_OPTIMIZED_MAX_OFFSET 16
+#define TEST_MEMLIB_OPTIMIZED_GUARD 0xA5
+
+static uint8 m_test_buffer[TEST_MEMLIB_OPTIMIZED_BUFFER_SIZE +
+			   2 * TEST_MEMLIB_OPTIMIZED_MAX_OFFSET];
+static uint8 m_expected_buffer[TEST_MEMLIB_OPTIMIZED_BUFFER_SIZE +
+			       2 * TEST_MEMLIB_OPTIMIZED_MAX_OFFSET];
+
+/**
+  Fill a buffer with a byte pattern that differs at every offset.
+
+  @param  buffer                        The buffer to fill.
+  @param  length                        The size in bytes of the buffer.
+  @param  seed                          The first byte of the pattern.
+**/
+static void internal_test_memlib_optimized_fill_pattern(OUT uint8 *buffer,
+					      IN uintn length, IN uint8 seed)
+{
+	uintn index;
+
+	for (index = 0; index < length; index++) {
+		buffer[index] = (uint8)(seed + index * 7);
+	}
+}
+
+/**
+  Byte by byte reference of an overlapping copy, through a temporary buffer.
+
+  @param  destination                   The destination of the copy.
+  @param  source                        The source of the copy.
+  @param  length                        The number of bytes to copy.
+**/
+static void internal_test_memlib_optimized_reference_copy(OUT uint8 *destination,
+						IN const uint8 *source,
+						IN uintn length)
+{
+	uint8 temp[TEST_MEMLIB_OPTIMIZED_BUFFER_SIZE];
+	uintn index;
+
+	for (index = 0; index < length; index++) {
+		temp[index] = source[index];
+	}
+	for (index = 0; index < length; index++) {
+		destination[index] = temp[index];
+	}
+}
+
+/**
+  Copy within one buffer from src_offset to dst_offset, and compare the whole buffer
+  against the reference copy, so that any write outside of the destination is caught.
+
+  @param  dst_offset                    The offset of the destination in the test buffer.
+  @param  src_offset                    The offset of the source in the test buffer.
+  @param  length                        The number of bytes to copy.
+**/
+static void internal_test_memlib_optimized_check_copy(IN uintn dst_offset,
+					    IN uintn src_offset,
+					    IN uintn length)
+{
+	internal_test_memlib_optimized_fill_pattern(m_test_buffer, sizeof(m_test_buffer),
+					  0x11);
+	internal_test_memlib_optimized_fill_pattern(m_expected_buffer,
+					  sizeof(m_expected_buffer), 0x11);
+
+	assert_ptr_equal(copy_mem(m_test_buffer + dst_offset,
+				  m_test_buffer + src_offset, length),
+			 m_test_buffer + dst_offset);
+	internal_test_memlib_optimized_reference_copy(m_expected_buffer + dst_offset,
+					    m_expected_buffer + src_offset,
+					    length);
+	assert_memory_equal(m_test_buffer, m_expected_buffer,
+			    sizeof(m_test_buffer));
+}
+
+/**
+  Test 1: copy_mem between disjoint buffers
+  Expected Behavior: every combination of unaligned head, unaligned tail and length is copied
+  exactly, without touching the bytes around the destination.
+**/
+void test_memlib_optimized_copy_mem_case1(void **state)
+{
+	uintn dst_offset;
+	uintn src_offset;
+	uintn length;
+
+	for (dst_offset = 0; dst_offset < sizeof(uintn); dst_offset++) {
+		for (src_offset = 0; src_offset < sizeof(uintn);
+		     src_offset++) {
+			for (length = 0; length <= TEST_MEMLIB_OPTIMIZED_BUFFER_SIZE / 2;
+			     length++) {
+				internal_test_memlib_optimized_check_copy(
+					dst_offset,
+					TEST_MEMLIB_OPTIMIZED_BUFFER_SIZE / 2 +
+						TEST_MEMLIB_OPTIMIZED_MAX_OFFSET +
+						src_offset,
+					length);
+				internal_test_memlib_optimized_check_copy(
+					TEST_MEMLIB_OPTIMIZED_BUFFER_SIZE / 2 +
+						TEST_MEMLIB_OPTIMIZED_MAX_OFFSET +
+						dst_offset,
+					src_offset, length);
+			}
+		}
+	}
+}
+
+/**
+  Test 2: copy_mem where the destination overlaps the end of the source
+  Expected Behavior: the copy runs backward and matches memmove semantics.
+**/
+void test_memlib_optimized_copy_mem_case2(void **state)
+{
+	uintn shift;
+	uintn src_offset;
+	uintn length;
+
+	for (shift = 1; shift <= TEST_MEMLIB_OPTIMIZED_MAX_OFFSET; shift++) {
+		for (src_offset = 0; src_offset < sizeof(uintn);
+		     src_offset++) {
+			for (length = 0; length <= TEST_MEMLIB_OPTIMIZED_BUFFER_SIZE;
+			     length++) {
+				internal_test_memlib_optimized_check_copy(
+					src_offset + shift, src_offset, length);
+			}
+		}
+	}
+}
+
+/**
+  Test 3: copy_mem where the destination overlaps the start of the source
+  Expected Behavior: the copy runs forward and matches memmove semantics.
+**/
+void test_memlib_optimized_copy_mem_case3(void **state)
+{
+	uintn shift;
+	uintn dst_offset;
+	uintn length;
+
+	for (shift = 1; shift <= TEST_MEMLIB_OPTIMIZED_MAX_OFFSET; shift++) {
+		for (dst_offset = 0; dst_offset < sizeof(uintn);
+		     dst_offset++) {
+			for (length = 0; length <= TEST_MEMLIB_OPTIMIZED_BUFFER_SIZE;
+			     length++) {
+				internal_test_memlib_optimized_check_copy(
+					dst_offset, dst_offset + shift, length);
+			}
+		}
+	}
+}
+
+/**
+  Test 4: copy_mem with the same source and destination
+  Expected Behavior: the buffer is unchanged.
+**/
+void test_memlib_optimized_copy_mem_case4(void **state)
+{
+	internal_test_memlib_optimized_check_copy(3, 3, TEST_MEMLIB_OPTIMIZED_BUFFER_SIZE);
+}
+
+/**
+  Test 5: set_mem, zero_mem and zero_mem_secure with unaligned heads and tails
+  Expected Behavior: exactly length bytes are written, the guard bytes around them are kept.
+**/
+void test_memlib_optimized_set_mem_case1(void **state)
+{
+	uintn offset;
+	uintn length;
+	uintn index;
+	uint8 *buffer;
+
+	for (offset = 0; offset < sizeof(uintn); offset++) {
+		for (length = 0; length <= TEST_MEMLIB_OPTIMIZED_BUFFER_SIZE; length++) {
+			buffer = m_test_buffer + TEST_MEMLIB_OPTIMIZED_MAX_OFFSET + offset;
+
+			set_mem(m_test_buffer, sizeof(m_test_buffer),
+				TEST_MEMLIB_OPTIMIZED_GUARD);
+			assert_ptr_equal(set_mem(buffer, length, 0x3C), buffer);
+			for (index = 0; index < sizeof(m_test_buffer); index++) {
+				if ((m_test_buffer + index >= buffer) &&
+				    (m_test_buffer + index < buffer + length)) {
+					assert_int_equal(m_test_buffer[index],
+							 0x3C);
+				} else {
+					assert_int_equal(m_test_buffer[index],
+							 TEST_MEMLIB_OPTIMIZED_GUARD);
+				}
+			}
+
+			assert_ptr_equal(zero_mem(buffer, length), buffer);
+			for (index = 0; index < sizeof(m_test_buffer); index++) {
+				if ((m_test_buffer + index >= buffer) &&
+				    (m_test_buffer + index < buffer + length)) {
+					assert_int_equal(m_test_buffer[index],
+							 0);
+				} else {
+					assert_int_equal(m_test_buffer[index],
+							 TEST_MEMLIB_OPTIMIZED_GUARD);
+				}
+			}
+
+			set_mem(buffer, length, 0x3C);
+			assert_ptr_equal(zero_mem_secure(buffer, length),
+					 buffer);
+			for (index = 0; index < sizeof(m_test_buffer); index++) {
+				if ((m_test_buffer + index >= buffer) &&
+				    (m_test_buffer + index < buffer + length)) {
+					assert_int_equal(m_test_buffer[index],
+							 0);
+				} else {
+					assert_int_equal(m_test_buffer[index],
+							 TEST_MEMLIB_OPTIMIZED_GUARD);
+				}
+			}
+		}
+	}
+}
+
+/**
+  Test 6: const_compare_mem on equal buffers and on buffers with one different byte
+  Expected Behavior: 0 for equal buffers, non-zero for a difference at any position,
+  for every relative alignment of the two buffers.
+**/
+void test_memlib_optimized_const_compare_mem_case1(void **state)
+{
+	uintn dst_offset;
+	uintn src_offset;
+	uintn length;
+	uintn index;
+	uint8 *buffer1;
+	uint8 *buffer2;
+
+	for (dst_offset = 0; dst_offset < sizeof(uintn); dst_offset++) {
+		for (src_offset = 0; src_offset < sizeof(uintn);
+		     src_offset++) {
+			buffer1 = m_test_buffer + dst_offset;
+			buffer2 = m_expected_buffer + src_offset;
+			for (length = 0; length <= TEST_MEMLIB_OPTIMIZED_BUFFER_SIZE;
+			     length++) {
+				internal_test_memlib_optimized_fill_pattern(buffer1,
+								  length, 0x5A);
+				internal_test_memlib_optimized_fill_pattern(buffer2,
+								  length, 0x5A);
+				assert_int_equal(
+					const_compare_mem(buffer1, buffer2,
+							  length),
+					0);
+				for (index = 0; index < length; index++) {
+					buffer2[index] ^= 0x80;
+					assert_int_not_equal(
+						const_compare_mem(buffer1,
+								  buffer2,
+								  length),
+						0);
+					buffer2[index] ^= 0x81;
+					assert_int_not_equal(
+						const_compare_mem(buffer1,
+								  buffer2,
+								  length),
+						0);
+					buffer2[index] ^= 0x01;
+				}
+			}
+		}
+	}
+}
+
+int main(void)
+{
+	const struct CMUnitTest test_memlib_optimized_tests[] = {
+		// Disjoint copy
+		cmocka_unit_test(test_memlib_optimized_copy_mem_case1),
+		// Overlapping copy, backward
+		cmocka_unit_test(test_memlib_optimized_copy_mem_case2),
+		// Overlapping copy, forward
+		cmocka_unit_test(test_memlib_optimized_copy_mem_case3),
+		// Same source and destination
+		cmocka_unit_test(test_memlib_optimized_copy_mem_case4),
+		// set_mem, zero_mem and zero_mem_secure
+		cmocka_unit_test(test_memlib_optimized_set_mem_case1),
+		// const_compare_mem
+		cmocka_unit_test(test_memlib_optimized_const_compare_mem_case1),
+	};
+
+	return cmocka_run_group_tests(test_memlib_optimized_tests, NULL, NULL);
+}
@@ -81,3 +81,106 @@ boolean aead_chacha20_poly1305_decrypt(
 	ASSERT(FALSE);
 	return FALSE;
 }
+
+/**
+  Allocates and initializes one AEAD ChaCha20Poly1305 context for subsequent use.
+
+  The key schedule is performed once here, and the context can be used for any number of
+  aead_chacha20_poly1305_encrypt_with_context() and aead_chacha20_poly1305_decrypt_with_context() calls
+  until it is released by aead_chacha20_poly1305_free().
+
+  key_size must be 32, otherwise NULL is returned.
+
+  @param[in]   key         Pointer to the encryption key.
+  @param[in]   key_size     size of the encryption key in bytes.
+
+  @return  Pointer to the AEAD ChaCha20Poly1305 context that has been initialized.
+           If the allocations fails, aead_chacha20_poly1305_new() returns NULL.
+
+**/
+void *aead_chacha20_poly1305_new(IN const uint8 *key, IN uintn key_size)
+{
+	ASSERT(FALSE);
+	return NULL;
+}
+
+/**
+  Release the specified AEAD ChaCha20Poly1305 context.
+
+  @param[in]  aead_chacha20_poly1305_ctx  Pointer to the AEAD ChaCha20Poly1305 context to be released.
+
+**/
+void aead_chacha20_poly1305_free(IN void *aead_chacha20_poly1305_ctx)
+{
+	ASSERT(FALSE);
+}
+
+/**
+  Performs AEAD ChaCha20Poly1305 authenticated encryption on a data buffer and additional authenticated data (AAD),
+  with a keyed AEAD ChaCha20Poly1305 context.
+
+  iv_size must be 12, otherwise FALSE is returned.
+  tag_size must be 16, otherwise FALSE is returned.
+
+  @param[in]   aead_chacha20_poly1305_ctx  Pointer to the AEAD ChaCha20Poly1305 context.
+  @param[in]   iv          Pointer to the IV value.
+  @param[in]   iv_size      size of the IV value in bytes.
+  @param[in]   a_data       Pointer to the additional authenticated data (AAD).
+  @param[in]   a_data_size   size of the additional authenticated data (AAD) in bytes.
+  @param[in]   data_in      Pointer to the input data buffer to be encrypted.
+  @param[in]   data_in_size  size of the input data buffer in bytes.
+  @param[out]  tag_out      Pointer to a buffer that receives the authentication tag output.
+  @param[in]   tag_size     size of the authentication tag in bytes.
+  @param[out]  data_out     Pointer to a buffer that receives the encryption output.
+  @param[out]  data_out_size size of the output data buffer in bytes.
+
+  @retval TRUE   AEAD ChaCha20Poly1305 authenticated encryption succeeded.
+  @retval FALSE  AEAD ChaCha20Poly1305 authenticated encryption failed.
+
+**/
+boolean aead_chacha20_poly1305_encrypt_with_context(
+	IN void *aead_chacha20_poly1305_ctx, IN const uint8 *iv, IN uintn iv_size,
+	IN const uint8 *a_data, IN uintn a_data_size, IN const uint8 *data_in,
+	IN uintn data_in_size, OUT uint8 *tag_out, IN uintn tag_size,
+	OUT uint8 *data_out, OUT uintn *data_out_size)
+{
+	copy_mem(data_out, data_in, data_in_size);
+	*data_out_size = data_in_size;
+	zero_mem(tag_out, tag_size);
+	return TRUE;
+}
+
+/**
+  Performs AEAD ChaCha20Poly1305 authenticated decryption on a data buffer and additional authenticated data (AAD),
+  with a keyed AEAD ChaCha20Poly1305 context.
+
+  iv_size must be 12, otherwise FALSE is returned.
+  tag_size must be 16, otherwise FALSE is returned.
+  If additional authenticated data verification fails, FALSE is returned.
+
+  @param[in]   aead_chacha20_poly1305_ctx  Pointer to the AEAD ChaCha20Poly1305 context.
+  @param[in]   iv          Pointer to the IV value.
+  @param[in]   iv_size      size of the IV value in bytes.
+  @param[in]   a_data       Pointer to the additional authenticated data (AAD).
+  @param[in]   a_data_size   size of the additional authenticated data (AAD) in bytes.
+  @param[in]   data_in      Pointer to the input data buffer to be decrypted.
+  @param[in]   data_in_size  size of the input data buffer in bytes.
+  @param[in]   tag         Pointer to a buffer that contains the authentication tag.
+  @param[in]   tag_size     size of the authentication tag in bytes.
+  @param[out]  data_out     Pointer to a buffer that receives the decryption output.
+  @param[out]  data_out_size size of the output data buffer in bytes.
+
+  @retval TRUE   AEAD ChaCha20Poly1305 authenticated decryption succeeded.
+  @retval FALSE  AEAD ChaCha20Poly1305 authenticated decryption failed.
+
+**/
+boolean aead_chacha20_poly1305_decrypt_with_context(
+	IN void *aead_chacha20_poly1305_ctx, IN const uint8 *iv, IN uintn iv_size,
+	IN const uint8 *a_data, IN uintn a_data_size, IN const uint8 *data_in,
+	IN uintn data_in_size, IN const uint8 *tag, IN uintn tag_size,
+	OUT uint8 *data_out, OUT uintn *data_out_size)
+{
+	copy_mem(data_out, data_in, data_in_size);
+	*data_out_size = data_in_size;
+	return TRUE;
+}
@@ -174,6 +174,273 @@ void test_spdm_crypt_spdm_x509_certificate_check(void **state)
 	free(file_buffer);
 }
 
+#if MAX_SPDM_CERT_CHAIN_VERIFY_CACHE_COUNT > 0
+void test_spdm_crypt_spdm_verify_cert_chain_data_cache(void **state)
+{
+	boolean status;
+	uint8 *file_buffer;
+	uintn file_buffer_size;
+	void *cache;
+
+	cache = malloc(spdm_get_cert_chain_verify_cache_size());
+	assert_non_null(cache);
+	spdm_flush_cert_chain_verify_cache(cache);
+	status = read_input_file("rsa2048/bundle_responder.certchain.der",
+				 (void **)&file_buffer, &file_buffer_size);
+	assert_true(status);
+	status = spdm_verify_cert_chain_data_with_cache(cache, file_buffer,
+							file_buffer_size);
+	assert_true(status);
+	// verified again from the cache
+	status = spdm_verify_cert_chain_data_with_cache(cache, file_buffer,
+							file_buffer_size);
+	assert_true(status);
+	// the leaf certificate is still verified against the cached chain
+	file_buffer[file_buffer_size - 1] ^= 0xFF;
+	status = spdm_verify_cert_chain_data_with_cache(cache, file_buffer,
+							file_buffer_size);
+	assert_false(status);
+	file_buffer[file_buffer_size - 1] ^= 0xFF;
+	spdm_flush_cert_chain_verify_cache(cache);
+	status = spdm_verify_cert_chain_data_with_cache(cache, file_buffer,
+							file_buffer_size);
+	assert_true(status);
+	// no cache
+	status = spdm_verify_cert_chain_data_with_cache(NULL, file_buffer,
+							file_buffer_size);
+	assert_true(status);
+	free(file_buffer);
+	free(cache);
+}
+
+void test_spdm_crypt_spdm_verify_cert_chain_data_cache_shared_root(void **state)
+{
+	boolean status;
+	uint8 *file_buffer;
+	uintn file_buffer_size;
+	uint8 *other_file_buffer;
+	uintn other_file_buffer_size;
+	void *cache;
+
+	// the requester and the responder chains share the root and the intermediate certificates
+	cache = malloc(spdm_get_cert_chain_verify_cache_size());
+	assert_non_null(cache);
+	spdm_flush_cert_chain_verify_cache(cache);
+	status = read_input_file("rsa2048/bundle_responder.certchain.der",
+				 (void **)&file_buffer, &file_buffer_size);
+	assert_true(status);
+	status = read_input_file("rsa2048/bundle_requester.certchain.der",
+				 (void **)&other_file_buffer,
+				 &other_file_buffer_size);
+	assert_true(status);
+	status = spdm_verify_cert_chain_data_with_cache(cache, file_buffer,
+							file_buffer_size);
+	assert_true(status);
+	// only the other leaf certificate is verified
+	status = spdm_verify_cert_chain_data_with_cache(
+		cache, other_file_buffer, other_file_buffer_size);
+	assert_true(status);
+	other_file_buffer[other_file_buffer_size - 1] ^= 0xFF;
+	status = spdm_verify_cert_chain_data_with_cache(
+		cache, other_file_buffer, other_file_buffer_size);
+	assert_false(status);
+	free(other_file_buffer);
+	free(file_buffer);
+	free(cache);
+}
+
+static char8 *m_current_date_time;
+static uintn m_current_date_time_call_count;
+
+boolean spdm_crypt_test_get_current_date_time(OUT char8 *date_time_str)
+{
+	m_current_date_time_call_count++;
+	copy_mem(date_time_str, m_current_date_time,
+		 SPDM_DATE_TIME_STRING_SIZE);
+	return TRUE;
+}
+
+void test_spdm_crypt_spdm_verify_cert_chain_data_cache_expired(void **state)
+{
+	boolean status;
+	uint8 *file_buffer;
+	uintn file_buffer_size;
+	void *cache;
+
+	// the leaf certificate is valid from 2020-10-10 to 2021-10-10
+	cache = malloc(spdm_get_cert_chain_verify_cache_size());
+	assert_non_null(cache);
+	spdm_flush_cert_chain_verify_cache(cache);
+	status = read_input_file("rsa2048/bundle_responder.certchain.der",
+				 (void **)&file_buffer, &file_buffer_size);
+	assert_true(status);
+	status = spdm_verify_cert_chain_data_with_cache(cache, file_buffer,
+							file_buffer_size);
+	assert_true(status);
+	// the leaf of the cached chain has expired once the platform time is known
+	m_current_date_time = "20260101000000Z";
+	m_current_date_time_call_count = 0;
+	spdm_register_current_date_time_func(
+		spdm_crypt_test_get_current_date_time);
+	status = spdm_verify_cert_chain_data_with_cache(cache, file_buffer,
+							file_buffer_size);
+	assert_false(status);
+	assert_int_equal(m_current_date_time_call_count, 1);
+	// not yet valid
+	m_current_date_time = "20200101000000Z";
+	status = spdm_verify_cert_chain_data_with_cache(cache, file_buffer,
+							file_buffer_size);
+	assert_false(status);
+	// valid: the time is checked on each use of the cache
+	m_current_date_time = "20210101000000Z";
+	m_current_date_time_call_count = 0;
+	status = spdm_verify_cert_chain_data_with_cache(cache, file_buffer,
+							file_buffer_size);
+	assert_true(status);
+	assert_int_equal(m_current_date_time_call_count, 1);
+	status = spdm_verify_cert_chain_data_with_cache(cache, file_buffer,
+							file_buffer_size);
+	assert_true(status);
+	assert_int_equal(m_current_date_time_call_count, 2);
+	m_current_date_time = "20211011000000Z";
+	status = spdm_verify_cert_chain_data_with_cache(cache, file_buffer,
+							file_buffer_size);
+	assert_false(status);
+	spdm_register_current_date_time_func(NULL);
+	free(file_buffer);
+	free(cache);
+}
+#endif
+
+void test_spdm_crypt_spdm_select_lru_cache_entry(void **state)
+{
+	struct {
+		uint32 data;
+		uint32 last_used;
+	} entry[3];
+
+	zero_mem(entry, sizeof(entry));
+	// the first empty entry
+	assert_int_equal(spdm_select_lru_cache_entry(&entry[0].last_used, 3,
+						     sizeof(entry[0])),
+			 0);
+	entry[0].last_used = 1;
+	entry[2].last_used = 2;
+	assert_int_equal(spdm_select_lru_cache_entry(&entry[0].last_used, 3,
+						     sizeof(entry[0])),
+			 1);
+	// the least recently used entry once the table is full
+	entry[1].last_used = 3;
+	assert_int_equal(spdm_select_lru_cache_entry(&entry[0].last_used, 3,
+						     sizeof(entry[0])),
+			 0);
+	entry[0].last_used = 4;
+	assert_int_equal(spdm_select_lru_cache_entry(&entry[0].last_used, 3,
+						     sizeof(entry[0])),
+			 2);
+}
+
+void test_spdm_crypt_spdm_hash_multi(void **state)
+{
+	boolean status;
+	uint8 data[256];
+	uint8 key[32];
+	uint8 hash_all_value[MAX_HASH_SIZE];
+	uint8 hash_multi_value[MAX_HASH_SIZE];
+	spdm_iovec_t iov[4];
+	uintn index;
+
+	for (index = 0; index < sizeof(data); index++) {
+		data[index] = (uint8)index;
+	}
+	set_mem(key, sizeof(key), 0x5A);
+
+	iov[0].data = data;
+	iov[0].data_size = 3;
+	iov[1].data = NULL;
+	iov[1].data_size = 0;
+	iov[2].data = data + 3;
+	iov[2].data_size = 125;
+	iov[3].data = data + 128;
+	iov[3].data_size = sizeof(data) - 128;
+
+	status = spdm_hash_all(SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_256,
+			       data, sizeof(data), hash_all_value);
+	assert_true(status);
+	status = spdm_hash_multi(SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_256,
+				 iov, ARRAY_SIZE(iov), hash_multi_value);
+	assert_true(status);
+	assert_memory_equal(hash_all_value, hash_multi_value,
+			    SHA256_DIGEST_SIZE);
+
+	status = spdm_hmac_all(SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_384,
+			       data, sizeof(data), key, sizeof(key),
+			       hash_all_value);
+	assert_true(status);
+	status = spdm_hmac_multi(SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_384,
+				 iov, ARRAY_SIZE(iov), key, sizeof(key),
+				 hash_multi_value);
+	assert_true(status);
+	assert_memory_equal(hash_all_value, hash_multi_value,
+			    SHA384_DIGEST_SIZE);
+}
+
+void test_spdm_crypt_spdm_hmac_with_key(void **state)
+{
+	boolean status;
+	uint8 data[64];
+	uint8 prk[SHA384_DIGEST_SIZE];
+	uint8 hmac_value[MAX_HASH_SIZE];
+	uint8 hmac_key_value[MAX_HASH_SIZE];
+	uint8 okm[SHA384_DIGEST_SIZE * 2 + 5];
+	uint8 okm_key[SHA384_DIGEST_SIZE * 2 + 5];
+	uintn okm_size[] = { 12, 32, SHA384_DIGEST_SIZE, sizeof(okm) };
+	void *hmac_key_context;
+	uintn index;
+
+	for (index = 0; index < sizeof(data); index++) {
+		data[index] = (uint8)index;
+	}
+	set_mem(prk, sizeof(prk), 0xA5);
+
+	hmac_key_context = spdm_hmac_new_with_key(
+		SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_384, prk,
+		sizeof(prk));
+	assert_non_null(hmac_key_context);
+
+	status = spdm_hmac_all(SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_384,
+			       data, sizeof(data), prk, sizeof(prk),
+			       hmac_value);
+	assert_true(status);
+	//
+	// The keyed context must stay usable after each HMAC.
+	//
+	for (index = 0; index < 2; index++) {
+		status = spdm_hmac_all_with_key(
+			SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_384,
+			hmac_key_context, data, sizeof(data), hmac_key_value);
+		assert_true(status);
+		assert_memory_equal(hmac_value, hmac_key_value,
+				    SHA384_DIGEST_SIZE);
+	}
+
+	for (index = 0; index < ARRAY_SIZE(okm_size); index++) {
+		status = spdm_hkdf_expand(
+			SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_384, prk,
+			sizeof(prk), data, sizeof(data), okm, okm_size[index]);
+		assert_true(status);
+		status = spdm_hkdf_expand_with_key(
+			SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_384,
+			hmac_key_context, data, sizeof(data), okm_key,
+			okm_size[index]);
+		assert_true(status);
+		assert_memory_equal(okm, okm_key, okm_size[index]);
+	}
+
+	spdm_hmac_free_with_key(SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_384,
+				hmac_key_context);
+}
+
 int spdm_crypt_lib_setup(void **state)
 {
 	return 0;
@@ -191,7 +458,18 @@ int spdm_crypt_lib_test_main(void)
 			test_spdm_crypt_spdm_get_dmtf_subject_alt_name_from_bytes),
 		cmocka_unit_test(
 			test_spdm_crypt_spdm_get_dmtf_subject_alt_name),
-		cmocka_unit_test(test_spdm_crypt_spdm_x509_certificate_check)
+		cmocka_unit_test(test_spdm_crypt_spdm_x509_certificate_check),
+#if MAX_SPDM_CERT_CHAIN_VERIFY_CACHE_COUNT > 0
+		cmocka_unit_test(
+			test_spdm_crypt_spdm_verify_cert_chain_data_cache),
+		cmocka_unit_test(
+			test_spdm_crypt_spdm_verify_cert_chain_data_cache_shared_root),
+		cmocka_unit_test(
+			test_spdm_crypt_spdm_verify_cert_chain_data_cache_expired),
+#endif
+		cmocka_unit_test(test_spdm_crypt_spdm_select_lru_cache_entry),
+		cmocka_unit_test(test_spdm_crypt_spdm_hash_multi),
+		cmocka_unit_test(test_spdm_crypt_spdm_hmac_with_key)
 	};
 
 	return cmocka_run_group_tests(spdm_crypt_lib_tests,
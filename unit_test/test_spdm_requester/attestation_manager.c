@@ -0,0 +1,508 @@
+/**
+    Copyright Notice:
+    Copyright 2021 DMTF. All rights reserved.
+    License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+**/
+
+#include "spdm_unit_test.h"
+#include <spdm_requester_lib_internal.h>
+
+#define ATTESTATION_TEST_DEVICE_COUNT 3
+
+//
+// Each device is a requester context talking to its own responder context
+// through an in-memory transport.
+//
+typedef struct {
+	void *requester_context;
+	void *responder_context;
+	uint8 request[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+	uintn request_size;
+	uint8 response[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+	uintn response_size;
+	uint8 last_request_code;
+	// Number of RETURN_TIMEOUT polls before each response is delivered
+	uintn poll_delay;
+	uintn poll_remaining;
+	// Request code whose send fails, or 0
+	uint8 fail_send_code;
+	// Request code whose receive fails with fail_receive_status, or 0
+	uint8 fail_receive_code;
+	return_status fail_receive_status;
+} spdm_attestation_test_device_io_t;
+
+static spdm_attestation_test_device_io_t
+	m_attestation_test_io[ATTESTATION_TEST_DEVICE_COUNT];
+static spdm_attestation_device_t
+	m_attestation_test_device[ATTESTATION_TEST_DEVICE_COUNT];
+static uint8 m_attestation_test_cert_chain[ATTESTATION_TEST_DEVICE_COUNT]
+					  [MAX_SPDM_CERT_CHAIN_SIZE];
+static uint8 m_attestation_test_measurement_record[MAX_SPDM_MEASUREMENT_RECORD_SIZE];
+
+//
+// Device index of each delivered response, in delivery order.
+//
+static uintn m_attestation_test_log[0x100];
+static uintn m_attestation_test_log_count;
+
+//
+// Set when a device is polled while another device has already finished.
+//
+static boolean m_attestation_test_polled_after_finish;
+
+static uint64 m_attestation_test_time;
+
+static void *m_attestation_test_responder_cert_chain;
+static uintn m_attestation_test_responder_cert_chain_size;
+static void *m_attestation_test_root_cert;
+
+/**
+  Return the device that owns an SPDM context.
+
+  @param  spdm_context                  A requester or responder SPDM context.
+
+  @return the index of the device.
+**/
+static uintn spdm_attestation_test_find_device(IN void *spdm_context)
+{
+	uintn index;
+
+	for (index = 0; index < ATTESTATION_TEST_DEVICE_COUNT; index++) {
+		if ((m_attestation_test_io[index].requester_context ==
+		     spdm_context) ||
+		    (m_attestation_test_io[index].responder_context ==
+		     spdm_context)) {
+			break;
+		}
+	}
+	assert_true(index < ATTESTATION_TEST_DEVICE_COUNT);
+	return index;
+}
+
+return_status spdm_attestation_test_requester_send_message(
+	IN void *spdm_context, IN uintn message_size, IN void *message,
+	IN uint64 timeout)
+{
+	spdm_attestation_test_device_io_t *io;
+
+	io = &m_attestation_test_io[spdm_attestation_test_find_device(
+		spdm_context)];
+	if (message_size > sizeof(io->request)) {
+		return RETURN_DEVICE_ERROR;
+	}
+	io->last_request_code = ((uint8 *)message)[sizeof(test_message_header_t) +
+						   1];
+	if (io->last_request_code == io->fail_send_code) {
+		return RETURN_DEVICE_ERROR;
+	}
+	copy_mem(io->request, message, message_size);
+	io->request_size = message_size;
+	io->response_size = 0;
+	io->poll_remaining = io->poll_delay;
+
+	return spdm_responder_dispatch_message(io->responder_context);
+}
+
+return_status spdm_attestation_test_requester_receive_message(
+	IN void *spdm_context, IN OUT uintn *message_size, IN OUT void *message,
+	IN uint64 timeout)
+{
+	spdm_attestation_test_device_io_t *io;
+	uintn device_index;
+	uintn index;
+
+	device_index = spdm_attestation_test_find_device(spdm_context);
+	io = &m_attestation_test_io[device_index];
+
+	//
+	// A polled device is still pending, and can see the others finish.
+	//
+	assert_int_equal(m_attestation_test_device[device_index].status,
+			 RETURN_NOT_READY);
+	for (index = 0; index < ATTESTATION_TEST_DEVICE_COUNT; index++) {
+		if (m_attestation_test_device[index].status !=
+		    RETURN_NOT_READY) {
+			m_attestation_test_polled_after_finish = TRUE;
+		}
+	}
+
+	if (io->poll_remaining != 0) {
+		io->poll_remaining--;
+		return RETURN_TIMEOUT;
+	}
+	if (io->last_request_code == io->fail_receive_code) {
+		return io->fail_receive_status;
+	}
+	if ((io->response_size == 0) || (*message_size < io->response_size)) {
+		return RETURN_DEVICE_ERROR;
+	}
+	copy_mem(message, io->response, io->response_size);
+	*message_size = io->response_size;
+	io->response_size = 0;
+
+	assert_true(m_attestation_test_log_count <
+		    ARRAY_SIZE(m_attestation_test_log));
+	m_attestation_test_log[m_attestation_test_log_count++] = device_index;
+	return RETURN_SUCCESS;
+}
+
+return_status spdm_attestation_test_responder_send_message(
+	IN void *spdm_context, IN uintn message_size, IN void *message,
+	IN uint64 timeout)
+{
+	spdm_attestation_test_device_io_t *io;
+
+	io = &m_attestation_test_io[spdm_attestation_test_find_device(
+		spdm_context)];
+	if (message_size > sizeof(io->response)) {
+		return RETURN_DEVICE_ERROR;
+	}
+	copy_mem(io->response, message, message_size);
+	io->response_size = message_size;
+	return RETURN_SUCCESS;
+}
+
+return_status spdm_attestation_test_responder_receive_message(
+	IN void *spdm_context, IN OUT uintn *message_size, IN OUT void *message,
+	IN uint64 timeout)
+{
+	spdm_attestation_test_device_io_t *io;
+
+	io = &m_attestation_test_io[spdm_attestation_test_find_device(
+		spdm_context)];
+	if ((io->request_size == 0) || (*message_size < io->request_size)) {
+		return RETURN_DEVICE_ERROR;
+	}
+	copy_mem(message, io->request, io->request_size);
+	*message_size = io->request_size;
+	io->request_size = 0;
+	return RETURN_SUCCESS;
+}
+
+uint64 spdm_attestation_test_get_time(void)
+{
+	return ++m_attestation_test_time;
+}
+
+/**
+  Create the requester and responder contexts of every device, and reset the test state.
+**/
+static void spdm_attestation_test_new_devices(void)
+{
+	spdm_attestation_test_device_io_t *io;
+	spdm_data_parameter_t parameter;
+	void *spdm_context;
+	uintn index;
+	uint8 data8;
+	uint32 data32;
+	uintn root_cert_size;
+	void *root_cert_hash;
+	uintn root_cert_hash_size;
+
+	assert_true(read_responder_public_certificate_chain(
+		m_use_hash_algo, m_use_asym_algo,
+		&m_attestation_test_responder_cert_chain,
+		&m_attestation_test_responder_cert_chain_size, NULL, NULL));
+	assert_true(read_responder_root_public_certificate(
+		m_use_hash_algo, m_use_asym_algo, &m_attestation_test_root_cert,
+		&root_cert_size, &root_cert_hash, &root_cert_hash_size));
+
+	zero_mem(m_attestation_test_io, sizeof(m_attestation_test_io));
+	zero_mem(m_attestation_test_device, sizeof(m_attestation_test_device));
+	m_attestation_test_log_count = 0;
+	m_attestation_test_polled_after_finish = FALSE;
+	m_attestation_test_time = 0;
+
+	for (index = 0; index < ATTESTATION_TEST_DEVICE_COUNT; index++) {
+		io = &m_attestation_test_io[index];
+
+		//
+		// Responder
+		//
+		spdm_context = malloc(spdm_get_context_size());
+		assert_non_null(spdm_context);
+		io->responder_context = spdm_context;
+		spdm_init_context(spdm_context);
+		spdm_register_arena_func(spdm_context, &m_spdm_unit_test_arena,
+					 spdm_unit_test_arena_allocate,
+					 spdm_unit_test_arena_free);
+		spdm_register_device_io_func(
+			spdm_context,
+			spdm_attestation_test_responder_send_message,
+			spdm_attestation_test_responder_receive_message);
+		spdm_register_transport_layer_func(
+			spdm_context, spdm_transport_test_encode_message,
+			spdm_transport_test_decode_message);
+
+		zero_mem(&parameter, sizeof(parameter));
+		parameter.location = SPDM_DATA_LOCATION_LOCAL;
+		data32 = SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP |
+			 SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CHAL_CAP |
+			 SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MEAS_CAP_SIG;
+		spdm_set_data(spdm_context, SPDM_DATA_CAPABILITY_FLAGS,
+			      &parameter, &data32, sizeof(data32));
+		data8 = m_use_measurement_spec;
+		spdm_set_data(spdm_context, SPDM_DATA_MEASUREMENT_SPEC,
+			      &parameter, &data8, sizeof(data8));
+		data32 = m_use_measurement_hash_algo;
+		spdm_set_data(spdm_context, SPDM_DATA_MEASUREMENT_HASH_ALGO,
+			      &parameter, &data32, sizeof(data32));
+		data32 = m_use_asym_algo;
+		spdm_set_data(spdm_context, SPDM_DATA_BASE_ASYM_ALGO,
+			      &parameter, &data32, sizeof(data32));
+		data32 = m_use_hash_algo;
+		spdm_set_data(spdm_context, SPDM_DATA_BASE_HASH_ALGO,
+			      &parameter, &data32, sizeof(data32));
+		data8 = 1;
+		spdm_set_data(spdm_context, SPDM_DATA_LOCAL_SLOT_COUNT,
+			      &parameter, &data8, sizeof(data8));
+		parameter.additional_data[0] = 0;
+		spdm_set_data(spdm_context, SPDM_DATA_LOCAL_PUBLIC_CERT_CHAIN,
+			      &parameter, m_attestation_test_responder_cert_chain,
+			      m_attestation_test_responder_cert_chain_size);
+
+		//
+		// Requester
+		//
+		spdm_context = malloc(spdm_get_context_size());
+		assert_non_null(spdm_context);
+		io->requester_context = spdm_context;
+		spdm_init_context(spdm_context);
+		spdm_register_arena_func(spdm_context, &m_spdm_unit_test_arena,
+					 spdm_unit_test_arena_allocate,
+					 spdm_unit_test_arena_free);
+		spdm_register_device_io_func(
+			spdm_context,
+			spdm_attestation_test_requester_send_message,
+			spdm_attestation_test_requester_receive_message);
+		spdm_register_transport_layer_func(
+			spdm_context, spdm_transport_test_encode_message,
+			spdm_transport_test_decode_message);
+
+		zero_mem(&parameter, sizeof(parameter));
+		parameter.location = SPDM_DATA_LOCATION_LOCAL;
+		data32 = 0;
+		spdm_set_data(spdm_context, SPDM_DATA_CAPABILITY_FLAGS,
+			      &parameter, &data32, sizeof(data32));
+		data8 = m_use_measurement_spec;
+		spdm_set_data(spdm_context, SPDM_DATA_MEASUREMENT_SPEC,
+			      &parameter, &data8, sizeof(data8));
+		data32 = m_use_asym_algo;
+		spdm_set_data(spdm_context, SPDM_DATA_BASE_ASYM_ALGO,
+			      &parameter, &data32, sizeof(data32));
+		data32 = m_use_hash_algo;
+		spdm_set_data(spdm_context, SPDM_DATA_BASE_HASH_ALGO,
+			      &parameter, &data32, sizeof(data32));
+		spdm_set_data(spdm_context,
+			      SPDM_DATA_PEER_PUBLIC_ROOT_CERT_HASH, &parameter,
+			      root_cert_hash, root_cert_hash_size);
+
+		m_attestation_test_device[index].spdm_context = spdm_context;
+		m_attestation_test_device[index].slot_id = 0;
+		m_attestation_test_device[index].measurement_hash_type =
+			SPDM_CHALLENGE_REQUEST_NO_MEASUREMENT_SUMMARY_HASH;
+		m_attestation_test_device[index].cert_chain_size =
+			sizeof(m_attestation_test_cert_chain[index]);
+		m_attestation_test_device[index].cert_chain =
+			m_attestation_test_cert_chain[index];
+	}
+}
+
+/**
+  Release the contexts of every device.
+**/
+static void spdm_attestation_test_free_devices(void)
+{
+	uintn index;
+
+	for (index = 0; index < ATTESTATION_TEST_DEVICE_COUNT; index++) {
+		spdm_deinit_context(m_attestation_test_io[index].requester_context);
+		spdm_deinit_context(m_attestation_test_io[index].responder_context);
+		free(m_attestation_test_io[index].requester_context);
+		free(m_attestation_test_io[index].responder_context);
+	}
+	free(m_attestation_test_responder_cert_chain);
+	free(m_attestation_test_root_cert);
+}
+
+/**
+  Return the position of the last response delivered to a device.
+
+  @param  device_index                  The index of the device.
+
+  @return the position in the delivery log.
+**/
+static uintn spdm_attestation_test_last_response(IN uintn device_index)
+{
+	uintn index;
+	uintn last;
+
+	last = 0;
+	for (index = 0; index < m_attestation_test_log_count; index++) {
+		if (m_attestation_test_log[index] == device_index) {
+			last = index;
+		}
+	}
+	return last;
+}
+
+/**
+  Test 1: attest three devices, the second one answering after a few polls, the third one with measurements
+  Expected Behavior: all devices reach SPDM_ATTESTATION_STAGE_DONE, the fast devices finish while
+  the slow one is still pending, and every stage is timed.
+**/
+void test_spdm_requester_attestation_manager_case1(void **state)
+{
+	return_status status;
+	uintn index;
+
+	spdm_attestation_test_new_devices();
+	m_attestation_test_io[1].poll_delay = 2;
+	m_attestation_test_device[2].measurement_attribute =
+		SPDM_GET_MEASUREMENTS_REQUEST_ATTRIBUTES_GENERATE_SIGNATURE;
+	m_attestation_test_device[2].measurement_record_length =
+		sizeof(m_attestation_test_measurement_record);
+	m_attestation_test_device[2].measurement_record =
+		m_attestation_test_measurement_record;
+
+	status = spdm_attest_devices(m_attestation_test_device,
+				     ATTESTATION_TEST_DEVICE_COUNT, 1,
+				     spdm_attestation_test_get_time);
+	assert_int_equal(status, RETURN_SUCCESS);
+
+	for (index = 0; index < ATTESTATION_TEST_DEVICE_COUNT; index++) {
+		assert_int_equal(m_attestation_test_device[index].stage,
+				 SPDM_ATTESTATION_STAGE_DONE);
+		assert_int_equal(m_attestation_test_device[index].status,
+				 RETURN_SUCCESS);
+		assert_int_equal(m_attestation_test_device[index].slot_mask,
+				 0x01);
+		assert_int_equal(m_attestation_test_device[index].cert_chain_size,
+				 m_attestation_test_responder_cert_chain_size);
+		assert_memory_equal(m_attestation_test_cert_chain[index],
+				    m_attestation_test_responder_cert_chain,
+				    m_attestation_test_responder_cert_chain_size);
+		assert_int_not_equal(
+			m_attestation_test_device[index]
+				.stage_time[SPDM_ATTESTATION_STAGE_INIT_CONNECTION],
+			0);
+		assert_int_not_equal(
+			m_attestation_test_device[index]
+				.stage_time[SPDM_ATTESTATION_STAGE_CHALLENGE],
+			0);
+		assert_int_not_equal(m_attestation_test_device[index].total_time,
+				     0);
+	}
+
+	//
+	// Only the third device asked for measurements.
+	//
+	assert_int_equal(
+		m_attestation_test_device[0]
+			.stage_time[SPDM_ATTESTATION_STAGE_GET_MEASUREMENT],
+		0);
+	assert_int_not_equal(m_attestation_test_device[2].number_of_blocks, 0);
+	assert_int_not_equal(
+		m_attestation_test_device[2].measurement_record_length, 0);
+
+	//
+	// The slow device did not hold back the others.
+	//
+	assert_true(spdm_attestation_test_last_response(0) <
+		    spdm_attestation_test_last_response(1));
+	assert_true(spdm_attestation_test_last_response(2) <
+		    spdm_attestation_test_last_response(1));
+	assert_true(m_attestation_test_polled_after_finish);
+
+	spdm_attestation_test_free_devices();
+}
+
+/**
+  Test 2: the first device fails to send GET_CERTIFICATE, the third one fails to receive CHALLENGE_AUTH
+  Expected Behavior: the failed devices report the stage and status of the failure, and the slow
+  second device is still attested.
+**/
+void test_spdm_requester_attestation_manager_case2(void **state)
+{
+	return_status status;
+
+	spdm_attestation_test_new_devices();
+	m_attestation_test_io[0].fail_send_code = SPDM_GET_CERTIFICATE;
+	m_attestation_test_io[1].poll_delay = 2;
+	m_attestation_test_io[2].fail_receive_code = SPDM_CHALLENGE;
+	m_attestation_test_io[2].fail_receive_status = RETURN_DEVICE_ERROR;
+
+	status = spdm_attest_devices(m_attestation_test_device,
+				     ATTESTATION_TEST_DEVICE_COUNT, 1, NULL);
+	assert_int_equal(status, RETURN_DEVICE_ERROR);
+
+	assert_int_equal(m_attestation_test_device[0].stage,
+			 SPDM_ATTESTATION_STAGE_GET_CERTIFICATE);
+	assert_int_equal(m_attestation_test_device[0].status,
+			 RETURN_DEVICE_ERROR);
+	assert_int_equal(m_attestation_test_device[1].stage,
+			 SPDM_ATTESTATION_STAGE_DONE);
+	assert_int_equal(m_attestation_test_device[1].status, RETURN_SUCCESS);
+	assert_int_equal(m_attestation_test_device[2].stage,
+			 SPDM_ATTESTATION_STAGE_CHALLENGE);
+	assert_int_equal(m_attestation_test_device[2].status,
+			 RETURN_DEVICE_ERROR);
+	assert_true(m_attestation_test_polled_after_finish);
+
+	spdm_attestation_test_free_devices();
+}
+
+/**
+  Test 3: a transport receive function returns RETURN_NOT_READY, the status that marks a pending device
+  Expected Behavior: the device ends with RETURN_DEVICE_ERROR instead of staying pending, the
+  other devices are attested, and a poll_timeout of 0 is rejected.
+**/
+void test_spdm_requester_attestation_manager_case3(void **state)
+{
+	return_status status;
+	uintn index;
+
+	spdm_attestation_test_new_devices();
+	m_attestation_test_io[1].fail_receive_code = SPDM_GET_DIGESTS;
+	m_attestation_test_io[1].fail_receive_status = RETURN_NOT_READY;
+
+	assert_int_equal(spdm_attest_devices(m_attestation_test_device,
+					     ATTESTATION_TEST_DEVICE_COUNT, 0,
+					     NULL),
+			 RETURN_INVALID_PARAMETER);
+
+	status = spdm_attest_devices(m_attestation_test_device,
+				     ATTESTATION_TEST_DEVICE_COUNT, 1, NULL);
+	assert_int_equal(status, RETURN_DEVICE_ERROR);
+
+	assert_int_equal(m_attestation_test_device[1].stage,
+			 SPDM_ATTESTATION_STAGE_GET_DIGEST);
+	assert_int_equal(m_attestation_test_device[1].status,
+			 RETURN_DEVICE_ERROR);
+	for (index = 0; index < ATTESTATION_TEST_DEVICE_COUNT; index++) {
+		if (index == 1) {
+			continue;
+		}
+		assert_int_equal(m_attestation_test_device[index].stage,
+				 SPDM_ATTESTATION_STAGE_DONE);
+		assert_int_equal(m_attestation_test_device[index].status,
+				 RETURN_SUCCESS);
+	}
+
+	spdm_attestation_test_free_devices();
+}
+
+int spdm_requester_attestation_manager_test_main(void)
+{
+	const struct CMUnitTest spdm_requester_attestation_manager_tests[] = {
+		// Three devices, one slow
+		cmocka_unit_test(test_spdm_requester_attestation_manager_case1),
+		// Failed devices do not stall the others
+		cmocka_unit_test(test_spdm_requester_attestation_manager_case2),
+		// RETURN_NOT_READY from the transport does not leave a device pending
+		cmocka_unit_test(test_spdm_requester_attestation_manager_case3),
+	};
+
+	return cmocka_run_group_tests(spdm_requester_attestation_manager_tests,
+				      NULL, NULL);
+}
@@ -24,6 +24,7 @@ return_status spdm_requester_challenge_test_send_message(IN void *spdm_context,
 	case 0x1:
 		return RETURN_DEVICE_ERROR;
 	case 0x2:
+	case 0x16:
 		m_local_buffer_size = 0;
 		copy_mem(m_local_buffer, &ptr[1], request_size - 1);
 		m_local_buffer_size += (request_size - 1);
@@ -99,7 +100,8 @@ return_status spdm_requester_challenge_test_receive_message(
 	case 0x1:
 		return RETURN_DEVICE_ERROR;
 
-	case 0x2: { //correct CHALLENGE_AUTH message
+	case 0x2:
+	case 0x16: { //correct CHALLENGE_AUTH message
 		spdm_challenge_auth_response_t *spdm_response;
 		void *data;
 		uintn data_size;
@@ -113,10 +115,10 @@ return_status spdm_requester_challenge_test_receive_message(
 							m_use_asym_algo, &data,
 							&data_size, NULL, NULL);
 		((spdm_context_t *)spdm_context)
-			->local_context.local_cert_chain_provision_size[0] =
+			->local_context->local_cert_chain_provision_size[0] =
 			data_size;
 		((spdm_context_t *)spdm_context)
-			->local_context.local_cert_chain_provision[0] = data;
+			->local_context->local_cert_chain_provision[0] = data;
 		((spdm_context_t *)spdm_context)
 			->connection_info.algorithm.base_asym_algo =
 			m_use_asym_algo;
@@ -138,10 +140,10 @@ return_status spdm_requester_challenge_test_receive_message(
 		spdm_hash_all(
 			m_use_hash_algo,
 			((spdm_context_t *)spdm_context)
-				->local_context.local_cert_chain_provision[0],
+				->local_context->local_cert_chain_provision[0],
 			((spdm_context_t *)spdm_context)
 				->local_context
-				.local_cert_chain_provision_size[0],
+				->local_cert_chain_provision_size[0],
 			ptr);
 		free(data);
 		ptr += spdm_get_hash_size(m_use_hash_algo);
@@ -189,10 +191,10 @@ return_status spdm_requester_challenge_test_receive_message(
 							m_use_asym_algo, &data,
 							&data_size, NULL, NULL);
 		((spdm_context_t *)spdm_context)
-			->local_context.local_cert_chain_provision_size[0] =
+			->local_context->local_cert_chain_provision_size[0] =
 			data_size;
 		((spdm_context_t *)spdm_context)
-			->local_context.local_cert_chain_provision[0] = data;
+			->local_context->local_cert_chain_provision[0] = data;
 		((spdm_context_t *)spdm_context)
 			->connection_info.algorithm.base_asym_algo =
 			m_use_asym_algo;
@@ -214,10 +216,10 @@ return_status spdm_requester_challenge_test_receive_message(
 		spdm_hash_all(
 			m_use_hash_algo,
 			((spdm_context_t *)spdm_context)
-				->local_context.local_cert_chain_provision[0],
+				->local_context->local_cert_chain_provision[0],
 			((spdm_context_t *)spdm_context)
 				->local_context
-				.local_cert_chain_provision_size[0],
+				->local_cert_chain_provision_size[0],
 			ptr);
 		free(data);
 		ptr += spdm_get_hash_size(m_use_hash_algo);
@@ -306,9 +308,9 @@ return_status spdm_requester_challenge_test_receive_message(
 				&data_size, NULL, NULL);
 			((spdm_context_t *)spdm_context)
 				->local_context
-				.local_cert_chain_provision_size[0] = data_size;
+				->local_cert_chain_provision_size[0] = data_size;
 			((spdm_context_t *)spdm_context)
-				->local_context.local_cert_chain_provision[0] =
+				->local_context->local_cert_chain_provision[0] =
 				data;
 			((spdm_context_t *)spdm_context)
 				->connection_info.algorithm.base_asym_algo =
@@ -334,10 +336,10 @@ return_status spdm_requester_challenge_test_receive_message(
 				m_use_hash_algo,
 				((spdm_context_t *)spdm_context)
 					->local_context
-					.local_cert_chain_provision[0],
+					->local_cert_chain_provision[0],
 				((spdm_context_t *)spdm_context)
 					->local_context
-					.local_cert_chain_provision_size[0],
+					->local_cert_chain_provision_size[0],
 				ptr);
 			free(data);
 			ptr += spdm_get_hash_size(m_use_hash_algo);
@@ -443,9 +445,9 @@ return_status spdm_requester_challenge_test_receive_message(
 				&data_size, NULL, NULL);
 			((spdm_context_t *)spdm_context)
 				->local_context
-				.local_cert_chain_provision_size[0] = data_size;
+				->local_cert_chain_provision_size[0] = data_size;
 			((spdm_context_t *)spdm_context)
-				->local_context.local_cert_chain_provision[0] =
+				->local_context->local_cert_chain_provision[0] =
 				data;
 			((spdm_context_t *)spdm_context)
 				->connection_info.algorithm.base_asym_algo =
@@ -471,10 +473,10 @@ return_status spdm_requester_challenge_test_receive_message(
 				m_use_hash_algo,
 				((spdm_context_t *)spdm_context)
 					->local_context
-					.local_cert_chain_provision[0],
+					->local_cert_chain_provision[0],
 				((spdm_context_t *)spdm_context)
 					->local_context
-					.local_cert_chain_provision_size[0],
+					->local_cert_chain_provision_size[0],
 				ptr);
 			free(data);
 			ptr += spdm_get_hash_size(m_use_hash_algo);
@@ -519,8 +521,8 @@ return_status spdm_requester_challenge_test_receive_message(
     uintn                         temp_buf_size;
 
     read_responder_public_certificate_chain (m_use_hash_algo, m_use_asym_algo, &data, &data_size, NULL, NULL);
-    ((spdm_context_t*)spdm_context)->local_context.local_cert_chain_provision_size[0] = data_size;
-    ((spdm_context_t*)spdm_context)->local_context.local_cert_chain_provision[0] = data;
+    ((spdm_context_t*)spdm_context)->local_context->local_cert_chain_provision_size[0] = data_size;
+    ((spdm_context_t*)spdm_context)->local_context->local_cert_chain_provision[0] = data;
     ((spdm_context_t*)spdm_context)->connection_info.algorithm.base_asym_algo = m_use_asym_algo;
     ((spdm_context_t*)spdm_context)->connection_info.algorithm.base_hash_algo = m_use_hash_algo;
     temp_buf_size = sizeof(spdm_challenge_auth_response_t) +
@@ -536,7 +538,7 @@ return_status spdm_requester_challenge_test_receive_message(
     spdm_response->header.param1 = 0;
     spdm_response->header.param2 = (1 << 0);
     Ptr = (void *)(spdm_response + 1);
-    spdm_hash_all (m_use_hash_algo, ((spdm_context_t*)spdm_context)->local_context.local_cert_chain_provision[0], ((spdm_context_t*)spdm_context)->local_context.local_cert_chain_provision_size[0], Ptr);
+    spdm_hash_all (m_use_hash_algo, ((spdm_context_t*)spdm_context)->local_context->local_cert_chain_provision[0], ((spdm_context_t*)spdm_context)->local_context->local_cert_chain_provision_size[0], Ptr);
     free(data);
     Ptr += spdm_get_hash_size (m_use_hash_algo);
     spdm_get_random_number (SPDM_NONCE_SIZE, Ptr);
@@ -585,8 +587,8 @@ return_status spdm_requester_challenge_test_receive_message(
     uintn                         temp_buf_size;
 
     read_responder_public_certificate_chain (m_use_hash_algo, m_use_asym_algo, &data, &data_size, NULL, NULL);
-    ((spdm_context_t*)spdm_context)->local_context.local_cert_chain_provision_size[0] = data_size;
-    ((spdm_context_t*)spdm_context)->local_context.local_cert_chain_provision[0] = data;
+    ((spdm_context_t*)spdm_context)->local_context->local_cert_chain_provision_size[0] = data_size;
+    ((spdm_context_t*)spdm_context)->local_context->local_cert_chain_provision[0] = data;
     ((spdm_context_t*)spdm_context)->connection_info.algorithm.base_asym_algo = m_use_asym_algo;
     ((spdm_context_t*)spdm_context)->connection_info.algorithm.base_hash_algo = m_use_hash_algo;
     temp_buf_size = sizeof(spdm_challenge_auth_response_t) +
@@ -602,7 +604,7 @@ return_status spdm_requester_challenge_test_receive_message(
     spdm_response->header.param1 = 0;
     spdm_response->header.param2 = (1 << 0);
     Ptr = (void *)(spdm_response + 1);
-    spdm_hash_all (m_use_hash_algo, ((spdm_context_t*)spdm_context)->local_context.local_cert_chain_provision[0], ((spdm_context_t*)spdm_context)->local_context.local_cert_chain_provision_size[0], Ptr);
+    spdm_hash_all (m_use_hash_algo, ((spdm_context_t*)spdm_context)->local_context->local_cert_chain_provision[0], ((spdm_context_t*)spdm_context)->local_context->local_cert_chain_provision_size[0], Ptr);
     free(data);
     Ptr += spdm_get_hash_size (m_use_hash_algo);
     spdm_get_random_number (SPDM_NONCE_SIZE, Ptr);
@@ -634,8 +636,8 @@ return_status spdm_requester_challenge_test_receive_message(
     uintn                         temp_buf_size;
 
     read_responder_public_certificate_chain (m_use_hash_algo, m_use_asym_algo, &data, &data_size, NULL, NULL);
-    ((spdm_context_t*)spdm_context)->local_context.local_cert_chain_provision_size[0] = data_size;
-    ((spdm_context_t*)spdm_context)->local_context.local_cert_chain_provision[0] = data;
+    ((spdm_context_t*)spdm_context)->local_context->local_cert_chain_provision_size[0] = data_size;
+    ((spdm_context_t*)spdm_context)->local_context->local_cert_chain_provision[0] = data;
     ((spdm_context_t*)spdm_context)->connection_info.algorithm.base_asym_algo = m_use_asym_algo;
     ((spdm_context_t*)spdm_context)->connection_info.algorithm.base_hash_algo = m_use_hash_algo;
     temp_buf_size = sizeof(spdm_challenge_auth_response_t) +
@@ -651,7 +653,7 @@ return_status spdm_requester_challenge_test_receive_message(
     spdm_response->header.param1 = 0;
     spdm_response->header.param2 = (1 << 0);
     Ptr = (void *)(spdm_response + 1);
-    spdm_hash_all (m_use_hash_algo, ((spdm_context_t*)spdm_context)->local_context.local_cert_chain_provision[0], ((spdm_context_t*)spdm_context)->local_context.local_cert_chain_provision_size[0], Ptr);
+    spdm_hash_all (m_use_hash_algo, ((spdm_context_t*)spdm_context)->local_context->local_cert_chain_provision[0], ((spdm_context_t*)spdm_context)->local_context->local_cert_chain_provision_size[0], Ptr);
     free(data);
     Ptr += spdm_get_hash_size (m_use_hash_algo);
     spdm_get_random_number (SPDM_NONCE_SIZE, Ptr);
@@ -683,8 +685,8 @@ return_status spdm_requester_challenge_test_receive_message(
     uintn                         temp_buf_size;
 
     read_responder_public_certificate_chain (m_use_hash_algo, m_use_asym_algo, &data, &data_size, NULL, NULL);
-    ((spdm_context_t*)spdm_context)->local_context.local_cert_chain_provision_size[0] = data_size;
-    ((spdm_context_t*)spdm_context)->local_context.local_cert_chain_provision[0] = data;
+    ((spdm_context_t*)spdm_context)->local_context->local_cert_chain_provision_size[0] = data_size;
+    ((spdm_context_t*)spdm_context)->local_context->local_cert_chain_provision[0] = data;
     ((spdm_context_t*)spdm_context)->connection_info.algorithm.base_asym_algo = m_use_asym_algo;
     ((spdm_context_t*)spdm_context)->connection_info.algorithm.base_hash_algo = m_use_hash_algo;
     temp_buf_size = sizeof(spdm_challenge_auth_response_t) +
@@ -700,7 +702,7 @@ return_status spdm_requester_challenge_test_receive_message(
     spdm_response->header.param1 = 1;
     spdm_response->header.param2 = (1 << 1); //wrong slot number
     Ptr = (void *)(spdm_response + 1);
-    spdm_hash_all (m_use_hash_algo, ((spdm_context_t*)spdm_context)->local_context.local_cert_chain_provision[0], ((spdm_context_t*)spdm_context)->local_context.local_cert_chain_provision_size[0], Ptr);
+    spdm_hash_all (m_use_hash_algo, ((spdm_context_t*)spdm_context)->local_context->local_cert_chain_provision[0], ((spdm_context_t*)spdm_context)->local_context->local_cert_chain_provision_size[0], Ptr);
     free(data);
     Ptr += spdm_get_hash_size (m_use_hash_algo);
     spdm_get_random_number (SPDM_NONCE_SIZE, Ptr);
@@ -732,8 +734,8 @@ return_status spdm_requester_challenge_test_receive_message(
     uintn                         temp_buf_size;
 
     read_responder_public_certificate_chain (m_use_hash_algo, m_use_asym_algo, &data, &data_size, NULL, NULL);
-    ((spdm_context_t*)spdm_context)->local_context.local_cert_chain_provision_size[0] = data_size;
-    ((spdm_context_t*)spdm_context)->local_context.local_cert_chain_provision[0] = data;
+    ((spdm_context_t*)spdm_context)->local_context->local_cert_chain_provision_size[0] = data_size;
+    ((spdm_context_t*)spdm_context)->local_context->local_cert_chain_provision[0] = data;
     ((spdm_context_t*)spdm_context)->connection_info.algorithm.base_asym_algo = m_use_asym_algo;
     ((spdm_context_t*)spdm_context)->connection_info.algorithm.base_hash_algo = m_use_hash_algo;
     temp_buf_size = sizeof(spdm_challenge_auth_response_t) +
@@ -749,7 +751,7 @@ return_status spdm_requester_challenge_test_receive_message(
     spdm_response->header.param1 = 8; //slot number overflow
     spdm_response->header.param2 = (1 << 0);
     Ptr = (void *)(spdm_response + 1);
-    spdm_hash_all (m_use_hash_algo, ((spdm_context_t*)spdm_context)->local_context.local_cert_chain_provision[0], ((spdm_context_t*)spdm_context)->local_context.local_cert_chain_provision_size[0], Ptr);
+    spdm_hash_all (m_use_hash_algo, ((spdm_context_t*)spdm_context)->local_context->local_cert_chain_provision[0], ((spdm_context_t*)spdm_context)->local_context->local_cert_chain_provision_size[0], Ptr);
     free(data);
     Ptr += spdm_get_hash_size (m_use_hash_algo);
     spdm_get_random_number (SPDM_NONCE_SIZE, Ptr);
@@ -781,8 +783,8 @@ return_status spdm_requester_challenge_test_receive_message(
     uintn                         temp_buf_size;
 
     read_responder_public_certificate_chain (m_use_hash_algo, m_use_asym_algo, &data, &data_size, NULL, NULL);
-    ((spdm_context_t*)spdm_context)->local_context.local_cert_chain_provision_size[0] = data_size;
-    ((spdm_context_t*)spdm_context)->local_context.local_cert_chain_provision[0] = data;
+    ((spdm_context_t*)spdm_context)->local_context->local_cert_chain_provision_size[0] = data_size;
+    ((spdm_context_t*)spdm_context)->local_context->local_cert_chain_provision[0] = data;
     ((spdm_context_t*)spdm_context)->connection_info.algorithm.base_asym_algo = m_use_asym_algo;
     ((spdm_context_t*)spdm_context)->connection_info.algorithm.base_hash_algo = m_use_hash_algo;
     temp_buf_size = sizeof(spdm_challenge_auth_response_t) +
@@ -798,7 +800,7 @@ return_status spdm_requester_challenge_test_receive_message(
     spdm_response->header.param1 = 0;
     spdm_response->header.param2 = (1 << 0);
     Ptr = (void *)(spdm_response + 1);
-    spdm_hash_all (m_use_hash_algo, ((spdm_context_t*)spdm_context)->local_context.local_cert_chain_provision[0], ((spdm_context_t*)spdm_context)->local_context.local_cert_chain_provision_size[0], Ptr);
+    spdm_hash_all (m_use_hash_algo, ((spdm_context_t*)spdm_context)->local_context->local_cert_chain_provision[0], ((spdm_context_t*)spdm_context)->local_context->local_cert_chain_provision_size[0], Ptr);
     free(data);
     Ptr += spdm_get_hash_size (m_use_hash_algo);
     spdm_get_random_number (SPDM_NONCE_SIZE, Ptr);
@@ -832,8 +834,8 @@ return_status spdm_requester_challenge_test_receive_message(
     uintn                         temp_buf_size;
 
     read_responder_public_certificate_chain (m_use_hash_algo, m_use_asym_algo, &data, &data_size, NULL, NULL);
-    ((spdm_context_t*)spdm_context)->local_context.local_cert_chain_provision_size[0] = data_size;
-    ((spdm_context_t*)spdm_context)->local_context.local_cert_chain_provision[0] = data;
+    ((spdm_context_t*)spdm_context)->local_context->local_cert_chain_provision_size[0] = data_size;
+    ((spdm_context_t*)spdm_context)->local_context->local_cert_chain_provision[0] = data;
     ((spdm_context_t*)spdm_context)->connection_info.algorithm.base_asym_algo = m_use_asym_algo;
     ((spdm_context_t*)spdm_context)->connection_info.algorithm.base_hash_algo = m_use_hash_algo;
     temp_buf_size = sizeof(spdm_challenge_auth_response_t) +
@@ -849,7 +851,7 @@ return_status spdm_requester_challenge_test_receive_message(
     spdm_response->header.param1 = 0;
     spdm_response->header.param2 = (1 << 0);
     Ptr = (void *)(spdm_response + 1);
-    spdm_hash_all (m_use_hash_algo, ((spdm_context_t*)spdm_context)->local_context.local_cert_chain_provision[0], ((spdm_context_t*)spdm_context)->local_context.local_cert_chain_provision_size[0], Ptr);
+    spdm_hash_all (m_use_hash_algo, ((spdm_context_t*)spdm_context)->local_context->local_cert_chain_provision[0], ((spdm_context_t*)spdm_context)->local_context->local_cert_chain_provision_size[0], Ptr);
     free(data);
     Ptr += spdm_get_hash_size (m_use_hash_algo);
     spdm_get_random_number (SPDM_NONCE_SIZE, Ptr);
@@ -883,8 +885,8 @@ return_status spdm_requester_challenge_test_receive_message(
     uintn                         temp_buf_size;
 
     read_responder_public_certificate_chain (m_use_hash_algo, m_use_asym_algo, &data, &data_size, NULL, NULL);
-    ((spdm_context_t*)spdm_context)->local_context.local_cert_chain_provision_size[0] = data_size;
-    ((spdm_context_t*)spdm_context)->local_context.local_cert_chain_provision[0] = data;
+    ((spdm_context_t*)spdm_context)->local_context->local_cert_chain_provision_size[0] = data_size;
+    ((spdm_context_t*)spdm_context)->local_context->local_cert_chain_provision[0] = data;
     ((spdm_context_t*)spdm_context)->connection_info.algorithm.base_asym_algo = m_use_asym_algo;
     ((spdm_context_t*)spdm_context)->connection_info.algorithm.base_hash_algo = m_use_hash_algo;
     temp_buf_size = sizeof(spdm_challenge_auth_response_t) +
@@ -899,7 +901,7 @@ return_status spdm_requester_challenge_test_receive_message(
     spdm_response->header.param1 = 0;
     spdm_response->header.param2 = (1 << 0);
     Ptr = (void *)(spdm_response + 1);
-    spdm_hash_all (m_use_hash_algo, ((spdm_context_t*)spdm_context)->local_context.local_cert_chain_provision[0], ((spdm_context_t*)spdm_context)->local_context.local_cert_chain_provision_size[0], Ptr);
+    spdm_hash_all (m_use_hash_algo, ((spdm_context_t*)spdm_context)->local_context->local_cert_chain_provision[0], ((spdm_context_t*)spdm_context)->local_context->local_cert_chain_provision_size[0], Ptr);
     free(data);
     Ptr += spdm_get_hash_size (m_use_hash_algo);
     spdm_get_random_number (SPDM_NONCE_SIZE, Ptr);
@@ -981,8 +983,13 @@ void test_spdm_requester_challenge_case1(void **state)
 						m_use_asym_algo, &data,
 						&data_size, &hash, &hash_size);
 	spdm_context->transcript.message_a.buffer_size = 0;
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	spdm_context->transcript.message_b.buffer_size = 0;
 	spdm_context->transcript.message_c.buffer_size = 0;
+#else
+	spdm_reset_message_b(spdm_context);
+	spdm_reset_message_c(spdm_context);
+#endif
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
 	spdm_context->connection_info.algorithm.base_asym_algo =
@@ -1001,7 +1008,9 @@ void test_spdm_requester_challenge_case1(void **state)
 		SPDM_CHALLENGE_REQUEST_NO_MEASUREMENT_SUMMARY_HASH,
 		measurement_hash);
 	assert_int_equal(status, RETURN_DEVICE_ERROR);
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	assert_int_equal(spdm_context->transcript.message_c.buffer_size, 0);
+#endif
 	free(data);
 }
 
@@ -1041,8 +1050,13 @@ void test_spdm_requester_challenge_case2(void **state)
 						m_use_asym_algo, &data,
 						&data_size, &hash, &hash_size);
 	spdm_context->transcript.message_a.buffer_size = 0;
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	spdm_context->transcript.message_b.buffer_size = 0;
 	spdm_context->transcript.message_c.buffer_size = 0;
+#else
+	spdm_reset_message_b(spdm_context);
+	spdm_reset_message_c(spdm_context);
+#endif
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
 	spdm_context->connection_info.algorithm.base_asym_algo =
@@ -1101,8 +1115,13 @@ void test_spdm_requester_challenge_case3(void **state)
 						m_use_asym_algo, &data,
 						&data_size, &hash, &hash_size);
 	spdm_context->transcript.message_a.buffer_size = 0;
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	spdm_context->transcript.message_b.buffer_size = 0;
 	spdm_context->transcript.message_c.buffer_size = 0;
+#else
+	spdm_reset_message_b(spdm_context);
+	spdm_reset_message_c(spdm_context);
+#endif
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
 	spdm_context->connection_info.algorithm.base_asym_algo =
@@ -1121,7 +1140,9 @@ void test_spdm_requester_challenge_case3(void **state)
 		SPDM_CHALLENGE_REQUEST_NO_MEASUREMENT_SUMMARY_HASH,
 		measurement_hash);
 	assert_int_equal(status, RETURN_UNSUPPORTED);
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	assert_int_equal(spdm_context->transcript.message_c.buffer_size, 0);
+#endif
 	free(data);
 }
 
@@ -1154,8 +1175,13 @@ void test_spdm_requester_challenge_case4(void **state)
 						m_use_asym_algo, &data,
 						&data_size, &hash, &hash_size);
 	spdm_context->transcript.message_a.buffer_size = 0;
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	spdm_context->transcript.message_b.buffer_size = 0;
 	spdm_context->transcript.message_c.buffer_size = 0;
+#else
+	spdm_reset_message_b(spdm_context);
+	spdm_reset_message_c(spdm_context);
+#endif
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
 	spdm_context->connection_info.algorithm.base_asym_algo =
@@ -1174,7 +1200,9 @@ void test_spdm_requester_challenge_case4(void **state)
 		SPDM_CHALLENGE_REQUEST_NO_MEASUREMENT_SUMMARY_HASH,
 		measurement_hash);
 	assert_int_equal(status, RETURN_DEVICE_ERROR);
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	assert_int_equal(spdm_context->transcript.message_c.buffer_size, 0);
+#endif
 	free(data);
 }
 
@@ -1207,8 +1235,13 @@ void test_spdm_requester_challenge_case5(void **state)
 						m_use_asym_algo, &data,
 						&data_size, &hash, &hash_size);
 	spdm_context->transcript.message_a.buffer_size = 0;
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	spdm_context->transcript.message_b.buffer_size = 0;
 	spdm_context->transcript.message_c.buffer_size = 0;
+#else
+	spdm_reset_message_b(spdm_context);
+	spdm_reset_message_c(spdm_context);
+#endif
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
 	spdm_context->connection_info.algorithm.base_asym_algo =
@@ -1227,7 +1260,9 @@ void test_spdm_requester_challenge_case5(void **state)
 		SPDM_CHALLENGE_REQUEST_NO_MEASUREMENT_SUMMARY_HASH,
 		measurement_hash);
 	assert_int_equal(status, RETURN_NO_RESPONSE);
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	assert_int_equal(spdm_context->transcript.message_c.buffer_size, 0);
+#endif
 	free(data);
 }
 
@@ -1260,8 +1295,13 @@ void test_spdm_requester_challenge_case6(void **state)
 						m_use_asym_algo, &data,
 						&data_size, &hash, &hash_size);
 	spdm_context->transcript.message_a.buffer_size = 0;
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	spdm_context->transcript.message_b.buffer_size = 0;
 	spdm_context->transcript.message_c.buffer_size = 0;
+#else
+	spdm_reset_message_b(spdm_context);
+	spdm_reset_message_c(spdm_context);
+#endif
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
 	spdm_context->connection_info.algorithm.base_asym_algo =
@@ -1313,8 +1353,13 @@ void test_spdm_requester_challenge_case7(void **state)
 						m_use_asym_algo, &data,
 						&data_size, &hash, &hash_size);
 	spdm_context->transcript.message_a.buffer_size = 0;
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	spdm_context->transcript.message_b.buffer_size = 0;
 	spdm_context->transcript.message_c.buffer_size = 0;
+#else
+	spdm_reset_message_b(spdm_context);
+	spdm_reset_message_c(spdm_context);
+#endif
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
 	spdm_context->connection_info.algorithm.base_asym_algo =
@@ -1335,7 +1380,9 @@ void test_spdm_requester_challenge_case7(void **state)
 	assert_int_equal(status, RETURN_DEVICE_ERROR);
 	assert_int_equal(spdm_context->connection_info.connection_state,
 			 SPDM_CONNECTION_STATE_NOT_STARTED);
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	assert_int_equal(spdm_context->transcript.message_c.buffer_size, 0);
+#endif
 	free(data);
 }
 
@@ -1368,8 +1415,13 @@ void test_spdm_requester_challenge_case8(void **state)
 						m_use_asym_algo, &data,
 						&data_size, &hash, &hash_size);
 	spdm_context->transcript.message_a.buffer_size = 0;
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	spdm_context->transcript.message_b.buffer_size = 0;
 	spdm_context->transcript.message_c.buffer_size = 0;
+#else
+	spdm_reset_message_b(spdm_context);
+	spdm_reset_message_c(spdm_context);
+#endif
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
 	spdm_context->connection_info.algorithm.base_asym_algo =
@@ -1388,7 +1440,9 @@ void test_spdm_requester_challenge_case8(void **state)
 		SPDM_CHALLENGE_REQUEST_NO_MEASUREMENT_SUMMARY_HASH,
 		measurement_hash);
 	assert_int_equal(status, RETURN_DEVICE_ERROR);
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	assert_int_equal (spdm_context->transcript.message_c.buffer_size, 0);
+#endif
 	free(data);
 }
 
@@ -1422,8 +1476,13 @@ void test_spdm_requester_challenge_case9(void **state)
 						m_use_asym_algo, &data,
 						&data_size, &hash, &hash_size);
 	spdm_context->transcript.message_a.buffer_size = 0;
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	spdm_context->transcript.message_b.buffer_size = 0;
 	spdm_context->transcript.message_c.buffer_size = 0;
+#else
+	spdm_reset_message_b(spdm_context);
+	spdm_reset_message_c(spdm_context);
+#endif
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
 	spdm_context->connection_info.algorithm.base_asym_algo =
@@ -1471,8 +1530,13 @@ void test_spdm_requester_challenge_case10(void **state) {
   // spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CHAL_CAP;
   read_responder_public_certificate_chain (m_use_hash_algo, m_use_asym_algo, &data, &data_size, &hash, &hash_size);
   spdm_context->transcript.message_a.buffer_size = 0;
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
   spdm_context->transcript.message_b.buffer_size = 0;
   spdm_context->transcript.message_c.buffer_size = 0;
+#else
+  spdm_reset_message_b(spdm_context);
+  spdm_reset_message_c(spdm_context);
+#endif
   spdm_context->connection_info.algorithm.base_hash_algo = m_use_hash_algo;
   spdm_context->connection_info.algorithm.base_asym_algo = m_use_asym_algo;
   spdm_context->connection_info.version.spdm_version_count = 1;
@@ -1484,7 +1548,9 @@ void test_spdm_requester_challenge_case10(void **state) {
   zero_mem (measurement_hash, sizeof(measurement_hash));
   status = spdm_challenge (spdm_context, 0, SPDM_CHALLENGE_REQUEST_NO_MEASUREMENT_SUMMARY_HASH, measurement_hash);
   assert_int_equal (status, RETURN_UNSUPPORTED);
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
   assert_int_equal (spdm_context->transcript.message_c.buffer_size, 0);
+#endif
   free(data);
 }
 
@@ -1511,8 +1577,13 @@ void test_spdm_requester_challenge_case11(void **state) {
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CHAL_CAP;
   read_responder_public_certificate_chain (m_use_hash_algo, m_use_asym_algo, &data, &data_size, &hash, &hash_size);
   spdm_context->transcript.message_a.buffer_size = 0;
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
   spdm_context->transcript.message_b.buffer_size = 0;
   spdm_context->transcript.message_c.buffer_size = 0;
+#else
+  spdm_reset_message_b(spdm_context);
+  spdm_reset_message_c(spdm_context);
+#endif
   spdm_context->connection_info.algorithm.base_hash_algo = m_use_hash_algo;
   spdm_context->connection_info.algorithm.base_asym_algo = m_use_asym_algo;
   spdm_context->connection_info.version.spdm_version_count = 1;
@@ -1551,8 +1622,13 @@ void test_spdm_requester_challenge_case12(void **state) {
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CHAL_CAP;
   read_responder_public_certificate_chain (m_use_hash_algo, m_use_asym_algo, &data, &data_size, &hash, &hash_size);
   spdm_context->transcript.message_a.buffer_size = 0;
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
   spdm_context->transcript.message_b.buffer_size = 0;
   spdm_context->transcript.message_c.buffer_size = 0;
+#else
+  spdm_reset_message_b(spdm_context);
+  spdm_reset_message_c(spdm_context);
+#endif
   spdm_context->connection_info.algorithm.base_hash_algo = m_use_hash_algo;
   spdm_context->connection_info.algorithm.base_asym_algo = m_use_asym_algo;
   spdm_context->connection_info.version.spdm_version_count = 1;
@@ -1592,8 +1668,13 @@ void test_spdm_requester_challenge_case13(void **state) {
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CHAL_CAP;
   read_responder_public_certificate_chain (m_use_hash_algo, m_use_asym_algo, &data, &data_size, &hash, &hash_size);
   spdm_context->transcript.message_a.buffer_size = 0;
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
   spdm_context->transcript.message_b.buffer_size = 0;
   spdm_context->transcript.message_c.buffer_size = 0;
+#else
+  spdm_reset_message_b(spdm_context);
+  spdm_reset_message_c(spdm_context);
+#endif
   spdm_context->connection_info.algorithm.base_hash_algo = m_use_hash_algo;
   spdm_context->connection_info.algorithm.base_asym_algo = m_use_asym_algo;
   spdm_context->connection_info.version.spdm_version_count = 1;
@@ -1632,8 +1713,13 @@ void test_spdm_requester_challenge_case14(void **state) {
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CHAL_CAP;
   read_responder_public_certificate_chain (m_use_hash_algo, m_use_asym_algo, &data, &data_size, &hash, &hash_size);
   spdm_context->transcript.message_a.buffer_size = 0;
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
   spdm_context->transcript.message_b.buffer_size = 0;
   spdm_context->transcript.message_c.buffer_size = 0;
+#else
+  spdm_reset_message_b(spdm_context);
+  spdm_reset_message_c(spdm_context);
+#endif
   spdm_context->connection_info.algorithm.base_hash_algo = m_use_hash_algo;
   spdm_context->connection_info.algorithm.base_asym_algo = m_use_asym_algo;
   spdm_context->connection_info.version.spdm_version_count = 1;
@@ -1673,8 +1759,13 @@ void test_spdm_requester_challenge_case15(void **state) {
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CHAL_CAP;
   read_responder_public_certificate_chain (m_use_hash_algo, m_use_asym_algo, &data, &data_size, &hash, &hash_size);
   spdm_context->transcript.message_a.buffer_size = 0;
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
   spdm_context->transcript.message_b.buffer_size = 0;
   spdm_context->transcript.message_c.buffer_size = 0;
+#else
+  spdm_reset_message_b(spdm_context);
+  spdm_reset_message_c(spdm_context);
+#endif
   spdm_context->connection_info.algorithm.base_hash_algo = m_use_hash_algo;
   spdm_context->connection_info.algorithm.base_asym_algo = m_use_asym_algo;
   spdm_context->connection_info.version.spdm_version_count = 1;
@@ -1720,8 +1811,13 @@ void test_spdm_requester_challenge_case16(void **state) {
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CHAL_CAP;
   read_responder_public_certificate_chain (m_use_hash_algo, m_use_asym_algo, &data, &data_size, &hash, &hash_size);
   spdm_context->transcript.message_a.buffer_size = 0;
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
   spdm_context->transcript.message_b.buffer_size = 0;
   spdm_context->transcript.message_c.buffer_size = 0;
+#else
+  spdm_reset_message_b(spdm_context);
+  spdm_reset_message_c(spdm_context);
+#endif
   spdm_context->connection_info.algorithm.base_hash_algo = m_use_hash_algo;
   spdm_context->connection_info.algorithm.base_asym_algo = m_use_asym_algo;
   spdm_context->connection_info.version.spdm_version_count = 1;
@@ -1767,8 +1863,13 @@ void test_spdm_requester_challenge_case17(void **state) {
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CHAL_CAP;
   read_responder_public_certificate_chain (m_use_hash_algo, m_use_asym_algo, &data, &data_size, &hash, &hash_size);
   spdm_context->transcript.message_a.buffer_size = 0;
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
   spdm_context->transcript.message_b.buffer_size = 0;
   spdm_context->transcript.message_c.buffer_size = 0;
+#else
+  spdm_reset_message_b(spdm_context);
+  spdm_reset_message_c(spdm_context);
+#endif
   spdm_context->connection_info.algorithm.base_hash_algo = m_use_hash_algo;
   spdm_context->connection_info.algorithm.base_asym_algo = m_use_asym_algo;
   spdm_context->connection_info.version.spdm_version_count = 1;
@@ -1815,8 +1916,13 @@ void test_spdm_requester_challenge_case18(void **state) {
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MEAS_CAP; //additional measurement capability
   read_responder_public_certificate_chain (m_use_hash_algo, m_use_asym_algo, &data, &data_size, &hash, &hash_size);
   spdm_context->transcript.message_a.buffer_size = 0;
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
   spdm_context->transcript.message_b.buffer_size = 0;
   spdm_context->transcript.message_c.buffer_size = 0;
+#else
+  spdm_reset_message_b(spdm_context);
+  spdm_reset_message_c(spdm_context);
+#endif
   spdm_context->connection_info.algorithm.base_hash_algo = m_use_hash_algo;
   spdm_context->connection_info.algorithm.base_asym_algo = m_use_asym_algo;
   spdm_context->connection_info.version.spdm_version_count = 1;
@@ -1862,8 +1968,13 @@ void test_spdm_requester_challenge_case19(void **state) {
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MEAS_CAP; //additional measurement capability
   read_responder_public_certificate_chain (m_use_hash_algo, m_use_asym_algo, &data, &data_size, &hash, &hash_size);
   spdm_context->transcript.message_a.buffer_size = 0;
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
   spdm_context->transcript.message_b.buffer_size = 0;
   spdm_context->transcript.message_c.buffer_size = 0;
+#else
+  spdm_reset_message_b(spdm_context);
+  spdm_reset_message_c(spdm_context);
+#endif
   spdm_context->connection_info.algorithm.base_hash_algo = m_use_hash_algo;
   spdm_context->connection_info.algorithm.base_asym_algo = m_use_asym_algo;
   spdm_context->connection_info.version.spdm_version_count = 1;
@@ -1914,15 +2025,24 @@ void test_spdm_requester_challenge_case20(void **state) {
   while(error_code <= 0xff) {
     spdm_context->connection_info.connection_state = SPDM_CONNECTION_STATE_NEGOTIATED;
     spdm_context->transcript.message_a.buffer_size = 0;
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
     spdm_context->transcript.message_b.buffer_size = 0;
     spdm_context->transcript.message_c.buffer_size = 0;
+#else
+    spdm_reset_message_b(spdm_context);
+    spdm_reset_message_c(spdm_context);
+#endif
 
     zero_mem (measurement_hash, sizeof(measurement_hash));
     status = spdm_challenge (spdm_context, 0, SPDM_CHALLENGE_REQUEST_NO_MEASUREMENT_SUMMARY_HASH, measurement_hash);
     // assert_int_equal (status, RETURN_DEVICE_ERROR);
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
     // assert_int_equal (spdm_context->transcript.message_c.buffer_size, 0);
+#endif
     ASSERT_INT_EQUAL_CASE (status, RETURN_DEVICE_ERROR, error_code);
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
     ASSERT_INT_EQUAL_CASE (spdm_context->transcript.message_c.buffer_size, 0, error_code);
+#endif
 
     error_code++;
     if(error_code == SPDM_ERROR_CODE_BUSY) { //busy is treated in cases 5 and 6
@@ -1939,6 +2059,186 @@ void test_spdm_requester_challenge_case20(void **state) {
   free(data);
 }
 
+/**
+  Test 21: reset message C (CHALLENGE retry) and append a new message C
+  Expected Behavior: M1/M2 hash is the hash of A, B and the new C, for both
+  the recorded transcript and the running hash transcript. The same applies to
+  the mutual authentication transcript, without A.
+**/
+void test_spdm_requester_challenge_case21(void **state)
+{
+	spdm_test_context_t *spdm_test_context;
+	spdm_context_t *spdm_context;
+	uint8 message_a[] = { 0x11, 0x84, 0x00, 0x00 };
+	uint8 message_b[] = { 0x11, 0x81, 0x00, 0x00, 0x11, 0x01, 0x00, 0x01 };
+	uint8 message_c1[] = { 0x11, 0x83, 0x00, 0x00, 0xc1 };
+	uint8 message_c2[] = { 0x11, 0x83, 0x00, 0x00, 0xc2, 0xc2 };
+	uint8 transcript[sizeof(message_a) + sizeof(message_b) +
+			 sizeof(message_c2)];
+	uint8 expected_hash[MAX_HASH_SIZE];
+	uint8 m1m2_hash[MAX_HASH_SIZE];
+	uintn hash_size;
+	return_status status;
+
+	spdm_test_context = *state;
+	spdm_context = spdm_test_context->spdm_context;
+	spdm_test_context->case_id = 0x15;
+	spdm_context->connection_info.algorithm.base_hash_algo =
+		m_use_hash_algo;
+	hash_size = spdm_get_hash_size(m_use_hash_algo);
+	spdm_reset_message_a(spdm_context);
+	spdm_reset_message_b(spdm_context);
+	spdm_reset_message_c(spdm_context);
+	spdm_reset_message_mut_b(spdm_context);
+	spdm_reset_message_mut_c(spdm_context);
+
+	status = spdm_append_message_a(spdm_context, message_a,
+				       sizeof(message_a));
+	assert_int_equal(status, RETURN_SUCCESS);
+	status = spdm_append_message_b(spdm_context, message_b,
+				       sizeof(message_b));
+	assert_int_equal(status, RETURN_SUCCESS);
+	status = spdm_append_message_c(spdm_context, message_c1,
+				       sizeof(message_c1));
+	assert_int_equal(status, RETURN_SUCCESS);
+	spdm_reset_message_c(spdm_context);
+
+	//
+	// B only: M1/M2 = Concatenate (A, B)
+	//
+	copy_mem(transcript, message_a, sizeof(message_a));
+	copy_mem(transcript + sizeof(message_a), message_b, sizeof(message_b));
+	spdm_hash_all(m_use_hash_algo, transcript,
+		      sizeof(message_a) + sizeof(message_b), expected_hash);
+	assert_true(spdm_calculate_m1m2_hash(spdm_context, FALSE, m1m2_hash));
+	assert_memory_equal(m1m2_hash, expected_hash, hash_size);
+
+	status = spdm_append_message_c(spdm_context, message_c2,
+				       sizeof(message_c2));
+	assert_int_equal(status, RETURN_SUCCESS);
+	copy_mem(transcript + sizeof(message_a) + sizeof(message_b), message_c2,
+		 sizeof(message_c2));
+	spdm_hash_all(m_use_hash_algo, transcript, sizeof(transcript),
+		      expected_hash);
+	assert_true(spdm_calculate_m1m2_hash(spdm_context, FALSE, m1m2_hash));
+	assert_memory_equal(m1m2_hash, expected_hash, hash_size);
+
+	//
+	// Mut M1/M2 = Concatenate (MutB, MutC)
+	//
+	status = spdm_append_message_mut_b(spdm_context, message_b,
+					   sizeof(message_b));
+	assert_int_equal(status, RETURN_SUCCESS);
+	status = spdm_append_message_mut_c(spdm_context, message_c1,
+					   sizeof(message_c1));
+	assert_int_equal(status, RETURN_SUCCESS);
+	spdm_reset_message_mut_c(spdm_context);
+	status = spdm_append_message_mut_c(spdm_context, message_c2,
+					   sizeof(message_c2));
+	assert_int_equal(status, RETURN_SUCCESS);
+	spdm_hash_all(m_use_hash_algo, transcript + sizeof(message_a),
+		      sizeof(message_b) + sizeof(message_c2), expected_hash);
+	assert_true(spdm_calculate_m1m2_hash(spdm_context, TRUE, m1m2_hash));
+	assert_memory_equal(m1m2_hash, expected_hash, hash_size);
+
+	spdm_reset_message_a(spdm_context);
+	spdm_reset_message_b(spdm_context);
+	spdm_reset_message_c(spdm_context);
+	spdm_reset_message_mut_b(spdm_context);
+	spdm_reset_message_mut_c(spdm_context);
+}
+
+/**
+  Test 22: two successful CHALLENGE exchanges with the same peer certificate chain
+  Expected Behavior: the peer public key is parsed once and reused by the second signature
+  verification. Invalidating the peer certificate chain frees the cached public key and
+  the cached peer certificate chain hash.
+**/
+void test_spdm_requester_challenge_case22(void **state)
+{
+	return_status status;
+	spdm_test_context_t *spdm_test_context;
+	spdm_context_t *spdm_context;
+	uint8 measurement_hash[MAX_HASH_SIZE];
+	void *data;
+	uintn data_size;
+	void *hash;
+	uintn hash_size;
+	void *public_key;
+	void *cert_chain_buffer;
+	uintn cert_chain_buffer_size;
+	uint8 cert_chain_hash[MAX_HASH_SIZE];
+
+	spdm_test_context = *state;
+	spdm_context = spdm_test_context->spdm_context;
+	spdm_test_context->case_id = 0x16;
+	spdm_context->connection_info.capability.flags = 0;
+	spdm_context->connection_info.capability.flags |=
+		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CHAL_CAP;
+	read_responder_public_certificate_chain(m_use_hash_algo,
+						m_use_asym_algo, &data,
+						&data_size, &hash, &hash_size);
+	spdm_context->connection_info.algorithm.base_hash_algo =
+		m_use_hash_algo;
+	spdm_context->connection_info.algorithm.base_asym_algo =
+		m_use_asym_algo;
+	spdm_context->connection_info.version.spdm_version_count = 1;
+	spdm_context->connection_info.version.spdm_version[0].major_version = 1;
+	spdm_context->connection_info.version.spdm_version[0].minor_version = 1;
+	spdm_context->connection_info.peer_used_cert_chain_buffer_size =
+		data_size;
+	copy_mem(spdm_context->connection_info.peer_used_cert_chain_buffer,
+		 data, data_size);
+	spdm_invalidate_peer_cert_chain_hash(spdm_context);
+
+	spdm_reset_message_a(spdm_context);
+	spdm_reset_message_b(spdm_context);
+	spdm_reset_message_c(spdm_context);
+	spdm_context->connection_info.connection_state =
+		SPDM_CONNECTION_STATE_NEGOTIATED;
+	zero_mem(measurement_hash, sizeof(measurement_hash));
+	status = spdm_challenge(
+		spdm_context, 0,
+		SPDM_CHALLENGE_REQUEST_NO_MEASUREMENT_SUMMARY_HASH,
+		measurement_hash);
+	assert_int_equal(status, RETURN_SUCCESS);
+	public_key =
+		spdm_context->connection_info.peer_public_key_cache.public_key;
+	assert_non_null(public_key);
+
+	spdm_reset_message_a(spdm_context);
+	spdm_reset_message_b(spdm_context);
+	spdm_reset_message_c(spdm_context);
+	spdm_context->connection_info.connection_state =
+		SPDM_CONNECTION_STATE_NEGOTIATED;
+	status = spdm_challenge(
+		spdm_context, 0,
+		SPDM_CHALLENGE_REQUEST_NO_MEASUREMENT_SUMMARY_HASH,
+		measurement_hash);
+	assert_int_equal(status, RETURN_SUCCESS);
+	assert_ptr_equal(
+		spdm_context->connection_info.peer_public_key_cache.public_key,
+		public_key);
+
+	assert_true(spdm_get_peer_cert_chain_buffer(spdm_context,
+						    &cert_chain_buffer,
+						    &cert_chain_buffer_size));
+	spdm_calculate_cert_chain_hash(spdm_context, cert_chain_buffer,
+				       cert_chain_buffer_size,
+				       cert_chain_hash);
+	assert_int_equal(spdm_context->connection_info
+				 .peer_cert_chain_hash_cache.base_hash_algo,
+			 m_use_hash_algo);
+
+	spdm_invalidate_peer_cert_chain_hash(spdm_context);
+	assert_null(
+		spdm_context->connection_info.peer_public_key_cache.public_key);
+	assert_int_equal(spdm_context->connection_info
+				 .peer_cert_chain_hash_cache.base_hash_algo,
+			 0);
+	free(data);
+}
+
 spdm_test_context_t m_spdm_requester_challenge_test_context = {
 	SPDM_TEST_CONTEXT_SIGNATURE,
 	TRUE,
@@ -1985,6 +2285,10 @@ int spdm_requester_challenge_test_main(void)
 		cmocka_unit_test(test_spdm_requester_challenge_case19),
 		// Unexpected errors
 		cmocka_unit_test(test_spdm_requester_challenge_case20),
+		// Message C reset keeps message B in M1/M2
+		cmocka_unit_test(test_spdm_requester_challenge_case21),
+		// Peer public key cache
+		cmocka_unit_test(test_spdm_requester_challenge_case22),
 	};
 
 	setup_spdm_test_context(&m_spdm_requester_challenge_test_context);
@@ -1306,11 +1306,11 @@ void test_spdm_requester_finish_case1(void **state)
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_ENCRYPT_CAP;
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MAC_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP;
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data,
@@ -1332,6 +1332,10 @@ void test_spdm_requester_finish_case1(void **state)
 	session_id = 0xFFFFFFFF;
 	session_info = &spdm_context->session_info[0];
 	spdm_session_info_init(spdm_context, session_info, session_id, FALSE);
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 0
+	// message_k is empty, only seed the TH hash context with (A, Ct).
+	spdm_append_message_k(spdm_context, session_info, TRUE, NULL, 0);
+#endif
 	hash_size = spdm_get_hash_size(m_use_hash_algo);
 	set_mem(m_dummy_buffer, hash_size, (uint8)(0xFF));
 	spdm_secured_message_set_response_finished_key(
@@ -1343,7 +1347,7 @@ void test_spdm_requester_finish_case1(void **state)
 
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_HANDSHAKE_IN_THE_CLEAR_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_HANDSHAKE_IN_THE_CLEAR_CAP;
 	req_slot_id_param = 0;
 	status = spdm_send_receive_finish(spdm_context, session_id,
@@ -1382,11 +1386,11 @@ void test_spdm_requester_finish_case2(void **state)
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_ENCRYPT_CAP;
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MAC_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP;
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data,
@@ -1408,6 +1412,10 @@ void test_spdm_requester_finish_case2(void **state)
 	session_id = 0xFFFFFFFF;
 	session_info = &spdm_context->session_info[0];
 	spdm_session_info_init(spdm_context, session_info, session_id, FALSE);
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 0
+	// message_k is empty, only seed the TH hash context with (A, Ct).
+	spdm_append_message_k(spdm_context, session_info, TRUE, NULL, 0);
+#endif
 	hash_size = spdm_get_hash_size(m_use_hash_algo);
 	set_mem(m_dummy_buffer, hash_size, (uint8)(0xFF));
 	spdm_secured_message_set_response_finished_key(
@@ -1419,8 +1427,12 @@ void test_spdm_requester_finish_case2(void **state)
 
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_HANDSHAKE_IN_THE_CLEAR_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_HANDSHAKE_IN_THE_CLEAR_CAP;
+#if MAX_SPDM_DHE_KEY_POOL_COUNT > 0
+	// KEY_EXCHANGE took a key pair from the DHE key pool.
+	spdm_context->dhe_key_pool_used_group = m_use_dhe_algo;
+#endif
 	req_slot_id_param = 0;
 	status = spdm_send_receive_finish(spdm_context, session_id,
 					  req_slot_id_param);
@@ -1429,6 +1441,13 @@ void test_spdm_requester_finish_case2(void **state)
 		spdm_secured_message_get_session_state(
 			spdm_context->session_info[0].secured_message_context),
 		SPDM_SESSION_STATE_ESTABLISHED);
+#if MAX_SPDM_DHE_KEY_POOL_COUNT > 0
+	assert_int_equal(spdm_context->dhe_key_pool_used_group, 0);
+	assert_non_null(spdm_get_dhe_key_pool(spdm_context, m_use_dhe_algo)
+				->entry[0]
+				.dhe_context);
+	spdm_free_dhe_key_pool(spdm_context);
+#endif
 	free(data);
 }
 
@@ -1461,11 +1480,11 @@ void test_spdm_requester_finish_case3(void **state)
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_ENCRYPT_CAP;
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MAC_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP;
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data,
@@ -1487,6 +1506,10 @@ void test_spdm_requester_finish_case3(void **state)
 	session_id = 0xFFFFFFFF;
 	session_info = &spdm_context->session_info[0];
 	spdm_session_info_init(spdm_context, session_info, session_id, FALSE);
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 0
+	// message_k is empty, only seed the TH hash context with (A, Ct).
+	spdm_append_message_k(spdm_context, session_info, TRUE, NULL, 0);
+#endif
 	hash_size = spdm_get_hash_size(m_use_hash_algo);
 	set_mem(m_dummy_buffer, hash_size, (uint8)(0xFF));
 	spdm_secured_message_set_response_finished_key(
@@ -1498,7 +1521,7 @@ void test_spdm_requester_finish_case3(void **state)
 
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_HANDSHAKE_IN_THE_CLEAR_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_HANDSHAKE_IN_THE_CLEAR_CAP;
 	req_slot_id_param = 0;
 	status = spdm_send_receive_finish(spdm_context, session_id,
@@ -1536,11 +1559,11 @@ void test_spdm_requester_finish_case4(void **state)
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_ENCRYPT_CAP;
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MAC_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP;
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data,
@@ -1562,6 +1585,10 @@ void test_spdm_requester_finish_case4(void **state)
 	session_id = 0xFFFFFFFF;
 	session_info = &spdm_context->session_info[0];
 	spdm_session_info_init(spdm_context, session_info, session_id, FALSE);
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 0
+	// message_k is empty, only seed the TH hash context with (A, Ct).
+	spdm_append_message_k(spdm_context, session_info, TRUE, NULL, 0);
+#endif
 	hash_size = spdm_get_hash_size(m_use_hash_algo);
 	set_mem(m_dummy_buffer, hash_size, (uint8)(0xFF));
 	spdm_secured_message_set_response_finished_key(
@@ -1573,7 +1600,7 @@ void test_spdm_requester_finish_case4(void **state)
 
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_HANDSHAKE_IN_THE_CLEAR_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_HANDSHAKE_IN_THE_CLEAR_CAP;
 	req_slot_id_param = 0;
 	status = spdm_send_receive_finish(spdm_context, session_id,
@@ -1611,11 +1638,11 @@ void test_spdm_requester_finish_case5(void **state)
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_ENCRYPT_CAP;
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MAC_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP;
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data,
@@ -1637,6 +1664,10 @@ void test_spdm_requester_finish_case5(void **state)
 	session_id = 0xFFFFFFFF;
 	session_info = &spdm_context->session_info[0];
 	spdm_session_info_init(spdm_context, session_info, session_id, FALSE);
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 0
+	// message_k is empty, only seed the TH hash context with (A, Ct).
+	spdm_append_message_k(spdm_context, session_info, TRUE, NULL, 0);
+#endif
 	hash_size = spdm_get_hash_size(m_use_hash_algo);
 	set_mem(m_dummy_buffer, hash_size, (uint8)(0xFF));
 	spdm_secured_message_set_response_finished_key(
@@ -1648,7 +1679,7 @@ void test_spdm_requester_finish_case5(void **state)
 
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_HANDSHAKE_IN_THE_CLEAR_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_HANDSHAKE_IN_THE_CLEAR_CAP;
 	req_slot_id_param = 0;
 	status = spdm_send_receive_finish(spdm_context, session_id,
@@ -1687,11 +1718,11 @@ void test_spdm_requester_finish_case6(void **state)
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_ENCRYPT_CAP;
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MAC_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP;
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data,
@@ -1713,6 +1744,10 @@ void test_spdm_requester_finish_case6(void **state)
 	session_id = 0xFFFFFFFF;
 	session_info = &spdm_context->session_info[0];
 	spdm_session_info_init(spdm_context, session_info, session_id, FALSE);
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 0
+	// message_k is empty, only seed the TH hash context with (A, Ct).
+	spdm_append_message_k(spdm_context, session_info, TRUE, NULL, 0);
+#endif
 	hash_size = spdm_get_hash_size(m_use_hash_algo);
 	set_mem(m_dummy_buffer, hash_size, (uint8)(0xFF));
 	spdm_secured_message_set_response_finished_key(
@@ -1724,7 +1759,7 @@ void test_spdm_requester_finish_case6(void **state)
 
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_HANDSHAKE_IN_THE_CLEAR_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_HANDSHAKE_IN_THE_CLEAR_CAP;
 	req_slot_id_param = 0;
 	status = spdm_send_receive_finish(spdm_context, session_id,
@@ -1767,11 +1802,11 @@ void test_spdm_requester_finish_case7(void **state)
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_ENCRYPT_CAP;
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MAC_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP;
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data,
@@ -1793,6 +1828,10 @@ void test_spdm_requester_finish_case7(void **state)
 	session_id = 0xFFFFFFFF;
 	session_info = &spdm_context->session_info[0];
 	spdm_session_info_init(spdm_context, session_info, session_id, FALSE);
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 0
+	// message_k is empty, only seed the TH hash context with (A, Ct).
+	spdm_append_message_k(spdm_context, session_info, TRUE, NULL, 0);
+#endif
 	hash_size = spdm_get_hash_size(m_use_hash_algo);
 	set_mem(m_dummy_buffer, hash_size, (uint8)(0xFF));
 	spdm_secured_message_set_response_finished_key(
@@ -1804,7 +1843,7 @@ void test_spdm_requester_finish_case7(void **state)
 
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_HANDSHAKE_IN_THE_CLEAR_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_HANDSHAKE_IN_THE_CLEAR_CAP;
 	req_slot_id_param = 0;
 	status = spdm_send_receive_finish(spdm_context, session_id,
@@ -1844,11 +1883,11 @@ void test_spdm_requester_finish_case8(void **state)
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_ENCRYPT_CAP;
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MAC_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP;
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data,
@@ -1870,6 +1909,10 @@ void test_spdm_requester_finish_case8(void **state)
 	session_id = 0xFFFFFFFF;
 	session_info = &spdm_context->session_info[0];
 	spdm_session_info_init(spdm_context, session_info, session_id, FALSE);
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 0
+	// message_k is empty, only seed the TH hash context with (A, Ct).
+	spdm_append_message_k(spdm_context, session_info, TRUE, NULL, 0);
+#endif
 	hash_size = spdm_get_hash_size(m_use_hash_algo);
 	set_mem(m_dummy_buffer, hash_size, (uint8)(0xFF));
 	spdm_secured_message_set_response_finished_key(
@@ -1881,7 +1924,7 @@ void test_spdm_requester_finish_case8(void **state)
 
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_HANDSHAKE_IN_THE_CLEAR_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_HANDSHAKE_IN_THE_CLEAR_CAP;
 	req_slot_id_param = 0;
 	status = spdm_send_receive_finish(spdm_context, session_id,
@@ -1920,11 +1963,11 @@ void test_spdm_requester_finish_case9(void **state)
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_ENCRYPT_CAP;
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MAC_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP;
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data,
@@ -1946,6 +1989,10 @@ void test_spdm_requester_finish_case9(void **state)
 	session_id = 0xFFFFFFFF;
 	session_info = &spdm_context->session_info[0];
 	spdm_session_info_init(spdm_context, session_info, session_id, FALSE);
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 0
+	// message_k is empty, only seed the TH hash context with (A, Ct).
+	spdm_append_message_k(spdm_context, session_info, TRUE, NULL, 0);
+#endif
 	hash_size = spdm_get_hash_size(m_use_hash_algo);
 	set_mem(m_dummy_buffer, hash_size, (uint8)(0xFF));
 	spdm_secured_message_set_response_finished_key(
@@ -1957,7 +2004,7 @@ void test_spdm_requester_finish_case9(void **state)
 
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_HANDSHAKE_IN_THE_CLEAR_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_HANDSHAKE_IN_THE_CLEAR_CAP;
 	req_slot_id_param = 0;
 	status = spdm_send_receive_finish(spdm_context, session_id,
@@ -1997,9 +2044,9 @@ void test_spdm_requester_finish_case10(void **state) {
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_KEY_EX_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_ENCRYPT_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MAC_CAP;
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP;
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP;
   read_responder_public_certificate_chain (m_use_hash_algo, m_use_asym_algo, &data, &data_size, &hash, &hash_size);
   spdm_context->connection_info.algorithm.base_hash_algo = m_use_hash_algo;
   spdm_context->connection_info.algorithm.base_asym_algo = m_use_asym_algo;
@@ -2010,7 +2057,7 @@ void test_spdm_requester_finish_case10(void **state) {
 
   session_id = 0xFFFFFFFF;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_HANDSHAKE_IN_THE_CLEAR_CAP;
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_HANDSHAKE_IN_THE_CLEAR_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_HANDSHAKE_IN_THE_CLEAR_CAP;
   req_slot_id_param = 0;
 
   error_code = SPDM_ERROR_CODE_RESERVED_00;
@@ -2020,6 +2067,10 @@ void test_spdm_requester_finish_case10(void **state) {
 
     session_info = &spdm_context->session_info[0];
     spdm_session_info_init (spdm_context, session_info, session_id, FALSE);
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 0
+    // message_k is empty, only seed the TH hash context with (A, Ct).
+    spdm_append_message_k(spdm_context, session_info, TRUE, NULL, 0);
+#endif
     hash_size = spdm_get_hash_size (m_use_hash_algo);
     set_mem (m_dummy_buffer, hash_size, (uint8)(0xFF));
     spdm_secured_message_set_response_finished_key (session_info->secured_message_context, m_dummy_buffer, hash_size);
@@ -2068,11 +2119,11 @@ void test_spdm_requester_finish_case11(void **state)
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_ENCRYPT_CAP;
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MAC_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP;
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data,
@@ -2094,6 +2145,10 @@ void test_spdm_requester_finish_case11(void **state)
 	session_id = 0xFFFFFFFF;
 	session_info = &spdm_context->session_info[0];
 	spdm_session_info_init(spdm_context, session_info, session_id, FALSE);
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 0
+	// message_k is empty, only seed the TH hash context with (A, Ct).
+	spdm_append_message_k(spdm_context, session_info, TRUE, NULL, 0);
+#endif
 	hash_size = spdm_get_hash_size(m_use_hash_algo);
 	set_mem(m_dummy_buffer, hash_size, (uint8)(0xFF));
 	spdm_secured_message_set_response_finished_key(
@@ -2105,11 +2160,12 @@ void test_spdm_requester_finish_case11(void **state)
 
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_HANDSHAKE_IN_THE_CLEAR_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_HANDSHAKE_IN_THE_CLEAR_CAP;
 	req_slot_id_param = 0;
 	spdm_context->transcript.message_m.buffer_size =
 		spdm_context->transcript.message_m.max_buffer_size;
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	spdm_context->transcript.message_b.buffer_size =
 							spdm_context->transcript.message_b.max_buffer_size;
 	spdm_context->transcript.message_c.buffer_size =
@@ -2118,6 +2174,7 @@ void test_spdm_requester_finish_case11(void **state)
 							spdm_context->transcript.message_mut_b.max_buffer_size;
 	spdm_context->transcript.message_mut_c.buffer_size =
 							spdm_context->transcript.message_mut_c.max_buffer_size;
+#endif
 
 	status = spdm_send_receive_finish(spdm_context, session_id,
 					  req_slot_id_param);
@@ -2128,10 +2185,12 @@ void test_spdm_requester_finish_case11(void **state)
 		SPDM_SESSION_STATE_ESTABLISHED);
 	assert_int_equal(spdm_context->transcript.message_m.buffer_size,
 					0);
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	assert_int_equal(spdm_context->transcript.message_b.buffer_size, 0);
 	assert_int_equal(spdm_context->transcript.message_c.buffer_size, 0);
 	assert_int_equal(spdm_context->transcript.message_mut_b.buffer_size, 0);
 	assert_int_equal(spdm_context->transcript.message_mut_c.buffer_size, 0);
+#endif
 	free(data);
 }
 
@@ -2166,11 +2225,11 @@ void test_spdm_requester_finish_case12(void **state)
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_ENCRYPT_CAP;
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MAC_CAP;
-	spdm_context->local_context.capability.flags = 0;
+	spdm_context->local_context->capability.flags = 0;
 	// no key exchange capabilities (requester)
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP;
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data,
@@ -2192,6 +2251,10 @@ void test_spdm_requester_finish_case12(void **state)
 	session_id = 0xFFFFFFFF;
 	session_info = &spdm_context->session_info[0];
 	spdm_session_info_init(spdm_context, session_info, session_id, FALSE);
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 0
+	// message_k is empty, only seed the TH hash context with (A, Ct).
+	spdm_append_message_k(spdm_context, session_info, TRUE, NULL, 0);
+#endif
 	hash_size = spdm_get_hash_size(m_use_hash_algo);
 	set_mem(m_dummy_buffer, hash_size, (uint8)(0xFF));
 	spdm_secured_message_set_response_finished_key(
@@ -2203,7 +2266,7 @@ void test_spdm_requester_finish_case12(void **state)
 
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_HANDSHAKE_IN_THE_CLEAR_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_HANDSHAKE_IN_THE_CLEAR_CAP;
 	req_slot_id_param = 0;
 	status = spdm_send_receive_finish(spdm_context, session_id,
@@ -2243,11 +2306,11 @@ void test_spdm_requester_finish_case13(void **state)
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_ENCRYPT_CAP;
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MAC_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP;
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data,
@@ -2269,6 +2332,10 @@ void test_spdm_requester_finish_case13(void **state)
 	session_id = 0xFFFFFFFF;
 	session_info = &spdm_context->session_info[0];
 	spdm_session_info_init(spdm_context, session_info, session_id, FALSE);
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 0
+	// message_k is empty, only seed the TH hash context with (A, Ct).
+	spdm_append_message_k(spdm_context, session_info, TRUE, NULL, 0);
+#endif
 	hash_size = spdm_get_hash_size(m_use_hash_algo);
 	set_mem(m_dummy_buffer, hash_size, (uint8)(0xFF));
 	spdm_secured_message_set_response_finished_key(
@@ -2280,7 +2347,7 @@ void test_spdm_requester_finish_case13(void **state)
 
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_HANDSHAKE_IN_THE_CLEAR_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_HANDSHAKE_IN_THE_CLEAR_CAP;
 	req_slot_id_param = 0;
 	status = spdm_send_receive_finish(spdm_context, session_id,
@@ -2318,11 +2385,11 @@ void test_spdm_requester_finish_case14(void **state)
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_ENCRYPT_CAP;
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MAC_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP;
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data,
@@ -2344,6 +2411,10 @@ void test_spdm_requester_finish_case14(void **state)
 	session_id = 0xFFFFFFFF;
 	session_info = &spdm_context->session_info[0];
 	spdm_session_info_init(spdm_context, session_info, session_id, FALSE);
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 0
+	// message_k is empty, only seed the TH hash context with (A, Ct).
+	spdm_append_message_k(spdm_context, session_info, TRUE, NULL, 0);
+#endif
 	hash_size = spdm_get_hash_size(m_use_hash_algo);
 	set_mem(m_dummy_buffer, hash_size, (uint8)(0xFF));
 	spdm_secured_message_set_response_finished_key(
@@ -2355,7 +2426,7 @@ void test_spdm_requester_finish_case14(void **state)
 
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_HANDSHAKE_IN_THE_CLEAR_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_HANDSHAKE_IN_THE_CLEAR_CAP;
 	req_slot_id_param = 0;
 	status = spdm_send_receive_finish(spdm_context, session_id,
@@ -2394,11 +2465,11 @@ void test_spdm_requester_finish_case15(void **state)
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_ENCRYPT_CAP;
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MAC_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP;
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data,
@@ -2420,6 +2491,10 @@ void test_spdm_requester_finish_case15(void **state)
 	session_id = 0xFFFFFFFF;
 	session_info = &spdm_context->session_info[0];
 	spdm_session_info_init(spdm_context, session_info, session_id, FALSE);
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 0
+	// message_k is empty, only seed the TH hash context with (A, Ct).
+	spdm_append_message_k(spdm_context, session_info, TRUE, NULL, 0);
+#endif
 	hash_size = spdm_get_hash_size(m_use_hash_algo);
 	set_mem(m_dummy_buffer, hash_size, (uint8)(0xFF));
 	spdm_secured_message_set_response_finished_key(
@@ -2431,7 +2506,7 @@ void test_spdm_requester_finish_case15(void **state)
 
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_HANDSHAKE_IN_THE_CLEAR_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_HANDSHAKE_IN_THE_CLEAR_CAP;
 	req_slot_id_param = 0;
 	status = spdm_send_receive_finish(spdm_context, session_id,
@@ -2470,11 +2545,11 @@ void test_spdm_requester_finish_case16(void **state)
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_ENCRYPT_CAP;
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MAC_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP;
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data,
@@ -2499,14 +2574,18 @@ void test_spdm_requester_finish_case16(void **state)
 	read_requester_public_certificate_chain(m_use_hash_algo,
 						m_use_req_asym_algo, &data,
 						&data_size, &hash, &hash_size);
-	spdm_context->local_context.
+	spdm_context->local_context->
 	      local_cert_chain_provision_size[req_slot_id_param] = data_size;
-	spdm_context->local_context.
+	spdm_context->local_context->
 	      local_cert_chain_provision[req_slot_id_param] = data;
 
 	session_id = 0xFFFFFFFF;
 	session_info = &spdm_context->session_info[0];
 	spdm_session_info_init(spdm_context, session_info, session_id, FALSE);
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 0
+	// message_k is empty, only seed the TH hash context with (A, Ct).
+	spdm_append_message_k(spdm_context, session_info, TRUE, NULL, 0);
+#endif
 	hash_size = spdm_get_hash_size(m_use_hash_algo);
 	set_mem(m_dummy_buffer, hash_size, (uint8)(0xFF));
 	spdm_secured_message_set_response_finished_key(
@@ -2519,9 +2598,9 @@ void test_spdm_requester_finish_case16(void **state)
 
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_HANDSHAKE_IN_THE_CLEAR_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_HANDSHAKE_IN_THE_CLEAR_CAP;
-	spdm_context->local_context.slot_count = 1;
+	spdm_context->local_context->slot_count = 1;
 	status = spdm_send_receive_finish(spdm_context, session_id,
 					  req_slot_id_param);
 	assert_int_equal(status, RETURN_SUCCESS);
@@ -2561,11 +2640,11 @@ void test_spdm_requester_finish_case17(void **state)
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_ENCRYPT_CAP;
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MAC_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP;
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data,
@@ -2590,14 +2669,18 @@ void test_spdm_requester_finish_case17(void **state)
 	read_requester_public_certificate_chain(m_use_hash_algo,
 						m_use_req_asym_algo, &data,
 						&data_size, &hash, &hash_size);
-	spdm_context->local_context.
+	spdm_context->local_context->
 	      local_cert_chain_provision_size[req_slot_id_param] = data_size;
-	spdm_context->local_context.
+	spdm_context->local_context->
 	      local_cert_chain_provision[req_slot_id_param] = data;
 
 	session_id = 0xFFFFFFFF;
 	session_info = &spdm_context->session_info[0];
 	spdm_session_info_init(spdm_context, session_info, session_id, FALSE);
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 0
+	// message_k is empty, only seed the TH hash context with (A, Ct).
+	spdm_append_message_k(spdm_context, session_info, TRUE, NULL, 0);
+#endif
 	hash_size = spdm_get_hash_size(m_use_hash_algo);
 	set_mem(m_dummy_buffer, hash_size, (uint8)(0xFF));
 	spdm_secured_message_set_response_finished_key(
@@ -2610,9 +2693,9 @@ void test_spdm_requester_finish_case17(void **state)
 
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_HANDSHAKE_IN_THE_CLEAR_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_HANDSHAKE_IN_THE_CLEAR_CAP;
-	spdm_context->local_context.slot_count = 1;
+	spdm_context->local_context->slot_count = 1;
 	status = spdm_send_receive_finish(spdm_context, session_id,
 					  req_slot_id_param);
 	assert_int_equal(status, RETURN_SECURITY_VIOLATION);
@@ -2648,11 +2731,11 @@ void test_spdm_requester_finish_case18(void **state)
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_ENCRYPT_CAP;
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MAC_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP;
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data,
@@ -2677,14 +2760,18 @@ void test_spdm_requester_finish_case18(void **state)
 	read_requester_public_certificate_chain(m_use_hash_algo,
 						m_use_req_asym_algo, &data,
 						&data_size, &hash, &hash_size);
-	spdm_context->local_context.
+	spdm_context->local_context->
 	      local_cert_chain_provision_size[req_slot_id_param] = data_size;
-	spdm_context->local_context.
+	spdm_context->local_context->
 	      local_cert_chain_provision[req_slot_id_param] = data;
 
 	session_id = 0xFFFFFFFF;
 	session_info = &spdm_context->session_info[0];
 	spdm_session_info_init(spdm_context, session_info, session_id, FALSE);
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 0
+	// message_k is empty, only seed the TH hash context with (A, Ct).
+	spdm_append_message_k(spdm_context, session_info, TRUE, NULL, 0);
+#endif
 	hash_size = spdm_get_hash_size(m_use_hash_algo);
 	set_mem(m_dummy_buffer, hash_size, (uint8)(0xFF));
 	spdm_secured_message_set_response_finished_key(
@@ -2697,9 +2784,9 @@ void test_spdm_requester_finish_case18(void **state)
 
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_HANDSHAKE_IN_THE_CLEAR_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_HANDSHAKE_IN_THE_CLEAR_CAP;
-	spdm_context->local_context.slot_count = 1;
+	spdm_context->local_context->slot_count = 1;
 	status = spdm_send_receive_finish(spdm_context, session_id,
 					  req_slot_id_param);
 	assert_int_equal(status, RETURN_SECURITY_VIOLATION);
@@ -2736,11 +2823,11 @@ void test_spdm_requester_finish_case19(void **state)
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_ENCRYPT_CAP;
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MAC_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP;
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data,
@@ -2765,14 +2852,18 @@ void test_spdm_requester_finish_case19(void **state)
 	read_requester_public_certificate_chain(m_use_hash_algo,
 						m_use_req_asym_algo, &data,
 						&data_size, &hash, &hash_size);
-	spdm_context->local_context.
+	spdm_context->local_context->
 	      local_cert_chain_provision_size[req_slot_id_param] = data_size;
-	spdm_context->local_context.
+	spdm_context->local_context->
 	      local_cert_chain_provision[req_slot_id_param] = data;
 
 	session_id = 0xFFFFFFFF;
 	session_info = &spdm_context->session_info[0];
 	spdm_session_info_init(spdm_context, session_info, session_id, FALSE);
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 0
+	// message_k is empty, only seed the TH hash context with (A, Ct).
+	spdm_append_message_k(spdm_context, session_info, TRUE, NULL, 0);
+#endif
 	hash_size = spdm_get_hash_size(m_use_hash_algo);
 	set_mem(m_dummy_buffer, hash_size, (uint8)(0xFF));
 	spdm_secured_message_set_response_finished_key(
@@ -2785,9 +2876,9 @@ void test_spdm_requester_finish_case19(void **state)
 
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_HANDSHAKE_IN_THE_CLEAR_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_HANDSHAKE_IN_THE_CLEAR_CAP;
-	spdm_context->local_context.slot_count = 1;
+	spdm_context->local_context->slot_count = 1;
 	status = spdm_send_receive_finish(spdm_context, session_id,
 					  req_slot_id_param);
 	assert_int_equal(status, RETURN_DEVICE_ERROR);
@@ -2824,11 +2915,11 @@ void test_spdm_requester_finish_case20(void **state)
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_ENCRYPT_CAP;
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MAC_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP;
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data,
@@ -2853,14 +2944,18 @@ void test_spdm_requester_finish_case20(void **state)
 	read_requester_public_certificate_chain(m_use_hash_algo,
 						m_use_req_asym_algo, &data,
 						&data_size, &hash, &hash_size);
-	spdm_context->local_context.
+	spdm_context->local_context->
 	      local_cert_chain_provision_size[req_slot_id_param] = data_size;
-	spdm_context->local_context.
+	spdm_context->local_context->
 	      local_cert_chain_provision[req_slot_id_param] = data;
 
 	session_id = 0xFFFFFFFF;
 	session_info = &spdm_context->session_info[0];
 	spdm_session_info_init(spdm_context, session_info, session_id, FALSE);
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 0
+	// message_k is empty, only seed the TH hash context with (A, Ct).
+	spdm_append_message_k(spdm_context, session_info, TRUE, NULL, 0);
+#endif
 	hash_size = spdm_get_hash_size(m_use_hash_algo);
 	set_mem(m_dummy_buffer, hash_size, (uint8)(0xFF));
 	spdm_secured_message_set_response_finished_key(
@@ -2873,9 +2968,9 @@ void test_spdm_requester_finish_case20(void **state)
 
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_HANDSHAKE_IN_THE_CLEAR_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_HANDSHAKE_IN_THE_CLEAR_CAP;
-	spdm_context->local_context.slot_count = 1;
+	spdm_context->local_context->slot_count = 1;
 	status = spdm_send_receive_finish(spdm_context, session_id,
 					  req_slot_id_param);
 	assert_int_equal(status, RETURN_DEVICE_ERROR);
@@ -755,8 +755,8 @@ void test_spdm_requester_get_capabilities_case1(void **state)
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AFTER_VERSION;
 
-	spdm_context->local_context.capability.ct_exponent = 0;
-	spdm_context->local_context.capability.flags = DEFAULT_CAPABILITY_FLAG;
+	spdm_context->local_context->capability.ct_exponent = 0;
+	spdm_context->local_context->capability.flags = DEFAULT_CAPABILITY_FLAG;
 	status = spdm_get_capabilities(spdm_context);
 	assert_int_equal(status, RETURN_DEVICE_ERROR);
 }
@@ -776,8 +776,8 @@ void test_spdm_requester_get_capabilities_case2(void **state)
 						spdm_context->transcript.message_m.max_buffer_size;
 
 
-	spdm_context->local_context.capability.ct_exponent = 0;
-	spdm_context->local_context.capability.flags = DEFAULT_CAPABILITY_FLAG;
+	spdm_context->local_context->capability.ct_exponent = 0;
+	spdm_context->local_context->capability.flags = DEFAULT_CAPABILITY_FLAG;
 	status = spdm_get_capabilities(spdm_context);
 	assert_int_equal(status, RETURN_SUCCESS);
 	assert_int_equal(spdm_context->connection_info.capability.ct_exponent,
@@ -799,8 +799,8 @@ void test_spdm_requester_get_capabilities_case3(void **state)
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_NOT_STARTED;
 
-	spdm_context->local_context.capability.ct_exponent = 0;
-	spdm_context->local_context.capability.flags = DEFAULT_CAPABILITY_FLAG;
+	spdm_context->local_context->capability.ct_exponent = 0;
+	spdm_context->local_context->capability.flags = DEFAULT_CAPABILITY_FLAG;
 	status = spdm_get_capabilities(spdm_context);
 	assert_int_equal(status, RETURN_UNSUPPORTED);
 }
@@ -817,8 +817,8 @@ void test_spdm_requester_get_capabilities_case4(void **state)
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AFTER_VERSION;
 
-	spdm_context->local_context.capability.ct_exponent = 0;
-	spdm_context->local_context.capability.flags = DEFAULT_CAPABILITY_FLAG;
+	spdm_context->local_context->capability.ct_exponent = 0;
+	spdm_context->local_context->capability.flags = DEFAULT_CAPABILITY_FLAG;
 	status = spdm_get_capabilities(spdm_context);
 	assert_int_equal(status, RETURN_DEVICE_ERROR);
 }
@@ -835,8 +835,8 @@ void test_spdm_requester_get_capabilities_case5(void **state)
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AFTER_VERSION;
 
-	spdm_context->local_context.capability.ct_exponent = 0;
-	spdm_context->local_context.capability.flags = DEFAULT_CAPABILITY_FLAG;
+	spdm_context->local_context->capability.ct_exponent = 0;
+	spdm_context->local_context->capability.flags = DEFAULT_CAPABILITY_FLAG;
 	status = spdm_get_capabilities(spdm_context);
 	assert_int_equal(status, RETURN_NO_RESPONSE);
 }
@@ -853,8 +853,8 @@ void test_spdm_requester_get_capabilities_case6(void **state)
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AFTER_VERSION;
 
-	spdm_context->local_context.capability.ct_exponent = 0;
-	spdm_context->local_context.capability.flags = DEFAULT_CAPABILITY_FLAG;
+	spdm_context->local_context->capability.ct_exponent = 0;
+	spdm_context->local_context->capability.flags = DEFAULT_CAPABILITY_FLAG;
 	status = spdm_get_capabilities(spdm_context);
 	assert_int_equal(status, RETURN_SUCCESS);
 	assert_int_equal(spdm_context->connection_info.capability.ct_exponent,
@@ -875,8 +875,8 @@ void test_spdm_requester_get_capabilities_case7(void **state)
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AFTER_VERSION;
 
-	spdm_context->local_context.capability.ct_exponent = 0;
-	spdm_context->local_context.capability.flags = DEFAULT_CAPABILITY_FLAG;
+	spdm_context->local_context->capability.ct_exponent = 0;
+	spdm_context->local_context->capability.flags = DEFAULT_CAPABILITY_FLAG;
 	status = spdm_get_capabilities(spdm_context);
 	assert_int_equal(status, RETURN_DEVICE_ERROR);
 	assert_int_equal(spdm_context->connection_info.connection_state,
@@ -895,8 +895,8 @@ void test_spdm_requester_get_capabilities_case8(void **state)
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AFTER_VERSION;
 
-	spdm_context->local_context.capability.ct_exponent = 0;
-	spdm_context->local_context.capability.flags = DEFAULT_CAPABILITY_FLAG;
+	spdm_context->local_context->capability.ct_exponent = 0;
+	spdm_context->local_context->capability.flags = DEFAULT_CAPABILITY_FLAG;
 	status = spdm_get_capabilities(spdm_context);
 	assert_int_equal(status, RETURN_DEVICE_ERROR);
 }
@@ -913,8 +913,8 @@ void test_spdm_requester_get_capabilities_case9(void **state)
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AFTER_VERSION;
 
-	spdm_context->local_context.capability.ct_exponent = 0;
-	spdm_context->local_context.capability.flags = DEFAULT_CAPABILITY_FLAG;
+	spdm_context->local_context->capability.ct_exponent = 0;
+	spdm_context->local_context->capability.flags = DEFAULT_CAPABILITY_FLAG;
 	status = spdm_get_capabilities(spdm_context);
 	assert_int_equal(status, RETURN_DEVICE_ERROR);
 	//  assert_int_equal (spdm_context->connection_info.capability.ct_exponent, 0);
@@ -933,8 +933,8 @@ void test_spdm_requester_get_capabilities_case10(void **state)
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AFTER_VERSION;
 
-	spdm_context->local_context.capability.ct_exponent = 0;
-	spdm_context->local_context.capability.flags = DEFAULT_CAPABILITY_FLAG;
+	spdm_context->local_context->capability.ct_exponent = 0;
+	spdm_context->local_context->capability.flags = DEFAULT_CAPABILITY_FLAG;
 	status = spdm_get_capabilities(spdm_context);
 	assert_int_equal(status, RETURN_SUCCESS);
 	assert_int_equal(spdm_context->connection_info.capability.ct_exponent,
@@ -959,8 +959,8 @@ void test_spdm_requester_get_capabilities_case11(void **state)
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AFTER_VERSION;
 
-	spdm_context->local_context.capability.ct_exponent = 0;
-	spdm_context->local_context.capability.flags = DEFAULT_CAPABILITY_FLAG;
+	spdm_context->local_context->capability.ct_exponent = 0;
+	spdm_context->local_context->capability.flags = DEFAULT_CAPABILITY_FLAG;
 	status = spdm_get_capabilities(spdm_context);
 	assert_int_equal(status, RETURN_SUCCESS);
 	assert_int_equal(spdm_context->connection_info.capability.ct_exponent,
@@ -986,8 +986,8 @@ void test_spdm_requester_get_capabilities_case12(void **state)
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AFTER_VERSION;
 
-	spdm_context->local_context.capability.ct_exponent = 0;
-	spdm_context->local_context.capability.flags = DEFAULT_CAPABILITY_FLAG;
+	spdm_context->local_context->capability.ct_exponent = 0;
+	spdm_context->local_context->capability.flags = DEFAULT_CAPABILITY_FLAG;
 	status = spdm_get_capabilities(spdm_context);
 	assert_int_equal(status, RETURN_SUCCESS);
 	assert_int_equal(spdm_context->connection_info.capability.ct_exponent,
@@ -1008,8 +1008,8 @@ void test_spdm_requester_get_capabilities_case13(void **state)
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AFTER_VERSION;
 
-	spdm_context->local_context.capability.ct_exponent = 0;
-	spdm_context->local_context.capability.flags = DEFAULT_CAPABILITY_FLAG;
+	spdm_context->local_context->capability.ct_exponent = 0;
+	spdm_context->local_context->capability.flags = DEFAULT_CAPABILITY_FLAG;
 	status = spdm_get_capabilities(spdm_context);
 	assert_int_equal(status, RETURN_DEVICE_ERROR);
 }
@@ -1026,8 +1026,8 @@ void test_spdm_requester_get_capabilities_case14(void **state)
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AFTER_VERSION;
 
-	spdm_context->local_context.capability.ct_exponent = 0;
-	spdm_context->local_context.capability.flags = DEFAULT_CAPABILITY_FLAG;
+	spdm_context->local_context->capability.ct_exponent = 0;
+	spdm_context->local_context->capability.flags = DEFAULT_CAPABILITY_FLAG;
 	status = spdm_get_capabilities(spdm_context);
 	assert_int_equal(status, RETURN_DEVICE_ERROR);
 }
@@ -1044,8 +1044,8 @@ void test_spdm_requester_get_capabilities_case15(void **state)
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AFTER_VERSION;
 
-	spdm_context->local_context.capability.ct_exponent = 0;
-	spdm_context->local_context.capability.flags = DEFAULT_CAPABILITY_FLAG;
+	spdm_context->local_context->capability.ct_exponent = 0;
+	spdm_context->local_context->capability.flags = DEFAULT_CAPABILITY_FLAG;
 	status = spdm_get_capabilities(spdm_context);
 	assert_int_equal(status, RETURN_DEVICE_ERROR);
 }
@@ -1065,8 +1065,8 @@ void test_spdm_requester_get_capabilities_case16(void **state)
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AFTER_VERSION;
 
-	spdm_context->local_context.capability.ct_exponent = 0;
-	spdm_context->local_context.capability.flags =
+	spdm_context->local_context->capability.ct_exponent = 0;
+	spdm_context->local_context->capability.flags =
 		DEFAULT_CAPABILITY_FLAG_VERSION_11;
 	status = spdm_get_capabilities(spdm_context);
 	assert_int_equal(status, RETURN_SUCCESS);
@@ -1091,8 +1091,8 @@ void test_spdm_requester_get_capabilities_case17(void **state)
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AFTER_VERSION;
 
-	spdm_context->local_context.capability.ct_exponent = 0;
-	spdm_context->local_context.capability.flags =
+	spdm_context->local_context->capability.ct_exponent = 0;
+	spdm_context->local_context->capability.flags =
 		DEFAULT_CAPABILITY_FLAG_VERSION_11;
 	status = spdm_get_capabilities(spdm_context);
 	assert_int_equal(status, RETURN_DEVICE_ERROR);
@@ -1115,8 +1115,8 @@ void test_spdm_requester_get_capabilities_case18(void **state)
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AFTER_VERSION;
 
-	spdm_context->local_context.capability.ct_exponent = 0;
-	spdm_context->local_context.capability.flags =
+	spdm_context->local_context->capability.ct_exponent = 0;
+	spdm_context->local_context->capability.flags =
 		DEFAULT_CAPABILITY_FLAG_VERSION_11;
 	status = spdm_get_capabilities(spdm_context);
 	assert_int_equal(status, RETURN_DEVICE_ERROR);
@@ -1140,8 +1140,8 @@ void test_spdm_requester_get_capabilities_case19(void **state)
 		SPDM_CONNECTION_STATE_AFTER_VERSION;
 	reset_managed_buffer(&spdm_context->transcript.message_a);
 
-	spdm_context->local_context.capability.ct_exponent = 0;
-	spdm_context->local_context.capability.flags =
+	spdm_context->local_context->capability.ct_exponent = 0;
+	spdm_context->local_context->capability.flags =
 		DEFAULT_CAPABILITY_FLAG_VERSION_11;
 	status = spdm_get_capabilities(spdm_context);
 	assert_int_equal(status, RETURN_DEVICE_ERROR);
@@ -1165,8 +1165,8 @@ void test_spdm_requester_get_capabilities_case20(void **state)
 		SPDM_CONNECTION_STATE_AFTER_VERSION;
 	reset_managed_buffer(&spdm_context->transcript.message_a);
 
-	spdm_context->local_context.capability.ct_exponent = 0;
-	spdm_context->local_context.capability.flags =
+	spdm_context->local_context->capability.ct_exponent = 0;
+	spdm_context->local_context->capability.flags =
 		DEFAULT_CAPABILITY_FLAG_VERSION_11;
 	status = spdm_get_capabilities(spdm_context);
 	assert_int_equal(status, RETURN_DEVICE_ERROR);
@@ -1190,8 +1190,8 @@ void test_spdm_requester_get_capabilities_case21(void **state)
 		SPDM_CONNECTION_STATE_AFTER_VERSION;
 	reset_managed_buffer(&spdm_context->transcript.message_a);
 
-	spdm_context->local_context.capability.ct_exponent = 0;
-	spdm_context->local_context.capability.flags =
+	spdm_context->local_context->capability.ct_exponent = 0;
+	spdm_context->local_context->capability.flags =
 		DEFAULT_CAPABILITY_FLAG_VERSION_11;
 	status = spdm_get_capabilities(spdm_context);
 	assert_int_equal(status, RETURN_DEVICE_ERROR);
@@ -1215,8 +1215,8 @@ void test_spdm_requester_get_capabilities_case22(void **state)
 		SPDM_CONNECTION_STATE_AFTER_VERSION;
 	reset_managed_buffer(&spdm_context->transcript.message_a);
 
-	spdm_context->local_context.capability.ct_exponent = 0;
-	spdm_context->local_context.capability.flags =
+	spdm_context->local_context->capability.ct_exponent = 0;
+	spdm_context->local_context->capability.flags =
 		DEFAULT_CAPABILITY_FLAG_VERSION_11;
 	status = spdm_get_capabilities(spdm_context);
 	assert_int_equal(status, RETURN_DEVICE_ERROR);
@@ -1240,8 +1240,8 @@ void test_spdm_requester_get_capabilities_case23(void **state)
 		SPDM_CONNECTION_STATE_AFTER_VERSION;
 	reset_managed_buffer(&spdm_context->transcript.message_a);
 
-	spdm_context->local_context.capability.ct_exponent = 0;
-	spdm_context->local_context.capability.flags =
+	spdm_context->local_context->capability.ct_exponent = 0;
+	spdm_context->local_context->capability.flags =
 		DEFAULT_CAPABILITY_FLAG_VERSION_11;
 	status = spdm_get_capabilities(spdm_context);
 	assert_int_equal(status, RETURN_DEVICE_ERROR);
@@ -1265,8 +1265,8 @@ void test_spdm_requester_get_capabilities_case24(void **state)
 		SPDM_CONNECTION_STATE_AFTER_VERSION;
 	reset_managed_buffer(&spdm_context->transcript.message_a);
 
-	spdm_context->local_context.capability.ct_exponent = 0;
-	spdm_context->local_context.capability.flags =
+	spdm_context->local_context->capability.ct_exponent = 0;
+	spdm_context->local_context->capability.flags =
 		DEFAULT_CAPABILITY_FLAG_VERSION_11;
 	status = spdm_get_capabilities(spdm_context);
 	assert_int_equal(status, RETURN_DEVICE_ERROR);
@@ -1290,8 +1290,8 @@ void test_spdm_requester_get_capabilities_case25(void **state)
 		SPDM_CONNECTION_STATE_AFTER_VERSION;
 	reset_managed_buffer(&spdm_context->transcript.message_a);
 
-	spdm_context->local_context.capability.ct_exponent = 0;
-	spdm_context->local_context.capability.flags =
+	spdm_context->local_context->capability.ct_exponent = 0;
+	spdm_context->local_context->capability.flags =
 		DEFAULT_CAPABILITY_FLAG_VERSION_11;
 	status = spdm_get_capabilities(spdm_context);
 	assert_int_equal(status, RETURN_DEVICE_ERROR);
@@ -1315,8 +1315,8 @@ void test_spdm_requester_get_capabilities_case26(void **state)
 		SPDM_CONNECTION_STATE_AFTER_VERSION;
 	reset_managed_buffer(&spdm_context->transcript.message_a);
 
-	spdm_context->local_context.capability.ct_exponent = 0;
-	spdm_context->local_context.capability.flags =
+	spdm_context->local_context->capability.ct_exponent = 0;
+	spdm_context->local_context->capability.flags =
 		DEFAULT_CAPABILITY_FLAG_VERSION_11;
 	status = spdm_get_capabilities(spdm_context);
 	assert_int_equal(status, RETURN_DEVICE_ERROR);
@@ -1340,8 +1340,8 @@ void test_spdm_requester_get_capabilities_case27(void **state)
 		SPDM_CONNECTION_STATE_AFTER_VERSION;
 	reset_managed_buffer(&spdm_context->transcript.message_a);
 
-	spdm_context->local_context.capability.ct_exponent = 0;
-	spdm_context->local_context.capability.flags =
+	spdm_context->local_context->capability.ct_exponent = 0;
+	spdm_context->local_context->capability.flags =
 		DEFAULT_CAPABILITY_FLAG_VERSION_11;
 	status = spdm_get_capabilities(spdm_context);
 	assert_int_equal(status, RETURN_DEVICE_ERROR);
@@ -1363,8 +1363,8 @@ void test_spdm_requester_get_capabilities_case28(void **state)
 		SPDM_CONNECTION_STATE_AFTER_VERSION;
 	reset_managed_buffer(&spdm_context->transcript.message_a);
 
-	spdm_context->local_context.capability.ct_exponent = 0;
-	spdm_context->local_context.capability.flags =
+	spdm_context->local_context->capability.ct_exponent = 0;
+	spdm_context->local_context->capability.flags =
 		DEFAULT_CAPABILITY_FLAG_VERSION_11;
 	status = spdm_get_capabilities(spdm_context);
 	assert_int_equal(status, RETURN_DEVICE_ERROR);
@@ -1382,8 +1382,8 @@ void test_spdm_requester_get_capabilities_case29(void **state) {
   spdm_context->connection_info.version.spdm_version_count = 1;
   spdm_context->connection_info.version.spdm_version[0].major_version = 1;
   spdm_context->connection_info.version.spdm_version[0].minor_version = 1;
-  spdm_context->local_context.capability.ct_exponent = 0;
-  spdm_context->local_context.capability.flags = DEFAULT_CAPABILITY_FLAG_VERSION_11;
+  spdm_context->local_context->capability.ct_exponent = 0;
+  spdm_context->local_context->capability.flags = DEFAULT_CAPABILITY_FLAG_VERSION_11;
 
   error_code = SPDM_ERROR_CODE_RESERVED_00;
   while(error_code <= 0xff) {
@@ -908,12 +908,16 @@ void test_spdm_requester_get_certificate_case1(void **state)
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data,
 						&data_size, &hash, &hash_size);
-	spdm_context->local_context.peer_root_cert_hash_provision_size =
+	spdm_context->local_context->peer_root_cert_hash_provision_size =
 		hash_size;
-	spdm_context->local_context.peer_root_cert_hash_provision = hash;
-	spdm_context->local_context.peer_cert_chain_provision = NULL;
-	spdm_context->local_context.peer_cert_chain_provision_size = 0;
+	spdm_context->local_context->peer_root_cert_hash_provision = hash;
+	spdm_context->local_context->peer_cert_chain_provision = NULL;
+	spdm_context->local_context->peer_cert_chain_provision_size = 0;
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	spdm_context->transcript.message_b.buffer_size = 0;
+#else
+	spdm_reset_message_b(spdm_context);
+#endif
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
 
@@ -922,7 +926,9 @@ void test_spdm_requester_get_certificate_case1(void **state)
 	status = spdm_get_certificate(spdm_context, 0, &cert_chain_size,
 				      cert_chain);
 	assert_int_equal(status, RETURN_DEVICE_ERROR);
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	assert_int_equal(spdm_context->transcript.message_b.buffer_size, 0);
+#endif
 	free(data);
 }
 
@@ -941,7 +947,9 @@ void test_spdm_requester_get_certificate_case2(void **state)
 	uintn data_size;
 	void *hash;
 	uintn hash_size;
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	uintn count;
+#endif
 
 	spdm_test_context = *state;
 	spdm_context = spdm_test_context->spdm_context;
@@ -953,14 +961,20 @@ void test_spdm_requester_get_certificate_case2(void **state)
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data,
 						&data_size, &hash, &hash_size);
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	count = (data_size + MAX_SPDM_CERT_CHAIN_BLOCK_LEN - 1) /
 		MAX_SPDM_CERT_CHAIN_BLOCK_LEN;
-	spdm_context->local_context.peer_root_cert_hash_provision_size =
+#endif
+	spdm_context->local_context->peer_root_cert_hash_provision_size =
 		hash_size;
-	spdm_context->local_context.peer_root_cert_hash_provision = hash;
-	spdm_context->local_context.peer_cert_chain_provision = NULL;
-	spdm_context->local_context.peer_cert_chain_provision_size = 0;
+	spdm_context->local_context->peer_root_cert_hash_provision = hash;
+	spdm_context->local_context->peer_cert_chain_provision = NULL;
+	spdm_context->local_context->peer_cert_chain_provision_size = 0;
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	spdm_context->transcript.message_b.buffer_size = 0;
+#else
+	spdm_reset_message_b(spdm_context);
+#endif
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
 
@@ -971,10 +985,12 @@ void test_spdm_requester_get_certificate_case2(void **state)
 	status = spdm_get_certificate(spdm_context, 0, &cert_chain_size,
 				      cert_chain);
 	assert_int_equal(status, RETURN_SUCCESS);
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	assert_int_equal(spdm_context->transcript.message_b.buffer_size,
 			 sizeof(spdm_get_certificate_request_t) * count +
 				 sizeof(spdm_certificate_response_t) * count +
 				 data_size);
+#endif
 	assert_int_equal(spdm_context->transcript.message_m.buffer_size, 0);
 	free(data);
 }
@@ -1005,12 +1021,16 @@ void test_spdm_requester_get_certificate_case3(void **state)
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data,
 						&data_size, &hash, &hash_size);
-	spdm_context->local_context.peer_root_cert_hash_provision_size =
+	spdm_context->local_context->peer_root_cert_hash_provision_size =
 		hash_size;
-	spdm_context->local_context.peer_root_cert_hash_provision = hash;
-	spdm_context->local_context.peer_cert_chain_provision = NULL;
-	spdm_context->local_context.peer_cert_chain_provision_size = 0;
+	spdm_context->local_context->peer_root_cert_hash_provision = hash;
+	spdm_context->local_context->peer_cert_chain_provision = NULL;
+	spdm_context->local_context->peer_cert_chain_provision_size = 0;
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	spdm_context->transcript.message_b.buffer_size = 0;
+#else
+	spdm_reset_message_b(spdm_context);
+#endif
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
 
@@ -1019,7 +1039,9 @@ void test_spdm_requester_get_certificate_case3(void **state)
 	status = spdm_get_certificate(spdm_context, 0, &cert_chain_size,
 				      cert_chain);
 	assert_int_equal(status, RETURN_UNSUPPORTED);
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	assert_int_equal(spdm_context->transcript.message_b.buffer_size, 0);
+#endif
 	free(data);
 }
 
@@ -1049,12 +1071,16 @@ void test_spdm_requester_get_certificate_case4(void **state)
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data,
 						&data_size, &hash, &hash_size);
-	spdm_context->local_context.peer_root_cert_hash_provision_size =
+	spdm_context->local_context->peer_root_cert_hash_provision_size =
 		hash_size;
-	spdm_context->local_context.peer_root_cert_hash_provision = hash;
-	spdm_context->local_context.peer_cert_chain_provision = NULL;
-	spdm_context->local_context.peer_cert_chain_provision_size = 0;
+	spdm_context->local_context->peer_root_cert_hash_provision = hash;
+	spdm_context->local_context->peer_cert_chain_provision = NULL;
+	spdm_context->local_context->peer_cert_chain_provision_size = 0;
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	spdm_context->transcript.message_b.buffer_size = 0;
+#else
+	spdm_reset_message_b(spdm_context);
+#endif
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
 
@@ -1063,7 +1089,9 @@ void test_spdm_requester_get_certificate_case4(void **state)
 	status = spdm_get_certificate(spdm_context, 0, &cert_chain_size,
 				      cert_chain);
 	assert_int_equal(status, RETURN_DEVICE_ERROR);
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	assert_int_equal(spdm_context->transcript.message_b.buffer_size, 0);
+#endif
 	free(data);
 }
 
@@ -1093,12 +1121,16 @@ void test_spdm_requester_get_certificate_case5(void **state)
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data,
 						&data_size, &hash, &hash_size);
-	spdm_context->local_context.peer_root_cert_hash_provision_size =
+	spdm_context->local_context->peer_root_cert_hash_provision_size =
 		hash_size;
-	spdm_context->local_context.peer_root_cert_hash_provision = hash;
-	spdm_context->local_context.peer_cert_chain_provision = NULL;
-	spdm_context->local_context.peer_cert_chain_provision_size = 0;
+	spdm_context->local_context->peer_root_cert_hash_provision = hash;
+	spdm_context->local_context->peer_cert_chain_provision = NULL;
+	spdm_context->local_context->peer_cert_chain_provision_size = 0;
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	spdm_context->transcript.message_b.buffer_size = 0;
+#else
+	spdm_reset_message_b(spdm_context);
+#endif
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
 
@@ -1107,7 +1139,9 @@ void test_spdm_requester_get_certificate_case5(void **state)
 	status = spdm_get_certificate(spdm_context, 0, &cert_chain_size,
 				      cert_chain);
 	assert_int_equal(status, RETURN_NO_RESPONSE);
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	assert_int_equal(spdm_context->transcript.message_b.buffer_size, 0);
+#endif
 	free(data);
 }
 
@@ -1126,7 +1160,9 @@ void test_spdm_requester_get_certificate_case6(void **state)
 	uintn data_size;
 	void *hash;
 	uintn hash_size;
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	uintn count;
+#endif
 
 	spdm_test_context = *state;
 	spdm_context = spdm_test_context->spdm_context;
@@ -1138,14 +1174,20 @@ void test_spdm_requester_get_certificate_case6(void **state)
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data,
 						&data_size, &hash, &hash_size);
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	count = (data_size + MAX_SPDM_CERT_CHAIN_BLOCK_LEN - 1) /
 		MAX_SPDM_CERT_CHAIN_BLOCK_LEN;
-	spdm_context->local_context.peer_root_cert_hash_provision_size =
+#endif
+	spdm_context->local_context->peer_root_cert_hash_provision_size =
 		hash_size;
-	spdm_context->local_context.peer_root_cert_hash_provision = hash;
-	spdm_context->local_context.peer_cert_chain_provision = NULL;
-	spdm_context->local_context.peer_cert_chain_provision_size = 0;
+	spdm_context->local_context->peer_root_cert_hash_provision = hash;
+	spdm_context->local_context->peer_cert_chain_provision = NULL;
+	spdm_context->local_context->peer_cert_chain_provision_size = 0;
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	spdm_context->transcript.message_b.buffer_size = 0;
+#else
+	spdm_reset_message_b(spdm_context);
+#endif
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
 
@@ -1154,10 +1196,12 @@ void test_spdm_requester_get_certificate_case6(void **state)
 	status = spdm_get_certificate(spdm_context, 0, &cert_chain_size,
 				      cert_chain);
 	assert_int_equal(status, RETURN_SUCCESS);
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	assert_int_equal(spdm_context->transcript.message_b.buffer_size,
 			 sizeof(spdm_get_certificate_request_t) * count +
 				 sizeof(spdm_certificate_response_t) * count +
 				 data_size);
+#endif
 	free(data);
 }
 
@@ -1187,12 +1231,16 @@ void test_spdm_requester_get_certificate_case7(void **state)
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data,
 						&data_size, &hash, &hash_size);
-	spdm_context->local_context.peer_root_cert_hash_provision_size =
+	spdm_context->local_context->peer_root_cert_hash_provision_size =
 		hash_size;
-	spdm_context->local_context.peer_root_cert_hash_provision = hash;
-	spdm_context->local_context.peer_cert_chain_provision = NULL;
-	spdm_context->local_context.peer_cert_chain_provision_size = 0;
+	spdm_context->local_context->peer_root_cert_hash_provision = hash;
+	spdm_context->local_context->peer_cert_chain_provision = NULL;
+	spdm_context->local_context->peer_cert_chain_provision_size = 0;
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	spdm_context->transcript.message_b.buffer_size = 0;
+#else
+	spdm_reset_message_b(spdm_context);
+#endif
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
 
@@ -1203,7 +1251,9 @@ void test_spdm_requester_get_certificate_case7(void **state)
 	assert_int_equal(status, RETURN_DEVICE_ERROR);
 	assert_int_equal(spdm_context->connection_info.connection_state,
 			 SPDM_CONNECTION_STATE_NOT_STARTED);
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	assert_int_equal(spdm_context->transcript.message_b.buffer_size, 0);
+#endif
 	free(data);
 }
 
@@ -1233,12 +1283,16 @@ void test_spdm_requester_get_certificate_case8(void **state)
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data,
 						&data_size, &hash, &hash_size);
-	spdm_context->local_context.peer_root_cert_hash_provision_size =
+	spdm_context->local_context->peer_root_cert_hash_provision_size =
 		hash_size;
-	spdm_context->local_context.peer_root_cert_hash_provision = hash;
-	spdm_context->local_context.peer_cert_chain_provision = NULL;
-	spdm_context->local_context.peer_cert_chain_provision_size = 0;
+	spdm_context->local_context->peer_root_cert_hash_provision = hash;
+	spdm_context->local_context->peer_cert_chain_provision = NULL;
+	spdm_context->local_context->peer_cert_chain_provision_size = 0;
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	spdm_context->transcript.message_b.buffer_size = 0;
+#else
+	spdm_reset_message_b(spdm_context);
+#endif
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
 
@@ -1265,7 +1319,9 @@ void test_spdm_requester_get_certificate_case9(void **state)
 	uintn data_size;
 	void *hash;
 	uintn hash_size;
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	uintn count;
+#endif
 
 	spdm_test_context = *state;
 	spdm_context = spdm_test_context->spdm_context;
@@ -1277,14 +1333,20 @@ void test_spdm_requester_get_certificate_case9(void **state)
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data,
 						&data_size, &hash, &hash_size);
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	count = (data_size + MAX_SPDM_CERT_CHAIN_BLOCK_LEN - 1) /
 		MAX_SPDM_CERT_CHAIN_BLOCK_LEN;
-	spdm_context->local_context.peer_root_cert_hash_provision_size =
+#endif
+	spdm_context->local_context->peer_root_cert_hash_provision_size =
 		hash_size;
-	spdm_context->local_context.peer_root_cert_hash_provision = hash;
-	spdm_context->local_context.peer_cert_chain_provision = NULL;
-	spdm_context->local_context.peer_cert_chain_provision_size = 0;
+	spdm_context->local_context->peer_root_cert_hash_provision = hash;
+	spdm_context->local_context->peer_cert_chain_provision = NULL;
+	spdm_context->local_context->peer_cert_chain_provision_size = 0;
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	spdm_context->transcript.message_b.buffer_size = 0;
+#else
+	spdm_reset_message_b(spdm_context);
+#endif
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
 
@@ -1293,10 +1355,12 @@ void test_spdm_requester_get_certificate_case9(void **state)
 	status = spdm_get_certificate(spdm_context, 0, &cert_chain_size,
 				      cert_chain);
 	assert_int_equal(status, RETURN_SUCCESS);
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	assert_int_equal(spdm_context->transcript.message_b.buffer_size,
 			 sizeof(spdm_get_certificate_request_t) * count +
 				 sizeof(spdm_certificate_response_t) * count +
 				 data_size);
+#endif
 	free(data);
 }
 
@@ -1315,7 +1379,9 @@ void test_spdm_requester_get_certificate_case10(void **state)
 	uintn data_size;
 	void *hash;
 	uintn hash_size;
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	uintn count;
+#endif
 
 	spdm_test_context = *state;
 	spdm_context = spdm_test_context->spdm_context;
@@ -1327,13 +1393,19 @@ void test_spdm_requester_get_certificate_case10(void **state)
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data,
 						&data_size, &hash, &hash_size);
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	count = (data_size + MAX_SPDM_CERT_CHAIN_BLOCK_LEN - 1) /
 		MAX_SPDM_CERT_CHAIN_BLOCK_LEN;
-	spdm_context->local_context.peer_root_cert_hash_provision_size = 0;
-	spdm_context->local_context.peer_root_cert_hash_provision = NULL;
-	spdm_context->local_context.peer_cert_chain_provision = data;
-	spdm_context->local_context.peer_cert_chain_provision_size = data_size;
+#endif
+	spdm_context->local_context->peer_root_cert_hash_provision_size = 0;
+	spdm_context->local_context->peer_root_cert_hash_provision = NULL;
+	spdm_context->local_context->peer_cert_chain_provision = data;
+	spdm_context->local_context->peer_cert_chain_provision_size = data_size;
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	spdm_context->transcript.message_b.buffer_size = 0;
+#else
+	spdm_reset_message_b(spdm_context);
+#endif
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
 
@@ -1342,10 +1414,12 @@ void test_spdm_requester_get_certificate_case10(void **state)
 	status = spdm_get_certificate(spdm_context, 0, &cert_chain_size,
 				      cert_chain);
 	assert_int_equal(status, RETURN_SUCCESS);
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	assert_int_equal(spdm_context->transcript.message_b.buffer_size,
 			 sizeof(spdm_get_certificate_request_t) * count +
 				 sizeof(spdm_certificate_response_t) * count +
 				 data_size);
+#endif
 	free(data);
 }
 
@@ -1364,7 +1438,9 @@ void test_spdm_requester_get_certificate_case11(void **state)
 	uintn data_size;
 	void *hash;
 	uintn hash_size;
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	uintn count;
+#endif
 
 	spdm_test_context = *state;
 	spdm_context = spdm_test_context->spdm_context;
@@ -1378,28 +1454,36 @@ void test_spdm_requester_get_certificate_case11(void **state)
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data,
 						&data_size, &hash, &hash_size);
-	spdm_context->local_context.peer_root_cert_hash_provision_size =
+	spdm_context->local_context->peer_root_cert_hash_provision_size =
 		hash_size;
-	spdm_context->local_context.peer_root_cert_hash_provision = hash;
-	spdm_context->local_context.peer_cert_chain_provision = NULL;
-	spdm_context->local_context.peer_cert_chain_provision_size = 0;
+	spdm_context->local_context->peer_root_cert_hash_provision = hash;
+	spdm_context->local_context->peer_cert_chain_provision = NULL;
+	spdm_context->local_context->peer_cert_chain_provision_size = 0;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
 	// Reseting message buffer
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	spdm_context->transcript.message_b.buffer_size = 0;
+#else
+	spdm_reset_message_b(spdm_context);
+#endif
 	// Calculating expected number of messages received
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	count = (data_size + MAX_SPDM_CERT_CHAIN_BLOCK_LEN - 1) /
 		MAX_SPDM_CERT_CHAIN_BLOCK_LEN;
+#endif
 
 	cert_chain_size = sizeof(cert_chain);
 	zero_mem(cert_chain, sizeof(cert_chain));
 	status = spdm_get_certificate(spdm_context, 0, &cert_chain_size,
 				      cert_chain);
 	assert_int_equal(status, RETURN_SECURITY_VIOLATION);
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	assert_int_equal(spdm_context->transcript.message_b.buffer_size,
 			 sizeof(spdm_get_certificate_request_t) * count +
 				 sizeof(spdm_certificate_response_t) * count +
 				 data_size);
+#endif
 	free(data);
 }
 
@@ -1418,7 +1502,9 @@ void test_spdm_requester_get_certificate_case12(void **state)
 	uintn data_size;
 	void *hash;
 	uintn hash_size;
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	uintn count;
+#endif
 
 	spdm_test_context = *state;
 	spdm_context = spdm_test_context->spdm_context;
@@ -1435,28 +1521,36 @@ void test_spdm_requester_get_certificate_case12(void **state)
 	if (hash != NULL) {
 		((uint8 *)hash)[0]++;
 	}
-	spdm_context->local_context.peer_root_cert_hash_provision_size =
+	spdm_context->local_context->peer_root_cert_hash_provision_size =
 		hash_size;
-	spdm_context->local_context.peer_root_cert_hash_provision = hash;
-	spdm_context->local_context.peer_cert_chain_provision = NULL;
-	spdm_context->local_context.peer_cert_chain_provision_size = 0;
+	spdm_context->local_context->peer_root_cert_hash_provision = hash;
+	spdm_context->local_context->peer_cert_chain_provision = NULL;
+	spdm_context->local_context->peer_cert_chain_provision_size = 0;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
 	// Reseting message buffer
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	spdm_context->transcript.message_b.buffer_size = 0;
+#else
+	spdm_reset_message_b(spdm_context);
+#endif
 	// Calculating expected number of messages received
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	count = (data_size + MAX_SPDM_CERT_CHAIN_BLOCK_LEN - 1) /
 		MAX_SPDM_CERT_CHAIN_BLOCK_LEN;
+#endif
 
 	cert_chain_size = sizeof(cert_chain);
 	zero_mem(cert_chain, sizeof(cert_chain));
 	status = spdm_get_certificate(spdm_context, 0, &cert_chain_size,
 				      cert_chain);
 	assert_int_equal(status, RETURN_SECURITY_VIOLATION);
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	assert_int_equal(spdm_context->transcript.message_b.buffer_size,
 			 sizeof(spdm_get_certificate_request_t) * count +
 				 sizeof(spdm_certificate_response_t) * count +
 				 data_size);
+#endif
 	free(data);
 }
 
@@ -1475,7 +1569,9 @@ void test_spdm_requester_get_certificate_case13(void **state)
 	uintn data_size;
 	void *hash;
 	uintn hash_size;
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	uintn count;
+#endif
 
 	spdm_test_context = *state;
 	spdm_context = spdm_test_context->spdm_context;
@@ -1489,28 +1585,36 @@ void test_spdm_requester_get_certificate_case13(void **state)
 	read_responder_public_certificate_chain_by_size(
 		m_use_hash_algo, m_use_asym_algo, TEST_CERT_SMALL, &data,
 		&data_size, &hash, &hash_size);
-	spdm_context->local_context.peer_root_cert_hash_provision_size =
+	spdm_context->local_context->peer_root_cert_hash_provision_size =
 		hash_size;
-	spdm_context->local_context.peer_root_cert_hash_provision = hash;
-	spdm_context->local_context.peer_cert_chain_provision = NULL;
-	spdm_context->local_context.peer_cert_chain_provision_size = 0;
+	spdm_context->local_context->peer_root_cert_hash_provision = hash;
+	spdm_context->local_context->peer_cert_chain_provision = NULL;
+	spdm_context->local_context->peer_cert_chain_provision_size = 0;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
 	// Reseting message buffer
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	spdm_context->transcript.message_b.buffer_size = 0;
+#else
+	spdm_reset_message_b(spdm_context);
+#endif
 	// Calculating expected number of messages received
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	count = (data_size + MAX_SPDM_CERT_CHAIN_BLOCK_LEN - 1) /
 		MAX_SPDM_CERT_CHAIN_BLOCK_LEN;
+#endif
 
 	cert_chain_size = sizeof(cert_chain);
 	zero_mem(cert_chain, sizeof(cert_chain));
 	status = spdm_get_certificate(spdm_context, 0, &cert_chain_size,
 				      cert_chain);
 	assert_int_equal(status, RETURN_SUCCESS);
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	assert_int_equal(spdm_context->transcript.message_b.buffer_size,
 			 sizeof(spdm_get_certificate_request_t) * count +
 				 sizeof(spdm_certificate_response_t) * count +
 				 data_size);
+#endif
 	free(data);
 }
 
@@ -1529,7 +1633,9 @@ void test_spdm_requester_get_certificate_case14(void **state)
 	uintn data_size;
 	void *hash;
 	uintn hash_size;
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	uintn count;
+#endif
 	uint16 get_cert_length;
 
 	// Get certificate chain byte by byte
@@ -1547,17 +1653,23 @@ void test_spdm_requester_get_certificate_case14(void **state)
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data,
 						&data_size, &hash, &hash_size);
-	spdm_context->local_context.peer_root_cert_hash_provision_size =
+	spdm_context->local_context->peer_root_cert_hash_provision_size =
 		hash_size;
-	spdm_context->local_context.peer_root_cert_hash_provision = hash;
-	spdm_context->local_context.peer_cert_chain_provision = NULL;
-	spdm_context->local_context.peer_cert_chain_provision_size = 0;
+	spdm_context->local_context->peer_root_cert_hash_provision = hash;
+	spdm_context->local_context->peer_cert_chain_provision = NULL;
+	spdm_context->local_context->peer_cert_chain_provision_size = 0;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
 	// Reseting message buffer
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	spdm_context->transcript.message_b.buffer_size = 0;
+#else
+	spdm_reset_message_b(spdm_context);
+#endif
 	// Calculating expected number of messages received
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	count = (data_size + get_cert_length - 1) / get_cert_length;
+#endif
 
 	cert_chain_size = sizeof(cert_chain);
 	zero_mem(cert_chain, sizeof(cert_chain));
@@ -1566,11 +1678,13 @@ void test_spdm_requester_get_certificate_case14(void **state)
 	// It may fail because the spdm does not support too many messages.
 	//assert_int_equal (status, RETURN_SUCCESS);
 	if (status == RETURN_SUCCESS) {
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 		assert_int_equal(
 			spdm_context->transcript.message_b.buffer_size,
 			sizeof(spdm_get_certificate_request_t) * count +
 				sizeof(spdm_certificate_response_t) * count +
 				data_size);
+#endif
 	}
 	free(data);
 }
@@ -1590,7 +1704,9 @@ void test_spdm_requester_get_certificate_case15(void **state)
 	uintn data_size;
 	void *hash;
 	uintn hash_size;
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	uintn count;
+#endif
 
 	spdm_test_context = *state;
 	spdm_context = spdm_test_context->spdm_context;
@@ -1604,18 +1720,24 @@ void test_spdm_requester_get_certificate_case15(void **state)
 	read_responder_public_certificate_chain_by_size(
 		m_use_hash_algo, m_use_asym_algo, TEST_CERT_MAXUINT16, &data,
 		&data_size, &hash, &hash_size);
-	spdm_context->local_context.peer_root_cert_hash_provision_size =
+	spdm_context->local_context->peer_root_cert_hash_provision_size =
 		hash_size;
-	spdm_context->local_context.peer_root_cert_hash_provision = hash;
-	spdm_context->local_context.peer_cert_chain_provision = NULL;
-	spdm_context->local_context.peer_cert_chain_provision_size = 0;
+	spdm_context->local_context->peer_root_cert_hash_provision = hash;
+	spdm_context->local_context->peer_cert_chain_provision = NULL;
+	spdm_context->local_context->peer_cert_chain_provision_size = 0;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
 	// Reseting message buffer
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	spdm_context->transcript.message_b.buffer_size = 0;
+#else
+	spdm_reset_message_b(spdm_context);
+#endif
 	// Calculating expected number of messages received
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	count = (data_size + MAX_SPDM_CERT_CHAIN_BLOCK_LEN - 1) /
 		MAX_SPDM_CERT_CHAIN_BLOCK_LEN;
+#endif
 
 	cert_chain_size = sizeof(cert_chain);
 	zero_mem(cert_chain, sizeof(cert_chain));
@@ -1624,11 +1746,13 @@ void test_spdm_requester_get_certificate_case15(void **state)
 	// It may fail because the spdm does not support too long message.
 	//assert_int_equal (status, RETURN_SUCCESS);
 	if (status == RETURN_SUCCESS) {
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 		assert_int_equal(
 			spdm_context->transcript.message_b.buffer_size,
 			sizeof(spdm_get_certificate_request_t) * count +
 				sizeof(spdm_certificate_response_t) * count +
 				data_size);
+#endif
 	}
 	free(data);
 }
@@ -1658,24 +1782,32 @@ void test_spdm_requester_get_certificate_case16(void **state) {
   spdm_test_context->case_id = 0x10;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
   read_responder_public_certificate_chain (m_use_hash_algo, m_use_asym_algo, &data, &data_size, &hash, &hash_size);
-  spdm_context->local_context.peer_root_cert_hash_provision_size = hash_size;
-  spdm_context->local_context.peer_root_cert_hash_provision = hash;
-  spdm_context->local_context.peer_cert_chain_provision = NULL;
-  spdm_context->local_context.peer_cert_chain_provision_size = 0;
+  spdm_context->local_context->peer_root_cert_hash_provision_size = hash_size;
+  spdm_context->local_context->peer_root_cert_hash_provision = hash;
+  spdm_context->local_context->peer_cert_chain_provision = NULL;
+  spdm_context->local_context->peer_cert_chain_provision_size = 0;
   spdm_context->connection_info.algorithm.base_hash_algo = m_use_hash_algo;
 
   error_code = SPDM_ERROR_CODE_RESERVED_00;
   while(error_code <= 0xff) {
     spdm_context->connection_info.connection_state = SPDM_CONNECTION_STATE_AFTER_DIGESTS;
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
     spdm_context->transcript.message_b.buffer_size = 0;
+#else
+    spdm_reset_message_b(spdm_context);
+#endif
 
     cert_chain_size = sizeof(cert_chain);
     zero_mem (cert_chain, sizeof(cert_chain));
     status = spdm_get_certificate (spdm_context, 0, &cert_chain_size, cert_chain);
     // assert_int_equal (status, RETURN_DEVICE_ERROR);
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
     // assert_int_equal (spdm_context->transcript.message_b.buffer_size, 0);
+#endif
     ASSERT_INT_EQUAL_CASE (status, RETURN_DEVICE_ERROR, error_code);
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
     ASSERT_INT_EQUAL_CASE (spdm_context->transcript.message_b.buffer_size, 0, error_code);
+#endif
 
     error_code++;
     if(error_code == SPDM_ERROR_CODE_BUSY) { //busy is treated in cases 5 and 6
@@ -1692,6 +1824,182 @@ void test_spdm_requester_get_certificate_case16(void **state) {
   free(data);
 }
 
+/**
+  Test 17: the certificate chain is verified once, then got from the certificate chain cache
+  Expected Behavior: the second request gets the same certificate chain with no message sent
+  and no CERTIFICATE messages received (checked in transcript.message_b buffer)
+**/
+void test_spdm_requester_get_certificate_case17(void **state)
+{
+	return_status status;
+	spdm_test_context_t *spdm_test_context;
+	spdm_context_t *spdm_context;
+	uintn cert_chain_size;
+	uint8 cert_chain[MAX_SPDM_CERT_CHAIN_SIZE];
+	void *data;
+	uintn data_size;
+	void *hash;
+	uintn hash_size;
+	void *cert_chain_cache;
+
+	spdm_test_context = *state;
+	spdm_context = spdm_test_context->spdm_context;
+	spdm_test_context->case_id = 0x2;
+	spdm_context->connection_info.connection_state =
+		SPDM_CONNECTION_STATE_AFTER_DIGESTS;
+	spdm_context->connection_info.capability.flags |=
+		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
+	read_responder_public_certificate_chain(m_use_hash_algo,
+						m_use_asym_algo, &data,
+						&data_size, &hash, &hash_size);
+	spdm_context->local_context->peer_root_cert_hash_provision_size =
+		hash_size;
+	spdm_context->local_context->peer_root_cert_hash_provision = hash;
+	spdm_context->local_context->peer_cert_chain_provision = NULL;
+	spdm_context->local_context->peer_cert_chain_provision_size = 0;
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
+	spdm_context->transcript.message_b.buffer_size = 0;
+#else
+	spdm_reset_message_b(spdm_context);
+#endif
+	spdm_context->connection_info.algorithm.base_hash_algo =
+		m_use_hash_algo;
+
+	cert_chain_cache = malloc(spdm_get_cert_chain_cache_size(1));
+	spdm_init_cert_chain_cache(cert_chain_cache, 1);
+	spdm_register_cert_chain_cache(spdm_context, cert_chain_cache, NULL,
+				       NULL);
+
+	cert_chain_size = sizeof(cert_chain);
+	zero_mem(cert_chain, sizeof(cert_chain));
+	status = spdm_get_certificate(spdm_context, 0, &cert_chain_size,
+				      cert_chain);
+	assert_int_equal(status, RETURN_SUCCESS);
+
+	spdm_test_context->case_id = 0x11;
+	spdm_context->connection_info.connection_state =
+		SPDM_CONNECTION_STATE_AFTER_DIGESTS;
+	spdm_context->connection_info.peer_digest_slot_mask = 0x01;
+	spdm_hash_all(m_use_hash_algo, data, data_size,
+		      spdm_context->connection_info.peer_digest[0]);
+	spdm_context->connection_info.peer_used_cert_chain_buffer_size = 0;
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
+	spdm_context->transcript.message_b.buffer_size = 0;
+#else
+	spdm_reset_message_b(spdm_context);
+#endif
+
+	cert_chain_size = sizeof(cert_chain);
+	zero_mem(cert_chain, sizeof(cert_chain));
+	status = spdm_get_certificate(spdm_context, 0, &cert_chain_size,
+				      cert_chain);
+	assert_int_equal(status, RETURN_SUCCESS);
+	assert_int_equal(cert_chain_size, data_size);
+	assert_memory_equal(cert_chain, data, data_size);
+	assert_int_equal(
+		spdm_context->connection_info.peer_used_cert_chain_buffer_size,
+		data_size);
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
+	assert_int_equal(spdm_context->transcript.message_b.buffer_size, 0);
+#endif
+
+	spdm_register_cert_chain_cache(spdm_context, NULL, NULL, NULL);
+	free(cert_chain_cache);
+	free(data);
+}
+
+/**
+  Test 18: the certificate chain is cached, then the provisioned root certificate hash changes
+  Expected Behavior: the cached chain no longer matches the root, so the entry is evicted and
+  GET_CERTIFICATE is sent again, which fails with RETURN_DEVICE_ERROR as the message could not be sent
+**/
+void test_spdm_requester_get_certificate_case18(void **state)
+{
+	return_status status;
+	spdm_test_context_t *spdm_test_context;
+	spdm_context_t *spdm_context;
+	uintn cert_chain_size;
+	uint8 cert_chain[MAX_SPDM_CERT_CHAIN_SIZE];
+	void *data;
+	uintn data_size;
+	void *hash;
+	uintn hash_size;
+	uint8 other_root_hash[MAX_HASH_SIZE];
+	spdm_cert_chain_cache_t *cert_chain_cache;
+
+	spdm_test_context = *state;
+	spdm_context = spdm_test_context->spdm_context;
+	spdm_test_context->case_id = 0x2;
+	spdm_context->connection_info.connection_state =
+		SPDM_CONNECTION_STATE_AFTER_DIGESTS;
+	spdm_context->connection_info.capability.flags |=
+		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
+	read_responder_public_certificate_chain(m_use_hash_algo,
+						m_use_asym_algo, &data,
+						&data_size, &hash, &hash_size);
+	spdm_context->local_context->peer_root_cert_hash_provision_size =
+		hash_size;
+	spdm_context->local_context->peer_root_cert_hash_provision = hash;
+	spdm_context->local_context->peer_cert_chain_provision = NULL;
+	spdm_context->local_context->peer_cert_chain_provision_size = 0;
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
+	spdm_context->transcript.message_b.buffer_size = 0;
+#else
+	spdm_reset_message_b(spdm_context);
+#endif
+	spdm_context->connection_info.algorithm.base_hash_algo =
+		m_use_hash_algo;
+
+	cert_chain_cache = malloc(spdm_get_cert_chain_cache_size(1));
+	spdm_init_cert_chain_cache(cert_chain_cache, 1);
+	spdm_register_cert_chain_cache(spdm_context, cert_chain_cache, NULL,
+				       NULL);
+
+	cert_chain_size = sizeof(cert_chain);
+	zero_mem(cert_chain, sizeof(cert_chain));
+	status = spdm_get_certificate(spdm_context, 0, &cert_chain_size,
+				      cert_chain);
+	assert_int_equal(status, RETURN_SUCCESS);
+	assert_int_equal(cert_chain_cache->entry[0].base_hash_algo,
+			 m_use_hash_algo);
+
+	//
+	// Provision another root. The cached chain was verified against the old one.
+	//
+	copy_mem(other_root_hash, hash, hash_size);
+	other_root_hash[0] ^= 0xFF;
+	spdm_context->local_context->peer_root_cert_hash_provision =
+		other_root_hash;
+
+	spdm_test_context->case_id = 0x1;
+	spdm_context->connection_info.connection_state =
+		SPDM_CONNECTION_STATE_AFTER_DIGESTS;
+	spdm_context->connection_info.peer_digest_slot_mask = 0x01;
+	spdm_hash_all(m_use_hash_algo, data, data_size,
+		      spdm_context->connection_info.peer_digest[0]);
+	spdm_context->connection_info.peer_used_cert_chain_buffer_size = 0;
+
+	cert_chain_size = sizeof(cert_chain);
+	zero_mem(cert_chain, sizeof(cert_chain));
+	status = spdm_get_cached_certificate(spdm_context, 0, &cert_chain_size,
+					     cert_chain);
+	assert_int_equal(status, RETURN_NOT_FOUND);
+	assert_int_equal(cert_chain_cache->entry[0].base_hash_algo, 0);
+	assert_int_equal(
+		spdm_context->connection_info.peer_used_cert_chain_buffer_size,
+		0);
+
+	cert_chain_size = sizeof(cert_chain);
+	status = spdm_get_certificate(spdm_context, 0, &cert_chain_size,
+				      cert_chain);
+	assert_int_equal(status, RETURN_DEVICE_ERROR);
+
+	spdm_context->local_context->peer_root_cert_hash_provision = hash;
+	spdm_register_cert_chain_cache(spdm_context, NULL, NULL, NULL);
+	free(cert_chain_cache);
+	free(data);
+}
+
 spdm_test_context_t m_spdm_requester_get_certificate_test_context = {
 	SPDM_TEST_CONTEXT_SIGNATURE,
 	TRUE,
@@ -1734,6 +2042,10 @@ int spdm_requester_get_certificate_test_main(void)
 		cmocka_unit_test(test_spdm_requester_get_certificate_case15),
 		// Unexpected errors
 		cmocka_unit_test(test_spdm_requester_get_certificate_case16),
+		// Successful response, then certificate chain cache hit
+		cmocka_unit_test(test_spdm_requester_get_certificate_case17),
+		// Certificate chain cache hit invalidated by a new provisioned root
+		cmocka_unit_test(test_spdm_requester_get_certificate_case18),
 	};
 
 	setup_spdm_test_context(&m_spdm_requester_get_certificate_test_context);
@@ -656,19 +656,25 @@ void test_spdm_requester_get_digests_case1(void **state)
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
-	spdm_context->local_context.peer_cert_chain_provision =
+	spdm_context->local_context->peer_cert_chain_provision =
 		m_local_certificate_chain;
-	spdm_context->local_context.peer_cert_chain_provision_size =
+	spdm_context->local_context->peer_cert_chain_provision_size =
 		MAX_SPDM_MESSAGE_BUFFER_SIZE;
 	set_mem(m_local_certificate_chain, MAX_SPDM_MESSAGE_BUFFER_SIZE,
 		(uint8)(0xFF));
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	spdm_context->transcript.message_b.buffer_size = 0;
+#else
+	spdm_reset_message_b(spdm_context);
+#endif
 
 	zero_mem(total_digest_buffer, sizeof(total_digest_buffer));
 	status =
 		spdm_get_digest(spdm_context, &slot_mask, &total_digest_buffer);
 	assert_int_equal(status, RETURN_DEVICE_ERROR);
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	assert_int_equal(spdm_context->transcript.message_b.buffer_size, 0);
+#endif
 }
 
 /**
@@ -692,13 +698,17 @@ void test_spdm_requester_get_digests_case2(void **state)
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
-	spdm_context->local_context.peer_cert_chain_provision =
+	spdm_context->local_context->peer_cert_chain_provision =
 		m_local_certificate_chain;
-	spdm_context->local_context.peer_cert_chain_provision_size =
+	spdm_context->local_context->peer_cert_chain_provision_size =
 		MAX_SPDM_MESSAGE_BUFFER_SIZE;
 	set_mem(m_local_certificate_chain, MAX_SPDM_MESSAGE_BUFFER_SIZE,
 		(uint8)(0xFF));
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	spdm_context->transcript.message_b.buffer_size = 0;
+#else
+	spdm_reset_message_b(spdm_context);
+#endif
 
 	spdm_context->transcript.message_m.buffer_size =
 							spdm_context->transcript.message_m.max_buffer_size;
@@ -706,12 +716,14 @@ void test_spdm_requester_get_digests_case2(void **state)
 	status =
 		spdm_get_digest(spdm_context, &slot_mask, &total_digest_buffer);
 	assert_int_equal(status, RETURN_SUCCESS);
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	assert_int_equal(
 		spdm_context->transcript.message_b.buffer_size,
 		sizeof(spdm_get_digest_request_t) +
 			sizeof(spdm_digest_response_t) +
 			spdm_get_hash_size(spdm_context->connection_info
 						   .algorithm.base_hash_algo) * MAX_SPDM_SLOT_COUNT);
+#endif
 	assert_int_equal(spdm_context->transcript.message_m.buffer_size, 0);
 }
 
@@ -737,19 +749,25 @@ void test_spdm_requester_get_digests_case3(void **state)
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
-	spdm_context->local_context.peer_cert_chain_provision =
+	spdm_context->local_context->peer_cert_chain_provision =
 		m_local_certificate_chain;
-	spdm_context->local_context.peer_cert_chain_provision_size =
+	spdm_context->local_context->peer_cert_chain_provision_size =
 		MAX_SPDM_MESSAGE_BUFFER_SIZE;
 	set_mem(m_local_certificate_chain, MAX_SPDM_MESSAGE_BUFFER_SIZE,
 		(uint8)(0xFF));
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	spdm_context->transcript.message_b.buffer_size = 0;
+#else
+	spdm_reset_message_b(spdm_context);
+#endif
 
 	zero_mem(total_digest_buffer, sizeof(total_digest_buffer));
 	status =
 		spdm_get_digest(spdm_context, &slot_mask, &total_digest_buffer);
 	assert_int_equal(status, RETURN_UNSUPPORTED);
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	assert_int_equal(spdm_context->transcript.message_b.buffer_size, 0);
+#endif
 }
 
 /**
@@ -773,19 +791,25 @@ void test_spdm_requester_get_digests_case4(void **state)
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
-	spdm_context->local_context.peer_cert_chain_provision =
+	spdm_context->local_context->peer_cert_chain_provision =
 		m_local_certificate_chain;
-	spdm_context->local_context.peer_cert_chain_provision_size =
+	spdm_context->local_context->peer_cert_chain_provision_size =
 		MAX_SPDM_MESSAGE_BUFFER_SIZE;
 	set_mem(m_local_certificate_chain, MAX_SPDM_MESSAGE_BUFFER_SIZE,
 		(uint8)(0xFF));
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	spdm_context->transcript.message_b.buffer_size = 0;
+#else
+	spdm_reset_message_b(spdm_context);
+#endif
 
 	zero_mem(total_digest_buffer, sizeof(total_digest_buffer));
 	status =
 		spdm_get_digest(spdm_context, &slot_mask, &total_digest_buffer);
 	assert_int_equal(status, RETURN_DEVICE_ERROR);
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	assert_int_equal(spdm_context->transcript.message_b.buffer_size, 0);
+#endif
 }
 
 /**
@@ -809,19 +833,25 @@ void test_spdm_requester_get_digests_case5(void **state)
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
-	spdm_context->local_context.peer_cert_chain_provision =
+	spdm_context->local_context->peer_cert_chain_provision =
 		m_local_certificate_chain;
-	spdm_context->local_context.peer_cert_chain_provision_size =
+	spdm_context->local_context->peer_cert_chain_provision_size =
 		MAX_SPDM_MESSAGE_BUFFER_SIZE;
 	set_mem(m_local_certificate_chain, MAX_SPDM_MESSAGE_BUFFER_SIZE,
 		(uint8)(0xFF));
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	spdm_context->transcript.message_b.buffer_size = 0;
+#else
+	spdm_reset_message_b(spdm_context);
+#endif
 
 	zero_mem(total_digest_buffer, sizeof(total_digest_buffer));
 	status =
 		spdm_get_digest(spdm_context, &slot_mask, &total_digest_buffer);
 	assert_int_equal(status, RETURN_NO_RESPONSE);
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	assert_int_equal(spdm_context->transcript.message_b.buffer_size, 0);
+#endif
 }
 
 /**
@@ -846,24 +876,30 @@ void test_spdm_requester_get_digests_case6(void **state)
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
-	spdm_context->local_context.peer_cert_chain_provision =
+	spdm_context->local_context->peer_cert_chain_provision =
 		m_local_certificate_chain;
-	spdm_context->local_context.peer_cert_chain_provision_size =
+	spdm_context->local_context->peer_cert_chain_provision_size =
 		MAX_SPDM_MESSAGE_BUFFER_SIZE;
 	set_mem(m_local_certificate_chain, MAX_SPDM_MESSAGE_BUFFER_SIZE,
 		(uint8)(0xFF));
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	spdm_context->transcript.message_b.buffer_size = 0;
+#else
+	spdm_reset_message_b(spdm_context);
+#endif
 
 	zero_mem(total_digest_buffer, sizeof(total_digest_buffer));
 	status =
 		spdm_get_digest(spdm_context, &slot_mask, &total_digest_buffer);
 	assert_int_equal(status, RETURN_SUCCESS);
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	assert_int_equal(
 		spdm_context->transcript.message_b.buffer_size,
 		sizeof(spdm_get_digest_request_t) +
 			sizeof(spdm_digest_response_t) +
 			spdm_get_hash_size(spdm_context->connection_info
 						   .algorithm.base_hash_algo));
+#endif
 }
 
 /**
@@ -888,13 +924,17 @@ void test_spdm_requester_get_digests_case7(void **state)
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
-	spdm_context->local_context.peer_cert_chain_provision =
+	spdm_context->local_context->peer_cert_chain_provision =
 		m_local_certificate_chain;
-	spdm_context->local_context.peer_cert_chain_provision_size =
+	spdm_context->local_context->peer_cert_chain_provision_size =
 		MAX_SPDM_MESSAGE_BUFFER_SIZE;
 	set_mem(m_local_certificate_chain, MAX_SPDM_MESSAGE_BUFFER_SIZE,
 		(uint8)(0xFF));
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	spdm_context->transcript.message_b.buffer_size = 0;
+#else
+	spdm_reset_message_b(spdm_context);
+#endif
 
 	zero_mem(total_digest_buffer, sizeof(total_digest_buffer));
 	status =
@@ -902,7 +942,9 @@ void test_spdm_requester_get_digests_case7(void **state)
 	assert_int_equal(status, RETURN_DEVICE_ERROR);
 	assert_int_equal(spdm_context->connection_info.connection_state,
 			 SPDM_CONNECTION_STATE_NOT_STARTED);
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	assert_int_equal(spdm_context->transcript.message_b.buffer_size, 0);
+#endif
 }
 
 /**
@@ -927,13 +969,17 @@ void test_spdm_requester_get_digests_case8(void **state)
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
-	spdm_context->local_context.peer_cert_chain_provision =
+	spdm_context->local_context->peer_cert_chain_provision =
 		m_local_certificate_chain;
-	spdm_context->local_context.peer_cert_chain_provision_size =
+	spdm_context->local_context->peer_cert_chain_provision_size =
 		MAX_SPDM_MESSAGE_BUFFER_SIZE;
 	set_mem(m_local_certificate_chain, MAX_SPDM_MESSAGE_BUFFER_SIZE,
 		(uint8)(0xFF));
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	spdm_context->transcript.message_b.buffer_size = 0;
+#else
+	spdm_reset_message_b(spdm_context);
+#endif
 
 	zero_mem(total_digest_buffer, sizeof(total_digest_buffer));
 	status =
@@ -963,24 +1009,30 @@ void test_spdm_requester_get_digests_case9(void **state)
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
-	spdm_context->local_context.peer_cert_chain_provision =
+	spdm_context->local_context->peer_cert_chain_provision =
 		m_local_certificate_chain;
-	spdm_context->local_context.peer_cert_chain_provision_size =
+	spdm_context->local_context->peer_cert_chain_provision_size =
 		MAX_SPDM_MESSAGE_BUFFER_SIZE;
 	set_mem(m_local_certificate_chain, MAX_SPDM_MESSAGE_BUFFER_SIZE,
 		(uint8)(0xFF));
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	spdm_context->transcript.message_b.buffer_size = 0;
+#else
+	spdm_reset_message_b(spdm_context);
+#endif
 
 	zero_mem(total_digest_buffer, sizeof(total_digest_buffer));
 	status =
 		spdm_get_digest(spdm_context, &slot_mask, &total_digest_buffer);
 	assert_int_equal(status, RETURN_SUCCESS);
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	assert_int_equal(
 		spdm_context->transcript.message_b.buffer_size,
 		sizeof(spdm_get_digest_request_t) +
 			sizeof(spdm_digest_response_t) +
 			spdm_get_hash_size(spdm_context->connection_info
 						   .algorithm.base_hash_algo));
+#endif
 }
 
 /**
@@ -1004,19 +1056,25 @@ void test_spdm_requester_get_digests_case10(void **state)
 	spdm_context->connection_info.capability.flags = 0;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
-	spdm_context->local_context.peer_cert_chain_provision =
+	spdm_context->local_context->peer_cert_chain_provision =
 		m_local_certificate_chain;
-	spdm_context->local_context.peer_cert_chain_provision_size =
+	spdm_context->local_context->peer_cert_chain_provision_size =
 		MAX_SPDM_MESSAGE_BUFFER_SIZE;
 	set_mem(m_local_certificate_chain, MAX_SPDM_MESSAGE_BUFFER_SIZE,
 		(uint8)(0xFF));
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	spdm_context->transcript.message_b.buffer_size = 0;
+#else
+	spdm_reset_message_b(spdm_context);
+#endif
 
 	zero_mem(total_digest_buffer, sizeof(total_digest_buffer));
 	status =
 		spdm_get_digest(spdm_context, &slot_mask, &total_digest_buffer);
 	assert_int_equal(status, RETURN_UNSUPPORTED);
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	assert_int_equal(spdm_context->transcript.message_b.buffer_size, 0);
+#endif
 }
 
 /**
@@ -1040,20 +1098,26 @@ void test_spdm_requester_get_digests_case11(void **state)
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
-	spdm_context->local_context.peer_cert_chain_provision =
+	spdm_context->local_context->peer_cert_chain_provision =
 		m_local_certificate_chain;
-	spdm_context->local_context.peer_cert_chain_provision_size =
+	spdm_context->local_context->peer_cert_chain_provision_size =
 		MAX_SPDM_MESSAGE_BUFFER_SIZE;
 	set_mem(m_local_certificate_chain, MAX_SPDM_MESSAGE_BUFFER_SIZE,
 		(uint8)(0xFF));
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	spdm_context->transcript.message_b.buffer_size = 0;
+#else
+	spdm_reset_message_b(spdm_context);
+#endif
 
 	zero_mem(total_digest_buffer, sizeof(total_digest_buffer));
 	status =
 		spdm_get_digest(spdm_context, &slot_mask, &total_digest_buffer);
 	assert_int_equal(status, RETURN_DEVICE_ERROR);
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	assert_int_equal(spdm_context->transcript.message_b.buffer_size,
 			 0);
+#endif
 }
 
 /**
@@ -1078,20 +1142,26 @@ void test_spdm_requester_get_digests_case12(void **state)
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
-	spdm_context->local_context.peer_cert_chain_provision =
+	spdm_context->local_context->peer_cert_chain_provision =
 		m_local_certificate_chain;
-	spdm_context->local_context.peer_cert_chain_provision_size =
+	spdm_context->local_context->peer_cert_chain_provision_size =
 		MAX_SPDM_MESSAGE_BUFFER_SIZE;
 	set_mem(m_local_certificate_chain, MAX_SPDM_MESSAGE_BUFFER_SIZE,
 		(uint8)(0xFF));
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	spdm_context->transcript.message_b.buffer_size = 0;
+#else
+	spdm_reset_message_b(spdm_context);
+#endif
 
 	zero_mem(total_digest_buffer, sizeof(total_digest_buffer));
 	status =
 		spdm_get_digest(spdm_context, &slot_mask, &total_digest_buffer);
 	assert_int_equal(status, RETURN_DEVICE_ERROR);
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	assert_int_equal(spdm_context->transcript.message_b.buffer_size,
 			 sizeof(spdm_get_digest_request_t));
+#endif
 }
 
 /**
@@ -1115,20 +1185,26 @@ void test_spdm_requester_get_digests_case13(void **state)
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
-	spdm_context->local_context.peer_cert_chain_provision =
+	spdm_context->local_context->peer_cert_chain_provision =
 		m_local_certificate_chain;
-	spdm_context->local_context.peer_cert_chain_provision_size =
+	spdm_context->local_context->peer_cert_chain_provision_size =
 		MAX_SPDM_MESSAGE_BUFFER_SIZE;
 	set_mem(m_local_certificate_chain, MAX_SPDM_MESSAGE_BUFFER_SIZE,
 		(uint8)(0xFF));
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	spdm_context->transcript.message_b.buffer_size = 0;
+#else
+	spdm_reset_message_b(spdm_context);
+#endif
 
 	zero_mem(total_digest_buffer, sizeof(total_digest_buffer));
 	status =
 		spdm_get_digest(spdm_context, &slot_mask, &total_digest_buffer);
 	assert_int_equal(status, RETURN_DEVICE_ERROR);
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	assert_int_equal(spdm_context->transcript.message_b.buffer_size,
 			 0);
+#endif
 }
 
 /**
@@ -1152,20 +1228,26 @@ void test_spdm_requester_get_digests_case14(void **state)
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
-	spdm_context->local_context.peer_cert_chain_provision =
+	spdm_context->local_context->peer_cert_chain_provision =
 		m_local_certificate_chain;
-	spdm_context->local_context.peer_cert_chain_provision_size =
+	spdm_context->local_context->peer_cert_chain_provision_size =
 		MAX_SPDM_MESSAGE_BUFFER_SIZE;
 	set_mem(m_local_certificate_chain, MAX_SPDM_MESSAGE_BUFFER_SIZE,
 		(uint8)(0xFF));
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	spdm_context->transcript.message_b.buffer_size = 0;
+#else
+	spdm_reset_message_b(spdm_context);
+#endif
 
 	zero_mem(total_digest_buffer, sizeof(total_digest_buffer));
 	status =
 		spdm_get_digest(spdm_context, &slot_mask, &total_digest_buffer);
 	assert_int_equal(status, RETURN_DEVICE_ERROR);
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	assert_int_equal(spdm_context->transcript.message_b.buffer_size,
 			 0);
+#endif
 }
 
 /**
@@ -1190,14 +1272,16 @@ void test_spdm_requester_get_digests_case15(void **state)
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
-	spdm_context->local_context.peer_cert_chain_provision =
+	spdm_context->local_context->peer_cert_chain_provision =
 		m_local_certificate_chain;
-	spdm_context->local_context.peer_cert_chain_provision_size =
+	spdm_context->local_context->peer_cert_chain_provision_size =
 		MAX_SPDM_MESSAGE_BUFFER_SIZE;
 	set_mem(m_local_certificate_chain, MAX_SPDM_MESSAGE_BUFFER_SIZE,
 		(uint8)(0xFF));
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	spdm_context->transcript.message_b.buffer_size =
 		spdm_context->transcript.message_b.max_buffer_size;
+#endif
 
 	zero_mem(total_digest_buffer, sizeof(total_digest_buffer));
 	status =
@@ -1226,20 +1310,30 @@ void test_spdm_requester_get_digests_case16(void **state)
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
-	spdm_context->local_context.peer_cert_chain_provision =
+	spdm_context->local_context->peer_cert_chain_provision =
 		m_local_certificate_chain;
-	spdm_context->local_context.peer_cert_chain_provision_size =
+	spdm_context->local_context->peer_cert_chain_provision_size =
 		MAX_SPDM_MESSAGE_BUFFER_SIZE;
 	set_mem(m_local_certificate_chain, MAX_SPDM_MESSAGE_BUFFER_SIZE,
 		(uint8)(0xFF));
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	spdm_context->transcript.message_b.buffer_size =
 		spdm_context->transcript.message_b.max_buffer_size -
 		(sizeof(spdm_digest_response_t));
+#endif
 
 	zero_mem(total_digest_buffer, sizeof(total_digest_buffer));
 	status =
 		spdm_get_digest(spdm_context, &slot_mask, &total_digest_buffer);
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	assert_int_equal(status, RETURN_SECURITY_VIOLATION);
+#else
+	//
+	// Without the transcript buffer the digest is hashed on the fly, so
+	// there is no cache to overflow.
+	//
+	assert_int_equal(status, RETURN_SUCCESS);
+#endif
 }
 
 /**
@@ -1263,13 +1357,17 @@ void test_spdm_requester_get_digests_case17(void **state)
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
-	spdm_context->local_context.peer_cert_chain_provision =
+	spdm_context->local_context->peer_cert_chain_provision =
 		m_local_certificate_chain;
-	spdm_context->local_context.peer_cert_chain_provision_size =
+	spdm_context->local_context->peer_cert_chain_provision_size =
 		MAX_SPDM_MESSAGE_BUFFER_SIZE;
 	set_mem(m_local_certificate_chain, MAX_SPDM_MESSAGE_BUFFER_SIZE,
 		(uint8)(0xFF));
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	spdm_context->transcript.message_b.buffer_size = 0;
+#else
+	spdm_reset_message_b(spdm_context);
+#endif
 
 	zero_mem(total_digest_buffer, sizeof(total_digest_buffer));
 	status =
@@ -1301,20 +1399,26 @@ void test_spdm_requester_get_digests_case18(void **state)
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
-	spdm_context->local_context.peer_cert_chain_provision =
+	spdm_context->local_context->peer_cert_chain_provision =
 		m_local_certificate_chain;
-	spdm_context->local_context.peer_cert_chain_provision_size =
+	spdm_context->local_context->peer_cert_chain_provision_size =
 		MAX_SPDM_MESSAGE_BUFFER_SIZE;
 	set_mem(m_local_certificate_chain, MAX_SPDM_MESSAGE_BUFFER_SIZE,
 		(uint8)(0xFF));
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	spdm_context->transcript.message_b.buffer_size = 0;
+#else
+	spdm_reset_message_b(spdm_context);
+#endif
 
 	zero_mem(total_digest_buffer, sizeof(total_digest_buffer));
 	status =
 		spdm_get_digest(spdm_context, &slot_mask, &total_digest_buffer);
 	assert_int_equal(status, RETURN_DEVICE_ERROR);
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	assert_int_equal(spdm_context->transcript.message_b.buffer_size,
 			 0);
+#endif
 }
 
 /**
@@ -1338,13 +1442,17 @@ void test_spdm_requester_get_digests_case19(void **state)
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
-	spdm_context->local_context.peer_cert_chain_provision =
+	spdm_context->local_context->peer_cert_chain_provision =
 		m_local_certificate_chain;
-	spdm_context->local_context.peer_cert_chain_provision_size =
+	spdm_context->local_context->peer_cert_chain_provision_size =
 		MAX_SPDM_MESSAGE_BUFFER_SIZE;
 	set_mem(m_local_certificate_chain, MAX_SPDM_MESSAGE_BUFFER_SIZE,
 		(uint8)(0xFF));
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	spdm_context->transcript.message_b.buffer_size = 0;
+#else
+	spdm_reset_message_b(spdm_context);
+#endif
 
 	zero_mem(total_digest_buffer, sizeof(total_digest_buffer));
 	status =
@@ -1376,20 +1484,26 @@ void test_spdm_requester_get_digests_case20(void **state)
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
-	spdm_context->local_context.peer_cert_chain_provision =
+	spdm_context->local_context->peer_cert_chain_provision =
 		m_local_certificate_chain;
-	spdm_context->local_context.peer_cert_chain_provision_size =
+	spdm_context->local_context->peer_cert_chain_provision_size =
 		MAX_SPDM_MESSAGE_BUFFER_SIZE;
 	set_mem(m_local_certificate_chain, MAX_SPDM_MESSAGE_BUFFER_SIZE,
 		(uint8)(0xFF));
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	spdm_context->transcript.message_b.buffer_size = 0;
+#else
+	spdm_reset_message_b(spdm_context);
+#endif
 
 	zero_mem(total_digest_buffer, sizeof(total_digest_buffer));
 	status =
 		spdm_get_digest(spdm_context, &slot_mask, &total_digest_buffer);
 	assert_int_equal(status, RETURN_DEVICE_ERROR);
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	assert_int_equal(spdm_context->transcript.message_b.buffer_size,
 			 sizeof(spdm_get_digest_request_t));
+#endif
 }
 
 /**
@@ -1414,20 +1528,26 @@ void test_spdm_requester_get_digests_case21(void **state)
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
-	spdm_context->local_context.peer_cert_chain_provision =
+	spdm_context->local_context->peer_cert_chain_provision =
 		m_local_certificate_chain;
-	spdm_context->local_context.peer_cert_chain_provision_size =
+	spdm_context->local_context->peer_cert_chain_provision_size =
 		MAX_SPDM_MESSAGE_BUFFER_SIZE;
 	set_mem(m_local_certificate_chain, MAX_SPDM_MESSAGE_BUFFER_SIZE,
 		(uint8)(0xFF));
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	spdm_context->transcript.message_b.buffer_size = 0;
+#else
+	spdm_reset_message_b(spdm_context);
+#endif
 
 	zero_mem(total_digest_buffer, sizeof(total_digest_buffer));
 	status =
 		spdm_get_digest(spdm_context, &slot_mask, &total_digest_buffer);
 	assert_int_equal(status, RETURN_DEVICE_ERROR);
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	assert_int_equal(spdm_context->transcript.message_b.buffer_size,
 			 sizeof(spdm_get_digest_request_t));
+#endif
 }
 
 /**
@@ -1451,21 +1571,29 @@ void test_spdm_requester_get_digests_case22(void **state) {
   spdm_test_context->case_id = 0x16;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
   spdm_context->connection_info.algorithm.base_hash_algo = m_use_hash_algo;
-  spdm_context->local_context.peer_cert_chain_provision = m_local_certificate_chain;
-  spdm_context->local_context.peer_cert_chain_provision_size = MAX_SPDM_MESSAGE_BUFFER_SIZE;
+  spdm_context->local_context->peer_cert_chain_provision = m_local_certificate_chain;
+  spdm_context->local_context->peer_cert_chain_provision_size = MAX_SPDM_MESSAGE_BUFFER_SIZE;
   set_mem (m_local_certificate_chain, MAX_SPDM_MESSAGE_BUFFER_SIZE, (uint8)(0xFF));
 
   error_code = SPDM_ERROR_CODE_RESERVED_00;
   while(error_code <= 0xff) {
     spdm_context->connection_info.connection_state = SPDM_CONNECTION_STATE_NEGOTIATED;
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
     spdm_context->transcript.message_b.buffer_size = 0;
+#else
+    spdm_reset_message_b(spdm_context);
+#endif
     
     zero_mem (total_digest_buffer, sizeof(total_digest_buffer));
     status = spdm_get_digest (spdm_context, &slot_mask, &total_digest_buffer);
     // assert_int_equal (status, RETURN_DEVICE_ERROR);
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
     // assert_int_equal (spdm_context->transcript.message_b.buffer_size, 0);
+#endif
     ASSERT_INT_EQUAL_CASE (status, RETURN_DEVICE_ERROR, error_code);
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
     ASSERT_INT_EQUAL_CASE (spdm_context->transcript.message_b.buffer_size, 0, error_code);
+#endif
 
     error_code++;
     if(error_code == SPDM_ERROR_CODE_BUSY) { //busy is treated in cases 5 and 6
@@ -488,11 +488,11 @@ void test_spdm_requester_heartbeat_case1(void **state)
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_ENCRYPT_CAP;
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MAC_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_HBEAT_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP;
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data,
@@ -513,9 +513,9 @@ void test_spdm_requester_heartbeat_case1(void **state)
 	zero_mem(m_local_psk_hint, 32);
 	copy_mem(&m_local_psk_hint[0], TEST_PSK_HINT_STRING,
 		 sizeof(TEST_PSK_HINT_STRING));
-	spdm_context->local_context.psk_hint_size =
+	spdm_context->local_context->psk_hint_size =
 		sizeof(TEST_PSK_HINT_STRING);
-	spdm_context->local_context.psk_hint = m_local_psk_hint;
+	spdm_context->local_context->psk_hint = m_local_psk_hint;
 
 	session_id = 0xFFFFFFFF;
 	session_info = &spdm_context->session_info[0];
@@ -552,11 +552,11 @@ void test_spdm_requester_heartbeat_case2(void **state)
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_ENCRYPT_CAP;
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MAC_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_HBEAT_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP;
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data,
@@ -577,9 +577,9 @@ void test_spdm_requester_heartbeat_case2(void **state)
 	zero_mem(m_local_psk_hint, 32);
 	copy_mem(&m_local_psk_hint[0], TEST_PSK_HINT_STRING,
 		 sizeof(TEST_PSK_HINT_STRING));
-	spdm_context->local_context.psk_hint_size =
+	spdm_context->local_context->psk_hint_size =
 		sizeof(TEST_PSK_HINT_STRING);
-	spdm_context->local_context.psk_hint = m_local_psk_hint;
+	spdm_context->local_context->psk_hint = m_local_psk_hint;
 
 	session_id = 0xFFFFFFFF;
 	session_info = &spdm_context->session_info[0];
@@ -639,11 +639,11 @@ void test_spdm_requester_heartbeat_case3(void **state)
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_ENCRYPT_CAP;
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MAC_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_HBEAT_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP;
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data,
@@ -664,9 +664,9 @@ void test_spdm_requester_heartbeat_case3(void **state)
 	zero_mem(m_local_psk_hint, 32);
 	copy_mem(&m_local_psk_hint[0], TEST_PSK_HINT_STRING,
 		 sizeof(TEST_PSK_HINT_STRING));
-	spdm_context->local_context.psk_hint_size =
+	spdm_context->local_context->psk_hint_size =
 		sizeof(TEST_PSK_HINT_STRING);
-	spdm_context->local_context.psk_hint = m_local_psk_hint;
+	spdm_context->local_context->psk_hint = m_local_psk_hint;
 
 	session_id = 0xFFFFFFFF;
 	session_info = &spdm_context->session_info[0];
@@ -726,11 +726,11 @@ void test_spdm_requester_heartbeat_case4(void **state)
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_ENCRYPT_CAP;
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MAC_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_HBEAT_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP;
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data,
@@ -751,9 +751,9 @@ void test_spdm_requester_heartbeat_case4(void **state)
 	zero_mem(m_local_psk_hint, 32);
 	copy_mem(&m_local_psk_hint[0], TEST_PSK_HINT_STRING,
 		 sizeof(TEST_PSK_HINT_STRING));
-	spdm_context->local_context.psk_hint_size =
+	spdm_context->local_context->psk_hint_size =
 		sizeof(TEST_PSK_HINT_STRING);
-	spdm_context->local_context.psk_hint = m_local_psk_hint;
+	spdm_context->local_context->psk_hint = m_local_psk_hint;
 
 	session_id = 0xFFFFFFFF;
 	session_info = &spdm_context->session_info[0];
@@ -813,11 +813,11 @@ void test_spdm_requester_heartbeat_case5(void **state)
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_ENCRYPT_CAP;
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MAC_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_HBEAT_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP;
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data,
@@ -838,9 +838,9 @@ void test_spdm_requester_heartbeat_case5(void **state)
 	zero_mem(m_local_psk_hint, 32);
 	copy_mem(&m_local_psk_hint[0], TEST_PSK_HINT_STRING,
 		 sizeof(TEST_PSK_HINT_STRING));
-	spdm_context->local_context.psk_hint_size =
+	spdm_context->local_context->psk_hint_size =
 		sizeof(TEST_PSK_HINT_STRING);
-	spdm_context->local_context.psk_hint = m_local_psk_hint;
+	spdm_context->local_context->psk_hint = m_local_psk_hint;
 
 	session_id = 0xFFFFFFFF;
 	session_info = &spdm_context->session_info[0];
@@ -900,11 +900,11 @@ void test_spdm_requester_heartbeat_case6(void **state)
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_ENCRYPT_CAP;
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MAC_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_HBEAT_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP;
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data,
@@ -925,9 +925,9 @@ void test_spdm_requester_heartbeat_case6(void **state)
 	zero_mem(m_local_psk_hint, 32);
 	copy_mem(&m_local_psk_hint[0], TEST_PSK_HINT_STRING,
 		 sizeof(TEST_PSK_HINT_STRING));
-	spdm_context->local_context.psk_hint_size =
+	spdm_context->local_context->psk_hint_size =
 		sizeof(TEST_PSK_HINT_STRING);
-	spdm_context->local_context.psk_hint = m_local_psk_hint;
+	spdm_context->local_context->psk_hint = m_local_psk_hint;
 
 	session_id = 0xFFFFFFFF;
 	session_info = &spdm_context->session_info[0];
@@ -987,11 +987,11 @@ void test_spdm_requester_heartbeat_case7(void **state)
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_ENCRYPT_CAP;
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MAC_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_HBEAT_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP;
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data,
@@ -1012,9 +1012,9 @@ void test_spdm_requester_heartbeat_case7(void **state)
 	zero_mem(m_local_psk_hint, 32);
 	copy_mem(&m_local_psk_hint[0], TEST_PSK_HINT_STRING,
 		 sizeof(TEST_PSK_HINT_STRING));
-	spdm_context->local_context.psk_hint_size =
+	spdm_context->local_context->psk_hint_size =
 		sizeof(TEST_PSK_HINT_STRING);
-	spdm_context->local_context.psk_hint = m_local_psk_hint;
+	spdm_context->local_context->psk_hint = m_local_psk_hint;
 
 	session_id = 0xFFFFFFFF;
 	session_info = &spdm_context->session_info[0];
@@ -1076,11 +1076,11 @@ void test_spdm_requester_heartbeat_case8(void **state)
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_ENCRYPT_CAP;
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MAC_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_HBEAT_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP;
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data,
@@ -1101,9 +1101,9 @@ void test_spdm_requester_heartbeat_case8(void **state)
 	zero_mem(m_local_psk_hint, 32);
 	copy_mem(&m_local_psk_hint[0], TEST_PSK_HINT_STRING,
 		 sizeof(TEST_PSK_HINT_STRING));
-	spdm_context->local_context.psk_hint_size =
+	spdm_context->local_context->psk_hint_size =
 		sizeof(TEST_PSK_HINT_STRING);
-	spdm_context->local_context.psk_hint = m_local_psk_hint;
+	spdm_context->local_context->psk_hint = m_local_psk_hint;
 
 	session_id = 0xFFFFFFFF;
 	session_info = &spdm_context->session_info[0];
@@ -1163,11 +1163,11 @@ void test_spdm_requester_heartbeat_case9(void **state)
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_ENCRYPT_CAP;
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MAC_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_HBEAT_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP;
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data,
@@ -1188,9 +1188,9 @@ void test_spdm_requester_heartbeat_case9(void **state)
 	zero_mem(m_local_psk_hint, 32);
 	copy_mem(&m_local_psk_hint[0], TEST_PSK_HINT_STRING,
 		 sizeof(TEST_PSK_HINT_STRING));
-	spdm_context->local_context.psk_hint_size =
+	spdm_context->local_context->psk_hint_size =
 		sizeof(TEST_PSK_HINT_STRING);
-	spdm_context->local_context.psk_hint = m_local_psk_hint;
+	spdm_context->local_context->psk_hint = m_local_psk_hint;
 
 	session_id = 0xFFFFFFFF;
 	session_info = &spdm_context->session_info[0];
@@ -1245,9 +1245,9 @@ void test_spdm_requester_heartbeat_case10(void **state) {
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_HBEAT_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_ENCRYPT_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MAC_CAP;
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_HBEAT_CAP;
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP;
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_HBEAT_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP;
   read_responder_public_certificate_chain (m_use_hash_algo, m_use_asym_algo, &data, &data_size, &hash, &hash_size);
   spdm_context->connection_info.algorithm.base_hash_algo = m_use_hash_algo;
   spdm_context->connection_info.algorithm.base_asym_algo = m_use_asym_algo;
@@ -1257,8 +1257,8 @@ void test_spdm_requester_heartbeat_case10(void **state) {
   copy_mem (spdm_context->connection_info.peer_used_cert_chain_buffer, data, data_size);
   zero_mem (m_local_psk_hint, 32);
   copy_mem (&m_local_psk_hint[0], TEST_PSK_HINT_STRING, sizeof(TEST_PSK_HINT_STRING));
-  spdm_context->local_context.psk_hint_size = sizeof(TEST_PSK_HINT_STRING);
-  spdm_context->local_context.psk_hint = m_local_psk_hint;
+  spdm_context->local_context->psk_hint_size = sizeof(TEST_PSK_HINT_STRING);
+  spdm_context->local_context->psk_hint = m_local_psk_hint;
 
   error_code = SPDM_ERROR_CODE_RESERVED_00;
   while(error_code <= 0xff) {
@@ -1317,11 +1317,11 @@ void test_spdm_requester_heartbeat_case11(void **state)
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_ENCRYPT_CAP;
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MAC_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_HBEAT_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP;
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data,
@@ -1342,9 +1342,9 @@ void test_spdm_requester_heartbeat_case11(void **state)
 	zero_mem(m_local_psk_hint, 32);
 	copy_mem(&m_local_psk_hint[0], TEST_PSK_HINT_STRING,
 		 sizeof(TEST_PSK_HINT_STRING));
-	spdm_context->local_context.psk_hint_size =
+	spdm_context->local_context->psk_hint_size =
 		sizeof(TEST_PSK_HINT_STRING);
-	spdm_context->local_context.psk_hint = m_local_psk_hint;
+	spdm_context->local_context->psk_hint = m_local_psk_hint;
 
 	session_id = 0xFFFFFFFF;
 	session_info = &spdm_context->session_info[0];
@@ -1377,6 +1377,7 @@ void test_spdm_requester_heartbeat_case11(void **state)
 		->application_secret.response_data_sequence_number = 0;
 	spdm_context->transcript.message_m.buffer_size =
 		spdm_context->transcript.message_m.max_buffer_size;
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	spdm_context->transcript.message_b.buffer_size =
 							spdm_context->transcript.message_b.max_buffer_size;
 	spdm_context->transcript.message_c.buffer_size =
@@ -1385,14 +1386,17 @@ void test_spdm_requester_heartbeat_case11(void **state)
 							spdm_context->transcript.message_mut_b.max_buffer_size;
 	spdm_context->transcript.message_mut_c.buffer_size =
 							spdm_context->transcript.message_mut_c.max_buffer_size;
+#endif
 
 	status = spdm_heartbeat(spdm_context, session_id);
 	assert_int_equal(status, RETURN_SUCCESS);
 	assert_int_equal(spdm_context->transcript.message_m.buffer_size, 0);
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	assert_int_equal(spdm_context->transcript.message_b.buffer_size, 0);
 	assert_int_equal(spdm_context->transcript.message_c.buffer_size, 0);
 	assert_int_equal(spdm_context->transcript.message_mut_b.buffer_size, 0);
 	assert_int_equal(spdm_context->transcript.message_mut_c.buffer_size, 0);
+#endif
 	free(data);
 }
 
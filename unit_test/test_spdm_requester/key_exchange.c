@@ -72,6 +72,8 @@ return_status spdm_requester_key_exchange_test_send_message(
 	case 0x1:
 		return RETURN_DEVICE_ERROR;
 	case 0x2:
+	case 0xC:
+	case 0xD:
 		m_local_buffer_size = 0;
 		message_size = spdm_test_get_key_exchange_request_size(
 			spdm_context, (uint8 *)request + header_size,
@@ -182,7 +184,9 @@ return_status spdm_requester_key_exchange_test_receive_message(
 	case 0x1:
 		return RETURN_DEVICE_ERROR;
 
-	case 0x2: {
+	case 0x2:
+	case 0xC:
+	case 0xD: {
 		spdm_key_exchange_response_t *spdm_response;
 		uintn dhe_key_size;
 		uint32 hash_size;
@@ -1189,7 +1193,7 @@ void test_spdm_requester_key_exchange_case2(void **state)
 		SPDM_CONNECTION_STATE_NEGOTIATED;
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_KEY_EX_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data,
@@ -1245,7 +1249,7 @@ void test_spdm_requester_key_exchange_case3(void **state)
 		SPDM_CONNECTION_STATE_NOT_STARTED;
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_KEY_EX_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data,
@@ -1296,7 +1300,7 @@ void test_spdm_requester_key_exchange_case4(void **state)
 		SPDM_CONNECTION_STATE_NEGOTIATED;
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_KEY_EX_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data,
@@ -1347,7 +1351,7 @@ void test_spdm_requester_key_exchange_case5(void **state)
 		SPDM_CONNECTION_STATE_NEGOTIATED;
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_KEY_EX_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data,
@@ -1398,7 +1402,7 @@ void test_spdm_requester_key_exchange_case6(void **state)
 		SPDM_CONNECTION_STATE_NEGOTIATED;
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_KEY_EX_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data,
@@ -1454,7 +1458,7 @@ void test_spdm_requester_key_exchange_case7(void **state)
 		SPDM_CONNECTION_STATE_NEGOTIATED;
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_KEY_EX_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data,
@@ -1507,7 +1511,7 @@ void test_spdm_requester_key_exchange_case8(void **state)
 		SPDM_CONNECTION_STATE_NEGOTIATED;
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_KEY_EX_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data,
@@ -1558,7 +1562,7 @@ void test_spdm_requester_key_exchange_case9(void **state)
 		SPDM_CONNECTION_STATE_NEGOTIATED;
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_KEY_EX_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data,
@@ -1611,7 +1615,7 @@ void test_spdm_requester_key_exchange_case10(void **state) {
   spdm_context = spdm_test_context->spdm_context;
   spdm_test_context->case_id = 0xA;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_KEY_EX_CAP;
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
   read_responder_public_certificate_chain (m_use_hash_algo, m_use_asym_algo, &data, &data_size, &hash, &hash_size);
   spdm_context->connection_info.algorithm.base_hash_algo = m_use_hash_algo;
   spdm_context->connection_info.algorithm.base_asym_algo = m_use_asym_algo;
@@ -1668,7 +1672,7 @@ void test_spdm_requester_key_exchange_case11(void **state)
 		SPDM_CONNECTION_STATE_NEGOTIATED;
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_KEY_EX_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data,
@@ -1686,6 +1690,7 @@ void test_spdm_requester_key_exchange_case11(void **state)
 		data_size;
 	spdm_context->transcript.message_m.buffer_size =
 							spdm_context->transcript.message_m.max_buffer_size;
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	spdm_context->transcript.message_b.buffer_size =
 							spdm_context->transcript.message_b.max_buffer_size;
 	spdm_context->transcript.message_c.buffer_size =
@@ -1694,6 +1699,7 @@ void test_spdm_requester_key_exchange_case11(void **state)
 							spdm_context->transcript.message_mut_b.max_buffer_size;
 	spdm_context->transcript.message_mut_c.buffer_size =
 							spdm_context->transcript.message_mut_c.max_buffer_size;
+#endif
 
 	copy_mem(spdm_context->connection_info.peer_used_cert_chain_buffer,
 		 data, data_size);
@@ -1711,12 +1717,273 @@ void test_spdm_requester_key_exchange_case11(void **state)
 			spdm_context->session_info[0].secured_message_context),
 		SPDM_SESSION_STATE_HANDSHAKING);
 	assert_int_equal(spdm_context->transcript.message_m.buffer_size, 0);
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	assert_int_equal(spdm_context->transcript.message_b.buffer_size, 0);
 	assert_int_equal(spdm_context->transcript.message_c.buffer_size, 0);
 	assert_int_equal(spdm_context->transcript.message_mut_b.buffer_size, 0);
 	assert_int_equal(spdm_context->transcript.message_mut_c.buffer_size, 0);
+#endif
+	free(data);
+}
+
+/**
+  Test 12: successful KEY_EXCHANGE, then TH2 with message F
+  Expected Behavior: the session keeps a TH hash context after TH1, and TH2 finalized
+  from it matches the hash of Concatenate (A, H(Ct), K, F).
+**/
+void test_spdm_requester_key_exchange_case12(void **state)
+{
+	return_status status;
+	spdm_test_context_t *spdm_test_context;
+	spdm_context_t *spdm_context;
+	spdm_session_info_t *session_info;
+	uint32 session_id;
+	uint8 heartbeat_period;
+	uint8 measurement_hash[MAX_HASH_SIZE];
+	uint8 slot_id_param;
+	void *data;
+	uintn data_size;
+	void *hash;
+	uintn hash_size;
+	uint8 *cert_chain_data;
+	uintn cert_chain_data_size;
+	uint8 message_f[] = { 0x11, 0xE5, 0x00, 0x00, 0xf0, 0xf1, 0xf2, 0xf3 };
+	uint8 th_data[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+	uintn th_data_size;
+	uint8 expected_th2_hash[MAX_HASH_SIZE];
+	uint8 th2_hash[MAX_HASH_SIZE];
+	uintn index;
+
+	spdm_test_context = *state;
+	spdm_context = spdm_test_context->spdm_context;
+	spdm_test_context->case_id = 0xC;
+	spdm_context->connection_info.connection_state =
+		SPDM_CONNECTION_STATE_NEGOTIATED;
+	spdm_context->connection_info.capability.flags |=
+		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_KEY_EX_CAP;
+	spdm_context->local_context->capability.flags |=
+		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
+	read_responder_public_certificate_chain(m_use_hash_algo,
+						m_use_asym_algo, &data,
+						&data_size, &hash, &hash_size);
+	spdm_context->transcript.message_a.buffer_size = 0;
+	spdm_context->connection_info.algorithm.base_hash_algo =
+		m_use_hash_algo;
+	spdm_context->connection_info.algorithm.base_asym_algo =
+		m_use_asym_algo;
+	spdm_context->connection_info.algorithm.dhe_named_group =
+		m_use_dhe_algo;
+	spdm_context->connection_info.algorithm.aead_cipher_suite =
+		m_use_aead_algo;
+	spdm_context->connection_info.peer_used_cert_chain_buffer_size =
+		data_size;
+	copy_mem(spdm_context->connection_info.peer_used_cert_chain_buffer,
+		 data, data_size);
+
+	//
+	// Release the sessions left by the previous cases.
+	//
+	for (index = 0; index < spdm_context->max_session_count; index++) {
+		if (spdm_context->session_info[index].session_id !=
+		    INVALID_SESSION_ID) {
+			spdm_free_session_id(
+				spdm_context,
+				spdm_context->session_info[index].session_id);
+		}
+	}
+
+	heartbeat_period = 0;
+	zero_mem(measurement_hash, sizeof(measurement_hash));
+	status = spdm_send_receive_key_exchange(
+		spdm_context,
+		SPDM_CHALLENGE_REQUEST_NO_MEASUREMENT_SUMMARY_HASH, 0,
+		&session_id, &heartbeat_period, &slot_id_param,
+		measurement_hash);
+	assert_int_equal(status, RETURN_SUCCESS);
+	session_info =
+		spdm_get_session_info_via_session_id(spdm_context, session_id);
+	assert_non_null(session_info);
+	assert_non_null(session_info->session_transcript.digest_context_th);
+
+	status = spdm_append_message_f(session_info, message_f,
+				       sizeof(message_f));
+	assert_int_equal(status, RETURN_SUCCESS);
+	status = spdm_calculate_th2_hash(spdm_context, session_info, TRUE,
+					 th2_hash);
+	assert_int_equal(status, RETURN_SUCCESS);
+
+	assert_true(spdm_get_peer_cert_chain_data(spdm_context,
+						  (void **)&cert_chain_data,
+						  &cert_chain_data_size));
+	th_data_size = 0;
+	copy_mem(th_data, get_managed_buffer(&spdm_context->transcript.message_a),
+		 get_managed_buffer_size(&spdm_context->transcript.message_a));
+	th_data_size += get_managed_buffer_size(&spdm_context->transcript.message_a);
+	spdm_hash_all(m_use_hash_algo, cert_chain_data, cert_chain_data_size,
+		      th_data + th_data_size);
+	th_data_size += spdm_get_hash_size(m_use_hash_algo);
+	copy_mem(th_data + th_data_size,
+		 get_managed_buffer(&session_info->session_transcript.message_k),
+		 get_managed_buffer_size(
+			 &session_info->session_transcript.message_k));
+	th_data_size += get_managed_buffer_size(
+		&session_info->session_transcript.message_k);
+	copy_mem(th_data + th_data_size, message_f, sizeof(message_f));
+	th_data_size += sizeof(message_f);
+	spdm_hash_all(m_use_hash_algo, th_data, th_data_size,
+		      expected_th2_hash);
+	assert_memory_equal(th2_hash, expected_th2_hash,
+			    spdm_get_hash_size(m_use_hash_algo));
+	free(data);
+}
+
+/**
+  Test 13: successful KEY_EXCHANGE with a filled DHE key pool
+  Expected Behavior: the KEY_EXCHANGE request carries the public key of the first pooled
+  key pair of the negotiated DHE group, which is removed from the pool and refilled when
+  the handshake completes. Before negotiation, the pools of all local DHE groups are
+  filled, and spdm_deinit_context frees the pools of a context.
+**/
+#if MAX_SPDM_DHE_KEY_POOL_COUNT > 0
+void test_spdm_requester_key_exchange_case13(void **state)
+{
+	return_status status;
+	spdm_test_context_t *spdm_test_context;
+	spdm_context_t *spdm_context;
+	spdm_context_t *spdm_context2;
+	uint32 session_id;
+	uint8 heartbeat_period;
+	uint8 measurement_hash[MAX_HASH_SIZE];
+	uint8 slot_id_param;
+	void *data;
+	uintn data_size;
+	void *hash;
+	uintn hash_size;
+	uint8 public_key[MAX_DHE_KEY_SIZE];
+	uintn public_key_size;
+	uintn index;
+	spdm_dhe_key_pool_t *pool;
+	spdm_dhe_key_pool_t *other_pool;
+	uint16 local_dhe_named_group;
+
+	spdm_test_context = *state;
+	spdm_context = spdm_test_context->spdm_context;
+	spdm_test_context->case_id = 0xD;
+	spdm_context->connection_info.connection_state =
+		SPDM_CONNECTION_STATE_NEGOTIATED;
+	spdm_context->connection_info.capability.flags |=
+		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_KEY_EX_CAP;
+	spdm_context->local_context->capability.flags |=
+		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
+	read_responder_public_certificate_chain(m_use_hash_algo,
+						m_use_asym_algo, &data,
+						&data_size, &hash, &hash_size);
+	spdm_context->transcript.message_a.buffer_size = 0;
+	spdm_context->connection_info.algorithm.base_hash_algo =
+		m_use_hash_algo;
+	spdm_context->connection_info.algorithm.base_asym_algo =
+		m_use_asym_algo;
+	spdm_context->connection_info.algorithm.dhe_named_group =
+		m_use_dhe_algo;
+	spdm_context->connection_info.algorithm.aead_cipher_suite =
+		m_use_aead_algo;
+	spdm_context->connection_info.peer_used_cert_chain_buffer_size =
+		data_size;
+	copy_mem(spdm_context->connection_info.peer_used_cert_chain_buffer,
+		 data, data_size);
+
+	//
+	// Release the sessions left by the previous cases.
+	//
+	for (index = 0; index < spdm_context->max_session_count; index++) {
+		if (spdm_context->session_info[index].session_id !=
+		    INVALID_SESSION_ID) {
+			spdm_free_session_id(
+				spdm_context,
+				spdm_context->session_info[index].session_id);
+		}
+	}
+
+	pool = spdm_get_dhe_key_pool(spdm_context, m_use_dhe_algo);
+	assert_non_null(pool);
+	status = spdm_refill_dhe_key_pool(spdm_context);
+	assert_int_equal(status, RETURN_SUCCESS);
+	for (index = 0; index < MAX_SPDM_DHE_KEY_POOL_COUNT; index++) {
+		assert_non_null(pool->entry[index].dhe_context);
+	}
+	public_key_size = pool->entry[0].public_key_size;
+	copy_mem(public_key, pool->entry[0].public_key, public_key_size);
+
+	heartbeat_period = 0;
+	zero_mem(measurement_hash, sizeof(measurement_hash));
+	status = spdm_send_receive_key_exchange(
+		spdm_context,
+		SPDM_CHALLENGE_REQUEST_NO_MEASUREMENT_SUMMARY_HASH, 0,
+		&session_id, &heartbeat_period, &slot_id_param,
+		measurement_hash);
+	assert_int_equal(status, RETURN_SUCCESS);
+	assert_memory_equal(m_local_buffer +
+				    sizeof(spdm_key_exchange_request_t),
+			    public_key, public_key_size);
+	assert_null(pool->entry[0].dhe_context);
+	assert_int_equal(spdm_context->dhe_key_pool_used_group,
+			 m_use_dhe_algo);
+
+	//
+	// The handshake completion refills the consumed entry.
+	//
+	spdm_refill_used_dhe_key_pool(spdm_context);
+	assert_non_null(pool->entry[0].dhe_context);
+	assert_int_equal(spdm_context->dhe_key_pool_used_group, 0);
+
+	//
+	// Before negotiation, the pool of every local DHE group is filled.
+	//
+	other_pool = spdm_get_dhe_key_pool(
+		spdm_context, SPDM_ALGORITHMS_DHE_NAMED_GROUP_SECP_384_R1);
+	assert_non_null(other_pool);
+	assert_ptr_not_equal(other_pool, pool);
+	assert_null(other_pool->entry[0].dhe_context);
+	local_dhe_named_group =
+		spdm_context->local_context->algorithm.dhe_named_group;
+	spdm_context->local_context->algorithm.dhe_named_group =
+		m_use_dhe_algo | SPDM_ALGORITHMS_DHE_NAMED_GROUP_SECP_384_R1;
+	spdm_context->connection_info.algorithm.dhe_named_group = 0;
+	status = spdm_refill_dhe_key_pool(spdm_context);
+	assert_int_equal(status, RETURN_SUCCESS);
+	spdm_context->local_context->algorithm.dhe_named_group =
+		local_dhe_named_group;
+	for (index = 0; index < MAX_SPDM_DHE_KEY_POOL_COUNT; index++) {
+		assert_non_null(pool->entry[index].dhe_context);
+		assert_non_null(other_pool->entry[index].dhe_context);
+	}
+
+	spdm_free_dhe_key_pool(spdm_context);
+	for (index = 0; index < MAX_SPDM_DHE_KEY_POOL_COUNT; index++) {
+		assert_null(pool->entry[index].dhe_context);
+		assert_null(other_pool->entry[index].dhe_context);
+	}
+
+	//
+	// spdm_deinit_context frees the pool.
+	//
+	spdm_context2 = (void *)malloc(spdm_get_context_size());
+	assert_non_null(spdm_context2);
+	spdm_init_context(spdm_context2);
+	spdm_context2->connection_info.algorithm.dhe_named_group =
+		m_use_dhe_algo;
+	pool = spdm_get_dhe_key_pool(spdm_context2, m_use_dhe_algo);
+	status = spdm_refill_dhe_key_pool(spdm_context2);
+	assert_int_equal(status, RETURN_SUCCESS);
+	assert_non_null(pool->entry[0].dhe_context);
+	spdm_deinit_context(spdm_context2);
+	for (index = 0; index < MAX_SPDM_DHE_KEY_POOL_COUNT; index++) {
+		assert_null(pool->entry[index].dhe_context);
+	}
+	free(spdm_context2);
 	free(data);
 }
+#endif
 
 spdm_test_context_t m_spdm_requester_key_exchange_test_context = {
 	SPDM_TEST_CONTEXT_SIGNATURE,
@@ -1750,6 +2017,12 @@ int spdm_requester_key_exchange_test_main(void)
 		cmocka_unit_test(test_spdm_requester_key_exchange_case10),
 		// Buffer reset
 		cmocka_unit_test(test_spdm_requester_key_exchange_case11),
+		// TH2 from the TH1 hash context snapshot
+		cmocka_unit_test(test_spdm_requester_key_exchange_case12),
+#if MAX_SPDM_DHE_KEY_POOL_COUNT > 0
+		// DHE key pool
+		cmocka_unit_test(test_spdm_requester_key_exchange_case13),
+#endif
 
 	};
 
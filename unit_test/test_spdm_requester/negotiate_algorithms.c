@@ -960,10 +960,10 @@ void test_spdm_requester_negotiate_algorithms_case1(void **state)
 	spdm_test_context->case_id = 0x1;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AFTER_CAPABILITIES;
-	spdm_context->local_context.algorithm.measurement_hash_algo =
+	spdm_context->local_context->algorithm.measurement_hash_algo =
 		m_use_measurement_hash_algo;
-	spdm_context->local_context.algorithm.base_asym_algo = m_use_asym_algo;
-	spdm_context->local_context.algorithm.base_hash_algo = m_use_hash_algo;
+	spdm_context->local_context->algorithm.base_asym_algo = m_use_asym_algo;
+	spdm_context->local_context->algorithm.base_hash_algo = m_use_hash_algo;
 	spdm_context->transcript.message_a.buffer_size = 0;
 
 	status = spdm_negotiate_algorithms(spdm_context);
@@ -982,10 +982,10 @@ void test_spdm_requester_negotiate_algorithms_case2(void **state)
 	spdm_test_context->case_id = 0x2;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AFTER_CAPABILITIES;
-	spdm_context->local_context.algorithm.measurement_hash_algo =
+	spdm_context->local_context->algorithm.measurement_hash_algo =
 		m_use_measurement_hash_algo;
-	spdm_context->local_context.algorithm.base_asym_algo = m_use_asym_algo;
-	spdm_context->local_context.algorithm.base_hash_algo = m_use_hash_algo;
+	spdm_context->local_context->algorithm.base_asym_algo = m_use_asym_algo;
+	spdm_context->local_context->algorithm.base_hash_algo = m_use_hash_algo;
 	spdm_context->transcript.message_a.buffer_size = 0;
 
 	status = spdm_negotiate_algorithms(spdm_context);
@@ -1006,10 +1006,10 @@ void test_spdm_requester_negotiate_algorithms_case3(void **state)
 	spdm_test_context->case_id = 0x3;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_NOT_STARTED;
-	spdm_context->local_context.algorithm.measurement_hash_algo =
+	spdm_context->local_context->algorithm.measurement_hash_algo =
 		m_use_measurement_hash_algo;
-	spdm_context->local_context.algorithm.base_asym_algo = m_use_asym_algo;
-	spdm_context->local_context.algorithm.base_hash_algo = m_use_hash_algo;
+	spdm_context->local_context->algorithm.base_asym_algo = m_use_asym_algo;
+	spdm_context->local_context->algorithm.base_hash_algo = m_use_hash_algo;
 	spdm_context->transcript.message_a.buffer_size = 0;
 
 	status = spdm_negotiate_algorithms(spdm_context);
@@ -1028,10 +1028,10 @@ void test_spdm_requester_negotiate_algorithms_case4(void **state)
 	spdm_test_context->case_id = 0x4;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AFTER_CAPABILITIES;
-	spdm_context->local_context.algorithm.measurement_hash_algo =
+	spdm_context->local_context->algorithm.measurement_hash_algo =
 		m_use_measurement_hash_algo;
-	spdm_context->local_context.algorithm.base_asym_algo = m_use_asym_algo;
-	spdm_context->local_context.algorithm.base_hash_algo = m_use_hash_algo;
+	spdm_context->local_context->algorithm.base_asym_algo = m_use_asym_algo;
+	spdm_context->local_context->algorithm.base_hash_algo = m_use_hash_algo;
 	spdm_context->transcript.message_a.buffer_size = 0;
 
 	status = spdm_negotiate_algorithms(spdm_context);
@@ -1050,10 +1050,10 @@ void test_spdm_requester_negotiate_algorithms_case5(void **state)
 	spdm_test_context->case_id = 0x5;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AFTER_CAPABILITIES;
-	spdm_context->local_context.algorithm.measurement_hash_algo =
+	spdm_context->local_context->algorithm.measurement_hash_algo =
 		m_use_measurement_hash_algo;
-	spdm_context->local_context.algorithm.base_asym_algo = m_use_asym_algo;
-	spdm_context->local_context.algorithm.base_hash_algo = m_use_hash_algo;
+	spdm_context->local_context->algorithm.base_asym_algo = m_use_asym_algo;
+	spdm_context->local_context->algorithm.base_hash_algo = m_use_hash_algo;
 	spdm_context->transcript.message_a.buffer_size = 0;
 
 	status = spdm_negotiate_algorithms(spdm_context);
@@ -1072,10 +1072,10 @@ void test_spdm_requester_negotiate_algorithms_case6(void **state)
 	spdm_test_context->case_id = 0x6;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AFTER_CAPABILITIES;
-	spdm_context->local_context.algorithm.measurement_hash_algo =
+	spdm_context->local_context->algorithm.measurement_hash_algo =
 		m_use_measurement_hash_algo;
-	spdm_context->local_context.algorithm.base_asym_algo = m_use_asym_algo;
-	spdm_context->local_context.algorithm.base_hash_algo = m_use_hash_algo;
+	spdm_context->local_context->algorithm.base_asym_algo = m_use_asym_algo;
+	spdm_context->local_context->algorithm.base_hash_algo = m_use_hash_algo;
 	spdm_context->transcript.message_a.buffer_size = 0;
 
 	status = spdm_negotiate_algorithms(spdm_context);
@@ -1096,10 +1096,10 @@ void test_spdm_requester_negotiate_algorithms_case7(void **state)
 	spdm_test_context->case_id = 0x7;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AFTER_CAPABILITIES;
-	spdm_context->local_context.algorithm.measurement_hash_algo =
+	spdm_context->local_context->algorithm.measurement_hash_algo =
 		m_use_measurement_hash_algo;
-	spdm_context->local_context.algorithm.base_asym_algo = m_use_asym_algo;
-	spdm_context->local_context.algorithm.base_hash_algo = m_use_hash_algo;
+	spdm_context->local_context->algorithm.base_asym_algo = m_use_asym_algo;
+	spdm_context->local_context->algorithm.base_hash_algo = m_use_hash_algo;
 	spdm_context->transcript.message_a.buffer_size = 0;
 
 	status = spdm_negotiate_algorithms(spdm_context);
@@ -1120,10 +1120,10 @@ void test_spdm_requester_negotiate_algorithms_case8(void **state)
 	spdm_test_context->case_id = 0x8;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AFTER_CAPABILITIES;
-	spdm_context->local_context.algorithm.measurement_hash_algo =
+	spdm_context->local_context->algorithm.measurement_hash_algo =
 		m_use_measurement_hash_algo;
-	spdm_context->local_context.algorithm.base_asym_algo = m_use_asym_algo;
-	spdm_context->local_context.algorithm.base_hash_algo = m_use_hash_algo;
+	spdm_context->local_context->algorithm.base_asym_algo = m_use_asym_algo;
+	spdm_context->local_context->algorithm.base_hash_algo = m_use_hash_algo;
 	spdm_context->transcript.message_a.buffer_size = 0;
 
 	status = spdm_negotiate_algorithms(spdm_context);
@@ -1141,10 +1141,10 @@ void test_spdm_requester_negotiate_algorithms_case9(void **state)
 	spdm_test_context->case_id = 0x9;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AFTER_CAPABILITIES;
-	spdm_context->local_context.algorithm.measurement_hash_algo =
+	spdm_context->local_context->algorithm.measurement_hash_algo =
 		m_use_measurement_hash_algo;
-	spdm_context->local_context.algorithm.base_asym_algo = m_use_asym_algo;
-	spdm_context->local_context.algorithm.base_hash_algo = m_use_hash_algo;
+	spdm_context->local_context->algorithm.base_asym_algo = m_use_asym_algo;
+	spdm_context->local_context->algorithm.base_hash_algo = m_use_hash_algo;
 	spdm_context->transcript.message_a.buffer_size = 0;
 
 	status = spdm_negotiate_algorithms(spdm_context);
@@ -1163,10 +1163,10 @@ void test_spdm_requester_negotiate_algorithms_case10(void **state)
 	spdm_test_context->case_id = 0xA;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AFTER_CAPABILITIES;
-	spdm_context->local_context.algorithm.measurement_hash_algo =
+	spdm_context->local_context->algorithm.measurement_hash_algo =
 		m_use_measurement_hash_algo;
-	spdm_context->local_context.algorithm.base_asym_algo = m_use_asym_algo;
-	spdm_context->local_context.algorithm.base_hash_algo = m_use_hash_algo;
+	spdm_context->local_context->algorithm.base_asym_algo = m_use_asym_algo;
+	spdm_context->local_context->algorithm.base_hash_algo = m_use_hash_algo;
 	spdm_context->connection_info.algorithm.measurement_hash_algo = 0;
 	spdm_context->connection_info.algorithm.base_asym_algo = 0;
 	spdm_context->connection_info.algorithm.base_hash_algo = 0;
@@ -1192,16 +1192,16 @@ void test_spdm_requester_negotiate_algorithms_case11(void **state)
 	spdm_test_context->case_id = 0xB;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AFTER_CAPABILITIES;
-	spdm_context->local_context.algorithm.measurement_hash_algo =
+	spdm_context->local_context->algorithm.measurement_hash_algo =
 		m_use_measurement_hash_algo;
-	spdm_context->local_context.algorithm.base_asym_algo = m_use_asym_algo;
-	spdm_context->local_context.algorithm.base_hash_algo = m_use_hash_algo;
+	spdm_context->local_context->algorithm.base_asym_algo = m_use_asym_algo;
+	spdm_context->local_context->algorithm.base_hash_algo = m_use_hash_algo;
 	spdm_context->connection_info.algorithm.measurement_hash_algo = 0;
 	spdm_context->connection_info.algorithm.base_asym_algo = 0;
 	spdm_context->connection_info.algorithm.base_hash_algo = 0;
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CHAL_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_CHAL_CAP;
 	spdm_context->transcript.message_a.buffer_size = 0;
 
@@ -1222,10 +1222,10 @@ void test_spdm_requester_negotiate_algorithms_case12(void **state)
 	spdm_test_context->case_id = 0xC;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AFTER_CAPABILITIES;
-	spdm_context->local_context.algorithm.measurement_hash_algo =
+	spdm_context->local_context->algorithm.measurement_hash_algo =
 		m_use_measurement_hash_algo;
-	spdm_context->local_context.algorithm.base_asym_algo = m_use_asym_algo;
-	spdm_context->local_context.algorithm.base_hash_algo = m_use_hash_algo;
+	spdm_context->local_context->algorithm.base_asym_algo = m_use_asym_algo;
+	spdm_context->local_context->algorithm.base_hash_algo = m_use_hash_algo;
 	spdm_context->connection_info.algorithm.measurement_hash_algo = 0;
 	spdm_context->connection_info.algorithm.base_asym_algo = 0;
 	spdm_context->connection_info.algorithm.base_hash_algo = 0;
@@ -1246,9 +1246,9 @@ void test_spdm_requester_negotiate_algorithms_case13(void **state) {
   spdm_context = spdm_test_context->spdm_context;
   spdm_test_context->case_id = 0xD;
   spdm_context->connection_info.connection_state = SPDM_CONNECTION_STATE_AFTER_CAPABILITIES;
-  spdm_context->local_context.algorithm.measurement_hash_algo = m_use_measurement_hash_algo;
-  spdm_context->local_context.algorithm.base_asym_algo = m_use_asym_algo;
-  spdm_context->local_context.algorithm.base_hash_algo = m_use_hash_algo;
+  spdm_context->local_context->algorithm.measurement_hash_algo = m_use_measurement_hash_algo;
+  spdm_context->local_context->algorithm.base_asym_algo = m_use_asym_algo;
+  spdm_context->local_context->algorithm.base_hash_algo = m_use_hash_algo;
   spdm_context->transcript.message_a.buffer_size = 0;
 
   status = spdm_negotiate_algorithms (spdm_context);
@@ -1264,9 +1264,9 @@ void test_spdm_requester_negotiate_algorithms_case14(void **state) {
   spdm_context = spdm_test_context->spdm_context;
   spdm_test_context->case_id = 0xE;
   spdm_context->connection_info.connection_state = SPDM_CONNECTION_STATE_AFTER_CAPABILITIES;
-  spdm_context->local_context.algorithm.measurement_hash_algo = m_use_measurement_hash_algo;
-  spdm_context->local_context.algorithm.base_asym_algo = m_use_asym_algo;
-  spdm_context->local_context.algorithm.base_hash_algo = m_use_hash_algo;
+  spdm_context->local_context->algorithm.measurement_hash_algo = m_use_measurement_hash_algo;
+  spdm_context->local_context->algorithm.base_asym_algo = m_use_asym_algo;
+  spdm_context->local_context->algorithm.base_hash_algo = m_use_hash_algo;
   spdm_context->transcript.message_a.buffer_size = 0;
 
   status = spdm_negotiate_algorithms (spdm_context);
@@ -1282,9 +1282,9 @@ void test_spdm_requester_negotiate_algorithms_case15(void **state) {
   spdm_context = spdm_test_context->spdm_context;
   spdm_test_context->case_id = 0xF;
   spdm_context->connection_info.connection_state = SPDM_CONNECTION_STATE_AFTER_CAPABILITIES;
-  spdm_context->local_context.algorithm.measurement_hash_algo = m_use_measurement_hash_algo;
-  spdm_context->local_context.algorithm.base_asym_algo = m_use_asym_algo;
-  spdm_context->local_context.algorithm.base_hash_algo = m_use_hash_algo;
+  spdm_context->local_context->algorithm.measurement_hash_algo = m_use_measurement_hash_algo;
+  spdm_context->local_context->algorithm.base_asym_algo = m_use_asym_algo;
+  spdm_context->local_context->algorithm.base_hash_algo = m_use_hash_algo;
   spdm_context->transcript.message_a.buffer_size = 0;
 
   status = spdm_negotiate_algorithms (spdm_context);
@@ -1300,9 +1300,9 @@ void test_spdm_requester_negotiate_algorithms_case16(void **state) {
   spdm_context = spdm_test_context->spdm_context;
   spdm_test_context->case_id = 0x10;
   spdm_context->connection_info.connection_state = SPDM_CONNECTION_STATE_AFTER_CAPABILITIES;
-  spdm_context->local_context.algorithm.measurement_hash_algo = m_use_measurement_hash_algo;
-  spdm_context->local_context.algorithm.base_asym_algo = m_use_asym_algo;
-  spdm_context->local_context.algorithm.base_hash_algo = m_use_hash_algo;
+  spdm_context->local_context->algorithm.measurement_hash_algo = m_use_measurement_hash_algo;
+  spdm_context->local_context->algorithm.base_asym_algo = m_use_asym_algo;
+  spdm_context->local_context->algorithm.base_hash_algo = m_use_hash_algo;
   spdm_context->transcript.message_a.buffer_size = 0;
 
   status = spdm_negotiate_algorithms (spdm_context);
@@ -1318,9 +1318,9 @@ void test_spdm_requester_negotiate_algorithms_case16(void **state) {
 //   spdm_context = spdm_test_context->spdm_context;
 //   spdm_test_context->case_id = 0x11;
 //   spdm_context->connection_info.connection_state = SPDM_CONNECTION_STATE_AFTER_CAPABILITIES;
-//   spdm_context->local_context.algorithm.measurement_hash_algo = m_use_measurement_hash_algo;
-//   spdm_context->local_context.algorithm.base_asym_algo = m_use_asym_algo;
-//   spdm_context->local_context.algorithm.base_hash_algo = m_use_hash_algo;
+//   spdm_context->local_context->algorithm.measurement_hash_algo = m_use_measurement_hash_algo;
+//   spdm_context->local_context->algorithm.base_asym_algo = m_use_asym_algo;
+//   spdm_context->local_context->algorithm.base_hash_algo = m_use_hash_algo;
 //   spdm_context->transcript.message_a.buffer_size = 0;
 //
 //   status = spdm_negotiate_algorithms (spdm_context);
@@ -1336,9 +1336,9 @@ void test_spdm_requester_negotiate_algorithms_case17(void **state) {
   spdm_context = spdm_test_context->spdm_context;
   spdm_test_context->case_id = 0x11;
   spdm_context->connection_info.connection_state = SPDM_CONNECTION_STATE_AFTER_CAPABILITIES;
-  spdm_context->local_context.algorithm.measurement_hash_algo = m_use_measurement_hash_algo;
-  spdm_context->local_context.algorithm.base_asym_algo = m_use_asym_algo;
-  spdm_context->local_context.algorithm.base_hash_algo = m_use_hash_algo;
+  spdm_context->local_context->algorithm.measurement_hash_algo = m_use_measurement_hash_algo;
+  spdm_context->local_context->algorithm.base_asym_algo = m_use_asym_algo;
+  spdm_context->local_context->algorithm.base_hash_algo = m_use_hash_algo;
   spdm_context->transcript.message_a.buffer_size = 0;
 
   status = spdm_negotiate_algorithms (spdm_context);
@@ -1354,9 +1354,9 @@ void test_spdm_requester_negotiate_algorithms_case18(void **state) {
   spdm_context = spdm_test_context->spdm_context;
   spdm_test_context->case_id = 0x12;
   spdm_context->connection_info.connection_state = SPDM_CONNECTION_STATE_AFTER_CAPABILITIES;
-  spdm_context->local_context.algorithm.measurement_hash_algo = m_use_measurement_hash_algo;
-  spdm_context->local_context.algorithm.base_asym_algo = m_use_asym_algo;
-  spdm_context->local_context.algorithm.base_hash_algo = m_use_hash_algo;
+  spdm_context->local_context->algorithm.measurement_hash_algo = m_use_measurement_hash_algo;
+  spdm_context->local_context->algorithm.base_asym_algo = m_use_asym_algo;
+  spdm_context->local_context->algorithm.base_hash_algo = m_use_hash_algo;
   spdm_context->transcript.message_a.buffer_size = 0;
 
   status = spdm_negotiate_algorithms (spdm_context);
@@ -1372,9 +1372,9 @@ void test_spdm_requester_negotiate_algorithms_case19(void **state) {
   spdm_context = spdm_test_context->spdm_context;
   spdm_test_context->case_id = 0x13;
   spdm_context->connection_info.connection_state = SPDM_CONNECTION_STATE_AFTER_CAPABILITIES;
-  spdm_context->local_context.algorithm.measurement_hash_algo = m_use_measurement_hash_algo;
-  spdm_context->local_context.algorithm.base_asym_algo = m_use_asym_algo;
-  spdm_context->local_context.algorithm.base_hash_algo = m_use_hash_algo;
+  spdm_context->local_context->algorithm.measurement_hash_algo = m_use_measurement_hash_algo;
+  spdm_context->local_context->algorithm.base_asym_algo = m_use_asym_algo;
+  spdm_context->local_context->algorithm.base_hash_algo = m_use_hash_algo;
   spdm_context->transcript.message_a.buffer_size = 0;
 
   status = spdm_negotiate_algorithms (spdm_context);
@@ -1390,9 +1390,9 @@ void test_spdm_requester_negotiate_algorithms_case20(void **state) {
   spdm_context = spdm_test_context->spdm_context;
   spdm_test_context->case_id = 0x14;
   spdm_context->connection_info.connection_state = SPDM_CONNECTION_STATE_AFTER_CAPABILITIES;
-  spdm_context->local_context.algorithm.measurement_hash_algo = m_use_measurement_hash_algo;
-  spdm_context->local_context.algorithm.base_asym_algo = m_use_asym_algo;
-  spdm_context->local_context.algorithm.base_hash_algo = m_use_hash_algo;
+  spdm_context->local_context->algorithm.measurement_hash_algo = m_use_measurement_hash_algo;
+  spdm_context->local_context->algorithm.base_asym_algo = m_use_asym_algo;
+  spdm_context->local_context->algorithm.base_hash_algo = m_use_hash_algo;
   spdm_context->transcript.message_a.buffer_size = 0;
 
   status = spdm_negotiate_algorithms (spdm_context);
@@ -1408,9 +1408,9 @@ void test_spdm_requester_negotiate_algorithms_case21(void **state) {
   spdm_context = spdm_test_context->spdm_context;
   spdm_test_context->case_id = 0x15;
   spdm_context->connection_info.connection_state = SPDM_CONNECTION_STATE_AFTER_CAPABILITIES;
-  spdm_context->local_context.algorithm.measurement_hash_algo = m_use_measurement_hash_algo;
-  spdm_context->local_context.algorithm.base_asym_algo = m_use_asym_algo;
-  spdm_context->local_context.algorithm.base_hash_algo = m_use_hash_algo;
+  spdm_context->local_context->algorithm.measurement_hash_algo = m_use_measurement_hash_algo;
+  spdm_context->local_context->algorithm.base_asym_algo = m_use_asym_algo;
+  spdm_context->local_context->algorithm.base_hash_algo = m_use_hash_algo;
   spdm_context->transcript.message_a.buffer_size = 0;
 
   status = spdm_negotiate_algorithms (spdm_context);
@@ -1426,9 +1426,9 @@ void test_spdm_requester_negotiate_algorithms_case22(void **state) {
   spdm_context = spdm_test_context->spdm_context;
   spdm_test_context->case_id = 0x16;
   spdm_context->connection_info.connection_state = SPDM_CONNECTION_STATE_AFTER_CAPABILITIES;
-  spdm_context->local_context.algorithm.measurement_hash_algo = m_use_measurement_hash_algo;
-  spdm_context->local_context.algorithm.base_asym_algo = m_use_asym_algo;
-  spdm_context->local_context.algorithm.base_hash_algo = m_use_hash_algo;
+  spdm_context->local_context->algorithm.measurement_hash_algo = m_use_measurement_hash_algo;
+  spdm_context->local_context->algorithm.base_asym_algo = m_use_asym_algo;
+  spdm_context->local_context->algorithm.base_hash_algo = m_use_hash_algo;
   spdm_context->transcript.message_a.buffer_size = 0;
 
   status = spdm_negotiate_algorithms (spdm_context);
@@ -1447,28 +1447,28 @@ void test_spdm_requester_negotiate_algorithms_case23(void **state) {
   spdm_context->connection_info.version.spdm_version[0].major_version = 1;
   spdm_context->connection_info.version.spdm_version[0].minor_version = 1;
   spdm_context->connection_info.connection_state = SPDM_CONNECTION_STATE_AFTER_CAPABILITIES;
-  spdm_context->local_context.algorithm.measurement_hash_algo = m_use_measurement_hash_algo;
-  spdm_context->local_context.algorithm.base_asym_algo = m_use_asym_algo;
-  spdm_context->local_context.algorithm.base_hash_algo = m_use_hash_algo;
+  spdm_context->local_context->algorithm.measurement_hash_algo = m_use_measurement_hash_algo;
+  spdm_context->local_context->algorithm.base_asym_algo = m_use_asym_algo;
+  spdm_context->local_context->algorithm.base_hash_algo = m_use_hash_algo;
   spdm_context->transcript.message_a.buffer_size = 0;
-  spdm_context->local_context.algorithm.dhe_named_group = m_use_dhe_algo;
-  spdm_context->local_context.algorithm.aead_cipher_suite = m_use_aead_algo;
-  spdm_context->local_context.algorithm.req_base_asym_alg = m_use_req_asym_algo;
-  spdm_context->local_context.algorithm.key_schedule = m_use_key_schedule_algo;
+  spdm_context->local_context->algorithm.dhe_named_group = m_use_dhe_algo;
+  spdm_context->local_context->algorithm.aead_cipher_suite = m_use_aead_algo;
+  spdm_context->local_context->algorithm.req_base_asym_alg = m_use_req_asym_algo;
+  spdm_context->local_context->algorithm.key_schedule = m_use_key_schedule_algo;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_KEY_EX_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_ENCRYPT_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MAC_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MUT_AUTH_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MUT_AUTH_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MUT_AUTH_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_PSK_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_PSK_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_PSK_CAP;
 
   status = spdm_negotiate_algorithms (spdm_context);
@@ -1488,28 +1488,28 @@ void test_spdm_requester_negotiate_algorithms_case24(void **state) {
   spdm_context->connection_info.version.spdm_version[0].major_version = 1;
   spdm_context->connection_info.version.spdm_version[0].minor_version = 1;
   spdm_context->connection_info.connection_state = SPDM_CONNECTION_STATE_AFTER_CAPABILITIES;
-  spdm_context->local_context.algorithm.measurement_hash_algo = m_use_measurement_hash_algo;
-  spdm_context->local_context.algorithm.base_asym_algo = m_use_asym_algo;
-  spdm_context->local_context.algorithm.base_hash_algo = m_use_hash_algo;
+  spdm_context->local_context->algorithm.measurement_hash_algo = m_use_measurement_hash_algo;
+  spdm_context->local_context->algorithm.base_asym_algo = m_use_asym_algo;
+  spdm_context->local_context->algorithm.base_hash_algo = m_use_hash_algo;
   spdm_context->transcript.message_a.buffer_size = 0;
-  spdm_context->local_context.algorithm.dhe_named_group = m_use_dhe_algo;
-  spdm_context->local_context.algorithm.aead_cipher_suite = m_use_aead_algo;
-  spdm_context->local_context.algorithm.req_base_asym_alg = m_use_req_asym_algo;
-  spdm_context->local_context.algorithm.key_schedule = m_use_key_schedule_algo;
+  spdm_context->local_context->algorithm.dhe_named_group = m_use_dhe_algo;
+  spdm_context->local_context->algorithm.aead_cipher_suite = m_use_aead_algo;
+  spdm_context->local_context->algorithm.req_base_asym_alg = m_use_req_asym_algo;
+  spdm_context->local_context->algorithm.key_schedule = m_use_key_schedule_algo;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_KEY_EX_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_ENCRYPT_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MAC_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MUT_AUTH_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MUT_AUTH_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MUT_AUTH_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_PSK_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_PSK_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_PSK_CAP;
 
   status = spdm_negotiate_algorithms (spdm_context);
@@ -1528,28 +1528,28 @@ void test_spdm_requester_negotiate_algorithms_case25(void **state) {
   spdm_context->connection_info.version.spdm_version[0].major_version = 1;
   spdm_context->connection_info.version.spdm_version[0].minor_version = 1;
   spdm_context->connection_info.connection_state = SPDM_CONNECTION_STATE_AFTER_CAPABILITIES;
-  spdm_context->local_context.algorithm.measurement_hash_algo = m_use_measurement_hash_algo;
-  spdm_context->local_context.algorithm.base_asym_algo = m_use_asym_algo;
-  spdm_context->local_context.algorithm.base_hash_algo = m_use_hash_algo;
+  spdm_context->local_context->algorithm.measurement_hash_algo = m_use_measurement_hash_algo;
+  spdm_context->local_context->algorithm.base_asym_algo = m_use_asym_algo;
+  spdm_context->local_context->algorithm.base_hash_algo = m_use_hash_algo;
   spdm_context->transcript.message_a.buffer_size = 0;
-  spdm_context->local_context.algorithm.dhe_named_group = m_use_dhe_algo;
-  spdm_context->local_context.algorithm.aead_cipher_suite = m_use_aead_algo;
-  spdm_context->local_context.algorithm.req_base_asym_alg = m_use_req_asym_algo;
-  spdm_context->local_context.algorithm.key_schedule = m_use_key_schedule_algo;
+  spdm_context->local_context->algorithm.dhe_named_group = m_use_dhe_algo;
+  spdm_context->local_context->algorithm.aead_cipher_suite = m_use_aead_algo;
+  spdm_context->local_context->algorithm.req_base_asym_alg = m_use_req_asym_algo;
+  spdm_context->local_context->algorithm.key_schedule = m_use_key_schedule_algo;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_KEY_EX_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_ENCRYPT_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MAC_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MUT_AUTH_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MUT_AUTH_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MUT_AUTH_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_PSK_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_PSK_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_PSK_CAP;
 
   status = spdm_negotiate_algorithms (spdm_context);
@@ -1568,28 +1568,28 @@ void test_spdm_requester_negotiate_algorithms_case26(void **state) {
   spdm_context->connection_info.version.spdm_version[0].major_version = 1;
   spdm_context->connection_info.version.spdm_version[0].minor_version = 1;
   spdm_context->connection_info.connection_state = SPDM_CONNECTION_STATE_AFTER_CAPABILITIES;
-  spdm_context->local_context.algorithm.measurement_hash_algo = m_use_measurement_hash_algo;
-  spdm_context->local_context.algorithm.base_asym_algo = m_use_asym_algo;
-  spdm_context->local_context.algorithm.base_hash_algo = m_use_hash_algo;
+  spdm_context->local_context->algorithm.measurement_hash_algo = m_use_measurement_hash_algo;
+  spdm_context->local_context->algorithm.base_asym_algo = m_use_asym_algo;
+  spdm_context->local_context->algorithm.base_hash_algo = m_use_hash_algo;
   spdm_context->transcript.message_a.buffer_size = 0;
-  spdm_context->local_context.algorithm.dhe_named_group = m_use_dhe_algo;
-  spdm_context->local_context.algorithm.aead_cipher_suite = m_use_aead_algo;
-  spdm_context->local_context.algorithm.req_base_asym_alg = m_use_req_asym_algo;
-  spdm_context->local_context.algorithm.key_schedule = m_use_key_schedule_algo;
+  spdm_context->local_context->algorithm.dhe_named_group = m_use_dhe_algo;
+  spdm_context->local_context->algorithm.aead_cipher_suite = m_use_aead_algo;
+  spdm_context->local_context->algorithm.req_base_asym_alg = m_use_req_asym_algo;
+  spdm_context->local_context->algorithm.key_schedule = m_use_key_schedule_algo;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_KEY_EX_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_ENCRYPT_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MAC_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MUT_AUTH_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MUT_AUTH_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MUT_AUTH_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_PSK_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_PSK_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_PSK_CAP;
 
   status = spdm_negotiate_algorithms (spdm_context);
@@ -1608,28 +1608,28 @@ void test_spdm_requester_negotiate_algorithms_case27(void **state) {
   spdm_context->connection_info.version.spdm_version[0].major_version = 1;
   spdm_context->connection_info.version.spdm_version[0].minor_version = 1;
   spdm_context->connection_info.connection_state = SPDM_CONNECTION_STATE_AFTER_CAPABILITIES;
-  spdm_context->local_context.algorithm.measurement_hash_algo = m_use_measurement_hash_algo;
-  spdm_context->local_context.algorithm.base_asym_algo = m_use_asym_algo;
-  spdm_context->local_context.algorithm.base_hash_algo = m_use_hash_algo;
+  spdm_context->local_context->algorithm.measurement_hash_algo = m_use_measurement_hash_algo;
+  spdm_context->local_context->algorithm.base_asym_algo = m_use_asym_algo;
+  spdm_context->local_context->algorithm.base_hash_algo = m_use_hash_algo;
   spdm_context->transcript.message_a.buffer_size = 0;
-  spdm_context->local_context.algorithm.dhe_named_group = m_use_dhe_algo;
-  spdm_context->local_context.algorithm.aead_cipher_suite = m_use_aead_algo;
-  spdm_context->local_context.algorithm.req_base_asym_alg = m_use_req_asym_algo;
-  spdm_context->local_context.algorithm.key_schedule = m_use_key_schedule_algo;
+  spdm_context->local_context->algorithm.dhe_named_group = m_use_dhe_algo;
+  spdm_context->local_context->algorithm.aead_cipher_suite = m_use_aead_algo;
+  spdm_context->local_context->algorithm.req_base_asym_alg = m_use_req_asym_algo;
+  spdm_context->local_context->algorithm.key_schedule = m_use_key_schedule_algo;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_KEY_EX_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_ENCRYPT_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MAC_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MUT_AUTH_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MUT_AUTH_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MUT_AUTH_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_PSK_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_PSK_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_PSK_CAP;
 
   status = spdm_negotiate_algorithms (spdm_context);
@@ -1648,28 +1648,28 @@ void test_spdm_requester_negotiate_algorithms_case28(void **state) {
   spdm_context->connection_info.version.spdm_version[0].major_version = 1;
   spdm_context->connection_info.version.spdm_version[0].minor_version = 1;
   spdm_context->connection_info.connection_state = SPDM_CONNECTION_STATE_AFTER_CAPABILITIES;
-  spdm_context->local_context.algorithm.measurement_hash_algo = m_use_measurement_hash_algo;
-  spdm_context->local_context.algorithm.base_asym_algo = m_use_asym_algo;
-  spdm_context->local_context.algorithm.base_hash_algo = m_use_hash_algo;
+  spdm_context->local_context->algorithm.measurement_hash_algo = m_use_measurement_hash_algo;
+  spdm_context->local_context->algorithm.base_asym_algo = m_use_asym_algo;
+  spdm_context->local_context->algorithm.base_hash_algo = m_use_hash_algo;
   spdm_context->transcript.message_a.buffer_size = 0;
-  spdm_context->local_context.algorithm.dhe_named_group = m_use_dhe_algo;
-  spdm_context->local_context.algorithm.aead_cipher_suite = m_use_aead_algo;
-  spdm_context->local_context.algorithm.req_base_asym_alg = m_use_req_asym_algo;
-  spdm_context->local_context.algorithm.key_schedule = m_use_key_schedule_algo;
+  spdm_context->local_context->algorithm.dhe_named_group = m_use_dhe_algo;
+  spdm_context->local_context->algorithm.aead_cipher_suite = m_use_aead_algo;
+  spdm_context->local_context->algorithm.req_base_asym_alg = m_use_req_asym_algo;
+  spdm_context->local_context->algorithm.key_schedule = m_use_key_schedule_algo;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_KEY_EX_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_ENCRYPT_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MAC_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MUT_AUTH_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MUT_AUTH_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MUT_AUTH_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_PSK_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_PSK_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_PSK_CAP;
 
   status = spdm_negotiate_algorithms (spdm_context);
@@ -1688,28 +1688,28 @@ void test_spdm_requester_negotiate_algorithms_case29(void **state) {
   spdm_context->connection_info.version.spdm_version[0].major_version = 1;
   spdm_context->connection_info.version.spdm_version[0].minor_version = 1;
   spdm_context->connection_info.connection_state = SPDM_CONNECTION_STATE_AFTER_CAPABILITIES;
-  spdm_context->local_context.algorithm.measurement_hash_algo = m_use_measurement_hash_algo;
-  spdm_context->local_context.algorithm.base_asym_algo = m_use_asym_algo;
-  spdm_context->local_context.algorithm.base_hash_algo = m_use_hash_algo;
+  spdm_context->local_context->algorithm.measurement_hash_algo = m_use_measurement_hash_algo;
+  spdm_context->local_context->algorithm.base_asym_algo = m_use_asym_algo;
+  spdm_context->local_context->algorithm.base_hash_algo = m_use_hash_algo;
   spdm_context->transcript.message_a.buffer_size = 0;
-  spdm_context->local_context.algorithm.dhe_named_group = m_use_dhe_algo;
-  spdm_context->local_context.algorithm.aead_cipher_suite = m_use_aead_algo;
-  spdm_context->local_context.algorithm.req_base_asym_alg = m_use_req_asym_algo;
-  spdm_context->local_context.algorithm.key_schedule = m_use_key_schedule_algo;
+  spdm_context->local_context->algorithm.dhe_named_group = m_use_dhe_algo;
+  spdm_context->local_context->algorithm.aead_cipher_suite = m_use_aead_algo;
+  spdm_context->local_context->algorithm.req_base_asym_alg = m_use_req_asym_algo;
+  spdm_context->local_context->algorithm.key_schedule = m_use_key_schedule_algo;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_KEY_EX_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_ENCRYPT_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MAC_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MUT_AUTH_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MUT_AUTH_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MUT_AUTH_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_PSK_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_PSK_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_PSK_CAP;
 
   status = spdm_negotiate_algorithms (spdm_context);
@@ -1728,28 +1728,28 @@ void test_spdm_requester_negotiate_algorithms_case30(void **state) {
   spdm_context->connection_info.version.spdm_version[0].major_version = 1;
   spdm_context->connection_info.version.spdm_version[0].minor_version = 1;
   spdm_context->connection_info.connection_state = SPDM_CONNECTION_STATE_AFTER_CAPABILITIES;
-  spdm_context->local_context.algorithm.measurement_hash_algo = m_use_measurement_hash_algo;
-  spdm_context->local_context.algorithm.base_asym_algo = m_use_asym_algo;
-  spdm_context->local_context.algorithm.base_hash_algo = m_use_hash_algo;
+  spdm_context->local_context->algorithm.measurement_hash_algo = m_use_measurement_hash_algo;
+  spdm_context->local_context->algorithm.base_asym_algo = m_use_asym_algo;
+  spdm_context->local_context->algorithm.base_hash_algo = m_use_hash_algo;
   spdm_context->transcript.message_a.buffer_size = 0;
-  spdm_context->local_context.algorithm.dhe_named_group = m_use_dhe_algo;
-  spdm_context->local_context.algorithm.aead_cipher_suite = m_use_aead_algo;
-  spdm_context->local_context.algorithm.req_base_asym_alg = m_use_req_asym_algo;
-  spdm_context->local_context.algorithm.key_schedule = m_use_key_schedule_algo;
+  spdm_context->local_context->algorithm.dhe_named_group = m_use_dhe_algo;
+  spdm_context->local_context->algorithm.aead_cipher_suite = m_use_aead_algo;
+  spdm_context->local_context->algorithm.req_base_asym_alg = m_use_req_asym_algo;
+  spdm_context->local_context->algorithm.key_schedule = m_use_key_schedule_algo;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_KEY_EX_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_ENCRYPT_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MAC_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MUT_AUTH_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MUT_AUTH_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MUT_AUTH_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_PSK_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_PSK_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_PSK_CAP;
 
   status = spdm_negotiate_algorithms (spdm_context);
@@ -1768,28 +1768,28 @@ void test_spdm_requester_negotiate_algorithms_case31(void **state) {
   spdm_context->connection_info.version.spdm_version[0].major_version = 1;
   spdm_context->connection_info.version.spdm_version[0].minor_version = 1;
   spdm_context->connection_info.connection_state = SPDM_CONNECTION_STATE_AFTER_CAPABILITIES;
-  spdm_context->local_context.algorithm.measurement_hash_algo = m_use_measurement_hash_algo;
-  spdm_context->local_context.algorithm.base_asym_algo = m_use_asym_algo;
-  spdm_context->local_context.algorithm.base_hash_algo = m_use_hash_algo;
+  spdm_context->local_context->algorithm.measurement_hash_algo = m_use_measurement_hash_algo;
+  spdm_context->local_context->algorithm.base_asym_algo = m_use_asym_algo;
+  spdm_context->local_context->algorithm.base_hash_algo = m_use_hash_algo;
   spdm_context->transcript.message_a.buffer_size = 0;
-  spdm_context->local_context.algorithm.dhe_named_group = m_use_dhe_algo;
-  spdm_context->local_context.algorithm.aead_cipher_suite = m_use_aead_algo;
-  spdm_context->local_context.algorithm.req_base_asym_alg = m_use_req_asym_algo;
-  spdm_context->local_context.algorithm.key_schedule = m_use_key_schedule_algo;
+  spdm_context->local_context->algorithm.dhe_named_group = m_use_dhe_algo;
+  spdm_context->local_context->algorithm.aead_cipher_suite = m_use_aead_algo;
+  spdm_context->local_context->algorithm.req_base_asym_alg = m_use_req_asym_algo;
+  spdm_context->local_context->algorithm.key_schedule = m_use_key_schedule_algo;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_KEY_EX_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_ENCRYPT_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MAC_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MUT_AUTH_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MUT_AUTH_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MUT_AUTH_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_PSK_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_PSK_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_PSK_CAP;
 
   status = spdm_negotiate_algorithms (spdm_context);
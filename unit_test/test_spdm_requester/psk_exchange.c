@@ -935,7 +935,7 @@ void test_spdm_requester_psk_exchange_case1(void **state)
 		SPDM_CONNECTION_STATE_NEGOTIATED;
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_PSK_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_PSK_CAP;
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data,
@@ -956,9 +956,9 @@ void test_spdm_requester_psk_exchange_case1(void **state)
 	zero_mem(m_local_psk_hint, 32);
 	copy_mem(&m_local_psk_hint[0], TEST_PSK_HINT_STRING,
 		 sizeof(TEST_PSK_HINT_STRING));
-	spdm_context->local_context.psk_hint_size =
+	spdm_context->local_context->psk_hint_size =
 		sizeof(TEST_PSK_HINT_STRING);
-	spdm_context->local_context.psk_hint = m_local_psk_hint;
+	spdm_context->local_context->psk_hint = m_local_psk_hint;
 
 	heartbeat_period = 0;
 	zero_mem(measurement_hash, sizeof(measurement_hash));
@@ -990,7 +990,7 @@ void test_spdm_requester_psk_exchange_case2(void **state)
 		SPDM_CONNECTION_STATE_NEGOTIATED;
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_PSK_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_PSK_CAP;
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data,
@@ -1011,9 +1011,9 @@ void test_spdm_requester_psk_exchange_case2(void **state)
 	zero_mem(m_local_psk_hint, 32);
 	copy_mem(&m_local_psk_hint[0], TEST_PSK_HINT_STRING,
 		 sizeof(TEST_PSK_HINT_STRING));
-	spdm_context->local_context.psk_hint_size =
+	spdm_context->local_context->psk_hint_size =
 		sizeof(TEST_PSK_HINT_STRING);
-	spdm_context->local_context.psk_hint = m_local_psk_hint;
+	spdm_context->local_context->psk_hint = m_local_psk_hint;
 
 	heartbeat_period = 0;
 	zero_mem(measurement_hash, sizeof(measurement_hash));
@@ -1050,7 +1050,7 @@ void test_spdm_requester_psk_exchange_case3(void **state)
 		SPDM_CONNECTION_STATE_NOT_STARTED;
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_PSK_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_PSK_CAP;
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data,
@@ -1071,9 +1071,9 @@ void test_spdm_requester_psk_exchange_case3(void **state)
 	zero_mem(m_local_psk_hint, 32);
 	copy_mem(&m_local_psk_hint[0], TEST_PSK_HINT_STRING,
 		 sizeof(TEST_PSK_HINT_STRING));
-	spdm_context->local_context.psk_hint_size =
+	spdm_context->local_context->psk_hint_size =
 		sizeof(TEST_PSK_HINT_STRING);
-	spdm_context->local_context.psk_hint = m_local_psk_hint;
+	spdm_context->local_context->psk_hint = m_local_psk_hint;
 
 	heartbeat_period = 0;
 	zero_mem(measurement_hash, sizeof(measurement_hash));
@@ -1105,7 +1105,7 @@ void test_spdm_requester_psk_exchange_case4(void **state)
 		SPDM_CONNECTION_STATE_NEGOTIATED;
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_PSK_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_PSK_CAP;
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data,
@@ -1126,9 +1126,9 @@ void test_spdm_requester_psk_exchange_case4(void **state)
 	zero_mem(m_local_psk_hint, 32);
 	copy_mem(&m_local_psk_hint[0], TEST_PSK_HINT_STRING,
 		 sizeof(TEST_PSK_HINT_STRING));
-	spdm_context->local_context.psk_hint_size =
+	spdm_context->local_context->psk_hint_size =
 		sizeof(TEST_PSK_HINT_STRING);
-	spdm_context->local_context.psk_hint = m_local_psk_hint;
+	spdm_context->local_context->psk_hint = m_local_psk_hint;
 
 	heartbeat_period = 0;
 	zero_mem(measurement_hash, sizeof(measurement_hash));
@@ -1160,7 +1160,7 @@ void test_spdm_requester_psk_exchange_case5(void **state)
 		SPDM_CONNECTION_STATE_NEGOTIATED;
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_PSK_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_PSK_CAP;
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data,
@@ -1181,9 +1181,9 @@ void test_spdm_requester_psk_exchange_case5(void **state)
 	zero_mem(m_local_psk_hint, 32);
 	copy_mem(&m_local_psk_hint[0], TEST_PSK_HINT_STRING,
 		 sizeof(TEST_PSK_HINT_STRING));
-	spdm_context->local_context.psk_hint_size =
+	spdm_context->local_context->psk_hint_size =
 		sizeof(TEST_PSK_HINT_STRING);
-	spdm_context->local_context.psk_hint = m_local_psk_hint;
+	spdm_context->local_context->psk_hint = m_local_psk_hint;
 
 	heartbeat_period = 0;
 	zero_mem(measurement_hash, sizeof(measurement_hash));
@@ -1215,7 +1215,7 @@ void test_spdm_requester_psk_exchange_case6(void **state)
 		SPDM_CONNECTION_STATE_NEGOTIATED;
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_PSK_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_PSK_CAP;
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data,
@@ -1236,9 +1236,9 @@ void test_spdm_requester_psk_exchange_case6(void **state)
 	zero_mem(m_local_psk_hint, 32);
 	copy_mem(&m_local_psk_hint[0], TEST_PSK_HINT_STRING,
 		 sizeof(TEST_PSK_HINT_STRING));
-	spdm_context->local_context.psk_hint_size =
+	spdm_context->local_context->psk_hint_size =
 		sizeof(TEST_PSK_HINT_STRING);
-	spdm_context->local_context.psk_hint = m_local_psk_hint;
+	spdm_context->local_context->psk_hint = m_local_psk_hint;
 
 	heartbeat_period = 0;
 	zero_mem(measurement_hash, sizeof(measurement_hash));
@@ -1275,7 +1275,7 @@ void test_spdm_requester_psk_exchange_case7(void **state)
 		SPDM_CONNECTION_STATE_NEGOTIATED;
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_PSK_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_PSK_CAP;
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data,
@@ -1296,9 +1296,9 @@ void test_spdm_requester_psk_exchange_case7(void **state)
 	zero_mem(m_local_psk_hint, 32);
 	copy_mem(&m_local_psk_hint[0], TEST_PSK_HINT_STRING,
 		 sizeof(TEST_PSK_HINT_STRING));
-	spdm_context->local_context.psk_hint_size =
+	spdm_context->local_context->psk_hint_size =
 		sizeof(TEST_PSK_HINT_STRING);
-	spdm_context->local_context.psk_hint = m_local_psk_hint;
+	spdm_context->local_context->psk_hint = m_local_psk_hint;
 
 	heartbeat_period = 0;
 	zero_mem(measurement_hash, sizeof(measurement_hash));
@@ -1332,7 +1332,7 @@ void test_spdm_requester_psk_exchange_case8(void **state)
 		SPDM_CONNECTION_STATE_NEGOTIATED;
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_PSK_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_PSK_CAP;
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data,
@@ -1353,9 +1353,9 @@ void test_spdm_requester_psk_exchange_case8(void **state)
 	zero_mem(m_local_psk_hint, 32);
 	copy_mem(&m_local_psk_hint[0], TEST_PSK_HINT_STRING,
 		 sizeof(TEST_PSK_HINT_STRING));
-	spdm_context->local_context.psk_hint_size =
+	spdm_context->local_context->psk_hint_size =
 		sizeof(TEST_PSK_HINT_STRING);
-	spdm_context->local_context.psk_hint = m_local_psk_hint;
+	spdm_context->local_context->psk_hint = m_local_psk_hint;
 
 	heartbeat_period = 0;
 	zero_mem(measurement_hash, sizeof(measurement_hash));
@@ -1387,7 +1387,7 @@ void test_spdm_requester_psk_exchange_case9(void **state)
 		SPDM_CONNECTION_STATE_NEGOTIATED;
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_PSK_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_PSK_CAP;
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data,
@@ -1408,9 +1408,9 @@ void test_spdm_requester_psk_exchange_case9(void **state)
 	zero_mem(m_local_psk_hint, 32);
 	copy_mem(&m_local_psk_hint[0], TEST_PSK_HINT_STRING,
 		 sizeof(TEST_PSK_HINT_STRING));
-	spdm_context->local_context.psk_hint_size =
+	spdm_context->local_context->psk_hint_size =
 		sizeof(TEST_PSK_HINT_STRING);
-	spdm_context->local_context.psk_hint = m_local_psk_hint;
+	spdm_context->local_context->psk_hint = m_local_psk_hint;
 
 	heartbeat_period = 0;
 	zero_mem(measurement_hash, sizeof(measurement_hash));
@@ -1444,7 +1444,7 @@ void test_spdm_requester_psk_exchange_case10(void **state) {
   spdm_context = spdm_test_context->spdm_context;
   spdm_test_context->case_id = 0xA;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_PSK_CAP;
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_PSK_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_PSK_CAP;
   read_responder_public_certificate_chain (m_use_hash_algo, m_use_asym_algo, &data, &data_size, &hash, &hash_size);
   spdm_context->connection_info.algorithm.base_hash_algo = m_use_hash_algo;
   spdm_context->connection_info.algorithm.dhe_named_group = m_use_dhe_algo;
@@ -1454,8 +1454,8 @@ void test_spdm_requester_psk_exchange_case10(void **state) {
   copy_mem (spdm_context->connection_info.peer_used_cert_chain_buffer, data, data_size);
   zero_mem (m_local_psk_hint, 32);
   copy_mem (&m_local_psk_hint[0], TEST_PSK_HINT_STRING, sizeof(TEST_PSK_HINT_STRING));
-  spdm_context->local_context.psk_hint_size = sizeof(TEST_PSK_HINT_STRING);
-  spdm_context->local_context.psk_hint = m_local_psk_hint;
+  spdm_context->local_context->psk_hint_size = sizeof(TEST_PSK_HINT_STRING);
+  spdm_context->local_context->psk_hint = m_local_psk_hint;
 
   error_code = SPDM_ERROR_CODE_RESERVED_00;
   while(error_code <= 0xff) {
@@ -1504,7 +1504,7 @@ void test_spdm_requester_psk_exchange_case11(void **state)
 		SPDM_CONNECTION_STATE_NEGOTIATED;
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_PSK_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_PSK_CAP;
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data,
@@ -1525,11 +1525,12 @@ void test_spdm_requester_psk_exchange_case11(void **state)
 	zero_mem(m_local_psk_hint, 32);
 	copy_mem(&m_local_psk_hint[0], TEST_PSK_HINT_STRING,
 		 sizeof(TEST_PSK_HINT_STRING));
-	spdm_context->local_context.psk_hint_size =
+	spdm_context->local_context->psk_hint_size =
 		sizeof(TEST_PSK_HINT_STRING);
-	spdm_context->local_context.psk_hint = m_local_psk_hint;
+	spdm_context->local_context->psk_hint = m_local_psk_hint;
 	spdm_context->transcript.message_m.buffer_size =
 							spdm_context->transcript.message_m.max_buffer_size;
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	spdm_context->transcript.message_b.buffer_size =
 							spdm_context->transcript.message_b.max_buffer_size;
 	spdm_context->transcript.message_c.buffer_size =
@@ -1538,6 +1539,7 @@ void test_spdm_requester_psk_exchange_case11(void **state)
 							spdm_context->transcript.message_mut_b.max_buffer_size;
 	spdm_context->transcript.message_mut_c.buffer_size =
 							spdm_context->transcript.message_mut_c.max_buffer_size;
+#endif
 
 	heartbeat_period = 0;
 	zero_mem(measurement_hash, sizeof(measurement_hash));
@@ -1552,10 +1554,12 @@ void test_spdm_requester_psk_exchange_case11(void **state)
 			spdm_context->session_info[0].secured_message_context),
 		SPDM_SESSION_STATE_HANDSHAKING);
 	assert_int_equal(spdm_context->transcript.message_m.buffer_size, 0);
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	assert_int_equal(spdm_context->transcript.message_b.buffer_size, 0);
 	assert_int_equal(spdm_context->transcript.message_c.buffer_size, 0);
 	assert_int_equal(spdm_context->transcript.message_mut_b.buffer_size, 0);
 	assert_int_equal(spdm_context->transcript.message_mut_c.buffer_size, 0);
+#endif
 	
 	free(data);
 }
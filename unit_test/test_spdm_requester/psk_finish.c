@@ -489,11 +489,11 @@ void test_spdm_requester_psk_finish_case1(void **state)
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_ENCRYPT_CAP;
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MAC_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_PSK_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP;
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data,
@@ -514,13 +514,17 @@ void test_spdm_requester_psk_finish_case1(void **state)
 	zero_mem(m_local_psk_hint, 32);
 	copy_mem(&m_local_psk_hint[0], TEST_PSK_HINT_STRING,
 		 sizeof(TEST_PSK_HINT_STRING));
-	spdm_context->local_context.psk_hint_size =
+	spdm_context->local_context->psk_hint_size =
 		sizeof(TEST_PSK_HINT_STRING);
-	spdm_context->local_context.psk_hint = m_local_psk_hint;
+	spdm_context->local_context->psk_hint = m_local_psk_hint;
 
 	session_id = 0xFFFFFFFF;
 	session_info = &spdm_context->session_info[0];
 	spdm_session_info_init(spdm_context, session_info, session_id, TRUE);
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 0
+	// message_k is empty, only seed the TH hash context with A.
+	spdm_append_message_k(spdm_context, session_info, TRUE, NULL, 0);
+#endif
 	spdm_secured_message_set_session_state(
 		session_info->secured_message_context,
 		SPDM_SESSION_STATE_HANDSHAKING);
@@ -553,11 +557,11 @@ void test_spdm_requester_psk_finish_case2(void **state)
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_ENCRYPT_CAP;
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MAC_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_PSK_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP;
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data,
@@ -578,13 +582,17 @@ void test_spdm_requester_psk_finish_case2(void **state)
 	zero_mem(m_local_psk_hint, 32);
 	copy_mem(&m_local_psk_hint[0], TEST_PSK_HINT_STRING,
 		 sizeof(TEST_PSK_HINT_STRING));
-	spdm_context->local_context.psk_hint_size =
+	spdm_context->local_context->psk_hint_size =
 		sizeof(TEST_PSK_HINT_STRING);
-	spdm_context->local_context.psk_hint = m_local_psk_hint;
+	spdm_context->local_context->psk_hint = m_local_psk_hint;
 
 	session_id = 0xFFFFFFFF;
 	session_info = &spdm_context->session_info[0];
 	spdm_session_info_init(spdm_context, session_info, session_id, TRUE);
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 0
+	// message_k is empty, only seed the TH hash context with A.
+	spdm_append_message_k(spdm_context, session_info, TRUE, NULL, 0);
+#endif
 	spdm_secured_message_set_session_state(
 		session_info->secured_message_context,
 		SPDM_SESSION_STATE_HANDSHAKING);
@@ -644,11 +652,11 @@ void test_spdm_requester_psk_finish_case3(void **state)
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_ENCRYPT_CAP;
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MAC_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_PSK_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP;
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data,
@@ -669,13 +677,17 @@ void test_spdm_requester_psk_finish_case3(void **state)
 	zero_mem(m_local_psk_hint, 32);
 	copy_mem(&m_local_psk_hint[0], TEST_PSK_HINT_STRING,
 		 sizeof(TEST_PSK_HINT_STRING));
-	spdm_context->local_context.psk_hint_size =
+	spdm_context->local_context->psk_hint_size =
 		sizeof(TEST_PSK_HINT_STRING);
-	spdm_context->local_context.psk_hint = m_local_psk_hint;
+	spdm_context->local_context->psk_hint = m_local_psk_hint;
 
 	session_id = 0xFFFFFFFF;
 	session_info = &spdm_context->session_info[0];
 	spdm_session_info_init(spdm_context, session_info, session_id, TRUE);
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 0
+	// message_k is empty, only seed the TH hash context with A.
+	spdm_append_message_k(spdm_context, session_info, TRUE, NULL, 0);
+#endif
 	spdm_secured_message_set_session_state(
 		session_info->secured_message_context,
 		SPDM_SESSION_STATE_HANDSHAKING);
@@ -731,11 +743,11 @@ void test_spdm_requester_psk_finish_case4(void **state)
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_ENCRYPT_CAP;
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MAC_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_PSK_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP;
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data,
@@ -756,13 +768,17 @@ void test_spdm_requester_psk_finish_case4(void **state)
 	zero_mem(m_local_psk_hint, 32);
 	copy_mem(&m_local_psk_hint[0], TEST_PSK_HINT_STRING,
 		 sizeof(TEST_PSK_HINT_STRING));
-	spdm_context->local_context.psk_hint_size =
+	spdm_context->local_context->psk_hint_size =
 		sizeof(TEST_PSK_HINT_STRING);
-	spdm_context->local_context.psk_hint = m_local_psk_hint;
+	spdm_context->local_context->psk_hint = m_local_psk_hint;
 
 	session_id = 0xFFFFFFFF;
 	session_info = &spdm_context->session_info[0];
 	spdm_session_info_init(spdm_context, session_info, session_id, TRUE);
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 0
+	// message_k is empty, only seed the TH hash context with A.
+	spdm_append_message_k(spdm_context, session_info, TRUE, NULL, 0);
+#endif
 	spdm_secured_message_set_session_state(
 		session_info->secured_message_context,
 		SPDM_SESSION_STATE_HANDSHAKING);
@@ -818,11 +834,11 @@ void test_spdm_requester_psk_finish_case5(void **state)
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_ENCRYPT_CAP;
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MAC_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_PSK_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP;
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data,
@@ -843,13 +859,17 @@ void test_spdm_requester_psk_finish_case5(void **state)
 	zero_mem(m_local_psk_hint, 32);
 	copy_mem(&m_local_psk_hint[0], TEST_PSK_HINT_STRING,
 		 sizeof(TEST_PSK_HINT_STRING));
-	spdm_context->local_context.psk_hint_size =
+	spdm_context->local_context->psk_hint_size =
 		sizeof(TEST_PSK_HINT_STRING);
-	spdm_context->local_context.psk_hint = m_local_psk_hint;
+	spdm_context->local_context->psk_hint = m_local_psk_hint;
 
 	session_id = 0xFFFFFFFF;
 	session_info = &spdm_context->session_info[0];
 	spdm_session_info_init(spdm_context, session_info, session_id, TRUE);
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 0
+	// message_k is empty, only seed the TH hash context with A.
+	spdm_append_message_k(spdm_context, session_info, TRUE, NULL, 0);
+#endif
 	spdm_secured_message_set_session_state(
 		session_info->secured_message_context,
 		SPDM_SESSION_STATE_HANDSHAKING);
@@ -905,11 +925,11 @@ void test_spdm_requester_psk_finish_case6(void **state)
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_ENCRYPT_CAP;
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MAC_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_PSK_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP;
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data,
@@ -930,13 +950,17 @@ void test_spdm_requester_psk_finish_case6(void **state)
 	zero_mem(m_local_psk_hint, 32);
 	copy_mem(&m_local_psk_hint[0], TEST_PSK_HINT_STRING,
 		 sizeof(TEST_PSK_HINT_STRING));
-	spdm_context->local_context.psk_hint_size =
+	spdm_context->local_context->psk_hint_size =
 		sizeof(TEST_PSK_HINT_STRING);
-	spdm_context->local_context.psk_hint = m_local_psk_hint;
+	spdm_context->local_context->psk_hint = m_local_psk_hint;
 
 	session_id = 0xFFFFFFFF;
 	session_info = &spdm_context->session_info[0];
 	spdm_session_info_init(spdm_context, session_info, session_id, TRUE);
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 0
+	// message_k is empty, only seed the TH hash context with A.
+	spdm_append_message_k(spdm_context, session_info, TRUE, NULL, 0);
+#endif
 	spdm_secured_message_set_session_state(
 		session_info->secured_message_context,
 		SPDM_SESSION_STATE_HANDSHAKING);
@@ -996,11 +1020,11 @@ void test_spdm_requester_psk_finish_case7(void **state)
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_ENCRYPT_CAP;
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MAC_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_PSK_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP;
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data,
@@ -1021,13 +1045,17 @@ void test_spdm_requester_psk_finish_case7(void **state)
 	zero_mem(m_local_psk_hint, 32);
 	copy_mem(&m_local_psk_hint[0], TEST_PSK_HINT_STRING,
 		 sizeof(TEST_PSK_HINT_STRING));
-	spdm_context->local_context.psk_hint_size =
+	spdm_context->local_context->psk_hint_size =
 		sizeof(TEST_PSK_HINT_STRING);
-	spdm_context->local_context.psk_hint = m_local_psk_hint;
+	spdm_context->local_context->psk_hint = m_local_psk_hint;
 
 	session_id = 0xFFFFFFFF;
 	session_info = &spdm_context->session_info[0];
 	spdm_session_info_init(spdm_context, session_info, session_id, TRUE);
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 0
+	// message_k is empty, only seed the TH hash context with A.
+	spdm_append_message_k(spdm_context, session_info, TRUE, NULL, 0);
+#endif
 	spdm_secured_message_set_session_state(
 		session_info->secured_message_context,
 		SPDM_SESSION_STATE_HANDSHAKING);
@@ -1085,11 +1113,11 @@ void test_spdm_requester_psk_finish_case8(void **state)
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_ENCRYPT_CAP;
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MAC_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_PSK_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP;
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data,
@@ -1110,13 +1138,17 @@ void test_spdm_requester_psk_finish_case8(void **state)
 	zero_mem(m_local_psk_hint, 32);
 	copy_mem(&m_local_psk_hint[0], TEST_PSK_HINT_STRING,
 		 sizeof(TEST_PSK_HINT_STRING));
-	spdm_context->local_context.psk_hint_size =
+	spdm_context->local_context->psk_hint_size =
 		sizeof(TEST_PSK_HINT_STRING);
-	spdm_context->local_context.psk_hint = m_local_psk_hint;
+	spdm_context->local_context->psk_hint = m_local_psk_hint;
 
 	session_id = 0xFFFFFFFF;
 	session_info = &spdm_context->session_info[0];
 	spdm_session_info_init(spdm_context, session_info, session_id, TRUE);
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 0
+	// message_k is empty, only seed the TH hash context with A.
+	spdm_append_message_k(spdm_context, session_info, TRUE, NULL, 0);
+#endif
 	spdm_secured_message_set_session_state(
 		session_info->secured_message_context,
 		SPDM_SESSION_STATE_HANDSHAKING);
@@ -1172,11 +1204,11 @@ void test_spdm_requester_psk_finish_case9(void **state)
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_ENCRYPT_CAP;
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MAC_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_PSK_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP;
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data,
@@ -1197,13 +1229,17 @@ void test_spdm_requester_psk_finish_case9(void **state)
 	zero_mem(m_local_psk_hint, 32);
 	copy_mem(&m_local_psk_hint[0], TEST_PSK_HINT_STRING,
 		 sizeof(TEST_PSK_HINT_STRING));
-	spdm_context->local_context.psk_hint_size =
+	spdm_context->local_context->psk_hint_size =
 		sizeof(TEST_PSK_HINT_STRING);
-	spdm_context->local_context.psk_hint = m_local_psk_hint;
+	spdm_context->local_context->psk_hint = m_local_psk_hint;
 
 	session_id = 0xFFFFFFFF;
 	session_info = &spdm_context->session_info[0];
 	spdm_session_info_init(spdm_context, session_info, session_id, TRUE);
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 0
+	// message_k is empty, only seed the TH hash context with A.
+	spdm_append_message_k(spdm_context, session_info, TRUE, NULL, 0);
+#endif
 	spdm_secured_message_set_session_state(
 		session_info->secured_message_context,
 		SPDM_SESSION_STATE_HANDSHAKING);
@@ -1258,9 +1294,9 @@ void test_spdm_requester_psk_finish_case10(void **state) {
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_PSK_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_ENCRYPT_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MAC_CAP;
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_PSK_CAP;
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP;
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_PSK_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP;
   read_responder_public_certificate_chain (m_use_hash_algo, m_use_asym_algo, &data, &data_size, &hash, &hash_size);
   spdm_context->connection_info.algorithm.base_hash_algo = m_use_hash_algo;
   spdm_context->connection_info.algorithm.base_asym_algo = m_use_asym_algo;
@@ -1270,8 +1306,8 @@ void test_spdm_requester_psk_finish_case10(void **state) {
   copy_mem (spdm_context->connection_info.peer_used_cert_chain_buffer, data, data_size);
   zero_mem (m_local_psk_hint, 32);
   copy_mem (&m_local_psk_hint[0], TEST_PSK_HINT_STRING, sizeof(TEST_PSK_HINT_STRING));
-  spdm_context->local_context.psk_hint_size = sizeof(TEST_PSK_HINT_STRING);
-  spdm_context->local_context.psk_hint = m_local_psk_hint;
+  spdm_context->local_context->psk_hint_size = sizeof(TEST_PSK_HINT_STRING);
+  spdm_context->local_context->psk_hint = m_local_psk_hint;
 
   error_code = SPDM_ERROR_CODE_RESERVED_00;
   while(error_code <= 0xff) {
@@ -1281,6 +1317,10 @@ void test_spdm_requester_psk_finish_case10(void **state) {
     session_id = 0xFFFFFFFF;
     session_info = &spdm_context->session_info[0];
     spdm_session_info_init (spdm_context, session_info, session_id, TRUE);
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 0
+    // message_k is empty, only seed the TH hash context with A.
+    spdm_append_message_k(spdm_context, session_info, TRUE, NULL, 0);
+#endif
     spdm_secured_message_set_session_state (session_info->secured_message_context, SPDM_SESSION_STATE_HANDSHAKING);  
     set_mem (m_dummy_key_buffer, ((spdm_secured_message_context_t*)(session_info->secured_message_context))->aead_key_size, (uint8)(0xFF));
     spdm_secured_message_set_response_handshake_encryption_key (session_info->secured_message_context, m_dummy_key_buffer, ((spdm_secured_message_context_t*)(session_info->secured_message_context))->aead_key_size);
@@ -1330,11 +1370,11 @@ void test_spdm_requester_psk_finish_case11(void **state)
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_ENCRYPT_CAP;
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MAC_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_PSK_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP;
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data,
@@ -1342,6 +1382,7 @@ void test_spdm_requester_psk_finish_case11(void **state)
 	spdm_context->transcript.message_a.buffer_size = 0;
 	spdm_context->transcript.message_m.buffer_size =
 							spdm_context->transcript.message_m.max_buffer_size;
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	spdm_context->transcript.message_b.buffer_size =
 							spdm_context->transcript.message_b.max_buffer_size;
 	spdm_context->transcript.message_c.buffer_size =
@@ -1350,6 +1391,7 @@ void test_spdm_requester_psk_finish_case11(void **state)
 							spdm_context->transcript.message_mut_b.max_buffer_size;
 	spdm_context->transcript.message_mut_c.buffer_size =
 							spdm_context->transcript.message_mut_c.max_buffer_size;
+#endif
 
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -1366,13 +1408,17 @@ void test_spdm_requester_psk_finish_case11(void **state)
 	zero_mem(m_local_psk_hint, 32);
 	copy_mem(&m_local_psk_hint[0], TEST_PSK_HINT_STRING,
 		 sizeof(TEST_PSK_HINT_STRING));
-	spdm_context->local_context.psk_hint_size =
+	spdm_context->local_context->psk_hint_size =
 		sizeof(TEST_PSK_HINT_STRING);
-	spdm_context->local_context.psk_hint = m_local_psk_hint;
+	spdm_context->local_context->psk_hint = m_local_psk_hint;
 
 	session_id = 0xFFFFFFFF;
 	session_info = &spdm_context->session_info[0];
 	spdm_session_info_init(spdm_context, session_info, session_id, TRUE);
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 0
+	// message_k is empty, only seed the TH hash context with A.
+	spdm_append_message_k(spdm_context, session_info, TRUE, NULL, 0);
+#endif
 	spdm_secured_message_set_session_state(
 		session_info->secured_message_context,
 		SPDM_SESSION_STATE_HANDSHAKING);
@@ -1407,10 +1453,12 @@ void test_spdm_requester_psk_finish_case11(void **state)
 			spdm_context->session_info[0].secured_message_context),
 		SPDM_SESSION_STATE_ESTABLISHED);
 	assert_int_equal(spdm_context->transcript.message_m.buffer_size, 0);
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	assert_int_equal(spdm_context->transcript.message_b.buffer_size, 0);
 	assert_int_equal(spdm_context->transcript.message_c.buffer_size, 0);
 	assert_int_equal(spdm_context->transcript.message_mut_b.buffer_size, 0);
 	assert_int_equal(spdm_context->transcript.message_mut_c.buffer_size, 0);
+#endif
 	free(data);
 }
 
@@ -0,0 +1,280 @@
+/**
+    Copyright Notice:
+    Copyright 2021 DMTF. All rights reserved.
+    License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+**/
+
+#include "spdm_unit_test.h"
+#include <spdm_requester_lib_internal.h>
+
+#if OPENSPDM_REQUESTER_STATISTICS_SUPPORT == 1
+
+#define SPDM_STATISTICS_TEST_TIME_STEP 100
+
+#pragma pack(1)
+typedef struct {
+	spdm_message_header_t header;
+	uint8 reserved;
+	uint8 version_number_entry_count;
+	spdm_version_number_t version_number_entry[1];
+} spdm_statistics_test_version_response_t;
+#pragma pack()
+
+static spdm_requester_statistics_t m_spdm_statistics;
+
+static uint64 m_spdm_statistics_test_timestamp;
+
+//
+// The number of BUSY errors returned before the VERSION response.
+//
+static uintn m_spdm_statistics_test_busy_count;
+
+/**
+  Return a timestamp that advances by SPDM_STATISTICS_TEST_TIME_STEP on each call.
+**/
+uint64 spdm_requester_statistics_test_get_timestamp(void)
+{
+	m_spdm_statistics_test_timestamp += SPDM_STATISTICS_TEST_TIME_STEP;
+	return m_spdm_statistics_test_timestamp;
+}
+
+return_status spdm_requester_statistics_test_send_message(
+	IN void *spdm_context, IN uintn request_size, IN void *request,
+	IN uint64 timeout)
+{
+	return RETURN_SUCCESS;
+}
+
+return_status spdm_requester_statistics_test_receive_message(
+	IN void *spdm_context, IN OUT uintn *response_size,
+	IN OUT void *response, IN uint64 timeout)
+{
+	spdm_error_response_t spdm_error_response;
+	spdm_statistics_test_version_response_t spdm_response;
+
+	if (m_spdm_statistics_test_busy_count != 0) {
+		m_spdm_statistics_test_busy_count--;
+		zero_mem(&spdm_error_response, sizeof(spdm_error_response));
+		spdm_error_response.header.spdm_version =
+			SPDM_MESSAGE_VERSION_10;
+		spdm_error_response.header.request_response_code = SPDM_ERROR;
+		spdm_error_response.header.param1 = SPDM_ERROR_CODE_BUSY;
+		spdm_transport_test_encode_message(spdm_context, NULL, FALSE,
+						   FALSE,
+						   sizeof(spdm_error_response),
+						   &spdm_error_response,
+						   response_size, response);
+		return RETURN_SUCCESS;
+	}
+
+	zero_mem(&spdm_response, sizeof(spdm_response));
+	spdm_response.header.spdm_version = SPDM_MESSAGE_VERSION_10;
+	spdm_response.header.request_response_code = SPDM_VERSION;
+	spdm_response.version_number_entry_count = 1;
+	spdm_response.version_number_entry[0].major_version = 1;
+	spdm_response.version_number_entry[0].minor_version = 1;
+	spdm_transport_test_encode_message(spdm_context, NULL, FALSE, FALSE,
+					   sizeof(spdm_response),
+					   &spdm_response, response_size,
+					   response);
+	return RETURN_SUCCESS;
+}
+
+/**
+  Read the requester statistics.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+**/
+static void spdm_requester_statistics_test_get(IN spdm_context_t *spdm_context)
+{
+	spdm_data_parameter_t parameter;
+	uintn data_size;
+
+	zero_mem(&parameter, sizeof(parameter));
+	parameter.location = SPDM_DATA_LOCATION_LOCAL;
+	data_size = sizeof(m_spdm_statistics);
+	assert_int_equal(spdm_get_data(spdm_context,
+				       SPDM_DATA_REQUESTER_STATISTICS,
+				       &parameter, &m_spdm_statistics,
+				       &data_size),
+			 RETURN_SUCCESS);
+	assert_int_equal(data_size, sizeof(m_spdm_statistics));
+}
+
+/**
+  Reset the requester statistics with a zeroed struct.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+**/
+static void spdm_requester_statistics_test_reset(IN spdm_context_t *spdm_context)
+{
+	spdm_data_parameter_t parameter;
+
+	zero_mem(&parameter, sizeof(parameter));
+	parameter.location = SPDM_DATA_LOCATION_LOCAL;
+	zero_mem(&m_spdm_statistics, sizeof(m_spdm_statistics));
+	assert_int_equal(spdm_set_data(spdm_context,
+				       SPDM_DATA_REQUESTER_STATISTICS,
+				       &parameter, &m_spdm_statistics,
+				       sizeof(m_spdm_statistics)),
+			 RETURN_SUCCESS);
+}
+
+/**
+  Test 1: GET_VERSION gets BUSY once, then VERSION
+  Expected Behavior: GET_VERSION counts two requests and one BUSY, and the encode, send,
+  receive and decode time are recorded for both round trips.
+**/
+void test_spdm_requester_statistics_case1(void **state)
+{
+	return_status status;
+	spdm_test_context_t *spdm_test_context;
+	spdm_context_t *spdm_context;
+	spdm_requester_request_statistics_t *request_statistics;
+
+	spdm_test_context = *state;
+	spdm_context = spdm_test_context->spdm_context;
+	spdm_context->retry_times = MAX_SPDM_REQUEST_RETRY_TIMES;
+	spdm_requester_statistics_test_reset(spdm_context);
+	m_spdm_statistics_test_timestamp = 0;
+	spdm_register_get_timestamp_func(
+		spdm_context, spdm_requester_statistics_test_get_timestamp);
+
+	m_spdm_statistics_test_busy_count = 1;
+	status = spdm_get_version(spdm_context);
+	assert_int_equal(status, RETURN_SUCCESS);
+
+	spdm_requester_statistics_test_get(spdm_context);
+	request_statistics = &m_spdm_statistics.request
+		[spdm_get_statistics_request_code_index(SPDM_GET_VERSION)];
+	assert_int_equal(request_statistics->request_count, 2);
+	assert_int_equal(request_statistics->busy_count, 1);
+	assert_int_equal(request_statistics->not_ready_count, 0);
+	assert_int_equal(request_statistics->encode_time.count, 2);
+	assert_int_equal(request_statistics->encode_time.total_time,
+			 2 * SPDM_STATISTICS_TEST_TIME_STEP);
+	// 64 <= 100 < 256
+	assert_int_equal(request_statistics->encode_time.histogram[2], 2);
+	assert_int_equal(request_statistics->send_time.count, 2);
+	assert_int_equal(request_statistics->receive_time.count, 2);
+	assert_int_equal(request_statistics->decode_time.count, 2);
+	assert_int_equal(request_statistics->decode_time.min_time,
+			 SPDM_STATISTICS_TEST_TIME_STEP);
+	assert_int_equal(request_statistics->decode_time.max_time,
+			 SPDM_STATISTICS_TEST_TIME_STEP);
+	assert_int_equal(request_statistics->verify_time.count, 0);
+
+	spdm_register_get_timestamp_func(spdm_context, NULL);
+}
+
+/**
+  Test 2: GET_VERSION without a timestamp function, then a statistics reset
+  Expected Behavior: the requests are counted but no time is recorded, and setting a zeroed
+  struct clears the statistics.
+**/
+void test_spdm_requester_statistics_case2(void **state)
+{
+	return_status status;
+	spdm_test_context_t *spdm_test_context;
+	spdm_context_t *spdm_context;
+	spdm_requester_request_statistics_t *request_statistics;
+
+	spdm_test_context = *state;
+	spdm_context = spdm_test_context->spdm_context;
+	spdm_requester_statistics_test_reset(spdm_context);
+
+	m_spdm_statistics_test_busy_count = 0;
+	status = spdm_get_version(spdm_context);
+	assert_int_equal(status, RETURN_SUCCESS);
+
+	spdm_requester_statistics_test_get(spdm_context);
+	request_statistics = &m_spdm_statistics.request
+		[spdm_get_statistics_request_code_index(SPDM_GET_VERSION)];
+	assert_int_equal(request_statistics->request_count, 1);
+	assert_int_equal(request_statistics->busy_count, 0);
+	assert_int_equal(request_statistics->encode_time.count, 0);
+	assert_int_equal(request_statistics->send_time.count, 0);
+	assert_int_equal(request_statistics->receive_time.count, 0);
+	assert_int_equal(request_statistics->decode_time.count, 0);
+
+	spdm_requester_statistics_test_reset(spdm_context);
+	set_mem(&m_spdm_statistics, sizeof(m_spdm_statistics), 0xFF);
+	spdm_requester_statistics_test_get(spdm_context);
+	assert_int_equal(m_spdm_statistics
+				 .request[spdm_get_statistics_request_code_index(
+					 SPDM_GET_VERSION)]
+				 .request_count,
+			 0);
+}
+
+/**
+  Test 3: record a signature verification after CHALLENGE is sent
+  Expected Behavior: the verify time is recorded for the last sent request code.
+**/
+void test_spdm_requester_statistics_case3(void **state)
+{
+	spdm_test_context_t *spdm_test_context;
+	spdm_context_t *spdm_context;
+	uint64 verify_start_time;
+
+	spdm_test_context = *state;
+	spdm_context = spdm_test_context->spdm_context;
+	spdm_requester_statistics_test_reset(spdm_context);
+	m_spdm_statistics_test_timestamp = 0;
+	spdm_register_get_timestamp_func(
+		spdm_context, spdm_requester_statistics_test_get_timestamp);
+
+	spdm_context->statistics_request_code = SPDM_CHALLENGE;
+	verify_start_time = spdm_statistics_get_timestamp(spdm_context);
+	spdm_statistics_add_verify_time(spdm_context, verify_start_time);
+
+	spdm_requester_statistics_test_get(spdm_context);
+	assert_int_equal(m_spdm_statistics
+				 .request[spdm_get_statistics_request_code_index(
+					 SPDM_CHALLENGE)]
+				 .verify_time.count,
+			 1);
+	assert_int_equal(m_spdm_statistics
+				 .request[spdm_get_statistics_request_code_index(
+					 SPDM_CHALLENGE)]
+				 .verify_time.total_time,
+			 SPDM_STATISTICS_TEST_TIME_STEP);
+	assert_int_equal(m_spdm_statistics
+				 .request[spdm_get_statistics_request_code_index(
+					 SPDM_CHALLENGE)]
+				 .request_count,
+			 0);
+
+	spdm_register_get_timestamp_func(spdm_context, NULL);
+}
+
+spdm_test_context_t m_spdm_requester_statistics_test_context = {
+	SPDM_TEST_CONTEXT_SIGNATURE,
+	TRUE,
+	spdm_requester_statistics_test_send_message,
+	spdm_requester_statistics_test_receive_message,
+};
+
+#endif
+
+int spdm_requester_statistics_test_main(void)
+{
+#if OPENSPDM_REQUESTER_STATISTICS_SUPPORT == 1
+	const struct CMUnitTest spdm_requester_statistics_tests[] = {
+		// BUSY + Successful response, with time statistics
+		cmocka_unit_test(test_spdm_requester_statistics_case1),
+		// No timestamp function, and statistics reset
+		cmocka_unit_test(test_spdm_requester_statistics_case2),
+		// Signature verification time
+		cmocka_unit_test(test_spdm_requester_statistics_case3),
+	};
+
+	setup_spdm_test_context(&m_spdm_requester_statistics_test_context);
+
+	return cmocka_run_group_tests(spdm_requester_statistics_tests,
+				      spdm_unit_test_group_setup,
+				      spdm_unit_test_group_teardown);
+#else
+	return 0;
+#endif
+}
@@ -0,0 +1,436 @@
+/**
+    Copyright Notice:
+    Copyright 2021 DMTF. All rights reserved.
+    License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+**/
+
+#include "spdm_unit_test.h"
+#include <spdm_requester_lib_internal.h>
+
+static uint8 m_local_certificate_chain[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+
+static uint8 m_step_slot_mask;
+static uint8 m_step_total_digest_buffer[MAX_HASH_SIZE * MAX_SPDM_SLOT_COUNT];
+
+#if OPENSPDM_REQUESTER_STATISTICS_SUPPORT == 1
+static spdm_requester_statistics_t m_step_requester_statistics;
+#endif
+
+return_status spdm_requester_step_test_send_message(IN void *spdm_context,
+						    IN uintn request_size,
+						    IN void *request,
+						    IN uint64 timeout)
+{
+	//
+	// The step API leaves the transport to the caller.
+	//
+	return RETURN_DEVICE_ERROR;
+}
+
+return_status spdm_requester_step_test_receive_message(
+	IN void *spdm_context, IN OUT uintn *response_size,
+	IN OUT void *response, IN uint64 timeout)
+{
+	return RETURN_DEVICE_ERROR;
+}
+
+/**
+  Prepare a negotiated SPDM context for GET_DIGESTS.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+**/
+static void spdm_requester_step_test_prepare(IN spdm_context_t *spdm_context)
+{
+#if OPENSPDM_REQUESTER_STATISTICS_SUPPORT == 1
+	spdm_data_parameter_t parameter;
+#endif
+
+	spdm_context->connection_info.connection_state =
+		SPDM_CONNECTION_STATE_NEGOTIATED;
+	spdm_context->connection_info.capability.flags |=
+		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
+	spdm_context->connection_info.algorithm.base_hash_algo =
+		m_use_hash_algo;
+	spdm_context->local_context->peer_cert_chain_provision =
+		m_local_certificate_chain;
+	spdm_context->local_context->peer_cert_chain_provision_size =
+		MAX_SPDM_MESSAGE_BUFFER_SIZE;
+	set_mem(m_local_certificate_chain, MAX_SPDM_MESSAGE_BUFFER_SIZE,
+		(uint8)(0xFF));
+	spdm_context->retry_times = MAX_SPDM_REQUEST_RETRY_TIMES;
+	spdm_reset_message_b(spdm_context);
+
+#if OPENSPDM_REQUESTER_STATISTICS_SUPPORT == 1
+	zero_mem(&parameter, sizeof(parameter));
+	parameter.location = SPDM_DATA_LOCATION_LOCAL;
+	zero_mem(&m_step_requester_statistics,
+		 sizeof(m_step_requester_statistics));
+	assert_int_equal(spdm_set_data(spdm_context,
+				       SPDM_DATA_REQUESTER_STATISTICS,
+				       &parameter, &m_step_requester_statistics,
+				       sizeof(m_step_requester_statistics)),
+			 RETURN_SUCCESS);
+#endif
+}
+
+/**
+  Check that the next action is to send a request, and check the request.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  request_code                  The expected request code.
+  @param  param1                        The expected param1 of the request.
+**/
+static void spdm_requester_step_test_expect_request(IN spdm_context_t *spdm_context,
+						    IN uint8 request_code,
+						    IN uint8 param1)
+{
+	spdm_requester_step_action_t action;
+	uint8 transport_message[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+	uintn transport_message_size;
+	uint8 request[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+	uintn request_size;
+	spdm_message_header_t *spdm_request;
+	uint32 *session_id;
+	boolean is_app_message;
+	return_status status;
+
+	transport_message_size = sizeof(transport_message);
+	status = spdm_requester_step(spdm_context, &action,
+				     &transport_message_size,
+				     transport_message);
+	assert_int_equal(status, RETURN_SUCCESS);
+	assert_int_equal(action, SPDM_REQUESTER_STEP_ACTION_SEND);
+
+	request_size = sizeof(request);
+	status = spdm_transport_test_decode_message(
+		spdm_context, &session_id, &is_app_message, TRUE,
+		transport_message_size, transport_message, &request_size,
+		request);
+	assert_int_equal(status, RETURN_SUCCESS);
+	assert_null(session_id);
+	assert_false(is_app_message);
+	spdm_request = (void *)request;
+	assert_int_equal(spdm_request->request_response_code, request_code);
+	assert_int_equal(spdm_request->param1, param1);
+
+	//
+	// The operation now waits for the response.
+	//
+	transport_message_size = sizeof(transport_message);
+	status = spdm_requester_step(spdm_context, &action,
+				     &transport_message_size,
+				     transport_message);
+	assert_int_equal(status, RETURN_SUCCESS);
+	assert_int_equal(action, SPDM_REQUESTER_STEP_ACTION_RECEIVE);
+}
+
+/**
+  Feed an SPDM response to the pending operation.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  response_size                 size in bytes of the SPDM response.
+  @param  response                      A pointer to the SPDM response.
+**/
+static void spdm_requester_step_test_respond(IN spdm_context_t *spdm_context,
+					     IN uintn response_size,
+					     IN void *response)
+{
+	uint8 transport_message[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+	uintn transport_message_size;
+
+	transport_message_size = sizeof(transport_message);
+	spdm_transport_test_encode_message(spdm_context, NULL, FALSE, FALSE,
+					   response_size, response,
+					   &transport_message_size,
+					   transport_message);
+	assert_int_equal(spdm_requester_step_receive(spdm_context,
+						     transport_message_size,
+						     transport_message),
+			 RETURN_SUCCESS);
+}
+
+/**
+  Feed an ERROR response to the pending operation.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  error_code                    The error code of the ERROR response.
+**/
+static void spdm_requester_step_test_respond_error(IN spdm_context_t *spdm_context,
+						   IN uint8 error_code)
+{
+	spdm_error_response_data_response_not_ready_t spdm_response;
+	uintn spdm_response_size;
+
+	zero_mem(&spdm_response, sizeof(spdm_response));
+	spdm_response.header.spdm_version = SPDM_MESSAGE_VERSION_10;
+	spdm_response.header.request_response_code = SPDM_ERROR;
+	spdm_response.header.param1 = error_code;
+	spdm_response.header.param2 = 0;
+	spdm_response_size = sizeof(spdm_error_response_t);
+	if (error_code == SPDM_ERROR_CODE_RESPONSE_NOT_READY) {
+		spdm_response.extend_error_data.rd_exponent = 1;
+		spdm_response.extend_error_data.rd_tm = 1;
+		spdm_response.extend_error_data.request_code = SPDM_GET_DIGESTS;
+		spdm_response.extend_error_data.token = 0x5A;
+		spdm_response_size = sizeof(spdm_response);
+	}
+	spdm_requester_step_test_respond(spdm_context, spdm_response_size,
+					 &spdm_response);
+}
+
+/**
+  Feed a DIGESTS response with the digest of slot 0 to the pending operation.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+**/
+static void spdm_requester_step_test_respond_digests(IN spdm_context_t *spdm_context)
+{
+	spdm_digest_response_t *spdm_response;
+	uint8 temp_buf[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+	uintn temp_buf_size;
+
+	temp_buf_size = sizeof(spdm_digest_response_t) +
+			spdm_get_hash_size(m_use_hash_algo);
+	spdm_response = (void *)temp_buf;
+	spdm_response->header.spdm_version = SPDM_MESSAGE_VERSION_10;
+	spdm_response->header.request_response_code = SPDM_DIGESTS;
+	spdm_response->header.param1 = 0;
+	spdm_response->header.param2 = (1 << 0);
+	spdm_hash_all(m_use_hash_algo, m_local_certificate_chain,
+		      MAX_SPDM_MESSAGE_BUFFER_SIZE, (void *)(spdm_response + 1));
+	spdm_requester_step_test_respond(spdm_context, temp_buf_size, temp_buf);
+}
+
+/**
+  Check that the operation is complete with a status.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  expected_status               The expected status of the operation.
+**/
+static void spdm_requester_step_test_expect_done(IN spdm_context_t *spdm_context,
+						 IN return_status expected_status)
+{
+	spdm_requester_step_action_t action;
+	uint8 transport_message[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+	uintn transport_message_size;
+	return_status status;
+
+	transport_message_size = sizeof(transport_message);
+	status = spdm_requester_step(spdm_context, &action,
+				     &transport_message_size,
+				     transport_message);
+	assert_int_equal(status, expected_status);
+	assert_int_equal(action, SPDM_REQUESTER_STEP_ACTION_DONE);
+
+	//
+	// No operation is pending any more.
+	//
+	transport_message_size = sizeof(transport_message);
+	status = spdm_requester_step(spdm_context, &action,
+				     &transport_message_size,
+				     transport_message);
+	assert_int_equal(status, RETURN_NOT_STARTED);
+	assert_int_equal(action, SPDM_REQUESTER_STEP_ACTION_DONE);
+}
+
+/**
+  Test 1: GET_DIGESTS receives ResponseNotReady, then the response to RESPOND_IF_READY
+  Expected Behavior: the next step sends RESPOND_IF_READY with the request code and token of
+  the ERROR response, and the operation completes with the digests.
+**/
+void test_spdm_requester_step_case1(void **state)
+{
+	spdm_test_context_t *spdm_test_context;
+	spdm_context_t *spdm_context;
+
+	spdm_test_context = *state;
+	spdm_context = spdm_test_context->spdm_context;
+	spdm_test_context->case_id = 0x1;
+	spdm_requester_step_test_prepare(spdm_context);
+
+	m_step_slot_mask = 0;
+	zero_mem(m_step_total_digest_buffer, sizeof(m_step_total_digest_buffer));
+	assert_int_equal(spdm_begin_get_digest(spdm_context, &m_step_slot_mask,
+					       m_step_total_digest_buffer),
+			 RETURN_SUCCESS);
+	spdm_requester_step_test_expect_request(spdm_context, SPDM_GET_DIGESTS,
+						0);
+	spdm_requester_step_test_respond_error(
+		spdm_context, SPDM_ERROR_CODE_RESPONSE_NOT_READY);
+	spdm_requester_step_test_expect_request(
+		spdm_context, SPDM_RESPOND_IF_READY, SPDM_GET_DIGESTS);
+	spdm_requester_step_test_respond_digests(spdm_context);
+	spdm_requester_step_test_expect_done(spdm_context, RETURN_SUCCESS);
+	assert_int_equal(m_step_slot_mask, 0x01);
+
+#if OPENSPDM_REQUESTER_STATISTICS_SUPPORT == 1
+	//
+	// RESPOND_IF_READY is counted for GET_DIGESTS.
+	//
+	assert_int_equal(spdm_context->requester_statistics
+				 .request[spdm_get_statistics_request_code_index(
+					 SPDM_GET_DIGESTS)]
+				 .request_count,
+			 2);
+	assert_int_equal(spdm_context->requester_statistics
+				 .request[spdm_get_statistics_request_code_index(
+					 SPDM_GET_DIGESTS)]
+				 .not_ready_count,
+			 1);
+	assert_int_equal(spdm_context->requester_statistics
+				 .request[spdm_get_statistics_request_code_index(
+					 SPDM_RESPOND_IF_READY)]
+				 .request_count,
+			 0);
+#endif
+}
+
+/**
+  Test 2: GET_DIGESTS receives Busy, first with retries left, then with no retry left
+  Expected Behavior: with retries left, the next step sends GET_DIGESTS again and the operation
+  completes with the digests. With no retry left, the operation completes with RETURN_NO_RESPONSE.
+**/
+void test_spdm_requester_step_case2(void **state)
+{
+	spdm_test_context_t *spdm_test_context;
+	spdm_context_t *spdm_context;
+
+	spdm_test_context = *state;
+	spdm_context = spdm_test_context->spdm_context;
+	spdm_test_context->case_id = 0x2;
+	spdm_requester_step_test_prepare(spdm_context);
+
+	m_step_slot_mask = 0;
+	assert_int_equal(spdm_begin_get_digest(spdm_context, &m_step_slot_mask,
+					       m_step_total_digest_buffer),
+			 RETURN_SUCCESS);
+	spdm_requester_step_test_expect_request(spdm_context, SPDM_GET_DIGESTS,
+						0);
+	spdm_requester_step_test_respond_error(spdm_context,
+					       SPDM_ERROR_CODE_BUSY);
+	spdm_requester_step_test_expect_request(spdm_context, SPDM_GET_DIGESTS,
+						0);
+	spdm_requester_step_test_respond_digests(spdm_context);
+	spdm_requester_step_test_expect_done(spdm_context, RETURN_SUCCESS);
+	assert_int_equal(m_step_slot_mask, 0x01);
+
+#if OPENSPDM_REQUESTER_STATISTICS_SUPPORT == 1
+	assert_int_equal(spdm_context->requester_statistics
+				 .request[spdm_get_statistics_request_code_index(
+					 SPDM_GET_DIGESTS)]
+				 .request_count,
+			 2);
+	assert_int_equal(spdm_context->requester_statistics
+				 .request[spdm_get_statistics_request_code_index(
+					 SPDM_GET_DIGESTS)]
+				 .busy_count,
+			 1);
+#endif
+
+	spdm_context->retry_times = 0;
+	spdm_context->connection_info.connection_state =
+		SPDM_CONNECTION_STATE_NEGOTIATED;
+	spdm_reset_message_b(spdm_context);
+	assert_int_equal(spdm_begin_get_digest(spdm_context, &m_step_slot_mask,
+					       m_step_total_digest_buffer),
+			 RETURN_SUCCESS);
+	spdm_requester_step_test_expect_request(spdm_context, SPDM_GET_DIGESTS,
+						0);
+	spdm_requester_step_test_respond_error(spdm_context,
+					       SPDM_ERROR_CODE_BUSY);
+	spdm_requester_step_test_expect_done(spdm_context, RETURN_NO_RESPONSE);
+	spdm_context->retry_times = MAX_SPDM_REQUEST_RETRY_TIMES;
+}
+
+/**
+  Test 3: abort GET_DIGESTS while it waits for a response, and while it waits to send RESPOND_IF_READY
+  Expected Behavior: after the abort no operation is pending, a late response is not consumed,
+  and the next operation starts with a fresh GET_DIGESTS request.
+**/
+void test_spdm_requester_step_case3(void **state)
+{
+	spdm_test_context_t *spdm_test_context;
+	spdm_context_t *spdm_context;
+	uint8 transport_message[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+
+	spdm_test_context = *state;
+	spdm_context = spdm_test_context->spdm_context;
+	spdm_test_context->case_id = 0x3;
+	spdm_requester_step_test_prepare(spdm_context);
+
+	//
+	// Nothing to abort.
+	//
+	spdm_requester_step_abort(spdm_context);
+	spdm_requester_step_test_expect_done(spdm_context, RETURN_NOT_STARTED);
+
+	assert_int_equal(spdm_begin_get_digest(spdm_context, &m_step_slot_mask,
+					       m_step_total_digest_buffer),
+			 RETURN_SUCCESS);
+	assert_int_equal(spdm_begin_get_digest(spdm_context, &m_step_slot_mask,
+					       m_step_total_digest_buffer),
+			 RETURN_ALREADY_STARTED);
+	spdm_requester_step_test_expect_request(spdm_context, SPDM_GET_DIGESTS,
+						0);
+	spdm_requester_step_abort(spdm_context);
+	zero_mem(transport_message, sizeof(transport_message));
+	assert_int_equal(spdm_requester_step_receive(spdm_context,
+						     sizeof(transport_message),
+						     transport_message),
+			 RETURN_NOT_STARTED);
+	spdm_requester_step_test_expect_done(spdm_context, RETURN_NOT_STARTED);
+
+	//
+	// Abort between ResponseNotReady and RESPOND_IF_READY.
+	//
+	spdm_reset_message_b(spdm_context);
+	assert_int_equal(spdm_begin_get_digest(spdm_context, &m_step_slot_mask,
+					       m_step_total_digest_buffer),
+			 RETURN_SUCCESS);
+	spdm_requester_step_test_expect_request(spdm_context, SPDM_GET_DIGESTS,
+						0);
+	spdm_requester_step_test_respond_error(
+		spdm_context, SPDM_ERROR_CODE_RESPONSE_NOT_READY);
+	spdm_requester_step_abort(spdm_context);
+	assert_false(spdm_context->requester_step.respond_if_ready);
+	spdm_requester_step_test_expect_done(spdm_context, RETURN_NOT_STARTED);
+
+	//
+	// The next operation sends GET_DIGESTS, not RESPOND_IF_READY.
+	//
+	spdm_reset_message_b(spdm_context);
+	m_step_slot_mask = 0;
+	assert_int_equal(spdm_begin_get_digest(spdm_context, &m_step_slot_mask,
+					       m_step_total_digest_buffer),
+			 RETURN_SUCCESS);
+	spdm_requester_step_test_expect_request(spdm_context, SPDM_GET_DIGESTS,
+						0);
+	spdm_requester_step_test_respond_digests(spdm_context);
+	spdm_requester_step_test_expect_done(spdm_context, RETURN_SUCCESS);
+	assert_int_equal(m_step_slot_mask, 0x01);
+}
+
+spdm_test_context_t m_spdm_requester_step_test_context = {
+	SPDM_TEST_CONTEXT_SIGNATURE,
+	TRUE,
+	spdm_requester_step_test_send_message,
+	spdm_requester_step_test_receive_message,
+};
+
+int spdm_requester_step_test_main(void)
+{
+	const struct CMUnitTest spdm_requester_step_tests[] = {
+		// ResponseNotReady + RESPOND_IF_READY
+		cmocka_unit_test(test_spdm_requester_step_case1),
+		// Busy with and without retries left
+		cmocka_unit_test(test_spdm_requester_step_case2),
+		// Abort
+		cmocka_unit_test(test_spdm_requester_step_case3),
+	};
+
+	setup_spdm_test_context(&m_spdm_requester_step_test_context);
+
+	return cmocka_run_group_tests(spdm_requester_step_tests,
+				      spdm_unit_test_group_setup,
+				      spdm_unit_test_group_teardown);
+}
@@ -20,6 +20,9 @@ int spdm_requester_psk_exchange_test_main(void);
 int spdm_requester_psk_finish_test_main(void);
 int spdm_requester_heartbeat_test_main(void);
 int spdm_requester_end_session_test_main(void);
+int spdm_requester_step_test_main(void);
+int spdm_requester_attestation_manager_test_main(void);
+int spdm_requester_statistics_test_main(void);
 
 int main(void)
 {
@@ -77,5 +80,17 @@ int main(void)
 		return_value = 1;
 	}
 
+	if (spdm_requester_step_test_main() != 0) {
+		return_value = 1;
+	}
+
+	if (spdm_requester_attestation_manager_test_main() != 0) {
+		return_value = 1;
+	}
+
+	if (spdm_requester_statistics_test_main() != 0) {
+		return_value = 1;
+	}
+
 	return return_value;
 }
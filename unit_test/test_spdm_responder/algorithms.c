@@ -674,11 +674,11 @@ void test_spdm_responder_algorithms_case1(void **state)
 	spdm_test_context->case_id = 0x1;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AFTER_CAPABILITIES;
-	spdm_context->local_context.algorithm.base_hash_algo = m_use_hash_algo;
-	spdm_context->local_context.algorithm.base_asym_algo = m_use_asym_algo;
-	spdm_context->local_context.algorithm.measurement_spec =
+	spdm_context->local_context->algorithm.base_hash_algo = m_use_hash_algo;
+	spdm_context->local_context->algorithm.base_asym_algo = m_use_asym_algo;
+	spdm_context->local_context->algorithm.measurement_spec =
 		m_use_measurement_spec;
-	spdm_context->local_context.algorithm.measurement_hash_algo =
+	spdm_context->local_context->algorithm.measurement_hash_algo =
 		m_use_measurement_hash_algo;
 
 	response_size = sizeof(response);
@@ -707,11 +707,11 @@ void test_spdm_responder_algorithms_case2(void **state)
 	spdm_test_context->case_id = 0x2;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AFTER_CAPABILITIES;
-	spdm_context->local_context.algorithm.base_hash_algo = m_use_hash_algo;
-	spdm_context->local_context.algorithm.base_asym_algo = m_use_asym_algo;
-	spdm_context->local_context.algorithm.measurement_spec =
+	spdm_context->local_context->algorithm.base_hash_algo = m_use_hash_algo;
+	spdm_context->local_context->algorithm.base_asym_algo = m_use_asym_algo;
+	spdm_context->local_context->algorithm.measurement_spec =
 		m_use_measurement_spec;
-	spdm_context->local_context.algorithm.measurement_hash_algo =
+	spdm_context->local_context->algorithm.measurement_hash_algo =
 		m_use_measurement_hash_algo;
 
 	response_size = sizeof(response);
@@ -744,11 +744,11 @@ void test_spdm_responder_algorithms_case3(void **state)
 	spdm_context->response_state = SPDM_RESPONSE_STATE_BUSY;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AFTER_CAPABILITIES;
-	spdm_context->local_context.algorithm.base_hash_algo = m_use_hash_algo;
-	spdm_context->local_context.algorithm.base_asym_algo = m_use_asym_algo;
-	spdm_context->local_context.algorithm.measurement_spec =
+	spdm_context->local_context->algorithm.base_hash_algo = m_use_hash_algo;
+	spdm_context->local_context->algorithm.base_asym_algo = m_use_asym_algo;
+	spdm_context->local_context->algorithm.measurement_spec =
 		m_use_measurement_spec;
-	spdm_context->local_context.algorithm.measurement_hash_algo =
+	spdm_context->local_context->algorithm.measurement_hash_algo =
 		m_use_measurement_hash_algo;
 
 	response_size = sizeof(response);
@@ -782,11 +782,11 @@ void test_spdm_responder_algorithms_case4(void **state)
 	spdm_context->response_state = SPDM_RESPONSE_STATE_NEED_RESYNC;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AFTER_CAPABILITIES;
-	spdm_context->local_context.algorithm.base_hash_algo = m_use_hash_algo;
-	spdm_context->local_context.algorithm.base_asym_algo = m_use_asym_algo;
-	spdm_context->local_context.algorithm.measurement_spec =
+	spdm_context->local_context->algorithm.base_hash_algo = m_use_hash_algo;
+	spdm_context->local_context->algorithm.base_asym_algo = m_use_asym_algo;
+	spdm_context->local_context->algorithm.measurement_spec =
 		m_use_measurement_spec;
-	spdm_context->local_context.algorithm.measurement_hash_algo =
+	spdm_context->local_context->algorithm.measurement_hash_algo =
 		m_use_measurement_hash_algo;
 
 	response_size = sizeof(response);
@@ -822,11 +822,11 @@ void test_spdm_responder_algorithms_case5(void **state)
 	spdm_context->response_state = SPDM_RESPONSE_STATE_NOT_READY;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AFTER_CAPABILITIES;
-	spdm_context->local_context.algorithm.base_hash_algo = m_use_hash_algo;
-	spdm_context->local_context.algorithm.base_asym_algo = m_use_asym_algo;
-	spdm_context->local_context.algorithm.measurement_spec =
+	spdm_context->local_context->algorithm.base_hash_algo = m_use_hash_algo;
+	spdm_context->local_context->algorithm.base_asym_algo = m_use_asym_algo;
+	spdm_context->local_context->algorithm.measurement_spec =
 		m_use_measurement_spec;
-	spdm_context->local_context.algorithm.measurement_hash_algo =
+	spdm_context->local_context->algorithm.measurement_hash_algo =
 		m_use_measurement_hash_algo;
 
 	response_size = sizeof(response);
@@ -866,11 +866,11 @@ void test_spdm_responder_algorithms_case6(void **state)
 	spdm_context->response_state = SPDM_RESPONSE_STATE_NORMAL;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_NOT_STARTED;
-	spdm_context->local_context.algorithm.base_hash_algo = m_use_hash_algo;
-	spdm_context->local_context.algorithm.base_asym_algo = m_use_asym_algo;
-	spdm_context->local_context.algorithm.measurement_spec =
+	spdm_context->local_context->algorithm.base_hash_algo = m_use_hash_algo;
+	spdm_context->local_context->algorithm.base_asym_algo = m_use_asym_algo;
+	spdm_context->local_context->algorithm.measurement_spec =
 		m_use_measurement_spec;
-	spdm_context->local_context.algorithm.measurement_hash_algo =
+	spdm_context->local_context->algorithm.measurement_hash_algo =
 		m_use_measurement_hash_algo;
 
 	response_size = sizeof(response);
@@ -903,30 +903,30 @@ void test_spdm_responder_algorithms_case7(void **state) {
   spdm_context->connection_info.version.spdm_version_count = 1;
   spdm_context->connection_info.version.spdm_version[0].major_version = 1;
   spdm_context->connection_info.version.spdm_version[0].minor_version = 1;
-  spdm_context->local_context.algorithm.base_hash_algo = m_use_hash_algo;
-  spdm_context->local_context.algorithm.base_asym_algo = m_use_asym_algo;
-  spdm_context->local_context.algorithm.measurement_spec = m_use_measurement_spec;
-  spdm_context->local_context.algorithm.measurement_hash_algo = m_use_measurement_hash_algo;
-  spdm_context->local_context.algorithm.dhe_named_group = m_use_dhe_algo;
-  spdm_context->local_context.algorithm.aead_cipher_suite = m_use_aead_algo;
-  spdm_context->local_context.algorithm.req_base_asym_alg = m_use_req_asym_algo;
-  spdm_context->local_context.algorithm.key_schedule = m_use_key_schedule_algo;
+  spdm_context->local_context->algorithm.base_hash_algo = m_use_hash_algo;
+  spdm_context->local_context->algorithm.base_asym_algo = m_use_asym_algo;
+  spdm_context->local_context->algorithm.measurement_spec = m_use_measurement_spec;
+  spdm_context->local_context->algorithm.measurement_hash_algo = m_use_measurement_hash_algo;
+  spdm_context->local_context->algorithm.dhe_named_group = m_use_dhe_algo;
+  spdm_context->local_context->algorithm.aead_cipher_suite = m_use_aead_algo;
+  spdm_context->local_context->algorithm.req_base_asym_alg = m_use_req_asym_algo;
+  spdm_context->local_context->algorithm.key_schedule = m_use_key_schedule_algo;
 
   spdm_context->transcript.message_a.buffer_size = 0;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_KEY_EX_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_ENCRYPT_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MAC_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MUT_AUTH_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MUT_AUTH_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MUT_AUTH_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_PSK_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_PSK_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_PSK_CAP;
 
   response_size = sizeof(response);
@@ -937,10 +937,10 @@ void test_spdm_responder_algorithms_case7(void **state) {
   assert_int_equal (spdm_response->header.request_response_code, SPDM_ALGORITHMS);
   assert_int_equal (spdm_response->header.spdm_version, SPDM_MESSAGE_VERSION_11);
 
-  assert_int_equal (spdm_response->struct_table[0].alg_supported, spdm_context->local_context.algorithm.dhe_named_group);
-  assert_int_equal (spdm_response->struct_table[1].alg_supported, spdm_context->local_context.algorithm.aead_cipher_suite);
-  assert_int_equal (spdm_response->struct_table[2].alg_supported, spdm_context->local_context.algorithm.req_base_asym_alg);
-  assert_int_equal (spdm_response->struct_table[3].alg_supported, spdm_context->local_context.algorithm.key_schedule);
+  assert_int_equal (spdm_response->struct_table[0].alg_supported, spdm_context->local_context->algorithm.dhe_named_group);
+  assert_int_equal (spdm_response->struct_table[1].alg_supported, spdm_context->local_context->algorithm.aead_cipher_suite);
+  assert_int_equal (spdm_response->struct_table[2].alg_supported, spdm_context->local_context->algorithm.req_base_asym_alg);
+  assert_int_equal (spdm_response->struct_table[3].alg_supported, spdm_context->local_context->algorithm.key_schedule);
 }
 
 void test_spdm_responder_algorithms_case8(void **state) {
@@ -958,33 +958,33 @@ void test_spdm_responder_algorithms_case8(void **state) {
   spdm_context->connection_info.version.spdm_version_count = 1;
   spdm_context->connection_info.version.spdm_version[0].major_version = 1;
   spdm_context->connection_info.version.spdm_version[0].minor_version = 1;
-  spdm_context->local_context.algorithm.base_hash_algo = m_use_hash_algo;
-  spdm_context->local_context.algorithm.base_asym_algo = m_use_asym_algo;
-  spdm_context->local_context.algorithm.measurement_spec = m_use_measurement_spec;
-  spdm_context->local_context.algorithm.measurement_hash_algo = m_use_measurement_hash_algo;
-  spdm_context->local_context.algorithm.dhe_named_group = m_use_dhe_algo;
-  spdm_context->local_context.algorithm.aead_cipher_suite = m_use_aead_algo;
-  spdm_context->local_context.algorithm.req_base_asym_alg = m_use_req_asym_algo;
-  spdm_context->local_context.algorithm.key_schedule = m_use_key_schedule_algo;
+  spdm_context->local_context->algorithm.base_hash_algo = m_use_hash_algo;
+  spdm_context->local_context->algorithm.base_asym_algo = m_use_asym_algo;
+  spdm_context->local_context->algorithm.measurement_spec = m_use_measurement_spec;
+  spdm_context->local_context->algorithm.measurement_hash_algo = m_use_measurement_hash_algo;
+  spdm_context->local_context->algorithm.dhe_named_group = m_use_dhe_algo;
+  spdm_context->local_context->algorithm.aead_cipher_suite = m_use_aead_algo;
+  spdm_context->local_context->algorithm.req_base_asym_alg = m_use_req_asym_algo;
+  spdm_context->local_context->algorithm.key_schedule = m_use_key_schedule_algo;
 
   spdm_context->transcript.message_a.buffer_size = 0;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_CHAL_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_CHAL_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CHAL_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_KEY_EX_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_ENCRYPT_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MAC_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MUT_AUTH_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MUT_AUTH_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MUT_AUTH_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_PSK_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_PSK_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_PSK_CAP;
 
   response_size = sizeof(response);
@@ -1012,33 +1012,33 @@ void test_spdm_responder_algorithms_case9(void **state) {
   spdm_context->connection_info.version.spdm_version_count = 1;
   spdm_context->connection_info.version.spdm_version[0].major_version = 1;
   spdm_context->connection_info.version.spdm_version[0].minor_version = 1;
-  spdm_context->local_context.algorithm.base_hash_algo = m_use_hash_algo;
-  spdm_context->local_context.algorithm.base_asym_algo = m_use_asym_algo;
-  spdm_context->local_context.algorithm.measurement_spec = m_use_measurement_spec;
-  spdm_context->local_context.algorithm.measurement_hash_algo = m_use_measurement_hash_algo;
-  spdm_context->local_context.algorithm.dhe_named_group = m_use_dhe_algo;
-  spdm_context->local_context.algorithm.aead_cipher_suite = m_use_aead_algo;
-  spdm_context->local_context.algorithm.req_base_asym_alg = m_use_req_asym_algo;
-  spdm_context->local_context.algorithm.key_schedule = m_use_key_schedule_algo;
+  spdm_context->local_context->algorithm.base_hash_algo = m_use_hash_algo;
+  spdm_context->local_context->algorithm.base_asym_algo = m_use_asym_algo;
+  spdm_context->local_context->algorithm.measurement_spec = m_use_measurement_spec;
+  spdm_context->local_context->algorithm.measurement_hash_algo = m_use_measurement_hash_algo;
+  spdm_context->local_context->algorithm.dhe_named_group = m_use_dhe_algo;
+  spdm_context->local_context->algorithm.aead_cipher_suite = m_use_aead_algo;
+  spdm_context->local_context->algorithm.req_base_asym_alg = m_use_req_asym_algo;
+  spdm_context->local_context->algorithm.key_schedule = m_use_key_schedule_algo;
 
   spdm_context->transcript.message_a.buffer_size = 0;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_CHAL_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_CHAL_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CHAL_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_KEY_EX_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_ENCRYPT_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MAC_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MUT_AUTH_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MUT_AUTH_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MUT_AUTH_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_PSK_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_PSK_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_PSK_CAP;
 
   response_size = sizeof(response);
@@ -1066,33 +1066,33 @@ void test_spdm_responder_algorithms_case10(void **state) {
   spdm_context->connection_info.version.spdm_version_count = 1;
   spdm_context->connection_info.version.spdm_version[0].major_version = 1;
   spdm_context->connection_info.version.spdm_version[0].minor_version = 1;
-  spdm_context->local_context.algorithm.base_hash_algo = m_use_hash_algo;
-  spdm_context->local_context.algorithm.base_asym_algo = m_use_asym_algo;
-  spdm_context->local_context.algorithm.measurement_spec = m_use_measurement_spec;
-  spdm_context->local_context.algorithm.measurement_hash_algo = m_use_measurement_hash_algo;
-  spdm_context->local_context.algorithm.dhe_named_group = m_use_dhe_algo;
-  spdm_context->local_context.algorithm.aead_cipher_suite = m_use_aead_algo;
-  spdm_context->local_context.algorithm.req_base_asym_alg = m_use_req_asym_algo;
-  spdm_context->local_context.algorithm.key_schedule = m_use_key_schedule_algo;
+  spdm_context->local_context->algorithm.base_hash_algo = m_use_hash_algo;
+  spdm_context->local_context->algorithm.base_asym_algo = m_use_asym_algo;
+  spdm_context->local_context->algorithm.measurement_spec = m_use_measurement_spec;
+  spdm_context->local_context->algorithm.measurement_hash_algo = m_use_measurement_hash_algo;
+  spdm_context->local_context->algorithm.dhe_named_group = m_use_dhe_algo;
+  spdm_context->local_context->algorithm.aead_cipher_suite = m_use_aead_algo;
+  spdm_context->local_context->algorithm.req_base_asym_alg = m_use_req_asym_algo;
+  spdm_context->local_context->algorithm.key_schedule = m_use_key_schedule_algo;
 
   spdm_context->transcript.message_a.buffer_size = 0;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_CHAL_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_CHAL_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CHAL_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_KEY_EX_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_ENCRYPT_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MAC_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MUT_AUTH_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MUT_AUTH_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MUT_AUTH_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_PSK_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_PSK_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_PSK_CAP;
 
   response_size = sizeof(response);
@@ -1120,33 +1120,33 @@ void test_spdm_responder_algorithms_case11(void **state) {
   spdm_context->connection_info.version.spdm_version_count = 1;
   spdm_context->connection_info.version.spdm_version[0].major_version = 1;
   spdm_context->connection_info.version.spdm_version[0].minor_version = 1;
-  spdm_context->local_context.algorithm.base_hash_algo = m_use_hash_algo;
-  spdm_context->local_context.algorithm.base_asym_algo = m_use_asym_algo;
-  spdm_context->local_context.algorithm.measurement_spec = m_use_measurement_spec;
-  spdm_context->local_context.algorithm.measurement_hash_algo = m_use_measurement_hash_algo;
-  spdm_context->local_context.algorithm.dhe_named_group = m_use_dhe_algo;
-  spdm_context->local_context.algorithm.aead_cipher_suite = m_use_aead_algo;
-  spdm_context->local_context.algorithm.req_base_asym_alg = m_use_req_asym_algo;
-  spdm_context->local_context.algorithm.key_schedule = m_use_key_schedule_algo;
+  spdm_context->local_context->algorithm.base_hash_algo = m_use_hash_algo;
+  spdm_context->local_context->algorithm.base_asym_algo = m_use_asym_algo;
+  spdm_context->local_context->algorithm.measurement_spec = m_use_measurement_spec;
+  spdm_context->local_context->algorithm.measurement_hash_algo = m_use_measurement_hash_algo;
+  spdm_context->local_context->algorithm.dhe_named_group = m_use_dhe_algo;
+  spdm_context->local_context->algorithm.aead_cipher_suite = m_use_aead_algo;
+  spdm_context->local_context->algorithm.req_base_asym_alg = m_use_req_asym_algo;
+  spdm_context->local_context->algorithm.key_schedule = m_use_key_schedule_algo;
 
   spdm_context->transcript.message_a.buffer_size = 0;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_CHAL_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_CHAL_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CHAL_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_KEY_EX_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_ENCRYPT_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MAC_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MUT_AUTH_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MUT_AUTH_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MUT_AUTH_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_PSK_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_PSK_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_PSK_CAP;
 
   response_size = sizeof(response);
@@ -1174,33 +1174,33 @@ void test_spdm_responder_algorithms_case12(void **state) {
   spdm_context->connection_info.version.spdm_version_count = 1;
   spdm_context->connection_info.version.spdm_version[0].major_version = 1;
   spdm_context->connection_info.version.spdm_version[0].minor_version = 1;
-  spdm_context->local_context.algorithm.base_hash_algo = m_use_hash_algo;
-  spdm_context->local_context.algorithm.base_asym_algo = m_use_asym_algo;
-  spdm_context->local_context.algorithm.measurement_spec = m_use_measurement_spec;
-  spdm_context->local_context.algorithm.measurement_hash_algo = m_use_measurement_hash_algo;
-  spdm_context->local_context.algorithm.dhe_named_group = m_use_dhe_algo;
-  spdm_context->local_context.algorithm.aead_cipher_suite = m_use_aead_algo;
-  spdm_context->local_context.algorithm.req_base_asym_alg = m_use_req_asym_algo;
-  spdm_context->local_context.algorithm.key_schedule = m_use_key_schedule_algo;
+  spdm_context->local_context->algorithm.base_hash_algo = m_use_hash_algo;
+  spdm_context->local_context->algorithm.base_asym_algo = m_use_asym_algo;
+  spdm_context->local_context->algorithm.measurement_spec = m_use_measurement_spec;
+  spdm_context->local_context->algorithm.measurement_hash_algo = m_use_measurement_hash_algo;
+  spdm_context->local_context->algorithm.dhe_named_group = m_use_dhe_algo;
+  spdm_context->local_context->algorithm.aead_cipher_suite = m_use_aead_algo;
+  spdm_context->local_context->algorithm.req_base_asym_alg = m_use_req_asym_algo;
+  spdm_context->local_context->algorithm.key_schedule = m_use_key_schedule_algo;
 
   spdm_context->transcript.message_a.buffer_size = 0;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_CHAL_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_CHAL_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CHAL_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_KEY_EX_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_ENCRYPT_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MAC_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MUT_AUTH_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MUT_AUTH_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MUT_AUTH_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_PSK_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_PSK_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_PSK_CAP;
 
   response_size = sizeof(response);
@@ -1227,33 +1227,33 @@ void test_spdm_responder_algorithms_case13(void **state) {
   spdm_context->connection_info.version.spdm_version_count = 1;
   spdm_context->connection_info.version.spdm_version[0].major_version = 1;
   spdm_context->connection_info.version.spdm_version[0].minor_version = 1;
-  spdm_context->local_context.algorithm.base_hash_algo = m_use_hash_algo;
-  spdm_context->local_context.algorithm.base_asym_algo = m_use_asym_algo;
-  spdm_context->local_context.algorithm.measurement_spec = m_use_measurement_spec;
-  spdm_context->local_context.algorithm.measurement_hash_algo = m_use_measurement_hash_algo;
-  spdm_context->local_context.algorithm.dhe_named_group = m_use_dhe_algo;
-  spdm_context->local_context.algorithm.aead_cipher_suite = m_use_aead_algo;
-  spdm_context->local_context.algorithm.req_base_asym_alg = m_use_req_asym_algo;
-  spdm_context->local_context.algorithm.key_schedule = m_use_key_schedule_algo;
+  spdm_context->local_context->algorithm.base_hash_algo = m_use_hash_algo;
+  spdm_context->local_context->algorithm.base_asym_algo = m_use_asym_algo;
+  spdm_context->local_context->algorithm.measurement_spec = m_use_measurement_spec;
+  spdm_context->local_context->algorithm.measurement_hash_algo = m_use_measurement_hash_algo;
+  spdm_context->local_context->algorithm.dhe_named_group = m_use_dhe_algo;
+  spdm_context->local_context->algorithm.aead_cipher_suite = m_use_aead_algo;
+  spdm_context->local_context->algorithm.req_base_asym_alg = m_use_req_asym_algo;
+  spdm_context->local_context->algorithm.key_schedule = m_use_key_schedule_algo;
 
   spdm_context->transcript.message_a.buffer_size = 0;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_CHAL_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_CHAL_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CHAL_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_KEY_EX_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_ENCRYPT_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MAC_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MUT_AUTH_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MUT_AUTH_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MUT_AUTH_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_PSK_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_PSK_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_PSK_CAP;
 
   response_size = sizeof(response);
@@ -1275,10 +1275,10 @@ void test_spdm_responder_algorithms_case14(void **state) {
   spdm_context->connection_info.version.spdm_version_count = 1;
   spdm_context->connection_info.version.spdm_version[0].major_version = 1;
   spdm_context->connection_info.version.spdm_version[0].minor_version = 0;
-  spdm_context->local_context.algorithm.base_hash_algo = m_use_hash_algo;
-  spdm_context->local_context.algorithm.base_asym_algo = m_use_asym_algo;
-  spdm_context->local_context.algorithm.measurement_spec = m_use_measurement_spec;
-  spdm_context->local_context.algorithm.measurement_hash_algo = m_use_measurement_hash_algo;
+  spdm_context->local_context->algorithm.base_hash_algo = m_use_hash_algo;
+  spdm_context->local_context->algorithm.base_asym_algo = m_use_asym_algo;
+  spdm_context->local_context->algorithm.measurement_spec = m_use_measurement_spec;
+  spdm_context->local_context->algorithm.measurement_hash_algo = m_use_measurement_hash_algo;
 
   spdm_context->transcript.message_a.buffer_size = 0;
 
@@ -1301,30 +1301,30 @@ void test_spdm_responder_algorithms_case15(void **state) {
   spdm_context->connection_info.version.spdm_version_count = 1;
   spdm_context->connection_info.version.spdm_version[0].major_version = 1;
   spdm_context->connection_info.version.spdm_version[0].minor_version = 1;
-  spdm_context->local_context.algorithm.base_hash_algo = m_use_hash_algo;
-  spdm_context->local_context.algorithm.base_asym_algo = m_use_asym_algo;
-  spdm_context->local_context.algorithm.measurement_spec = m_use_measurement_spec;
-  spdm_context->local_context.algorithm.measurement_hash_algo = m_use_measurement_hash_algo;
-  spdm_context->local_context.algorithm.dhe_named_group = m_use_dhe_algo;
-  spdm_context->local_context.algorithm.aead_cipher_suite = m_use_aead_algo;
-  spdm_context->local_context.algorithm.req_base_asym_alg = m_use_req_asym_algo;
-  spdm_context->local_context.algorithm.key_schedule = m_use_key_schedule_algo;
+  spdm_context->local_context->algorithm.base_hash_algo = m_use_hash_algo;
+  spdm_context->local_context->algorithm.base_asym_algo = m_use_asym_algo;
+  spdm_context->local_context->algorithm.measurement_spec = m_use_measurement_spec;
+  spdm_context->local_context->algorithm.measurement_hash_algo = m_use_measurement_hash_algo;
+  spdm_context->local_context->algorithm.dhe_named_group = m_use_dhe_algo;
+  spdm_context->local_context->algorithm.aead_cipher_suite = m_use_aead_algo;
+  spdm_context->local_context->algorithm.req_base_asym_alg = m_use_req_asym_algo;
+  spdm_context->local_context->algorithm.key_schedule = m_use_key_schedule_algo;
 
   spdm_context->transcript.message_a.buffer_size = 0;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_KEY_EX_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_ENCRYPT_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MAC_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MUT_AUTH_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MUT_AUTH_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MUT_AUTH_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_PSK_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_PSK_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_PSK_CAP;
 
   response_size = sizeof(response);
@@ -1347,30 +1347,30 @@ void test_spdm_responder_algorithms_case16(void **state) {
   spdm_context->connection_info.version.spdm_version_count = 1;
   spdm_context->connection_info.version.spdm_version[0].major_version = 1;
   spdm_context->connection_info.version.spdm_version[0].minor_version = 1;
-  spdm_context->local_context.algorithm.base_hash_algo = m_use_hash_algo;
-  spdm_context->local_context.algorithm.base_asym_algo = m_use_asym_algo;
-  spdm_context->local_context.algorithm.measurement_spec = m_use_measurement_spec;
-  spdm_context->local_context.algorithm.measurement_hash_algo = m_use_measurement_hash_algo;
-  spdm_context->local_context.algorithm.dhe_named_group = m_use_dhe_algo;
-  spdm_context->local_context.algorithm.aead_cipher_suite = m_use_aead_algo;
-  spdm_context->local_context.algorithm.req_base_asym_alg = m_use_req_asym_algo;
-  spdm_context->local_context.algorithm.key_schedule = m_use_key_schedule_algo;
+  spdm_context->local_context->algorithm.base_hash_algo = m_use_hash_algo;
+  spdm_context->local_context->algorithm.base_asym_algo = m_use_asym_algo;
+  spdm_context->local_context->algorithm.measurement_spec = m_use_measurement_spec;
+  spdm_context->local_context->algorithm.measurement_hash_algo = m_use_measurement_hash_algo;
+  spdm_context->local_context->algorithm.dhe_named_group = m_use_dhe_algo;
+  spdm_context->local_context->algorithm.aead_cipher_suite = m_use_aead_algo;
+  spdm_context->local_context->algorithm.req_base_asym_alg = m_use_req_asym_algo;
+  spdm_context->local_context->algorithm.key_schedule = m_use_key_schedule_algo;
 
   spdm_context->transcript.message_a.buffer_size = 0;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_KEY_EX_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_ENCRYPT_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MAC_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MUT_AUTH_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MUT_AUTH_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MUT_AUTH_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_PSK_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_PSK_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_PSK_CAP;
 
   response_size = sizeof(response);
@@ -1381,10 +1381,10 @@ void test_spdm_responder_algorithms_case16(void **state) {
   assert_int_equal (spdm_response->header.request_response_code, SPDM_ALGORITHMS);
   assert_int_equal (spdm_response->header.spdm_version, SPDM_MESSAGE_VERSION_11);
 
-  assert_int_equal (spdm_response->struct_table[0].alg_supported, spdm_context->local_context.algorithm.dhe_named_group);
-  assert_int_equal (spdm_response->struct_table[1].alg_supported, spdm_context->local_context.algorithm.aead_cipher_suite);
-  assert_int_equal (spdm_response->struct_table[2].alg_supported, spdm_context->local_context.algorithm.req_base_asym_alg);
-  assert_int_equal (spdm_response->struct_table[3].alg_supported, spdm_context->local_context.algorithm.key_schedule);
+  assert_int_equal (spdm_response->struct_table[0].alg_supported, spdm_context->local_context->algorithm.dhe_named_group);
+  assert_int_equal (spdm_response->struct_table[1].alg_supported, spdm_context->local_context->algorithm.aead_cipher_suite);
+  assert_int_equal (spdm_response->struct_table[2].alg_supported, spdm_context->local_context->algorithm.req_base_asym_alg);
+  assert_int_equal (spdm_response->struct_table[3].alg_supported, spdm_context->local_context->algorithm.key_schedule);
 }
 
 void test_spdm_responder_algorithms_case17(void **state) {
@@ -1402,30 +1402,30 @@ void test_spdm_responder_algorithms_case17(void **state) {
   spdm_context->connection_info.version.spdm_version_count = 1;
   spdm_context->connection_info.version.spdm_version[0].major_version = 1;
   spdm_context->connection_info.version.spdm_version[0].minor_version = 1;
-  spdm_context->local_context.algorithm.base_hash_algo = m_use_hash_algo;
-  spdm_context->local_context.algorithm.base_asym_algo = m_use_asym_algo;
-  spdm_context->local_context.algorithm.measurement_spec = m_use_measurement_spec;
-  spdm_context->local_context.algorithm.measurement_hash_algo = m_use_measurement_hash_algo;
-  spdm_context->local_context.algorithm.dhe_named_group = m_use_dhe_algo;
-  spdm_context->local_context.algorithm.aead_cipher_suite = m_use_aead_algo;
-  spdm_context->local_context.algorithm.req_base_asym_alg = m_use_req_asym_algo;
-  spdm_context->local_context.algorithm.key_schedule = m_use_key_schedule_algo;
+  spdm_context->local_context->algorithm.base_hash_algo = m_use_hash_algo;
+  spdm_context->local_context->algorithm.base_asym_algo = m_use_asym_algo;
+  spdm_context->local_context->algorithm.measurement_spec = m_use_measurement_spec;
+  spdm_context->local_context->algorithm.measurement_hash_algo = m_use_measurement_hash_algo;
+  spdm_context->local_context->algorithm.dhe_named_group = m_use_dhe_algo;
+  spdm_context->local_context->algorithm.aead_cipher_suite = m_use_aead_algo;
+  spdm_context->local_context->algorithm.req_base_asym_alg = m_use_req_asym_algo;
+  spdm_context->local_context->algorithm.key_schedule = m_use_key_schedule_algo;
 
   spdm_context->transcript.message_a.buffer_size = 0;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_KEY_EX_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_ENCRYPT_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MAC_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MUT_AUTH_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MUT_AUTH_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MUT_AUTH_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_PSK_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_PSK_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_PSK_CAP;
 
   response_size = sizeof(response);
@@ -1436,10 +1436,10 @@ void test_spdm_responder_algorithms_case17(void **state) {
   assert_int_equal (spdm_response->header.request_response_code, SPDM_ALGORITHMS);
   assert_int_equal (spdm_response->header.spdm_version, SPDM_MESSAGE_VERSION_11);
 
-  assert_int_equal (spdm_response->struct_table[0].alg_supported, spdm_context->local_context.algorithm.dhe_named_group);
-  assert_int_equal (spdm_response->struct_table[1].alg_supported, spdm_context->local_context.algorithm.aead_cipher_suite);
-  assert_int_equal (spdm_response->struct_table[2].alg_supported, spdm_context->local_context.algorithm.req_base_asym_alg);
-  assert_int_equal (spdm_response->struct_table[3].alg_supported, spdm_context->local_context.algorithm.key_schedule);
+  assert_int_equal (spdm_response->struct_table[0].alg_supported, spdm_context->local_context->algorithm.dhe_named_group);
+  assert_int_equal (spdm_response->struct_table[1].alg_supported, spdm_context->local_context->algorithm.aead_cipher_suite);
+  assert_int_equal (spdm_response->struct_table[2].alg_supported, spdm_context->local_context->algorithm.req_base_asym_alg);
+  assert_int_equal (spdm_response->struct_table[3].alg_supported, spdm_context->local_context->algorithm.key_schedule);
 }
 
 void test_spdm_responder_algorithms_case18(void **state) {
@@ -1457,30 +1457,30 @@ void test_spdm_responder_algorithms_case18(void **state) {
   spdm_context->connection_info.version.spdm_version_count = 1;
   spdm_context->connection_info.version.spdm_version[0].major_version = 1;
   spdm_context->connection_info.version.spdm_version[0].minor_version = 1;
-  spdm_context->local_context.algorithm.base_hash_algo = m_use_hash_algo;
-  spdm_context->local_context.algorithm.base_asym_algo = m_use_asym_algo;
-  spdm_context->local_context.algorithm.measurement_spec = m_use_measurement_spec;
-  spdm_context->local_context.algorithm.measurement_hash_algo = m_use_measurement_hash_algo;
-  spdm_context->local_context.algorithm.dhe_named_group = m_use_dhe_algo;
-  spdm_context->local_context.algorithm.aead_cipher_suite = m_use_aead_algo;
-  spdm_context->local_context.algorithm.req_base_asym_alg = m_use_req_asym_algo;
-  spdm_context->local_context.algorithm.key_schedule = m_use_key_schedule_algo;
+  spdm_context->local_context->algorithm.base_hash_algo = m_use_hash_algo;
+  spdm_context->local_context->algorithm.base_asym_algo = m_use_asym_algo;
+  spdm_context->local_context->algorithm.measurement_spec = m_use_measurement_spec;
+  spdm_context->local_context->algorithm.measurement_hash_algo = m_use_measurement_hash_algo;
+  spdm_context->local_context->algorithm.dhe_named_group = m_use_dhe_algo;
+  spdm_context->local_context->algorithm.aead_cipher_suite = m_use_aead_algo;
+  spdm_context->local_context->algorithm.req_base_asym_alg = m_use_req_asym_algo;
+  spdm_context->local_context->algorithm.key_schedule = m_use_key_schedule_algo;
 
   spdm_context->transcript.message_a.buffer_size = 0;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_KEY_EX_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_ENCRYPT_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MAC_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MUT_AUTH_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MUT_AUTH_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MUT_AUTH_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_PSK_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_PSK_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_PSK_CAP;
 
   response_size = sizeof(response);
@@ -1508,30 +1508,30 @@ void test_spdm_responder_algorithms_case19(void **state) {
   spdm_context->connection_info.version.spdm_version_count = 1;
   spdm_context->connection_info.version.spdm_version[0].major_version = 1;
   spdm_context->connection_info.version.spdm_version[0].minor_version = 1;
-  spdm_context->local_context.algorithm.base_hash_algo = m_use_hash_algo;
-  spdm_context->local_context.algorithm.base_asym_algo = m_use_asym_algo;
-  spdm_context->local_context.algorithm.measurement_spec = m_use_measurement_spec;
-  spdm_context->local_context.algorithm.measurement_hash_algo = m_use_measurement_hash_algo;
-  spdm_context->local_context.algorithm.dhe_named_group = m_use_dhe_algo;
-  spdm_context->local_context.algorithm.aead_cipher_suite = m_use_aead_algo;
-  spdm_context->local_context.algorithm.req_base_asym_alg = m_use_req_asym_algo;
-  spdm_context->local_context.algorithm.key_schedule = m_use_key_schedule_algo;
+  spdm_context->local_context->algorithm.base_hash_algo = m_use_hash_algo;
+  spdm_context->local_context->algorithm.base_asym_algo = m_use_asym_algo;
+  spdm_context->local_context->algorithm.measurement_spec = m_use_measurement_spec;
+  spdm_context->local_context->algorithm.measurement_hash_algo = m_use_measurement_hash_algo;
+  spdm_context->local_context->algorithm.dhe_named_group = m_use_dhe_algo;
+  spdm_context->local_context->algorithm.aead_cipher_suite = m_use_aead_algo;
+  spdm_context->local_context->algorithm.req_base_asym_alg = m_use_req_asym_algo;
+  spdm_context->local_context->algorithm.key_schedule = m_use_key_schedule_algo;
 
   spdm_context->transcript.message_a.buffer_size = 0;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_KEY_EX_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_ENCRYPT_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MAC_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MUT_AUTH_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MUT_AUTH_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MUT_AUTH_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_PSK_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_PSK_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_PSK_CAP;
 
   response_size = sizeof(response);
@@ -1542,10 +1542,10 @@ void test_spdm_responder_algorithms_case19(void **state) {
   assert_int_equal (spdm_response->header.request_response_code, SPDM_ALGORITHMS);
   assert_int_equal (spdm_response->header.spdm_version, SPDM_MESSAGE_VERSION_11);
 
-  assert_int_equal (spdm_response->struct_table[0].alg_supported, spdm_context->local_context.algorithm.dhe_named_group);
-  assert_int_equal (spdm_response->struct_table[1].alg_supported, spdm_context->local_context.algorithm.aead_cipher_suite);
-  assert_int_equal (spdm_response->struct_table[2].alg_supported, spdm_context->local_context.algorithm.req_base_asym_alg);
-  assert_int_equal (spdm_response->struct_table[3].alg_supported, spdm_context->local_context.algorithm.key_schedule);
+  assert_int_equal (spdm_response->struct_table[0].alg_supported, spdm_context->local_context->algorithm.dhe_named_group);
+  assert_int_equal (spdm_response->struct_table[1].alg_supported, spdm_context->local_context->algorithm.aead_cipher_suite);
+  assert_int_equal (spdm_response->struct_table[2].alg_supported, spdm_context->local_context->algorithm.req_base_asym_alg);
+  assert_int_equal (spdm_response->struct_table[3].alg_supported, spdm_context->local_context->algorithm.key_schedule);
 }
 
 spdm_test_context_t m_spdm_responder_algorithms_test_context = {
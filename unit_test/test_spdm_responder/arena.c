@@ -0,0 +1,252 @@
+/**
+    Copyright Notice:
+    Copyright 2021 DMTF. All rights reserved.
+    License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+**/
+
+#include "spdm_unit_test.h"
+#include <spdm_responder_lib_internal.h>
+
+#if OPENSPDM_ARENA_MANAGED_BUFFER_SUPPORT == 1
+
+static spdm_get_version_request_t m_spdm_arena_get_version_request = {
+	{
+		SPDM_MESSAGE_VERSION_10,
+		SPDM_GET_VERSION,
+	},
+};
+
+static spdm_get_digest_request_t m_spdm_arena_get_digests_request = {
+	{
+		SPDM_MESSAGE_VERSION_10,
+		SPDM_GET_DIGESTS,
+	},
+};
+
+static uint8 m_arena_data[MAX_SPDM_MESSAGE_SMALL_BUFFER_SIZE * 2];
+
+static uint8 m_arena_certificate_chain[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+
+/**
+  Test 1: use an SPDM context without registering an arena
+  Expected Behavior: spdm_process_request rejects the request with RETURN_OUT_OF_RESOURCES,
+  and an append to an arena managed buffer fails without recording data. Once an arena is
+  registered, the append succeeds and reset returns the data to the arena.
+**/
+void test_spdm_responder_arena_case1(void **state)
+{
+	spdm_context_t *spdm_context;
+	spdm_unit_test_arena_t arena;
+	return_status status;
+	uint32 *session_id;
+	boolean is_app_message;
+
+	spdm_context = malloc(spdm_get_context_size());
+	assert_non_null(spdm_context);
+	spdm_init_context(spdm_context);
+	spdm_register_transport_layer_func(spdm_context,
+					   spdm_transport_test_encode_message,
+					   spdm_transport_test_decode_message);
+
+	status = spdm_process_request(spdm_context, &session_id,
+				      &is_app_message,
+				      sizeof(m_spdm_arena_get_version_request),
+				      &m_spdm_arena_get_version_request);
+	assert_int_equal(status, RETURN_OUT_OF_RESOURCES);
+
+	set_mem(m_arena_data, sizeof(m_arena_data), 0x5A);
+	status = append_managed_buffer(&spdm_context->transcript.message_m,
+				       m_arena_data, 0x10);
+	assert_int_equal(status, RETURN_OUT_OF_RESOURCES);
+	assert_int_equal(
+		get_managed_buffer_size(&spdm_context->transcript.message_m),
+		0);
+
+	zero_mem(&arena, sizeof(arena));
+	spdm_register_arena_func(spdm_context, &arena,
+				 spdm_unit_test_arena_allocate,
+				 spdm_unit_test_arena_free);
+	status = append_managed_buffer(&spdm_context->transcript.message_m,
+				       m_arena_data, 0x10);
+	assert_int_equal(status, RETURN_SUCCESS);
+	assert_int_equal(arena.allocation_count, 1);
+	assert_int_equal(arena.allocated_size,
+			 MAX_SPDM_MESSAGE_SMALL_BUFFER_SIZE);
+	assert_memory_equal(
+		get_managed_buffer(&spdm_context->transcript.message_m),
+		m_arena_data, 0x10);
+
+	spdm_reset_message_m(spdm_context);
+	assert_int_equal(arena.allocation_count, 0);
+	assert_int_equal(arena.allocated_size, 0);
+
+	spdm_deinit_context(spdm_context);
+	free(spdm_context);
+}
+
+/**
+  Test 2: append to an arena managed buffer until the arena is exhausted
+  Expected Behavior: the append that needs more than the arena holds fails, and the data recorded
+  so far is kept. A responder whose arena is exhausted answers GET_DIGESTS with ERROR(Unspecified).
+**/
+void test_spdm_responder_arena_case2(void **state)
+{
+	spdm_context_t *spdm_context;
+	spdm_unit_test_arena_t arena;
+	return_status status;
+	uintn response_size;
+	uint8 response[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+	spdm_digest_response_t *spdm_response;
+
+	spdm_context = malloc(spdm_get_context_size());
+	assert_non_null(spdm_context);
+	spdm_init_context(spdm_context);
+	zero_mem(&arena, sizeof(arena));
+	arena.max_size = MAX_SPDM_MESSAGE_SMALL_BUFFER_SIZE;
+	spdm_register_arena_func(spdm_context, &arena,
+				 spdm_unit_test_arena_allocate,
+				 spdm_unit_test_arena_free);
+
+	//
+	// The first allocation takes the whole arena.
+	//
+	set_mem(m_arena_data, sizeof(m_arena_data), 0x5A);
+	status = append_managed_buffer(&spdm_context->transcript.message_m,
+				       m_arena_data,
+				       MAX_SPDM_MESSAGE_SMALL_BUFFER_SIZE);
+	assert_int_equal(status, RETURN_SUCCESS);
+	assert_int_equal(arena.allocated_size,
+			 MAX_SPDM_MESSAGE_SMALL_BUFFER_SIZE);
+
+	//
+	// Growing it needs twice as much, which the arena cannot give.
+	//
+	status = append_managed_buffer(&spdm_context->transcript.message_m,
+				       m_arena_data, 1);
+	assert_int_equal(status, RETURN_OUT_OF_RESOURCES);
+	assert_int_equal(
+		get_managed_buffer_size(&spdm_context->transcript.message_m),
+		MAX_SPDM_MESSAGE_SMALL_BUFFER_SIZE);
+	assert_memory_equal(
+		get_managed_buffer(&spdm_context->transcript.message_m),
+		m_arena_data, MAX_SPDM_MESSAGE_SMALL_BUFFER_SIZE);
+	assert_int_equal(arena.allocation_count, 1);
+
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
+	//
+	// GET_DIGESTS drops message M, but message B still cannot get data from
+	// an arena that is smaller than one buffer.
+	//
+	arena.max_size = 1;
+	spdm_context->connection_info.connection_state =
+		SPDM_CONNECTION_STATE_NEGOTIATED;
+	spdm_context->local_context->capability.flags |=
+		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
+	spdm_context->connection_info.algorithm.base_hash_algo =
+		m_use_hash_algo;
+	spdm_context->local_context->local_cert_chain_provision[0] =
+		m_arena_certificate_chain;
+	spdm_context->local_context->local_cert_chain_provision_size[0] =
+		sizeof(m_arena_certificate_chain);
+	spdm_context->local_context->slot_count = 1;
+	response_size = sizeof(response);
+	status = spdm_get_response_digests(
+		spdm_context, sizeof(m_spdm_arena_get_digests_request),
+		&m_spdm_arena_get_digests_request, &response_size, response);
+	assert_int_equal(status, RETURN_SUCCESS);
+	assert_int_equal(response_size, sizeof(spdm_error_response_t));
+	spdm_response = (void *)response;
+	assert_int_equal(spdm_response->header.request_response_code,
+			 SPDM_ERROR);
+	assert_int_equal(spdm_response->header.param1,
+			 SPDM_ERROR_CODE_UNSPECIFIED);
+#endif
+
+	spdm_deinit_context(spdm_context);
+	assert_int_equal(arena.allocation_count, 0);
+	free(spdm_context);
+}
+
+/**
+  Test 3: record message K in a session, free the session and start a new one in the same slot
+  Expected Behavior: freeing the session returns its data to the arena, and the new session
+  allocates fresh data that does not contain the old transcript.
+**/
+void test_spdm_responder_arena_case3(void **state)
+{
+	spdm_context_t *spdm_context;
+	spdm_unit_test_arena_t arena;
+	spdm_session_info_t *session_info;
+	return_status status;
+
+	spdm_context = malloc(spdm_get_context_size_ex(1));
+	assert_non_null(spdm_context);
+	spdm_init_context_ex(spdm_context, 1);
+	zero_mem(&arena, sizeof(arena));
+	arena.max_size = MAX_SPDM_MESSAGE_SMALL_BUFFER_SIZE * 2;
+	spdm_register_arena_func(spdm_context, &arena,
+				 spdm_unit_test_arena_allocate,
+				 spdm_unit_test_arena_free);
+
+	session_info = spdm_assign_session_id(spdm_context, 0xFFFEFFFE, FALSE);
+	assert_non_null(session_info);
+	set_mem(m_arena_data, sizeof(m_arena_data), 0x5A);
+	status = append_managed_buffer(
+		&session_info->session_transcript.message_k, m_arena_data,
+		MAX_SPDM_MESSAGE_SMALL_BUFFER_SIZE);
+	assert_int_equal(status, RETURN_SUCCESS);
+	assert_int_equal(arena.allocation_count, 1);
+
+	spdm_free_session_id(spdm_context, 0xFFFEFFFE);
+	assert_int_equal(arena.allocation_count, 0);
+	assert_int_equal(arena.allocated_size, 0);
+
+	//
+	// The new session grows to the full arena, which only works if the old
+	// data was returned.
+	//
+	session_info = spdm_assign_session_id(spdm_context, 0xFFFDFFFD, FALSE);
+	assert_non_null(session_info);
+	assert_int_equal(get_managed_buffer_size(
+				 &session_info->session_transcript.message_k),
+			 0);
+	set_mem(m_arena_data, sizeof(m_arena_data), 0xA5);
+	status = append_managed_buffer(
+		&session_info->session_transcript.message_k, m_arena_data,
+		MAX_SPDM_MESSAGE_SMALL_BUFFER_SIZE * 2);
+	assert_int_equal(status, RETURN_SUCCESS);
+	assert_int_equal(arena.allocated_size,
+			 MAX_SPDM_MESSAGE_SMALL_BUFFER_SIZE * 2);
+	assert_memory_equal(
+		get_managed_buffer(&session_info->session_transcript.message_k),
+		m_arena_data, MAX_SPDM_MESSAGE_SMALL_BUFFER_SIZE * 2);
+
+	//
+	// Resetting the context returns the session data as well.
+	//
+	spdm_reset_context(spdm_context);
+	assert_int_equal(arena.allocation_count, 0);
+
+	spdm_deinit_context(spdm_context);
+	free(spdm_context);
+}
+
+#endif
+
+int spdm_responder_arena_test_main(void)
+{
+#if OPENSPDM_ARENA_MANAGED_BUFFER_SUPPORT == 1
+	const struct CMUnitTest spdm_responder_arena_tests[] = {
+		// No arena registered
+		cmocka_unit_test(test_spdm_responder_arena_case1),
+		// Arena exhausted
+		cmocka_unit_test(test_spdm_responder_arena_case2),
+		// Arena data returned between sessions
+		cmocka_unit_test(test_spdm_responder_arena_case3),
+	};
+
+	return cmocka_run_group_tests(spdm_responder_arena_tests, NULL, NULL);
+#else
+	return 0;
+#endif
+}
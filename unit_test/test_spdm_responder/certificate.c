@@ -57,15 +57,17 @@ void test_spdm_responder_certificate_case1(void **state)
 	spdm_test_context->case_id = 0x1;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AFTER_DIGESTS;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
+	spdm_context->connection_info.algorithm.base_hash_algo =
+		m_use_hash_algo;
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data,
 						&data_size, NULL, NULL);
-	spdm_context->local_context.local_cert_chain_provision[0] = data;
-	spdm_context->local_context.local_cert_chain_provision_size[0] =
+	spdm_context->local_context->local_cert_chain_provision[0] = data;
+	spdm_context->local_context->local_cert_chain_provision_size[0] =
 		data_size;
-	spdm_context->local_context.slot_count = 1;
+	spdm_context->local_context->slot_count = 1;
 	spdm_context->transcript.message_m.buffer_size =
 		spdm_context->transcript.message_m.max_buffer_size;
 
@@ -109,15 +111,17 @@ void test_spdm_responder_certificate_case2(void **state)
 	spdm_test_context->case_id = 0x2;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AFTER_DIGESTS;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
+	spdm_context->connection_info.algorithm.base_hash_algo =
+		m_use_hash_algo;
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data,
 						&data_size, NULL, NULL);
-	spdm_context->local_context.local_cert_chain_provision[0] = data;
-	spdm_context->local_context.local_cert_chain_provision_size[0] =
+	spdm_context->local_context->local_cert_chain_provision[0] = data;
+	spdm_context->local_context->local_cert_chain_provision_size[0] =
 		data_size;
-	spdm_context->local_context.slot_count = 1;
+	spdm_context->local_context->slot_count = 1;
 
 	response_size = sizeof(response);
 	status = spdm_get_response_certificate(
@@ -155,15 +159,17 @@ void test_spdm_responder_certificate_case3(void **state)
 	spdm_context->response_state = SPDM_RESPONSE_STATE_BUSY;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AFTER_DIGESTS;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
+	spdm_context->connection_info.algorithm.base_hash_algo =
+		m_use_hash_algo;
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data,
 						&data_size, NULL, NULL);
-	spdm_context->local_context.local_cert_chain_provision[0] = data;
-	spdm_context->local_context.local_cert_chain_provision_size[0] =
+	spdm_context->local_context->local_cert_chain_provision[0] = data;
+	spdm_context->local_context->local_cert_chain_provision_size[0] =
 		data_size;
-	spdm_context->local_context.slot_count = 1;
+	spdm_context->local_context->slot_count = 1;
 
 	response_size = sizeof(response);
 	status = spdm_get_response_certificate(
@@ -202,15 +208,17 @@ void test_spdm_responder_certificate_case4(void **state)
 	spdm_context->response_state = SPDM_RESPONSE_STATE_NEED_RESYNC;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AFTER_DIGESTS;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
+	spdm_context->connection_info.algorithm.base_hash_algo =
+		m_use_hash_algo;
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data,
 						&data_size, NULL, NULL);
-	spdm_context->local_context.local_cert_chain_provision[0] = data;
-	spdm_context->local_context.local_cert_chain_provision_size[0] =
+	spdm_context->local_context->local_cert_chain_provision[0] = data;
+	spdm_context->local_context->local_cert_chain_provision_size[0] =
 		data_size;
-	spdm_context->local_context.slot_count = 1;
+	spdm_context->local_context->slot_count = 1;
 
 	response_size = sizeof(response);
 	status = spdm_get_response_certificate(
@@ -251,15 +259,17 @@ void test_spdm_responder_certificate_case5(void **state)
 	spdm_context->response_state = SPDM_RESPONSE_STATE_NOT_READY;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AFTER_DIGESTS;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
+	spdm_context->connection_info.algorithm.base_hash_algo =
+		m_use_hash_algo;
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data,
 						&data_size, NULL, NULL);
-	spdm_context->local_context.local_cert_chain_provision[0] = data;
-	spdm_context->local_context.local_cert_chain_provision_size[0] =
+	spdm_context->local_context->local_cert_chain_provision[0] = data;
+	spdm_context->local_context->local_cert_chain_provision_size[0] =
 		data_size;
-	spdm_context->local_context.slot_count = 1;
+	spdm_context->local_context->slot_count = 1;
 
 	response_size = sizeof(response);
 	status = spdm_get_response_certificate(
@@ -304,15 +314,17 @@ void test_spdm_responder_certificate_case6(void **state)
 	spdm_context->response_state = SPDM_RESPONSE_STATE_NORMAL;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_NOT_STARTED;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
+	spdm_context->connection_info.algorithm.base_hash_algo =
+		m_use_hash_algo;
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data,
 						&data_size, NULL, NULL);
-	spdm_context->local_context.local_cert_chain_provision[0] = data;
-	spdm_context->local_context.local_cert_chain_provision_size[0] =
+	spdm_context->local_context->local_cert_chain_provision[0] = data;
+	spdm_context->local_context->local_cert_chain_provision_size[0] =
 		data_size;
-	spdm_context->local_context.slot_count = 1;
+	spdm_context->local_context->slot_count = 1;
 
 	response_size = sizeof(response);
 	status = spdm_get_response_certificate(
@@ -358,15 +370,17 @@ void test_spdm_responder_certificate_case7(void **state)
 	spdm_test_context->case_id = 0x7;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AFTER_DIGESTS;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
+	spdm_context->connection_info.algorithm.base_hash_algo =
+		m_use_hash_algo;
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data,
 						&data_size, NULL, NULL);
-	spdm_context->local_context.local_cert_chain_provision[0] = data;
-	spdm_context->local_context.local_cert_chain_provision_size[0] =
+	spdm_context->local_context->local_cert_chain_provision[0] = data;
+	spdm_context->local_context->local_cert_chain_provision_size[0] =
 		data_size;
-	spdm_context->local_context.slot_count = 1;
+	spdm_context->local_context->slot_count = 1;
 
 	// This tests considers only offset = 0, other tests vary offset value
 	m_spdm_get_certificate_request3.offset = 0;
@@ -379,7 +393,9 @@ void test_spdm_responder_certificate_case7(void **state)
 					MAX_SPDM_CERT_CHAIN_BLOCK_LEN);
 
 		// reseting an internal buffer to avoid overflow and prevent tests to succeed
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 		reset_managed_buffer(&spdm_context->transcript.message_b);
+#endif
 		response_size = sizeof(response);
 		status = spdm_get_response_certificate(
 			spdm_context, m_spdm_get_certificate_request3_size,
@@ -436,15 +452,17 @@ void test_spdm_responder_certificate_case8(void **state)
 	spdm_test_context->case_id = 0x8;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AFTER_DIGESTS;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
+	spdm_context->connection_info.algorithm.base_hash_algo =
+		m_use_hash_algo;
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data,
 						&data_size, NULL, NULL);
-	spdm_context->local_context.local_cert_chain_provision[0] = data;
-	spdm_context->local_context.local_cert_chain_provision_size[0] =
+	spdm_context->local_context->local_cert_chain_provision[0] = data;
+	spdm_context->local_context->local_cert_chain_provision_size[0] =
 		data_size;
-	spdm_context->local_context.slot_count = 1;
+	spdm_context->local_context->slot_count = 1;
 
 	// This tests considers only length = 0, other tests vary length value
 	m_spdm_get_certificate_request3.length = 0;
@@ -458,7 +476,9 @@ void test_spdm_responder_certificate_case8(void **state)
 		m_spdm_get_certificate_request3.offset = test_offsets[i];
 
 		// reseting an internal buffer to avoid overflow and prevent tests to succeed
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 		reset_managed_buffer(&spdm_context->transcript.message_b);
+#endif
 		response_size = sizeof(response);
 		status = spdm_get_response_certificate(
 			spdm_context, m_spdm_get_certificate_request3_size,
@@ -539,15 +559,17 @@ void test_spdm_responder_certificate_case9(void **state)
 	spdm_test_context->case_id = 0x9;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AFTER_DIGESTS;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
+	spdm_context->connection_info.algorithm.base_hash_algo =
+		m_use_hash_algo;
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data,
 						&data_size, NULL, NULL);
-	spdm_context->local_context.local_cert_chain_provision[0] = data;
-	spdm_context->local_context.local_cert_chain_provision_size[0] =
+	spdm_context->local_context->local_cert_chain_provision[0] = data;
+	spdm_context->local_context->local_cert_chain_provision_size[0] =
 		data_size;
-	spdm_context->local_context.slot_count = 1;
+	spdm_context->local_context->slot_count = 1;
 
 	// Setting up offset values at the boundary of certificate length
 	test_sizes[0] += (uint16)(test_sizes[0] + data_size);
@@ -565,8 +587,10 @@ void test_spdm_responder_certificate_case9(void **state)
 			m_spdm_get_certificate_request3.offset = test_sizes[j];
 
 			// reseting an internal buffer to avoid overflow and prevent tests to succeed
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 			reset_managed_buffer(
 				&spdm_context->transcript.message_b);
+#endif
 			response_size = sizeof(response);
 			status = spdm_get_response_certificate(
 				spdm_context,
@@ -651,8 +675,10 @@ void test_spdm_responder_certificate_case10(void **state)
 	spdm_test_context->case_id = 0xA;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AFTER_DIGESTS;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
+	spdm_context->connection_info.algorithm.base_hash_algo =
+		m_use_hash_algo;
 
 	m_spdm_get_certificate_request3.length = MAX_SPDM_CERT_CHAIN_BLOCK_LEN;
 
@@ -661,11 +687,11 @@ void test_spdm_responder_certificate_case10(void **state)
 			m_use_hash_algo, m_use_asym_algo, test_cases[i], &data,
 			&data_size, NULL, NULL);
 
-		spdm_context->local_context.local_cert_chain_provision[0] =
+		spdm_context->local_context->local_cert_chain_provision[0] =
 			data;
-		spdm_context->local_context.local_cert_chain_provision_size[0] =
+		spdm_context->local_context->local_cert_chain_provision_size[0] =
 			data_size;
-		spdm_context->local_context.slot_count = 1;
+		spdm_context->local_context->slot_count = 1;
 
 		m_spdm_get_certificate_request3.offset =
 			(uint16)(MIN(data_size - 1, MAX_UINT16));
@@ -680,7 +706,9 @@ void test_spdm_responder_certificate_case10(void **state)
 				m_spdm_get_certificate_request3.length);
 
 		// reseting an internal buffer to avoid overflow and prevent tests to succeed
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 		reset_managed_buffer(&spdm_context->transcript.message_b);
+#endif
 		response_size = sizeof(response);
 		status = spdm_get_response_certificate(
 			spdm_context, m_spdm_get_certificate_request3_size,
@@ -727,9 +755,9 @@ void test_spdm_responder_certificate_case10(void **state)
 
 		TEST_DEBUG_PRINT("\n");
 
-		spdm_context->local_context.local_cert_chain_provision[0] =
+		spdm_context->local_context->local_cert_chain_provision[0] =
 			NULL;
-		spdm_context->local_context.local_cert_chain_provision_size[0] =
+		spdm_context->local_context->local_cert_chain_provision_size[0] =
 			0;
 		free(data);
 	}
@@ -762,8 +790,10 @@ void test_spdm_responder_certificate_case11(void **state)
 	spdm_test_context->case_id = 0xB;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AFTER_DIGESTS;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
+	spdm_context->connection_info.algorithm.base_hash_algo =
+		m_use_hash_algo;
 
 	m_spdm_get_certificate_request3.length = MAX_SPDM_CERT_CHAIN_BLOCK_LEN;
 	m_spdm_get_certificate_request3.offset = 0;
@@ -772,11 +802,11 @@ void test_spdm_responder_certificate_case11(void **state)
 		read_responder_public_certificate_chain_by_size(
 			m_use_hash_algo, m_use_asym_algo, test_cases[i], &data,
 			&data_size, NULL, NULL);
-		spdm_context->local_context.local_cert_chain_provision[0] =
+		spdm_context->local_context->local_cert_chain_provision[0] =
 			data;
-		spdm_context->local_context.local_cert_chain_provision_size[0] =
+		spdm_context->local_context->local_cert_chain_provision_size[0] =
 			data_size;
-		spdm_context->local_context.slot_count = 1;
+		spdm_context->local_context->slot_count = 1;
 
 		TEST_DEBUG_PRINT("data_size: %u\n", data_size);
 		TEST_DEBUG_PRINT("m_spdm_get_certificate_request3.offset: %u\n",
@@ -789,7 +819,9 @@ void test_spdm_responder_certificate_case11(void **state)
 				m_spdm_get_certificate_request3.length);
 
 		// reseting an internal buffer to avoid overflow and prevent tests to succeed
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 		reset_managed_buffer(&spdm_context->transcript.message_b);
+#endif
 		response_size = sizeof(response);
 		status = spdm_get_response_certificate(
 			spdm_context, m_spdm_get_certificate_request3_size,
@@ -855,7 +887,9 @@ void test_spdm_responder_certificate_case12(void **state)
 	void *data;
 	uintn data_size;
 
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	uintn count;
+#endif
 	uint16 expected_chunk_size;
 
 	// Setting up the spdm_context and loading a sample certificate chain
@@ -864,25 +898,31 @@ void test_spdm_responder_certificate_case12(void **state)
 	spdm_test_context->case_id = 0xC;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AFTER_DIGESTS;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
+	spdm_context->connection_info.algorithm.base_hash_algo =
+		m_use_hash_algo;
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data,
 						&data_size, NULL, NULL);
-	spdm_context->local_context.local_cert_chain_provision[0] = data;
-	spdm_context->local_context.local_cert_chain_provision_size[0] =
+	spdm_context->local_context->local_cert_chain_provision[0] = data;
+	spdm_context->local_context->local_cert_chain_provision_size[0] =
 		data_size;
-	spdm_context->local_context.slot_count = 1;
+	spdm_context->local_context->slot_count = 1;
 
 	// This tests considers only length = 1
 	m_spdm_get_certificate_request3.length = 1;
 	expected_chunk_size = 1;
 
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	count = (data_size + m_spdm_get_certificate_request3.length - 1) /
 		m_spdm_get_certificate_request3.length;
+#endif
 
 	// reseting an internal buffer to avoid overflow and prevent tests to succeed
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	reset_managed_buffer(&spdm_context->transcript.message_b);
+#endif
 
 	spdm_response = NULL;
 	for (uintn offset = 0; offset < data_size; offset++) {
@@ -926,12 +966,14 @@ void test_spdm_responder_certificate_case12(void **state)
 	if (spdm_response != NULL) {
 		if (spdm_response->header.request_response_code ==
 		    SPDM_CERTIFICATE) {
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 			assert_int_equal(
 				spdm_context->transcript.message_b.buffer_size,
 				sizeof(spdm_get_certificate_request_t) * count +
 					sizeof(spdm_certificate_response_t) *
 						count +
 					data_size);
+#endif
 		}
 	}
 	free(data);
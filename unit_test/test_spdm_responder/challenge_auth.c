@@ -67,8 +67,8 @@ void test_spdm_responder_challenge_auth_case1(void **state)
 	spdm_test_context->case_id = 0x1;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_NEGOTIATED;
-	spdm_context->local_context.capability.flags = 0;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags = 0;
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CHAL_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -84,12 +84,16 @@ void test_spdm_responder_challenge_auth_case1(void **state)
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data1,
 						&data_size1, NULL, NULL);
-	spdm_context->local_context.local_cert_chain_provision[0] = data1;
-	spdm_context->local_context.local_cert_chain_provision_size[0] =
+	spdm_context->local_context->local_cert_chain_provision[0] = data1;
+	spdm_context->local_context->local_cert_chain_provision_size[0] =
 		data_size1;
-	spdm_context->local_context.slot_count = 1;
-	spdm_context->local_context.opaque_challenge_auth_rsp_size = 0;
+	spdm_context->local_context->slot_count = 1;
+	spdm_context->local_context->opaque_challenge_auth_rsp_size = 0;
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	spdm_context->transcript.message_c.buffer_size = 0;
+#else
+	spdm_reset_message_c(spdm_context);
+#endif
 	spdm_context->transcript.message_m.buffer_size =
 		spdm_context->transcript.message_m.max_buffer_size;
 
@@ -136,8 +140,8 @@ void test_spdm_responder_challenge_auth_case2(void **state)
 	spdm_test_context->case_id = 0x2;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_NEGOTIATED;
-	spdm_context->local_context.capability.flags = 0;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags = 0;
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CHAL_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -153,12 +157,16 @@ void test_spdm_responder_challenge_auth_case2(void **state)
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data1,
 						&data_size1, NULL, NULL);
-	spdm_context->local_context.local_cert_chain_provision[0] = data1;
-	spdm_context->local_context.local_cert_chain_provision_size[0] =
+	spdm_context->local_context->local_cert_chain_provision[0] = data1;
+	spdm_context->local_context->local_cert_chain_provision_size[0] =
 		data_size1;
-	spdm_context->local_context.slot_count = 1;
-	spdm_context->local_context.opaque_challenge_auth_rsp_size = 0;
+	spdm_context->local_context->slot_count = 1;
+	spdm_context->local_context->opaque_challenge_auth_rsp_size = 0;
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	spdm_context->transcript.message_c.buffer_size = 0;
+#else
+	spdm_reset_message_c(spdm_context);
+#endif
 
 	response_size = sizeof(response);
 	spdm_get_random_number(SPDM_NONCE_SIZE,
@@ -200,8 +208,8 @@ void test_spdm_responder_challenge_auth_case3(void **state)
 	spdm_context->response_state = SPDM_RESPONSE_STATE_BUSY;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_NEGOTIATED;
-	spdm_context->local_context.capability.flags = 0;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags = 0;
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CHAL_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -217,12 +225,16 @@ void test_spdm_responder_challenge_auth_case3(void **state)
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data1,
 						&data_size1, NULL, NULL);
-	spdm_context->local_context.local_cert_chain_provision[0] = data1;
-	spdm_context->local_context.local_cert_chain_provision_size[0] =
+	spdm_context->local_context->local_cert_chain_provision[0] = data1;
+	spdm_context->local_context->local_cert_chain_provision_size[0] =
 		data_size1;
-	spdm_context->local_context.slot_count = 1;
-	spdm_context->local_context.opaque_challenge_auth_rsp_size = 0;
+	spdm_context->local_context->slot_count = 1;
+	spdm_context->local_context->opaque_challenge_auth_rsp_size = 0;
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	spdm_context->transcript.message_c.buffer_size = 0;
+#else
+	spdm_reset_message_c(spdm_context);
+#endif
 
 	response_size = sizeof(response);
 	spdm_get_random_number(SPDM_NONCE_SIZE,
@@ -265,8 +277,8 @@ void test_spdm_responder_challenge_auth_case4(void **state)
 	spdm_context->response_state = SPDM_RESPONSE_STATE_NEED_RESYNC;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_NEGOTIATED;
-	spdm_context->local_context.capability.flags = 0;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags = 0;
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CHAL_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -282,12 +294,16 @@ void test_spdm_responder_challenge_auth_case4(void **state)
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data1,
 						&data_size1, NULL, NULL);
-	spdm_context->local_context.local_cert_chain_provision[0] = data1;
-	spdm_context->local_context.local_cert_chain_provision_size[0] =
+	spdm_context->local_context->local_cert_chain_provision[0] = data1;
+	spdm_context->local_context->local_cert_chain_provision_size[0] =
 		data_size1;
-	spdm_context->local_context.slot_count = 1;
-	spdm_context->local_context.opaque_challenge_auth_rsp_size = 0;
+	spdm_context->local_context->slot_count = 1;
+	spdm_context->local_context->opaque_challenge_auth_rsp_size = 0;
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	spdm_context->transcript.message_c.buffer_size = 0;
+#else
+	spdm_reset_message_c(spdm_context);
+#endif
 
 	response_size = sizeof(response);
 	spdm_get_random_number(SPDM_NONCE_SIZE,
@@ -332,8 +348,8 @@ void test_spdm_responder_challenge_auth_case5(void **state)
 	spdm_context->response_state = SPDM_RESPONSE_STATE_NOT_READY;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_NEGOTIATED;
-	spdm_context->local_context.capability.flags = 0;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags = 0;
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CHAL_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -349,12 +365,16 @@ void test_spdm_responder_challenge_auth_case5(void **state)
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data1,
 						&data_size1, NULL, NULL);
-	spdm_context->local_context.local_cert_chain_provision[0] = data1;
-	spdm_context->local_context.local_cert_chain_provision_size[0] =
+	spdm_context->local_context->local_cert_chain_provision[0] = data1;
+	spdm_context->local_context->local_cert_chain_provision_size[0] =
 		data_size1;
-	spdm_context->local_context.slot_count = 1;
-	spdm_context->local_context.opaque_challenge_auth_rsp_size = 0;
+	spdm_context->local_context->slot_count = 1;
+	spdm_context->local_context->opaque_challenge_auth_rsp_size = 0;
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	spdm_context->transcript.message_c.buffer_size = 0;
+#else
+	spdm_reset_message_c(spdm_context);
+#endif
 
 	response_size = sizeof(response);
 	spdm_get_random_number(SPDM_NONCE_SIZE,
@@ -404,8 +424,8 @@ void test_spdm_responder_challenge_auth_case6(void **state)
 	spdm_context->response_state = SPDM_RESPONSE_STATE_NORMAL;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_NOT_STARTED;
-	spdm_context->local_context.capability.flags = 0;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags = 0;
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CHAL_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -421,12 +441,16 @@ void test_spdm_responder_challenge_auth_case6(void **state)
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data1,
 						&data_size1, NULL, NULL);
-	spdm_context->local_context.local_cert_chain_provision[0] = data1;
-	spdm_context->local_context.local_cert_chain_provision_size[0] =
+	spdm_context->local_context->local_cert_chain_provision[0] = data1;
+	spdm_context->local_context->local_cert_chain_provision_size[0] =
 		data_size1;
-	spdm_context->local_context.slot_count = 1;
-	spdm_context->local_context.opaque_challenge_auth_rsp_size = 0;
+	spdm_context->local_context->slot_count = 1;
+	spdm_context->local_context->opaque_challenge_auth_rsp_size = 0;
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	spdm_context->transcript.message_c.buffer_size = 0;
+#else
+	spdm_reset_message_c(spdm_context);
+#endif
 
 	response_size = sizeof(response);
 	spdm_get_random_number(SPDM_NONCE_SIZE,
@@ -465,8 +489,8 @@ void test_spdm_responder_challenge_auth_case7(void **state) {
   spdm_context = spdm_test_context->spdm_context;
   spdm_test_context->case_id = 0x7;
   spdm_context->connection_info.connection_state = SPDM_CONNECTION_STATE_NEGOTIATED;
-  spdm_context->local_context.capability.flags = 0;
-  // spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CHAL_CAP;
+  spdm_context->local_context->capability.flags = 0;
+  // spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CHAL_CAP;
   spdm_context->connection_info.algorithm.base_hash_algo = m_use_hash_algo;
   spdm_context->connection_info.algorithm.base_asym_algo = m_use_asym_algo;
   spdm_context->connection_info.algorithm.measurement_spec = m_use_measurement_spec;
@@ -475,11 +499,15 @@ void test_spdm_responder_challenge_auth_case7(void **state) {
   spdm_context->connection_info.version.spdm_version[0].major_version = 1;
   spdm_context->connection_info.version.spdm_version[0].minor_version = 1;
   read_responder_public_certificate_chain (m_use_hash_algo, m_use_asym_algo, &data1, &data_size1, NULL, NULL);
-  spdm_context->local_context.local_cert_chain_provision[0] = data1;
-  spdm_context->local_context.local_cert_chain_provision_size[0] = data_size1;
-  spdm_context->local_context.slot_count = 1;
-  spdm_context->local_context.opaque_challenge_auth_rsp_size = 0;
+  spdm_context->local_context->local_cert_chain_provision[0] = data1;
+  spdm_context->local_context->local_cert_chain_provision_size[0] = data_size1;
+  spdm_context->local_context->slot_count = 1;
+  spdm_context->local_context->opaque_challenge_auth_rsp_size = 0;
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
   spdm_context->transcript.message_c.buffer_size = 0;
+#else
+  spdm_reset_message_c(spdm_context);
+#endif
 
   response_size = sizeof(response);
   spdm_get_random_number (SPDM_NONCE_SIZE, m_spdm_challenge_request1.nonce);
@@ -513,8 +541,8 @@ void test_spdm_responder_challenge_auth_case8(void **state) {
   spdm_context = spdm_test_context->spdm_context;
   spdm_test_context->case_id = 0x8;
   spdm_context->connection_info.connection_state = SPDM_CONNECTION_STATE_NEGOTIATED;
-  spdm_context->local_context.capability.flags = 0;
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CHAL_CAP;
+  spdm_context->local_context->capability.flags = 0;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CHAL_CAP;
   spdm_context->connection_info.algorithm.base_hash_algo = m_use_hash_algo;
   spdm_context->connection_info.algorithm.base_asym_algo = m_use_asym_algo;
   spdm_context->connection_info.algorithm.measurement_spec = m_use_measurement_spec;
@@ -523,11 +551,15 @@ void test_spdm_responder_challenge_auth_case8(void **state) {
   spdm_context->connection_info.version.spdm_version[0].major_version = 1;
   spdm_context->connection_info.version.spdm_version[0].minor_version = 1;
   read_responder_public_certificate_chain (m_use_hash_algo, m_use_asym_algo, &data1, &data_size1, NULL, NULL);
-  spdm_context->local_context.local_cert_chain_provision[0] = data1;
-  spdm_context->local_context.local_cert_chain_provision_size[0] = data_size1;
-  spdm_context->local_context.slot_count = 1;
-  spdm_context->local_context.opaque_challenge_auth_rsp_size = 0;
+  spdm_context->local_context->local_cert_chain_provision[0] = data1;
+  spdm_context->local_context->local_cert_chain_provision_size[0] = data_size1;
+  spdm_context->local_context->slot_count = 1;
+  spdm_context->local_context->opaque_challenge_auth_rsp_size = 0;
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
   spdm_context->transcript.message_c.buffer_size = 0;
+#else
+  spdm_reset_message_c(spdm_context);
+#endif
 
   response_size = sizeof(response);
   spdm_get_random_number (SPDM_NONCE_SIZE, m_spdm_challenge_request1.nonce);
@@ -561,8 +593,8 @@ void test_spdm_responder_challenge_auth_case9(void **state) {
   spdm_context = spdm_test_context->spdm_context;
   spdm_test_context->case_id = 0x9;
   spdm_context->connection_info.connection_state = SPDM_CONNECTION_STATE_NEGOTIATED;
-  spdm_context->local_context.capability.flags = 0;
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CHAL_CAP;
+  spdm_context->local_context->capability.flags = 0;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CHAL_CAP;
   spdm_context->connection_info.algorithm.base_hash_algo = m_use_hash_algo;
   spdm_context->connection_info.algorithm.base_asym_algo = m_use_asym_algo;
   spdm_context->connection_info.algorithm.measurement_spec = m_use_measurement_spec;
@@ -571,11 +603,15 @@ void test_spdm_responder_challenge_auth_case9(void **state) {
   spdm_context->connection_info.version.spdm_version[0].major_version = 1;
   spdm_context->connection_info.version.spdm_version[0].minor_version = 1;
   read_responder_public_certificate_chain (m_use_hash_algo, m_use_asym_algo, &data1, &data_size1, NULL, NULL);
-  spdm_context->local_context.local_cert_chain_provision[1] = data1;
-  spdm_context->local_context.local_cert_chain_provision_size[1] = data_size1;
-  spdm_context->local_context.slot_count = 2;
-  spdm_context->local_context.opaque_challenge_auth_rsp_size = 0;
+  spdm_context->local_context->local_cert_chain_provision[1] = data1;
+  spdm_context->local_context->local_cert_chain_provision_size[1] = data_size1;
+  spdm_context->local_context->slot_count = 2;
+  spdm_context->local_context->opaque_challenge_auth_rsp_size = 0;
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
   spdm_context->transcript.message_c.buffer_size = 0;
+#else
+  spdm_reset_message_c(spdm_context);
+#endif
 
   response_size = sizeof(response);
   spdm_get_random_number (SPDM_NONCE_SIZE, m_spdm_challenge_request1.nonce);
@@ -609,8 +645,8 @@ void test_spdm_responder_challenge_auth_case10(void **state) {
   spdm_context = spdm_test_context->spdm_context;
   spdm_test_context->case_id = 0xA;
   spdm_context->connection_info.connection_state = SPDM_CONNECTION_STATE_NEGOTIATED;
-  spdm_context->local_context.capability.flags = 0;
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CHAL_CAP;
+  spdm_context->local_context->capability.flags = 0;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CHAL_CAP;
   spdm_context->connection_info.algorithm.base_hash_algo = m_use_hash_algo;
   spdm_context->connection_info.algorithm.base_asym_algo = m_use_asym_algo;
   spdm_context->connection_info.algorithm.measurement_spec = m_use_measurement_spec;
@@ -619,11 +655,15 @@ void test_spdm_responder_challenge_auth_case10(void **state) {
   spdm_context->connection_info.version.spdm_version[0].major_version = 1;
   spdm_context->connection_info.version.spdm_version[0].minor_version = 1;
   read_responder_public_certificate_chain (m_use_hash_algo, m_use_asym_algo, &data1, &data_size1, NULL, NULL);
-  spdm_context->local_context.local_cert_chain_provision[0] = data1;
-  spdm_context->local_context.local_cert_chain_provision_size[0] = data_size1;
-  spdm_context->local_context.slot_count = 1;
-  spdm_context->local_context.opaque_challenge_auth_rsp_size = 0;
+  spdm_context->local_context->local_cert_chain_provision[0] = data1;
+  spdm_context->local_context->local_cert_chain_provision_size[0] = data_size1;
+  spdm_context->local_context->slot_count = 1;
+  spdm_context->local_context->opaque_challenge_auth_rsp_size = 0;
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
   spdm_context->transcript.message_c.buffer_size = 0;
+#else
+  spdm_reset_message_c(spdm_context);
+#endif
 
   response_size = sizeof(response);
   spdm_get_random_number (SPDM_NONCE_SIZE, m_spdm_challenge_request1.nonce);
@@ -657,8 +697,8 @@ void test_spdm_responder_challenge_auth_case11(void **state) {
   spdm_context = spdm_test_context->spdm_context;
   spdm_test_context->case_id = 0xB;
   spdm_context->connection_info.connection_state = SPDM_CONNECTION_STATE_NEGOTIATED;
-  spdm_context->local_context.capability.flags = 0;
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CHAL_CAP;
+  spdm_context->local_context->capability.flags = 0;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CHAL_CAP;
   spdm_context->connection_info.algorithm.base_hash_algo = m_use_hash_algo;
   spdm_context->connection_info.algorithm.base_asym_algo = m_use_asym_algo;
   spdm_context->connection_info.algorithm.measurement_spec = m_use_measurement_spec;
@@ -667,12 +707,16 @@ void test_spdm_responder_challenge_auth_case11(void **state) {
   spdm_context->connection_info.version.spdm_version[0].major_version = 1;
   spdm_context->connection_info.version.spdm_version[0].minor_version = 1;
   read_responder_public_certificate_chain (m_use_hash_algo, m_use_asym_algo, &data1, &data_size1, NULL, NULL);
-  spdm_context->local_context.local_cert_chain_provision[0] = data1;
-  spdm_context->local_context.local_cert_chain_provision_size[0] = data_size1;
-  spdm_context->local_context.slot_count = 1;
-  spdm_context->local_context.opaque_challenge_auth_rsp_size = 8;
-  spdm_context->local_context.opaque_challenge_auth_rsp = m_opaque_challenge_auth_rsp;
+  spdm_context->local_context->local_cert_chain_provision[0] = data1;
+  spdm_context->local_context->local_cert_chain_provision_size[0] = data_size1;
+  spdm_context->local_context->slot_count = 1;
+  spdm_context->local_context->opaque_challenge_auth_rsp_size = 8;
+  spdm_context->local_context->opaque_challenge_auth_rsp = m_opaque_challenge_auth_rsp;
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
   spdm_context->transcript.message_c.buffer_size = 0;
+#else
+  spdm_reset_message_c(spdm_context);
+#endif
 
   response_size = sizeof(response);
   spdm_get_random_number (SPDM_NONCE_SIZE, m_spdm_challenge_request1.nonce);
@@ -706,9 +750,9 @@ void test_spdm_responder_challenge_auth_case12(void **state) {
   spdm_context = spdm_test_context->spdm_context;
   spdm_test_context->case_id = 0xC;
   spdm_context->connection_info.connection_state = SPDM_CONNECTION_STATE_NEGOTIATED;
-  spdm_context->local_context.capability.flags = 0;
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CHAL_CAP;
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MEAS_CAP; //additional measurement capability
+  spdm_context->local_context->capability.flags = 0;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CHAL_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MEAS_CAP; //additional measurement capability
   spdm_context->connection_info.algorithm.base_hash_algo = m_use_hash_algo;
   spdm_context->connection_info.algorithm.base_asym_algo = m_use_asym_algo;
   spdm_context->connection_info.algorithm.measurement_spec = m_use_measurement_spec;
@@ -717,11 +761,15 @@ void test_spdm_responder_challenge_auth_case12(void **state) {
   spdm_context->connection_info.version.spdm_version[0].major_version = 1;
   spdm_context->connection_info.version.spdm_version[0].minor_version = 1;
   read_responder_public_certificate_chain (m_use_hash_algo, m_use_asym_algo, &data1, &data_size1, NULL, NULL);
-  spdm_context->local_context.local_cert_chain_provision[0] = data1;
-  spdm_context->local_context.local_cert_chain_provision_size[0] = data_size1;
-  spdm_context->local_context.slot_count = 1;
-  spdm_context->local_context.opaque_challenge_auth_rsp_size = 0;
+  spdm_context->local_context->local_cert_chain_provision[0] = data1;
+  spdm_context->local_context->local_cert_chain_provision_size[0] = data_size1;
+  spdm_context->local_context->slot_count = 1;
+  spdm_context->local_context->opaque_challenge_auth_rsp_size = 0;
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
   spdm_context->transcript.message_c.buffer_size = 0;
+#else
+  spdm_reset_message_c(spdm_context);
+#endif
 
   response_size = sizeof(response);
   spdm_get_random_number (SPDM_NONCE_SIZE, m_spdm_challenge_request1.nonce);
@@ -755,9 +803,9 @@ void test_spdm_responder_challenge_auth_case13(void **state) {
   spdm_context = spdm_test_context->spdm_context;
   spdm_test_context->case_id = 0xD;
   spdm_context->connection_info.connection_state = SPDM_CONNECTION_STATE_NEGOTIATED;
-  spdm_context->local_context.capability.flags = 0;
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CHAL_CAP;
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MEAS_CAP; //additional measurement capability
+  spdm_context->local_context->capability.flags = 0;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CHAL_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MEAS_CAP; //additional measurement capability
   spdm_context->connection_info.algorithm.base_hash_algo = m_use_hash_algo;
   spdm_context->connection_info.algorithm.base_asym_algo = m_use_asym_algo;
   spdm_context->connection_info.algorithm.measurement_spec = m_use_measurement_spec;
@@ -766,11 +814,15 @@ void test_spdm_responder_challenge_auth_case13(void **state) {
   spdm_context->connection_info.version.spdm_version[0].major_version = 1;
   spdm_context->connection_info.version.spdm_version[0].minor_version = 1;
   read_responder_public_certificate_chain (m_use_hash_algo, m_use_asym_algo, &data1, &data_size1, NULL, NULL);
-  spdm_context->local_context.local_cert_chain_provision[0] = data1;
-  spdm_context->local_context.local_cert_chain_provision_size[0] = data_size1;
-  spdm_context->local_context.slot_count = 1;
-  spdm_context->local_context.opaque_challenge_auth_rsp_size = 0;
+  spdm_context->local_context->local_cert_chain_provision[0] = data1;
+  spdm_context->local_context->local_cert_chain_provision_size[0] = data_size1;
+  spdm_context->local_context->slot_count = 1;
+  spdm_context->local_context->opaque_challenge_auth_rsp_size = 0;
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
   spdm_context->transcript.message_c.buffer_size = 0;
+#else
+  spdm_reset_message_c(spdm_context);
+#endif
 
   response_size = sizeof(response);
   spdm_get_random_number (SPDM_NONCE_SIZE, m_spdm_challenge_request1.nonce);
@@ -805,9 +857,9 @@ void test_spdm_responder_challenge_auth_case14(void **state) {
   spdm_context = spdm_test_context->spdm_context;
   spdm_test_context->case_id = 0xE;
   spdm_context->connection_info.connection_state = SPDM_CONNECTION_STATE_NEGOTIATED;
-  spdm_context->local_context.capability.flags = 0;
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CHAL_CAP;
-  // spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MEAS_CAP; //no measurement capability
+  spdm_context->local_context->capability.flags = 0;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CHAL_CAP;
+  // spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MEAS_CAP; //no measurement capability
   spdm_context->connection_info.algorithm.base_hash_algo = m_use_hash_algo;
   spdm_context->connection_info.algorithm.base_asym_algo = m_use_asym_algo;
   spdm_context->connection_info.algorithm.measurement_spec = m_use_measurement_spec;
@@ -816,11 +868,15 @@ void test_spdm_responder_challenge_auth_case14(void **state) {
   spdm_context->connection_info.version.spdm_version[0].major_version = 1;
   spdm_context->connection_info.version.spdm_version[0].minor_version = 1;
   read_responder_public_certificate_chain (m_use_hash_algo, m_use_asym_algo, &data1, &data_size1, NULL, NULL);
-  spdm_context->local_context.local_cert_chain_provision[0] = data1;
-  spdm_context->local_context.local_cert_chain_provision_size[0] = data_size1;
-  spdm_context->local_context.slot_count = 1;
-  spdm_context->local_context.opaque_challenge_auth_rsp_size = 0;
+  spdm_context->local_context->local_cert_chain_provision[0] = data1;
+  spdm_context->local_context->local_cert_chain_provision_size[0] = data_size1;
+  spdm_context->local_context->slot_count = 1;
+  spdm_context->local_context->opaque_challenge_auth_rsp_size = 0;
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
   spdm_context->transcript.message_c.buffer_size = 0;
+#else
+  spdm_reset_message_c(spdm_context);
+#endif
 
   response_size = sizeof(response);
   spdm_get_random_number (SPDM_NONCE_SIZE, m_spdm_challenge_request1.nonce);
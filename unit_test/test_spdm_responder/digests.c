@@ -43,17 +43,17 @@ void test_spdm_responder_digests_case1(void **state)
 	spdm_test_context->case_id = 0x1;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_NEGOTIATED;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
-	spdm_context->local_context.local_cert_chain_provision[0] =
+	spdm_context->local_context->local_cert_chain_provision[0] =
 		m_local_certificate_chain;
-	spdm_context->local_context.local_cert_chain_provision_size[0] =
+	spdm_context->local_context->local_cert_chain_provision_size[0] =
 		MAX_SPDM_MESSAGE_BUFFER_SIZE;
 	set_mem(m_local_certificate_chain, MAX_SPDM_MESSAGE_BUFFER_SIZE,
 		(uint8)(0xFF));
-	spdm_context->local_context.slot_count = 1;
+	spdm_context->local_context->slot_count = 1;
 	spdm_context->transcript.message_m.buffer_size =
 		spdm_context->transcript.message_m.max_buffer_size;
 
@@ -93,17 +93,17 @@ void test_spdm_responder_digests_case2(void **state)
 	spdm_test_context->case_id = 0x2;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_NEGOTIATED;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
-	spdm_context->local_context.local_cert_chain_provision[0] =
+	spdm_context->local_context->local_cert_chain_provision[0] =
 		m_local_certificate_chain;
-	spdm_context->local_context.local_cert_chain_provision_size[0] =
+	spdm_context->local_context->local_cert_chain_provision_size[0] =
 		MAX_SPDM_MESSAGE_BUFFER_SIZE;
 	set_mem(m_local_certificate_chain, MAX_SPDM_MESSAGE_BUFFER_SIZE,
 		(uint8)(0xFF));
-	spdm_context->local_context.slot_count = 1;
+	spdm_context->local_context->slot_count = 1;
 
 	response_size = sizeof(response);
 	status = spdm_get_response_digests(spdm_context,
@@ -140,17 +140,17 @@ void test_spdm_responder_digests_case3(void **state)
 	spdm_context->response_state = SPDM_RESPONSE_STATE_BUSY;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_NEGOTIATED;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
-	spdm_context->local_context.local_cert_chain_provision[0] =
+	spdm_context->local_context->local_cert_chain_provision[0] =
 		m_local_certificate_chain;
-	spdm_context->local_context.local_cert_chain_provision_size[0] =
+	spdm_context->local_context->local_cert_chain_provision_size[0] =
 		MAX_SPDM_MESSAGE_BUFFER_SIZE;
 	set_mem(m_local_certificate_chain, MAX_SPDM_MESSAGE_BUFFER_SIZE,
 		(uint8)(0xFF));
-	spdm_context->local_context.slot_count = 1;
+	spdm_context->local_context->slot_count = 1;
 
 	response_size = sizeof(response);
 	status = spdm_get_response_digests(spdm_context,
@@ -187,17 +187,17 @@ void test_spdm_responder_digests_case4(void **state)
 	spdm_context->response_state = SPDM_RESPONSE_STATE_NEED_RESYNC;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_NEGOTIATED;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
-	spdm_context->local_context.local_cert_chain_provision[0] =
+	spdm_context->local_context->local_cert_chain_provision[0] =
 		m_local_certificate_chain;
-	spdm_context->local_context.local_cert_chain_provision_size[0] =
+	spdm_context->local_context->local_cert_chain_provision_size[0] =
 		MAX_SPDM_MESSAGE_BUFFER_SIZE;
 	set_mem(m_local_certificate_chain, MAX_SPDM_MESSAGE_BUFFER_SIZE,
 		(uint8)(0xFF));
-	spdm_context->local_context.slot_count = 1;
+	spdm_context->local_context->slot_count = 1;
 
 	response_size = sizeof(response);
 	status = spdm_get_response_digests(spdm_context,
@@ -236,17 +236,17 @@ void test_spdm_responder_digests_case5(void **state)
 	spdm_context->response_state = SPDM_RESPONSE_STATE_NOT_READY;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_NEGOTIATED;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
-	spdm_context->local_context.local_cert_chain_provision[0] =
+	spdm_context->local_context->local_cert_chain_provision[0] =
 		m_local_certificate_chain;
-	spdm_context->local_context.local_cert_chain_provision_size[0] =
+	spdm_context->local_context->local_cert_chain_provision_size[0] =
 		MAX_SPDM_MESSAGE_BUFFER_SIZE;
 	set_mem(m_local_certificate_chain, MAX_SPDM_MESSAGE_BUFFER_SIZE,
 		(uint8)(0xFF));
-	spdm_context->local_context.slot_count = 1;
+	spdm_context->local_context->slot_count = 1;
 
 	response_size = sizeof(response);
 	status = spdm_get_response_digests(spdm_context,
@@ -290,17 +290,17 @@ void test_spdm_responder_digests_case6(void **state)
 	spdm_context->response_state = SPDM_RESPONSE_STATE_NORMAL;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_NOT_STARTED;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
-	spdm_context->local_context.local_cert_chain_provision[0] =
+	spdm_context->local_context->local_cert_chain_provision[0] =
 		m_local_certificate_chain;
-	spdm_context->local_context.local_cert_chain_provision_size[0] =
+	spdm_context->local_context->local_cert_chain_provision_size[0] =
 		MAX_SPDM_MESSAGE_BUFFER_SIZE;
 	set_mem(m_local_certificate_chain, MAX_SPDM_MESSAGE_BUFFER_SIZE,
 		(uint8)(0xFF));
-	spdm_context->local_context.slot_count = 1;
+	spdm_context->local_context->slot_count = 1;
 
 	response_size = sizeof(response);
 	status = spdm_get_response_digests(spdm_context,
@@ -335,26 +335,29 @@ void test_spdm_responder_digests_case7(void **state)
 	spdm_test_context->case_id = 0x7;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_NEGOTIATED;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
-	spdm_context->local_context.local_cert_chain_provision[0] =
+	spdm_context->local_context->local_cert_chain_provision[0] =
 		m_local_certificate_chain;
-	spdm_context->local_context.local_cert_chain_provision_size[0] =
+	spdm_context->local_context->local_cert_chain_provision_size[0] =
 		MAX_SPDM_MESSAGE_BUFFER_SIZE;
 	set_mem(m_local_certificate_chain, MAX_SPDM_MESSAGE_BUFFER_SIZE,
 		(uint8)(0xFF));
-	spdm_context->local_context.slot_count = 1;
+	spdm_context->local_context->slot_count = 1;
 
 	response_size = sizeof(response);
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	spdm_context->transcript.message_b.buffer_size =
 		spdm_context->transcript.message_b.max_buffer_size;
+#endif
 	status = spdm_get_response_digests(spdm_context,
 					   m_spdm_get_digests_request1_size,
 					   &m_spdm_get_digests_request1,
 					   &response_size, response);
 	assert_int_equal(status, RETURN_SUCCESS);
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	assert_int_equal(response_size, sizeof(spdm_error_response_t));
 	spdm_response = (void *)response;
 	assert_int_equal(spdm_response->header.request_response_code,
@@ -362,6 +365,15 @@ void test_spdm_responder_digests_case7(void **state)
 	assert_int_equal(spdm_response->header.param1,
 			 SPDM_ERROR_CODE_UNSPECIFIED);
 	assert_int_equal(spdm_response->header.param2, 0);
+#else
+	//
+	// Without the transcript buffer message B is hashed on the fly, so
+	// there is no cache to overflow.
+	//
+	spdm_response = (void *)response;
+	assert_int_equal(spdm_response->header.request_response_code,
+			 SPDM_DIGESTS);
+#endif
 }
 
 /**
@@ -382,27 +394,30 @@ void test_spdm_responder_digests_case8(void **state)
 	spdm_test_context->case_id = 0x8;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_NEGOTIATED;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
-	spdm_context->local_context.local_cert_chain_provision[0] =
+	spdm_context->local_context->local_cert_chain_provision[0] =
 		m_local_certificate_chain;
-	spdm_context->local_context.local_cert_chain_provision_size[0] =
+	spdm_context->local_context->local_cert_chain_provision_size[0] =
 		MAX_SPDM_MESSAGE_BUFFER_SIZE;
 	set_mem(m_local_certificate_chain, MAX_SPDM_MESSAGE_BUFFER_SIZE,
 		(uint8)(0xFF));
-	spdm_context->local_context.slot_count = 1;
+	spdm_context->local_context->slot_count = 1;
 
 	response_size = sizeof(response);
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	spdm_context->transcript.message_b.buffer_size =
 		spdm_context->transcript.message_b.max_buffer_size -
 		sizeof(spdm_get_digest_request_t);
+#endif
 	status = spdm_get_response_digests(spdm_context,
 					   m_spdm_get_digests_request1_size,
 					   &m_spdm_get_digests_request1,
 					   &response_size, response);
 	assert_int_equal(status, RETURN_SUCCESS);
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	assert_int_equal(response_size, sizeof(spdm_error_response_t));
 	spdm_response = (void *)response;
 	assert_int_equal(spdm_response->header.request_response_code,
@@ -410,6 +425,15 @@ void test_spdm_responder_digests_case8(void **state)
 	assert_int_equal(spdm_response->header.param1,
 			 SPDM_ERROR_CODE_UNSPECIFIED);
 	assert_int_equal(spdm_response->header.param2, 0);
+#else
+	//
+	// Without the transcript buffer message B is hashed on the fly, so
+	// there is no cache to overflow.
+	//
+	spdm_response = (void *)response;
+	assert_int_equal(spdm_response->header.request_response_code,
+			 SPDM_DIGESTS);
+#endif
 }
 
 /**
@@ -431,21 +455,25 @@ void test_spdm_responder_digests_case9(void **state)
 	spdm_test_context->case_id = 0x9;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_NEGOTIATED;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
 
 	for (index = 0; index < MAX_SPDM_SLOT_COUNT; index++) {
-		spdm_context->local_context.local_cert_chain_provision[index] =
+		spdm_context->local_context->local_cert_chain_provision[index] =
 			NULL;
 		spdm_context->local_context
-			.local_cert_chain_provision_size[index] = 0;
+			->local_cert_chain_provision_size[index] = 0;
 	}
-	spdm_context->local_context.slot_count = 0;
+	spdm_context->local_context->slot_count = 0;
 
 	response_size = sizeof(response);
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	spdm_context->transcript.message_b.buffer_size = 0;
+#else
+	spdm_reset_message_b(spdm_context);
+#endif
 	status = spdm_get_response_digests(spdm_context,
 					   m_spdm_get_digests_request1_size,
 					   &m_spdm_get_digests_request1,
@@ -460,6 +488,97 @@ void test_spdm_responder_digests_case9(void **state)
 	assert_int_equal(spdm_response->header.param2, SPDM_GET_DIGESTS);
 }
 
+/**
+  Test 10: receives two GET_DIGESTS request messages, with the certificate chain content changed in between
+  Expected Behavior: the second DIGESTS response reports the cached hash until the certificate chain
+  is provisioned again with spdm_set_data, which invalidates the cache.
+**/
+void test_spdm_responder_digests_case10(void **state)
+{
+	return_status status;
+	spdm_test_context_t *spdm_test_context;
+	spdm_context_t *spdm_context;
+	spdm_data_parameter_t parameter;
+	uintn response_size;
+	uint8 response[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+	spdm_digest_response_t *spdm_response;
+	uint8 hash1[MAX_HASH_SIZE];
+	uint8 hash2[MAX_HASH_SIZE];
+	uintn hash_size;
+
+	spdm_test_context = *state;
+	spdm_context = spdm_test_context->spdm_context;
+	spdm_test_context->case_id = 0xA;
+	spdm_context->connection_info.connection_state =
+		SPDM_CONNECTION_STATE_NEGOTIATED;
+	spdm_context->local_context->capability.flags |=
+		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
+	spdm_context->connection_info.algorithm.base_hash_algo =
+		m_use_hash_algo;
+	hash_size = spdm_get_hash_size(m_use_hash_algo);
+	spdm_context->local_context->slot_count = 1;
+	set_mem(m_local_certificate_chain, MAX_SPDM_MESSAGE_BUFFER_SIZE,
+		(uint8)(0xFF));
+	zero_mem(&parameter, sizeof(parameter));
+	parameter.location = SPDM_DATA_LOCATION_LOCAL;
+	parameter.additional_data[0] = 0;
+	status = spdm_set_data(spdm_context, SPDM_DATA_LOCAL_PUBLIC_CERT_CHAIN,
+			       &parameter, m_local_certificate_chain,
+			       MAX_SPDM_MESSAGE_BUFFER_SIZE);
+	assert_int_equal(status, RETURN_SUCCESS);
+	spdm_hash_all(m_use_hash_algo, m_local_certificate_chain,
+		      MAX_SPDM_MESSAGE_BUFFER_SIZE, hash1);
+
+	response_size = sizeof(response);
+	status = spdm_get_response_digests(spdm_context,
+					   m_spdm_get_digests_request1_size,
+					   &m_spdm_get_digests_request1,
+					   &response_size, response);
+	assert_int_equal(status, RETURN_SUCCESS);
+	spdm_response = (void *)response;
+	assert_memory_equal(spdm_response + 1, hash1, hash_size);
+	assert_int_equal(
+		spdm_context->local_cert_chain_hash_cache[0].base_hash_algo,
+		m_use_hash_algo);
+
+	//
+	// Change the content only. The cached hash is still reported.
+	//
+	set_mem(m_local_certificate_chain, MAX_SPDM_MESSAGE_BUFFER_SIZE,
+		(uint8)(0xEE));
+	spdm_hash_all(m_use_hash_algo, m_local_certificate_chain,
+		      MAX_SPDM_MESSAGE_BUFFER_SIZE, hash2);
+	spdm_context->connection_info.connection_state =
+		SPDM_CONNECTION_STATE_NEGOTIATED;
+	response_size = sizeof(response);
+	status = spdm_get_response_digests(spdm_context,
+					   m_spdm_get_digests_request1_size,
+					   &m_spdm_get_digests_request1,
+					   &response_size, response);
+	assert_int_equal(status, RETURN_SUCCESS);
+	assert_memory_equal(spdm_response + 1, hash1, hash_size);
+
+	//
+	// Provision it again. The cache is invalidated and the new hash is reported.
+	//
+	status = spdm_set_data(spdm_context, SPDM_DATA_LOCAL_PUBLIC_CERT_CHAIN,
+			       &parameter, m_local_certificate_chain,
+			       MAX_SPDM_MESSAGE_BUFFER_SIZE);
+	assert_int_equal(status, RETURN_SUCCESS);
+	assert_int_not_equal(
+		spdm_context->local_cert_chain_hash_cache[0].generation,
+		spdm_context->local_context->local_cert_chain_generation[0]);
+	spdm_context->connection_info.connection_state =
+		SPDM_CONNECTION_STATE_NEGOTIATED;
+	response_size = sizeof(response);
+	status = spdm_get_response_digests(spdm_context,
+					   m_spdm_get_digests_request1_size,
+					   &m_spdm_get_digests_request1,
+					   &response_size, response);
+	assert_int_equal(status, RETURN_SUCCESS);
+	assert_memory_equal(spdm_response + 1, hash2, hash_size);
+}
+
 spdm_test_context_t m_spdm_responder_digests_test_context = {
 	SPDM_TEST_CONTEXT_SIGNATURE,
 	FALSE,
@@ -486,6 +605,8 @@ int spdm_responder_digests_test_main(void)
 		cmocka_unit_test(test_spdm_responder_digests_case8),
 		// No digest to send
 		cmocka_unit_test(test_spdm_responder_digests_case9),
+		// Cached certificate chain hash and its invalidation
+		cmocka_unit_test(test_spdm_responder_digests_case10),
 	};
 
 	setup_spdm_test_context(&m_spdm_responder_digests_test_context);
@@ -81,7 +81,7 @@ void test_spdm_responder_finish_case1(void **state)
 		SPDM_CONNECTION_STATE_NEGOTIATED;
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_KEY_EX_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -98,20 +98,24 @@ void test_spdm_responder_finish_case1(void **state)
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data1,
 						&data_size1, NULL, NULL);
-	spdm_context->local_context.local_cert_chain_provision[0] = data1;
-	spdm_context->local_context.local_cert_chain_provision_size[0] =
+	spdm_context->local_context->local_cert_chain_provision[0] = data1;
+	spdm_context->local_context->local_cert_chain_provision_size[0] =
 		data_size1;
 	spdm_context->connection_info.local_used_cert_chain_buffer = data1;
 	spdm_context->connection_info.local_used_cert_chain_buffer_size =
 		data_size1;
-	spdm_context->local_context.slot_count = 1;
+	spdm_context->local_context->slot_count = 1;
 	spdm_context->transcript.message_a.buffer_size = 0;
-	spdm_context->local_context.mut_auth_requested = 0;
+	spdm_context->local_context->mut_auth_requested = 0;
 
 	session_id = 0xFFFFFFFF;
 	spdm_context->latest_session_id = session_id;
 	session_info = &spdm_context->session_info[0];
 	spdm_session_info_init(spdm_context, session_info, session_id, FALSE);
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 0
+	// message_k is empty, only seed the TH hash context with (A, Ct).
+	spdm_append_message_k(spdm_context, session_info, FALSE, NULL, 0);
+#endif
 	hash_size = spdm_get_hash_size(m_use_hash_algo);
 	set_mem(m_dummy_buffer, hash_size, (uint8)(0xFF));
 	spdm_secured_message_set_request_finished_key(
@@ -123,7 +127,7 @@ void test_spdm_responder_finish_case1(void **state)
 
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_HANDSHAKE_IN_THE_CLEAR_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_HANDSHAKE_IN_THE_CLEAR_CAP;
 	hash_size = spdm_get_hash_size(m_use_hash_algo);
 	hmac_size = spdm_get_hash_size(m_use_hash_algo);
@@ -189,7 +193,7 @@ void test_spdm_responder_finish_case2(void **state)
 		SPDM_CONNECTION_STATE_NEGOTIATED;
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_KEY_EX_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -206,20 +210,24 @@ void test_spdm_responder_finish_case2(void **state)
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data1,
 						&data_size1, NULL, NULL);
-	spdm_context->local_context.local_cert_chain_provision[0] = data1;
-	spdm_context->local_context.local_cert_chain_provision_size[0] =
+	spdm_context->local_context->local_cert_chain_provision[0] = data1;
+	spdm_context->local_context->local_cert_chain_provision_size[0] =
 		data_size1;
 	spdm_context->connection_info.local_used_cert_chain_buffer = data1;
 	spdm_context->connection_info.local_used_cert_chain_buffer_size =
 		data_size1;
-	spdm_context->local_context.slot_count = 1;
+	spdm_context->local_context->slot_count = 1;
 	spdm_context->transcript.message_a.buffer_size = 0;
-	spdm_context->local_context.mut_auth_requested = 0;
+	spdm_context->local_context->mut_auth_requested = 0;
 
 	session_id = 0xFFFFFFFF;
 	spdm_context->latest_session_id = session_id;
 	session_info = &spdm_context->session_info[0];
 	spdm_session_info_init(spdm_context, session_info, session_id, FALSE);
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 0
+	// message_k is empty, only seed the TH hash context with (A, Ct).
+	spdm_append_message_k(spdm_context, session_info, FALSE, NULL, 0);
+#endif
 	hash_size = spdm_get_hash_size(m_use_hash_algo);
 	set_mem(m_dummy_buffer, hash_size, (uint8)(0xFF));
 	spdm_secured_message_set_request_finished_key(
@@ -231,7 +239,7 @@ void test_spdm_responder_finish_case2(void **state)
 
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_HANDSHAKE_IN_THE_CLEAR_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_HANDSHAKE_IN_THE_CLEAR_CAP;
 	hash_size = spdm_get_hash_size(m_use_hash_algo);
 	ptr = m_spdm_finish_request2.signature;
@@ -300,7 +308,7 @@ void test_spdm_responder_finish_case3(void **state)
 		SPDM_CONNECTION_STATE_NEGOTIATED;
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_KEY_EX_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -317,20 +325,24 @@ void test_spdm_responder_finish_case3(void **state)
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data1,
 						&data_size1, NULL, NULL);
-	spdm_context->local_context.local_cert_chain_provision[0] = data1;
-	spdm_context->local_context.local_cert_chain_provision_size[0] =
+	spdm_context->local_context->local_cert_chain_provision[0] = data1;
+	spdm_context->local_context->local_cert_chain_provision_size[0] =
 		data_size1;
 	spdm_context->connection_info.local_used_cert_chain_buffer = data1;
 	spdm_context->connection_info.local_used_cert_chain_buffer_size =
 		data_size1;
-	spdm_context->local_context.slot_count = 1;
+	spdm_context->local_context->slot_count = 1;
 	spdm_context->transcript.message_a.buffer_size = 0;
-	spdm_context->local_context.mut_auth_requested = 0;
+	spdm_context->local_context->mut_auth_requested = 0;
 
 	session_id = 0xFFFFFFFF;
 	spdm_context->latest_session_id = session_id;
 	session_info = &spdm_context->session_info[0];
 	spdm_session_info_init(spdm_context, session_info, session_id, FALSE);
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 0
+	// message_k is empty, only seed the TH hash context with (A, Ct).
+	spdm_append_message_k(spdm_context, session_info, FALSE, NULL, 0);
+#endif
 	hash_size = spdm_get_hash_size(m_use_hash_algo);
 	set_mem(m_dummy_buffer, hash_size, (uint8)(0xFF));
 	spdm_secured_message_set_request_finished_key(
@@ -342,7 +354,7 @@ void test_spdm_responder_finish_case3(void **state)
 
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_HANDSHAKE_IN_THE_CLEAR_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_HANDSHAKE_IN_THE_CLEAR_CAP;
 	hash_size = spdm_get_hash_size(m_use_hash_algo);
 	hmac_size = spdm_get_hash_size(m_use_hash_algo);
@@ -414,7 +426,7 @@ void test_spdm_responder_finish_case4(void **state)
 		SPDM_CONNECTION_STATE_NEGOTIATED;
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_KEY_EX_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -431,20 +443,24 @@ void test_spdm_responder_finish_case4(void **state)
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data1,
 						&data_size1, NULL, NULL);
-	spdm_context->local_context.local_cert_chain_provision[0] = data1;
-	spdm_context->local_context.local_cert_chain_provision_size[0] =
+	spdm_context->local_context->local_cert_chain_provision[0] = data1;
+	spdm_context->local_context->local_cert_chain_provision_size[0] =
 		data_size1;
 	spdm_context->connection_info.local_used_cert_chain_buffer = data1;
 	spdm_context->connection_info.local_used_cert_chain_buffer_size =
 		data_size1;
-	spdm_context->local_context.slot_count = 1;
+	spdm_context->local_context->slot_count = 1;
 	spdm_context->transcript.message_a.buffer_size = 0;
-	spdm_context->local_context.mut_auth_requested = 0;
+	spdm_context->local_context->mut_auth_requested = 0;
 
 	session_id = 0xFFFFFFFF;
 	spdm_context->latest_session_id = session_id;
 	session_info = &spdm_context->session_info[0];
 	spdm_session_info_init(spdm_context, session_info, session_id, FALSE);
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 0
+	// message_k is empty, only seed the TH hash context with (A, Ct).
+	spdm_append_message_k(spdm_context, session_info, FALSE, NULL, 0);
+#endif
 	hash_size = spdm_get_hash_size(m_use_hash_algo);
 	set_mem(m_dummy_buffer, hash_size, (uint8)(0xFF));
 	spdm_secured_message_set_request_finished_key(
@@ -456,7 +472,7 @@ void test_spdm_responder_finish_case4(void **state)
 
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_HANDSHAKE_IN_THE_CLEAR_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_HANDSHAKE_IN_THE_CLEAR_CAP;
 	hash_size = spdm_get_hash_size(m_use_hash_algo);
 	hmac_size = spdm_get_hash_size(m_use_hash_algo);
@@ -530,7 +546,7 @@ void test_spdm_responder_finish_case5(void **state)
 		SPDM_CONNECTION_STATE_NEGOTIATED;
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_KEY_EX_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -547,20 +563,24 @@ void test_spdm_responder_finish_case5(void **state)
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data1,
 						&data_size1, NULL, NULL);
-	spdm_context->local_context.local_cert_chain_provision[0] = data1;
-	spdm_context->local_context.local_cert_chain_provision_size[0] =
+	spdm_context->local_context->local_cert_chain_provision[0] = data1;
+	spdm_context->local_context->local_cert_chain_provision_size[0] =
 		data_size1;
 	spdm_context->connection_info.local_used_cert_chain_buffer = data1;
 	spdm_context->connection_info.local_used_cert_chain_buffer_size =
 		data_size1;
-	spdm_context->local_context.slot_count = 1;
+	spdm_context->local_context->slot_count = 1;
 	spdm_context->transcript.message_a.buffer_size = 0;
-	spdm_context->local_context.mut_auth_requested = 0;
+	spdm_context->local_context->mut_auth_requested = 0;
 
 	session_id = 0xFFFFFFFF;
 	spdm_context->latest_session_id = session_id;
 	session_info = &spdm_context->session_info[0];
 	spdm_session_info_init(spdm_context, session_info, session_id, FALSE);
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 0
+	// message_k is empty, only seed the TH hash context with (A, Ct).
+	spdm_append_message_k(spdm_context, session_info, FALSE, NULL, 0);
+#endif
 	hash_size = spdm_get_hash_size(m_use_hash_algo);
 	set_mem(m_dummy_buffer, hash_size, (uint8)(0xFF));
 	spdm_secured_message_set_request_finished_key(
@@ -572,7 +592,7 @@ void test_spdm_responder_finish_case5(void **state)
 
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_HANDSHAKE_IN_THE_CLEAR_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_HANDSHAKE_IN_THE_CLEAR_CAP;
 	hash_size = spdm_get_hash_size(m_use_hash_algo);
 	hmac_size = spdm_get_hash_size(m_use_hash_algo);
@@ -652,7 +672,7 @@ void test_spdm_responder_finish_case6(void **state)
 		SPDM_CONNECTION_STATE_NOT_STARTED;
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_KEY_EX_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -669,20 +689,24 @@ void test_spdm_responder_finish_case6(void **state)
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data1,
 						&data_size1, NULL, NULL);
-	spdm_context->local_context.local_cert_chain_provision[0] = data1;
-	spdm_context->local_context.local_cert_chain_provision_size[0] =
+	spdm_context->local_context->local_cert_chain_provision[0] = data1;
+	spdm_context->local_context->local_cert_chain_provision_size[0] =
 		data_size1;
 	spdm_context->connection_info.local_used_cert_chain_buffer = data1;
 	spdm_context->connection_info.local_used_cert_chain_buffer_size =
 		data_size1;
-	spdm_context->local_context.slot_count = 1;
+	spdm_context->local_context->slot_count = 1;
 	spdm_context->transcript.message_a.buffer_size = 0;
-	spdm_context->local_context.mut_auth_requested = 0;
+	spdm_context->local_context->mut_auth_requested = 0;
 
 	session_id = 0xFFFFFFFF;
 	spdm_context->latest_session_id = session_id;
 	session_info = &spdm_context->session_info[0];
 	spdm_session_info_init(spdm_context, session_info, session_id, FALSE);
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 0
+	// message_k is empty, only seed the TH hash context with (A, Ct).
+	spdm_append_message_k(spdm_context, session_info, FALSE, NULL, 0);
+#endif
 	hash_size = spdm_get_hash_size(m_use_hash_algo);
 	set_mem(m_dummy_buffer, hash_size, (uint8)(0xFF));
 	spdm_secured_message_set_request_finished_key(
@@ -694,7 +718,7 @@ void test_spdm_responder_finish_case6(void **state)
 
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_HANDSHAKE_IN_THE_CLEAR_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_HANDSHAKE_IN_THE_CLEAR_CAP;
 	hash_size = spdm_get_hash_size(m_use_hash_algo);
 	hmac_size = spdm_get_hash_size(m_use_hash_algo);
@@ -758,7 +782,7 @@ void test_spdm_responder_finish_case7(void **state)
 		SPDM_CONNECTION_STATE_NEGOTIATED;
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_KEY_EX_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -775,20 +799,24 @@ void test_spdm_responder_finish_case7(void **state)
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data1,
 						&data_size1, NULL, NULL);
-	spdm_context->local_context.local_cert_chain_provision[0] = data1;
-	spdm_context->local_context.local_cert_chain_provision_size[0] =
+	spdm_context->local_context->local_cert_chain_provision[0] = data1;
+	spdm_context->local_context->local_cert_chain_provision_size[0] =
 		data_size1;
 	spdm_context->connection_info.local_used_cert_chain_buffer = data1;
 	spdm_context->connection_info.local_used_cert_chain_buffer_size =
 		data_size1;
-	spdm_context->local_context.slot_count = 1;
+	spdm_context->local_context->slot_count = 1;
 	spdm_context->transcript.message_a.buffer_size = 0;
-	spdm_context->local_context.mut_auth_requested = 0;
+	spdm_context->local_context->mut_auth_requested = 0;
 
 	session_id = 0xFFFFFFFF;
 	spdm_context->latest_session_id = session_id;
 	session_info = &spdm_context->session_info[0];
 	spdm_session_info_init(spdm_context, session_info, session_id, FALSE);
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 0
+	// message_k is empty, only seed the TH hash context with (A, Ct).
+	spdm_append_message_k(spdm_context, session_info, FALSE, NULL, 0);
+#endif
 	hash_size = spdm_get_hash_size(m_use_hash_algo);
 	set_mem(m_dummy_buffer, hash_size, (uint8)(0xFF));
 	spdm_secured_message_set_request_finished_key(
@@ -800,7 +828,7 @@ void test_spdm_responder_finish_case7(void **state)
 
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_HANDSHAKE_IN_THE_CLEAR_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_HANDSHAKE_IN_THE_CLEAR_CAP;
 	hash_size = spdm_get_hash_size(m_use_hash_algo);
 	hmac_size = spdm_get_hash_size(m_use_hash_algo);
@@ -810,6 +838,7 @@ void test_spdm_responder_finish_case7(void **state)
 	cert_buffer_size = data_size1 - (sizeof(spdm_cert_chain_t) + hash_size);
 	spdm_context->transcript.message_m.buffer_size =
 							spdm_context->transcript.message_m.max_buffer_size;
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	spdm_context->transcript.message_b.buffer_size =
 							spdm_context->transcript.message_b.max_buffer_size;
 	spdm_context->transcript.message_c.buffer_size =
@@ -818,6 +847,7 @@ void test_spdm_responder_finish_case7(void **state)
 							spdm_context->transcript.message_mut_b.max_buffer_size;
 	spdm_context->transcript.message_mut_c.buffer_size =
 							spdm_context->transcript.message_mut_c.max_buffer_size;
+#endif
 
 	spdm_hash_all(m_use_hash_algo, cert_buffer, cert_buffer_size,
 		      cert_buffer_hash);
@@ -843,10 +873,12 @@ void test_spdm_responder_finish_case7(void **state)
 	assert_int_equal(spdm_response->header.request_response_code,
 			 SPDM_FINISH_RSP);
 	assert_int_equal(spdm_context->transcript.message_m.buffer_size, 0);
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	assert_int_equal(spdm_context->transcript.message_b.buffer_size, 0);
 	assert_int_equal(spdm_context->transcript.message_c.buffer_size, 0);
 	assert_int_equal(spdm_context->transcript.message_mut_b.buffer_size, 0);
 	assert_int_equal(spdm_context->transcript.message_mut_c.buffer_size, 0);
+#endif
 
 	free(data1);
 }
@@ -890,7 +922,7 @@ void test_spdm_responder_finish_case8(void **state)
 		SPDM_CONNECTION_STATE_NEGOTIATED;
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_KEY_EX_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -909,20 +941,20 @@ void test_spdm_responder_finish_case8(void **state)
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data1,
 						&data_size1, NULL, NULL);
-	spdm_context->local_context.local_cert_chain_provision[0] = data1;
-	spdm_context->local_context.local_cert_chain_provision_size[0] =
+	spdm_context->local_context->local_cert_chain_provision[0] = data1;
+	spdm_context->local_context->local_cert_chain_provision_size[0] =
 		data_size1;
 	spdm_context->connection_info.local_used_cert_chain_buffer = data1;
 	spdm_context->connection_info.local_used_cert_chain_buffer_size =
 		data_size1;
-	spdm_context->local_context.slot_count = 1;
+	spdm_context->local_context->slot_count = 1;
 	spdm_context->transcript.message_a.buffer_size = 0;
-	spdm_context->local_context.mut_auth_requested = 1;
+	spdm_context->local_context->mut_auth_requested = 1;
 	read_requester_public_certificate_chain(m_use_hash_algo,
 						m_use_req_asym_algo, &data2,
 						&data_size2, NULL, NULL);
-	spdm_context->local_context.peer_cert_chain_provision = data2;
-	spdm_context->local_context.peer_cert_chain_provision_size =
+	spdm_context->local_context->peer_cert_chain_provision = data2;
+	spdm_context->local_context->peer_cert_chain_provision_size =
 		data_size2;
 	copy_mem(spdm_context->connection_info.peer_used_cert_chain_buffer,
 		 data2, data_size2);
@@ -933,6 +965,10 @@ void test_spdm_responder_finish_case8(void **state)
 	spdm_context->latest_session_id = session_id;
 	session_info = &spdm_context->session_info[0];
 	spdm_session_info_init(spdm_context, session_info, session_id, FALSE);
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 0
+	// message_k is empty, only seed the TH hash context with (A, Ct).
+	spdm_append_message_k(spdm_context, session_info, FALSE, NULL, 0);
+#endif
 	hash_size = spdm_get_hash_size(m_use_hash_algo);
 	set_mem(m_dummy_buffer, hash_size, (uint8)(0xFF));
 	spdm_secured_message_set_request_finished_key(
@@ -945,7 +981,7 @@ void test_spdm_responder_finish_case8(void **state)
 
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_HANDSHAKE_IN_THE_CLEAR_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_HANDSHAKE_IN_THE_CLEAR_CAP;
 	hash_size = spdm_get_hash_size(m_use_hash_algo);
 	hmac_size = spdm_get_hash_size(m_use_hash_algo);
@@ -1026,7 +1062,7 @@ void test_spdm_responder_finish_case9(void **state)
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_NEGOTIATED;
 	spdm_context->connection_info.capability.flags = 0;
-	spdm_context->local_context.capability.flags = 0;
+	spdm_context->local_context->capability.flags = 0;
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
 	// no key exchange capabilities (responder)
@@ -1045,20 +1081,24 @@ void test_spdm_responder_finish_case9(void **state)
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data1,
 						&data_size1, NULL, NULL);
-	spdm_context->local_context.local_cert_chain_provision[0] = data1;
-	spdm_context->local_context.local_cert_chain_provision_size[0] =
+	spdm_context->local_context->local_cert_chain_provision[0] = data1;
+	spdm_context->local_context->local_cert_chain_provision_size[0] =
 		data_size1;
 	spdm_context->connection_info.local_used_cert_chain_buffer = data1;
 	spdm_context->connection_info.local_used_cert_chain_buffer_size =
 		data_size1;
-	spdm_context->local_context.slot_count = 1;
+	spdm_context->local_context->slot_count = 1;
 	spdm_context->transcript.message_a.buffer_size = 0;
-	spdm_context->local_context.mut_auth_requested = 0;
+	spdm_context->local_context->mut_auth_requested = 0;
 
 	session_id = 0xFFFFFFFF;
 	spdm_context->latest_session_id = session_id;
 	session_info = &spdm_context->session_info[0];
 	spdm_session_info_init(spdm_context, session_info, session_id, FALSE);
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 0
+	// message_k is empty, only seed the TH hash context with (A, Ct).
+	spdm_append_message_k(spdm_context, session_info, FALSE, NULL, 0);
+#endif
 	hash_size = spdm_get_hash_size(m_use_hash_algo);
 	set_mem(m_dummy_buffer, hash_size, (uint8)(0xFF));
 	spdm_secured_message_set_request_finished_key(
@@ -1070,7 +1110,7 @@ void test_spdm_responder_finish_case9(void **state)
 
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_HANDSHAKE_IN_THE_CLEAR_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_HANDSHAKE_IN_THE_CLEAR_CAP;
 	hash_size = spdm_get_hash_size(m_use_hash_algo);
 	hmac_size = spdm_get_hash_size(m_use_hash_algo);
@@ -1141,7 +1181,7 @@ void test_spdm_responder_finish_case10(void **state)
 		SPDM_CONNECTION_STATE_NEGOTIATED;
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_KEY_EX_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -1158,20 +1198,24 @@ void test_spdm_responder_finish_case10(void **state)
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data1,
 						&data_size1, NULL, NULL);
-	spdm_context->local_context.local_cert_chain_provision[0] = data1;
-	spdm_context->local_context.local_cert_chain_provision_size[0] =
+	spdm_context->local_context->local_cert_chain_provision[0] = data1;
+	spdm_context->local_context->local_cert_chain_provision_size[0] =
 		data_size1;
 	spdm_context->connection_info.local_used_cert_chain_buffer = data1;
 	spdm_context->connection_info.local_used_cert_chain_buffer_size =
 		data_size1;
-	spdm_context->local_context.slot_count = 1;
+	spdm_context->local_context->slot_count = 1;
 	spdm_context->transcript.message_a.buffer_size = 0;
-	spdm_context->local_context.mut_auth_requested = 0;
+	spdm_context->local_context->mut_auth_requested = 0;
 
 	session_id = 0xFFFFFFFF;
 	spdm_context->latest_session_id = session_id;
 	session_info = &spdm_context->session_info[0];
 	spdm_session_info_init(spdm_context, session_info, session_id, FALSE);
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 0
+	// message_k is empty, only seed the TH hash context with (A, Ct).
+	spdm_append_message_k(spdm_context, session_info, FALSE, NULL, 0);
+#endif
 	hash_size = spdm_get_hash_size(m_use_hash_algo);
 	set_mem(m_dummy_buffer, hash_size, (uint8)(0xFF));
 	spdm_secured_message_set_request_finished_key(
@@ -1183,7 +1227,7 @@ void test_spdm_responder_finish_case10(void **state)
 
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_HANDSHAKE_IN_THE_CLEAR_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_HANDSHAKE_IN_THE_CLEAR_CAP;
 	hash_size = spdm_get_hash_size(m_use_hash_algo);
 	hmac_size = spdm_get_hash_size(m_use_hash_algo);
@@ -1248,7 +1292,7 @@ void test_spdm_responder_finish_case11(void **state)
 		SPDM_CONNECTION_STATE_NEGOTIATED;
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_KEY_EX_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -1265,20 +1309,24 @@ void test_spdm_responder_finish_case11(void **state)
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data1,
 						&data_size1, NULL, NULL);
-	spdm_context->local_context.local_cert_chain_provision[0] = data1;
-	spdm_context->local_context.local_cert_chain_provision_size[0] =
+	spdm_context->local_context->local_cert_chain_provision[0] = data1;
+	spdm_context->local_context->local_cert_chain_provision_size[0] =
 		data_size1;
 	spdm_context->connection_info.local_used_cert_chain_buffer = data1;
 	spdm_context->connection_info.local_used_cert_chain_buffer_size =
 		data_size1;
-	spdm_context->local_context.slot_count = 1;
+	spdm_context->local_context->slot_count = 1;
 	spdm_context->transcript.message_a.buffer_size = 0;
-	spdm_context->local_context.mut_auth_requested = 0;
+	spdm_context->local_context->mut_auth_requested = 0;
 
 	session_id = 0xFFFFFFFF;
 	spdm_context->latest_session_id = session_id;
 	session_info = &spdm_context->session_info[0];
 	spdm_session_info_init(spdm_context, session_info, session_id, FALSE);
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 0
+	// message_k is empty, only seed the TH hash context with (A, Ct).
+	spdm_append_message_k(spdm_context, session_info, FALSE, NULL, 0);
+#endif
 	hash_size = spdm_get_hash_size(m_use_hash_algo);
 	set_mem(m_dummy_buffer, hash_size, (uint8)(0xFF));
 	spdm_secured_message_set_request_finished_key(
@@ -1290,7 +1338,7 @@ void test_spdm_responder_finish_case11(void **state)
 
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_HANDSHAKE_IN_THE_CLEAR_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_HANDSHAKE_IN_THE_CLEAR_CAP;
 	hash_size = spdm_get_hash_size(m_use_hash_algo);
 	hmac_size = spdm_get_hash_size(m_use_hash_algo);
@@ -1344,7 +1392,7 @@ void test_spdm_responder_finish_case12(void **state)
 		SPDM_CONNECTION_STATE_NEGOTIATED;
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_KEY_EX_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -1361,20 +1409,24 @@ void test_spdm_responder_finish_case12(void **state)
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data1,
 						&data_size1, NULL, NULL);
-	spdm_context->local_context.local_cert_chain_provision[0] = data1;
-	spdm_context->local_context.local_cert_chain_provision_size[0] =
+	spdm_context->local_context->local_cert_chain_provision[0] = data1;
+	spdm_context->local_context->local_cert_chain_provision_size[0] =
 		data_size1;
 	spdm_context->connection_info.local_used_cert_chain_buffer = data1;
 	spdm_context->connection_info.local_used_cert_chain_buffer_size =
 		data_size1;
-	spdm_context->local_context.slot_count = 1;
+	spdm_context->local_context->slot_count = 1;
 	spdm_context->transcript.message_a.buffer_size = 0;
-	spdm_context->local_context.mut_auth_requested = 0;
+	spdm_context->local_context->mut_auth_requested = 0;
 
 	session_id = 0xFFFFFFFF;
 	spdm_context->latest_session_id = session_id;
 	session_info = &spdm_context->session_info[0];
 	spdm_session_info_init(spdm_context, session_info, session_id, FALSE);
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 0
+	// message_k is empty, only seed the TH hash context with (A, Ct).
+	spdm_append_message_k(spdm_context, session_info, FALSE, NULL, 0);
+#endif
 	hash_size = spdm_get_hash_size(m_use_hash_algo);
 	set_mem(m_dummy_buffer, hash_size, (uint8)(0xFF));
 	spdm_secured_message_set_request_finished_key(
@@ -1386,7 +1438,7 @@ void test_spdm_responder_finish_case12(void **state)
 
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_HANDSHAKE_IN_THE_CLEAR_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_HANDSHAKE_IN_THE_CLEAR_CAP;
 	hash_size = spdm_get_hash_size(m_use_hash_algo);
 	hmac_size = spdm_get_hash_size(m_use_hash_algo);
@@ -1447,7 +1499,7 @@ void test_spdm_responder_finish_case13(void **state)
 		SPDM_CONNECTION_STATE_NEGOTIATED;
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_KEY_EX_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -1464,20 +1516,24 @@ void test_spdm_responder_finish_case13(void **state)
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data1,
 						&data_size1, NULL, NULL);
-	spdm_context->local_context.local_cert_chain_provision[0] = data1;
-	spdm_context->local_context.local_cert_chain_provision_size[0] =
+	spdm_context->local_context->local_cert_chain_provision[0] = data1;
+	spdm_context->local_context->local_cert_chain_provision_size[0] =
 		data_size1;
 	spdm_context->connection_info.local_used_cert_chain_buffer = data1;
 	spdm_context->connection_info.local_used_cert_chain_buffer_size =
 		data_size1;
-	spdm_context->local_context.slot_count = 1;
+	spdm_context->local_context->slot_count = 1;
 	spdm_context->transcript.message_a.buffer_size = 0;
-	spdm_context->local_context.mut_auth_requested = 0;
+	spdm_context->local_context->mut_auth_requested = 0;
 
 	session_id = 0xFFFFFFFF;
 	spdm_context->latest_session_id = session_id;
 	session_info = &spdm_context->session_info[0];
 	spdm_session_info_init(spdm_context, session_info, session_id, FALSE);
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 0
+	// message_k is empty, only seed the TH hash context with (A, Ct).
+	spdm_append_message_k(spdm_context, session_info, FALSE, NULL, 0);
+#endif
 	hash_size = spdm_get_hash_size(m_use_hash_algo);
 	set_mem(m_dummy_buffer, hash_size, (uint8)(0xFF));
 	spdm_secured_message_set_request_finished_key(
@@ -1489,7 +1545,7 @@ void test_spdm_responder_finish_case13(void **state)
 
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_HANDSHAKE_IN_THE_CLEAR_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_HANDSHAKE_IN_THE_CLEAR_CAP;
 	hash_size = spdm_get_hash_size(m_use_hash_algo);
 	hmac_size = spdm_get_hash_size(m_use_hash_algo);
@@ -1560,7 +1616,7 @@ void test_spdm_responder_finish_case14(void **state)
 		SPDM_CONNECTION_STATE_NEGOTIATED;
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_KEY_EX_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -1577,20 +1633,24 @@ void test_spdm_responder_finish_case14(void **state)
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data1,
 						&data_size1, NULL, NULL);
-	spdm_context->local_context.local_cert_chain_provision[0] = data1;
-	spdm_context->local_context.local_cert_chain_provision_size[0] =
+	spdm_context->local_context->local_cert_chain_provision[0] = data1;
+	spdm_context->local_context->local_cert_chain_provision_size[0] =
 		data_size1;
 	spdm_context->connection_info.local_used_cert_chain_buffer = data1;
 	spdm_context->connection_info.local_used_cert_chain_buffer_size =
 		data_size1;
-	spdm_context->local_context.slot_count = 1;
+	spdm_context->local_context->slot_count = 1;
 	spdm_context->transcript.message_a.buffer_size = 0;
-	spdm_context->local_context.mut_auth_requested = 0;
+	spdm_context->local_context->mut_auth_requested = 0;
 
 	session_id = 0xFFFFFFFF;
 	spdm_context->latest_session_id = session_id;
 	session_info = &spdm_context->session_info[0];
 	spdm_session_info_init(spdm_context, session_info, session_id, FALSE);
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 0
+	// message_k is empty, only seed the TH hash context with (A, Ct).
+	spdm_append_message_k(spdm_context, session_info, FALSE, NULL, 0);
+#endif
 	hash_size = spdm_get_hash_size(m_use_hash_algo);
 	set_mem(m_dummy_buffer, hash_size, (uint8)(0xFF));
 	spdm_secured_message_set_request_finished_key(
@@ -1602,7 +1662,7 @@ void test_spdm_responder_finish_case14(void **state)
 
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_HANDSHAKE_IN_THE_CLEAR_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_HANDSHAKE_IN_THE_CLEAR_CAP;
 	hash_size = spdm_get_hash_size(m_use_hash_algo);
 	hmac_size = spdm_get_hash_size(m_use_hash_algo);
@@ -1677,7 +1737,7 @@ void test_spdm_responder_finish_case15(void **state)
 		SPDM_CONNECTION_STATE_NEGOTIATED;
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_KEY_EX_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -1696,20 +1756,20 @@ void test_spdm_responder_finish_case15(void **state)
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data1,
 						&data_size1, NULL, NULL);
-	spdm_context->local_context.local_cert_chain_provision[0] = data1;
-	spdm_context->local_context.local_cert_chain_provision_size[0] =
+	spdm_context->local_context->local_cert_chain_provision[0] = data1;
+	spdm_context->local_context->local_cert_chain_provision_size[0] =
 		data_size1;
 	spdm_context->connection_info.local_used_cert_chain_buffer = data1;
 	spdm_context->connection_info.local_used_cert_chain_buffer_size =
 		data_size1;
-	spdm_context->local_context.slot_count = 1;
+	spdm_context->local_context->slot_count = 1;
 	spdm_context->transcript.message_a.buffer_size = 0;
-	spdm_context->local_context.mut_auth_requested = 1;
+	spdm_context->local_context->mut_auth_requested = 1;
 	read_requester_public_certificate_chain(m_use_hash_algo,
 						m_use_req_asym_algo, &data2,
 						&data_size2, NULL, NULL);
-	spdm_context->local_context.peer_cert_chain_provision = data2;
-	spdm_context->local_context.peer_cert_chain_provision_size =
+	spdm_context->local_context->peer_cert_chain_provision = data2;
+	spdm_context->local_context->peer_cert_chain_provision_size =
 		data_size2;
 	copy_mem(spdm_context->connection_info.peer_used_cert_chain_buffer,
 		 data2, data_size2);
@@ -1720,6 +1780,10 @@ void test_spdm_responder_finish_case15(void **state)
 	spdm_context->latest_session_id = session_id;
 	session_info = &spdm_context->session_info[0];
 	spdm_session_info_init(spdm_context, session_info, session_id, FALSE);
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 0
+	// message_k is empty, only seed the TH hash context with (A, Ct).
+	spdm_append_message_k(spdm_context, session_info, FALSE, NULL, 0);
+#endif
 	hash_size = spdm_get_hash_size(m_use_hash_algo);
 	set_mem(m_dummy_buffer, hash_size, (uint8)(0xFF));
 	spdm_secured_message_set_request_finished_key(
@@ -1732,7 +1796,7 @@ void test_spdm_responder_finish_case15(void **state)
 
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_HANDSHAKE_IN_THE_CLEAR_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_HANDSHAKE_IN_THE_CLEAR_CAP;
 	hash_size = spdm_get_hash_size(m_use_hash_algo);
 	hmac_size = spdm_get_hash_size(m_use_hash_algo);
@@ -1823,7 +1887,7 @@ void test_spdm_responder_finish_case16(void **state)
 		SPDM_CONNECTION_STATE_NEGOTIATED;
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_KEY_EX_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -1842,20 +1906,20 @@ void test_spdm_responder_finish_case16(void **state)
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data1,
 						&data_size1, NULL, NULL);
-	spdm_context->local_context.local_cert_chain_provision[0] = data1;
-	spdm_context->local_context.local_cert_chain_provision_size[0] =
+	spdm_context->local_context->local_cert_chain_provision[0] = data1;
+	spdm_context->local_context->local_cert_chain_provision_size[0] =
 		data_size1;
 	spdm_context->connection_info.local_used_cert_chain_buffer = data1;
 	spdm_context->connection_info.local_used_cert_chain_buffer_size =
 		data_size1;
-	spdm_context->local_context.slot_count = 1;
+	spdm_context->local_context->slot_count = 1;
 	spdm_context->transcript.message_a.buffer_size = 0;
-	spdm_context->local_context.mut_auth_requested = 1;
+	spdm_context->local_context->mut_auth_requested = 1;
 	read_requester_public_certificate_chain(m_use_hash_algo,
 						m_use_req_asym_algo, &data2,
 						&data_size2, NULL, NULL);
-	spdm_context->local_context.peer_cert_chain_provision = data2;
-	spdm_context->local_context.peer_cert_chain_provision_size =
+	spdm_context->local_context->peer_cert_chain_provision = data2;
+	spdm_context->local_context->peer_cert_chain_provision_size =
 		data_size2;
 	copy_mem(spdm_context->connection_info.peer_used_cert_chain_buffer,
 		 data2, data_size2);
@@ -1866,6 +1930,10 @@ void test_spdm_responder_finish_case16(void **state)
 	spdm_context->latest_session_id = session_id;
 	session_info = &spdm_context->session_info[0];
 	spdm_session_info_init(spdm_context, session_info, session_id, FALSE);
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 0
+	// message_k is empty, only seed the TH hash context with (A, Ct).
+	spdm_append_message_k(spdm_context, session_info, FALSE, NULL, 0);
+#endif
 	hash_size = spdm_get_hash_size(m_use_hash_algo);
 	set_mem(m_dummy_buffer, hash_size, (uint8)(0xFF));
 	spdm_secured_message_set_request_finished_key(
@@ -1878,7 +1946,7 @@ void test_spdm_responder_finish_case16(void **state)
 
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_HANDSHAKE_IN_THE_CLEAR_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_HANDSHAKE_IN_THE_CLEAR_CAP;
 	hash_size = spdm_get_hash_size(m_use_hash_algo);
 	hmac_size = spdm_get_hash_size(m_use_hash_algo);
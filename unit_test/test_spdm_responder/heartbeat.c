@@ -40,7 +40,7 @@ void test_spdm_responder_heartbeat_case1(void **state)
 		SPDM_CONNECTION_STATE_NEGOTIATED;
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_HBEAT_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_HBEAT_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -57,21 +57,21 @@ void test_spdm_responder_heartbeat_case1(void **state)
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data1,
 						&data_size1, NULL, NULL);
-	spdm_context->local_context.local_cert_chain_provision[0] = data1;
-	spdm_context->local_context.local_cert_chain_provision_size[0] =
+	spdm_context->local_context->local_cert_chain_provision[0] = data1;
+	spdm_context->local_context->local_cert_chain_provision_size[0] =
 		data_size1;
 	spdm_context->connection_info.local_used_cert_chain_buffer = data1;
 	spdm_context->connection_info.local_used_cert_chain_buffer_size =
 		data_size1;
-	spdm_context->local_context.slot_count = 1;
+	spdm_context->local_context->slot_count = 1;
 	spdm_context->transcript.message_a.buffer_size = 0;
-	spdm_context->local_context.mut_auth_requested = 0;
+	spdm_context->local_context->mut_auth_requested = 0;
 	zero_mem(m_local_psk_hint, 32);
 	copy_mem(&m_local_psk_hint[0], TEST_PSK_HINT_STRING,
 		 sizeof(TEST_PSK_HINT_STRING));
-	spdm_context->local_context.psk_hint_size =
+	spdm_context->local_context->psk_hint_size =
 		sizeof(TEST_PSK_HINT_STRING);
-	spdm_context->local_context.psk_hint = m_local_psk_hint;
+	spdm_context->local_context->psk_hint = m_local_psk_hint;
 
 	session_id = 0xFFFFFFFF;
 	spdm_context->latest_session_id = session_id;
@@ -116,7 +116,7 @@ void test_spdm_responder_heartbeat_case2(void **state)
 		SPDM_CONNECTION_STATE_NEGOTIATED;
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_HBEAT_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_HBEAT_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -133,21 +133,21 @@ void test_spdm_responder_heartbeat_case2(void **state)
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data1,
 						&data_size1, NULL, NULL);
-	spdm_context->local_context.local_cert_chain_provision[0] = data1;
-	spdm_context->local_context.local_cert_chain_provision_size[0] =
+	spdm_context->local_context->local_cert_chain_provision[0] = data1;
+	spdm_context->local_context->local_cert_chain_provision_size[0] =
 		data_size1;
 	spdm_context->connection_info.local_used_cert_chain_buffer = data1;
 	spdm_context->connection_info.local_used_cert_chain_buffer_size =
 		data_size1;
-	spdm_context->local_context.slot_count = 1;
+	spdm_context->local_context->slot_count = 1;
 	spdm_context->transcript.message_a.buffer_size = 0;
-	spdm_context->local_context.mut_auth_requested = 0;
+	spdm_context->local_context->mut_auth_requested = 0;
 	zero_mem(m_local_psk_hint, 32);
 	copy_mem(&m_local_psk_hint[0], TEST_PSK_HINT_STRING,
 		 sizeof(TEST_PSK_HINT_STRING));
-	spdm_context->local_context.psk_hint_size =
+	spdm_context->local_context->psk_hint_size =
 		sizeof(TEST_PSK_HINT_STRING);
-	spdm_context->local_context.psk_hint = m_local_psk_hint;
+	spdm_context->local_context->psk_hint = m_local_psk_hint;
 
 	session_id = 0xFFFFFFFF;
 	spdm_context->latest_session_id = session_id;
@@ -196,7 +196,7 @@ void test_spdm_responder_heartbeat_case3(void **state)
 		SPDM_CONNECTION_STATE_NEGOTIATED;
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_HBEAT_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_HBEAT_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -213,21 +213,21 @@ void test_spdm_responder_heartbeat_case3(void **state)
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data1,
 						&data_size1, NULL, NULL);
-	spdm_context->local_context.local_cert_chain_provision[0] = data1;
-	spdm_context->local_context.local_cert_chain_provision_size[0] =
+	spdm_context->local_context->local_cert_chain_provision[0] = data1;
+	spdm_context->local_context->local_cert_chain_provision_size[0] =
 		data_size1;
 	spdm_context->connection_info.local_used_cert_chain_buffer = data1;
 	spdm_context->connection_info.local_used_cert_chain_buffer_size =
 		data_size1;
-	spdm_context->local_context.slot_count = 1;
+	spdm_context->local_context->slot_count = 1;
 	spdm_context->transcript.message_a.buffer_size = 0;
-	spdm_context->local_context.mut_auth_requested = 0;
+	spdm_context->local_context->mut_auth_requested = 0;
 	zero_mem(m_local_psk_hint, 32);
 	copy_mem(&m_local_psk_hint[0], TEST_PSK_HINT_STRING,
 		 sizeof(TEST_PSK_HINT_STRING));
-	spdm_context->local_context.psk_hint_size =
+	spdm_context->local_context->psk_hint_size =
 		sizeof(TEST_PSK_HINT_STRING);
-	spdm_context->local_context.psk_hint = m_local_psk_hint;
+	spdm_context->local_context->psk_hint = m_local_psk_hint;
 
 	session_id = 0xFFFFFFFF;
 	spdm_context->latest_session_id = session_id;
@@ -277,7 +277,7 @@ void test_spdm_responder_heartbeat_case4(void **state)
 		SPDM_CONNECTION_STATE_NEGOTIATED;
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_HBEAT_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_HBEAT_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -294,21 +294,21 @@ void test_spdm_responder_heartbeat_case4(void **state)
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data1,
 						&data_size1, NULL, NULL);
-	spdm_context->local_context.local_cert_chain_provision[0] = data1;
-	spdm_context->local_context.local_cert_chain_provision_size[0] =
+	spdm_context->local_context->local_cert_chain_provision[0] = data1;
+	spdm_context->local_context->local_cert_chain_provision_size[0] =
 		data_size1;
 	spdm_context->connection_info.local_used_cert_chain_buffer = data1;
 	spdm_context->connection_info.local_used_cert_chain_buffer_size =
 		data_size1;
-	spdm_context->local_context.slot_count = 1;
+	spdm_context->local_context->slot_count = 1;
 	spdm_context->transcript.message_a.buffer_size = 0;
-	spdm_context->local_context.mut_auth_requested = 0;
+	spdm_context->local_context->mut_auth_requested = 0;
 	zero_mem(m_local_psk_hint, 32);
 	copy_mem(&m_local_psk_hint[0], TEST_PSK_HINT_STRING,
 		 sizeof(TEST_PSK_HINT_STRING));
-	spdm_context->local_context.psk_hint_size =
+	spdm_context->local_context->psk_hint_size =
 		sizeof(TEST_PSK_HINT_STRING);
-	spdm_context->local_context.psk_hint = m_local_psk_hint;
+	spdm_context->local_context->psk_hint = m_local_psk_hint;
 
 	session_id = 0xFFFFFFFF;
 	spdm_context->latest_session_id = session_id;
@@ -360,7 +360,7 @@ void test_spdm_responder_heartbeat_case5(void **state)
 		SPDM_CONNECTION_STATE_NEGOTIATED;
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_HBEAT_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_HBEAT_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -377,21 +377,21 @@ void test_spdm_responder_heartbeat_case5(void **state)
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data1,
 						&data_size1, NULL, NULL);
-	spdm_context->local_context.local_cert_chain_provision[0] = data1;
-	spdm_context->local_context.local_cert_chain_provision_size[0] =
+	spdm_context->local_context->local_cert_chain_provision[0] = data1;
+	spdm_context->local_context->local_cert_chain_provision_size[0] =
 		data_size1;
 	spdm_context->connection_info.local_used_cert_chain_buffer = data1;
 	spdm_context->connection_info.local_used_cert_chain_buffer_size =
 		data_size1;
-	spdm_context->local_context.slot_count = 1;
+	spdm_context->local_context->slot_count = 1;
 	spdm_context->transcript.message_a.buffer_size = 0;
-	spdm_context->local_context.mut_auth_requested = 0;
+	spdm_context->local_context->mut_auth_requested = 0;
 	zero_mem(m_local_psk_hint, 32);
 	copy_mem(&m_local_psk_hint[0], TEST_PSK_HINT_STRING,
 		 sizeof(TEST_PSK_HINT_STRING));
-	spdm_context->local_context.psk_hint_size =
+	spdm_context->local_context->psk_hint_size =
 		sizeof(TEST_PSK_HINT_STRING);
-	spdm_context->local_context.psk_hint = m_local_psk_hint;
+	spdm_context->local_context->psk_hint = m_local_psk_hint;
 
 	session_id = 0xFFFFFFFF;
 	spdm_context->latest_session_id = session_id;
@@ -447,7 +447,7 @@ void test_spdm_responder_heartbeat_case6(void **state)
 		SPDM_CONNECTION_STATE_NOT_STARTED;
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_HBEAT_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_HBEAT_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -464,21 +464,21 @@ void test_spdm_responder_heartbeat_case6(void **state)
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data1,
 						&data_size1, NULL, NULL);
-	spdm_context->local_context.local_cert_chain_provision[0] = data1;
-	spdm_context->local_context.local_cert_chain_provision_size[0] =
+	spdm_context->local_context->local_cert_chain_provision[0] = data1;
+	spdm_context->local_context->local_cert_chain_provision_size[0] =
 		data_size1;
 	spdm_context->connection_info.local_used_cert_chain_buffer = data1;
 	spdm_context->connection_info.local_used_cert_chain_buffer_size =
 		data_size1;
-	spdm_context->local_context.slot_count = 1;
+	spdm_context->local_context->slot_count = 1;
 	spdm_context->transcript.message_a.buffer_size = 0;
-	spdm_context->local_context.mut_auth_requested = 0;
+	spdm_context->local_context->mut_auth_requested = 0;
 	zero_mem(m_local_psk_hint, 32);
 	copy_mem(&m_local_psk_hint[0], TEST_PSK_HINT_STRING,
 		 sizeof(TEST_PSK_HINT_STRING));
-	spdm_context->local_context.psk_hint_size =
+	spdm_context->local_context->psk_hint_size =
 		sizeof(TEST_PSK_HINT_STRING);
-	spdm_context->local_context.psk_hint = m_local_psk_hint;
+	spdm_context->local_context->psk_hint = m_local_psk_hint;
 
 	session_id = 0xFFFFFFFF;
 	spdm_context->latest_session_id = session_id;
@@ -526,7 +526,7 @@ void test_spdm_responder_heartbeat_case7(void **state)
 		SPDM_CONNECTION_STATE_NEGOTIATED;
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_HBEAT_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_HBEAT_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -543,23 +543,24 @@ void test_spdm_responder_heartbeat_case7(void **state)
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data1,
 						&data_size1, NULL, NULL);
-	spdm_context->local_context.local_cert_chain_provision[0] = data1;
-	spdm_context->local_context.local_cert_chain_provision_size[0] =
+	spdm_context->local_context->local_cert_chain_provision[0] = data1;
+	spdm_context->local_context->local_cert_chain_provision_size[0] =
 		data_size1;
 	spdm_context->connection_info.local_used_cert_chain_buffer = data1;
 	spdm_context->connection_info.local_used_cert_chain_buffer_size =
 		data_size1;
-	spdm_context->local_context.slot_count = 1;
+	spdm_context->local_context->slot_count = 1;
 	spdm_context->transcript.message_a.buffer_size = 0;
-	spdm_context->local_context.mut_auth_requested = 0;
+	spdm_context->local_context->mut_auth_requested = 0;
 	zero_mem(m_local_psk_hint, 32);
 	copy_mem(&m_local_psk_hint[0], TEST_PSK_HINT_STRING,
 		 sizeof(TEST_PSK_HINT_STRING));
-	spdm_context->local_context.psk_hint_size =
+	spdm_context->local_context->psk_hint_size =
 		sizeof(TEST_PSK_HINT_STRING);
-	spdm_context->local_context.psk_hint = m_local_psk_hint;
+	spdm_context->local_context->psk_hint = m_local_psk_hint;
 	spdm_context->transcript.message_m.buffer_size =
 							spdm_context->transcript.message_m.max_buffer_size;
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	spdm_context->transcript.message_b.buffer_size =
 							spdm_context->transcript.message_b.max_buffer_size;
 	spdm_context->transcript.message_c.buffer_size =
@@ -568,6 +569,7 @@ void test_spdm_responder_heartbeat_case7(void **state)
 							spdm_context->transcript.message_mut_b.max_buffer_size;
 	spdm_context->transcript.message_mut_c.buffer_size =
 							spdm_context->transcript.message_mut_c.max_buffer_size;
+#endif
 
 	session_id = 0xFFFFFFFF;
 	spdm_context->latest_session_id = session_id;
@@ -590,10 +592,12 @@ void test_spdm_responder_heartbeat_case7(void **state)
 	assert_int_equal(spdm_response->header.request_response_code,
 			 SPDM_HEARTBEAT_ACK);
 	assert_int_equal(spdm_context->transcript.message_m.buffer_size, 0);
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	assert_int_equal(spdm_context->transcript.message_b.buffer_size, 0);
 	assert_int_equal(spdm_context->transcript.message_c.buffer_size, 0);
 	assert_int_equal(spdm_context->transcript.message_mut_b.buffer_size, 0);
 	assert_int_equal(spdm_context->transcript.message_mut_c.buffer_size, 0);
+#endif
 
 	free(data1);
 }
@@ -55,7 +55,7 @@ void test_spdm_responder_key_exchange_case1(void **state)
 		SPDM_CONNECTION_STATE_NEGOTIATED;
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_KEY_EX_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -72,12 +72,12 @@ void test_spdm_responder_key_exchange_case1(void **state)
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data1,
 						&data_size1, NULL, NULL);
-	spdm_context->local_context.local_cert_chain_provision[0] = data1;
-	spdm_context->local_context.local_cert_chain_provision_size[0] =
+	spdm_context->local_context->local_cert_chain_provision[0] = data1;
+	spdm_context->local_context->local_cert_chain_provision_size[0] =
 		data_size1;
-	spdm_context->local_context.slot_count = 1;
+	spdm_context->local_context->slot_count = 1;
 	spdm_context->transcript.message_a.buffer_size = 0;
-	spdm_context->local_context.mut_auth_requested = 0;
+	spdm_context->local_context->mut_auth_requested = 0;
 
 	spdm_get_random_number(SPDM_RANDOM_DATA_SIZE,
 			       m_spdm_key_exchange_request1.random_data);
@@ -134,7 +134,7 @@ void test_spdm_responder_key_exchange_case2(void **state)
 		SPDM_CONNECTION_STATE_NEGOTIATED;
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_KEY_EX_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -151,12 +151,12 @@ void test_spdm_responder_key_exchange_case2(void **state)
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data1,
 						&data_size1, NULL, NULL);
-	spdm_context->local_context.local_cert_chain_provision[0] = data1;
-	spdm_context->local_context.local_cert_chain_provision_size[0] =
+	spdm_context->local_context->local_cert_chain_provision[0] = data1;
+	spdm_context->local_context->local_cert_chain_provision_size[0] =
 		data_size1;
-	spdm_context->local_context.slot_count = 1;
+	spdm_context->local_context->slot_count = 1;
 	spdm_context->transcript.message_a.buffer_size = 0;
-	spdm_context->local_context.mut_auth_requested = 0;
+	spdm_context->local_context->mut_auth_requested = 0;
 
 	spdm_get_random_number(SPDM_RANDOM_DATA_SIZE,
 			       m_spdm_key_exchange_request2.random_data);
@@ -213,7 +213,7 @@ void test_spdm_responder_key_exchange_case3(void **state)
 		SPDM_CONNECTION_STATE_NEGOTIATED;
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_KEY_EX_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -230,12 +230,12 @@ void test_spdm_responder_key_exchange_case3(void **state)
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data1,
 						&data_size1, NULL, NULL);
-	spdm_context->local_context.local_cert_chain_provision[0] = data1;
-	spdm_context->local_context.local_cert_chain_provision_size[0] =
+	spdm_context->local_context->local_cert_chain_provision[0] = data1;
+	spdm_context->local_context->local_cert_chain_provision_size[0] =
 		data_size1;
-	spdm_context->local_context.slot_count = 1;
+	spdm_context->local_context->slot_count = 1;
 	spdm_context->transcript.message_a.buffer_size = 0;
-	spdm_context->local_context.mut_auth_requested = 0;
+	spdm_context->local_context->mut_auth_requested = 0;
 
 	spdm_get_random_number(SPDM_RANDOM_DATA_SIZE,
 			       m_spdm_key_exchange_request1.random_data);
@@ -293,7 +293,7 @@ void test_spdm_responder_key_exchange_case4(void **state)
 		SPDM_CONNECTION_STATE_NEGOTIATED;
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_KEY_EX_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -310,12 +310,12 @@ void test_spdm_responder_key_exchange_case4(void **state)
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data1,
 						&data_size1, NULL, NULL);
-	spdm_context->local_context.local_cert_chain_provision[0] = data1;
-	spdm_context->local_context.local_cert_chain_provision_size[0] =
+	spdm_context->local_context->local_cert_chain_provision[0] = data1;
+	spdm_context->local_context->local_cert_chain_provision_size[0] =
 		data_size1;
-	spdm_context->local_context.slot_count = 1;
+	spdm_context->local_context->slot_count = 1;
 	spdm_context->transcript.message_a.buffer_size = 0;
-	spdm_context->local_context.mut_auth_requested = 0;
+	spdm_context->local_context->mut_auth_requested = 0;
 
 	spdm_get_random_number(SPDM_RANDOM_DATA_SIZE,
 			       m_spdm_key_exchange_request1.random_data);
@@ -375,7 +375,7 @@ void test_spdm_responder_key_exchange_case5(void **state)
 		SPDM_CONNECTION_STATE_NEGOTIATED;
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_KEY_EX_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -392,12 +392,12 @@ void test_spdm_responder_key_exchange_case5(void **state)
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data1,
 						&data_size1, NULL, NULL);
-	spdm_context->local_context.local_cert_chain_provision[0] = data1;
-	spdm_context->local_context.local_cert_chain_provision_size[0] =
+	spdm_context->local_context->local_cert_chain_provision[0] = data1;
+	spdm_context->local_context->local_cert_chain_provision_size[0] =
 		data_size1;
-	spdm_context->local_context.slot_count = 1;
+	spdm_context->local_context->slot_count = 1;
 	spdm_context->transcript.message_a.buffer_size = 0;
-	spdm_context->local_context.mut_auth_requested = 0;
+	spdm_context->local_context->mut_auth_requested = 0;
 
 	spdm_get_random_number(SPDM_RANDOM_DATA_SIZE,
 			       m_spdm_key_exchange_request1.random_data);
@@ -461,7 +461,7 @@ void test_spdm_responder_key_exchange_case6(void **state)
 		SPDM_CONNECTION_STATE_NOT_STARTED;
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_KEY_EX_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -478,12 +478,12 @@ void test_spdm_responder_key_exchange_case6(void **state)
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data1,
 						&data_size1, NULL, NULL);
-	spdm_context->local_context.local_cert_chain_provision[0] = data1;
-	spdm_context->local_context.local_cert_chain_provision_size[0] =
+	spdm_context->local_context->local_cert_chain_provision[0] = data1;
+	spdm_context->local_context->local_cert_chain_provision_size[0] =
 		data_size1;
-	spdm_context->local_context.slot_count = 1;
+	spdm_context->local_context->slot_count = 1;
 	spdm_context->transcript.message_a.buffer_size = 0;
-	spdm_context->local_context.mut_auth_requested = 0;
+	spdm_context->local_context->mut_auth_requested = 0;
 
 	spdm_get_random_number(SPDM_RANDOM_DATA_SIZE,
 			       m_spdm_key_exchange_request1.random_data);
@@ -539,7 +539,7 @@ void test_spdm_responder_key_exchange_case7(void **state)
 		SPDM_CONNECTION_STATE_NEGOTIATED;
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_KEY_EX_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -556,14 +556,15 @@ void test_spdm_responder_key_exchange_case7(void **state)
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data1,
 						&data_size1, NULL, NULL);
-	spdm_context->local_context.local_cert_chain_provision[0] = data1;
-	spdm_context->local_context.local_cert_chain_provision_size[0] =
+	spdm_context->local_context->local_cert_chain_provision[0] = data1;
+	spdm_context->local_context->local_cert_chain_provision_size[0] =
 		data_size1;
-	spdm_context->local_context.slot_count = 1;
+	spdm_context->local_context->slot_count = 1;
 	spdm_context->transcript.message_a.buffer_size = 0;
-	spdm_context->local_context.mut_auth_requested = 0;
+	spdm_context->local_context->mut_auth_requested = 0;
 	spdm_context->transcript.message_m.buffer_size =
 							spdm_context->transcript.message_m.max_buffer_size;
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	spdm_context->transcript.message_b.buffer_size =
 							spdm_context->transcript.message_b.max_buffer_size;
 	spdm_context->transcript.message_c.buffer_size =
@@ -572,6 +573,7 @@ void test_spdm_responder_key_exchange_case7(void **state)
 							spdm_context->transcript.message_mut_b.max_buffer_size;
 	spdm_context->transcript.message_mut_c.buffer_size =
 							spdm_context->transcript.message_mut_c.max_buffer_size;
+#endif
 
 	spdm_get_random_number(SPDM_RANDOM_DATA_SIZE,
 			       m_spdm_key_exchange_request1.random_data);
@@ -603,10 +605,12 @@ void test_spdm_responder_key_exchange_case7(void **state)
 	assert_int_equal(spdm_response->header.request_response_code,
 			 SPDM_KEY_EXCHANGE_RSP);
 	assert_int_equal(spdm_context->transcript.message_m.buffer_size, 0);
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	assert_int_equal(spdm_context->transcript.message_b.buffer_size, 0);
 	assert_int_equal(spdm_context->transcript.message_c.buffer_size, 0);
 	assert_int_equal(spdm_context->transcript.message_mut_b.buffer_size, 0);
 	assert_int_equal(spdm_context->transcript.message_mut_c.buffer_size, 0);
+#endif
 
 	free(data1);
 }
@@ -0,0 +1,349 @@
+/**
+    Copyright Notice:
+    Copyright 2021 DMTF. All rights reserved.
+    License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+**/
+
+#include "spdm_unit_test.h"
+#include <spdm_responder_lib_internal.h>
+
+static spdm_get_digest_request_t m_spdm_local_context_get_digests_request = {
+	{
+		SPDM_MESSAGE_VERSION_10,
+		SPDM_GET_DIGESTS,
+	},
+};
+
+static uint8 m_local_context_certificate_chain[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+
+/**
+  Allocate and initialize an SPDM context on top of a shared local context.
+
+  @param  local_context                 A pointer to the shared SPDM local context.
+  @param  base_hash_algo                The hash algorithm negotiated by the SPDM context.
+
+  @return the SPDM context.
+**/
+static spdm_context_t *
+spdm_local_context_test_new_context(IN void *local_context,
+				    IN uint32 base_hash_algo)
+{
+	spdm_context_t *spdm_context;
+
+	spdm_context = malloc(spdm_get_context_size_with_local_context(
+		MAX_SPDM_SESSION_COUNT));
+	assert_non_null(spdm_context);
+	spdm_init_context_with_local_context(
+		spdm_context, MAX_SPDM_SESSION_COUNT, local_context);
+	spdm_register_arena_func(spdm_context, &m_spdm_unit_test_arena,
+				 spdm_unit_test_arena_allocate,
+				 spdm_unit_test_arena_free);
+	spdm_context->connection_info.algorithm.base_hash_algo =
+		base_hash_algo;
+	return spdm_context;
+}
+
+/**
+  Send GET_DIGESTS to an SPDM context and check the digest of slot 0.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  cert_chain                    The certificate chain provisioned in slot 0.
+  @param  cert_chain_size               size in bytes of the certificate chain.
+**/
+static void spdm_local_context_test_check_digest(IN spdm_context_t *spdm_context,
+						 IN void *cert_chain,
+						 IN uintn cert_chain_size)
+{
+	return_status status;
+	uintn response_size;
+	uint8 response[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+	spdm_digest_response_t *spdm_response;
+	uint8 hash[MAX_HASH_SIZE];
+	uint32 base_hash_algo;
+
+	base_hash_algo = spdm_context->connection_info.algorithm.base_hash_algo;
+	spdm_hash_all(base_hash_algo, cert_chain, cert_chain_size, hash);
+
+	spdm_context->connection_info.connection_state =
+		SPDM_CONNECTION_STATE_NEGOTIATED;
+	spdm_reset_message_b(spdm_context);
+	response_size = sizeof(response);
+	status = spdm_get_response_digests(
+		spdm_context, sizeof(m_spdm_local_context_get_digests_request),
+		&m_spdm_local_context_get_digests_request, &response_size,
+		response);
+	assert_int_equal(status, RETURN_SUCCESS);
+	spdm_response = (void *)response;
+	assert_int_equal(spdm_response->header.request_response_code,
+			 SPDM_DIGESTS);
+	assert_int_equal(response_size,
+			 sizeof(spdm_digest_response_t) +
+				 spdm_get_hash_size(base_hash_algo));
+	assert_memory_equal(spdm_response + 1, hash,
+			    spdm_get_hash_size(base_hash_algo));
+}
+
+/**
+  Test 1: attach two SPDM contexts to one local context, then deinitialize them in both orders
+  Expected Behavior: each attach takes a reference and each deinit drops one, and the remaining
+  SPDM context keeps working with the shared local context.
+**/
+void test_spdm_responder_local_context_case1(void **state)
+{
+	void *local_context;
+	spdm_context_t *spdm_context[2];
+	spdm_data_parameter_t parameter;
+	uint8 slot_count;
+	uintn order;
+	uintn first;
+
+	local_context = malloc(spdm_get_local_context_size());
+	assert_non_null(local_context);
+	spdm_init_local_context(local_context);
+	assert_int_equal(spdm_get_local_context_ref_count(local_context), 0);
+	set_mem(m_local_context_certificate_chain,
+		sizeof(m_local_context_certificate_chain), (uint8)(0xFF));
+
+	for (order = 0; order < 2; order++) {
+		spdm_context[0] =
+			spdm_local_context_test_new_context(local_context,
+							    m_use_hash_algo);
+		spdm_context[1] =
+			spdm_local_context_test_new_context(local_context,
+							    m_use_hash_algo);
+		assert_int_equal(spdm_get_local_context_ref_count(local_context),
+				 2);
+		assert_ptr_equal(spdm_context[0]->local_context, local_context);
+		assert_ptr_equal(spdm_context[1]->local_context, local_context);
+
+		//
+		// Local data set through one SPDM context applies to both.
+		//
+		zero_mem(&parameter, sizeof(parameter));
+		parameter.location = SPDM_DATA_LOCATION_LOCAL;
+		spdm_context[0]->local_context->capability.flags |=
+			SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
+		slot_count = 1;
+		assert_int_equal(spdm_set_data(spdm_context[0],
+					       SPDM_DATA_LOCAL_SLOT_COUNT,
+					       &parameter, &slot_count,
+					       sizeof(slot_count)),
+				 RETURN_SUCCESS);
+		assert_int_equal(
+			spdm_set_data(spdm_context[1],
+				      SPDM_DATA_LOCAL_PUBLIC_CERT_CHAIN,
+				      &parameter,
+				      m_local_context_certificate_chain,
+				      sizeof(m_local_context_certificate_chain)),
+			RETURN_SUCCESS);
+		spdm_local_context_test_check_digest(
+			spdm_context[0], m_local_context_certificate_chain,
+			sizeof(m_local_context_certificate_chain));
+		spdm_local_context_test_check_digest(
+			spdm_context[1], m_local_context_certificate_chain,
+			sizeof(m_local_context_certificate_chain));
+
+		//
+		// Release the first context in the first round and the second one
+		// in the second round. The other one still answers.
+		//
+		first = (order == 0) ? 0 : 1;
+		spdm_deinit_context(spdm_context[first]);
+		assert_null(spdm_context[first]->local_context);
+		assert_int_equal(spdm_get_local_context_ref_count(local_context),
+				 1);
+		spdm_local_context_test_check_digest(
+			spdm_context[1 - first],
+			m_local_context_certificate_chain,
+			sizeof(m_local_context_certificate_chain));
+		spdm_deinit_context(spdm_context[1 - first]);
+		assert_int_equal(spdm_get_local_context_ref_count(local_context),
+				 0);
+
+		free(spdm_context[0]);
+		free(spdm_context[1]);
+	}
+
+	free(local_context);
+}
+
+/**
+  Test 2: two SPDM contexts sharing a local context negotiate different hash algorithms
+  Expected Behavior: each context reports the certificate chain digest in its own hash algorithm,
+  and provisioning the chain again through one context drops the cached hash of both.
+**/
+void test_spdm_responder_local_context_case2(void **state)
+{
+	void *local_context;
+	spdm_context_t *spdm_context[2];
+	spdm_data_parameter_t parameter;
+	uint8 slot_count;
+
+	local_context = malloc(spdm_get_local_context_size());
+	assert_non_null(local_context);
+	spdm_init_local_context(local_context);
+	spdm_context[0] = spdm_local_context_test_new_context(
+		local_context, SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_256);
+	spdm_context[1] = spdm_local_context_test_new_context(
+		local_context, SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_384);
+
+	zero_mem(&parameter, sizeof(parameter));
+	parameter.location = SPDM_DATA_LOCATION_LOCAL;
+	spdm_context[0]->local_context->capability.flags |=
+		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
+	slot_count = 1;
+	assert_int_equal(spdm_set_data(spdm_context[0],
+				       SPDM_DATA_LOCAL_SLOT_COUNT, &parameter,
+				       &slot_count, sizeof(slot_count)),
+			 RETURN_SUCCESS);
+	set_mem(m_local_context_certificate_chain,
+		sizeof(m_local_context_certificate_chain), (uint8)(0xFF));
+	assert_int_equal(
+		spdm_set_data(spdm_context[0], SPDM_DATA_LOCAL_PUBLIC_CERT_CHAIN,
+			      &parameter, m_local_context_certificate_chain,
+			      sizeof(m_local_context_certificate_chain)),
+		RETURN_SUCCESS);
+
+	//
+	// Each context fills its own cache, in its own hash algorithm.
+	//
+	spdm_local_context_test_check_digest(
+		spdm_context[0], m_local_context_certificate_chain,
+		sizeof(m_local_context_certificate_chain));
+	spdm_local_context_test_check_digest(
+		spdm_context[1], m_local_context_certificate_chain,
+		sizeof(m_local_context_certificate_chain));
+	assert_int_equal(
+		spdm_context[0]->local_cert_chain_hash_cache[0].base_hash_algo,
+		SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_256);
+	assert_int_equal(
+		spdm_context[1]->local_cert_chain_hash_cache[0].base_hash_algo,
+		SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_384);
+
+	//
+	// Provision new content through the second context. The first context
+	// drops its cached hash as well.
+	//
+	set_mem(m_local_context_certificate_chain,
+		sizeof(m_local_context_certificate_chain), (uint8)(0xEE));
+	assert_int_equal(
+		spdm_set_data(spdm_context[1], SPDM_DATA_LOCAL_PUBLIC_CERT_CHAIN,
+			      &parameter, m_local_context_certificate_chain,
+			      sizeof(m_local_context_certificate_chain)),
+		RETURN_SUCCESS);
+	spdm_local_context_test_check_digest(
+		spdm_context[0], m_local_context_certificate_chain,
+		sizeof(m_local_context_certificate_chain));
+	spdm_local_context_test_check_digest(
+		spdm_context[1], m_local_context_certificate_chain,
+		sizeof(m_local_context_certificate_chain));
+
+	spdm_deinit_context(spdm_context[1]);
+	spdm_deinit_context(spdm_context[0]);
+	assert_int_equal(spdm_get_local_context_ref_count(local_context), 0);
+	free(spdm_context[0]);
+	free(spdm_context[1]);
+	free(local_context);
+}
+
+/**
+  Test 3: the peer certificate chain is provisioned again through another SPDM context
+  Expected Behavior: an SPDM context sharing the local context drops its cached peer
+  certificate chain hash and peer public key, even though the new chain is at the same address.
+**/
+void test_spdm_responder_local_context_case3(void **state)
+{
+	void *local_context;
+	spdm_context_t *spdm_context[2];
+	spdm_data_parameter_t parameter;
+	void *data;
+	uintn data_size;
+	uint8 hash[MAX_HASH_SIZE];
+	uint8 expected_hash[MAX_HASH_SIZE];
+	uintn hash_size;
+	void *public_key;
+	uint32 generation;
+
+	local_context = malloc(spdm_get_local_context_size());
+	assert_non_null(local_context);
+	spdm_init_local_context(local_context);
+	spdm_context[0] = spdm_local_context_test_new_context(
+		local_context, m_use_hash_algo);
+	spdm_context[1] = spdm_local_context_test_new_context(
+		local_context, m_use_hash_algo);
+	spdm_context[0]->connection_info.algorithm.base_asym_algo =
+		m_use_asym_algo;
+	hash_size = spdm_get_hash_size(m_use_hash_algo);
+
+	read_responder_public_certificate_chain(m_use_hash_algo,
+						m_use_asym_algo, &data,
+						&data_size, NULL, NULL);
+	assert_true(data_size <= sizeof(m_local_context_certificate_chain));
+	copy_mem(m_local_context_certificate_chain, data, data_size);
+	zero_mem(&parameter, sizeof(parameter));
+	parameter.location = SPDM_DATA_LOCATION_LOCAL;
+	assert_int_equal(
+		spdm_set_data(spdm_context[1], SPDM_DATA_PEER_PUBLIC_CERT_CHAIN,
+			      &parameter, m_local_context_certificate_chain,
+			      data_size),
+		RETURN_SUCCESS);
+
+	//
+	// The first context caches the hash and the public key of the provisioned chain.
+	//
+	spdm_calculate_cert_chain_hash(spdm_context[0],
+				       m_local_context_certificate_chain,
+				       data_size, hash);
+	spdm_hash_all(m_use_hash_algo, m_local_context_certificate_chain,
+		      data_size, expected_hash);
+	assert_memory_equal(hash, expected_hash, hash_size);
+	assert_true(spdm_get_peer_public_key(spdm_context[0], FALSE,
+					     &public_key));
+	generation = spdm_context[0]
+			     ->connection_info.peer_public_key_cache.generation;
+
+	//
+	// Provision different content at the same address through the second context.
+	//
+	m_local_context_certificate_chain[data_size - 1] ^= 0x01;
+	assert_int_equal(
+		spdm_set_data(spdm_context[1], SPDM_DATA_PEER_PUBLIC_CERT_CHAIN,
+			      &parameter, m_local_context_certificate_chain,
+			      data_size),
+		RETURN_SUCCESS);
+	spdm_calculate_cert_chain_hash(spdm_context[0],
+				       m_local_context_certificate_chain,
+				       data_size, hash);
+	spdm_hash_all(m_use_hash_algo, m_local_context_certificate_chain,
+		      data_size, expected_hash);
+	assert_memory_equal(hash, expected_hash, hash_size);
+
+	m_local_context_certificate_chain[data_size - 1] ^= 0x01;
+	assert_true(spdm_get_peer_public_key(spdm_context[0], FALSE,
+					     &public_key));
+	assert_int_not_equal(
+		spdm_context[0]->connection_info.peer_public_key_cache.generation,
+		generation);
+
+	spdm_deinit_context(spdm_context[1]);
+	spdm_deinit_context(spdm_context[0]);
+	free(spdm_context[0]);
+	free(spdm_context[1]);
+	free(local_context);
+	free(data);
+}
+
+int spdm_responder_local_context_test_main(void)
+{
+	const struct CMUnitTest spdm_responder_local_context_tests[] = {
+		// Reference count with both deinit orders
+		cmocka_unit_test(test_spdm_responder_local_context_case1),
+		// Per context certificate chain hash cache
+		cmocka_unit_test(test_spdm_responder_local_context_case2),
+		// Per context peer certificate chain caches
+		cmocka_unit_test(test_spdm_responder_local_context_case3),
+	};
+
+	return cmocka_run_group_tests(spdm_responder_local_context_tests, NULL,
+				      NULL);
+}
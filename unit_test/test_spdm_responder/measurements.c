@@ -112,7 +112,7 @@ void test_spdm_responder_measurements_case1(void **state)
 	spdm_test_context->case_id = 0x1;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AUTHENTICATED;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MEAS_CAP_SIG;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -123,8 +123,8 @@ void test_spdm_responder_measurements_case1(void **state)
 	spdm_context->connection_info.algorithm.measurement_hash_algo =
 		m_use_measurement_hash_algo;
 	spdm_context->transcript.message_m.buffer_size = 0;
-	spdm_context->local_context.opaque_measurement_rsp_size = 0;
-	spdm_context->local_context.opaque_measurement_rsp = NULL;
+	spdm_context->local_context->opaque_measurement_rsp_size = 0;
+	spdm_context->local_context->opaque_measurement_rsp = NULL;
 
 	response_size = sizeof(response);
 	spdm_get_random_number(SPDM_NONCE_SIZE,
@@ -165,7 +165,7 @@ void test_spdm_responder_measurements_case2(void **state)
 	spdm_test_context->case_id = 0x2;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AUTHENTICATED;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MEAS_CAP_SIG;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -176,8 +176,8 @@ void test_spdm_responder_measurements_case2(void **state)
 	spdm_context->connection_info.algorithm.measurement_hash_algo =
 		m_use_measurement_hash_algo;
 	spdm_context->transcript.message_m.buffer_size = 0;
-	spdm_context->local_context.opaque_measurement_rsp_size = 0;
-	spdm_context->local_context.opaque_measurement_rsp = NULL;
+	spdm_context->local_context->opaque_measurement_rsp_size = 0;
+	spdm_context->local_context->opaque_measurement_rsp = NULL;
 
 	response_size = sizeof(response);
 	spdm_get_random_number(SPDM_NONCE_SIZE,
@@ -215,7 +215,7 @@ void test_spdm_responder_measurements_case3(void **state)
 	spdm_context->response_state = SPDM_RESPONSE_STATE_BUSY;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AUTHENTICATED;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MEAS_CAP_SIG;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -226,8 +226,8 @@ void test_spdm_responder_measurements_case3(void **state)
 	spdm_context->connection_info.algorithm.measurement_hash_algo =
 		m_use_measurement_hash_algo;
 	spdm_context->transcript.message_m.buffer_size = 0;
-	spdm_context->local_context.opaque_measurement_rsp_size = 0;
-	spdm_context->local_context.opaque_measurement_rsp = NULL;
+	spdm_context->local_context->opaque_measurement_rsp_size = 0;
+	spdm_context->local_context->opaque_measurement_rsp = NULL;
 
 	response_size = sizeof(response);
 	spdm_get_random_number(SPDM_NONCE_SIZE,
@@ -266,7 +266,7 @@ void test_spdm_responder_measurements_case4(void **state)
 	spdm_context->response_state = SPDM_RESPONSE_STATE_NEED_RESYNC;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AUTHENTICATED;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MEAS_CAP_SIG;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -277,8 +277,8 @@ void test_spdm_responder_measurements_case4(void **state)
 	spdm_context->connection_info.algorithm.measurement_hash_algo =
 		m_use_measurement_hash_algo;
 	spdm_context->transcript.message_m.buffer_size = 0;
-	spdm_context->local_context.opaque_measurement_rsp_size = 0;
-	spdm_context->local_context.opaque_measurement_rsp = NULL;
+	spdm_context->local_context->opaque_measurement_rsp_size = 0;
+	spdm_context->local_context->opaque_measurement_rsp = NULL;
 
 	response_size = sizeof(response);
 	spdm_get_random_number(SPDM_NONCE_SIZE,
@@ -319,7 +319,7 @@ void test_spdm_responder_measurements_case5(void **state)
 	spdm_context->response_state = SPDM_RESPONSE_STATE_NOT_READY;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AUTHENTICATED;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MEAS_CAP_SIG;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -330,8 +330,8 @@ void test_spdm_responder_measurements_case5(void **state)
 	spdm_context->connection_info.algorithm.measurement_hash_algo =
 		m_use_measurement_hash_algo;
 	spdm_context->transcript.message_m.buffer_size = 0;
-	spdm_context->local_context.opaque_measurement_rsp_size = 0;
-	spdm_context->local_context.opaque_measurement_rsp = NULL;
+	spdm_context->local_context->opaque_measurement_rsp_size = 0;
+	spdm_context->local_context->opaque_measurement_rsp = NULL;
 
 	response_size = sizeof(response);
 	spdm_get_random_number(SPDM_NONCE_SIZE,
@@ -377,7 +377,7 @@ void test_spdm_responder_measurements_case6(void **state)
 	spdm_context->response_state = SPDM_RESPONSE_STATE_NORMAL;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_NOT_STARTED;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MEAS_CAP_SIG;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -388,8 +388,8 @@ void test_spdm_responder_measurements_case6(void **state)
 	spdm_context->connection_info.algorithm.measurement_hash_algo =
 		m_use_measurement_hash_algo;
 	spdm_context->transcript.message_m.buffer_size = 0;
-	spdm_context->local_context.opaque_measurement_rsp_size = 0;
-	spdm_context->local_context.opaque_measurement_rsp = NULL;
+	spdm_context->local_context->opaque_measurement_rsp_size = 0;
+	spdm_context->local_context->opaque_measurement_rsp = NULL;
 
 	response_size = sizeof(response);
 	spdm_get_random_number(SPDM_NONCE_SIZE,
@@ -427,7 +427,7 @@ void test_spdm_responder_measurements_case7(void **state)
 	spdm_test_context->case_id = 0x7;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AUTHENTICATED;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MEAS_CAP_SIG;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -438,8 +438,8 @@ void test_spdm_responder_measurements_case7(void **state)
 	spdm_context->connection_info.algorithm.measurement_hash_algo =
 		m_use_measurement_hash_algo;
 	spdm_context->transcript.message_m.buffer_size = 0;
-	spdm_context->local_context.opaque_measurement_rsp_size = 0;
-	spdm_context->local_context.opaque_measurement_rsp = NULL;
+	spdm_context->local_context->opaque_measurement_rsp_size = 0;
+	spdm_context->local_context->opaque_measurement_rsp = NULL;
 	measurment_sig_size = SPDM_NONCE_SIZE + sizeof(uint16) + 0 +
 			      spdm_get_asym_signature_size(m_use_asym_algo);
 
@@ -479,7 +479,7 @@ void test_spdm_responder_measurements_case8(void **state)
 	spdm_test_context->case_id = 0x8;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AUTHENTICATED;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MEAS_CAP_SIG;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -490,8 +490,8 @@ void test_spdm_responder_measurements_case8(void **state)
 	spdm_context->connection_info.algorithm.measurement_hash_algo =
 		m_use_measurement_hash_algo;
 	spdm_context->transcript.message_m.buffer_size = 0;
-	spdm_context->local_context.opaque_measurement_rsp_size = 0;
-	spdm_context->local_context.opaque_measurement_rsp = NULL;
+	spdm_context->local_context->opaque_measurement_rsp_size = 0;
+	spdm_context->local_context->opaque_measurement_rsp = NULL;
 	measurment_sig_size = SPDM_NONCE_SIZE + sizeof(uint16) + 0 +
 			      spdm_get_asym_signature_size(m_use_asym_algo);
 	response_size = sizeof(response);
@@ -531,7 +531,7 @@ void test_spdm_responder_measurements_case9(void **state)
 	spdm_test_context->case_id = 0x9;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AUTHENTICATED;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MEAS_CAP_SIG;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -542,8 +542,8 @@ void test_spdm_responder_measurements_case9(void **state)
 	spdm_context->connection_info.algorithm.measurement_hash_algo =
 		m_use_measurement_hash_algo;
 	spdm_context->transcript.message_m.buffer_size = 0;
-	spdm_context->local_context.opaque_measurement_rsp_size = 0;
-	spdm_context->local_context.opaque_measurement_rsp = NULL;
+	spdm_context->local_context->opaque_measurement_rsp_size = 0;
+	spdm_context->local_context->opaque_measurement_rsp = NULL;
 
 	response_size = sizeof(response);
 	spdm_get_random_number(SPDM_NONCE_SIZE,
@@ -580,7 +580,7 @@ void test_spdm_responder_measurements_case10(void **state)
 	spdm_test_context->case_id = 0xA;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AUTHENTICATED;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MEAS_CAP_SIG;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -591,8 +591,8 @@ void test_spdm_responder_measurements_case10(void **state)
 	spdm_context->connection_info.algorithm.measurement_hash_algo =
 		m_use_measurement_hash_algo;
 	spdm_context->transcript.message_m.buffer_size = 0;
-	spdm_context->local_context.opaque_measurement_rsp_size = 0;
-	spdm_context->local_context.opaque_measurement_rsp = NULL;
+	spdm_context->local_context->opaque_measurement_rsp_size = 0;
+	spdm_context->local_context->opaque_measurement_rsp = NULL;
 
 	response_size = sizeof(response);
 	spdm_get_random_number(SPDM_NONCE_SIZE,
@@ -638,7 +638,7 @@ void test_spdm_responder_measurements_case11(void **state)
 	spdm_test_context->case_id = 0xB;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AUTHENTICATED;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MEAS_CAP_SIG;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -649,8 +649,8 @@ void test_spdm_responder_measurements_case11(void **state)
 	spdm_context->connection_info.algorithm.measurement_hash_algo =
 		m_use_measurement_hash_algo;
 	spdm_context->transcript.message_m.buffer_size = 0;
-	spdm_context->local_context.opaque_measurement_rsp_size = 0;
-	spdm_context->local_context.opaque_measurement_rsp = NULL;
+	spdm_context->local_context->opaque_measurement_rsp_size = 0;
+	spdm_context->local_context->opaque_measurement_rsp = NULL;
 	measurment_sig_size = SPDM_NONCE_SIZE + sizeof(uint16) + 0 +
 			      spdm_get_asym_signature_size(m_use_asym_algo);
 
@@ -696,7 +696,7 @@ void test_spdm_responder_measurements_case12(void **state)
 	spdm_test_context->case_id = 0xC;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AUTHENTICATED;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MEAS_CAP_SIG;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -707,8 +707,8 @@ void test_spdm_responder_measurements_case12(void **state)
 	spdm_context->connection_info.algorithm.measurement_hash_algo =
 		m_use_measurement_hash_algo;
 	spdm_context->transcript.message_m.buffer_size = 0;
-	spdm_context->local_context.opaque_measurement_rsp_size = 0;
-	spdm_context->local_context.opaque_measurement_rsp = NULL;
+	spdm_context->local_context->opaque_measurement_rsp_size = 0;
+	spdm_context->local_context->opaque_measurement_rsp = NULL;
 
 	response_size = sizeof(response);
 	spdm_get_random_number(SPDM_NONCE_SIZE,
@@ -773,8 +773,8 @@ void test_spdm_responder_measurements_case13(void **state)
 	spdm_test_context->case_id = 0xD;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AUTHENTICATED;
-	spdm_context->local_context.capability.flags = 0;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags = 0;
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MEAS_CAP_NO_SIG;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -786,8 +786,8 @@ void test_spdm_responder_measurements_case13(void **state)
 	spdm_context->connection_info.version.spdm_version[0].major_version = 1;
 	spdm_context->connection_info.version.spdm_version[0].minor_version = 1;
 	spdm_context->transcript.message_m.buffer_size = 0;
-	spdm_context->local_context.opaque_measurement_rsp_size = 0;
-	spdm_context->local_context.opaque_measurement_rsp = NULL;
+	spdm_context->local_context->opaque_measurement_rsp_size = 0;
+	spdm_context->local_context->opaque_measurement_rsp = NULL;
 
 	spdm_get_random_number(SPDM_NONCE_SIZE,
 			       m_spdm_get_measurements_request9.nonce);
@@ -841,8 +841,8 @@ void test_spdm_responder_measurements_case14(void **state)
 	spdm_test_context->case_id = 0xE;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AUTHENTICATED;
-	spdm_context->local_context.capability.flags = 0;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags = 0;
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MEAS_CAP_SIG;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -854,8 +854,8 @@ void test_spdm_responder_measurements_case14(void **state)
 	spdm_context->connection_info.version.spdm_version[0].major_version = 1;
 	spdm_context->connection_info.version.spdm_version[0].minor_version = 1;
 	spdm_context->transcript.message_m.buffer_size = 0;
-	spdm_context->local_context.opaque_measurement_rsp_size = 0;
-	spdm_context->local_context.opaque_measurement_rsp = NULL;
+	spdm_context->local_context->opaque_measurement_rsp_size = 0;
+	spdm_context->local_context->opaque_measurement_rsp = NULL;
 
 	spdm_get_random_number(SPDM_NONCE_SIZE,
 			       m_spdm_get_measurements_request10.nonce);
@@ -898,8 +898,8 @@ void test_spdm_responder_measurements_case15(void **state)
 	spdm_test_context->case_id = 0xF;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AUTHENTICATED;
-	spdm_context->local_context.capability.flags = 0;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags = 0;
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MEAS_CAP_NO_SIG;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -911,8 +911,8 @@ void test_spdm_responder_measurements_case15(void **state)
 	spdm_context->connection_info.version.spdm_version[0].major_version = 1;
 	spdm_context->connection_info.version.spdm_version[0].minor_version = 1;
 	spdm_context->transcript.message_m.buffer_size = 0;
-	spdm_context->local_context.opaque_measurement_rsp_size = 0;
-	spdm_context->local_context.opaque_measurement_rsp = NULL;
+	spdm_context->local_context->opaque_measurement_rsp_size = 0;
+	spdm_context->local_context->opaque_measurement_rsp = NULL;
 	// measurment_sig_size = SPDM_NONCE_SIZE + sizeof(uint16) + 0 + spdm_get_asym_signature_size (m_use_asym_algo);
 
 	response_size = sizeof(response);
@@ -951,8 +951,8 @@ void test_spdm_responder_measurements_case16(void **state)
 	spdm_test_context->case_id = 0x10;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AUTHENTICATED;
-	spdm_context->local_context.capability.flags = 0;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags = 0;
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MEAS_CAP_NO_SIG;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -964,8 +964,8 @@ void test_spdm_responder_measurements_case16(void **state)
 	spdm_context->connection_info.version.spdm_version[0].major_version = 1;
 	spdm_context->connection_info.version.spdm_version[0].minor_version = 1;
 	spdm_context->transcript.message_m.buffer_size = 0;
-	spdm_context->local_context.opaque_measurement_rsp_size = 0;
-	spdm_context->local_context.opaque_measurement_rsp = NULL;
+	spdm_context->local_context->opaque_measurement_rsp_size = 0;
+	spdm_context->local_context->opaque_measurement_rsp = NULL;
 	// measurment_sig_size = SPDM_NONCE_SIZE + sizeof(uint16) + 0 + spdm_get_asym_signature_size (m_use_asym_algo);
 
 	response_size = sizeof(response);
@@ -1002,7 +1002,7 @@ void test_spdm_responder_measurements_case17(void **state)
 	spdm_test_context->case_id = 0x11;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AUTHENTICATED;
-	spdm_context->local_context.capability.flags = 0;
+	spdm_context->local_context->capability.flags = 0;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
 	spdm_context->connection_info.algorithm.base_asym_algo =
@@ -1013,8 +1013,8 @@ void test_spdm_responder_measurements_case17(void **state)
 	spdm_context->connection_info.version.spdm_version[0].major_version = 1;
 	spdm_context->connection_info.version.spdm_version[0].minor_version = 1;
 	spdm_context->transcript.message_m.buffer_size = 0;
-	spdm_context->local_context.opaque_measurement_rsp_size = 0;
-	spdm_context->local_context.opaque_measurement_rsp = NULL;
+	spdm_context->local_context->opaque_measurement_rsp_size = 0;
+	spdm_context->local_context->opaque_measurement_rsp = NULL;
 	;
 	// measurment_sig_size = SPDM_NONCE_SIZE + sizeof(uint16) + 0 + spdm_get_asym_signature_size (m_use_asym_algo);
 
@@ -1058,7 +1058,7 @@ void test_spdm_responder_measurements_case18(void **state)
 	spdm_test_context->case_id = 0x12;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AUTHENTICATED;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MEAS_CAP_SIG;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -1070,18 +1070,18 @@ void test_spdm_responder_measurements_case18(void **state)
 	spdm_context->connection_info.version.spdm_version[0].major_version = 1;
 	spdm_context->connection_info.version.spdm_version[0].minor_version = 1;
 	spdm_context->transcript.message_m.buffer_size = 0;
-	spdm_context->local_context.opaque_measurement_rsp_size = 0;
-	spdm_context->local_context.opaque_measurement_rsp = NULL;
+	spdm_context->local_context->opaque_measurement_rsp_size = 0;
+	spdm_context->local_context->opaque_measurement_rsp = NULL;
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data,
 						&data_size, NULL, NULL);
 	measurment_sig_size = SPDM_NONCE_SIZE + sizeof(uint16) + 0 +
 			      spdm_get_asym_signature_size(m_use_asym_algo);
-	spdm_context->local_context.slot_count = MAX_SPDM_SLOT_COUNT;
-	for (int i = 1; i < spdm_context->local_context.slot_count; i++) {
-		spdm_context->local_context.local_cert_chain_provision_size[i] =
+	spdm_context->local_context->slot_count = MAX_SPDM_SLOT_COUNT;
+	for (int i = 1; i < spdm_context->local_context->slot_count; i++) {
+		spdm_context->local_context->local_cert_chain_provision_size[i] =
 			data_size;
-		spdm_context->local_context.local_cert_chain_provision[i] =
+		spdm_context->local_context->local_cert_chain_provision[i] =
 			data;
 	}
 
@@ -1105,7 +1105,7 @@ void test_spdm_responder_measurements_case18(void **state)
 	assert_int_equal(m_spdm_get_measurements_request11.SlotIDParam,
 			 spdm_response->header.param2);
 
-	spdm_context->local_context.slot_count = 1;
+	spdm_context->local_context->slot_count = 1;
 	free(data);
 }
 
@@ -1128,7 +1128,7 @@ void test_spdm_responder_measurements_case19(void **state)
 	spdm_test_context->case_id = 0x13;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AUTHENTICATED;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MEAS_CAP_SIG;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -1140,8 +1140,8 @@ void test_spdm_responder_measurements_case19(void **state)
 	spdm_context->connection_info.version.spdm_version[0].major_version = 1;
 	spdm_context->connection_info.version.spdm_version[0].minor_version = 1;
 	spdm_context->transcript.message_m.buffer_size = 0;
-	spdm_context->local_context.opaque_measurement_rsp_size = 0;
-	spdm_context->local_context.opaque_measurement_rsp = NULL;
+	spdm_context->local_context->opaque_measurement_rsp_size = 0;
+	spdm_context->local_context->opaque_measurement_rsp = NULL;
 	// measurment_sig_size = SPDM_NONCE_SIZE + sizeof(uint16) + 0 + spdm_get_asym_signature_size (m_use_asym_algo);
 
 	response_size = sizeof(response);
@@ -1180,7 +1180,7 @@ void test_spdm_responder_measurements_case20(void **state)
 	spdm_test_context->case_id = 0x14;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AUTHENTICATED;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MEAS_CAP_SIG;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -1192,8 +1192,8 @@ void test_spdm_responder_measurements_case20(void **state)
 	spdm_context->connection_info.version.spdm_version[0].major_version = 1;
 	spdm_context->connection_info.version.spdm_version[0].minor_version = 1;
 	spdm_context->transcript.message_m.buffer_size = 0;
-	spdm_context->local_context.opaque_measurement_rsp_size = 0;
-	spdm_context->local_context.opaque_measurement_rsp = NULL;
+	spdm_context->local_context->opaque_measurement_rsp_size = 0;
+	spdm_context->local_context->opaque_measurement_rsp = NULL;
 	// measurment_sig_size = SPDM_NONCE_SIZE + sizeof(uint16) + 0 + spdm_get_asym_signature_size (m_use_asym_algo);
 
 	response_size = sizeof(response);
@@ -1231,7 +1231,7 @@ void test_spdm_responder_measurements_case21(void **state)
 	spdm_test_context->case_id = 0x15;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AUTHENTICATED;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MEAS_CAP_SIG;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -1243,8 +1243,8 @@ void test_spdm_responder_measurements_case21(void **state)
 	spdm_context->connection_info.version.spdm_version[0].major_version = 1;
 	spdm_context->connection_info.version.spdm_version[0].minor_version = 1;
 	spdm_context->transcript.message_m.buffer_size = 0;
-	spdm_context->local_context.opaque_measurement_rsp_size = 0;
-	spdm_context->local_context.opaque_measurement_rsp = NULL;
+	spdm_context->local_context->opaque_measurement_rsp_size = 0;
+	spdm_context->local_context->opaque_measurement_rsp = NULL;
 
 	response_size = sizeof(response);
 	spdm_get_random_number(SPDM_NONCE_SIZE,
@@ -1284,7 +1284,7 @@ void test_spdm_responder_measurements_case22(void **state)
 	spdm_test_context->case_id = 0x16;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AUTHENTICATED;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MEAS_CAP_SIG;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -1296,8 +1296,8 @@ void test_spdm_responder_measurements_case22(void **state)
 	spdm_context->connection_info.version.spdm_version[0].major_version = 1;
 	spdm_context->connection_info.version.spdm_version[0].minor_version = 1;
 	spdm_context->transcript.message_m.buffer_size = 0;
-	spdm_context->local_context.opaque_measurement_rsp_size = 0;
-	spdm_context->local_context.opaque_measurement_rsp = NULL;
+	spdm_context->local_context->opaque_measurement_rsp_size = 0;
+	spdm_context->local_context->opaque_measurement_rsp = NULL;
 
 	for (NumberOfMessages = 1; NumberOfMessages <= TOTAL_MESSAGES;
 	     NumberOfMessages++) {
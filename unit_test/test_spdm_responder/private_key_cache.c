@@ -0,0 +1,196 @@
+/**
+    Copyright Notice:
+    Copyright 2021 DMTF. All rights reserved.
+    License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+**/
+
+#include "spdm_unit_test.h"
+#include <spdm_device_secret_lib_internal.h>
+
+/**
+  Acquire and release a responder private key.
+
+  @param  base_asym_algo                 Indicates the signing algorithm.
+
+  @return the private key context, which is no longer in use.
+**/
+static void *spdm_private_key_cache_test_use(IN uint32 base_asym_algo)
+{
+	void *context;
+
+	context = spdm_acquire_private_key(FALSE, base_asym_algo);
+	assert_non_null(context);
+	spdm_release_private_key(FALSE, base_asym_algo, context);
+	return context;
+}
+
+/**
+  Test 1: get the responder private key twice
+  Expected Behavior: the key is parsed once, the second call returns the cached context,
+  and spdm_flush_private_key_cache frees it.
+**/
+void test_spdm_responder_private_key_cache_case1(void **state)
+{
+	void *context1;
+	void *context2;
+
+	spdm_flush_private_key_cache();
+	assert_false(spdm_is_private_key_cached(
+		FALSE, SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_ECDSA_ECC_NIST_P256));
+
+	context1 = spdm_private_key_cache_test_use(
+		SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_ECDSA_ECC_NIST_P256);
+	assert_true(spdm_is_private_key_cached(
+		FALSE, SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_ECDSA_ECC_NIST_P256));
+	context2 = spdm_private_key_cache_test_use(
+		SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_ECDSA_ECC_NIST_P256);
+	assert_ptr_equal(context1, context2);
+
+	//
+	// The requester table is separate.
+	//
+	assert_false(spdm_is_private_key_cached(
+		TRUE, SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_ECDSA_ECC_NIST_P256));
+
+	spdm_flush_private_key_cache();
+	assert_false(spdm_is_private_key_cached(
+		FALSE, SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_ECDSA_ECC_NIST_P256));
+}
+
+/**
+  Test 2: get more responder private keys than the cache holds
+  Expected Behavior: the least recently used key is evicted, the recently used keys are kept.
+**/
+void test_spdm_responder_private_key_cache_case2(void **state)
+{
+	void *context;
+
+	spdm_flush_private_key_cache();
+
+	//
+	// Fill the 4 entries.
+	//
+	spdm_private_key_cache_test_use(
+		SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_ECDSA_ECC_NIST_P256);
+	spdm_private_key_cache_test_use(
+		SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_ECDSA_ECC_NIST_P384);
+	spdm_private_key_cache_test_use(
+		SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_RSASSA_2048);
+	context = spdm_private_key_cache_test_use(
+		SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_RSASSA_3072);
+
+	//
+	// Use P256 again, so P384 becomes the least recently used key.
+	//
+	spdm_private_key_cache_test_use(
+		SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_ECDSA_ECC_NIST_P256);
+
+	spdm_private_key_cache_test_use(
+		SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_RSAPSS_2048);
+	assert_false(spdm_is_private_key_cached(
+		FALSE, SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_ECDSA_ECC_NIST_P384));
+	assert_true(spdm_is_private_key_cached(
+		FALSE, SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_ECDSA_ECC_NIST_P256));
+	assert_true(spdm_is_private_key_cached(
+		FALSE, SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_RSASSA_2048));
+	assert_true(spdm_is_private_key_cached(
+		FALSE, SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_RSAPSS_2048));
+	assert_ptr_equal(spdm_private_key_cache_test_use(
+				 SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_RSASSA_3072),
+			 context);
+
+	spdm_flush_private_key_cache();
+}
+
+/**
+  Test 3: get the requester private key, then sign with it
+  Expected Behavior: the signing function uses the cached requester key.
+**/
+void test_spdm_responder_private_key_cache_case3(void **state)
+{
+	uint8 message[] = { 0x11, 0x22, 0x33, 0x44 };
+	uint8 signature[MAX_ASYM_KEY_SIZE];
+	uintn sig_size;
+	void *context;
+
+	spdm_flush_private_key_cache();
+	context = spdm_acquire_private_key(TRUE, m_use_req_asym_algo);
+	assert_non_null(context);
+	spdm_release_private_key(TRUE, m_use_req_asym_algo, context);
+	assert_true(spdm_is_private_key_cached(TRUE, m_use_req_asym_algo));
+
+	sig_size = sizeof(signature);
+	assert_true(spdm_requester_data_sign(m_use_req_asym_algo,
+					     m_use_hash_algo, message,
+					     sizeof(message), signature,
+					     &sig_size));
+	assert_int_equal(sig_size,
+			 spdm_get_req_asym_signature_size(m_use_req_asym_algo));
+	assert_true(spdm_is_private_key_cached(TRUE, m_use_req_asym_algo));
+	assert_ptr_equal(spdm_acquire_private_key(TRUE, m_use_req_asym_algo),
+			 context);
+	spdm_release_private_key(TRUE, m_use_req_asym_algo, context);
+
+	spdm_flush_private_key_cache();
+	assert_false(spdm_is_private_key_cached(TRUE, m_use_req_asym_algo));
+}
+
+/**
+  Test 4: acquire the same private key twice before releasing it, and flush a key in use
+  Expected Behavior: a key in use is not shared, so the second user gets its own copy.
+  A key flushed while in use stays valid until it is released.
+**/
+void test_spdm_responder_private_key_cache_case4(void **state)
+{
+	uint8 message[] = { 0x11, 0x22, 0x33, 0x44 };
+	uint8 signature[MAX_ASYM_KEY_SIZE];
+	uintn sig_size;
+	void *context1;
+	void *context2;
+
+	spdm_flush_private_key_cache();
+	context1 = spdm_acquire_private_key(
+		FALSE, SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_ECDSA_ECC_NIST_P256);
+	assert_non_null(context1);
+	context2 = spdm_acquire_private_key(
+		FALSE, SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_ECDSA_ECC_NIST_P256);
+	assert_non_null(context2);
+	assert_ptr_not_equal(context1, context2);
+	spdm_release_private_key(
+		FALSE, SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_ECDSA_ECC_NIST_P256,
+		context2);
+	assert_ptr_equal(spdm_private_key_cache_test_use(
+				 SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_ECDSA_ECC_NIST_P256),
+			 context2);
+
+	spdm_flush_private_key_cache();
+	assert_false(spdm_is_private_key_cached(
+		FALSE, SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_ECDSA_ECC_NIST_P256));
+	sig_size = sizeof(signature);
+	assert_true(spdm_asym_sign(
+		SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_ECDSA_ECC_NIST_P256,
+		SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_256, context1, message,
+		sizeof(message), signature, &sig_size));
+	spdm_release_private_key(
+		FALSE, SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_ECDSA_ECC_NIST_P256,
+		context1);
+	assert_false(spdm_is_private_key_cached(
+		FALSE, SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_ECDSA_ECC_NIST_P256));
+}
+
+int spdm_responder_private_key_cache_test_main(void)
+{
+	const struct CMUnitTest spdm_responder_private_key_cache_tests[] = {
+		// Cache hit and flush
+		cmocka_unit_test(test_spdm_responder_private_key_cache_case1),
+		// LRU eviction
+		cmocka_unit_test(test_spdm_responder_private_key_cache_case2),
+		// Requester key used by the sign function
+		cmocka_unit_test(test_spdm_responder_private_key_cache_case3),
+		// Key in use is not shared, flush of a key in use
+		cmocka_unit_test(test_spdm_responder_private_key_cache_case4),
+	};
+
+	return cmocka_run_group_tests(spdm_responder_private_key_cache_tests, NULL,
+				      NULL);
+}
@@ -56,7 +56,7 @@ void test_spdm_responder_psk_exchange_case1(void **state)
 		SPDM_CONNECTION_STATE_NEGOTIATED;
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_PSK_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_PSK_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -73,23 +73,23 @@ void test_spdm_responder_psk_exchange_case1(void **state)
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data1,
 						&data_size1, NULL, NULL);
-	spdm_context->local_context.local_cert_chain_provision[0] = data1;
-	spdm_context->local_context.local_cert_chain_provision_size[0] =
+	spdm_context->local_context->local_cert_chain_provision[0] = data1;
+	spdm_context->local_context->local_cert_chain_provision_size[0] =
 		data_size1;
 	spdm_context->connection_info.local_used_cert_chain_buffer = data1;
 	spdm_context->connection_info.local_used_cert_chain_buffer_size =
 		data_size1;
-	spdm_context->local_context.slot_count = 1;
+	spdm_context->local_context->slot_count = 1;
 	spdm_context->transcript.message_a.buffer_size = 0;
 	zero_mem(m_local_psk_hint, 32);
 	copy_mem(&m_local_psk_hint[0], TEST_PSK_HINT_STRING,
 		 sizeof(TEST_PSK_HINT_STRING));
-	spdm_context->local_context.psk_hint_size =
+	spdm_context->local_context->psk_hint_size =
 		sizeof(TEST_PSK_HINT_STRING);
-	spdm_context->local_context.psk_hint = m_local_psk_hint;
+	spdm_context->local_context->psk_hint = m_local_psk_hint;
 
 	m_spdm_psk_exchange_request1.psk_hint_length =
-		(uint16)spdm_context->local_context.psk_hint_size;
+		(uint16)spdm_context->local_context->psk_hint_size;
 	m_spdm_psk_exchange_request1.context_length = DEFAULT_CONTEXT_LENGTH;
 	opaque_psk_exchange_req_size =
 		spdm_get_opaque_data_supported_version_data_size(spdm_context);
@@ -97,8 +97,8 @@ void test_spdm_responder_psk_exchange_case1(void **state)
 		(uint16)opaque_psk_exchange_req_size;
 	m_spdm_psk_exchange_request1.req_session_id = 0xFFFF;
 	ptr = m_spdm_psk_exchange_request1.psk_hint;
-	copy_mem(ptr, spdm_context->local_context.psk_hint,
-		 spdm_context->local_context.psk_hint_size);
+	copy_mem(ptr, spdm_context->local_context->psk_hint,
+		 spdm_context->local_context->psk_hint_size);
 	ptr += m_spdm_psk_exchange_request1.psk_hint_length;
 	spdm_get_random_number(DEFAULT_CONTEXT_LENGTH, ptr);
 	ptr += m_spdm_psk_exchange_request1.context_length;
@@ -145,7 +145,7 @@ void test_spdm_responder_psk_exchange_case2(void **state)
 		SPDM_CONNECTION_STATE_NEGOTIATED;
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_PSK_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_PSK_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -162,23 +162,23 @@ void test_spdm_responder_psk_exchange_case2(void **state)
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data1,
 						&data_size1, NULL, NULL);
-	spdm_context->local_context.local_cert_chain_provision[0] = data1;
-	spdm_context->local_context.local_cert_chain_provision_size[0] =
+	spdm_context->local_context->local_cert_chain_provision[0] = data1;
+	spdm_context->local_context->local_cert_chain_provision_size[0] =
 		data_size1;
 	spdm_context->connection_info.local_used_cert_chain_buffer = data1;
 	spdm_context->connection_info.local_used_cert_chain_buffer_size =
 		data_size1;
-	spdm_context->local_context.slot_count = 1;
+	spdm_context->local_context->slot_count = 1;
 	spdm_context->transcript.message_a.buffer_size = 0;
 	zero_mem(m_local_psk_hint, 32);
 	copy_mem(&m_local_psk_hint[0], TEST_PSK_HINT_STRING,
 		 sizeof(TEST_PSK_HINT_STRING));
-	spdm_context->local_context.psk_hint_size =
+	spdm_context->local_context->psk_hint_size =
 		sizeof(TEST_PSK_HINT_STRING);
-	spdm_context->local_context.psk_hint = m_local_psk_hint;
+	spdm_context->local_context->psk_hint = m_local_psk_hint;
 
 	m_spdm_psk_exchange_request2.psk_hint_length =
-		(uint16)spdm_context->local_context.psk_hint_size;
+		(uint16)spdm_context->local_context->psk_hint_size;
 	m_spdm_psk_exchange_request2.context_length = DEFAULT_CONTEXT_LENGTH;
 	opaque_psk_exchange_req_size =
 		spdm_get_opaque_data_supported_version_data_size(spdm_context);
@@ -186,8 +186,8 @@ void test_spdm_responder_psk_exchange_case2(void **state)
 		(uint16)opaque_psk_exchange_req_size;
 	m_spdm_psk_exchange_request2.req_session_id = 0xFFFF;
 	ptr = m_spdm_psk_exchange_request2.psk_hint;
-	copy_mem(ptr, spdm_context->local_context.psk_hint,
-		 spdm_context->local_context.psk_hint_size);
+	copy_mem(ptr, spdm_context->local_context->psk_hint,
+		 spdm_context->local_context->psk_hint_size);
 	ptr += m_spdm_psk_exchange_request2.psk_hint_length;
 	spdm_get_random_number(DEFAULT_CONTEXT_LENGTH, ptr);
 	ptr += m_spdm_psk_exchange_request2.context_length;
@@ -230,7 +230,7 @@ void test_spdm_responder_psk_exchange_case3(void **state)
 		SPDM_CONNECTION_STATE_NEGOTIATED;
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_PSK_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_PSK_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -247,23 +247,23 @@ void test_spdm_responder_psk_exchange_case3(void **state)
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data1,
 						&data_size1, NULL, NULL);
-	spdm_context->local_context.local_cert_chain_provision[0] = data1;
-	spdm_context->local_context.local_cert_chain_provision_size[0] =
+	spdm_context->local_context->local_cert_chain_provision[0] = data1;
+	spdm_context->local_context->local_cert_chain_provision_size[0] =
 		data_size1;
 	spdm_context->connection_info.local_used_cert_chain_buffer = data1;
 	spdm_context->connection_info.local_used_cert_chain_buffer_size =
 		data_size1;
-	spdm_context->local_context.slot_count = 1;
+	spdm_context->local_context->slot_count = 1;
 	spdm_context->transcript.message_a.buffer_size = 0;
 	zero_mem(m_local_psk_hint, 32);
 	copy_mem(&m_local_psk_hint[0], TEST_PSK_HINT_STRING,
 		 sizeof(TEST_PSK_HINT_STRING));
-	spdm_context->local_context.psk_hint_size =
+	spdm_context->local_context->psk_hint_size =
 		sizeof(TEST_PSK_HINT_STRING);
-	spdm_context->local_context.psk_hint = m_local_psk_hint;
+	spdm_context->local_context->psk_hint = m_local_psk_hint;
 
 	m_spdm_psk_exchange_request1.psk_hint_length =
-		(uint16)spdm_context->local_context.psk_hint_size;
+		(uint16)spdm_context->local_context->psk_hint_size;
 	m_spdm_psk_exchange_request1.context_length = DEFAULT_CONTEXT_LENGTH;
 	opaque_psk_exchange_req_size =
 		spdm_get_opaque_data_supported_version_data_size(spdm_context);
@@ -271,8 +271,8 @@ void test_spdm_responder_psk_exchange_case3(void **state)
 		(uint16)opaque_psk_exchange_req_size;
 	m_spdm_psk_exchange_request1.req_session_id = 0xFFFF;
 	ptr = m_spdm_psk_exchange_request1.psk_hint;
-	copy_mem(ptr, spdm_context->local_context.psk_hint,
-		 spdm_context->local_context.psk_hint_size);
+	copy_mem(ptr, spdm_context->local_context->psk_hint,
+		 spdm_context->local_context->psk_hint_size);
 	ptr += m_spdm_psk_exchange_request1.psk_hint_length;
 	spdm_get_random_number(DEFAULT_CONTEXT_LENGTH, ptr);
 	ptr += m_spdm_psk_exchange_request1.context_length;
@@ -316,7 +316,7 @@ void test_spdm_responder_psk_exchange_case4(void **state)
 		SPDM_CONNECTION_STATE_NEGOTIATED;
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_PSK_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_PSK_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -333,23 +333,23 @@ void test_spdm_responder_psk_exchange_case4(void **state)
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data1,
 						&data_size1, NULL, NULL);
-	spdm_context->local_context.local_cert_chain_provision[0] = data1;
-	spdm_context->local_context.local_cert_chain_provision_size[0] =
+	spdm_context->local_context->local_cert_chain_provision[0] = data1;
+	spdm_context->local_context->local_cert_chain_provision_size[0] =
 		data_size1;
 	spdm_context->connection_info.local_used_cert_chain_buffer = data1;
 	spdm_context->connection_info.local_used_cert_chain_buffer_size =
 		data_size1;
-	spdm_context->local_context.slot_count = 1;
+	spdm_context->local_context->slot_count = 1;
 	spdm_context->transcript.message_a.buffer_size = 0;
 	zero_mem(m_local_psk_hint, 32);
 	copy_mem(&m_local_psk_hint[0], TEST_PSK_HINT_STRING,
 		 sizeof(TEST_PSK_HINT_STRING));
-	spdm_context->local_context.psk_hint_size =
+	spdm_context->local_context->psk_hint_size =
 		sizeof(TEST_PSK_HINT_STRING);
-	spdm_context->local_context.psk_hint = m_local_psk_hint;
+	spdm_context->local_context->psk_hint = m_local_psk_hint;
 
 	m_spdm_psk_exchange_request1.psk_hint_length =
-		(uint16)spdm_context->local_context.psk_hint_size;
+		(uint16)spdm_context->local_context->psk_hint_size;
 	m_spdm_psk_exchange_request1.context_length = DEFAULT_CONTEXT_LENGTH;
 	opaque_psk_exchange_req_size =
 		spdm_get_opaque_data_supported_version_data_size(spdm_context);
@@ -357,8 +357,8 @@ void test_spdm_responder_psk_exchange_case4(void **state)
 		(uint16)opaque_psk_exchange_req_size;
 	m_spdm_psk_exchange_request1.req_session_id = 0xFFFF;
 	ptr = m_spdm_psk_exchange_request1.psk_hint;
-	copy_mem(ptr, spdm_context->local_context.psk_hint,
-		 spdm_context->local_context.psk_hint_size);
+	copy_mem(ptr, spdm_context->local_context->psk_hint,
+		 spdm_context->local_context->psk_hint_size);
 	ptr += m_spdm_psk_exchange_request1.psk_hint_length;
 	spdm_get_random_number(DEFAULT_CONTEXT_LENGTH, ptr);
 	ptr += m_spdm_psk_exchange_request1.context_length;
@@ -404,7 +404,7 @@ void test_spdm_responder_psk_exchange_case5(void **state)
 		SPDM_CONNECTION_STATE_NEGOTIATED;
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_PSK_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_PSK_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -421,23 +421,23 @@ void test_spdm_responder_psk_exchange_case5(void **state)
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data1,
 						&data_size1, NULL, NULL);
-	spdm_context->local_context.local_cert_chain_provision[0] = data1;
-	spdm_context->local_context.local_cert_chain_provision_size[0] =
+	spdm_context->local_context->local_cert_chain_provision[0] = data1;
+	spdm_context->local_context->local_cert_chain_provision_size[0] =
 		data_size1;
 	spdm_context->connection_info.local_used_cert_chain_buffer = data1;
 	spdm_context->connection_info.local_used_cert_chain_buffer_size =
 		data_size1;
-	spdm_context->local_context.slot_count = 1;
+	spdm_context->local_context->slot_count = 1;
 	spdm_context->transcript.message_a.buffer_size = 0;
 	zero_mem(m_local_psk_hint, 32);
 	copy_mem(&m_local_psk_hint[0], TEST_PSK_HINT_STRING,
 		 sizeof(TEST_PSK_HINT_STRING));
-	spdm_context->local_context.psk_hint_size =
+	spdm_context->local_context->psk_hint_size =
 		sizeof(TEST_PSK_HINT_STRING);
-	spdm_context->local_context.psk_hint = m_local_psk_hint;
+	spdm_context->local_context->psk_hint = m_local_psk_hint;
 
 	m_spdm_psk_exchange_request1.psk_hint_length =
-		(uint16)spdm_context->local_context.psk_hint_size;
+		(uint16)spdm_context->local_context->psk_hint_size;
 	m_spdm_psk_exchange_request1.context_length = DEFAULT_CONTEXT_LENGTH;
 	opaque_psk_exchange_req_size =
 		spdm_get_opaque_data_supported_version_data_size(spdm_context);
@@ -445,8 +445,8 @@ void test_spdm_responder_psk_exchange_case5(void **state)
 		(uint16)opaque_psk_exchange_req_size;
 	m_spdm_psk_exchange_request1.req_session_id = 0xFFFF;
 	ptr = m_spdm_psk_exchange_request1.psk_hint;
-	copy_mem(ptr, spdm_context->local_context.psk_hint,
-		 spdm_context->local_context.psk_hint_size);
+	copy_mem(ptr, spdm_context->local_context->psk_hint,
+		 spdm_context->local_context->psk_hint_size);
 	ptr += m_spdm_psk_exchange_request1.psk_hint_length;
 	spdm_get_random_number(DEFAULT_CONTEXT_LENGTH, ptr);
 	ptr += m_spdm_psk_exchange_request1.context_length;
@@ -496,7 +496,7 @@ void test_spdm_responder_psk_exchange_case6(void **state)
 		SPDM_CONNECTION_STATE_NOT_STARTED;
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_PSK_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_PSK_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -513,23 +513,23 @@ void test_spdm_responder_psk_exchange_case6(void **state)
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data1,
 						&data_size1, NULL, NULL);
-	spdm_context->local_context.local_cert_chain_provision[0] = data1;
-	spdm_context->local_context.local_cert_chain_provision_size[0] =
+	spdm_context->local_context->local_cert_chain_provision[0] = data1;
+	spdm_context->local_context->local_cert_chain_provision_size[0] =
 		data_size1;
 	spdm_context->connection_info.local_used_cert_chain_buffer = data1;
 	spdm_context->connection_info.local_used_cert_chain_buffer_size =
 		data_size1;
-	spdm_context->local_context.slot_count = 1;
+	spdm_context->local_context->slot_count = 1;
 	spdm_context->transcript.message_a.buffer_size = 0;
 	zero_mem(m_local_psk_hint, 32);
 	copy_mem(&m_local_psk_hint[0], TEST_PSK_HINT_STRING,
 		 sizeof(TEST_PSK_HINT_STRING));
-	spdm_context->local_context.psk_hint_size =
+	spdm_context->local_context->psk_hint_size =
 		sizeof(TEST_PSK_HINT_STRING);
-	spdm_context->local_context.psk_hint = m_local_psk_hint;
+	spdm_context->local_context->psk_hint = m_local_psk_hint;
 
 	m_spdm_psk_exchange_request1.psk_hint_length =
-		(uint16)spdm_context->local_context.psk_hint_size;
+		(uint16)spdm_context->local_context->psk_hint_size;
 	m_spdm_psk_exchange_request1.context_length = DEFAULT_CONTEXT_LENGTH;
 	opaque_psk_exchange_req_size =
 		spdm_get_opaque_data_supported_version_data_size(spdm_context);
@@ -537,8 +537,8 @@ void test_spdm_responder_psk_exchange_case6(void **state)
 		(uint16)opaque_psk_exchange_req_size;
 	m_spdm_psk_exchange_request1.req_session_id = 0xFFFF;
 	ptr = m_spdm_psk_exchange_request1.psk_hint;
-	copy_mem(ptr, spdm_context->local_context.psk_hint,
-		 spdm_context->local_context.psk_hint_size);
+	copy_mem(ptr, spdm_context->local_context->psk_hint,
+		 spdm_context->local_context->psk_hint_size);
 	ptr += m_spdm_psk_exchange_request1.psk_hint_length;
 	spdm_get_random_number(DEFAULT_CONTEXT_LENGTH, ptr);
 	ptr += m_spdm_psk_exchange_request1.context_length;
@@ -580,7 +580,7 @@ void test_spdm_responder_psk_exchange_case7(void **state)
 		SPDM_CONNECTION_STATE_NEGOTIATED;
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_PSK_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_PSK_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -597,23 +597,23 @@ void test_spdm_responder_psk_exchange_case7(void **state)
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data1,
 						&data_size1, NULL, NULL);
-	spdm_context->local_context.local_cert_chain_provision[0] = data1;
-	spdm_context->local_context.local_cert_chain_provision_size[0] =
+	spdm_context->local_context->local_cert_chain_provision[0] = data1;
+	spdm_context->local_context->local_cert_chain_provision_size[0] =
 		data_size1;
 	spdm_context->connection_info.local_used_cert_chain_buffer = data1;
 	spdm_context->connection_info.local_used_cert_chain_buffer_size =
 		data_size1;
-	spdm_context->local_context.slot_count = 1;
+	spdm_context->local_context->slot_count = 1;
 	spdm_context->transcript.message_a.buffer_size = 0;
 	zero_mem(m_local_psk_hint, 32);
 	copy_mem(&m_local_psk_hint[0], TEST_PSK_HINT_STRING,
 		 sizeof(TEST_PSK_HINT_STRING));
-	spdm_context->local_context.psk_hint_size =
+	spdm_context->local_context->psk_hint_size =
 		sizeof(TEST_PSK_HINT_STRING);
-	spdm_context->local_context.psk_hint = m_local_psk_hint;
+	spdm_context->local_context->psk_hint = m_local_psk_hint;
 
 	m_spdm_psk_exchange_request1.psk_hint_length =
-		(uint16)spdm_context->local_context.psk_hint_size;
+		(uint16)spdm_context->local_context->psk_hint_size;
 	m_spdm_psk_exchange_request1.context_length = DEFAULT_CONTEXT_LENGTH;
 	opaque_psk_exchange_req_size =
 		spdm_get_opaque_data_supported_version_data_size(spdm_context);
@@ -621,8 +621,8 @@ void test_spdm_responder_psk_exchange_case7(void **state)
 		(uint16)opaque_psk_exchange_req_size;
 	m_spdm_psk_exchange_request1.req_session_id = 0xFFFF;
 	ptr = m_spdm_psk_exchange_request1.psk_hint;
-	copy_mem(ptr, spdm_context->local_context.psk_hint,
-		 spdm_context->local_context.psk_hint_size);
+	copy_mem(ptr, spdm_context->local_context->psk_hint,
+		 spdm_context->local_context->psk_hint_size);
 	ptr += m_spdm_psk_exchange_request1.psk_hint_length;
 	spdm_get_random_number(DEFAULT_CONTEXT_LENGTH, ptr);
 	ptr += m_spdm_psk_exchange_request1.context_length;
@@ -634,6 +634,7 @@ void test_spdm_responder_psk_exchange_case7(void **state)
 
 	spdm_context->transcript.message_m.buffer_size =
 							spdm_context->transcript.message_m.max_buffer_size;
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	spdm_context->transcript.message_b.buffer_size =
 							spdm_context->transcript.message_b.max_buffer_size;
 	spdm_context->transcript.message_c.buffer_size =
@@ -642,6 +643,7 @@ void test_spdm_responder_psk_exchange_case7(void **state)
 							spdm_context->transcript.message_mut_b.max_buffer_size;
 	spdm_context->transcript.message_mut_c.buffer_size =
 							spdm_context->transcript.message_mut_c.max_buffer_size;
+#endif
 
 	response_size = sizeof(response);
 	status = spdm_get_response_psk_exchange(
@@ -658,10 +660,12 @@ void test_spdm_responder_psk_exchange_case7(void **state)
 	assert_int_equal(spdm_context->transcript.message_m.buffer_size,
 					0);
 	assert_int_equal(spdm_context->transcript.message_m.buffer_size, 0);
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	assert_int_equal(spdm_context->transcript.message_b.buffer_size, 0);
 	assert_int_equal(spdm_context->transcript.message_c.buffer_size, 0);
 	assert_int_equal(spdm_context->transcript.message_mut_b.buffer_size, 0);
 	assert_int_equal(spdm_context->transcript.message_mut_c.buffer_size, 0);
+#endif
 
 	free(data1);
 }
@@ -66,7 +66,7 @@ void test_spdm_responder_psk_finish_case1(void **state)
 		SPDM_CONNECTION_STATE_NEGOTIATED;
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_PSK_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_PSK_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -83,21 +83,21 @@ void test_spdm_responder_psk_finish_case1(void **state)
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data1,
 						&data_size1, NULL, NULL);
-	spdm_context->local_context.local_cert_chain_provision[0] = data1;
-	spdm_context->local_context.local_cert_chain_provision_size[0] =
+	spdm_context->local_context->local_cert_chain_provision[0] = data1;
+	spdm_context->local_context->local_cert_chain_provision_size[0] =
 		data_size1;
 	spdm_context->connection_info.local_used_cert_chain_buffer = data1;
 	spdm_context->connection_info.local_used_cert_chain_buffer_size =
 		data_size1;
-	spdm_context->local_context.slot_count = 1;
+	spdm_context->local_context->slot_count = 1;
 	spdm_context->transcript.message_a.buffer_size = 0;
-	spdm_context->local_context.mut_auth_requested = 0;
+	spdm_context->local_context->mut_auth_requested = 0;
 	zero_mem(m_local_psk_hint, 32);
 	copy_mem(&m_local_psk_hint[0], TEST_PSK_HINT_STRING,
 		 sizeof(TEST_PSK_HINT_STRING));
-	spdm_context->local_context.psk_hint_size =
+	spdm_context->local_context->psk_hint_size =
 		sizeof(TEST_PSK_HINT_STRING);
-	spdm_context->local_context.psk_hint = m_local_psk_hint;
+	spdm_context->local_context->psk_hint = m_local_psk_hint;
 
 	session_id = 0xFFFFFFFF;
 	spdm_context->latest_session_id = session_id;
@@ -105,6 +105,10 @@ void test_spdm_responder_psk_finish_case1(void **state)
 	spdm_context->last_spdm_request_session_id = session_id;
 	session_info = &spdm_context->session_info[0];
 	spdm_session_info_init(spdm_context, session_info, session_id, TRUE);
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 0
+	// message_k is empty, only seed the TH hash context with A.
+	spdm_append_message_k(spdm_context, session_info, FALSE, NULL, 0);
+#endif
 	hash_size = spdm_get_hash_size(m_use_hash_algo);
 	set_mem(m_dummy_buffer, hash_size, (uint8)(0xFF));
 	spdm_secured_message_set_request_finished_key(
@@ -165,7 +169,7 @@ void test_spdm_responder_psk_finish_case2(void **state)
 		SPDM_CONNECTION_STATE_NEGOTIATED;
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_PSK_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_PSK_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -182,21 +186,21 @@ void test_spdm_responder_psk_finish_case2(void **state)
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data1,
 						&data_size1, NULL, NULL);
-	spdm_context->local_context.local_cert_chain_provision[0] = data1;
-	spdm_context->local_context.local_cert_chain_provision_size[0] =
+	spdm_context->local_context->local_cert_chain_provision[0] = data1;
+	spdm_context->local_context->local_cert_chain_provision_size[0] =
 		data_size1;
 	spdm_context->connection_info.local_used_cert_chain_buffer = data1;
 	spdm_context->connection_info.local_used_cert_chain_buffer_size =
 		data_size1;
-	spdm_context->local_context.slot_count = 1;
+	spdm_context->local_context->slot_count = 1;
 	spdm_context->transcript.message_a.buffer_size = 0;
-	spdm_context->local_context.mut_auth_requested = 0;
+	spdm_context->local_context->mut_auth_requested = 0;
 	zero_mem(m_local_psk_hint, 32);
 	copy_mem(&m_local_psk_hint[0], TEST_PSK_HINT_STRING,
 		 sizeof(TEST_PSK_HINT_STRING));
-	spdm_context->local_context.psk_hint_size =
+	spdm_context->local_context->psk_hint_size =
 		sizeof(TEST_PSK_HINT_STRING);
-	spdm_context->local_context.psk_hint = m_local_psk_hint;
+	spdm_context->local_context->psk_hint = m_local_psk_hint;
 
 	session_id = 0xFFFFFFFF;
 	spdm_context->latest_session_id = session_id;
@@ -204,6 +208,10 @@ void test_spdm_responder_psk_finish_case2(void **state)
 	spdm_context->last_spdm_request_session_id = session_id;
 	session_info = &spdm_context->session_info[0];
 	spdm_session_info_init(spdm_context, session_info, session_id, TRUE);
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 0
+	// message_k is empty, only seed the TH hash context with A.
+	spdm_append_message_k(spdm_context, session_info, FALSE, NULL, 0);
+#endif
 	hash_size = spdm_get_hash_size(m_use_hash_algo);
 	set_mem(m_dummy_buffer, hash_size, (uint8)(0xFF));
 	spdm_secured_message_set_request_finished_key(
@@ -266,7 +274,7 @@ void test_spdm_responder_psk_finish_case3(void **state)
 		SPDM_CONNECTION_STATE_NEGOTIATED;
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_PSK_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_PSK_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -283,21 +291,21 @@ void test_spdm_responder_psk_finish_case3(void **state)
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data1,
 						&data_size1, NULL, NULL);
-	spdm_context->local_context.local_cert_chain_provision[0] = data1;
-	spdm_context->local_context.local_cert_chain_provision_size[0] =
+	spdm_context->local_context->local_cert_chain_provision[0] = data1;
+	spdm_context->local_context->local_cert_chain_provision_size[0] =
 		data_size1;
 	spdm_context->connection_info.local_used_cert_chain_buffer = data1;
 	spdm_context->connection_info.local_used_cert_chain_buffer_size =
 		data_size1;
-	spdm_context->local_context.slot_count = 1;
+	spdm_context->local_context->slot_count = 1;
 	spdm_context->transcript.message_a.buffer_size = 0;
-	spdm_context->local_context.mut_auth_requested = 0;
+	spdm_context->local_context->mut_auth_requested = 0;
 	zero_mem(m_local_psk_hint, 32);
 	copy_mem(&m_local_psk_hint[0], TEST_PSK_HINT_STRING,
 		 sizeof(TEST_PSK_HINT_STRING));
-	spdm_context->local_context.psk_hint_size =
+	spdm_context->local_context->psk_hint_size =
 		sizeof(TEST_PSK_HINT_STRING);
-	spdm_context->local_context.psk_hint = m_local_psk_hint;
+	spdm_context->local_context->psk_hint = m_local_psk_hint;
 
 	session_id = 0xFFFFFFFF;
 	spdm_context->latest_session_id = session_id;
@@ -305,6 +313,10 @@ void test_spdm_responder_psk_finish_case3(void **state)
 	spdm_context->last_spdm_request_session_id = session_id;
 	session_info = &spdm_context->session_info[0];
 	spdm_session_info_init(spdm_context, session_info, session_id, TRUE);
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 0
+	// message_k is empty, only seed the TH hash context with A.
+	spdm_append_message_k(spdm_context, session_info, FALSE, NULL, 0);
+#endif
 	hash_size = spdm_get_hash_size(m_use_hash_algo);
 	set_mem(m_dummy_buffer, hash_size, (uint8)(0xFF));
 	spdm_secured_message_set_request_finished_key(
@@ -371,7 +383,7 @@ void test_spdm_responder_psk_finish_case4(void **state)
 		SPDM_CONNECTION_STATE_NEGOTIATED;
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_PSK_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_PSK_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -388,21 +400,21 @@ void test_spdm_responder_psk_finish_case4(void **state)
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data1,
 						&data_size1, NULL, NULL);
-	spdm_context->local_context.local_cert_chain_provision[0] = data1;
-	spdm_context->local_context.local_cert_chain_provision_size[0] =
+	spdm_context->local_context->local_cert_chain_provision[0] = data1;
+	spdm_context->local_context->local_cert_chain_provision_size[0] =
 		data_size1;
 	spdm_context->connection_info.local_used_cert_chain_buffer = data1;
 	spdm_context->connection_info.local_used_cert_chain_buffer_size =
 		data_size1;
-	spdm_context->local_context.slot_count = 1;
+	spdm_context->local_context->slot_count = 1;
 	spdm_context->transcript.message_a.buffer_size = 0;
-	spdm_context->local_context.mut_auth_requested = 0;
+	spdm_context->local_context->mut_auth_requested = 0;
 	zero_mem(m_local_psk_hint, 32);
 	copy_mem(&m_local_psk_hint[0], TEST_PSK_HINT_STRING,
 		 sizeof(TEST_PSK_HINT_STRING));
-	spdm_context->local_context.psk_hint_size =
+	spdm_context->local_context->psk_hint_size =
 		sizeof(TEST_PSK_HINT_STRING);
-	spdm_context->local_context.psk_hint = m_local_psk_hint;
+	spdm_context->local_context->psk_hint = m_local_psk_hint;
 
 	session_id = 0xFFFFFFFF;
 	spdm_context->latest_session_id = session_id;
@@ -410,6 +422,10 @@ void test_spdm_responder_psk_finish_case4(void **state)
 	spdm_context->last_spdm_request_session_id = session_id;
 	session_info = &spdm_context->session_info[0];
 	spdm_session_info_init(spdm_context, session_info, session_id, TRUE);
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 0
+	// message_k is empty, only seed the TH hash context with A.
+	spdm_append_message_k(spdm_context, session_info, FALSE, NULL, 0);
+#endif
 	hash_size = spdm_get_hash_size(m_use_hash_algo);
 	set_mem(m_dummy_buffer, hash_size, (uint8)(0xFF));
 	spdm_secured_message_set_request_finished_key(
@@ -478,7 +494,7 @@ void test_spdm_responder_psk_finish_case5(void **state)
 		SPDM_CONNECTION_STATE_NEGOTIATED;
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_PSK_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_PSK_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -495,21 +511,21 @@ void test_spdm_responder_psk_finish_case5(void **state)
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data1,
 						&data_size1, NULL, NULL);
-	spdm_context->local_context.local_cert_chain_provision[0] = data1;
-	spdm_context->local_context.local_cert_chain_provision_size[0] =
+	spdm_context->local_context->local_cert_chain_provision[0] = data1;
+	spdm_context->local_context->local_cert_chain_provision_size[0] =
 		data_size1;
 	spdm_context->connection_info.local_used_cert_chain_buffer = data1;
 	spdm_context->connection_info.local_used_cert_chain_buffer_size =
 		data_size1;
-	spdm_context->local_context.slot_count = 1;
+	spdm_context->local_context->slot_count = 1;
 	spdm_context->transcript.message_a.buffer_size = 0;
-	spdm_context->local_context.mut_auth_requested = 0;
+	spdm_context->local_context->mut_auth_requested = 0;
 	zero_mem(m_local_psk_hint, 32);
 	copy_mem(&m_local_psk_hint[0], TEST_PSK_HINT_STRING,
 		 sizeof(TEST_PSK_HINT_STRING));
-	spdm_context->local_context.psk_hint_size =
+	spdm_context->local_context->psk_hint_size =
 		sizeof(TEST_PSK_HINT_STRING);
-	spdm_context->local_context.psk_hint = m_local_psk_hint;
+	spdm_context->local_context->psk_hint = m_local_psk_hint;
 
 	session_id = 0xFFFFFFFF;
 	spdm_context->latest_session_id = session_id;
@@ -517,6 +533,10 @@ void test_spdm_responder_psk_finish_case5(void **state)
 	spdm_context->last_spdm_request_session_id = session_id;
 	session_info = &spdm_context->session_info[0];
 	spdm_session_info_init(spdm_context, session_info, session_id, TRUE);
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 0
+	// message_k is empty, only seed the TH hash context with A.
+	spdm_append_message_k(spdm_context, session_info, FALSE, NULL, 0);
+#endif
 	hash_size = spdm_get_hash_size(m_use_hash_algo);
 	set_mem(m_dummy_buffer, hash_size, (uint8)(0xFF));
 	spdm_secured_message_set_request_finished_key(
@@ -589,7 +609,7 @@ void test_spdm_responder_psk_finish_case6(void **state)
 		SPDM_CONNECTION_STATE_NOT_STARTED;
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_PSK_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_PSK_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -606,21 +626,21 @@ void test_spdm_responder_psk_finish_case6(void **state)
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data1,
 						&data_size1, NULL, NULL);
-	spdm_context->local_context.local_cert_chain_provision[0] = data1;
-	spdm_context->local_context.local_cert_chain_provision_size[0] =
+	spdm_context->local_context->local_cert_chain_provision[0] = data1;
+	spdm_context->local_context->local_cert_chain_provision_size[0] =
 		data_size1;
 	spdm_context->connection_info.local_used_cert_chain_buffer = data1;
 	spdm_context->connection_info.local_used_cert_chain_buffer_size =
 		data_size1;
-	spdm_context->local_context.slot_count = 1;
+	spdm_context->local_context->slot_count = 1;
 	spdm_context->transcript.message_a.buffer_size = 0;
-	spdm_context->local_context.mut_auth_requested = 0;
+	spdm_context->local_context->mut_auth_requested = 0;
 	zero_mem(m_local_psk_hint, 32);
 	copy_mem(&m_local_psk_hint[0], TEST_PSK_HINT_STRING,
 		 sizeof(TEST_PSK_HINT_STRING));
-	spdm_context->local_context.psk_hint_size =
+	spdm_context->local_context->psk_hint_size =
 		sizeof(TEST_PSK_HINT_STRING);
-	spdm_context->local_context.psk_hint = m_local_psk_hint;
+	spdm_context->local_context->psk_hint = m_local_psk_hint;
 
 	session_id = 0xFFFFFFFF;
 	spdm_context->latest_session_id = session_id;
@@ -628,6 +648,10 @@ void test_spdm_responder_psk_finish_case6(void **state)
 	spdm_context->last_spdm_request_session_id = session_id;
 	session_info = &spdm_context->session_info[0];
 	spdm_session_info_init(spdm_context, session_info, session_id, TRUE);
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 0
+	// message_k is empty, only seed the TH hash context with A.
+	spdm_append_message_k(spdm_context, session_info, FALSE, NULL, 0);
+#endif
 	hash_size = spdm_get_hash_size(m_use_hash_algo);
 	set_mem(m_dummy_buffer, hash_size, (uint8)(0xFF));
 	spdm_secured_message_set_request_finished_key(
@@ -692,7 +716,7 @@ void test_spdm_responder_psk_finish_case7(void **state)
 		SPDM_CONNECTION_STATE_NEGOTIATED;
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_PSK_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_PSK_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -709,21 +733,21 @@ void test_spdm_responder_psk_finish_case7(void **state)
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data1,
 						&data_size1, NULL, NULL);
-	spdm_context->local_context.local_cert_chain_provision[0] = data1;
-	spdm_context->local_context.local_cert_chain_provision_size[0] =
+	spdm_context->local_context->local_cert_chain_provision[0] = data1;
+	spdm_context->local_context->local_cert_chain_provision_size[0] =
 		data_size1;
 	spdm_context->connection_info.local_used_cert_chain_buffer = data1;
 	spdm_context->connection_info.local_used_cert_chain_buffer_size =
 		data_size1;
-	spdm_context->local_context.slot_count = 1;
+	spdm_context->local_context->slot_count = 1;
 	spdm_context->transcript.message_a.buffer_size = 0;
-	spdm_context->local_context.mut_auth_requested = 0;
+	spdm_context->local_context->mut_auth_requested = 0;
 	zero_mem(m_local_psk_hint, 32);
 	copy_mem(&m_local_psk_hint[0], TEST_PSK_HINT_STRING,
 		 sizeof(TEST_PSK_HINT_STRING));
-	spdm_context->local_context.psk_hint_size =
+	spdm_context->local_context->psk_hint_size =
 		sizeof(TEST_PSK_HINT_STRING);
-	spdm_context->local_context.psk_hint = m_local_psk_hint;
+	spdm_context->local_context->psk_hint = m_local_psk_hint;
 
 	session_id = 0xFFFFFFFF;
 	spdm_context->latest_session_id = session_id;
@@ -731,6 +755,10 @@ void test_spdm_responder_psk_finish_case7(void **state)
 	spdm_context->last_spdm_request_session_id = session_id;
 	session_info = &spdm_context->session_info[0];
 	spdm_session_info_init(spdm_context, session_info, session_id, TRUE);
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 0
+	// message_k is empty, only seed the TH hash context with A.
+	spdm_append_message_k(spdm_context, session_info, FALSE, NULL, 0);
+#endif
 	hash_size = spdm_get_hash_size(m_use_hash_algo);
 	set_mem(m_dummy_buffer, hash_size, (uint8)(0xFF));
 	spdm_secured_message_set_request_finished_key(
@@ -751,6 +779,7 @@ void test_spdm_responder_psk_finish_case7(void **state)
 
 	spdm_context->transcript.message_m.buffer_size =
 							spdm_context->transcript.message_m.max_buffer_size;
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	spdm_context->transcript.message_b.buffer_size =
 							spdm_context->transcript.message_b.max_buffer_size;
 	spdm_context->transcript.message_c.buffer_size =
@@ -759,6 +788,7 @@ void test_spdm_responder_psk_finish_case7(void **state)
 							spdm_context->transcript.message_mut_b.max_buffer_size;
 	spdm_context->transcript.message_mut_c.buffer_size =
 							spdm_context->transcript.message_mut_c.max_buffer_size;
+#endif
 
 	set_mem(request_finished_key, MAX_HASH_SIZE, (uint8)(0xFF));
 	spdm_hmac_all(m_use_hash_algo, get_managed_buffer(&th_curr),
@@ -777,10 +807,12 @@ void test_spdm_responder_psk_finish_case7(void **state)
 	assert_int_equal(spdm_response->header.request_response_code,
 			 SPDM_PSK_FINISH_RSP);
 	assert_int_equal(spdm_context->transcript.message_m.buffer_size, 0);
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 1
 	assert_int_equal(spdm_context->transcript.message_b.buffer_size, 0);
 	assert_int_equal(spdm_context->transcript.message_c.buffer_size, 0);
 	assert_int_equal(spdm_context->transcript.message_mut_b.buffer_size, 0);
 	assert_int_equal(spdm_context->transcript.message_mut_c.buffer_size, 0);
+#endif
 	 
 	free(data1);
 }
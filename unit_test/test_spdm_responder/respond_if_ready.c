@@ -254,6 +254,22 @@ uintn m_spdm_end_session_request_size = sizeof(m_spdm_end_session_request);
 
 static uint8                  m_local_certificate_chain[MAX_SPDM_MESSAGE_BUFFER_SIZE];
 
+/**
+  Allocate the request buffers of the SPDM context from the arena on first use,
+  if they are not held in the SPDM context.
+**/
+static void spdm_test_respond_if_ready_allocate_request(spdm_context_t *spdm_context)
+{
+#if OPENSPDM_ARENA_MANAGED_BUFFER_SUPPORT == 1
+  return_status status;
+
+  status = spdm_allocate_arena_request_buffer(&spdm_context->arena, &spdm_context->last_spdm_request);
+  assert_int_equal (status, RETURN_SUCCESS);
+  status = spdm_allocate_arena_request_buffer(&spdm_context->arena, &spdm_context->cache_spdm_request);
+  assert_int_equal (status, RETURN_SUCCESS);
+#endif
+}
+
 static void spdm_secured_message_set_request_finished_key(
 	IN void *spdm_secured_message_context, IN void *key, IN uintn key_size)
 {
@@ -286,17 +302,18 @@ void test_spdm_responder_respond_if_ready_case1(void **state) {
 
   //state for the the original request (GET_DIGESTS)
   spdm_context->connection_info.connection_state = SPDM_CONNECTION_STATE_NEGOTIATED; 
-  spdm_context->local_context.capability.flags = 0;
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
+  spdm_context->local_context->capability.flags = 0;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
   spdm_context->connection_info.algorithm.base_hash_algo = m_use_hash_algo;
   spdm_context->connection_info.version.spdm_version_count = 1;
   spdm_context->connection_info.version.spdm_version[0].major_version = 1;
   spdm_context->connection_info.version.spdm_version[0].minor_version = 1;
-  spdm_context->local_context.local_cert_chain_provision[0] = m_local_certificate_chain;
-  spdm_context->local_context.local_cert_chain_provision_size[0] = MAX_SPDM_MESSAGE_BUFFER_SIZE;
+  spdm_context->local_context->local_cert_chain_provision[0] = m_local_certificate_chain;
+  spdm_context->local_context->local_cert_chain_provision_size[0] = MAX_SPDM_MESSAGE_BUFFER_SIZE;
   set_mem (m_local_certificate_chain, MAX_SPDM_MESSAGE_BUFFER_SIZE, (uint8)(0xFF));
-  spdm_context->local_context.slot_count = 1;
+  spdm_context->local_context->slot_count = 1;
 
+  spdm_test_respond_if_ready_allocate_request (spdm_context);
   spdm_context->last_spdm_request_size = m_spdm_get_digest_request_size;
   copy_mem (spdm_context->last_spdm_request, &m_spdm_get_digest_request, m_spdm_get_digest_request_size);
 
@@ -340,18 +357,19 @@ void test_spdm_responder_respond_if_ready_case2(void **state) {
 
   //state for the the original request (GET_CERTIFICATE)
   spdm_context->connection_info.connection_state = SPDM_CONNECTION_STATE_AFTER_DIGESTS;
-  spdm_context->local_context.capability.flags = 0;
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
+  spdm_context->local_context->capability.flags = 0;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
   spdm_context->connection_info.algorithm.base_hash_algo = m_use_hash_algo;
   spdm_context->connection_info.algorithm.base_asym_algo = m_use_asym_algo;
   spdm_context->connection_info.version.spdm_version_count = 1;
   spdm_context->connection_info.version.spdm_version[0].major_version = 1;
   spdm_context->connection_info.version.spdm_version[0].minor_version = 1;
   read_responder_public_certificate_chain (m_use_hash_algo, m_use_asym_algo, &data, &data_size, NULL, NULL);
-  spdm_context->local_context.local_cert_chain_provision[0] = data;
-  spdm_context->local_context.local_cert_chain_provision_size[0] = data_size;
-  spdm_context->local_context.slot_count = 1;
+  spdm_context->local_context->local_cert_chain_provision[0] = data;
+  spdm_context->local_context->local_cert_chain_provision_size[0] = data_size;
+  spdm_context->local_context->slot_count = 1;
 
+  spdm_test_respond_if_ready_allocate_request (spdm_context);
   spdm_context->last_spdm_request_size = m_spdm_get_certificate_request_size;
   copy_mem (spdm_context->last_spdm_request, &m_spdm_get_certificate_request, m_spdm_get_certificate_request_size);
 
@@ -399,9 +417,9 @@ void test_spdm_responder_respond_if_ready_case3(void **state) {
 
   //state for the the original request (CHALLENGE)
   spdm_context->connection_info.connection_state = SPDM_CONNECTION_STATE_NEGOTIATED;
-  spdm_context->local_context.capability.flags = 0;
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CHAL_CAP;
+  spdm_context->local_context->capability.flags = 0;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CHAL_CAP;
   spdm_context->connection_info.algorithm.base_hash_algo = m_use_hash_algo;
   spdm_context->connection_info.algorithm.base_asym_algo = m_use_asym_algo;
   spdm_context->connection_info.algorithm.measurement_spec = m_use_measurement_spec;
@@ -410,11 +428,12 @@ void test_spdm_responder_respond_if_ready_case3(void **state) {
   spdm_context->connection_info.version.spdm_version[0].major_version = 1;
   spdm_context->connection_info.version.spdm_version[0].minor_version = 1;
   read_responder_public_certificate_chain (m_use_hash_algo, m_use_asym_algo, &data, &data_size, NULL, NULL);
-  spdm_context->local_context.local_cert_chain_provision[0] = data;
-  spdm_context->local_context.local_cert_chain_provision_size[0] = data_size;
-  spdm_context->local_context.slot_count = 1;
-  spdm_context->local_context.opaque_challenge_auth_rsp_size = 0;
+  spdm_context->local_context->local_cert_chain_provision[0] = data;
+  spdm_context->local_context->local_cert_chain_provision_size[0] = data_size;
+  spdm_context->local_context->slot_count = 1;
+  spdm_context->local_context->opaque_challenge_auth_rsp_size = 0;
 
+  spdm_test_respond_if_ready_allocate_request (spdm_context);
   spdm_context->last_spdm_request_size = m_spdm_challenge_request_size;
   copy_mem (spdm_context->last_spdm_request, &m_spdm_challenge_request, m_spdm_challenge_request_size);
 
@@ -460,8 +479,8 @@ void test_spdm_responder_respond_if_ready_case4(void **state) {
 
   //state for the the original request (GET_MEASUREMENTS)
   spdm_context->connection_info.connection_state = SPDM_CONNECTION_STATE_AUTHENTICATED;
-  spdm_context->local_context.capability.flags = 0;
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MEAS_CAP_SIG;
+  spdm_context->local_context->capability.flags = 0;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MEAS_CAP_SIG;
   spdm_context->connection_info.algorithm.base_hash_algo = m_use_hash_algo;
   spdm_context->connection_info.algorithm.base_asym_algo = m_use_asym_algo;
   spdm_context->connection_info.algorithm.measurement_spec = m_use_measurement_spec;
@@ -469,9 +488,10 @@ void test_spdm_responder_respond_if_ready_case4(void **state) {
   spdm_context->connection_info.version.spdm_version_count = 1;
   spdm_context->connection_info.version.spdm_version[0].major_version = 1;
   spdm_context->connection_info.version.spdm_version[0].minor_version = 1;
-  spdm_context->local_context.opaque_measurement_rsp_size = 0;
-  spdm_context->local_context.opaque_measurement_rsp = NULL;
+  spdm_context->local_context->opaque_measurement_rsp_size = 0;
+  spdm_context->local_context->opaque_measurement_rsp = NULL;
 
+  spdm_test_respond_if_ready_allocate_request (spdm_context);
   spdm_context->last_spdm_request_size = m_spdm_get_measurements_request_size;
   copy_mem (spdm_context->last_spdm_request, &m_spdm_get_measurements_request, m_spdm_get_measurements_request_size);
 
@@ -521,9 +541,9 @@ void test_spdm_responder_respond_if_ready_case5(void **state) {
 
   //state for the the original request (KEY_EXCHANGE)
   spdm_context->connection_info.connection_state = SPDM_CONNECTION_STATE_AUTHENTICATED;
-  spdm_context->local_context.capability.flags = 0;
+  spdm_context->local_context->capability.flags = 0;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_KEY_EX_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_KEY_EX_CAP;
   spdm_context->connection_info.algorithm.base_hash_algo = m_use_hash_algo;
   spdm_context->connection_info.algorithm.base_asym_algo = m_use_asym_algo;
   spdm_context->connection_info.algorithm.measurement_spec = m_use_measurement_spec;
@@ -534,10 +554,10 @@ void test_spdm_responder_respond_if_ready_case5(void **state) {
   spdm_context->connection_info.version.spdm_version[0].major_version = 1;
   spdm_context->connection_info.version.spdm_version[0].minor_version = 1;
   read_responder_public_certificate_chain (m_use_hash_algo, m_use_asym_algo, &data, &data_size, NULL, NULL);
-  spdm_context->local_context.local_cert_chain_provision[0] = data;
-  spdm_context->local_context.local_cert_chain_provision_size[0] = data_size;
-  spdm_context->local_context.slot_count = 1;
-  spdm_context->local_context.mut_auth_requested = 0;
+  spdm_context->local_context->local_cert_chain_provision[0] = data;
+  spdm_context->local_context->local_cert_chain_provision_size[0] = data_size;
+  spdm_context->local_context->slot_count = 1;
+  spdm_context->local_context->mut_auth_requested = 0;
 
   m_spdm_key_exchange_request.req_session_id = 0xFFFF;
   m_spdm_key_exchange_request.reserved = 0;
@@ -555,6 +575,7 @@ void test_spdm_responder_respond_if_ready_case5(void **state) {
   spdm_build_opaque_data_supported_version_data (spdm_context, &opaque_key_exchange_req_size, ptr);
   ptr += opaque_key_exchange_req_size;
 
+  spdm_test_respond_if_ready_allocate_request (spdm_context);
   spdm_context->last_spdm_request_size = m_spdm_key_exchange_request_size;
   copy_mem (spdm_context->last_spdm_request, &m_spdm_key_exchange_request, m_spdm_key_exchange_request_size);
 
@@ -613,11 +634,11 @@ void test_spdm_responder_respond_if_ready_case6(void **state) {
 
   //state for the the original request (FINISH)
   spdm_context->connection_info.connection_state = SPDM_CONNECTION_STATE_AUTHENTICATED;
-  spdm_context->local_context.capability.flags = 0;
+  spdm_context->local_context->capability.flags = 0;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_HANDSHAKE_IN_THE_CLEAR_CAP;
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_KEY_EX_CAP;
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_HANDSHAKE_IN_THE_CLEAR_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_KEY_EX_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_HANDSHAKE_IN_THE_CLEAR_CAP;
   spdm_context->connection_info.algorithm.base_hash_algo = m_use_hash_algo;
   spdm_context->connection_info.algorithm.base_asym_algo = m_use_asym_algo;
   spdm_context->connection_info.algorithm.measurement_spec = m_use_measurement_spec;
@@ -628,17 +649,21 @@ void test_spdm_responder_respond_if_ready_case6(void **state) {
   spdm_context->connection_info.version.spdm_version[0].major_version = 1;
   spdm_context->connection_info.version.spdm_version[0].minor_version = 1;
   read_responder_public_certificate_chain (m_use_hash_algo, m_use_asym_algo, &data, &data_size, NULL, NULL);
-  spdm_context->local_context.local_cert_chain_provision[0] = data;
-  spdm_context->local_context.local_cert_chain_provision_size[0] = data_size;
+  spdm_context->local_context->local_cert_chain_provision[0] = data;
+  spdm_context->local_context->local_cert_chain_provision_size[0] = data_size;
   spdm_context->connection_info.local_used_cert_chain_buffer = data;
   spdm_context->connection_info.local_used_cert_chain_buffer_size = data_size;
-  spdm_context->local_context.slot_count = 1;
-  spdm_context->local_context.mut_auth_requested = 0;
+  spdm_context->local_context->slot_count = 1;
+  spdm_context->local_context->mut_auth_requested = 0;
 
   session_id = 0xFFFFFFFF;
   spdm_context->latest_session_id = session_id;
   session_info = &spdm_context->session_info[0];
   spdm_session_info_init (spdm_context, session_info, session_id, FALSE);
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 0
+  // message_k is empty, only seed the TH hash context with (A, Ct).
+  spdm_append_message_k (spdm_context, session_info, FALSE, NULL, 0);
+#endif
   hash_size = spdm_get_hash_size (m_use_hash_algo);
   set_mem (dummy_buffer, hash_size, (uint8)(0xFF));
   spdm_secured_message_set_request_finished_key (session_info->secured_message_context, dummy_buffer, hash_size);
@@ -658,6 +683,7 @@ void test_spdm_responder_respond_if_ready_case6(void **state) {
   set_mem (request_finished_key, MAX_HASH_SIZE, (uint8)(0xFF));
   spdm_hmac_all (m_use_hash_algo, get_managed_buffer(&th_curr), get_managed_buffer_size(&th_curr), request_finished_key, hash_size, ptr);
 
+  spdm_test_respond_if_ready_allocate_request (spdm_context);
   spdm_context->last_spdm_request_size = sizeof(spdm_finish_request_t) + hmac_size;
   copy_mem (spdm_context->last_spdm_request, &m_spdm_finish_request, m_spdm_finish_request_size);
 
@@ -707,9 +733,9 @@ void test_spdm_responder_respond_if_ready_case7(void **state) {
 
   //state for the the original request (PSK_EXCHANGE)
   spdm_context->connection_info.connection_state = SPDM_CONNECTION_STATE_AUTHENTICATED;
-  spdm_context->local_context.capability.flags = 0;
+  spdm_context->local_context->capability.flags = 0;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_PSK_CAP;
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_PSK_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_PSK_CAP;
   spdm_context->connection_info.algorithm.base_hash_algo = m_use_hash_algo;
   spdm_context->connection_info.algorithm.base_asym_algo = m_use_asym_algo;
   spdm_context->connection_info.algorithm.measurement_spec = m_use_measurement_spec;
@@ -721,29 +747,30 @@ void test_spdm_responder_respond_if_ready_case7(void **state) {
   spdm_context->connection_info.version.spdm_version[0].major_version = 1;
   spdm_context->connection_info.version.spdm_version[0].minor_version = 1;
   read_responder_public_certificate_chain (m_use_hash_algo, m_use_asym_algo, &data, &data_size, NULL, NULL);
-  spdm_context->local_context.local_cert_chain_provision[0] = data;
-  spdm_context->local_context.local_cert_chain_provision_size[0] = data_size;
+  spdm_context->local_context->local_cert_chain_provision[0] = data;
+  spdm_context->local_context->local_cert_chain_provision_size[0] = data_size;
   spdm_context->connection_info.local_used_cert_chain_buffer = data;
   spdm_context->connection_info.local_used_cert_chain_buffer_size = data_size;
-  spdm_context->local_context.slot_count = 1;
+  spdm_context->local_context->slot_count = 1;
   zero_mem (local_psk_hint, 32);
   copy_mem (&local_psk_hint[0], TEST_PSK_HINT_STRING, sizeof(TEST_PSK_HINT_STRING));
-  spdm_context->local_context.psk_hint_size = sizeof(TEST_PSK_HINT_STRING);
-  spdm_context->local_context.psk_hint = local_psk_hint;
+  spdm_context->local_context->psk_hint_size = sizeof(TEST_PSK_HINT_STRING);
+  spdm_context->local_context->psk_hint = local_psk_hint;
 
-  m_spdm_psk_exchange_request.psk_hint_length = (uint16)spdm_context->local_context.psk_hint_size;
+  m_spdm_psk_exchange_request.psk_hint_length = (uint16)spdm_context->local_context->psk_hint_size;
   m_spdm_psk_exchange_request.requester_context_length = DEFAULT_CONTEXT_LENGTH;
   OpaquePskExchangeReqSize = spdm_get_opaque_data_supported_version_data_size (spdm_context);
   m_spdm_psk_exchange_request.opaque_length = (uint16)OpaquePskExchangeReqSize;
   m_spdm_psk_exchange_request.req_session_id = 0xFFFF;
   ptr = m_spdm_psk_exchange_request.psk_hint;
-  copy_mem (ptr, spdm_context->local_context.psk_hint, spdm_context->local_context.psk_hint_size);
+  copy_mem (ptr, spdm_context->local_context->psk_hint, spdm_context->local_context->psk_hint_size);
   ptr += m_spdm_psk_exchange_request.psk_hint_length;
   spdm_get_random_number (DEFAULT_CONTEXT_LENGTH, ptr);
   ptr += m_spdm_psk_exchange_request.requester_context_length;
   spdm_build_opaque_data_supported_version_data (spdm_context, &OpaquePskExchangeReqSize, ptr);
   ptr += OpaquePskExchangeReqSize;
 
+  spdm_test_respond_if_ready_allocate_request (spdm_context);
   spdm_context->last_spdm_request_size = m_spdm_psk_exchange_request_size;
   copy_mem (spdm_context->last_spdm_request, &m_spdm_psk_exchange_request, m_spdm_psk_exchange_request_size);
 
@@ -800,11 +827,11 @@ void test_spdm_responder_respond_if_ready_case8(void **state) {
 
   //state for the the original request (FINISH)
   spdm_context->connection_info.connection_state = SPDM_CONNECTION_STATE_AUTHENTICATED;
-  spdm_context->local_context.capability.flags = 0;
+  spdm_context->local_context->capability.flags = 0;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_PSK_CAP;
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_PSK_CAP;
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_KEY_EX_CAP;
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_HANDSHAKE_IN_THE_CLEAR_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_PSK_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_KEY_EX_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_HANDSHAKE_IN_THE_CLEAR_CAP;
   spdm_context->connection_info.algorithm.base_hash_algo = m_use_hash_algo;
   spdm_context->connection_info.algorithm.base_asym_algo = m_use_asym_algo;
   spdm_context->connection_info.algorithm.measurement_spec = m_use_measurement_spec;
@@ -815,23 +842,27 @@ void test_spdm_responder_respond_if_ready_case8(void **state) {
   spdm_context->connection_info.version.spdm_version[0].major_version = 1;
   spdm_context->connection_info.version.spdm_version[0].minor_version = 1;
   read_responder_public_certificate_chain (m_use_hash_algo, m_use_asym_algo, &data, &data_size, NULL, NULL);
-  spdm_context->local_context.local_cert_chain_provision[0] = data;
-  spdm_context->local_context.local_cert_chain_provision_size[0] = data_size;
+  spdm_context->local_context->local_cert_chain_provision[0] = data;
+  spdm_context->local_context->local_cert_chain_provision_size[0] = data_size;
   spdm_context->connection_info.local_used_cert_chain_buffer = data;
   spdm_context->connection_info.local_used_cert_chain_buffer_size = data_size;
-  spdm_context->local_context.slot_count = 1;
-  spdm_context->local_context.mut_auth_requested = 0;
+  spdm_context->local_context->slot_count = 1;
+  spdm_context->local_context->mut_auth_requested = 0;
   zero_mem (local_psk_hint, 32);
   copy_mem (&local_psk_hint[0], TEST_PSK_HINT_STRING, sizeof(TEST_PSK_HINT_STRING));
-  spdm_context->local_context.psk_hint_size = sizeof(TEST_PSK_HINT_STRING);
-  spdm_context->local_context.psk_hint = local_psk_hint;
+  spdm_context->local_context->psk_hint_size = sizeof(TEST_PSK_HINT_STRING);
+  spdm_context->local_context->psk_hint = local_psk_hint;
 
   session_id = 0xFFFFFFFF;
   spdm_context->latest_session_id = session_id;
   spdm_context->last_spdm_request_session_id_valid = TRUE;
   spdm_context->last_spdm_request_session_id = session_id;
   session_info = &spdm_context->session_info[0];
-  spdm_session_info_init (spdm_context, session_info, session_id, FALSE);
+  spdm_session_info_init (spdm_context, session_info, session_id, TRUE);
+#if OPENSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT == 0
+  // message_k is empty, only seed the TH hash context with A.
+  spdm_append_message_k (spdm_context, session_info, FALSE, NULL, 0);
+#endif
   hash_size = spdm_get_hash_size (m_use_hash_algo);
   set_mem (dummy_buffer, hash_size, (uint8)(0xFF));
   spdm_secured_message_set_request_finished_key (session_info->secured_message_context, dummy_buffer, hash_size);
@@ -847,6 +878,7 @@ void test_spdm_responder_respond_if_ready_case8(void **state) {
   set_mem (request_finished_key, MAX_HASH_SIZE, (uint8)(0xFF));
   spdm_hmac_all (m_use_hash_algo, get_managed_buffer(&th_curr), get_managed_buffer_size(&th_curr), request_finished_key, hash_size, ptr);
 
+  spdm_test_respond_if_ready_allocate_request (spdm_context);
   spdm_context->last_spdm_request_size = sizeof(spdm_psk_finish_request_t) + hmac_size;
   copy_mem (spdm_context->last_spdm_request, &m_spdm_psk_finish_request, m_spdm_psk_finish_request_size);
 
@@ -890,12 +922,13 @@ void test_spdm_responder_respond_if_ready_case9(void **state) {
 
   //state for the the original request (GET_DIGESTS)
   spdm_context->connection_info.connection_state = SPDM_CONNECTION_STATE_NEGOTIATED; 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
   spdm_context->connection_info.algorithm.base_hash_algo = m_use_hash_algo;
-  spdm_context->local_context.local_cert_chain_provision[0] = m_local_certificate_chain;
-  spdm_context->local_context.local_cert_chain_provision_size[0] = MAX_SPDM_MESSAGE_BUFFER_SIZE;
+  spdm_context->local_context->local_cert_chain_provision[0] = m_local_certificate_chain;
+  spdm_context->local_context->local_cert_chain_provision_size[0] = MAX_SPDM_MESSAGE_BUFFER_SIZE;
   set_mem (m_local_certificate_chain, MAX_SPDM_MESSAGE_BUFFER_SIZE, (uint8)(0xFF));
-  spdm_context->local_context.slot_count = 1;
+  spdm_context->local_context->slot_count = 1;
+  spdm_test_respond_if_ready_allocate_request (spdm_context);
   spdm_context->last_spdm_request_size = m_spdm_get_digest_request_size;
   copy_mem (spdm_context->last_spdm_request, &m_spdm_get_digest_request, m_spdm_get_digest_request_size);
 
@@ -939,12 +972,13 @@ void test_spdm_responder_respond_if_ready_case10(void **state) {
 
   //state for the the original request (GET_DIGESTS)
   spdm_context->connection_info.connection_state = SPDM_CONNECTION_STATE_NEGOTIATED; 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
   spdm_context->connection_info.algorithm.base_hash_algo = m_use_hash_algo;
-  spdm_context->local_context.local_cert_chain_provision[0] = m_local_certificate_chain;
-  spdm_context->local_context.local_cert_chain_provision_size[0] = MAX_SPDM_MESSAGE_BUFFER_SIZE;
+  spdm_context->local_context->local_cert_chain_provision[0] = m_local_certificate_chain;
+  spdm_context->local_context->local_cert_chain_provision_size[0] = MAX_SPDM_MESSAGE_BUFFER_SIZE;
   set_mem (m_local_certificate_chain, MAX_SPDM_MESSAGE_BUFFER_SIZE, (uint8)(0xFF));
-  spdm_context->local_context.slot_count = 1;
+  spdm_context->local_context->slot_count = 1;
+  spdm_test_respond_if_ready_allocate_request (spdm_context);
   spdm_context->last_spdm_request_size = m_spdm_get_digest_request_size;
   copy_mem (spdm_context->last_spdm_request, &m_spdm_get_digest_request, m_spdm_get_digest_request_size);
 
@@ -989,12 +1023,13 @@ void test_spdm_responder_respond_if_ready_case11(void **state) {
 
   //state for the the original request (GET_DIGESTS)
   spdm_context->connection_info.connection_state = SPDM_CONNECTION_STATE_NEGOTIATED; 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
   spdm_context->connection_info.algorithm.base_hash_algo = m_use_hash_algo;
-  spdm_context->local_context.local_cert_chain_provision[0] = m_local_certificate_chain;
-  spdm_context->local_context.local_cert_chain_provision_size[0] = MAX_SPDM_MESSAGE_BUFFER_SIZE;
+  spdm_context->local_context->local_cert_chain_provision[0] = m_local_certificate_chain;
+  spdm_context->local_context->local_cert_chain_provision_size[0] = MAX_SPDM_MESSAGE_BUFFER_SIZE;
   set_mem (m_local_certificate_chain, MAX_SPDM_MESSAGE_BUFFER_SIZE, (uint8)(0xFF));
-  spdm_context->local_context.slot_count = 1;
+  spdm_context->local_context->slot_count = 1;
+  spdm_test_respond_if_ready_allocate_request (spdm_context);
   spdm_context->last_spdm_request_size = m_spdm_get_digest_request_size;
   copy_mem (spdm_context->last_spdm_request, &m_spdm_get_digest_request, m_spdm_get_digest_request_size);
 
@@ -1040,12 +1075,13 @@ void test_spdm_responder_respond_if_ready_case12(void **state) {
 
   //state for the the original request (GET_DIGESTS)
   spdm_context->connection_info.connection_state = SPDM_CONNECTION_STATE_NEGOTIATED; 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
   spdm_context->connection_info.algorithm.base_hash_algo = m_use_hash_algo;
-  spdm_context->local_context.local_cert_chain_provision[0] = m_local_certificate_chain;
-  spdm_context->local_context.local_cert_chain_provision_size[0] = MAX_SPDM_MESSAGE_BUFFER_SIZE;
+  spdm_context->local_context->local_cert_chain_provision[0] = m_local_certificate_chain;
+  spdm_context->local_context->local_cert_chain_provision_size[0] = MAX_SPDM_MESSAGE_BUFFER_SIZE;
   set_mem (m_local_certificate_chain, MAX_SPDM_MESSAGE_BUFFER_SIZE, (uint8)(0xFF));
-  spdm_context->local_context.slot_count = 1;
+  spdm_context->local_context->slot_count = 1;
+  spdm_test_respond_if_ready_allocate_request (spdm_context);
   spdm_context->last_spdm_request_size = m_spdm_get_digest_request_size;
   copy_mem (spdm_context->last_spdm_request, &m_spdm_get_digest_request, m_spdm_get_digest_request_size);
 
@@ -1093,12 +1129,13 @@ void test_spdm_responder_respond_if_ready_case13(void **state) {
 
   //state for the the original request (GET_DIGESTS)
   spdm_context->connection_info.connection_state = SPDM_CONNECTION_STATE_NEGOTIATED; 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
   spdm_context->connection_info.algorithm.base_hash_algo = m_use_hash_algo;
-  spdm_context->local_context.local_cert_chain_provision[0] = m_local_certificate_chain;
-  spdm_context->local_context.local_cert_chain_provision_size[0] = MAX_SPDM_MESSAGE_BUFFER_SIZE;
+  spdm_context->local_context->local_cert_chain_provision[0] = m_local_certificate_chain;
+  spdm_context->local_context->local_cert_chain_provision_size[0] = MAX_SPDM_MESSAGE_BUFFER_SIZE;
   set_mem (m_local_certificate_chain, MAX_SPDM_MESSAGE_BUFFER_SIZE, (uint8)(0xFF));
-  spdm_context->local_context.slot_count = 1;
+  spdm_context->local_context->slot_count = 1;
+  spdm_test_respond_if_ready_allocate_request (spdm_context);
   spdm_context->last_spdm_request_size = m_spdm_get_digest_request_size;
   copy_mem (spdm_context->last_spdm_request, &m_spdm_get_digest_request, m_spdm_get_digest_request_size);
 
@@ -1142,12 +1179,13 @@ void test_spdm_responder_respond_if_ready_case14(void **state) {
 
   //state for the the original request (GET_DIGESTS)
   spdm_context->connection_info.connection_state = SPDM_CONNECTION_STATE_NEGOTIATED; 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
   spdm_context->connection_info.algorithm.base_hash_algo = m_use_hash_algo;
-  spdm_context->local_context.local_cert_chain_provision[0] = m_local_certificate_chain;
-  spdm_context->local_context.local_cert_chain_provision_size[0] = MAX_SPDM_MESSAGE_BUFFER_SIZE;
+  spdm_context->local_context->local_cert_chain_provision[0] = m_local_certificate_chain;
+  spdm_context->local_context->local_cert_chain_provision_size[0] = MAX_SPDM_MESSAGE_BUFFER_SIZE;
   set_mem (m_local_certificate_chain, MAX_SPDM_MESSAGE_BUFFER_SIZE, (uint8)(0xFF));
-  spdm_context->local_context.slot_count = 1;
+  spdm_context->local_context->slot_count = 1;
+  spdm_test_respond_if_ready_allocate_request (spdm_context);
   spdm_context->last_spdm_request_size = m_spdm_get_digest_request_size;
   copy_mem (spdm_context->last_spdm_request, &m_spdm_get_digest_request, m_spdm_get_digest_request_size);
 
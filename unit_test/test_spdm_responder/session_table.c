@@ -0,0 +1,306 @@
+/**
+    Copyright Notice:
+    Copyright 2021 DMTF. All rights reserved.
+    License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+**/
+
+#include "spdm_unit_test.h"
+
+#define SESSION_TABLE_TEST_PATTERN 0xA5
+
+/**
+  Allocate and initialize an SPDM context with a session table of a given capacity.
+
+  The buffer is filled with SESSION_TABLE_TEST_PATTERN first, so that a test can
+  check which storage the initialization writes.
+
+  @param  max_session_count             The maximum number of concurrent sessions.
+
+  @return the SPDM context.
+**/
+spdm_context_t *spdm_session_table_test_new_context(IN uintn max_session_count)
+{
+	spdm_context_t *spdm_context;
+	uintn context_size;
+
+	context_size = spdm_get_context_size_ex(max_session_count);
+	spdm_context = malloc(context_size);
+	assert_non_null(spdm_context);
+	set_mem(spdm_context, context_size, SESSION_TABLE_TEST_PATTERN);
+	spdm_init_context_ex(spdm_context, max_session_count);
+	return spdm_context;
+}
+
+/**
+  Return TRUE if the secured message context of a session still holds the fill pattern.
+
+  @param  session_info                  A pointer to the SPDM session info.
+
+  @retval TRUE  the secured message context storage was never written.
+  @retval FALSE the secured message context storage was written.
+**/
+boolean spdm_session_table_test_is_untouched(IN spdm_session_info_t *session_info)
+{
+	uint8 *storage;
+	uintn index;
+
+	storage = session_info->secured_message_context;
+	for (index = 0; index < spdm_secured_message_get_context_size();
+	     index++) {
+		if (storage[index] != SESSION_TABLE_TEST_PATTERN) {
+			return FALSE;
+		}
+	}
+	return TRUE;
+}
+
+/**
+  Test 1: initialize a context with 5 sessions
+  Expected Behavior: the hash bucket count is rounded up to 8, all slots are in the free list,
+  and the session storage is not initialized until the slot is assigned.
+**/
+void test_spdm_responder_session_table_case1(void **state)
+{
+	spdm_context_t *spdm_context;
+	spdm_session_info_t *session_info;
+	uint32 index;
+
+	spdm_context = spdm_session_table_test_new_context(5);
+	assert_int_equal(spdm_context->max_session_count, 5);
+	assert_int_equal(spdm_context->session_hash_mask, 7);
+	for (index = 0; index <= spdm_context->session_hash_mask; index++) {
+		assert_int_equal(spdm_context->session_hash_bucket[index],
+				 INVALID_SESSION_INDEX);
+	}
+
+	//
+	// The free list links the slots in order.
+	//
+	assert_int_equal(spdm_context->free_session_index, 0);
+	for (index = 0; index < spdm_context->max_session_count; index++) {
+		session_info = &spdm_context->session_info[index];
+		assert_int_equal(session_info->session_id, INVALID_SESSION_ID);
+		assert_true(session_info->in_free_list);
+		assert_false(session_info->storage_initialized);
+		assert_true(spdm_session_table_test_is_untouched(session_info));
+		if (index + 1 < spdm_context->max_session_count) {
+			assert_int_equal(session_info->next_free_index,
+					 index + 1);
+		} else {
+			assert_int_equal(session_info->next_free_index,
+					 INVALID_SESSION_INDEX);
+		}
+	}
+
+	//
+	// Assigning a session only initializes its own slot.
+	//
+	session_info = spdm_assign_session_id(spdm_context, 0xFFFEFFFE, FALSE);
+	assert_ptr_equal(session_info, &spdm_context->session_info[0]);
+	assert_true(session_info->storage_initialized);
+	assert_false(spdm_session_table_test_is_untouched(session_info));
+	for (index = 1; index < spdm_context->max_session_count; index++) {
+		assert_false(
+			spdm_context->session_info[index].storage_initialized);
+		assert_true(spdm_session_table_test_is_untouched(
+			&spdm_context->session_info[index]));
+	}
+
+	//
+	// Reset skips the slots that were never used.
+	//
+	spdm_reset_context(spdm_context);
+	assert_int_equal(spdm_context->session_info[0].session_id,
+			 INVALID_SESSION_ID);
+	for (index = 1; index < spdm_context->max_session_count; index++) {
+		assert_false(
+			spdm_context->session_info[index].storage_initialized);
+		assert_true(spdm_session_table_test_is_untouched(
+			&spdm_context->session_info[index]));
+	}
+
+	spdm_deinit_context(spdm_context);
+	free(spdm_context);
+}
+
+/**
+  Test 2: assign three session IDs that fall into the same hash bucket, then free the middle one
+  Expected Behavior: every session is found through the shared hash chain, and the freed session
+  is no longer found while the others still are.
+**/
+void test_spdm_responder_session_table_case2(void **state)
+{
+	spdm_context_t *spdm_context;
+	spdm_session_info_t *session_info[3];
+	uint32 session_id[3];
+	uint32 index;
+
+	spdm_context = spdm_session_table_test_new_context(4);
+	assert_int_equal(spdm_context->session_hash_mask, 3);
+
+	//
+	// (session_id ^ (session_id >> 16)) & 3 is 1 for all of them.
+	//
+	session_id[0] = 0x00000001;
+	session_id[1] = 0x00040005;
+	session_id[2] = 0x00050004;
+	for (index = 0; index < 3; index++) {
+		session_info[index] = spdm_assign_session_id(
+			spdm_context, session_id[index], FALSE);
+		assert_non_null(session_info[index]);
+	}
+	assert_ptr_not_equal(session_info[0], session_info[1]);
+	assert_ptr_not_equal(session_info[1], session_info[2]);
+
+	//
+	// The bucket heads the latest session, and the chain reaches the others.
+	//
+	assert_int_equal(spdm_context->session_hash_bucket[1],
+			 (uint32)(session_info[2] - spdm_context->session_info));
+	for (index = 0; index < 4; index++) {
+		if (index != 1) {
+			assert_int_equal(
+				spdm_context->session_hash_bucket[index],
+				INVALID_SESSION_INDEX);
+		}
+	}
+	for (index = 0; index < 3; index++) {
+		assert_ptr_equal(spdm_get_session_info_via_session_id(
+					 spdm_context, session_id[index]),
+				 session_info[index]);
+	}
+
+	assert_ptr_equal(spdm_free_session_id(spdm_context, session_id[1]),
+			 session_info[1]);
+	assert_null(spdm_get_session_info_via_session_id(spdm_context,
+							 session_id[1]));
+	assert_ptr_equal(spdm_get_session_info_via_session_id(spdm_context,
+							      session_id[0]),
+			 session_info[0]);
+	assert_ptr_equal(spdm_get_session_info_via_session_id(spdm_context,
+							      session_id[2]),
+			 session_info[2]);
+
+	//
+	// A session ID in another bucket is not found through this chain.
+	//
+	assert_null(spdm_get_session_info_via_session_id(spdm_context,
+							 0x00000002));
+
+	spdm_deinit_context(spdm_context);
+	free(spdm_context);
+}
+
+/**
+  Test 3: fill a table of 3 sessions, free one and assign again
+  Expected Behavior: assignment fails when the table is full, the freed slot is reused first,
+  and the session ID halves are allocated from the head of the free list.
+**/
+void test_spdm_responder_session_table_case3(void **state)
+{
+	spdm_context_t *spdm_context;
+	spdm_session_info_t *session_info;
+	uint32 index;
+
+	spdm_context = spdm_session_table_test_new_context(3);
+
+	for (index = 0; index < 3; index++) {
+		assert_int_equal(spdm_allocate_rsp_session_id(spdm_context),
+				 0xFFFF - index);
+		assert_int_equal(spdm_allocate_req_session_id(spdm_context),
+				 0xFFFF - index);
+		session_info = spdm_assign_session_id(
+			spdm_context, 0x10001000 + index, FALSE);
+		assert_ptr_equal(session_info,
+				 &spdm_context->session_info[index]);
+		assert_false(session_info->in_free_list);
+	}
+	assert_int_equal(spdm_context->free_session_index,
+			 INVALID_SESSION_INDEX);
+
+	//
+	// The table is full.
+	//
+	assert_int_equal(spdm_allocate_rsp_session_id(spdm_context),
+			 INVALID_SESSION_ID & 0xFFFF);
+	assert_int_equal(spdm_allocate_req_session_id(spdm_context),
+			 (INVALID_SESSION_ID & 0xFFFF0000) >> 16);
+	assert_null(spdm_assign_session_id(spdm_context, 0x20002000, FALSE));
+
+	//
+	// The freed slot goes back to the head of the free list.
+	//
+	spdm_free_session_id(spdm_context, 0x10001001);
+	assert_int_equal(spdm_context->free_session_index, 1);
+	assert_true(spdm_context->session_info[1].in_free_list);
+	assert_int_equal(spdm_allocate_rsp_session_id(spdm_context), 0xFFFE);
+	session_info = spdm_assign_session_id(spdm_context, 0x20002000, FALSE);
+	assert_ptr_equal(session_info, &spdm_context->session_info[1]);
+	assert_ptr_equal(spdm_get_session_info_via_session_id(spdm_context,
+							      0x20002000),
+			 session_info);
+	assert_null(spdm_get_session_info_via_session_id(spdm_context,
+							 0x10001001));
+
+	spdm_deinit_context(spdm_context);
+	free(spdm_context);
+}
+
+/**
+  Test 4: initialize a slot directly with spdm_session_info_init, as a caller restoring a session does
+  Expected Behavior: the slot is found by its session ID, and the free list skips it.
+**/
+void test_spdm_responder_session_table_case4(void **state)
+{
+	spdm_context_t *spdm_context;
+	spdm_session_info_t *session_info;
+
+	spdm_context = spdm_session_table_test_new_context(2);
+
+	spdm_session_info_init(spdm_context, &spdm_context->session_info[0],
+			       0x30003000, FALSE);
+	assert_true(spdm_context->session_info[0].storage_initialized);
+	assert_ptr_equal(spdm_get_session_info_via_session_id(spdm_context,
+							      0x30003000),
+			 &spdm_context->session_info[0]);
+
+	//
+	// Slot 0 is still at the head of the free list, but is dropped from it here.
+	//
+	assert_int_equal(spdm_allocate_rsp_session_id(spdm_context), 0xFFFE);
+	assert_false(spdm_context->session_info[0].in_free_list);
+	session_info = spdm_assign_session_id(spdm_context, 0x40004000, FALSE);
+	assert_ptr_equal(session_info, &spdm_context->session_info[1]);
+	assert_null(spdm_assign_session_id(spdm_context, 0x50005000, FALSE));
+
+	//
+	// Re-initializing a slot with another session ID moves it to the new hash chain.
+	//
+	spdm_session_info_init(spdm_context, &spdm_context->session_info[0],
+			       0x30013001, FALSE);
+	assert_null(spdm_get_session_info_via_session_id(spdm_context,
+							 0x30003000));
+	assert_ptr_equal(spdm_get_session_info_via_session_id(spdm_context,
+							      0x30013001),
+			 &spdm_context->session_info[0]);
+
+	spdm_deinit_context(spdm_context);
+	free(spdm_context);
+}
+
+int spdm_responder_session_table_test_main(void)
+{
+	const struct CMUnitTest spdm_responder_session_table_tests[] = {
+		// Hash bucket sizing, free list and lazy initialization
+		cmocka_unit_test(test_spdm_responder_session_table_case1),
+		// Hash chain with colliding session IDs
+		cmocka_unit_test(test_spdm_responder_session_table_case2),
+		// Full table and free list reuse
+		cmocka_unit_test(test_spdm_responder_session_table_case3),
+		// Slot initialized directly
+		cmocka_unit_test(test_spdm_responder_session_table_case4),
+	};
+
+	return cmocka_run_group_tests(spdm_responder_session_table_tests, NULL,
+				      NULL);
+}
@@ -0,0 +1,333 @@
+/**
+    Copyright Notice:
+    Copyright 2021 DMTF. All rights reserved.
+    License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+**/
+
+#include "spdm_unit_test.h"
+#include <spdm_responder_lib_internal.h>
+
+#if OPENSPDM_RESPONDER_STATISTICS_SUPPORT == 1
+
+#define SPDM_STATISTICS_TEST_TIME_STEP 100
+
+static spdm_get_version_request_t m_spdm_statistics_get_version_request = {
+	{
+		SPDM_MESSAGE_VERSION_10,
+		SPDM_GET_VERSION,
+	},
+};
+
+static spdm_get_digest_request_t m_spdm_statistics_get_digests_request = {
+	{
+		SPDM_MESSAGE_VERSION_10,
+		SPDM_GET_DIGESTS,
+	},
+};
+
+static spdm_responder_statistics_t m_spdm_statistics;
+
+static uint64 m_spdm_statistics_test_timestamp;
+
+/**
+  Return a timestamp that advances by SPDM_STATISTICS_TEST_TIME_STEP on each call.
+**/
+uint64 spdm_statistics_test_get_timestamp(void)
+{
+	m_spdm_statistics_test_timestamp += SPDM_STATISTICS_TEST_TIME_STEP;
+	return m_spdm_statistics_test_timestamp;
+}
+
+/**
+  Allocate and initialize an SPDM context for the statistics tests.
+
+  @return the SPDM context.
+**/
+static spdm_context_t *spdm_statistics_test_new_context(void)
+{
+	spdm_context_t *spdm_context;
+
+	spdm_context = malloc(spdm_get_context_size());
+	assert_non_null(spdm_context);
+	spdm_init_context(spdm_context);
+	spdm_register_transport_layer_func(spdm_context,
+					   spdm_transport_test_encode_message,
+					   spdm_transport_test_decode_message);
+	spdm_register_arena_func(spdm_context, &m_spdm_unit_test_arena,
+				 spdm_unit_test_arena_allocate,
+				 spdm_unit_test_arena_free);
+	return spdm_context;
+}
+
+/**
+  Process one request and build its response.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  request_size                  size in bytes of the SPDM request.
+  @param  request                       A pointer to the SPDM request.
+
+  @return the request_response_code of the SPDM response.
+**/
+static uint8 spdm_statistics_test_handle(IN spdm_context_t *spdm_context,
+					 IN uintn request_size,
+					 IN void *request)
+{
+	return_status status;
+	uint8 message[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+	uintn message_size;
+	uint32 *session_id;
+	boolean is_app_message;
+
+	message_size = sizeof(message);
+	status = spdm_transport_test_encode_message(spdm_context, NULL, FALSE,
+						    TRUE, request_size, request,
+						    &message_size, message);
+	assert_int_equal(status, RETURN_SUCCESS);
+	status = spdm_process_request(spdm_context, &session_id,
+				      &is_app_message, message_size, message);
+	assert_int_equal(status, RETURN_SUCCESS);
+
+	message_size = sizeof(message);
+	status = spdm_build_response(spdm_context, session_id, is_app_message,
+				     &message_size, message);
+	assert_int_equal(status, RETURN_SUCCESS);
+	return message[sizeof(test_message_header_t) + 1];
+}
+
+/**
+  Read the responder statistics.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+**/
+static void spdm_statistics_test_get(IN spdm_context_t *spdm_context)
+{
+	spdm_data_parameter_t parameter;
+	uintn data_size;
+
+	zero_mem(&parameter, sizeof(parameter));
+	parameter.location = SPDM_DATA_LOCATION_LOCAL;
+	data_size = sizeof(m_spdm_statistics);
+	assert_int_equal(spdm_get_data(spdm_context,
+				       SPDM_DATA_RESPONDER_STATISTICS,
+				       &parameter, &m_spdm_statistics,
+				       &data_size),
+			 RETURN_SUCCESS);
+	assert_int_equal(data_size, sizeof(m_spdm_statistics));
+}
+
+/**
+  Test 1: handle GET_VERSION, then GET_DIGESTS without CERT_CAP
+  Expected Behavior: each request code counts one invocation, the GET_DIGESTS error response
+  is counted by its error code, and the handler and encode time of each request are recorded
+  once, with the time histogram bucket of the sample.
+**/
+void test_spdm_responder_statistics_case1(void **state)
+{
+	spdm_context_t *spdm_context;
+	spdm_responder_request_statistics_t *request_statistics;
+	uint8 response_code;
+
+	spdm_context = spdm_statistics_test_new_context();
+	m_spdm_statistics_test_timestamp = 0;
+	spdm_register_get_timestamp_func(spdm_context,
+					 spdm_statistics_test_get_timestamp);
+
+	response_code = spdm_statistics_test_handle(
+		spdm_context, sizeof(m_spdm_statistics_get_version_request),
+		&m_spdm_statistics_get_version_request);
+	assert_int_equal(response_code, SPDM_VERSION);
+	response_code = spdm_statistics_test_handle(
+		spdm_context, sizeof(m_spdm_statistics_get_digests_request),
+		&m_spdm_statistics_get_digests_request);
+	assert_int_equal(response_code, SPDM_ERROR);
+
+	spdm_statistics_test_get(spdm_context);
+	request_statistics = &m_spdm_statistics.request
+		[spdm_get_statistics_request_code_index(SPDM_GET_VERSION)];
+	assert_int_equal(request_statistics->invocation_count, 1);
+	assert_int_equal(request_statistics->error_response_count
+				 [SPDM_ERROR_CODE_UNSUPPORTED_REQUEST],
+			 0);
+	assert_int_equal(request_statistics->handler_time.count, 1);
+	assert_int_equal(request_statistics->handler_time.total_time,
+			 SPDM_STATISTICS_TEST_TIME_STEP);
+	assert_int_equal(request_statistics->handler_time.min_time,
+			 SPDM_STATISTICS_TEST_TIME_STEP);
+	assert_int_equal(request_statistics->handler_time.max_time,
+			 SPDM_STATISTICS_TEST_TIME_STEP);
+	// 64 <= 100 < 256
+	assert_int_equal(request_statistics->handler_time.histogram[2], 1);
+	assert_int_equal(request_statistics->encode_time.count, 1);
+	assert_int_equal(request_statistics->encode_time.total_time,
+			 SPDM_STATISTICS_TEST_TIME_STEP);
+	assert_int_equal(request_statistics->sign_time.count, 0);
+
+	request_statistics = &m_spdm_statistics.request
+		[spdm_get_statistics_request_code_index(SPDM_GET_DIGESTS)];
+	assert_int_equal(request_statistics->invocation_count, 1);
+	assert_int_equal(request_statistics->error_response_count
+				 [SPDM_ERROR_CODE_UNSUPPORTED_REQUEST],
+			 1);
+	assert_int_equal(request_statistics->handler_time.count, 1);
+	assert_int_equal(request_statistics->encode_time.count, 1);
+
+	assert_int_equal(
+		m_spdm_statistics
+			.request[spdm_get_statistics_request_code_index(
+				SPDM_GET_CAPABILITIES)]
+			.invocation_count,
+		0);
+
+	spdm_deinit_context(spdm_context);
+	free(spdm_context);
+}
+
+/**
+  Test 2: handle requests without a timestamp function, then reset the statistics
+  Expected Behavior: the invocations are counted but no time is recorded. Setting a zeroed
+  struct clears the statistics, and a struct of another size or a non-local location is rejected.
+**/
+void test_spdm_responder_statistics_case2(void **state)
+{
+	spdm_context_t *spdm_context;
+	spdm_responder_request_statistics_t *request_statistics;
+	spdm_data_parameter_t parameter;
+
+	spdm_context = spdm_statistics_test_new_context();
+
+	spdm_statistics_test_handle(spdm_context,
+				    sizeof(m_spdm_statistics_get_version_request),
+				    &m_spdm_statistics_get_version_request);
+	spdm_statistics_test_handle(spdm_context,
+				    sizeof(m_spdm_statistics_get_version_request),
+				    &m_spdm_statistics_get_version_request);
+
+	spdm_statistics_test_get(spdm_context);
+	request_statistics = &m_spdm_statistics.request
+		[spdm_get_statistics_request_code_index(SPDM_GET_VERSION)];
+	assert_int_equal(request_statistics->invocation_count, 2);
+	assert_int_equal(request_statistics->handler_time.count, 0);
+	assert_int_equal(request_statistics->encode_time.count, 0);
+
+	zero_mem(&parameter, sizeof(parameter));
+	parameter.location = SPDM_DATA_LOCATION_LOCAL;
+	zero_mem(&m_spdm_statistics, sizeof(m_spdm_statistics));
+	assert_int_equal(spdm_set_data(spdm_context,
+				       SPDM_DATA_RESPONDER_STATISTICS,
+				       &parameter, &m_spdm_statistics,
+				       sizeof(m_spdm_statistics) - 1),
+			 RETURN_INVALID_PARAMETER);
+	parameter.location = SPDM_DATA_LOCATION_CONNECTION;
+	assert_int_equal(spdm_set_data(spdm_context,
+				       SPDM_DATA_RESPONDER_STATISTICS,
+				       &parameter, &m_spdm_statistics,
+				       sizeof(m_spdm_statistics)),
+			 RETURN_INVALID_PARAMETER);
+	parameter.location = SPDM_DATA_LOCATION_LOCAL;
+	assert_int_equal(spdm_set_data(spdm_context,
+				       SPDM_DATA_RESPONDER_STATISTICS,
+				       &parameter, &m_spdm_statistics,
+				       sizeof(m_spdm_statistics)),
+			 RETURN_SUCCESS);
+
+	set_mem(&m_spdm_statistics, sizeof(m_spdm_statistics), 0xFF);
+	spdm_statistics_test_get(spdm_context);
+	assert_int_equal(m_spdm_statistics
+				 .request[spdm_get_statistics_request_code_index(
+					 SPDM_GET_VERSION)]
+				 .invocation_count,
+			 0);
+
+	spdm_deinit_context(spdm_context);
+	free(spdm_context);
+}
+
+/**
+  Test 3: record time samples at the bucket boundaries
+  Expected Behavior: bucket N counts the samples below (16 << (2 * N)), the last bucket counts
+  all the larger samples, and count/total/min/max follow the samples.
+**/
+void test_spdm_responder_statistics_case3(void **state)
+{
+	spdm_statistics_time_t time_statistics;
+
+	zero_mem(&time_statistics, sizeof(time_statistics));
+	spdm_statistics_record_time(&time_statistics, 15);
+	spdm_statistics_record_time(&time_statistics, 16);
+	spdm_statistics_record_time(&time_statistics, 63);
+	spdm_statistics_record_time(&time_statistics, 64);
+	spdm_statistics_record_time(&time_statistics,
+				    (uint64)16 << (2 * 6));
+	spdm_statistics_record_time(&time_statistics, 0x100000000ull);
+
+	assert_int_equal(time_statistics.histogram[0], 1);
+	assert_int_equal(time_statistics.histogram[1], 2);
+	assert_int_equal(time_statistics.histogram[2], 1);
+	assert_int_equal(time_statistics.histogram[6], 0);
+	assert_int_equal(time_statistics
+				 .histogram[SPDM_STATISTICS_HISTOGRAM_BUCKET_COUNT - 1],
+			 2);
+	assert_int_equal(time_statistics.count, 6);
+	assert_int_equal(time_statistics.min_time, 15);
+	assert_int_equal(time_statistics.max_time, 0x100000000ull);
+	assert_int_equal(time_statistics.total_time,
+			 15 + 16 + 63 + 64 + ((uint64)16 << (2 * 6)) +
+				 0x100000000ull);
+}
+
+/**
+  Test 4: map request codes to the request statistics index
+  Expected Behavior: each request code of SPDM 1.1 has its own index, and any other code
+  uses SPDM_STATISTICS_REQUEST_CODE_INDEX_OTHER.
+**/
+void test_spdm_responder_statistics_case4(void **state)
+{
+	boolean index_used[SPDM_STATISTICS_REQUEST_CODE_COUNT];
+	uintn request_code;
+	uintn index;
+	uintn known_count;
+
+	zero_mem(index_used, sizeof(index_used));
+	known_count = 0;
+	for (request_code = 0; request_code <= 0xFF; request_code++) {
+		index = spdm_get_statistics_request_code_index(
+			(uint8)request_code);
+		assert_true(index < SPDM_STATISTICS_REQUEST_CODE_COUNT);
+		if (index == SPDM_STATISTICS_REQUEST_CODE_INDEX_OTHER) {
+			continue;
+		}
+		assert_false(index_used[index]);
+		index_used[index] = TRUE;
+		known_count++;
+	}
+	assert_int_equal(known_count, SPDM_STATISTICS_REQUEST_CODE_INDEX_OTHER);
+	assert_int_equal(spdm_get_statistics_request_code_index(
+				 SPDM_GET_VERSION & 0x7F),
+			 SPDM_STATISTICS_REQUEST_CODE_INDEX_OTHER);
+	assert_int_not_equal(spdm_get_statistics_request_code_index(
+				     SPDM_RESPOND_IF_READY),
+			     SPDM_STATISTICS_REQUEST_CODE_INDEX_OTHER);
+}
+
+#endif
+
+int spdm_responder_statistics_test_main(void)
+{
+#if OPENSPDM_RESPONDER_STATISTICS_SUPPORT == 1
+	const struct CMUnitTest spdm_responder_statistics_tests[] = {
+		// Invocation, error response and time statistics
+		cmocka_unit_test(test_spdm_responder_statistics_case1),
+		// No timestamp function, and statistics reset
+		cmocka_unit_test(test_spdm_responder_statistics_case2),
+		// Time histogram buckets
+		cmocka_unit_test(test_spdm_responder_statistics_case3),
+		// Request code to statistics index
+		cmocka_unit_test(test_spdm_responder_statistics_case4),
+	};
+
+	return cmocka_run_group_tests(spdm_responder_statistics_tests, NULL,
+				      NULL);
+#else
+	return 0;
+#endif
+}
@@ -21,6 +21,11 @@ int spdm_responder_psk_exchange_test_main(void);
 int spdm_responder_psk_finish_test_main(void);
 int spdm_responder_heartbeat_test_main(void);
 int spdm_responder_end_session_test_main(void);
+int spdm_responder_private_key_cache_test_main(void);
+int spdm_responder_session_table_test_main(void);
+int spdm_responder_local_context_test_main(void);
+int spdm_responder_arena_test_main(void);
+int spdm_responder_statistics_test_main(void);
 
 int main(void)
 {
@@ -82,5 +87,25 @@ int main(void)
 		return_value = 1;
 	}
 
+	if (spdm_responder_private_key_cache_test_main() != 0) {
+		return_value = 1;
+	}
+
+	if (spdm_responder_session_table_test_main() != 0) {
+		return_value = 1;
+	}
+
+	if (spdm_responder_local_context_test_main() != 0) {
+		return_value = 1;
+	}
+
+	if (spdm_responder_arena_test_main() != 0) {
+		return_value = 1;
+	}
+
+	if (spdm_responder_statistics_test_main() != 0) {
+		return_value = 1;
+	}
+
 	return return_value;
 }
@@ -0,0 +1,273 @@
+/**
+    Copyright Notice:
+    Copyright 2021 DMTF. All rights reserved.
+    License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+**/
+
+#include "spdm_secured_message_test.h"
+
+/**
+  Test 1: a batch encodes and decodes like the same records one by one.
+  Expected behavior: each batch record equals the single record with the same sequence number.
+**/
+void test_spdm_secured_message_batch_case1(void **state)
+{
+	return_status status;
+	spdm_test_context_t *spdm_test_context;
+	spdm_context_t *spdm_context;
+	spdm_secured_message_context_t *secured_message_context;
+	uint8 app_message[SECURED_MESSAGE_TEST_BATCH_COUNT]
+			 [SECURED_MESSAGE_TEST_APP_MESSAGE_SIZE];
+	uintn app_message_size[SECURED_MESSAGE_TEST_BATCH_COUNT];
+	void *app_message_ptr[SECURED_MESSAGE_TEST_BATCH_COUNT];
+	uint8 secured_message[SECURED_MESSAGE_TEST_BATCH_COUNT]
+			     [MAX_SPDM_MESSAGE_BUFFER_SIZE];
+	uintn secured_message_size[SECURED_MESSAGE_TEST_BATCH_COUNT];
+	void *secured_message_ptr[SECURED_MESSAGE_TEST_BATCH_COUNT];
+	uint8 single_message[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+	uintn single_message_size;
+	uint8 decoded_message[SECURED_MESSAGE_TEST_BATCH_COUNT]
+			     [SECURED_MESSAGE_TEST_APP_MESSAGE_SIZE];
+	uintn decoded_message_size[SECURED_MESSAGE_TEST_BATCH_COUNT];
+	void *decoded_message_ptr[SECURED_MESSAGE_TEST_BATCH_COUNT];
+	uintn index;
+
+	spdm_test_context = *state;
+	spdm_context = spdm_test_context->spdm_context;
+	spdm_test_context->case_id = 0x1;
+
+	secured_message_context = spdm_secured_message_test_setup_session(
+		spdm_context, SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP |
+				      SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP);
+	for (index = 0; index < SECURED_MESSAGE_TEST_BATCH_COUNT; index++) {
+		set_mem(app_message[index], sizeof(app_message[index]),
+			(uint8)(0x10 + index));
+		app_message_size[index] = sizeof(app_message[index]) - index;
+		app_message_ptr[index] = app_message[index];
+		secured_message_size[index] = sizeof(secured_message[index]);
+		secured_message_ptr[index] = secured_message[index];
+		decoded_message_size[index] = sizeof(decoded_message[index]);
+		decoded_message_ptr[index] = decoded_message[index];
+	}
+
+	status = spdm_encode_secured_messages(
+		secured_message_context, SECURED_MESSAGE_TEST_SESSION_ID, TRUE,
+		SECURED_MESSAGE_TEST_BATCH_COUNT, app_message_size,
+		app_message_ptr, secured_message_size, secured_message_ptr,
+		&m_secured_message_test_callbacks);
+	assert_int_equal(status, RETURN_SUCCESS);
+	assert_int_equal(secured_message_context->application_secret
+				 .request_data_sequence_number,
+			 SECURED_MESSAGE_TEST_BATCH_COUNT);
+
+	secured_message_context->application_secret
+		.request_data_sequence_number = 0;
+	for (index = 0; index < SECURED_MESSAGE_TEST_BATCH_COUNT; index++) {
+		single_message_size = sizeof(single_message);
+		status = spdm_encode_secured_message(
+			secured_message_context,
+			SECURED_MESSAGE_TEST_SESSION_ID, TRUE,
+			app_message_size[index], app_message[index],
+			&single_message_size, single_message,
+			&m_secured_message_test_callbacks);
+		assert_int_equal(status, RETURN_SUCCESS);
+		assert_int_equal(single_message_size,
+				 secured_message_size[index]);
+		assert_memory_equal(single_message, secured_message[index],
+				    single_message_size);
+	}
+
+	secured_message_context->application_secret
+		.request_data_sequence_number = 0;
+	status = spdm_decode_secured_messages(
+		secured_message_context, SECURED_MESSAGE_TEST_SESSION_ID, TRUE,
+		SECURED_MESSAGE_TEST_BATCH_COUNT, secured_message_size,
+		secured_message_ptr, decoded_message_size, decoded_message_ptr,
+		&m_secured_message_test_callbacks);
+	assert_int_equal(status, RETURN_SUCCESS);
+	for (index = 0; index < SECURED_MESSAGE_TEST_BATCH_COUNT; index++) {
+		assert_int_equal(decoded_message_size[index],
+				 app_message_size[index]);
+		assert_memory_equal(decoded_message[index], app_message[index],
+				    app_message_size[index]);
+	}
+	assert_int_equal(secured_message_context->application_secret
+				 .request_data_sequence_number,
+			 SECURED_MESSAGE_TEST_BATCH_COUNT);
+}
+
+/**
+  Test 2: a batch with a tampered record in the middle.
+  Expected behavior: the records before it are decoded, the call fails with RETURN_SECURITY_VIOLATION and the records after it are untouched.
+**/
+void test_spdm_secured_message_batch_case2(void **state)
+{
+	return_status status;
+	spdm_test_context_t *spdm_test_context;
+	spdm_context_t *spdm_context;
+	spdm_secured_message_context_t *secured_message_context;
+	uint8 app_message[SECURED_MESSAGE_TEST_BATCH_COUNT]
+			 [SECURED_MESSAGE_TEST_APP_MESSAGE_SIZE];
+	uintn app_message_size[SECURED_MESSAGE_TEST_BATCH_COUNT];
+	void *app_message_ptr[SECURED_MESSAGE_TEST_BATCH_COUNT];
+	uint8 secured_message[SECURED_MESSAGE_TEST_BATCH_COUNT]
+			     [MAX_SPDM_MESSAGE_BUFFER_SIZE];
+	uintn secured_message_size[SECURED_MESSAGE_TEST_BATCH_COUNT];
+	void *secured_message_ptr[SECURED_MESSAGE_TEST_BATCH_COUNT];
+	uint8 decoded_message[SECURED_MESSAGE_TEST_BATCH_COUNT]
+			     [SECURED_MESSAGE_TEST_APP_MESSAGE_SIZE];
+	uintn decoded_message_size[SECURED_MESSAGE_TEST_BATCH_COUNT];
+	void *decoded_message_ptr[SECURED_MESSAGE_TEST_BATCH_COUNT];
+	spdm_error_struct_t spdm_error;
+	uintn index;
+
+	spdm_test_context = *state;
+	spdm_context = spdm_test_context->spdm_context;
+	spdm_test_context->case_id = 0x2;
+
+	secured_message_context = spdm_secured_message_test_setup_session(
+		spdm_context, SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP |
+				      SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP);
+	for (index = 0; index < SECURED_MESSAGE_TEST_BATCH_COUNT; index++) {
+		set_mem(app_message[index], sizeof(app_message[index]),
+			(uint8)(0x20 + index));
+		app_message_size[index] = sizeof(app_message[index]);
+		app_message_ptr[index] = app_message[index];
+		secured_message_size[index] = sizeof(secured_message[index]);
+		secured_message_ptr[index] = secured_message[index];
+		decoded_message_size[index] = sizeof(decoded_message[index]);
+		decoded_message_ptr[index] = decoded_message[index];
+	}
+	zero_mem(decoded_message, sizeof(decoded_message));
+
+	status = spdm_encode_secured_messages(
+		secured_message_context, SECURED_MESSAGE_TEST_SESSION_ID, TRUE,
+		SECURED_MESSAGE_TEST_BATCH_COUNT, app_message_size,
+		app_message_ptr, secured_message_size, secured_message_ptr,
+		&m_secured_message_test_callbacks);
+	assert_int_equal(status, RETURN_SUCCESS);
+
+	secured_message[1][secured_message_size[1] - 1] ^= 0x01;
+
+	secured_message_context->application_secret
+		.request_data_sequence_number = 0;
+	status = spdm_decode_secured_messages(
+		secured_message_context, SECURED_MESSAGE_TEST_SESSION_ID, TRUE,
+		SECURED_MESSAGE_TEST_BATCH_COUNT, secured_message_size,
+		secured_message_ptr, decoded_message_size, decoded_message_ptr,
+		&m_secured_message_test_callbacks);
+	assert_int_equal(status, RETURN_SECURITY_VIOLATION);
+	spdm_secured_message_get_last_spdm_error_struct(secured_message_context,
+							&spdm_error);
+	assert_int_equal(spdm_error.error_code, SPDM_ERROR_CODE_DECRYPT_ERROR);
+
+	assert_int_equal(decoded_message_size[0], app_message_size[0]);
+	assert_memory_equal(decoded_message[0], app_message[0],
+			    app_message_size[0]);
+	assert_int_equal(decoded_message_size[2], sizeof(decoded_message[2]));
+	for (index = 0; index < sizeof(decoded_message[2]); index++) {
+		assert_int_equal(decoded_message[2][index], 0);
+	}
+	// The sequence numbers of the decoded record and the failed record are consumed.
+	assert_int_equal(secured_message_context->application_secret
+				 .request_data_sequence_number,
+			 2);
+}
+
+/**
+  Test 3: short buffers are reported without writing past them.
+  Expected behavior: RETURN_BUFFER_TOO_SMALL with the required size, without consuming a sequence number.
+**/
+void test_spdm_secured_message_batch_case3(void **state)
+{
+	return_status status;
+	spdm_test_context_t *spdm_test_context;
+	spdm_context_t *spdm_context;
+	spdm_secured_message_context_t *secured_message_context;
+	uint8 app_message[SECURED_MESSAGE_TEST_APP_MESSAGE_SIZE];
+	uintn app_message_size;
+	void *app_message_ptr;
+	uint8 secured_message[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+	void *secured_message_ptr;
+	uintn secured_message_size;
+	uint8 decoded_message[SECURED_MESSAGE_TEST_APP_MESSAGE_SIZE];
+	void *decoded_message_ptr;
+	uintn decoded_message_size;
+	uintn headroom;
+	uintn tailroom;
+
+	spdm_test_context = *state;
+	spdm_context = spdm_test_context->spdm_context;
+	spdm_test_context->case_id = 0x3;
+
+	secured_message_context = spdm_secured_message_test_setup_session(
+		spdm_context, SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP |
+				      SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP);
+	set_mem(app_message, sizeof(app_message), (uint8)(0x33));
+	headroom = spdm_secured_message_get_headroom(
+		secured_message_context, &m_secured_message_test_callbacks);
+	tailroom = spdm_secured_message_get_tailroom(
+		secured_message_context, &m_secured_message_test_callbacks);
+
+	// The secured message buffer cannot hold the application message.
+	app_message_size = sizeof(app_message);
+	app_message_ptr = app_message;
+	secured_message_ptr = secured_message;
+	secured_message_size = headroom + sizeof(app_message) - 1;
+	status = spdm_encode_secured_messages(
+		secured_message_context, SECURED_MESSAGE_TEST_SESSION_ID, TRUE, 1,
+		&app_message_size, &app_message_ptr,
+		&secured_message_size, &secured_message_ptr,
+		&m_secured_message_test_callbacks);
+	assert_int_equal(status, RETURN_BUFFER_TOO_SMALL);
+	assert_int_equal(secured_message_size,
+			 headroom + sizeof(app_message) + tailroom);
+	assert_int_equal(secured_message_context->application_secret
+				 .request_data_sequence_number,
+			 0);
+
+	status = spdm_encode_secured_messages(
+		secured_message_context, SECURED_MESSAGE_TEST_SESSION_ID, TRUE, 1,
+		&app_message_size, &app_message_ptr,
+		&secured_message_size, &secured_message_ptr,
+		&m_secured_message_test_callbacks);
+	assert_int_equal(status, RETURN_SUCCESS);
+
+	// The application message buffer is too small.
+	secured_message_context->application_secret
+		.request_data_sequence_number = 0;
+	decoded_message_ptr = decoded_message;
+	decoded_message_size = sizeof(decoded_message) - 1;
+	status = spdm_decode_secured_messages(
+		secured_message_context, SECURED_MESSAGE_TEST_SESSION_ID, TRUE, 1,
+		&secured_message_size, &secured_message_ptr,
+		&decoded_message_size, &decoded_message_ptr,
+		&m_secured_message_test_callbacks);
+	assert_int_equal(status, RETURN_BUFFER_TOO_SMALL);
+	assert_int_equal(decoded_message_size, sizeof(app_message));
+}
+
+spdm_test_context_t m_spdm_secured_message_batch_test_context = {
+	SPDM_TEST_CONTEXT_SIGNATURE,
+	TRUE,
+	spdm_secured_message_test_send_message,
+	spdm_secured_message_test_receive_message,
+};
+
+int spdm_secured_message_batch_test_main(void)
+{
+	const struct CMUnitTest spdm_secured_message_batch_tests[] = {
+		// Batch equals single records
+		cmocka_unit_test(test_spdm_secured_message_batch_case1),
+		// Batch with a tampered middle record
+		cmocka_unit_test(test_spdm_secured_message_batch_case2),
+		// Short buffers
+		cmocka_unit_test(test_spdm_secured_message_batch_case3),
+	};
+
+	setup_spdm_test_context(&m_spdm_secured_message_batch_test_context);
+
+	return cmocka_run_group_tests(spdm_secured_message_batch_tests,
+				      spdm_unit_test_group_setup,
+				      spdm_unit_test_group_teardown);
+}
@@ -0,0 +1,426 @@
+/**
+    Copyright Notice:
+    Copyright 2021 DMTF. All rights reserved.
+    License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+**/
+
+#include "spdm_secured_message_test.h"
+
+/**
+  Decode a secured message through the copy and the in-place paths and check
+  that both recover the application message, the in-place one inside the
+  receive buffer.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  capability_flags              The ENCRYPT_CAP and MAC_CAP flags of the session.
+**/
+static void spdm_secured_message_test_decode(IN spdm_context_t *spdm_context,
+					     IN uint32 capability_flags)
+{
+	return_status status;
+	spdm_secured_message_context_t *secured_message_context;
+	uint8 app_message[SECURED_MESSAGE_TEST_APP_MESSAGE_SIZE];
+	uint8 secured_message[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+	uintn secured_message_size;
+	uint8 received_message[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+	uint8 decoded_message[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+	uintn decoded_message_size;
+	void *decoded_app_message;
+	uintn headroom;
+	uintn index;
+
+	secured_message_context = spdm_secured_message_test_setup_session(
+		spdm_context, capability_flags);
+	for (index = 0; index < sizeof(app_message); index++) {
+		app_message[index] = (uint8)index;
+	}
+	headroom = spdm_secured_message_get_headroom(
+		secured_message_context, &m_secured_message_test_callbacks);
+
+	secured_message_size = sizeof(secured_message);
+	status = spdm_encode_secured_message(
+		secured_message_context, SECURED_MESSAGE_TEST_SESSION_ID, TRUE,
+		sizeof(app_message), app_message, &secured_message_size,
+		secured_message, &m_secured_message_test_callbacks);
+	assert_int_equal(status, RETURN_SUCCESS);
+	copy_mem(received_message, secured_message, secured_message_size);
+
+	// Decode through the copy path. The secured message is left intact.
+	secured_message_context->application_secret
+		.request_data_sequence_number = 0;
+	decoded_message_size = sizeof(decoded_message);
+	status = spdm_decode_secured_message(
+		secured_message_context, SECURED_MESSAGE_TEST_SESSION_ID, TRUE,
+		secured_message_size, secured_message, &decoded_message_size,
+		decoded_message, &m_secured_message_test_callbacks);
+	assert_int_equal(status, RETURN_SUCCESS);
+	assert_int_equal(decoded_message_size, sizeof(app_message));
+	assert_memory_equal(decoded_message, app_message, sizeof(app_message));
+	assert_memory_equal(secured_message, received_message,
+			    secured_message_size);
+
+	// Decode in place. The application message is returned inside the buffer.
+	secured_message_context->application_secret
+		.request_data_sequence_number = 0;
+	status = spdm_decode_secured_message_in_place(
+		secured_message_context, SECURED_MESSAGE_TEST_SESSION_ID, TRUE,
+		secured_message_size, received_message, &decoded_message_size,
+		&decoded_app_message, &m_secured_message_test_callbacks);
+	assert_int_equal(status, RETURN_SUCCESS);
+	assert_int_equal(decoded_message_size, sizeof(app_message));
+	assert_ptr_equal(decoded_app_message, received_message + headroom);
+	assert_memory_equal(decoded_app_message, app_message,
+			    sizeof(app_message));
+	assert_int_equal(secured_message_context->application_secret
+				 .request_data_sequence_number,
+			 1);
+
+	// A request record does not decode in place with the response key.
+	copy_mem(received_message, secured_message, secured_message_size);
+	status = spdm_decode_secured_message_in_place(
+		secured_message_context, SECURED_MESSAGE_TEST_SESSION_ID, FALSE,
+		secured_message_size, received_message, &decoded_message_size,
+		&decoded_app_message, &m_secured_message_test_callbacks);
+	assert_int_equal(status, RETURN_SECURITY_VIOLATION);
+}
+
+/**
+  Test 1: in-place and copy decode of an ENC_MAC session.
+  Expected behavior: both decoders recover the application message, the in-place decoder inside the receive buffer.
+**/
+void test_spdm_secured_message_decode_case1(void **state)
+{
+	spdm_test_context_t *spdm_test_context;
+	spdm_context_t *spdm_context;
+
+	spdm_test_context = *state;
+	spdm_context = spdm_test_context->spdm_context;
+	spdm_test_context->case_id = 0x1;
+
+	spdm_secured_message_test_decode(
+		spdm_context, SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP |
+				      SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP);
+}
+
+/**
+  Test 2: in-place and copy decode of a MAC_ONLY session.
+  Expected behavior: both decoders recover the application message, the in-place decoder inside the receive buffer.
+**/
+void test_spdm_secured_message_decode_case2(void **state)
+{
+	spdm_test_context_t *spdm_test_context;
+	spdm_context_t *spdm_context;
+
+	spdm_test_context = *state;
+	spdm_context = spdm_test_context->spdm_context;
+	spdm_test_context->case_id = 0x2;
+
+	spdm_secured_message_test_decode(
+		spdm_context, SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP);
+}
+
+/**
+  Test 3: a tampered or replayed secured message is rejected by both decoders.
+  Expected behavior: RETURN_SECURITY_VIOLATION with a DECRYPT_ERROR, and the sequence number is consumed.
+**/
+void test_spdm_secured_message_decode_case3(void **state)
+{
+	return_status status;
+	spdm_test_context_t *spdm_test_context;
+	spdm_context_t *spdm_context;
+	spdm_secured_message_context_t *secured_message_context;
+	uint8 app_message[SECURED_MESSAGE_TEST_APP_MESSAGE_SIZE];
+	uint8 secured_message[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+	uintn secured_message_size;
+	uint8 tampered_message[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+	uint8 decoded_message[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+	uintn decoded_message_size;
+	void *decoded_app_message;
+	spdm_error_struct_t spdm_error;
+	uintn headroom;
+
+	spdm_test_context = *state;
+	spdm_context = spdm_test_context->spdm_context;
+	spdm_test_context->case_id = 0x3;
+
+	secured_message_context = spdm_secured_message_test_setup_session(
+		spdm_context, SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP |
+				      SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP);
+	set_mem(app_message, sizeof(app_message), (uint8)(0x5A));
+	headroom = spdm_secured_message_get_headroom(
+		secured_message_context, &m_secured_message_test_callbacks);
+
+	secured_message_size = sizeof(secured_message);
+	status = spdm_encode_secured_message(
+		secured_message_context, SECURED_MESSAGE_TEST_SESSION_ID, TRUE,
+		sizeof(app_message), app_message, &secured_message_size,
+		secured_message, &m_secured_message_test_callbacks);
+	assert_int_equal(status, RETURN_SUCCESS);
+
+	// Flip one bit of the cipher text.
+	copy_mem(tampered_message, secured_message, secured_message_size);
+	tampered_message[headroom] ^= 0x01;
+	secured_message_context->application_secret
+		.request_data_sequence_number = 0;
+	status = spdm_decode_secured_message_in_place(
+		secured_message_context, SECURED_MESSAGE_TEST_SESSION_ID, TRUE,
+		secured_message_size, tampered_message, &decoded_message_size,
+		&decoded_app_message, &m_secured_message_test_callbacks);
+	assert_int_equal(status, RETURN_SECURITY_VIOLATION);
+	spdm_secured_message_get_last_spdm_error_struct(secured_message_context,
+							&spdm_error);
+	assert_int_equal(spdm_error.error_code, SPDM_ERROR_CODE_DECRYPT_ERROR);
+	assert_int_equal(spdm_error.session_id,
+			 SECURED_MESSAGE_TEST_SESSION_ID);
+	assert_int_equal(secured_message_context->application_secret
+				 .request_data_sequence_number,
+			 1);
+
+	// Flip one bit of the tag.
+	copy_mem(tampered_message, secured_message, secured_message_size);
+	tampered_message[secured_message_size - 1] ^= 0x80;
+	secured_message_context->application_secret
+		.request_data_sequence_number = 0;
+	decoded_message_size = sizeof(decoded_message);
+	status = spdm_decode_secured_message(
+		secured_message_context, SECURED_MESSAGE_TEST_SESSION_ID, TRUE,
+		secured_message_size, tampered_message, &decoded_message_size,
+		decoded_message, &m_secured_message_test_callbacks);
+	assert_int_equal(status, RETURN_SECURITY_VIOLATION);
+
+	// A different session ID in the record header.
+	copy_mem(tampered_message, secured_message, secured_message_size);
+	((spdm_secured_message_a_data_header1_t *)tampered_message)->session_id =
+		SECURED_MESSAGE_TEST_SESSION_ID - 1;
+	secured_message_context->application_secret
+		.request_data_sequence_number = 0;
+	status = spdm_decode_secured_message(
+		secured_message_context, SECURED_MESSAGE_TEST_SESSION_ID, TRUE,
+		secured_message_size, tampered_message, &decoded_message_size,
+		decoded_message, &m_secured_message_test_callbacks);
+	assert_int_equal(status, RETURN_SECURITY_VIOLATION);
+
+	// The untampered record decodes once and is rejected on replay.
+	secured_message_context->application_secret
+		.request_data_sequence_number = 0;
+	decoded_message_size = sizeof(decoded_message);
+	status = spdm_decode_secured_message(
+		secured_message_context, SECURED_MESSAGE_TEST_SESSION_ID, TRUE,
+		secured_message_size, secured_message, &decoded_message_size,
+		decoded_message, &m_secured_message_test_callbacks);
+	assert_int_equal(status, RETURN_SUCCESS);
+	assert_memory_equal(decoded_message, app_message, sizeof(app_message));
+	status = spdm_decode_secured_message(
+		secured_message_context, SECURED_MESSAGE_TEST_SESSION_ID, TRUE,
+		secured_message_size, secured_message, &decoded_message_size,
+		decoded_message, &m_secured_message_test_callbacks);
+	assert_int_equal(status, RETURN_SECURITY_VIOLATION);
+}
+
+/**
+  Test 4: a truncated secured message is rejected by the in-place decoder.
+  Expected behavior: RETURN_SECURITY_VIOLATION without reading past the record.
+**/
+void test_spdm_secured_message_decode_case4(void **state)
+{
+	return_status status;
+	spdm_test_context_t *spdm_test_context;
+	spdm_context_t *spdm_context;
+	spdm_secured_message_context_t *secured_message_context;
+	uint8 app_message[SECURED_MESSAGE_TEST_APP_MESSAGE_SIZE];
+	uint8 secured_message[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+	uintn secured_message_size;
+	uintn decoded_message_size;
+	void *decoded_app_message;
+	uintn headroom;
+
+	spdm_test_context = *state;
+	spdm_context = spdm_test_context->spdm_context;
+	spdm_test_context->case_id = 0x4;
+
+	secured_message_context = spdm_secured_message_test_setup_session(
+		spdm_context, SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP |
+				      SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP);
+	set_mem(app_message, sizeof(app_message), (uint8)(0x33));
+	headroom = spdm_secured_message_get_headroom(
+		secured_message_context, &m_secured_message_test_callbacks);
+
+	secured_message_size = sizeof(secured_message);
+	status = spdm_encode_secured_message(
+		secured_message_context, SECURED_MESSAGE_TEST_SESSION_ID, TRUE,
+		sizeof(app_message), app_message, &secured_message_size,
+		secured_message, &m_secured_message_test_callbacks);
+	assert_int_equal(status, RETURN_SUCCESS);
+
+	// A record shorter than its header and tag.
+	secured_message_context->application_secret
+		.request_data_sequence_number = 0;
+	status = spdm_decode_secured_message_in_place(
+		secured_message_context, SECURED_MESSAGE_TEST_SESSION_ID, TRUE,
+		headroom, secured_message, &decoded_message_size,
+		&decoded_app_message, &m_secured_message_test_callbacks);
+	assert_int_equal(status, RETURN_SECURITY_VIOLATION);
+
+	// A record truncated inside its cipher text.
+	secured_message_context->application_secret
+		.request_data_sequence_number = 0;
+	status = spdm_decode_secured_message_in_place(
+		secured_message_context, SECURED_MESSAGE_TEST_SESSION_ID, TRUE,
+		secured_message_size - 1, secured_message, &decoded_message_size,
+		&decoded_app_message, &m_secured_message_test_callbacks);
+	assert_int_equal(status, RETURN_SECURITY_VIOLATION);
+}
+
+/**
+  Test 5: an SPDM message in an MCTP transport buffer is decoded in place.
+  Expected behavior: the message round trips and a tampered transport message is rejected with DECRYPT_ERROR.
+**/
+void test_spdm_secured_message_decode_case5(void **state)
+{
+	return_status status;
+	spdm_test_context_t *spdm_test_context;
+	spdm_context_t *spdm_context;
+	spdm_secured_message_context_t *secured_message_context;
+	spdm_heartbeat_request_t spdm_request;
+	uint8 transport_message[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+	uintn transport_message_size;
+	uint8 tampered_message[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+	uint8 message[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+	uintn message_size;
+	uint32 session_id;
+	uint32 *decoded_session_id;
+	boolean is_app_message;
+	spdm_error_struct_t spdm_error;
+
+	spdm_test_context = *state;
+	spdm_context = spdm_test_context->spdm_context;
+	spdm_test_context->case_id = 0x5;
+
+	secured_message_context = spdm_secured_message_test_setup_session(
+		spdm_context, SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP |
+				      SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP);
+	spdm_request.header.spdm_version = SPDM_MESSAGE_VERSION_11;
+	spdm_request.header.request_response_code = SPDM_HEARTBEAT;
+	spdm_request.header.param1 = 0;
+	spdm_request.header.param2 = 0;
+
+	session_id = SECURED_MESSAGE_TEST_SESSION_ID;
+	transport_message_size = sizeof(transport_message);
+	status = spdm_transport_mctp_encode_message(
+		spdm_context, &session_id, FALSE, TRUE, sizeof(spdm_request),
+		&spdm_request, &transport_message_size, transport_message);
+	assert_int_equal(status, RETURN_SUCCESS);
+	copy_mem(tampered_message, transport_message, transport_message_size);
+
+	secured_message_context->application_secret
+		.request_data_sequence_number = 0;
+	message_size = sizeof(message);
+	status = spdm_transport_mctp_decode_message(
+		spdm_context, &decoded_session_id, &is_app_message, TRUE,
+		transport_message_size, transport_message, &message_size,
+		message);
+	assert_int_equal(status, RETURN_SUCCESS);
+	assert_non_null(decoded_session_id);
+	assert_int_equal(*decoded_session_id, SECURED_MESSAGE_TEST_SESSION_ID);
+	assert_false(is_app_message);
+	assert_int_equal(message_size, sizeof(spdm_request));
+	assert_memory_equal(message, &spdm_request, sizeof(spdm_request));
+
+	tampered_message[transport_message_size - 1] ^= 0x01;
+	secured_message_context->application_secret
+		.request_data_sequence_number = 0;
+	message_size = sizeof(message);
+	status = spdm_transport_mctp_decode_message(
+		spdm_context, &decoded_session_id, &is_app_message, TRUE,
+		transport_message_size, tampered_message, &message_size,
+		message);
+	assert_int_equal(status, RETURN_UNSUPPORTED);
+	spdm_get_last_spdm_error_struct(spdm_context, &spdm_error);
+	assert_int_equal(spdm_error.error_code, SPDM_ERROR_CODE_DECRYPT_ERROR);
+	assert_int_equal(spdm_error.session_id,
+			 SECURED_MESSAGE_TEST_SESSION_ID);
+}
+
+/**
+  Test 6: an SPDM message in a PCI DOE transport buffer is decoded in place.
+  Expected behavior: the message round trips.
+**/
+void test_spdm_secured_message_decode_case6(void **state)
+{
+	return_status status;
+	spdm_test_context_t *spdm_test_context;
+	spdm_context_t *spdm_context;
+	spdm_secured_message_context_t *secured_message_context;
+	spdm_heartbeat_request_t spdm_request;
+	uint8 transport_message[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+	uintn transport_message_size;
+	uint8 message[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+	uintn message_size;
+	uint32 session_id;
+	uint32 *decoded_session_id;
+	boolean is_app_message;
+
+	spdm_test_context = *state;
+	spdm_context = spdm_test_context->spdm_context;
+	spdm_test_context->case_id = 0x6;
+
+	secured_message_context = spdm_secured_message_test_setup_session(
+		spdm_context, SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP |
+				      SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP);
+	spdm_request.header.spdm_version = SPDM_MESSAGE_VERSION_11;
+	spdm_request.header.request_response_code = SPDM_HEARTBEAT;
+	spdm_request.header.param1 = 0;
+	spdm_request.header.param2 = 0;
+
+	session_id = SECURED_MESSAGE_TEST_SESSION_ID;
+	transport_message_size = sizeof(transport_message);
+	status = spdm_transport_pci_doe_encode_message(
+		spdm_context, &session_id, FALSE, TRUE, sizeof(spdm_request),
+		&spdm_request, &transport_message_size, transport_message);
+	assert_int_equal(status, RETURN_SUCCESS);
+
+	secured_message_context->application_secret
+		.request_data_sequence_number = 0;
+	message_size = sizeof(message);
+	status = spdm_transport_pci_doe_decode_message(
+		spdm_context, &decoded_session_id, &is_app_message, TRUE,
+		transport_message_size, transport_message, &message_size,
+		message);
+	assert_int_equal(status, RETURN_SUCCESS);
+	assert_non_null(decoded_session_id);
+	assert_int_equal(*decoded_session_id, SECURED_MESSAGE_TEST_SESSION_ID);
+	assert_false(is_app_message);
+	assert_int_equal(message_size, sizeof(spdm_request));
+	assert_memory_equal(message, &spdm_request, sizeof(spdm_request));
+}
+
+spdm_test_context_t m_spdm_secured_message_decode_test_context = {
+	SPDM_TEST_CONTEXT_SIGNATURE,
+	TRUE,
+	spdm_secured_message_test_send_message,
+	spdm_secured_message_test_receive_message,
+};
+
+int spdm_secured_message_decode_test_main(void)
+{
+	const struct CMUnitTest spdm_secured_message_decode_tests[] = {
+		// In-place and copy decode, ENC_MAC
+		cmocka_unit_test(test_spdm_secured_message_decode_case1),
+		// In-place and copy decode, MAC_ONLY
+		cmocka_unit_test(test_spdm_secured_message_decode_case2),
+		// Tampered and replayed records
+		cmocka_unit_test(test_spdm_secured_message_decode_case3),
+		// Truncated records
+		cmocka_unit_test(test_spdm_secured_message_decode_case4),
+		// MCTP in-place transport round trip and tamper
+		cmocka_unit_test(test_spdm_secured_message_decode_case5),
+		// PCI DOE in-place transport round trip
+		cmocka_unit_test(test_spdm_secured_message_decode_case6),
+	};
+
+	setup_spdm_test_context(&m_spdm_secured_message_decode_test_context);
+
+	return cmocka_run_group_tests(spdm_secured_message_decode_tests,
+				      spdm_unit_test_group_setup,
+				      spdm_unit_test_group_teardown);
+}
@@ -0,0 +1,301 @@
+/**
+    Copyright Notice:
+    Copyright 2021 DMTF. All rights reserved.
+    License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+**/
+
+#include "spdm_secured_message_test.h"
+
+/**
+  Encode an application message through the copy and the in-place paths and
+  check that both produce the same secured message, which the copy decoder
+  turns back into the application message.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  capability_flags              The ENCRYPT_CAP and MAC_CAP flags of the session.
+**/
+static void spdm_secured_message_test_encode(IN spdm_context_t *spdm_context,
+					     IN uint32 capability_flags)
+{
+	return_status status;
+	spdm_secured_message_context_t *secured_message_context;
+	uint8 app_message[SECURED_MESSAGE_TEST_APP_MESSAGE_SIZE];
+	uint8 copy_message[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+	uintn copy_message_size;
+	uint8 in_place_message[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+	uintn in_place_message_size;
+	uint8 decoded_message[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+	uintn decoded_message_size;
+	uintn headroom;
+	uintn tailroom;
+	uintn index;
+
+	secured_message_context = spdm_secured_message_test_setup_session(
+		spdm_context, capability_flags);
+	for (index = 0; index < sizeof(app_message); index++) {
+		app_message[index] = (uint8)index;
+	}
+	headroom = spdm_secured_message_get_headroom(
+		secured_message_context, &m_secured_message_test_callbacks);
+	tailroom = spdm_secured_message_get_tailroom(
+		secured_message_context, &m_secured_message_test_callbacks);
+
+	copy_message_size = sizeof(copy_message);
+	status = spdm_encode_secured_message(
+		secured_message_context, SECURED_MESSAGE_TEST_SESSION_ID, TRUE,
+		sizeof(app_message), app_message, &copy_message_size,
+		copy_message, &m_secured_message_test_callbacks);
+	assert_int_equal(status, RETURN_SUCCESS);
+	assert_int_equal(copy_message_size,
+			 headroom + sizeof(app_message) + tailroom);
+	assert_int_equal(secured_message_context->application_secret
+				 .request_data_sequence_number,
+			 1);
+
+	// Encode the same record again in place with the same sequence number.
+	secured_message_context->application_secret
+		.request_data_sequence_number = 0;
+	zero_mem(in_place_message, sizeof(in_place_message));
+	copy_mem(in_place_message + headroom, app_message,
+		 sizeof(app_message));
+	in_place_message_size = headroom + sizeof(app_message) + tailroom;
+	status = spdm_encode_secured_message_in_place(
+		secured_message_context, SECURED_MESSAGE_TEST_SESSION_ID, TRUE,
+		sizeof(app_message), &in_place_message_size, in_place_message,
+		&m_secured_message_test_callbacks);
+	assert_int_equal(status, RETURN_SUCCESS);
+	assert_int_equal(in_place_message_size, copy_message_size);
+	assert_memory_equal(in_place_message, copy_message, copy_message_size);
+	assert_int_equal(secured_message_context->application_secret
+				 .request_data_sequence_number,
+			 1);
+
+	// The in-place record decodes through the copy path.
+	secured_message_context->application_secret
+		.request_data_sequence_number = 0;
+	decoded_message_size = sizeof(decoded_message);
+	status = spdm_decode_secured_message(
+		secured_message_context, SECURED_MESSAGE_TEST_SESSION_ID, TRUE,
+		in_place_message_size, in_place_message, &decoded_message_size,
+		decoded_message, &m_secured_message_test_callbacks);
+	assert_int_equal(status, RETURN_SUCCESS);
+	assert_int_equal(decoded_message_size, sizeof(app_message));
+	assert_memory_equal(decoded_message, app_message, sizeof(app_message));
+
+	// A request record does not decode with the response key.
+	status = spdm_decode_secured_message(
+		secured_message_context, SECURED_MESSAGE_TEST_SESSION_ID, FALSE,
+		in_place_message_size, in_place_message, &decoded_message_size,
+		decoded_message, &m_secured_message_test_callbacks);
+	assert_int_equal(status, RETURN_SECURITY_VIOLATION);
+}
+
+/**
+  Test 1: in-place and copy encode of an ENC_MAC session produce the same result.
+  Expected behavior: both encoders produce the same secured message, which decodes to the application message.
+**/
+void test_spdm_secured_message_encode_case1(void **state)
+{
+	spdm_test_context_t *spdm_test_context;
+	spdm_context_t *spdm_context;
+
+	spdm_test_context = *state;
+	spdm_context = spdm_test_context->spdm_context;
+	spdm_test_context->case_id = 0x1;
+
+	spdm_secured_message_test_encode(
+		spdm_context, SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP |
+				      SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP);
+}
+
+/**
+  Test 2: in-place and copy encode of a MAC_ONLY session produce the same result.
+  Expected behavior: both encoders produce the same secured message, which decodes to the application message.
+**/
+void test_spdm_secured_message_encode_case2(void **state)
+{
+	spdm_test_context_t *spdm_test_context;
+	spdm_context_t *spdm_context;
+
+	spdm_test_context = *state;
+	spdm_context = spdm_test_context->spdm_context;
+	spdm_test_context->case_id = 0x2;
+
+	spdm_secured_message_test_encode(
+		spdm_context, SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP);
+}
+
+/**
+  Test 3: the transport buffer cannot hold the transport header, headroom and tailroom.
+  Expected behavior: RETURN_BUFFER_TOO_SMALL without consuming a sequence number.
+**/
+void test_spdm_secured_message_encode_case3(void **state)
+{
+	return_status status;
+	spdm_test_context_t *spdm_test_context;
+	spdm_context_t *spdm_context;
+	spdm_secured_message_context_t *secured_message_context;
+	uint8 app_message[SECURED_MESSAGE_TEST_APP_MESSAGE_SIZE];
+	uint8 transport_message[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+	uintn transport_message_size;
+	uint32 session_id;
+
+	spdm_test_context = *state;
+	spdm_context = spdm_test_context->spdm_context;
+	spdm_test_context->case_id = 0x3;
+
+	secured_message_context = spdm_secured_message_test_setup_session(
+		spdm_context, SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP |
+				      SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP);
+	set_mem(app_message, sizeof(app_message), (uint8)(0x33));
+
+	session_id = SECURED_MESSAGE_TEST_SESSION_ID;
+	transport_message_size =
+		sizeof(mctp_message_header_t) +
+		spdm_secured_message_get_headroom(
+			secured_message_context,
+			&m_secured_message_test_mctp_callbacks) +
+		spdm_secured_message_get_tailroom(
+			secured_message_context,
+			&m_secured_message_test_mctp_callbacks) -
+		1;
+	status = spdm_transport_mctp_encode_message(
+		spdm_context, &session_id, TRUE, TRUE, sizeof(app_message),
+		app_message, &transport_message_size, transport_message);
+	assert_int_equal(status, RETURN_BUFFER_TOO_SMALL);
+	assert_int_equal(secured_message_context->application_secret
+				 .request_data_sequence_number,
+			 0);
+}
+
+/**
+  Test 4: an SPDM message is encoded in place in an MCTP transport buffer.
+  Expected behavior: the secured message follows the MCTP header and carries the session ID.
+**/
+void test_spdm_secured_message_encode_case4(void **state)
+{
+	return_status status;
+	spdm_test_context_t *spdm_test_context;
+	spdm_context_t *spdm_context;
+	spdm_secured_message_context_t *secured_message_context;
+	spdm_heartbeat_request_t spdm_request;
+	uint8 transport_message[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+	uintn transport_message_size;
+	uint32 session_id;
+
+	spdm_test_context = *state;
+	spdm_context = spdm_test_context->spdm_context;
+	spdm_test_context->case_id = 0x4;
+
+	secured_message_context = spdm_secured_message_test_setup_session(
+		spdm_context, SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP |
+				      SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP);
+	spdm_request.header.spdm_version = SPDM_MESSAGE_VERSION_11;
+	spdm_request.header.request_response_code = SPDM_HEARTBEAT;
+	spdm_request.header.param1 = 0;
+	spdm_request.header.param2 = 0;
+
+	session_id = SECURED_MESSAGE_TEST_SESSION_ID;
+	transport_message_size = sizeof(transport_message);
+	status = spdm_transport_mctp_encode_message(
+		spdm_context, &session_id, FALSE, TRUE, sizeof(spdm_request),
+		&spdm_request, &transport_message_size, transport_message);
+	assert_int_equal(status, RETURN_SUCCESS);
+	assert_int_equal(
+		((mctp_message_header_t *)transport_message)->message_type,
+		MCTP_MESSAGE_TYPE_SECURED_MCTP);
+	assert_int_equal(*(uint32 *)(transport_message +
+				     sizeof(mctp_message_header_t)),
+			 SECURED_MESSAGE_TEST_SESSION_ID);
+	assert_int_equal(secured_message_context->application_secret
+				 .request_data_sequence_number,
+			 1);
+}
+
+/**
+  Test 5: an SPDM message is encoded in place in a PCI DOE transport buffer.
+  Expected behavior: the in-place secured message equals the copy-path encoding of the same SPDM message.
+**/
+void test_spdm_secured_message_encode_case5(void **state)
+{
+	return_status status;
+	spdm_test_context_t *spdm_test_context;
+	spdm_context_t *spdm_context;
+	spdm_secured_message_context_t *secured_message_context;
+	spdm_heartbeat_request_t spdm_request;
+	uint8 transport_message[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+	uintn transport_message_size;
+	uint8 secured_message[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+	uintn secured_message_size;
+	pci_doe_data_object_header_t *pci_doe_header;
+	uint32 session_id;
+
+	spdm_test_context = *state;
+	spdm_context = spdm_test_context->spdm_context;
+	spdm_test_context->case_id = 0x5;
+
+	secured_message_context = spdm_secured_message_test_setup_session(
+		spdm_context, SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP |
+				      SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP);
+	spdm_request.header.spdm_version = SPDM_MESSAGE_VERSION_11;
+	spdm_request.header.request_response_code = SPDM_HEARTBEAT;
+	spdm_request.header.param1 = 0;
+	spdm_request.header.param2 = 0;
+
+	session_id = SECURED_MESSAGE_TEST_SESSION_ID;
+	transport_message_size = sizeof(transport_message);
+	status = spdm_transport_pci_doe_encode_message(
+		spdm_context, &session_id, FALSE, TRUE, sizeof(spdm_request),
+		&spdm_request, &transport_message_size, transport_message);
+	assert_int_equal(status, RETURN_SUCCESS);
+	pci_doe_header = (void *)transport_message;
+	assert_int_equal(pci_doe_header->data_object_type,
+			 PCI_DOE_DATA_OBJECT_TYPE_SECURED_SPDM);
+	assert_int_equal(pci_doe_header->length * sizeof(uint32),
+			 transport_message_size);
+
+	// PCI DOE carries the SPDM message itself as the APP message.
+	secured_message_context->application_secret
+		.request_data_sequence_number = 0;
+	secured_message_size = sizeof(secured_message);
+	status = spdm_encode_secured_message(
+		secured_message_context, SECURED_MESSAGE_TEST_SESSION_ID, TRUE,
+		sizeof(spdm_request), &spdm_request, &secured_message_size,
+		secured_message, &m_secured_message_test_callbacks);
+	assert_int_equal(status, RETURN_SUCCESS);
+	assert_true(sizeof(pci_doe_data_object_header_t) +
+			    secured_message_size <=
+		    transport_message_size);
+	assert_memory_equal(transport_message +
+				    sizeof(pci_doe_data_object_header_t),
+			    secured_message, secured_message_size);
+}
+
+spdm_test_context_t m_spdm_secured_message_encode_test_context = {
+	SPDM_TEST_CONTEXT_SIGNATURE,
+	TRUE,
+	spdm_secured_message_test_send_message,
+	spdm_secured_message_test_receive_message,
+};
+
+int spdm_secured_message_encode_test_main(void)
+{
+	const struct CMUnitTest spdm_secured_message_encode_tests[] = {
+		// In-place and copy encode, ENC_MAC
+		cmocka_unit_test(test_spdm_secured_message_encode_case1),
+		// In-place and copy encode, MAC_ONLY
+		cmocka_unit_test(test_spdm_secured_message_encode_case2),
+		// MCTP transport buffer without tailroom
+		cmocka_unit_test(test_spdm_secured_message_encode_case3),
+		// MCTP in-place transport encode
+		cmocka_unit_test(test_spdm_secured_message_encode_case4),
+		// PCI DOE in-place transport encode equals copy path
+		cmocka_unit_test(test_spdm_secured_message_encode_case5),
+	};
+
+	setup_spdm_test_context(&m_spdm_secured_message_encode_test_context);
+
+	return cmocka_run_group_tests(spdm_secured_message_encode_tests,
+				      spdm_unit_test_group_setup,
+				      spdm_unit_test_group_teardown);
+}
@@ -0,0 +1,59 @@
+/**
+    Copyright Notice:
+    Copyright 2021 DMTF. All rights reserved.
+    License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+**/
+
+#ifndef __SPDM_SECURED_MESSAGE_TEST_H__
+#define __SPDM_SECURED_MESSAGE_TEST_H__
+
+#include "spdm_unit_test.h"
+#include <spdm_secured_message_lib_internal.h>
+#include <library/spdm_transport_mctp_lib.h>
+#include <library/spdm_transport_pcidoe_lib.h>
+#include <industry_standard/mctp.h>
+#include <industry_standard/pcidoe.h>
+
+#define SECURED_MESSAGE_TEST_SESSION_ID 0xFFFFFFFF
+#define SECURED_MESSAGE_TEST_APP_MESSAGE_SIZE 0x40
+#define SECURED_MESSAGE_TEST_BATCH_COUNT 3
+
+//
+// PCI DOE has no random padding, so the secured messages are deterministic.
+//
+extern spdm_secured_message_callbacks_t m_secured_message_test_callbacks;
+extern spdm_secured_message_callbacks_t m_secured_message_test_mctp_callbacks;
+
+/**
+  A send_message function of a test context that does not talk to a device.
+**/
+return_status spdm_secured_message_test_send_message(IN void *spdm_context,
+						     IN uintn request_size,
+						     IN void *request,
+						     IN uint64 timeout);
+
+/**
+  A receive_message function of a test context that does not talk to a device.
+**/
+return_status
+spdm_secured_message_test_receive_message(IN void *spdm_context,
+					  IN OUT uintn *response_size,
+					  IN OUT void *response,
+					  IN uint64 timeout);
+
+/**
+  Set up an established session in session_info[0] with dummy data keys.
+
+  The request and response keys differ, so a message decoded in the wrong
+  direction fails verification.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  capability_flags              The ENCRYPT_CAP and MAC_CAP flags of the session.
+
+  @return the secured message context of the session.
+**/
+spdm_secured_message_context_t *
+spdm_secured_message_test_setup_session(IN spdm_context_t *spdm_context,
+					IN uint32 capability_flags);
+
+#endif
@@ -0,0 +1,115 @@
+/**
+    Copyright Notice:
+    Copyright 2021 DMTF. All rights reserved.
+    License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+**/
+
+#include "spdm_secured_message_test.h"
+
+spdm_secured_message_callbacks_t m_secured_message_test_callbacks = {
+	SPDM_SECURED_MESSAGE_CALLBACKS_VERSION,
+	spdm_pci_doe_get_sequence_number,
+	spdm_pci_doe_get_max_random_number_count,
+};
+
+spdm_secured_message_callbacks_t m_secured_message_test_mctp_callbacks = {
+	SPDM_SECURED_MESSAGE_CALLBACKS_VERSION,
+	spdm_mctp_get_sequence_number,
+	spdm_mctp_get_max_random_number_count,
+};
+
+return_status spdm_secured_message_test_send_message(IN void *spdm_context,
+						     IN uintn request_size,
+						     IN void *request,
+						     IN uint64 timeout)
+{
+	return RETURN_DEVICE_ERROR;
+}
+
+return_status
+spdm_secured_message_test_receive_message(IN void *spdm_context,
+					  IN OUT uintn *response_size,
+					  IN OUT void *response,
+					  IN uint64 timeout)
+{
+	return RETURN_DEVICE_ERROR;
+}
+
+/**
+  Set up an established session in session_info[0] with dummy data keys.
+
+  The request and response keys differ, so a message decoded in the wrong
+  direction fails verification.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  capability_flags              The ENCRYPT_CAP and MAC_CAP flags of the session.
+
+  @return the secured message context of the session.
+**/
+spdm_secured_message_context_t *
+spdm_secured_message_test_setup_session(IN spdm_context_t *spdm_context,
+					IN uint32 capability_flags)
+{
+	spdm_session_info_t *session_info;
+	spdm_secured_message_context_t *secured_message_context;
+
+	spdm_context->connection_info.connection_state =
+		SPDM_CONNECTION_STATE_NEGOTIATED;
+	spdm_context->connection_info.capability.flags = capability_flags;
+	spdm_context->local_context->capability.flags = capability_flags;
+	spdm_context->connection_info.algorithm.base_hash_algo =
+		m_use_hash_algo;
+	spdm_context->connection_info.algorithm.dhe_named_group =
+		m_use_dhe_algo;
+	spdm_context->connection_info.algorithm.aead_cipher_suite =
+		m_use_aead_algo;
+	spdm_context->connection_info.algorithm.key_schedule =
+		m_use_key_schedule_algo;
+
+	session_info = &spdm_context->session_info[0];
+	spdm_session_info_init(spdm_context, session_info,
+			       SECURED_MESSAGE_TEST_SESSION_ID, FALSE);
+	secured_message_context = session_info->secured_message_context;
+	spdm_secured_message_set_session_state(secured_message_context,
+					       SPDM_SESSION_STATE_ESTABLISHED);
+
+	set_mem(secured_message_context->application_secret
+			.request_data_encryption_key,
+		secured_message_context->aead_key_size, (uint8)(0xFF));
+	set_mem(secured_message_context->application_secret.request_data_salt,
+		secured_message_context->aead_iv_size, (uint8)(0xFF));
+	secured_message_context->application_secret
+		.request_data_sequence_number = 0;
+	set_mem(secured_message_context->application_secret
+			.response_data_encryption_key,
+		secured_message_context->aead_key_size, (uint8)(0xAA));
+	set_mem(secured_message_context->application_secret.response_data_salt,
+		secured_message_context->aead_iv_size, (uint8)(0xAA));
+	secured_message_context->application_secret
+		.response_data_sequence_number = 0;
+
+	return secured_message_context;
+}
+
+int spdm_secured_message_encode_test_main(void);
+int spdm_secured_message_decode_test_main(void);
+int spdm_secured_message_batch_test_main(void);
+
+int main(void)
+{
+	int return_value = 0;
+
+	if (spdm_secured_message_encode_test_main() != 0) {
+		return_value = 1;
+	}
+
+	if (spdm_secured_message_decode_test_main() != 0) {
+		return_value = 1;
+	}
+
+	if (spdm_secured_message_batch_test_main() != 0) {
+		return_value = 1;
+	}
+
+	return return_value;
+}